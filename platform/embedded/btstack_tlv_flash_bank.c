@@ -204,6 +204,98 @@ static void tlv_iterator_fetch_next(btstack_tlv_flash_bank_t * self, tlv_iterato
 	btstack_tlv_flash_bank_iterator_fetch_tag_len(self, it);
 }
 
+// tag index
+
+#ifdef ENABLE_TLV_FLASH_INDEX
+
+#if (BTSTACK_TLV_FLASH_INDEX_SIZE & (BTSTACK_TLV_FLASH_INDEX_SIZE - 1)) != 0
+#error "BTSTACK_TLV_FLASH_INDEX_SIZE must be a power of two"
+#endif
+
+#define BTSTACK_TLV_FLASH_INDEX_MASK (BTSTACK_TLV_FLASH_INDEX_SIZE - 1u)
+
+static uint16_t btstack_tlv_flash_bank_index_home_slot(uint32_t tag){
+    // multiplicative hashing, as tags often differ only in the lowest byte
+    return (uint16_t) (((tag * 2654435761u) >> 16) & BTSTACK_TLV_FLASH_INDEX_MASK);
+}
+
+static btstack_tlv_flash_bank_index_entry_t * btstack_tlv_flash_bank_index_lookup(btstack_tlv_flash_bank_t * self, uint32_t tag){
+    uint16_t slot = btstack_tlv_flash_bank_index_home_slot(tag);
+    while (self->index_entries[slot].offset != 0u){
+        if (self->index_entries[slot].tag == tag){
+            return &self->index_entries[slot];
+        }
+        slot = (slot + 1u) & BTSTACK_TLV_FLASH_INDEX_MASK;
+    }
+    return NULL;
+}
+
+static void btstack_tlv_flash_bank_index_set(btstack_tlv_flash_bank_t * self, uint32_t tag, uint32_t offset, uint32_t len){
+    uint16_t slot = btstack_tlv_flash_bank_index_home_slot(tag);
+    while (self->index_entries[slot].offset != 0u){
+        if (self->index_entries[slot].tag == tag){
+            break;
+        }
+        slot = (slot + 1u) & BTSTACK_TLV_FLASH_INDEX_MASK;
+    }
+    if (self->index_entries[slot].offset == 0u){
+        // keep at least one free slot to terminate probing, lookup falls back to scan otherwise
+        if ((self->index_num_entries + 1u) >= BTSTACK_TLV_FLASH_INDEX_SIZE){
+            if (self->index_complete){
+                log_info("tag index full");
+            }
+            self->index_complete = false;
+            return;
+        }
+        self->index_num_entries++;
+    }
+    self->index_entries[slot].tag    = tag;
+    self->index_entries[slot].offset = offset;
+    self->index_entries[slot].len    = len;
+}
+
+#ifndef ENABLE_TLV_FLASH_WRITE_ONCE
+static void btstack_tlv_flash_bank_index_remove(btstack_tlv_flash_bank_t * self, btstack_tlv_flash_bank_index_entry_t * index_entry){
+    // backward shift deletion keeps probe sequences intact without tombstones
+    uint16_t slot = (uint16_t) (index_entry - &self->index_entries[0]);
+    uint16_t next = (slot + 1u) & BTSTACK_TLV_FLASH_INDEX_MASK;
+    while (self->index_entries[next].offset != 0u){
+        uint16_t home = btstack_tlv_flash_bank_index_home_slot(self->index_entries[next].tag);
+        // move entry into hole if its home slot is not within (slot, next]
+        if (((next - home) & BTSTACK_TLV_FLASH_INDEX_MASK) >= ((next - slot) & BTSTACK_TLV_FLASH_INDEX_MASK)){
+            self->index_entries[slot] = self->index_entries[next];
+            slot = next;
+        }
+        next = (next + 1u) & BTSTACK_TLV_FLASH_INDEX_MASK;
+    }
+    self->index_entries[slot].offset = 0;
+    self->index_num_entries--;
+}
+#endif
+
+static void btstack_tlv_flash_bank_index_reset(btstack_tlv_flash_bank_t * self){
+    memset(self->index_entries, 0, sizeof(self->index_entries));
+    self->index_num_entries = 0;
+    self->index_complete = false;
+}
+
+static void btstack_tlv_flash_bank_index_rebuild(btstack_tlv_flash_bank_t * self){
+    btstack_tlv_flash_bank_index_reset(self);
+    self->index_complete = true;
+    tlv_iterator_t it;
+    btstack_tlv_flash_bank_iterator_init(self, &it, self->current_bank);
+    while (btstack_tlv_flash_bank_iterator_has_next(self, &it)){
+        // skip deleted entries, later entries replace earlier ones
+        if (it.tag != 0u){
+            btstack_tlv_flash_bank_index_set(self, it.tag, it.offset, it.len);
+        }
+        tlv_iterator_fetch_next(self, &it);
+    }
+    log_info("tag index: %u entries, complete %u", self->index_num_entries, (int) self->index_complete);
+}
+
+#endif
+
 //
 
 // check both banks for headers and pick the one with the higher epoch % 4
@@ -265,6 +357,28 @@ static void btstack_tlv_flash_bank_erase_bank(btstack_tlv_flash_bank_t * self, i
 	}
 }
 
+#ifdef ENABLE_TLV_FLASH_WRITE_ONCE
+static bool btstack_tlv_flash_bank_is_latest_entry(btstack_tlv_flash_bank_t * self, const tlv_iterator_t * it){
+#ifdef ENABLE_TLV_FLASH_INDEX
+    // index references latest entry
+    if (self->index_complete){
+        btstack_tlv_flash_bank_index_entry_t * index_entry = btstack_tlv_flash_bank_index_lookup(self, it->tag);
+        return (index_entry != NULL) && (index_entry->offset == it->offset);
+    }
+#endif
+    // search until end for newer entry of same tag
+    tlv_iterator_t it2;
+    memcpy(&it2, it, sizeof(tlv_iterator_t));
+    while (btstack_tlv_flash_bank_iterator_has_next(self, &it2)){
+        if ((it2.offset != it->offset) && (it2.tag == it->tag)){
+            return false;
+        }
+        tlv_iterator_fetch_next(self, &it2);
+    }
+    return true;
+}
+#endif
+
 static void btstack_tlv_flash_bank_migrate(btstack_tlv_flash_bank_t * self){
 
 	int next_bank = 1 - self->current_bank;
@@ -284,19 +398,9 @@ static void btstack_tlv_flash_bank_migrate(btstack_tlv_flash_bank_t * self){
             bool tag_valid = true;
 
 #ifdef ENABLE_TLV_FLASH_WRITE_ONCE
-            // search until end for newer entry of same tag
-            tlv_iterator_t it2;
-            memcpy(&it2, &it, sizeof(tlv_iterator_t));
-            while (btstack_tlv_flash_bank_iterator_has_next(self, &it2)){
-                if ((it2.offset != it.offset) && (it2.tag == it.tag)){
-                    tag_valid = false;
-                    break;
-                }
-                tlv_iterator_fetch_next(self, &it2);
-            }
+            tag_valid = btstack_tlv_flash_bank_is_latest_entry(self, &it);
             if (tag_valid == false){
-			    log_info("skip pos %u, tag '%x' as newer entry found at %u", (unsigned int) tag_index, (unsigned int) it.tag,
-                    (unsigned int) it2.offset);
+			    log_info("skip pos %u, tag '%x' as newer entry exists", (unsigned int) tag_index, (unsigned int) it.tag);
             }
 #endif
 
@@ -349,71 +453,93 @@ static void btstack_tlv_flash_bank_migrate(btstack_tlv_flash_bank_t * self){
 	btstack_tlv_flash_bank_write_header(self, next_bank, (epoch_buffer + 1) & 3);
 	self->current_bank = next_bank;
 	self->write_offset = next_write_pos;
+
+#ifdef ENABLE_TLV_FLASH_INDEX
+	btstack_tlv_flash_bank_index_rebuild(self);
+#endif
 }
 
 #ifndef ENABLE_TLV_FLASH_WRITE_ONCE
+static void btstack_tlv_flash_bank_delete_entry(btstack_tlv_flash_bank_t * self, uint32_t offset, uint32_t len){
+	// mark entry as invalid
+	uint32_t zero_value = 0;
+#ifdef ENABLE_TLV_FLASH_EXPLICIT_DELETE_FIELD
+	UNUSED(len);
+	// write delete field after entry header
+	btstack_tlv_flash_bank_write(self, self->current_bank, offset+self->entry_header_len, (uint8_t*) &zero_value, sizeof(zero_value));
+#else
+    uint32_t alignment = self->hal_flash_bank_impl->get_alignment(self->hal_flash_bank_context);
+    if (alignment <= 4){
+        // if alignment < 4, overwrite only tag with zero value
+        btstack_tlv_flash_bank_write(self, self->current_bank, offset, (uint8_t*) &zero_value, sizeof(zero_value));
+    } else {
+        // otherwise, overwrite complete entry. This results in a sequence of { tag: 0, len: 0 } entries
+        uint8_t zero_buffer[32];
+        memset(zero_buffer, 0, sizeof(zero_buffer));
+        uint32_t entry_offset = 0;
+        uint32_t entry_size = btstack_tlv_flash_bank_aligned_entry_size(self, len);
+        while (entry_offset < entry_size) {
+            uint32_t bytes_to_write = btstack_min(entry_size - entry_offset, sizeof(zero_buffer));
+            btstack_tlv_flash_bank_write(self, self->current_bank, offset + entry_offset, zero_buffer, bytes_to_write);
+            entry_offset += bytes_to_write;
+        }
+    }
+#endif
+}
+
 static void btstack_tlv_flash_bank_delete_tag_until_offset(btstack_tlv_flash_bank_t * self, uint32_t tag, uint32_t offset){
 	tlv_iterator_t it;
 	btstack_tlv_flash_bank_iterator_init(self, &it, self->current_bank);
 	while (btstack_tlv_flash_bank_iterator_has_next(self, &it) && it.offset < offset){
 		if (it.tag == tag){
 			log_info("Erase tag '%x' at position %u", (unsigned int) tag, (unsigned int) it.offset);
-
-			// mark entry as invalid
-			uint32_t zero_value = 0;
-#ifdef ENABLE_TLV_FLASH_EXPLICIT_DELETE_FIELD
-			// write delete field after entry header
-			btstack_tlv_flash_bank_write(self, self->current_bank, it.offset+self->entry_header_len, (uint8_t*) &zero_value, sizeof(zero_value));
-#else
-            uint32_t alignment = self->hal_flash_bank_impl->get_alignment(self->hal_flash_bank_context);
-            if (alignment <= 4){
-                // if alignment < 4, overwrite only tag with zero value
-                btstack_tlv_flash_bank_write(self, self->current_bank, it.offset, (uint8_t*) &zero_value, sizeof(zero_value));
-            } else {
-                // otherwise, overwrite complete entry. This results in a sequence of { tag: 0, len: 0 } entries
-                uint8_t zero_buffer[32];
-                memset(zero_buffer, 0, sizeof(zero_buffer));
-                uint32_t entry_offset = 0;
-                uint32_t entry_size = btstack_tlv_flash_bank_aligned_entry_size(self, it.len);
-                while (entry_offset < entry_size) {
-                    uint32_t bytes_to_write = btstack_min(entry_size - entry_offset, sizeof(zero_buffer));
-                    btstack_tlv_flash_bank_write(self, self->current_bank, it.offset + entry_offset, zero_buffer, bytes_to_write);
-                    entry_offset += bytes_to_write;
-                }
-            }
-#endif
+			btstack_tlv_flash_bank_delete_entry(self, it.offset, it.len);
 		}
 		tlv_iterator_fetch_next(self, &it);
 	}
 }
 #endif
 
-/**
- * Get Value for Tag
- * @param tag
- * @param buffer
- * @param buffer_size
- * @returns size of value
- */
-static int btstack_tlv_flash_bank_get_tag(void * context, uint32_t tag, uint8_t * buffer, uint32_t buffer_size){
-
-	btstack_tlv_flash_bank_t * self = (btstack_tlv_flash_bank_t *) context;
-
+// @returns offset of latest entry for tag or 0 if not found
+static uint32_t btstack_tlv_flash_bank_find_tag(btstack_tlv_flash_bank_t * self, uint32_t tag, uint32_t * tag_len){
+#ifdef ENABLE_TLV_FLASH_INDEX
+	btstack_tlv_flash_bank_index_entry_t * index_entry = btstack_tlv_flash_bank_index_lookup(self, tag);
+	if (index_entry != NULL){
+		*tag_len = index_entry->len;
+		return index_entry->offset;
+	}
+	if (self->index_complete) return 0;
+#endif
 	uint32_t tag_index = 0;
-	uint32_t tag_len   = 0;
 	tlv_iterator_t it;
 	btstack_tlv_flash_bank_iterator_init(self, &it, self->current_bank);
 	while (btstack_tlv_flash_bank_iterator_has_next(self, &it)){
 		if (it.tag == tag){
 			log_info("Found tag '%x' at position %u", (unsigned int) tag, (unsigned int) it.offset);
 			tag_index = it.offset;
-			tag_len   = it.len;
+			*tag_len  = it.len;
 #ifndef ENABLE_TLV_FLASH_WRITE_ONCE
 			break;
 #endif
 		}
 		tlv_iterator_fetch_next(self, &it);
 	}
+	return tag_index;
+}
+
+/**
+ * Get Value for Tag
+ * @param tag
+ * @param buffer
+ * @param buffer_size
+ * @returns size of value
+ */
+static int btstack_tlv_flash_bank_get_tag(void * context, uint32_t tag, uint8_t * buffer, uint32_t buffer_size){
+
+	btstack_tlv_flash_bank_t * self = (btstack_tlv_flash_bank_t *) context;
+
+	uint32_t tag_len   = 0;
+	uint32_t tag_index = btstack_tlv_flash_bank_find_tag(self, tag, &tag_len);
 	if (tag_index == 0) return 0;
 	if (!buffer) return tag_len;
 	int copy_size = btstack_min(buffer_size, tag_len);
@@ -488,8 +614,21 @@ static int btstack_tlv_flash_bank_store_tag(void * context, uint32_t tag, const
 
 #ifndef ENABLE_TLV_FLASH_WRITE_ONCE
 	// overwrite old entries (if exists)
+#ifdef ENABLE_TLV_FLASH_INDEX
+	btstack_tlv_flash_bank_index_entry_t * index_entry = btstack_tlv_flash_bank_index_lookup(self, tag);
+	if (index_entry != NULL){
+		btstack_tlv_flash_bank_delete_entry(self, index_entry->offset, index_entry->len);
+	} else if (self->index_complete == false){
+		btstack_tlv_flash_bank_delete_tag_until_offset(self, tag, self->write_offset);
+	}
+#else
 	btstack_tlv_flash_bank_delete_tag_until_offset(self, tag, self->write_offset);
 #endif
+#endif
+
+#ifdef ENABLE_TLV_FLASH_INDEX
+	btstack_tlv_flash_bank_index_set(self, tag, self->write_offset, data_size);
+#endif
 
 	// done
 	self->write_offset += btstack_tlv_flash_bank_aligned_entry_size(self, data_size);
@@ -506,6 +645,16 @@ static void btstack_tlv_flash_bank_delete_tag(void * context, uint32_t tag){
     btstack_tlv_flash_bank_store_tag(context, tag, NULL, 0);
 #else
     btstack_tlv_flash_bank_t * self = (btstack_tlv_flash_bank_t *) context;
+#ifdef ENABLE_TLV_FLASH_INDEX
+	btstack_tlv_flash_bank_index_entry_t * index_entry = btstack_tlv_flash_bank_index_lookup(self, tag);
+	if (index_entry != NULL){
+		btstack_tlv_flash_bank_delete_entry(self, index_entry->offset, index_entry->len);
+		btstack_tlv_flash_bank_index_remove(self, index_entry);
+		return;
+	}
+	// not stored
+	if (self->index_complete) return;
+#endif
 	btstack_tlv_flash_bank_delete_tag_until_offset(self, tag, self->write_offset);
 #endif
 }
@@ -543,6 +692,11 @@ const btstack_tlv_t * btstack_tlv_flash_bank_init_instance(btstack_tlv_flash_ban
     self->entry_header_len = BTSTACK_TLV_ENTRY_HEADER_LEN;
 #endif
 
+#ifdef ENABLE_TLV_FLASH_INDEX
+	// index is built after current bank has been validated
+	btstack_tlv_flash_bank_index_reset(self);
+#endif
+
 	// try to find current bank
 	self->current_bank = btstack_tlv_flash_bank_get_latest_bank(self);
 	log_info("found bank %d", self->current_bank);
@@ -595,6 +749,10 @@ const btstack_tlv_t * btstack_tlv_flash_bank_init_instance(btstack_tlv_flash_ban
         self->write_offset = btstack_tlv_flash_bank_align_size (self, BTSTACK_TLV_BANK_HEADER_LEN);
 	}
 
+#ifdef ENABLE_TLV_FLASH_INDEX
+	btstack_tlv_flash_bank_index_rebuild(self);
+#endif
+
 	log_info("write offset %" PRIx32, self->write_offset);
 	return &btstack_tlv_flash_bank;
 }
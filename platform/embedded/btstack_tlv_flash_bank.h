@@ -40,6 +40,8 @@
 #define BTSTACK_TLV_FLASH_BANK_H
 
 #include <stdint.h>
+#include "btstack_config.h"
+#include "btstack_bool.h"
 #include "btstack_tlv.h"
 #include "hal_flash_bank.h"
 
@@ -47,6 +49,21 @@
 extern "C" {
 #endif
 
+#ifdef ENABLE_TLV_FLASH_INDEX
+
+// number of slots in tag index, must be a power of two and larger than the number of stored tags
+#ifndef BTSTACK_TLV_FLASH_INDEX_SIZE
+#define BTSTACK_TLV_FLASH_INDEX_SIZE 64
+#endif
+
+typedef struct {
+    uint32_t tag;
+    uint32_t offset;    // offset of latest entry in current bank, 0 = unused slot
+    uint32_t len;
+} btstack_tlv_flash_bank_index_entry_t;
+
+#endif
+
 typedef struct {
 	const    hal_flash_bank_t * hal_flash_bank_impl;
 	void *   hal_flash_bank_context;
@@ -54,6 +71,13 @@ typedef struct {
 	int8_t   current_bank;
     uint16_t  delete_tag_len;
     uint16_t  entry_header_len;
+#ifdef ENABLE_TLV_FLASH_INDEX
+    // open addressing hash table with linear probing, tag -> latest entry
+    btstack_tlv_flash_bank_index_entry_t index_entries[BTSTACK_TLV_FLASH_INDEX_SIZE];
+    uint16_t index_num_entries;
+    // all tags in current bank are indexed, otherwise lookup falls back to scan
+    bool     index_complete;
+#endif
 } btstack_tlv_flash_bank_t;
 
 /**
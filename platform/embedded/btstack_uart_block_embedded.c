@@ -223,6 +223,8 @@ static const btstack_uart_block_t btstack_uart_embedded = {
     /* void (*set_sleep)(btstack_uart_sleep_mode_t sleep_mode); */    &btstack_uart_embedded_set_sleep,
     /* void (*set_wakeup_handler)(void (*handler)(void)); */          &btstack_uart_embedded_set_wakeup_handler,
     NULL, NULL, NULL, NULL,
+    /* void (*set_bytes_received)(void (*bytes_handler)(uint16_t bytes_received)); */ NULL,
+    /* void (*receive_bytes)(uint8_t *buffer, uint16_t len); */       NULL,
 };
 
 const btstack_uart_block_t * btstack_uart_block_embedded_instance(void){
@@ -160,6 +160,10 @@ const hci_dump_t * hci_dump_embedded_stdout_get_instance(void){
         // void (*log_message_P)(int log_level, PGM_P * format, va_list argptr);
         &hci_dump_embedded_stdout_log_message_P,
 #endif
+        // void (*snapshot)(void);
+        NULL,
+        // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+        NULL,
     };
     return &hci_dump_instance;
 }
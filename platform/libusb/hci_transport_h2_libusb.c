@@ -73,6 +73,7 @@
 #include "hci.h"
 #include "hci_transport.h"
 #include "hci_transport_usb.h"
+#include "hci_transport_h2_libusb.h"
 
 #define DEBUG
 
@@ -88,6 +89,7 @@
 #define HAVE_USB_VENDOR_ID_AND_PRODUCT_ID
 #endif
 
+// default number of transfers in flight, see hci_transport_usb_set_num_transfers
 #define ACL_IN_BUFFER_COUNT    3
 #define EVENT_IN_BUFFER_COUNT  3
 #define EVENT_OUT_BUFFER_COUNT 4
@@ -132,9 +134,7 @@ static const uint16_t iso_packet_size_for_alt_setting[] = {
 #define SCO_PACKET_SIZE  (49 * NUM_ISO_PACKETS)
 
 // Outgoing SCO packet queue
-// simplified ring buffer implementation
 #define SCO_OUT_BUFFER_COUNT  (8)
-#define SCO_OUT_BUFFER_SIZE (SCO_OUT_BUFFER_COUNT * SCO_PACKET_SIZE)
 
 // seems to be the max depth for USB 3
 #define USB_MAX_PATH_LEN 7
@@ -179,6 +179,18 @@ typedef struct {
 
 static btstack_linked_list_t usb_knwon_devices;
 
+// number of transfers in flight per endpoint type
+static uint8_t usb_num_event_in_transfers = EVENT_IN_BUFFER_COUNT;
+static uint8_t usb_num_acl_in_transfers   = ACL_IN_BUFFER_COUNT;
+static uint8_t usb_num_out_transfers      = EVENT_OUT_BUFFER_COUNT;
+#ifdef ENABLE_SCO_OVER_HCI
+static uint8_t usb_num_sco_in_transfers   = SCO_IN_BUFFER_COUNT;
+static uint8_t usb_num_sco_out_transfers  = SCO_OUT_BUFFER_COUNT;
+#endif
+
+// transfer statistics
+static hci_transport_usb_endpoint_stats_t usb_endpoint_stats[HCI_TRANSPORT_USB_ENDPOINT_NUM];
+
 typedef struct list_head {
     struct list_head *next, *prev;
 } list_head_t;
@@ -428,6 +440,78 @@ void hci_transport_usb_set_bus_and_path(uint8_t bus, int len, uint8_t* port_numb
     usb_bus = bus;
 }
 
+void hci_transport_usb_set_num_transfers(uint8_t num_event_in, uint8_t num_acl_in, uint8_t num_out, uint8_t num_sco_in, uint8_t num_sco_out){
+    if (usb_transport_open){
+        log_error("hci_transport_usb_set_num_transfers: transport already open");
+        return;
+    }
+    usb_num_event_in_transfers = (num_event_in != 0) ? num_event_in : EVENT_IN_BUFFER_COUNT;
+    usb_num_acl_in_transfers   = (num_acl_in   != 0) ? num_acl_in   : ACL_IN_BUFFER_COUNT;
+    usb_num_out_transfers      = (num_out      != 0) ? num_out      : EVENT_OUT_BUFFER_COUNT;
+#ifdef ENABLE_SCO_OVER_HCI
+    usb_num_sco_in_transfers   = (num_sco_in   != 0) ? num_sco_in   : SCO_IN_BUFFER_COUNT;
+    usb_num_sco_out_transfers  = (num_sco_out  != 0) ? num_sco_out  : SCO_OUT_BUFFER_COUNT;
+#else
+    UNUSED(num_sco_in);
+    UNUSED(num_sco_out);
+#endif
+}
+
+static hci_transport_usb_endpoint_t usb_endpoint_type(uint8_t endpoint){
+    if (endpoint == 0)             return HCI_TRANSPORT_USB_ENDPOINT_CONTROL_OUT;
+    if (endpoint == event_in_addr) return HCI_TRANSPORT_USB_ENDPOINT_EVENT_IN;
+    if (endpoint == acl_in_addr)   return HCI_TRANSPORT_USB_ENDPOINT_ACL_IN;
+    if (endpoint == acl_out_addr)  return HCI_TRANSPORT_USB_ENDPOINT_ACL_OUT;
+    if (endpoint == sco_in_addr)   return HCI_TRANSPORT_USB_ENDPOINT_SCO_IN;
+    if (endpoint == sco_out_addr)  return HCI_TRANSPORT_USB_ENDPOINT_SCO_OUT;
+    return HCI_TRANSPORT_USB_ENDPOINT_NUM;
+}
+
+static void usb_endpoint_stats_count(uint8_t endpoint, enum libusb_transfer_status status){
+    hci_transport_usb_endpoint_t endpoint_type = usb_endpoint_type(endpoint);
+    if (endpoint_type == HCI_TRANSPORT_USB_ENDPOINT_NUM) return;
+    switch (status){
+        case LIBUSB_TRANSFER_COMPLETED:
+            usb_endpoint_stats[endpoint_type].transfers_completed++;
+            break;
+        case LIBUSB_TRANSFER_STALL:
+            usb_endpoint_stats[endpoint_type].transfers_stalled++;
+            break;
+        default:
+            break;
+    }
+}
+
+static int usb_submit_transfer(struct libusb_transfer *transfer){
+    int r = libusb_submit_transfer(transfer);
+    if (r == 0){
+        hci_transport_usb_endpoint_t endpoint_type = usb_endpoint_type(transfer->endpoint);
+        if (endpoint_type != HCI_TRANSPORT_USB_ENDPOINT_NUM){
+            usb_endpoint_stats[endpoint_type].transfers_submitted++;
+        }
+    }
+    return r;
+}
+
+void hci_transport_usb_get_endpoint_stats(hci_transport_usb_endpoint_t endpoint, hci_transport_usb_endpoint_stats_t * stats){
+    if (endpoint >= HCI_TRANSPORT_USB_ENDPOINT_NUM){
+        memset(stats, 0, sizeof(hci_transport_usb_endpoint_stats_t));
+        return;
+    }
+    *stats = usb_endpoint_stats[endpoint];
+}
+
+void hci_transport_usb_dump_stats(void){
+    static const char * endpoint_names[HCI_TRANSPORT_USB_ENDPOINT_NUM] = {
+        "Control Out", "Event In", "ACL In", "ACL Out", "SCO In", "SCO Out"
+    };
+    int i;
+    for (i = 0; i < HCI_TRANSPORT_USB_ENDPOINT_NUM; i++){
+        log_info("%-11s: submitted %u, completed %u, stalled %u", endpoint_names[i],
+                 usb_endpoint_stats[i].transfers_submitted, usb_endpoint_stats[i].transfers_completed, usb_endpoint_stats[i].transfers_stalled);
+    }
+}
+
 LIBUSB_CALL static void async_callback(struct libusb_transfer *transfer) {
     if (libusb_state != LIB_USB_TRANSFERS_ALLOCATED) {
         log_info("shutdown, transfer %p", transfer);
@@ -438,6 +522,8 @@ LIBUSB_CALL static void async_callback(struct libusb_transfer *transfer) {
     int r;
     // log_info("begin async_callback endpoint %x, status %x, actual length %u", transfer->endpoint, transfer->status, transfer->actual_length );
 
+    usb_endpoint_stats_count(transfer->endpoint, transfer->status);
+
     if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
         enqueue_transfer(transfer);
     } else if (transfer->status == LIBUSB_TRANSFER_STALL){
@@ -446,7 +532,7 @@ LIBUSB_CALL static void async_callback(struct libusb_transfer *transfer) {
         if (r) {
             log_error("Error rclearing halt %d", r);
         }
-        r = libusb_submit_transfer(transfer);
+        r = usb_submit_transfer(transfer);
         if (r) {
             log_error("Error re-submitting transfer %d", r);
         }
@@ -462,7 +548,7 @@ LIBUSB_CALL static void async_callback(struct libusb_transfer *transfer) {
     } else {
         log_info("async_callback. not data -> resubmit transfer, endpoint %x, status %x, length %u", transfer->endpoint, transfer->status, transfer->actual_length);
         // No usable data, just resubmit packet
-        r = libusb_submit_transfer(transfer);
+        r = usb_submit_transfer(transfer);
         if (r) {
             log_error("Error re-submitting transfer %d", r);
         }
@@ -495,7 +581,7 @@ static int usb_send_sco_packet(uint8_t *packet, int size){
     // log_info("usb_send_sco_packet: size %u, max size %u, iso packet size %u", size, NUM_ISO_PACKETS * iso_packet_size, iso_packet_size);
     libusb_fill_iso_transfer(transfer, handle, sco_out_addr, data, NUM_ISO_PACKETS * iso_packet_size, NUM_ISO_PACKETS, async_callback, user_data, 0);
     libusb_set_iso_packet_lengths(transfer, iso_packet_size);
-    r = libusb_submit_transfer(transfer);
+    r = usb_submit_transfer(transfer);
     if (r < 0) {
         log_error("Error submitting sco transfer, %d", r);
         return -1;
@@ -519,6 +605,14 @@ static void sco_state_machine_init(void){
 
 static void handle_isochronous_data(uint8_t * buffer, uint16_t size){
     while (size){
+        // deliver complete packets directly from transfer buffer
+        if ((sco_read_pos == 0) && (size >= 3u) && (size >= (3u + buffer[2]))){
+            uint16_t packet_len = 3u + buffer[2];
+            packet_handler(HCI_SCO_DATA_PACKET, buffer, packet_len);
+            buffer += packet_len;
+            size   -= packet_len;
+            continue;
+        }
         if (size < sco_bytes_to_read){
             // just store incomplete data
             memcpy(&sco_buffer[sco_read_pos], buffer, size);
@@ -588,7 +682,15 @@ static void handle_completed_transfer(struct libusb_transfer *transfer){
             }
             if (!pack->actual_length) continue;
             uint8_t * data = libusb_get_iso_packet_buffer_simple(transfer, i);
-            handle_isochronous_data(data, pack->actual_length);
+            uint16_t len = pack->actual_length;
+            // full iso packets are followed by the next one in the transfer buffer, process them together
+            while ((pack->actual_length == pack->length) && ((i + 1) < transfer->num_iso_packets)
+                && (transfer->iso_packet_desc[i + 1].status == LIBUSB_TRANSFER_COMPLETED)){
+                i++;
+                pack = &transfer->iso_packet_desc[i];
+                len += pack->actual_length;
+            }
+            handle_isochronous_data(data, len);
         }
         resubmit = 1;
     } else if (transfer->endpoint == sco_out_addr){
@@ -622,7 +724,7 @@ static void handle_completed_transfer(struct libusb_transfer *transfer){
 
     if (resubmit){
         // Re-submit transfer 
-        int r = libusb_submit_transfer(transfer);
+        int r = usb_submit_transfer(transfer);
         if (r) {
             log_error("Error re-submitting transfer %d", r);
         }
@@ -963,14 +1065,14 @@ static int usb_sco_start(void){
 
 #ifdef DEBUG
     int in_flight = usb_transfer_list_in_flight( sco_transfer_list );
-    // there need to be at least SCO_IN_BUFFER_COUNT packets available to 
+    // there need to be at least usb_num_sco_in_transfers packets available to
     // fill them in below
-    btstack_assert( in_flight <= SCO_OUT_BUFFER_COUNT );
+    btstack_assert( in_flight <= usb_num_sco_out_transfers );
 #endif
 
     // incoming
     int c;
-    for (c = 0 ; c < SCO_IN_BUFFER_COUNT ; c++) {
+    for (c = 0 ; c < usb_num_sco_in_transfers ; c++) {
 
         struct libusb_transfer *transfer = usb_transfer_list_acquire( sco_transfer_list );
         uint8_t *data = transfer->buffer;
@@ -980,7 +1082,7 @@ static int usb_sco_start(void){
         libusb_fill_iso_transfer(transfer, handle, sco_in_addr,
                 data, NUM_ISO_PACKETS * iso_packet_size, NUM_ISO_PACKETS, async_callback, user_data, 0);
         libusb_set_iso_packet_lengths(transfer, iso_packet_size);
-        r = libusb_submit_transfer(transfer);
+        r = usb_submit_transfer(transfer);
         if (r) {
             log_error("Error submitting isochronous in transfer %d", r);
             usb_close();
@@ -1168,13 +1270,13 @@ static int usb_open(void){
     int c;
 
     default_transfer_list = usb_transfer_list_alloc(
-            EVENT_OUT_BUFFER_COUNT+EVENT_IN_BUFFER_COUNT+ACL_IN_BUFFER_COUNT,
+            usb_num_out_transfers+usb_num_event_in_transfers+usb_num_acl_in_transfers,
             0,
             LIBUSB_CONTROL_SETUP_SIZE + HCI_INCOMING_PRE_BUFFER_SIZE + HCI_ACL_BUFFER_SIZE ); // biggest packet ever to expect
 
 #ifdef ENABLE_SCO_OVER_HCI
     sco_transfer_list = usb_transfer_list_alloc(
-            SCO_OUT_BUFFER_COUNT+SCO_IN_BUFFER_COUNT,
+            usb_num_sco_out_transfers+usb_num_sco_in_transfers,
             NUM_ISO_PACKETS,
             SCO_PACKET_SIZE
             );
@@ -1184,14 +1286,19 @@ static int usb_open(void){
 
     libusb_state = LIB_USB_TRANSFERS_ALLOCATED;
 
-    for (c = 0 ; c < EVENT_IN_BUFFER_COUNT ; c++) {
+    memset(usb_endpoint_stats, 0, sizeof(usb_endpoint_stats));
+    log_info("Transfers: %u event in, %u acl in, %u out", usb_num_event_in_transfers, usb_num_acl_in_transfers, usb_num_out_transfers);
+
+    // incoming packets are delivered in place with HCI_INCOMING_PRE_BUFFER_SIZE headroom
+    for (c = 0 ; c < usb_num_event_in_transfers ; c++) {
         struct libusb_transfer *transfer = usb_transfer_list_acquire( default_transfer_list );
-        uint8_t *data = transfer->buffer;
+        usb_transfer_list_entry_t *transfer_meta_data = (usb_transfer_list_entry_t*)transfer->user_data;
+        uint8_t *data = transfer_meta_data->data;
         void *user_data = transfer->user_data;
         // configure event_in handlers      
         libusb_fill_interrupt_transfer(transfer, handle, event_in_addr,
-                data, HCI_ACL_BUFFER_SIZE, async_callback, user_data, 0);
-        r = libusb_submit_transfer(transfer);
+                data + HCI_INCOMING_PRE_BUFFER_SIZE, HCI_ACL_BUFFER_SIZE, async_callback, user_data, 0);
+        r = usb_submit_transfer(transfer);
         if (r) {
             log_error("Error submitting interrupt transfer %d", r);
             usb_close();
@@ -1199,7 +1306,7 @@ static int usb_open(void){
         }
     }
 
-    for (c = 0 ; c < ACL_IN_BUFFER_COUNT ; c++) {
+    for (c = 0 ; c < usb_num_acl_in_transfers ; c++) {
         struct libusb_transfer *transfer = usb_transfer_list_acquire( default_transfer_list );
         usb_transfer_list_entry_t *transfer_meta_data = (usb_transfer_list_entry_t*)transfer->user_data;
         uint8_t *data = transfer_meta_data->data;
@@ -1207,7 +1314,7 @@ static int usb_open(void){
         // configure acl_in handlers
         libusb_fill_bulk_transfer(transfer, handle, acl_in_addr,
                 data + HCI_INCOMING_PRE_BUFFER_SIZE, HCI_ACL_BUFFER_SIZE, async_callback, user_data, 0) ;
-        r = libusb_submit_transfer(transfer);
+        r = usb_submit_transfer(transfer);
         if (r) {
             log_error("Error submitting bulk in transfer %d", r);
             usb_close();
@@ -1391,7 +1498,7 @@ static int usb_send_cmd_packet(uint8_t *packet, int size){
 //    printf("%s( %p, %d )\n", __FUNCTION__, packet, size );
 
     struct libusb_transfer *transfer = usb_transfer_list_acquire( default_transfer_list );
-    uint8_t *data = transfer->buffer;
+    uint8_t *data = ((usb_transfer_list_entry_t*)transfer->user_data)->data;
     void *user_data = transfer->user_data;
 
     // async
@@ -1402,7 +1509,7 @@ static int usb_send_cmd_packet(uint8_t *packet, int size){
     libusb_fill_control_transfer(transfer, handle, data, async_callback, user_data, 0);
 
     // submit transfer
-    r = libusb_submit_transfer(transfer);
+    r = usb_submit_transfer(transfer);
 
     if (r < 0) {
         log_error("Error submitting cmd transfer %d", r);
@@ -1422,14 +1529,14 @@ static int usb_send_acl_packet(uint8_t *packet, int size){
     // log_info("usb_send_acl_packet enter, size %u", size);
 
     struct libusb_transfer *transfer = usb_transfer_list_acquire( default_transfer_list );
-    uint8_t *data = transfer->buffer;
+    uint8_t *data = ((usb_transfer_list_entry_t*)transfer->user_data)->data;
 
     // prepare transfer
     memcpy( data, packet, size );
     libusb_fill_bulk_transfer(transfer, handle, acl_out_addr, data, size,
         async_callback, transfer->user_data, 0);
 
-    r = libusb_submit_transfer(transfer);
+    r = usb_submit_transfer(transfer);
 
     if (r < 0) {
         log_error("Error submitting acl transfer, %d", r);
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/*
+ *  hci_transport_h2_libusb.h
+ *
+ *  libusb specific extensions of the HCI Transport USB API
+ */
+
+#ifndef HCI_TRANSPORT_H2_LIBUSB_H
+#define HCI_TRANSPORT_H2_LIBUSB_H
+
+#include <stdint.h>
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/* API_START */
+
+typedef enum {
+    HCI_TRANSPORT_USB_ENDPOINT_CONTROL_OUT = 0,
+    HCI_TRANSPORT_USB_ENDPOINT_EVENT_IN,
+    HCI_TRANSPORT_USB_ENDPOINT_ACL_IN,
+    HCI_TRANSPORT_USB_ENDPOINT_ACL_OUT,
+    HCI_TRANSPORT_USB_ENDPOINT_SCO_IN,
+    HCI_TRANSPORT_USB_ENDPOINT_SCO_OUT,
+    HCI_TRANSPORT_USB_ENDPOINT_NUM
+} hci_transport_usb_endpoint_t;
+
+typedef struct {
+    uint32_t transfers_submitted;
+    uint32_t transfers_completed;
+    uint32_t transfers_stalled;
+} hci_transport_usb_endpoint_stats_t;
+
+/**
+ * @brief Set number of transfers kept in flight per endpoint type, must be called before transport is opened
+ * @note Use 0 to keep default for an endpoint type.
+ * @param num_event_in interrupt transfers for HCI Events, default: 3
+ * @param num_acl_in bulk transfers for incoming ACL/ISO packets, default: 3
+ * @param num_out transfers shared by outgoing HCI Commands and ACL/ISO packets, default: 4
+ * @param num_sco_in isochronous transfers for incoming SCO packets, default: 10
+ * @param num_sco_out isochronous transfers for outgoing SCO packets, default: 8
+ */
+void hci_transport_usb_set_num_transfers(uint8_t num_event_in, uint8_t num_acl_in, uint8_t num_out, uint8_t num_sco_in, uint8_t num_sco_out);
+
+/**
+ * @brief Get transfer statistics for endpoint, reset when transport is opened
+ * @param endpoint
+ * @param stats
+ */
+void hci_transport_usb_get_endpoint_stats(hci_transport_usb_endpoint_t endpoint, hci_transport_usb_endpoint_stats_t * stats);
+
+/**
+ * @brief Log transfer statistics for all endpoints
+ */
+void hci_transport_usb_dump_stats(void);
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // HCI_TRANSPORT_H2_LIBUSB_H
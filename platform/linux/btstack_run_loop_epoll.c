@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at 
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "btstack_run_loop_epoll.c"
+
+/*
+ *  btstack_run_loop_epoll.c
+ *
+ *  Linux run loop based on epoll and eventfd
+ */
+
+// enable Linux specific functions
+#define _GNU_SOURCE
+
+#include "btstack_run_loop_epoll.h"
+
+#include "btstack_run_loop.h"
+#include "btstack_util.h"
+#include "btstack_linked_list.h"
+#include "btstack_debug.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// max number of events fetched per epoll_wait
+#ifndef BTSTACK_RUN_LOOP_EPOLL_MAX_EVENTS
+#define BTSTACK_RUN_LOOP_EPOLL_MAX_EVENTS 32
+#endif
+
+// data source registered for a file descriptor and the epoll events currently requested for it
+typedef struct {
+    btstack_data_source_t * data_source;
+    uint32_t events;
+} btstack_run_loop_epoll_fd_entry_t;
+
+// the run loop
+static int btstack_run_loop_epoll_fd = -1;
+
+static bool btstack_run_loop_epoll_exit_requested;
+
+// data sources indexed by file descriptor
+static btstack_run_loop_epoll_fd_entry_t * btstack_run_loop_epoll_fd_entries;
+static int                                 btstack_run_loop_epoll_fd_entries_count;
+
+// to trigger process callbacks other thread
+static pthread_mutex_t       btstack_run_loop_epoll_callbacks_mutex = PTHREAD_MUTEX_INITIALIZER;
+static btstack_data_source_t btstack_run_loop_epoll_process_callbacks_ds;
+
+// to trigger poll data sources from irq
+static btstack_data_source_t btstack_run_loop_epoll_poll_data_sources_ds;
+
+// start time. tv_nsec = 0
+static struct timespec init_ts;
+
+static uint32_t btstack_run_loop_epoll_events_for_flags(uint16_t flags){
+    uint32_t events = 0;
+    if ((flags & DATA_SOURCE_CALLBACK_READ) != 0){
+        events |= EPOLLIN;
+    }
+    if ((flags & DATA_SOURCE_CALLBACK_WRITE) != 0){
+        events |= EPOLLOUT;
+    }
+    if ((flags & DATA_SOURCE_CALLBACK_ERROR) != 0){
+        events |= EPOLLERR;
+    }
+    return events;
+}
+
+static btstack_run_loop_epoll_fd_entry_t * btstack_run_loop_epoll_get_fd_entry(int fd){
+    if ((fd < 0) || (fd >= btstack_run_loop_epoll_fd_entries_count)) {
+        return NULL;
+    }
+    return &btstack_run_loop_epoll_fd_entries[fd];
+}
+
+static bool btstack_run_loop_epoll_reserve_fd_entry(int fd){
+    if (fd < btstack_run_loop_epoll_fd_entries_count) {
+        return true;
+    }
+    int new_count = btstack_max(16, btstack_run_loop_epoll_fd_entries_count);
+    while (new_count <= fd){
+        new_count *= 2;
+    }
+    btstack_run_loop_epoll_fd_entry_t * new_entries = (btstack_run_loop_epoll_fd_entry_t *) realloc(btstack_run_loop_epoll_fd_entries,
+                                                                                             new_count * sizeof(btstack_run_loop_epoll_fd_entry_t));
+    if (new_entries == NULL){
+        return false;
+    }
+    memset(&new_entries[btstack_run_loop_epoll_fd_entries_count], 0,
+           (new_count - btstack_run_loop_epoll_fd_entries_count) * sizeof(btstack_run_loop_epoll_fd_entry_t));
+    btstack_run_loop_epoll_fd_entries = new_entries;
+    btstack_run_loop_epoll_fd_entries_count = new_count;
+    return true;
+}
+
+// register, modify, or unregister fd with epoll according to enabled callbacks
+static void btstack_run_loop_epoll_update_events(btstack_data_source_t * ds){
+    btstack_run_loop_epoll_fd_entry_t * entry = btstack_run_loop_epoll_get_fd_entry(ds->source.fd);
+    if ((entry == NULL) || (entry->data_source != ds)) {
+        // not added yet, events are registered in add_data_source
+        return;
+    }
+    uint32_t events = btstack_run_loop_epoll_events_for_flags(ds->flags);
+    if (events == entry->events){
+        return;
+    }
+    int op;
+    if (entry->events == 0){
+        op = EPOLL_CTL_ADD;
+    } else if (events == 0){
+        op = EPOLL_CTL_DEL;
+    } else {
+        op = EPOLL_CTL_MOD;
+    }
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events  = events;
+    event.data.fd = ds->source.fd;
+    int res = epoll_ctl(btstack_run_loop_epoll_fd, op, ds->source.fd, &event);
+    if (res < 0){
+        log_error("epoll_ctl(%d) for fd %d failed, errno %d", op, ds->source.fd, errno);
+        return;
+    }
+    entry->events = events;
+}
+
+/**
+ * Add data_source to run_loop
+ */
+static void btstack_run_loop_epoll_add_data_source(btstack_data_source_t *ds){
+    btstack_run_loop_base_add_data_source(ds);
+    int fd = ds->source.fd;
+    if (fd < 0) return;
+    if (btstack_run_loop_epoll_reserve_fd_entry(fd) == false){
+        log_error("cannot track fd %d", fd);
+        return;
+    }
+    btstack_run_loop_epoll_fd_entry_t * entry = &btstack_run_loop_epoll_fd_entries[fd];
+    if ((entry->data_source != NULL) && (entry->data_source != ds)){
+        log_error("fd %d already used by data source %p", fd, (void *) entry->data_source);
+        return;
+    }
+    entry->data_source = ds;
+    btstack_run_loop_epoll_update_events(ds);
+}
+
+/**
+ * Remove data_source from run loop
+ */
+static bool btstack_run_loop_epoll_remove_data_source(btstack_data_source_t *ds){
+    btstack_run_loop_epoll_fd_entry_t * entry = btstack_run_loop_epoll_get_fd_entry(ds->source.fd);
+    if ((entry != NULL) && (entry->data_source == ds)){
+        if (entry->events != 0){
+            int res = epoll_ctl(btstack_run_loop_epoll_fd, EPOLL_CTL_DEL, ds->source.fd, NULL);
+            // fd might have been closed already, which removes it from the epoll set
+            if ((res < 0) && (errno != EBADF) && (errno != ENOENT)){
+                log_error("epoll_ctl(DEL) for fd %d failed, errno %d", ds->source.fd, errno);
+            }
+        }
+        entry->data_source = NULL;
+        entry->events = 0;
+    }
+    return btstack_run_loop_base_remove_data_source(ds);
+}
+
+static void btstack_run_loop_epoll_enable_data_source_callbacks(btstack_data_source_t * ds, uint16_t callback_types){
+    btstack_run_loop_base_enable_data_source_callbacks(ds, callback_types);
+    btstack_run_loop_epoll_update_events(ds);
+}
+
+static void btstack_run_loop_epoll_disable_data_source_callbacks(btstack_data_source_t * ds, uint16_t callback_types){
+    btstack_run_loop_base_disable_data_source_callbacks(ds, callback_types);
+    btstack_run_loop_epoll_update_events(ds);
+}
+
+/**
+ * @brief Queries the current time in ms since start
+ */
+static uint32_t btstack_run_loop_epoll_get_time_ms(void){
+    struct timespec now_ts;
+    clock_gettime(CLOCK_MONOTONIC, &now_ts);
+    int64_t delta_sec  = (int64_t) now_ts.tv_sec - (int64_t) init_ts.tv_sec;
+    int64_t delta_nsec = (int64_t) now_ts.tv_nsec;
+    return (uint32_t) ((delta_sec * 1000) + (delta_nsec / 1000000));
+}
+
+// the data source might have been removed or replaced by a previous callback
+static bool btstack_run_loop_epoll_data_source_active(int fd, btstack_data_source_t * ds){
+    btstack_run_loop_epoll_fd_entry_t * entry = btstack_run_loop_epoll_get_fd_entry(fd);
+    return (entry != NULL) && (entry->data_source == ds);
+}
+
+static void btstack_run_loop_epoll_process_event(const struct epoll_event * event){
+    int fd = event->data.fd;
+    btstack_run_loop_epoll_fd_entry_t * entry = btstack_run_loop_epoll_get_fd_entry(fd);
+    if ((entry == NULL) || (entry->data_source == NULL)) return;
+    btstack_data_source_t * ds = entry->data_source;
+    uint32_t events = event->events;
+
+    // hang-up and errors are reported as readable/writable, same as select()
+    if (((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) && ((ds->flags & DATA_SOURCE_CALLBACK_READ) != 0)){
+        log_debug("btstack_run_loop_epoll_execute: process read ds %p with fd %u\n", ds, fd);
+        ds->process(ds, DATA_SOURCE_CALLBACK_READ);
+        if (btstack_run_loop_epoll_data_source_active(fd, ds) == false) return;
+    }
+    if (((events & (EPOLLOUT | EPOLLERR)) != 0) && ((ds->flags & DATA_SOURCE_CALLBACK_WRITE) != 0)){
+        log_debug("btstack_run_loop_epoll_execute: process write ds %p with fd %u\n", ds, fd);
+        ds->process(ds, DATA_SOURCE_CALLBACK_WRITE);
+        if (btstack_run_loop_epoll_data_source_active(fd, ds) == false) return;
+    }
+    if (((events & EPOLLERR) != 0) && ((ds->flags & DATA_SOURCE_CALLBACK_ERROR) != 0)){
+        log_debug("btstack_run_loop_epoll_execute: process error ds %p with fd %u\n", ds, fd);
+        ds->process(ds, DATA_SOURCE_CALLBACK_ERROR);
+    }
+}
+
+/**
+ * Execute run_loop
+ */
+static void btstack_run_loop_epoll_execute(void) {
+    struct epoll_event events[BTSTACK_RUN_LOOP_EPOLL_MAX_EVENTS];
+
+    log_info("Linux epoll run loop");
+
+    // clear exit flag
+    btstack_run_loop_epoll_exit_requested = false;
+
+    while (btstack_run_loop_epoll_exit_requested == false) {
+
+        // get next timeout
+        uint32_t now_ms = btstack_run_loop_epoll_get_time_ms();
+        int32_t delta_ms = btstack_run_loop_base_get_time_until_timeout(now_ms);
+        if (delta_ms >= 0) {
+            log_debug("btstack_run_loop_execute next timeout in %u ms", delta_ms);
+        }
+
+        // wait for ready FDs
+        int res = epoll_wait(btstack_run_loop_epoll_fd, events, BTSTACK_RUN_LOOP_EPOLL_MAX_EVENTS, (int) delta_ms);
+        if ((res < 0) && (errno != EINTR)){
+            log_error("btstack_run_loop_epoll_execute: epoll_wait -> errno %u", errno);
+        }
+        int i;
+        for (i = 0; i < res; i++){
+            btstack_run_loop_epoll_process_event(&events[i]);
+        }
+
+        // process timers
+        now_ms = btstack_run_loop_epoll_get_time_ms();
+        btstack_run_loop_base_process_timers(now_ms);
+    }
+}
+
+static void btstack_run_loop_epoll_trigger_exit(void){
+    btstack_run_loop_epoll_exit_requested = true;
+}
+
+// set timer
+static void btstack_run_loop_epoll_set_timer(btstack_timer_source_t *a, uint32_t timeout_in_ms){
+    uint32_t time_ms = btstack_run_loop_epoll_get_time_ms();
+    a->timeout = time_ms + timeout_in_ms;
+    log_debug("btstack_run_loop_epoll_set_timer to %u ms (now %u, timeout %u)", a->timeout, time_ms, timeout_in_ms);
+}
+
+// signal eventfd
+static void btstack_run_loop_epoll_trigger_eventfd(int fd){
+    if (fd < 0) return;
+    const uint64_t value = 1;
+    ssize_t bytes_written = write(fd, &value, sizeof(value));
+    UNUSED(bytes_written);
+}
+
+// reset eventfd counter
+static void btstack_run_loop_epoll_clear_eventfd(int fd){
+    uint64_t value;
+    ssize_t bytes_read = read(fd, &value, sizeof(value));
+    UNUSED(bytes_read);
+}
+
+// poll data sources from irq
+
+static void btstack_run_loop_epoll_poll_data_sources_handler(btstack_data_source_t * ds, btstack_data_source_callback_type_t callback_type){
+    UNUSED(callback_type);
+    btstack_run_loop_epoll_clear_eventfd(ds->source.fd);
+    // poll data sources
+    btstack_run_loop_base_poll_data_sources();
+}
+
+static void btstack_run_loop_epoll_poll_data_sources_from_irq(void){
+    // trigger run loop
+    btstack_run_loop_epoll_trigger_eventfd(btstack_run_loop_epoll_poll_data_sources_ds.source.fd);
+}
+
+// execute on main thread from same or different thread
+
+static void btstack_run_loop_epoll_process_callbacks_handler(btstack_data_source_t * ds, btstack_data_source_callback_type_t callback_type){
+    UNUSED(callback_type);
+    btstack_run_loop_epoll_clear_eventfd(ds->source.fd);
+    // execute callbacks - protect list with mutex
+    while (1){
+        pthread_mutex_lock(&btstack_run_loop_epoll_callbacks_mutex);
+        btstack_context_callback_registration_t * callback_registration = (btstack_context_callback_registration_t *) btstack_linked_list_pop(&btstack_run_loop_base_callbacks);
+        pthread_mutex_unlock(&btstack_run_loop_epoll_callbacks_mutex);
+        if (callback_registration == NULL){
+            break;
+        }
+        (*callback_registration->callback)(callback_registration->context);
+    }
+}
+
+static void btstack_run_loop_epoll_execute_on_main_thread(btstack_context_callback_registration_t * callback_registration){
+    // protect list with mutex
+    pthread_mutex_lock(&btstack_run_loop_epoll_callbacks_mutex);
+    btstack_run_loop_base_add_callback(callback_registration);
+    pthread_mutex_unlock(&btstack_run_loop_epoll_callbacks_mutex);
+    // trigger run loop
+    btstack_run_loop_epoll_trigger_eventfd(btstack_run_loop_epoll_process_callbacks_ds.source.fd);
+}
+
+//init
+
+static void btstack_run_loop_epoll_register_eventfd_datasource(btstack_data_source_t * data_source){
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0){
+        log_error("eventfd() failed");
+    }
+    data_source->source.fd = fd;
+    data_source->flags = DATA_SOURCE_CALLBACK_READ;
+    btstack_run_loop_epoll_add_data_source(data_source);
+    log_info("Eventfd: %d", fd);
+}
+
+static void btstack_run_loop_epoll_init(void){
+    btstack_run_loop_base_init();
+
+    clock_gettime(CLOCK_MONOTONIC, &init_ts);
+    init_ts.tv_nsec = 0;
+
+    // reset fd table
+    free(btstack_run_loop_epoll_fd_entries);
+    btstack_run_loop_epoll_fd_entries = NULL;
+    btstack_run_loop_epoll_fd_entries_count = 0;
+
+    if (btstack_run_loop_epoll_fd >= 0){
+        close(btstack_run_loop_epoll_fd);
+    }
+    btstack_run_loop_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (btstack_run_loop_epoll_fd < 0){
+        log_error("epoll_create1() failed, errno %d", errno);
+    }
+
+    // setup eventfd to trigger process callbacks
+    btstack_run_loop_epoll_process_callbacks_ds.process = &btstack_run_loop_epoll_process_callbacks_handler;
+    btstack_run_loop_epoll_register_eventfd_datasource(&btstack_run_loop_epoll_process_callbacks_ds);
+
+    // setup eventfd to poll data sources
+    btstack_run_loop_epoll_poll_data_sources_ds.process = &btstack_run_loop_epoll_poll_data_sources_handler;
+    btstack_run_loop_epoll_register_eventfd_datasource(&btstack_run_loop_epoll_poll_data_sources_ds);
+}
+
+static const btstack_run_loop_t btstack_run_loop_epoll = {
+    &btstack_run_loop_epoll_init,
+    &btstack_run_loop_epoll_add_data_source,
+    &btstack_run_loop_epoll_remove_data_source,
+    &btstack_run_loop_epoll_enable_data_source_callbacks,
+    &btstack_run_loop_epoll_disable_data_source_callbacks,
+    &btstack_run_loop_epoll_set_timer,
+    &btstack_run_loop_base_add_timer,
+    &btstack_run_loop_base_remove_timer,
+    &btstack_run_loop_epoll_execute,
+    &btstack_run_loop_base_dump_timer,
+    &btstack_run_loop_epoll_get_time_ms,
+    &btstack_run_loop_epoll_poll_data_sources_from_irq,
+    &btstack_run_loop_epoll_execute_on_main_thread,
+    &btstack_run_loop_epoll_trigger_exit,
+};
+
+/**
+ * Provide btstack_run_loop_epoll instance
+ */
+const btstack_run_loop_t * btstack_run_loop_epoll_get_instance(void){
+    return &btstack_run_loop_epoll;
+}
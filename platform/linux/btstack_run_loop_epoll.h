@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at 
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/*
+ *  btstack_run_loop_epoll.h
+ *  Functionality special to the Linux epoll run loop
+ *
+ *  Drop-in replacement for the POSIX run loop on Linux. File descriptors are registered with epoll
+ *  when the data source is added or its callbacks change, so waiting and dispatching does not depend
+ *  on the number of registered data sources and file descriptors are not limited by FD_SETSIZE.
+ *
+ *  Data sources are level-triggered, i.e. a data source is called again as long as its fd is ready.
+ *  Only a single data source can be registered per file descriptor.
+ */
+
+#ifndef BTSTACK_RUN_LOOP_EPOLL_H
+#define BTSTACK_RUN_LOOP_EPOLL_H
+
+#include "btstack_run_loop.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Provide btstack_run_loop_epoll instance
+ */
+const btstack_run_loop_t * btstack_run_loop_epoll_get_instance(void);
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // BTSTACK_RUN_LOOP_EPOLL_H
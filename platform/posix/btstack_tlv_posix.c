@@ -40,6 +40,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 
 // Header:
@@ -59,9 +60,16 @@
 
 static const char * btstack_tlv_header_magic = "BTstack";
 
+#define BTSTACK_TLV_ENTRY_HEADER_LEN 8
+
+#if (BTSTACK_TLV_POSIX_NUM_BUCKETS & (BTSTACK_TLV_POSIX_NUM_BUCKETS - 1)) != 0
+#error "BTSTACK_TLV_POSIX_NUM_BUCKETS must be a power of two"
+#endif
+
 #define DUMMY_SIZE 4
 typedef struct tlv_entry {
 	void   * next;
+	struct tlv_entry * bucket_next;
 	uint32_t tag;
 	uint32_t len;
 	uint8_t  value[DUMMY_SIZE];	// dummy size
@@ -70,51 +78,112 @@ typedef struct tlv_entry {
 // testing support
 static bool btstack_tlv_posix_read_only = false;
 
-static void btstack_tlv_posix_append_tag(btstack_tlv_posix_t * self, uint32_t tag, const uint8_t * data, uint32_t data_size){
-
-	if (!self->file) return;
-
-	log_info("append tag %04x, len %u", tag, data_size);
+static void btstack_tlv_posix_sync(btstack_tlv_posix_t * self){
+	switch (self->sync_policy){
+		case BTSTACK_TLV_POSIX_SYNC_FLUSH:
+			fflush(self->file);
+			break;
+		case BTSTACK_TLV_POSIX_SYNC_FSYNC:
+			fflush(self->file);
+			fsync(fileno(self->file));
+			break;
+		default:
+			break;
+	}
+}
 
-	uint8_t header[8];
+static int btstack_tlv_posix_write_tag(FILE * file, uint32_t tag, const uint8_t * data, uint32_t data_size){
+	uint8_t header[BTSTACK_TLV_ENTRY_HEADER_LEN];
 	big_endian_store_32(header, 0, tag);
 	big_endian_store_32(header, 4, data_size);
-	size_t written_header = fwrite(header, 1, sizeof(header), self->file);
-	if (written_header != sizeof(header)) return;
+	size_t written_header = fwrite(header, 1, sizeof(header), file);
+	if (written_header != sizeof(header)) return -1;
 	if (data_size > 0) {
-		size_t written_value = fwrite(data, 1, data_size, self->file);
-		if (written_value != data_size) return;
+		size_t written_value = fwrite(data, 1, data_size, file);
+		if (written_value != data_size) return -1;
 	}
-	fflush(self->file);
+	return 0;
 }
 
-static tlv_entry_t * btstack_tlv_posix_find_entry(btstack_tlv_posix_t * self, uint32_t tag){
+// write header and all live entries
+static int btstack_tlv_posix_write_db(btstack_tlv_posix_t * self, FILE * file){
+	uint8_t header[BTSTACK_TLV_HEADER_LEN];
+	memset(header, 0, sizeof(header));
+	strcpy((char *)header, btstack_tlv_header_magic);
+	if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) return -1;
 	btstack_linked_list_iterator_t it;
 	btstack_linked_list_iterator_init(&it, &self->entry_list);
 	while (btstack_linked_list_iterator_has_next(&it)){
 		tlv_entry_t * entry = (tlv_entry_t*) btstack_linked_list_iterator_next(&it);
-		if (entry->tag != tag) continue;
-		return entry;
+		if (btstack_tlv_posix_write_tag(file, entry->tag, &entry->value[0], entry->len) != 0) return -1;
+	}
+	return 0;
+}
+
+static void btstack_tlv_posix_append_tag(btstack_tlv_posix_t * self, uint32_t tag, const uint8_t * data, uint32_t data_size){
+
+	if (!self->file) return;
+
+	log_info("append tag %04x, len %u", tag, data_size);
+
+	if (btstack_tlv_posix_write_tag(self->file, tag, data, data_size) != 0) return;
+	self->file_bytes += BTSTACK_TLV_ENTRY_HEADER_LEN + data_size;
+	btstack_tlv_posix_sync(self);
+}
+
+static uint32_t btstack_tlv_posix_bucket_for_tag(uint32_t tag){
+	// multiplicative hashing, use upper bits
+	return ((tag * 2654435761u) >> 24) & (BTSTACK_TLV_POSIX_NUM_BUCKETS - 1u);
+}
+
+static tlv_entry_t * btstack_tlv_posix_find_entry(btstack_tlv_posix_t * self, uint32_t tag){
+	tlv_entry_t * entry = (tlv_entry_t *) self->entry_buckets[btstack_tlv_posix_bucket_for_tag(tag)];
+	while (entry != NULL){
+		if (entry->tag == tag) return entry;
+		entry = entry->bucket_next;
 	}
 	return NULL;
 }
 
+static void btstack_tlv_posix_add_entry(btstack_tlv_posix_t * self, tlv_entry_t * entry){
+	uint32_t bucket = btstack_tlv_posix_bucket_for_tag(entry->tag);
+	entry->bucket_next = (tlv_entry_t *) self->entry_buckets[bucket];
+	self->entry_buckets[bucket] = entry;
+	btstack_linked_list_add(&self->entry_list, (btstack_linked_item_t *) entry);
+	self->live_bytes += BTSTACK_TLV_ENTRY_HEADER_LEN + entry->len;
+}
+
+static void btstack_tlv_posix_remove_entry(btstack_tlv_posix_t * self, tlv_entry_t * entry){
+	tlv_entry_t ** it = (tlv_entry_t **) &self->entry_buckets[btstack_tlv_posix_bucket_for_tag(entry->tag)];
+	while (*it != entry){
+		it = &(*it)->bucket_next;
+	}
+	*it = entry->bucket_next;
+	btstack_linked_list_remove(&self->entry_list, (btstack_linked_item_t *) entry);
+	self->live_bytes -= BTSTACK_TLV_ENTRY_HEADER_LEN + entry->len;
+	free(entry);
+}
+
+static void btstack_tlv_posix_compact_if_needed(btstack_tlv_posix_t * self){
+	if (self->file == NULL) return;
+	uint32_t garbage_bytes = self->file_bytes - self->live_bytes;
+	if (garbage_bytes < BTSTACK_TLV_POSIX_COMPACTION_THRESHOLD) return;
+	if (garbage_bytes < self->live_bytes) return;
+	log_info("compact db, live %u, garbage %u bytes", self->live_bytes, garbage_bytes);
+	btstack_tlv_posix_compact(self);
+}
+
 /**
  * Delete Tag
  * @param tag
  */
 static void btstack_tlv_posix_delete_tag(void * context, uint32_t tag){
 	btstack_tlv_posix_t * self = (btstack_tlv_posix_t *) context;
-	btstack_linked_list_iterator_t it;
-	btstack_linked_list_iterator_init(&it, &self->entry_list);
-	while (btstack_linked_list_iterator_has_next(&it)){
-		tlv_entry_t * entry = (tlv_entry_t*) btstack_linked_list_iterator_next(&it);
-		if (entry->tag != tag) continue;
-		btstack_linked_list_iterator_remove(&it);
-		free(entry);
-		btstack_tlv_posix_append_tag(self, tag, NULL, 0);
-		return;
-	}
+	tlv_entry_t * entry = btstack_tlv_posix_find_entry(self, tag);
+	if (entry == NULL) return;
+	btstack_tlv_posix_remove_entry(self, entry);
+	btstack_tlv_posix_append_tag(self, tag, NULL, 0);
+	btstack_tlv_posix_compact_if_needed(self);
 }
 
 /**
@@ -152,8 +221,7 @@ static int btstack_tlv_posix_store_tag(void * context, uint32_t tag, const uint8
 	// remove old entry
 	tlv_entry_t * old_entry = btstack_tlv_posix_find_entry(self, tag);
 	if (old_entry){
-		btstack_linked_list_remove(&self->entry_list, (btstack_linked_item_t *) old_entry);
-		free(old_entry);
+		btstack_tlv_posix_remove_entry(self, old_entry);
 	}
 
 	// create new entry
@@ -166,11 +234,12 @@ static int btstack_tlv_posix_store_tag(void * context, uint32_t tag, const uint8
 	memcpy(&new_entry->value[0], data, data_size);
 
 	// append new entry
-	btstack_linked_list_add(&self->entry_list, (btstack_linked_item_t *) new_entry);
+	btstack_tlv_posix_add_entry(self, new_entry);
 
 	// write new tag
 	btstack_tlv_posix_append_tag(self, tag, data, data_size);
 
+	btstack_tlv_posix_compact_if_needed(self);
 	return 0;
 }
 
@@ -221,14 +290,14 @@ static int btstack_tlv_posix_read_db(btstack_tlv_posix_t * self){
                     // remove old entry
                     tlv_entry_t * old_entry = btstack_tlv_posix_find_entry(self, tag);
                     if (old_entry){
-                        btstack_linked_list_remove(&self->entry_list, (btstack_linked_item_t *) old_entry);
-                        free(old_entry);
+                        btstack_tlv_posix_remove_entry(self, old_entry);
                     }
 
                     // append new entry
                     if (new_entry){
-	                    btstack_linked_list_add(&self->entry_list, (btstack_linked_item_t *) new_entry);
+                        btstack_tlv_posix_add_entry(self, new_entry);
                     }
+                    self->file_bytes += BTSTACK_TLV_ENTRY_HEADER_LEN + len;
 		    	}
 	    	}
 	    }
@@ -253,20 +322,55 @@ static int btstack_tlv_posix_read_db(btstack_tlv_posix_t * self){
             log_error("failed to create file");
             return -1;
         }
-	    memset(header, 0, sizeof(header));
-	    strcpy((char *)header, btstack_tlv_header_magic);
-	    fwrite(header, 1, sizeof(header), self->file);
-	    // write out all valid entries (if any)
-		btstack_linked_list_iterator_t it;
-		btstack_linked_list_iterator_init(&it, &self->entry_list);
-		while (btstack_linked_list_iterator_has_next(&it)){
-			tlv_entry_t * entry = (tlv_entry_t*) btstack_linked_list_iterator_next(&it);
-			btstack_tlv_posix_append_tag(self, entry->tag, &entry->value[0], entry->len);
-		}
+	    // write out header and all valid entries (if any)
+	    btstack_tlv_posix_write_db(self, self->file);
+	    self->file_bytes = self->live_bytes;
+	    btstack_tlv_posix_sync(self);
+    } else {
+        // drop overwritten and deleted tags from file
+        btstack_tlv_posix_compact_if_needed(self);
     }
 	return 0;
 }
 
+int btstack_tlv_posix_compact(btstack_tlv_posix_t * self){
+	if (self->file == NULL) return -1;
+
+	// write live entries to temp file next to db
+	size_t path_len = strlen(self->db_path);
+	char * tmp_path = (char *) malloc(path_len + 5);
+	if (tmp_path == NULL) return -1;
+	memcpy(tmp_path, self->db_path, path_len);
+	memcpy(&tmp_path[path_len], ".tmp", 5);
+
+	int err = -1;
+	FILE * file = fopen(tmp_path, "w+");
+	if (file != NULL){
+		err = btstack_tlv_posix_write_db(self, file);
+		// data needs to be on disk before rename
+		if ((err == 0) && ((fflush(file) != 0) || (fsync(fileno(file)) != 0))){
+			err = -1;
+		}
+		if ((err == 0) && (rename(tmp_path, self->db_path) != 0)){
+			err = -1;
+		}
+		if (err == 0){
+			// continue appending to new file
+			fclose(self->file);
+			self->file = file;
+			self->file_bytes = self->live_bytes;
+		} else {
+			fclose(file);
+			unlink(tmp_path);
+		}
+	}
+	if (err != 0){
+		log_error("compaction failed");
+	}
+	free(tmp_path);
+	return err;
+}
+
 static const btstack_tlv_t btstack_tlv_posix = {
 	/* int  (*get_tag)(..);     */ &btstack_tlv_posix_get_tag,
 	/* int (*store_tag)(..);    */ &btstack_tlv_posix_store_tag,
@@ -291,8 +395,19 @@ void btstack_tlv_posix_set_read_only(void){
     btstack_tlv_posix_read_only = true;
 }
 
+void btstack_tlv_posix_set_sync_policy(btstack_tlv_posix_t * self, btstack_tlv_posix_sync_policy_t sync_policy){
+	self->sync_policy = sync_policy;
+}
+
+int btstack_tlv_posix_flush(btstack_tlv_posix_t * self){
+	if (self->file == NULL) return 0;
+	if (fflush(self->file) != 0) return -1;
+	if (fsync(fileno(self->file)) != 0) return -1;
+	return 0;
+}
+
 /**
- * Free TLV entries
+ * Free TLV entries and close file
  * @param self
  */
 void btstack_tlv_posix_deinit(btstack_tlv_posix_t * self){
@@ -304,5 +419,12 @@ void btstack_tlv_posix_deinit(btstack_tlv_posix_t * self){
 		btstack_linked_list_iterator_remove(&it);
 		free(entry);
     }
+    memset(self->entry_buckets, 0, sizeof(self->entry_buckets));
+    self->live_bytes = 0;
+    // close file, writes buffered tags
+    if (self->file != NULL){
+        fclose(self->file);
+        self->file = NULL;
+    }
     btstack_tlv_posix_read_only = true;
 }
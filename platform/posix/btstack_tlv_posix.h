@@ -48,10 +48,35 @@
 extern "C" {
 #endif
 
+// number of hash buckets for tag lookup, must be a power of two
+#ifndef BTSTACK_TLV_POSIX_NUM_BUCKETS
+#define BTSTACK_TLV_POSIX_NUM_BUCKETS 32
+#endif
+
+// compact file if garbage from overwritten/deleted tags exceeds this size and the size of all live tags
+#ifndef BTSTACK_TLV_POSIX_COMPACTION_THRESHOLD
+#define BTSTACK_TLV_POSIX_COMPACTION_THRESHOLD 4096
+#endif
+
+typedef enum {
+	// flush stdio buffer after each tag (default)
+	BTSTACK_TLV_POSIX_SYNC_FLUSH = 0,
+	// flush stdio buffer and fsync file after each tag
+	BTSTACK_TLV_POSIX_SYNC_FSYNC,
+	// leave flushing to stdio, e.g. when file is closed
+	BTSTACK_TLV_POSIX_SYNC_NONE,
+} btstack_tlv_posix_sync_policy_t;
+
 typedef struct {
 	btstack_linked_list_t entry_list;
 	const char * db_path;
 	FILE * file;
+	// entries by tag hash
+	void * entry_buckets[BTSTACK_TLV_POSIX_NUM_BUCKETS];
+	// size of live entries and of all entries in file, excluding header
+	uint32_t live_bytes;
+	uint32_t file_bytes;
+	btstack_tlv_posix_sync_policy_t sync_policy;
 } btstack_tlv_posix_t;
 
 /* API_START */
@@ -70,7 +95,30 @@ const btstack_tlv_t * btstack_tlv_posix_init_instance(btstack_tlv_posix_t * cont
 void btstack_tlv_posix_set_read_only(void);
 
 /**
- * Free TLV entries
+ * Set policy to sync file after writing a tag
+ * @param self
+ * @param sync_policy default: BTSTACK_TLV_POSIX_SYNC_FLUSH
+ */
+void btstack_tlv_posix_set_sync_policy(btstack_tlv_posix_t * self, btstack_tlv_posix_sync_policy_t sync_policy);
+
+/**
+ * Write all live tags to new file and replace current file
+ * @note called automatically if garbage exceeds BTSTACK_TLV_POSIX_COMPACTION_THRESHOLD
+ * @param self
+ * @return 0 on success
+ */
+int btstack_tlv_posix_compact(btstack_tlv_posix_t * self);
+
+/**
+ * Write buffered tags to file and sync file, e.g. with BTSTACK_TLV_POSIX_SYNC_NONE
+ * @param self
+ * @return 0 on success
+ */
+int btstack_tlv_posix_flush(btstack_tlv_posix_t * self);
+
+/**
+ * Free TLV entries and close file
+ * @note following instances are read-only
  * @param self
  */
 void btstack_tlv_posix_deinit(btstack_tlv_posix_t * self);
@@ -47,6 +47,7 @@
 #include "btstack_uart.h"
 #include "btstack_run_loop.h"
 #include "btstack_debug.h"
+#include "btstack_bool.h"
 
 #include <termios.h>  /* POSIX terminal control definitions */
 #include <fcntl.h>    /* File control definitions */
@@ -81,9 +82,13 @@ static const uint8_t * btstack_uart_block_write_bytes_data;
 static uint16_t  btstack_uart_block_read_bytes_len;
 static uint8_t * btstack_uart_block_read_bytes_data;
 
+// streaming read: deliver whatever is available instead of waiting for the full block
+static bool      btstack_uart_block_read_partial;
+
 // callbacks
 static void (*block_sent)(void);
 static void (*block_received)(void);
+static void (*bytes_received)(uint16_t bytes_received);
 
 static void hci_uart_posix_process(btstack_data_source_t *ds, btstack_data_source_callback_type_t callback_type);
 
@@ -162,6 +167,15 @@ static void btstack_uart_block_posix_process_read(btstack_data_source_t *ds) {
         return;
     }
 
+    if (btstack_uart_block_read_partial){
+        btstack_uart_block_read_bytes_len = 0;
+        btstack_run_loop_disable_data_source_callbacks(ds, DATA_SOURCE_CALLBACK_READ);
+        if (bytes_received){
+            bytes_received((uint16_t) bytes_read);
+        }
+        return;
+    }
+
     btstack_uart_block_read_bytes_len   -= bytes_read;
     btstack_uart_block_read_bytes_data  += bytes_read;
     if (btstack_uart_block_read_bytes_len > 0) return;
@@ -389,6 +403,11 @@ static void btstack_uart_posix_set_block_received( void (*block_handler)(void)){
     block_received = block_handler;
 }
 
+static void btstack_uart_posix_set_bytes_received( void (*bytes_handler)(uint16_t bytes_received)){
+    btstack_uart_block_read_bytes_len = 0;
+    bytes_received = bytes_handler;
+}
+
 static void btstack_uart_posix_set_block_sent( void (*block_handler)(void)){
     btstack_uart_block_write_bytes_len = 0;
     block_sent = block_handler;
@@ -474,6 +493,18 @@ static void btstack_uart_posix_receive_block(uint8_t *buffer, uint16_t len){
     btstack_assert(btstack_uart_block_read_bytes_len == 0);
 
     // setup async read
+    btstack_uart_block_read_partial = false;
+    btstack_uart_block_read_bytes_data = buffer;
+    btstack_uart_block_read_bytes_len = len;
+    btstack_run_loop_enable_data_source_callbacks(&transport_data_source, DATA_SOURCE_CALLBACK_READ);
+}
+
+static void btstack_uart_posix_receive_bytes(uint8_t *buffer, uint16_t len){
+    btstack_assert(btstack_uart_block_read_bytes_len == 0);
+    btstack_assert(len > 0);
+
+    // setup async read, complete with first read()
+    btstack_uart_block_read_partial = true;
     btstack_uart_block_read_bytes_data = buffer;
     btstack_uart_block_read_bytes_len = len;
     btstack_run_loop_enable_data_source_callbacks(&transport_data_source, DATA_SOURCE_CALLBACK_READ);
@@ -739,6 +770,8 @@ static const btstack_uart_t btstack_uart_posix = {
     .receive_frame           = NULL,
     .send_frame              = NULL,
 #endif
+    .set_bytes_received      = &btstack_uart_posix_set_bytes_received,
+    .receive_bytes           = &btstack_uart_posix_receive_bytes,
 };
 
 const btstack_uart_t * btstack_uart_posix_instance(void){
@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2014-2020 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at 
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "hci_dump_posix_async.c"
+
+/*
+ *  hci_dump_posix_async.c
+ *
+ *  Dump HCI trace in BlueZ's hcidump, Apple's PacketLogger or BTSnoop format into a file from a writer thread
+ *
+ *  Ring buffer records: 4 byte length in host byte order followed by file header and packet.
+ *  Special length values mark the end of data before the wrap around and a request to reset the file.
+ *  The BTstack thread only advances the write index, the writer thread only advances the read index.
+ */
+
+#include "btstack_config.h"
+
+// enable POSIX functions (needed for -std=c99)
+#define _POSIX_C_SOURCE 200809
+
+#ifdef __FreeBSD__
+// FreeBSD does not set __BSD_VISIBLE or __XSI_VISIBLE if _POSIX_C_SOURCE is defined
+#define __BSD_VISIBLE 1
+#define __XSI_VISIBLE 1
+#endif
+
+#include "hci_dump_posix_async.h"
+
+#include "btstack_debug.h"
+#include "btstack_util.h"
+
+#include <sys/time.h>     // for timestamps
+#include <sys/stat.h>     // file modes
+#include <sys/uio.h>      // writev
+
+#include <errno.h>        // errno
+#include <fcntl.h>        // open
+#include <pthread.h>
+#include <stdio.h>        // printf
+#include <stdlib.h>       // malloc
+#include <string.h>       // memcpy
+#include <time.h>         // clock_gettime
+#include <unistd.h>       // write
+
+#ifndef HCI_DUMP_POSIX_ASYNC_RING_BUFFER_SIZE
+#define HCI_DUMP_POSIX_ASYNC_RING_BUFFER_SIZE (256 * 1024)
+#endif
+
+// writer thread wakes up periodically to write pending records, or earlier if ring buffer is half full
+#ifndef HCI_DUMP_POSIX_ASYNC_FLUSH_INTERVAL_MS
+#define HCI_DUMP_POSIX_ASYNC_FLUSH_INTERVAL_MS 10
+#endif
+
+// max records written with a single writev call
+#ifndef HCI_DUMP_POSIX_ASYNC_MAX_IOVECS
+#define HCI_DUMP_POSIX_ASYNC_MAX_IOVECS 64
+#endif
+
+#define RECORD_PREFIX_SIZE  4
+#define RECORD_WRAP         0xffffffffu
+#define RECORD_RESET        0xfffffffeu
+
+#define HCI_DUMP_POSIX_ASYNC_MAX_HEADER_SIZE HCI_DUMP_HEADER_SIZE_BTSNOOP
+
+static int      dump_file = -1;
+static int      dump_format;
+static char     log_message_buffer[256];
+
+// ring buffer
+static uint8_t * ring_buffer;
+static uint32_t  ring_buffer_size;
+static uint32_t  ring_write_index;   // written by BTstack thread
+static uint32_t  ring_read_index;    // written by writer thread
+static uint32_t  ring_reserved_index;
+static bool      ring_reserved_wrap;
+
+// dropped records, only accessed by BTstack thread
+static uint32_t  num_dropped_records;
+static uint32_t  num_dropped_records_reported;
+
+// writer thread
+static pthread_t       writer_thread;
+static pthread_mutex_t writer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  writer_cond  = PTHREAD_COND_INITIALIZER;
+static bool            writer_idle;
+static bool            writer_stop;
+
+static const uint8_t btsnoop_file_header[] = {
+    // Identification Pattern: "btsnoop\0"
+    0x62, 0x74, 0x73, 0x6E, 0x6F, 0x6F, 0x70, 0x00,
+    // Version: 1
+    0x00, 0x00, 0x00, 0x01,
+    // Datalink Type: 2001 - Linux Monitor
+    0x00, 0x00, 0x07, 0xD1,
+};
+
+// BTstack thread
+
+// reserve space for record with given size, returns pointer to record data or NULL if ring buffer is full
+static uint8_t * hci_dump_posix_async_reserve(uint32_t size){
+    uint32_t record_size = RECORD_PREFIX_SIZE + size;
+    uint32_t read_index  = __atomic_load_n(&ring_read_index, __ATOMIC_ACQUIRE);
+    uint32_t write_index = ring_write_index;
+
+    ring_reserved_wrap = false;
+    if (write_index >= read_index){
+        // free space at end, one byte kept free if read index is at start
+        uint32_t free_at_end = ring_buffer_size - write_index - ((read_index == 0) ? 1 : 0);
+        if (free_at_end >= record_size){
+            ring_reserved_index = write_index;
+            return &ring_buffer[write_index + RECORD_PREFIX_SIZE];
+        }
+        // wrap around if record fits before read index
+        if (read_index > record_size){
+            ring_reserved_index = 0;
+            ring_reserved_wrap = true;
+            return &ring_buffer[RECORD_PREFIX_SIZE];
+        }
+        return NULL;
+    }
+
+    if ((read_index - write_index - 1) >= record_size){
+        ring_reserved_index = write_index;
+        return &ring_buffer[write_index + RECORD_PREFIX_SIZE];
+    }
+    return NULL;
+}
+
+static void hci_dump_posix_async_commit(uint32_t record_len){
+    // mark end of data, if there's room for marker
+    if (ring_reserved_wrap && ((ring_buffer_size - ring_write_index) >= RECORD_PREFIX_SIZE)){
+        uint32_t marker = RECORD_WRAP;
+        memcpy(&ring_buffer[ring_write_index], &marker, RECORD_PREFIX_SIZE);
+    }
+    memcpy(&ring_buffer[ring_reserved_index], &record_len, RECORD_PREFIX_SIZE);
+    uint32_t payload_len = (record_len == RECORD_RESET) ? 0 : record_len;
+    uint32_t write_index = ring_reserved_index + RECORD_PREFIX_SIZE + payload_len;
+    if (write_index == ring_buffer_size){
+        write_index = 0;
+    }
+
+    // publish record, then wake writer if it's waiting and ring buffer is half full
+    __atomic_store_n(&ring_write_index, write_index, __ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&writer_idle, __ATOMIC_SEQ_CST)) return;
+    uint32_t read_index = __atomic_load_n(&ring_read_index, __ATOMIC_ACQUIRE);
+    uint32_t used = (write_index >= read_index) ? (write_index - read_index) : (ring_buffer_size - read_index + write_index);
+    if ((used * 2u) >= ring_buffer_size){
+        pthread_mutex_lock(&writer_mutex);
+        pthread_cond_signal(&writer_cond);
+        pthread_mutex_unlock(&writer_mutex);
+    }
+}
+
+// provide summary for ISO Data Packets if not supported by fileformat/viewer yet
+static uint16_t hci_dump_iso_summary(uint8_t in,  uint8_t *packet, uint16_t len){
+    UNUSED(len);
+    uint16_t conn_handle = little_endian_read_16(packet, 0) & 0xfff;
+    uint8_t pb = (packet[1] >> 4) & 3;
+    uint8_t ts = (packet[1] >> 6) & 1;
+    uint16_t pos = 4;
+    uint32_t time_stamp = 0;
+    if (ts){
+        time_stamp = little_endian_read_32(packet, pos);
+        pos += 4;
+    }
+    if ((pb & 1) == 0) {
+        uint16_t packet_sequence = little_endian_read_16(packet, pos);
+        pos += 2;
+        uint16_t iso_sdu_len = little_endian_read_16(packet, pos);
+        uint8_t packet_status_flag = packet[pos+1] >> 6;
+        return btstack_snprintf_assert_complete(log_message_buffer,sizeof(log_message_buffer), "ISO %s, handle %04x, pb %u, ts 0x%08x, size %u, sequence 0x%04x, packet status %u, iso pdu len %u",
+                        in ? "IN" : "OUT", conn_handle, pb, time_stamp, len, packet_sequence, packet_status_flag, iso_sdu_len);
+    } else {
+        return btstack_snprintf_assert_complete(log_message_buffer,sizeof(log_message_buffer), "ISO %s, handle %04x, pb %u, ts 0x%08x, size %u",
+                        in ? "IN" : "OUT", conn_handle, pb, time_stamp, len);
+    }
+}
+
+static bool hci_dump_posix_async_store_record(const struct timeval * curr_time, uint8_t packet_type, uint8_t in, const uint8_t *packet, uint16_t len){
+    uint8_t * record = hci_dump_posix_async_reserve(HCI_DUMP_POSIX_ASYNC_MAX_HEADER_SIZE + len);
+    if (record == NULL){
+        return false;
+    }
+
+    uint32_t tv_sec = (uint32_t) curr_time->tv_sec;
+    uint32_t tv_us  = (uint32_t) curr_time->tv_usec;
+    uint64_t ts_usec;
+    uint16_t header_len;
+    switch (dump_format){
+        case HCI_DUMP_BLUEZ:
+            hci_dump_setup_header_bluez(record, tv_sec, tv_us, packet_type, in, len);
+            header_len = HCI_DUMP_HEADER_SIZE_BLUEZ;
+            break;
+        case HCI_DUMP_PACKETLOGGER:
+            hci_dump_setup_header_packetlogger(record, tv_sec, tv_us, packet_type, in, len);
+            header_len = HCI_DUMP_HEADER_SIZE_PACKETLOGGER;
+            break;
+        case HCI_DUMP_BTSNOOP:
+            ts_usec = 0xdcddb30f2f8000LLU + 1000000LLU * curr_time->tv_sec + curr_time->tv_usec;
+            hci_dump_setup_header_btsnoop(record, ts_usec >> 32, ts_usec & 0xFFFFFFFF, num_dropped_records, packet_type, in, len);
+            header_len = HCI_DUMP_HEADER_SIZE_BTSNOOP;
+            break;
+        default:
+            btstack_unreachable();
+            return false;
+    }
+    memcpy(&record[header_len], packet, len);
+    hci_dump_posix_async_commit(header_len + len);
+    return true;
+}
+
+static void hci_dump_posix_async_log_packet(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len) {
+    if (dump_file < 0) return;
+
+    // get time
+    struct timeval curr_time;
+    gettimeofday(&curr_time, NULL);
+
+    // report dropped records as log message, BTSnoop has cumulative drops field instead
+    if ((dump_format != HCI_DUMP_BTSNOOP) && (num_dropped_records != num_dropped_records_reported)){
+        char drop_message[64];
+        uint16_t drop_message_len = btstack_snprintf_assert_complete(drop_message, sizeof(drop_message),
+                                                                     "hci_dump_posix_async: %u records dropped", (unsigned int) num_dropped_records);
+        if (hci_dump_posix_async_store_record(&curr_time, LOG_MESSAGE_PACKET, 0, (const uint8_t *) drop_message, drop_message_len) == false){
+            num_dropped_records++;
+            return;
+        }
+        num_dropped_records_reported = num_dropped_records;
+    }
+
+    // ISO packets not supported by BlueZ
+    if ((dump_format == HCI_DUMP_BLUEZ) && (packet_type == HCI_ISO_DATA_PACKET)){
+        len = hci_dump_iso_summary(in, packet, len);
+        packet_type = LOG_MESSAGE_PACKET;
+        packet = (uint8_t*) log_message_buffer;
+    }
+
+    if (hci_dump_posix_async_store_record(&curr_time, packet_type, in, packet, len) == false){
+        num_dropped_records++;
+    }
+}
+
+static void hci_dump_posix_async_log_message(int log_level, const char * format, va_list argptr){
+    UNUSED(log_level);
+    if (dump_file < 0) return;
+    int full_string_len = vsnprintf(log_message_buffer, sizeof(log_message_buffer), format, argptr);
+    int len = btstack_min(sizeof(log_message_buffer), full_string_len);
+    hci_dump_posix_async_log_packet(LOG_MESSAGE_PACKET, 0, (uint8_t*) log_message_buffer, len);
+}
+
+static void hci_dump_posix_async_reset(void){
+    btstack_assert(dump_file >= 0);
+    // file is reset by writer thread after writing pending records
+    if (hci_dump_posix_async_reserve(0) == NULL){
+        log_error("hci_dump_posix_async: ring buffer full, reset skipped");
+        return;
+    }
+    hci_dump_posix_async_commit(RECORD_RESET);
+}
+
+// Writer thread
+
+static void hci_dump_posix_async_write_all(struct iovec * iov, int iovcnt){
+    while (iovcnt > 0){
+        ssize_t bytes_written = writev(dump_file, iov, iovcnt);
+        if (bytes_written < 0){
+            if (errno == EINTR) continue;
+            return;
+        }
+        // skip completely written records, adjust partially written one
+        while ((iovcnt > 0) && ((size_t) bytes_written >= iov->iov_len)){
+            bytes_written -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0){
+            iov->iov_base = ((uint8_t *) iov->iov_base) + bytes_written;
+            iov->iov_len -= bytes_written;
+        }
+    }
+}
+
+static void hci_dump_posix_async_truncate(void){
+    (void) lseek(dump_file, 0, SEEK_SET);
+    int err = ftruncate(dump_file, 0);
+    UNUSED(err);
+    if (dump_format == HCI_DUMP_BTSNOOP){
+        ssize_t bytes_written = write(dump_file, btsnoop_file_header, sizeof(btsnoop_file_header));
+        UNUSED(bytes_written);
+    }
+}
+
+static void * hci_dump_posix_async_writer(void * context){
+    UNUSED(context);
+    struct iovec iov[HCI_DUMP_POSIX_ASYNC_MAX_IOVECS];
+    while (true){
+        // collect pending records
+        uint32_t write_index = __atomic_load_n(&ring_write_index, __ATOMIC_ACQUIRE);
+        uint32_t read_index  = ring_read_index;
+        int      iovcnt = 0;
+        bool     reset  = false;
+        while ((read_index != write_index) && (iovcnt < HCI_DUMP_POSIX_ASYNC_MAX_IOVECS)){
+            if ((ring_buffer_size - read_index) < RECORD_PREFIX_SIZE){
+                read_index = 0;
+                continue;
+            }
+            uint32_t record_len;
+            memcpy(&record_len, &ring_buffer[read_index], RECORD_PREFIX_SIZE);
+            if (record_len == RECORD_WRAP){
+                read_index = 0;
+                continue;
+            }
+            if (record_len == RECORD_RESET){
+                record_len = 0;
+                reset = true;
+            } else {
+                iov[iovcnt].iov_base = &ring_buffer[read_index + RECORD_PREFIX_SIZE];
+                iov[iovcnt].iov_len  = record_len;
+                iovcnt++;
+            }
+            read_index += RECORD_PREFIX_SIZE + record_len;
+            if (read_index == ring_buffer_size){
+                read_index = 0;
+            }
+            if (reset) break;
+        }
+
+        if (read_index != ring_read_index){
+            hci_dump_posix_async_write_all(iov, iovcnt);
+            if (reset){
+                hci_dump_posix_async_truncate();
+            }
+            // release space
+            __atomic_store_n(&ring_read_index, read_index, __ATOMIC_RELEASE);
+            continue;
+        }
+
+        // wait for flush interval, ring buffer half full or stop request
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += HCI_DUMP_POSIX_ASYNC_FLUSH_INTERVAL_MS * 1000000L;
+        deadline.tv_sec  += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        pthread_mutex_lock(&writer_mutex);
+        __atomic_store_n(&writer_idle, true, __ATOMIC_SEQ_CST);
+        int err = 0;
+        while (!writer_stop && (err == 0)){
+            err = pthread_cond_timedwait(&writer_cond, &writer_mutex, &deadline);
+        }
+        __atomic_store_n(&writer_idle, false, __ATOMIC_SEQ_CST);
+        bool done = writer_stop && (__atomic_load_n(&ring_write_index, __ATOMIC_SEQ_CST) == ring_read_index);
+        pthread_mutex_unlock(&writer_mutex);
+        if (done) break;
+    }
+    return NULL;
+}
+
+// returns system errno
+int hci_dump_posix_async_open(const char *filename, hci_dump_format_t format, uint32_t ring_buffer_size_bytes){
+    btstack_assert(format == HCI_DUMP_BLUEZ || format == HCI_DUMP_PACKETLOGGER || format == HCI_DUMP_BTSNOOP);
+    btstack_assert(dump_file < 0);
+
+    if (ring_buffer_size_bytes == 0){
+        ring_buffer_size_bytes = HCI_DUMP_POSIX_ASYNC_RING_BUFFER_SIZE;
+    }
+    ring_buffer = (uint8_t *) malloc(ring_buffer_size_bytes);
+    if (ring_buffer == NULL){
+        return ENOMEM;
+    }
+    // touch all pages now instead of on the first pass through the ring buffer
+    memset(ring_buffer, 0, ring_buffer_size_bytes);
+    ring_buffer_size    = ring_buffer_size_bytes;
+    ring_write_index    = 0;
+    ring_read_index     = 0;
+    num_dropped_records = 0;
+    num_dropped_records_reported = 0;
+    writer_idle = false;
+    writer_stop = false;
+
+    dump_format = format;
+    int oflags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef _WIN32
+    oflags |= O_BINARY;
+#endif
+    dump_file = open(filename, oflags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH );
+    if (dump_file < 0){
+        int err = errno;
+        printf("failed to open file %s, errno = %d\n", filename, err);
+        free(ring_buffer);
+        ring_buffer = NULL;
+        return err;
+    }
+
+    if (format == HCI_DUMP_BTSNOOP){
+        // write BTSnoop file header
+        ssize_t bytes_written = write(dump_file, btsnoop_file_header, sizeof(btsnoop_file_header));
+        UNUSED(bytes_written);
+    }
+
+    int err = pthread_create(&writer_thread, NULL, &hci_dump_posix_async_writer, NULL);
+    if (err != 0){
+        printf("failed to start writer thread, err = %d\n", err);
+        close(dump_file);
+        dump_file = -1;
+        free(ring_buffer);
+        ring_buffer = NULL;
+        return err;
+    }
+    return 0;
+}
+
+void hci_dump_posix_async_close(void){
+    if (dump_file < 0) return;
+
+    // stop writer thread after pending records have been written
+    pthread_mutex_lock(&writer_mutex);
+    writer_stop = true;
+    pthread_cond_signal(&writer_cond);
+    pthread_mutex_unlock(&writer_mutex);
+    pthread_join(writer_thread, NULL);
+
+    close(dump_file);
+    dump_file = -1;
+    free(ring_buffer);
+    ring_buffer = NULL;
+}
+
+uint32_t hci_dump_posix_async_get_num_dropped_records(void){
+    return num_dropped_records;
+}
+
+const hci_dump_t * hci_dump_posix_async_get_instance(void){
+    static const hci_dump_t hci_dump_instance = {
+        // void (*reset)(void);
+        &hci_dump_posix_async_reset,
+        // void (*log_packet)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len);
+        &hci_dump_posix_async_log_packet,
+        // void (*log_message)(int log_level, const char * format, va_list argptr);
+        &hci_dump_posix_async_log_message,
+        // void (*snapshot)(void);
+        NULL,
+        // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+        NULL,
+    };
+    return &hci_dump_instance;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/*
+ *  Dump HCI trace in binary formats like PacketLogger and BlueZ (hcidump) into file from a writer thread
+ *
+ *  Packets and log messages are formatted and copied into a single-producer/single-consumer ring buffer
+ *  by the BTstack thread. A dedicated writer thread collects pending records every 10 ms, or as soon as the
+ *  ring buffer is half full, and writes them with writev, so file I/O does not delay HCI processing. If the ring buffer is full, records are dropped and counted.
+ *  For BTSnoop, the number of dropped records is reported in the cumulative drops field of the next record.
+ *
+ *  hci_dump_packet and hci_dump_log must only be called from a single thread.
+ */
+
+#ifndef HCI_DUMP_POSIX_ASYNC_H
+#define HCI_DUMP_POSIX_ASYNC_H
+
+#include <stdint.h>
+#include "hci_dump.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/* API_START */
+
+/**
+ * @brief Get HCI Dump POSIX Async Instance
+ * @return hci_dump_impl
+ */
+const hci_dump_t * hci_dump_posix_async_get_instance(void);
+
+/**
+ * @brief Open Log file and start writer thread
+ * @param filename or path
+ * @param format
+ * @param ring_buffer_size in bytes, 0 for default of 256 kB
+ * @returns 0 if ok, errno otherwise
+ */
+int hci_dump_posix_async_open(const char *filename, hci_dump_format_t format, uint32_t ring_buffer_size);
+
+/**
+ * @brief Write pending records, stop writer thread and close Log file
+ */
+void hci_dump_posix_async_close(void);
+
+/**
+ * @brief Get number of records dropped since log file was opened as ring buffer was full
+ * @return num dropped records
+ */
+uint32_t hci_dump_posix_async_get_num_dropped_records(void);
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+#endif // HCI_DUMP_POSIX_ASYNC_H
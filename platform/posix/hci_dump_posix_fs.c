@@ -69,21 +69,260 @@
 
 #include <time.h>
 #include <stdio.h>        // printf
+#include <stdlib.h>       // malloc
+#include <string.h>       // strlen
 #include <fcntl.h>        // open
 #include <unistd.h>       // write
 #include <errno.h>        // errno
 
+#ifndef HCI_DUMP_POSIX_FS_MAX_PATH_LEN
+#define HCI_DUMP_POSIX_FS_MAX_PATH_LEN 256
+#endif
+
+#define FLIGHT_RECORDER_RECORD_PREFIX_SIZE 4
+
+// "_YYYYMMDD_HHMMSS_mmm_<counter>"
+#define FILE_NAME_TIMESTAMP_MAX_LEN 31
+
 static int  dump_file = -1;
 static int  dump_format;
 static char log_message_buffer[256];
 
+static const uint8_t btsnoop_file_header[] = {
+    // Identification Pattern: "btsnoop\0"
+    0x62, 0x74, 0x73, 0x6E, 0x6F, 0x6F, 0x70, 0x00,
+    // Version: 1
+    0x00, 0x00, 0x00, 0x01,
+    // Datalink Type: 2001 - Linux Monitor
+    0x00, 0x00, 0x07, 0xD1,
+};
+
+// file name template for rotation and flight recorder, timestamp is inserted before extension
+static char     file_name_template[HCI_DUMP_POSIX_FS_MAX_PATH_LEN];
+static uint16_t file_name_extension_pos;
+
+// timestamp and counter of last file name, to keep names in creation order within the same millisecond
+static time_t       file_name_seconds;
+static unsigned int file_name_milliseconds;
+static unsigned int file_name_counter;
+
+// log rotation
+static uint32_t rotation_max_file_size;
+static uint32_t rotation_max_file_duration_s;
+static uint16_t rotation_num_files_to_keep;
+static bool     rotation_active;
+static uint32_t file_size;
+static time_t   file_start_time;
+
+// files created by log rotation, oldest first
+static char *   rotation_files;
+static uint16_t rotation_files_count;
+
+// flight recorder: records with 4 byte length prefix in circular buffer, oldest records get overwritten
+static uint8_t * flight_recorder_buffer;
+static uint32_t  flight_recorder_size;
+static uint32_t  flight_recorder_head;
+static uint32_t  flight_recorder_used;
+
+static uint32_t hci_dump_posix_fs_file_header_size(void){
+    return (dump_format == HCI_DUMP_BTSNOOP) ? sizeof(btsnoop_file_header) : 0;
+}
+
+// returns file descriptor or -errno
+static int hci_dump_posix_fs_create_file(const char * path){
+    int oflags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef _WIN32
+    oflags |= O_BINARY;
+#endif
+    int fd = open(path, oflags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH );
+    if (fd < 0){
+        int err = errno;
+        printf("failed to open file %s, errno = %d\n", path, err);
+        return -err;
+    }
+    if (dump_format == HCI_DUMP_BTSNOOP){
+        // write BTSnoop file header
+        ssize_t bytes_written = write(fd, btsnoop_file_header, sizeof(btsnoop_file_header));
+        UNUSED(bytes_written);
+    }
+    return fd;
+}
+
+static int hci_dump_posix_fs_set_file_name_template(const char * filename){
+    size_t len = strlen(filename);
+    if ((len + FILE_NAME_TIMESTAMP_MAX_LEN) >= sizeof(file_name_template)){
+        return ENAMETOOLONG;
+    }
+    memcpy(file_name_template, filename, len + 1);
+    // extension starts at last '.' in last path component
+    const char * separator = strrchr(filename, '/');
+    const char * extension = strrchr((separator != NULL) ? separator : filename, '.');
+    file_name_extension_pos = (uint16_t) ((extension != NULL) ? (size_t) (extension - filename) : len);
+    return 0;
+}
+
+// <name>_YYYYMMDD_HHMMSS_mmm<extension> in UTC, counter appended if file already exists
+static void hci_dump_posix_fs_setup_file_name(char * path, const struct timeval * curr_time){
+    time_t seconds = curr_time->tv_sec;
+    struct tm time_utc;
+    gmtime_r(&seconds, &time_utc);
+    char timestamp[24];
+    (void) strftime(timestamp, sizeof(timestamp), "%Y%m%d_%H%M%S", &time_utc);
+    const char * extension = &file_name_template[file_name_extension_pos];
+    unsigned int milliseconds = (unsigned int) (curr_time->tv_usec / 1000);
+    unsigned int counter = 0;
+    if ((seconds == file_name_seconds) && (milliseconds == file_name_milliseconds)){
+        counter = file_name_counter + 1u;
+    }
+    while (true){
+        if (counter == 0){
+            (void) btstack_snprintf_assert_complete(path, HCI_DUMP_POSIX_FS_MAX_PATH_LEN, "%.*s_%s_%03u%s",
+                (int) file_name_extension_pos, file_name_template, timestamp, milliseconds, extension);
+        } else {
+            (void) btstack_snprintf_assert_complete(path, HCI_DUMP_POSIX_FS_MAX_PATH_LEN, "%.*s_%s_%03u_%03u%s",
+                (int) file_name_extension_pos, file_name_template, timestamp, milliseconds, counter, extension);
+        }
+        if (access(path, F_OK) != 0) break;
+        counter++;
+    }
+    file_name_seconds      = seconds;
+    file_name_milliseconds = milliseconds;
+    file_name_counter      = counter;
+}
+
+// delete oldest file if more than max files would exist
+static void hci_dump_posix_fs_add_rotation_file(const char * path){
+    if (rotation_files == NULL) return;
+    if (rotation_files_count == rotation_num_files_to_keep){
+        (void) unlink(rotation_files);
+        memmove(rotation_files, &rotation_files[HCI_DUMP_POSIX_FS_MAX_PATH_LEN],
+                (rotation_files_count - 1u) * HCI_DUMP_POSIX_FS_MAX_PATH_LEN);
+        rotation_files_count--;
+    }
+    btstack_strcpy(&rotation_files[rotation_files_count * HCI_DUMP_POSIX_FS_MAX_PATH_LEN], HCI_DUMP_POSIX_FS_MAX_PATH_LEN, path);
+    rotation_files_count++;
+}
+
+// returns system errno
+static int hci_dump_posix_fs_start_rotation_file(const struct timeval * curr_time){
+    // also limits retries to one per second if file cannot be created
+    file_start_time = curr_time->tv_sec;
+    char path[HCI_DUMP_POSIX_FS_MAX_PATH_LEN];
+    hci_dump_posix_fs_setup_file_name(path, curr_time);
+    int fd = hci_dump_posix_fs_create_file(path);
+    if (fd < 0){
+        dump_file = -1;
+        return -fd;
+    }
+    dump_file = fd;
+    file_size = hci_dump_posix_fs_file_header_size();
+    hci_dump_posix_fs_add_rotation_file(path);
+    return 0;
+}
+
+static void hci_dump_posix_fs_rotate(const struct timeval * curr_time){
+    if (dump_file >= 0){
+        close(dump_file);
+        dump_file = -1;
+    }
+    (void) hci_dump_posix_fs_start_rotation_file(curr_time);
+}
+
+static void hci_dump_posix_fs_free_rotation_files(void){
+    free(rotation_files);
+    rotation_files = NULL;
+    rotation_files_count = 0;
+}
+
+static void hci_dump_posix_fs_flight_recorder_write(const uint8_t * data, uint32_t len){
+    uint32_t pos = (flight_recorder_head + flight_recorder_used) % flight_recorder_size;
+    uint32_t bytes_to_end = btstack_min(len, flight_recorder_size - pos);
+    memcpy(&flight_recorder_buffer[pos], data, bytes_to_end);
+    memcpy(flight_recorder_buffer, &data[bytes_to_end], len - bytes_to_end);
+    flight_recorder_used += len;
+}
+
+static uint32_t hci_dump_posix_fs_flight_recorder_read_len(uint32_t pos){
+    uint8_t prefix[FLIGHT_RECORDER_RECORD_PREFIX_SIZE];
+    uint32_t i;
+    for (i = 0; i < FLIGHT_RECORDER_RECORD_PREFIX_SIZE; i++){
+        prefix[i] = flight_recorder_buffer[(pos + i) % flight_recorder_size];
+    }
+    return little_endian_read_32(prefix, 0);
+}
+
+static void hci_dump_posix_fs_flight_recorder_store(const uint8_t * header, uint16_t header_len, const uint8_t * packet, uint16_t len){
+    uint32_t record_len  = header_len + len;
+    uint32_t record_size = FLIGHT_RECORDER_RECORD_PREFIX_SIZE + record_len;
+    if (record_size > flight_recorder_size) return;
+
+    // drop oldest records
+    while ((flight_recorder_used + record_size) > flight_recorder_size){
+        uint32_t oldest_size = FLIGHT_RECORDER_RECORD_PREFIX_SIZE + hci_dump_posix_fs_flight_recorder_read_len(flight_recorder_head);
+        flight_recorder_head = (flight_recorder_head + oldest_size) % flight_recorder_size;
+        flight_recorder_used -= oldest_size;
+    }
+
+    uint8_t prefix[FLIGHT_RECORDER_RECORD_PREFIX_SIZE];
+    little_endian_store_32(prefix, 0, record_len);
+    hci_dump_posix_fs_flight_recorder_write(prefix, sizeof(prefix));
+    hci_dump_posix_fs_flight_recorder_write(header, header_len);
+    hci_dump_posix_fs_flight_recorder_write(packet, len);
+}
+
 static void hci_dump_posix_fs_reset(void){
+    if (flight_recorder_buffer != NULL){
+        // size already limited, keep history
+        return;
+    }
+    if (rotation_active){
+        struct timeval curr_time;
+        gettimeofday(&curr_time, NULL);
+        hci_dump_posix_fs_rotate(&curr_time);
+        return;
+    }
     btstack_assert(dump_file >= 0);
     (void) lseek(dump_file, 0, SEEK_SET);
     int err = ftruncate(dump_file, 0);
     UNUSED(err);
 }
 
+static void hci_dump_posix_fs_snapshot(void){
+    if (flight_recorder_buffer == NULL) return;
+    (void) hci_dump_posix_fs_flight_recorder_save();
+}
+
+static void hci_dump_posix_fs_store_record(const struct timeval * curr_time, const uint8_t * header, uint16_t header_len, const uint8_t * packet, uint16_t len){
+    if (flight_recorder_buffer != NULL){
+        hci_dump_posix_fs_flight_recorder_store(header, header_len, packet, len);
+        return;
+    }
+
+    if (rotation_active){
+        if (dump_file < 0){
+            // previous file could not be created
+            if (curr_time->tv_sec == file_start_time) return;
+            if (hci_dump_posix_fs_start_rotation_file(curr_time) != 0) return;
+        }
+        uint32_t record_size = header_len + len;
+        bool size_exceeded = (rotation_max_file_size > 0u) && (file_size > hci_dump_posix_fs_file_header_size())
+                             && ((file_size + record_size) > rotation_max_file_size);
+        bool duration_exceeded = (rotation_max_file_duration_s > 0u)
+                                 && ((curr_time->tv_sec - file_start_time) >= (time_t) rotation_max_file_duration_s);
+        if (size_exceeded || duration_exceeded){
+            hci_dump_posix_fs_rotate(curr_time);
+        }
+        if (dump_file < 0) return;
+        file_size += record_size;
+    }
+
+    ssize_t bytes_written;
+    bytes_written = write(dump_file, header, header_len);
+    UNUSED(bytes_written);
+    bytes_written = write(dump_file, packet, len );
+    UNUSED(bytes_written);
+}
+
 // provide summary for ISO Data Packets if not supported by fileformat/viewer yet
 static uint16_t hci_dump_iso_summary(uint8_t in,  uint8_t *packet, uint16_t len){
     UNUSED(len);
@@ -109,8 +348,8 @@ static uint16_t hci_dump_iso_summary(uint8_t in,  uint8_t *packet, uint16_t len)
     }
 }
 
-static void hci_dump_posix_fs_log_packet(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len) {
-    if (dump_file < 0) return;
+static void hci_dump_posix_fs_log_packet_truncated(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len) {
+    if ((dump_file < 0) && (flight_recorder_buffer == NULL) && (rotation_active == false)) return;
 
     static union {
         uint8_t header_bluez[HCI_DUMP_HEADER_SIZE_BLUEZ];
@@ -146,7 +385,7 @@ static void hci_dump_posix_fs_log_packet(uint8_t packet_type, uint8_t in, uint8_
             break;
         case HCI_DUMP_BTSNOOP:
             ts_usec = 0xdcddb30f2f8000LLU + 1000000LLU * curr_time.tv_sec + curr_time.tv_usec;
-            hci_dump_setup_header_btsnoop(header.header_btsnoop, ts_usec >> 32, ts_usec & 0xFFFFFFFF, 0, packet_type, in, len);
+            hci_dump_setup_header_btsnoop_truncated(header.header_btsnoop, ts_usec >> 32, ts_usec & 0xFFFFFFFF, 0, packet_type, in, len, original_len);
             header_len = HCI_DUMP_HEADER_SIZE_BTSNOOP;
             break;
         default:
@@ -154,55 +393,138 @@ static void hci_dump_posix_fs_log_packet(uint8_t packet_type, uint8_t in, uint8_
             return;
     }
 
-    ssize_t bytes_written;
-    bytes_written = write(dump_file, &header, header_len);
-    UNUSED(bytes_written);
-    bytes_written = write(dump_file, packet, len );
-    UNUSED(bytes_written);
+    hci_dump_posix_fs_store_record(&curr_time, (const uint8_t *) &header, header_len, packet, len);
+}
+
+static void hci_dump_posix_fs_log_packet(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len) {
+    hci_dump_posix_fs_log_packet_truncated(packet_type, in, packet, len, len);
 }
 
 static void hci_dump_posix_fs_log_message(int log_level, const char * format, va_list argptr){
     UNUSED(log_level);
-    if (dump_file < 0) return;
+    if ((dump_file < 0) && (flight_recorder_buffer == NULL) && (rotation_active == false)) return;
     int full_string_len = vsnprintf(log_message_buffer, sizeof(log_message_buffer), format, argptr);
     int len = btstack_min(sizeof(log_message_buffer), full_string_len);
     hci_dump_posix_fs_log_packet(LOG_MESSAGE_PACKET, 0, (uint8_t*) log_message_buffer, len);
 }
 
+void hci_dump_posix_fs_set_rotation(uint32_t max_file_size, uint32_t max_file_duration_s, uint16_t num_files_to_keep){
+    rotation_max_file_size       = max_file_size;
+    rotation_max_file_duration_s = max_file_duration_s;
+    rotation_num_files_to_keep   = num_files_to_keep;
+}
+
 // returns system errno
 int hci_dump_posix_fs_open(const char *filename, hci_dump_format_t format){
     btstack_assert(format == HCI_DUMP_BLUEZ || format == HCI_DUMP_PACKETLOGGER || format == HCI_DUMP_BTSNOOP);
 
+    // close file of previous open
+    if (dump_file >= 0){
+        close(dump_file);
+        dump_file = -1;
+    }
+    hci_dump_posix_fs_free_rotation_files();
+    rotation_active = false;
+
     dump_format = format;
-    int oflags = O_WRONLY | O_CREAT | O_TRUNC;
-#ifdef _WIN32
-    oflags |= O_BINARY;
-#endif
-    dump_file = open(filename, oflags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH );
-    if (dump_file < 0){
-        printf("failed to open file %s, errno = %d\n", filename, errno);
-        return errno;
+    bool use_rotation = (rotation_max_file_size > 0u) || (rotation_max_file_duration_s > 0u) || (rotation_num_files_to_keep > 0u);
+    if (use_rotation == false){
+        int fd = hci_dump_posix_fs_create_file(filename);
+        if (fd < 0){
+            return -fd;
+        }
+        dump_file = fd;
+        return 0;
     }
 
-    if (format == HCI_DUMP_BTSNOOP){
-        // write BTSnoop file header
-        const uint8_t file_header[] = {
-            // Identification Pattern: "btsnoop\0"
-            0x62, 0x74, 0x73, 0x6E, 0x6F, 0x6F, 0x70, 0x00,
-            // Version: 1
-            0x00, 0x00, 0x00, 0x01,
-            // Datalink Type: 2001 - Linux Monitor
-            0x00, 0x00, 0x07, 0xD1,
-        };
-        ssize_t bytes_written = write(dump_file, &file_header, sizeof(file_header));
+    int err = hci_dump_posix_fs_set_file_name_template(filename);
+    if (err != 0){
+        return err;
+    }
+    if (rotation_num_files_to_keep > 0u){
+        rotation_files = (char *) malloc(rotation_num_files_to_keep * HCI_DUMP_POSIX_FS_MAX_PATH_LEN);
+        if (rotation_files == NULL){
+            return ENOMEM;
+        }
+    }
+    struct timeval curr_time;
+    gettimeofday(&curr_time, NULL);
+    err = hci_dump_posix_fs_start_rotation_file(&curr_time);
+    if (err != 0){
+        hci_dump_posix_fs_free_rotation_files();
+        return err;
+    }
+    rotation_active = true;
+    return 0;
+}
+
+// returns system errno
+int hci_dump_posix_fs_open_flight_recorder(const char * filename, hci_dump_format_t format, uint32_t buffer_size){
+    btstack_assert(format == HCI_DUMP_BLUEZ || format == HCI_DUMP_PACKETLOGGER || format == HCI_DUMP_BTSNOOP);
+    btstack_assert(buffer_size > 0u);
+
+    // discard flight recorder of previous open
+    free(flight_recorder_buffer);
+    flight_recorder_buffer = NULL;
+
+    dump_format = format;
+    int err = hci_dump_posix_fs_set_file_name_template(filename);
+    if (err != 0){
+        return err;
+    }
+    flight_recorder_buffer = (uint8_t *) malloc(buffer_size);
+    if (flight_recorder_buffer == NULL){
+        return ENOMEM;
+    }
+    flight_recorder_size = buffer_size;
+    flight_recorder_head = 0;
+    flight_recorder_used = 0;
+    return 0;
+}
+
+// returns system errno
+int hci_dump_posix_fs_flight_recorder_save(void){
+    if (flight_recorder_buffer == NULL){
+        return EBADF;
+    }
+    char path[HCI_DUMP_POSIX_FS_MAX_PATH_LEN];
+    struct timeval curr_time;
+    gettimeofday(&curr_time, NULL);
+    hci_dump_posix_fs_setup_file_name(path, &curr_time);
+    int fd = hci_dump_posix_fs_create_file(path);
+    if (fd < 0){
+        return -fd;
+    }
+
+    // write records from oldest to newest
+    uint32_t pos = flight_recorder_head;
+    uint32_t remaining = flight_recorder_used;
+    while (remaining > 0u){
+        uint32_t record_len = hci_dump_posix_fs_flight_recorder_read_len(pos);
+        uint32_t data_pos = (pos + FLIGHT_RECORDER_RECORD_PREFIX_SIZE) % flight_recorder_size;
+        uint32_t bytes_to_end = btstack_min(record_len, flight_recorder_size - data_pos);
+        ssize_t bytes_written;
+        bytes_written = write(fd, &flight_recorder_buffer[data_pos], bytes_to_end);
+        UNUSED(bytes_written);
+        bytes_written = write(fd, flight_recorder_buffer, record_len - bytes_to_end);
         UNUSED(bytes_written);
+        pos = (data_pos + record_len) % flight_recorder_size;
+        remaining -= FLIGHT_RECORDER_RECORD_PREFIX_SIZE + record_len;
     }
+    close(fd);
+    log_info("flight recorder saved to %s", path);
     return 0;
 }
 
 void hci_dump_posix_fs_close(void){
-    close(dump_file);
+    if (dump_file >= 0){
+        close(dump_file);
+    }
     dump_file = -1;
+    rotation_active = false;
+    hci_dump_posix_fs_free_rotation_files();
+    free(flight_recorder_buffer);
+    flight_recorder_buffer = NULL;
 }
 
 const hci_dump_t * hci_dump_posix_fs_get_instance(void){
@@ -213,6 +535,10 @@ const hci_dump_t * hci_dump_posix_fs_get_instance(void){
         &hci_dump_posix_fs_log_packet,
         // void (*log_message)(int log_level, const char * format, va_list argptr);
         &hci_dump_posix_fs_log_message,
+        // void (*snapshot)(void);
+        &hci_dump_posix_fs_snapshot,
+        // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+        &hci_dump_posix_fs_log_packet_truncated,
     };
     return &hci_dump_instance;
 }
@@ -37,6 +37,14 @@
 
 /*
  *  Dump HCI trace in binary formats like PacketLogger and BlueZ (hcidump) into file
+ *
+ *  With log rotation, a new file is started when size or time limit is reached and only the most recent files are kept.
+ *  In flight recorder mode, only the most recent records are kept in memory and written into a file on demand,
+ *  or when the Controller reports a Hardware Error.
+ *
+ *  Rotated and flight recorder files are named <name>_YYYYMMDD_HHMMSS_mmm<extension> with UTC timestamp,
+ *  e.g. hci_dump_20260101_120000_000.pklg for hci_dump.pklg. Files created within the same millisecond get an
+ *  additional counter, e.g. hci_dump_20260101_120000_000_001.pklg
  */
 
 #ifndef HCI_DUMP_POSIX_FS_H
@@ -66,8 +74,32 @@ const hci_dump_t * hci_dump_posix_fs_get_instance(void);
  */
 int hci_dump_posix_fs_open(const char *filename, hci_dump_format_t format);
 
+/**
+ * @brief Enable log rotation, must be called before hci_dump_posix_fs_open
+ * @note If max packets set via hci_dump_set_max_packets is reached, a new file is started instead of truncating the current one
+ * @param max_file_size in bytes to start new file, 0 for no size limit
+ * @param max_file_duration_s in seconds to start new file, 0 for no time limit
+ * @param num_files_to_keep incl. current file, older files created since open get deleted, 0 to keep all
+ */
+void hci_dump_posix_fs_set_rotation(uint32_t max_file_size, uint32_t max_file_duration_s, uint16_t num_files_to_keep);
+
+/**
+ * @brief Open flight recorder that keeps most recent records in memory, records of previous open are discarded
+ * @param filename or path used as name template for saved files
+ * @param format
+ * @param buffer_size in bytes
+ * @returns 0 if ok, errno otherwise
+ */
+int hci_dump_posix_fs_open_flight_recorder(const char * filename, hci_dump_format_t format, uint32_t buffer_size);
+
+/**
+ * @brief Write records in flight recorder into new file, also called via hci_dump_snapshot on Controller Hardware Error
+ * @returns 0 if ok, errno otherwise
+ */
+int hci_dump_posix_fs_flight_recorder_save(void);
+
 /*
- * @brief Close Log file
+ * @brief Close Log file or flight recorder
  */
 void hci_dump_posix_fs_close(void);
 
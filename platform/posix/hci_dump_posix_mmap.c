@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "hci_dump_posix_mmap.c"
+
+/*
+ *  hci_dump_posix_mmap.c
+ *
+ *  Store HCI trace in a memory-mapped file using the ring mode of hci_dump_buffered
+ */
+
+#include "btstack_config.h"
+
+// enable POSIX functions (needed for -std=c99)
+#define _POSIX_C_SOURCE 200809
+
+#ifdef __FreeBSD__
+// FreeBSD does not set __BSD_VISIBLE or __XSI_VISIBLE if _POSIX_C_SOURCE is defined
+#define __BSD_VISIBLE 1
+#define __XSI_VISIBLE 1
+#endif
+
+#include "hci_dump_posix_mmap.h"
+
+#include "btstack_debug.h"
+#include "hci_dump_buffered.h"
+
+#include <sys/mman.h>     // mmap
+#include <sys/stat.h>     // file modes
+#include <sys/time.h>     // for timestamps
+
+#include <errno.h>        // errno
+#include <fcntl.h>        // open
+#include <stddef.h>
+#include <unistd.h>       // ftruncate
+
+#ifndef HCI_DUMP_POSIX_MMAP_FILE_SIZE
+#define HCI_DUMP_POSIX_MMAP_FILE_SIZE (1024 * 1024)
+#endif
+
+static int       dump_file = -1;
+static uint8_t * dump_mapping;
+static uint32_t  dump_mapping_size;
+
+// timestamps in us since epoch, gettimeofday does not require a syscall on most systems
+static uint64_t hci_dump_posix_mmap_get_time_us(void){
+    struct timeval curr_time;
+    gettimeofday(&curr_time, NULL);
+    return ((uint64_t) curr_time.tv_sec * 1000000u) + (uint64_t) curr_time.tv_usec;
+}
+
+int hci_dump_posix_mmap_open(const char *filename, uint32_t file_size){
+    btstack_assert(dump_file < 0);
+
+    if (file_size == 0u){
+        file_size = HCI_DUMP_POSIX_MMAP_FILE_SIZE;
+    }
+
+    dump_file = open(filename, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (dump_file < 0){
+        int err = errno;
+        log_error("open %s failed, errno %d", filename, err);
+        return err;
+    }
+
+    // allocate file blocks to avoid SIGBUS on full disk when pages are written back
+    int err = posix_fallocate(dump_file, 0, (off_t) file_size);
+    if ((err == EINVAL) || (err == EOPNOTSUPP)){
+        err = (ftruncate(dump_file, (off_t) file_size) == 0) ? 0 : errno;
+    }
+    if (err == 0){
+        void * mapping = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, dump_file, 0);
+        if (mapping == MAP_FAILED){
+            err = errno;
+        } else {
+            dump_mapping = (uint8_t *) mapping;
+            dump_mapping_size = file_size;
+        }
+    }
+    if (err != 0){
+        log_error("mapping %s failed, errno %d", filename, err);
+        close(dump_file);
+        dump_file = -1;
+        return err;
+    }
+
+    hci_dump_buffered_init_ring(dump_mapping, dump_mapping_size, &hci_dump_posix_mmap_get_time_us);
+    return 0;
+}
+
+void hci_dump_posix_mmap_close(void){
+    if (dump_file < 0) return;
+    // stop logging into mapping
+    hci_dump_buffered_init(NULL, NULL, 0, 0);
+    msync(dump_mapping, dump_mapping_size, MS_SYNC);
+    munmap(dump_mapping, dump_mapping_size);
+    close(dump_file);
+    dump_file = -1;
+    dump_mapping = NULL;
+    dump_mapping_size = 0;
+}
+
+const hci_dump_t * hci_dump_posix_mmap_get_instance(void){
+    return hci_dump_buffered_get_instance();
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/*
+ *  Store HCI trace in a memory-mapped file that survives a crash of the process
+ *
+ *  The file is used as ring buffer by hci_dump_buffered. Logging a packet only copies it into the mapping,
+ *  the kernel writes the pages back to the file, even if the process is terminated unexpectedly.
+ *  If the file already contains a ring of the same size, new packets are appended.
+ *  Use tool/convert_hci_dump_ring.py to convert the file into PacketLogger or BTSnoop format.
+ */
+
+#ifndef HCI_DUMP_POSIX_MMAP_H
+#define HCI_DUMP_POSIX_MMAP_H
+
+#include <stdint.h>
+#include "hci_dump.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+/* API_START */
+
+/**
+ * @brief Get HCI Dump POSIX mmap Instance
+ * @return hci_dump_impl
+ */
+const hci_dump_t * hci_dump_posix_mmap_get_instance(void);
+
+/**
+ * @brief Open or create ring file and map it into memory
+ * @param filename or path
+ * @param file_size in bytes, 0 for default of 1 MB
+ * @returns 0 if ok, errno otherwise
+ */
+int hci_dump_posix_mmap_open(const char *filename, uint32_t file_size);
+
+/**
+ * @brief Sync and unmap ring file
+ */
+void hci_dump_posix_mmap_close(void);
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+#endif // HCI_DUMP_POSIX_MMAP_H
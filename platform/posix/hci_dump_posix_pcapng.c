@@ -0,0 +1,435 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+#define BTSTACK_FILE__ "hci_dump_posix_pcapng.c"
+
+/*
+ *  hci_dump_posix_pcapng.c
+ *
+ *  Dump HCI trace in pcapng format
+ *
+ *  Blocks are written in host byte order as defined by the Byte-Order Magic of the Section Header Block,
+ *  here always little endian. Packets are stored with the 4 byte Linux Monitor header: adapter index and opcode,
+ *  both big endian, followed by the HCI packet without packet type.
+ */
+
+#include "btstack_config.h"
+
+// enable POSIX functions (needed for -std=c99)
+#define _POSIX_C_SOURCE 200809
+
+#ifdef __FreeBSD__
+// FreeBSD does not set __BSD_VISIBLE or __XSI_VISIBLE if _POSIX_C_SOURCE is defined
+#define __BSD_VISIBLE 1
+#define __XSI_VISIBLE 1
+#endif
+
+#include "hci_dump_posix_pcapng.h"
+
+#include "btstack_debug.h"
+#include "btstack_util.h"
+
+#include <sys/stat.h>     // file modes
+#include <sys/uio.h>      // writev
+
+#include <errno.h>        // errno
+#include <fcntl.h>        // open
+#include <stdio.h>        // vsnprintf
+#include <string.h>       // memcpy
+#include <time.h>         // clock_gettime
+#include <unistd.h>       // write
+
+#ifndef HCI_DUMP_POSIX_PCAPNG_MAX_INTERFACES
+#define HCI_DUMP_POSIX_PCAPNG_MAX_INTERFACES 4
+#endif
+
+#ifndef HCI_DUMP_POSIX_PCAPNG_MAX_NAME_LEN
+#define HCI_DUMP_POSIX_PCAPNG_MAX_NAME_LEN 32
+#endif
+
+#define BLOCK_TYPE_SECTION_HEADER           0x0A0D0D0Au
+#define BLOCK_TYPE_INTERFACE_DESCRIPTION    0x00000001u
+#define BLOCK_TYPE_INTERFACE_STATISTICS     0x00000005u
+#define BLOCK_TYPE_ENHANCED_PACKET          0x00000006u
+
+#define BYTE_ORDER_MAGIC                    0x1A2B3C4Du
+
+#define OPTION_END_OF_OPT                   0u
+#define OPTION_COMMENT                      1u
+#define OPTION_SHB_USERAPPL                 4u
+#define OPTION_IF_NAME                      2u
+#define OPTION_IF_TSRESOL                   9u
+#define OPTION_EPB_DROPCOUNT                4u
+#define OPTION_ISB_STARTTIME                2u
+#define OPTION_ISB_ENDTIME                  3u
+#define OPTION_ISB_IFRECV                   4u
+#define OPTION_ISB_IFDROP                   5u
+
+#define LINKTYPE_BLUETOOTH_LINUX_MONITOR    254u
+
+// Linux Monitor opcodes, see hci_dump_setup_header_btsnoop
+#define MONITOR_COMMAND_PKT                 0x0002u
+#define MONITOR_EVENT_PKT                   0x0003u
+#define MONITOR_ACL_TX_PKT                  0x0004u
+#define MONITOR_ACL_RX_PKT                  0x0005u
+#define MONITOR_SCO_TX_PKT                  0x0006u
+#define MONITOR_SCO_RX_PKT                  0x0007u
+#define MONITOR_SYSTEM_NOTE                 0x000cu
+#define MONITOR_ISO_TX_PKT                  0x0012u
+#define MONITOR_ISO_RX_PKT                  0x0013u
+
+// block header, timestamp, captured and original length, monitor header
+#define ENHANCED_PACKET_HEADER_SIZE         32u
+#define MONITOR_HEADER_SIZE                 4u
+
+typedef struct {
+    char     name[HCI_DUMP_POSIX_PCAPNG_MAX_NAME_LEN];
+    uint64_t start_time_ns;
+    uint64_t num_packets;
+    uint64_t num_dropped;
+    uint32_t num_dropped_pending;
+} hci_dump_posix_pcapng_interface_t;
+
+static int      dump_file = -1;
+// end of last complete block
+static off_t    file_offset;
+static char     log_message_buffer[256];
+
+static hci_dump_posix_pcapng_interface_t interfaces[HCI_DUMP_POSIX_PCAPNG_MAX_INTERFACES];
+static uint32_t num_interfaces;
+static uint32_t current_interface_id;
+
+// blocks without packet data, enhanced packet block trailer
+static uint8_t  block_buffer[64 + HCI_DUMP_POSIX_PCAPNG_MAX_NAME_LEN];
+static uint8_t  trailer_buffer[3 + 12 + 4 + sizeof(log_message_buffer) + 4 + 4];
+
+static uint64_t hci_dump_posix_pcapng_get_time_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec;
+}
+
+static uint16_t hci_dump_posix_pcapng_store_option(uint8_t * buffer, uint16_t pos, uint16_t code, const void * value, uint16_t value_len){
+    uint16_t padding = (uint16_t) ((4u - (value_len & 3u)) & 3u);
+    little_endian_store_16(buffer, pos, code);
+    little_endian_store_16(buffer, pos + 2u, value_len);
+    (void) memcpy(&buffer[pos + 4u], value, value_len);
+    (void) memset(&buffer[pos + 4u + value_len], 0, padding);
+    return (uint16_t) (pos + 4u + value_len + padding);
+}
+
+static uint16_t hci_dump_posix_pcapng_store_option_64(uint8_t * buffer, uint16_t pos, uint16_t code, uint64_t value){
+    uint8_t value_buffer[8];
+    little_endian_store_32(value_buffer, 0, (uint32_t) value);
+    little_endian_store_32(value_buffer, 4, (uint32_t) (value >> 32));
+    return hci_dump_posix_pcapng_store_option(buffer, pos, code, value_buffer, sizeof(value_buffer));
+}
+
+// timestamps are stored as high and low 32-bit words
+static uint16_t hci_dump_posix_pcapng_store_timestamp(uint8_t * buffer, uint16_t pos, uint64_t timestamp_ns){
+    little_endian_store_32(buffer, pos, (uint32_t) (timestamp_ns >> 32));
+    little_endian_store_32(buffer, pos + 4u, (uint32_t) timestamp_ns);
+    return (uint16_t) (pos + 8u);
+}
+
+static uint16_t hci_dump_posix_pcapng_store_option_timestamp(uint8_t * buffer, uint16_t pos, uint16_t code, uint64_t timestamp_ns){
+    uint8_t value_buffer[8];
+    hci_dump_posix_pcapng_store_timestamp(value_buffer, 0, timestamp_ns);
+    return hci_dump_posix_pcapng_store_option(buffer, pos, code, value_buffer, sizeof(value_buffer));
+}
+
+// add end of options and trailing block length, update block length in header
+static uint16_t hci_dump_posix_pcapng_finalize_block(uint8_t * buffer, uint16_t pos, uint32_t block_type){
+    little_endian_store_32(buffer, pos, OPTION_END_OF_OPT);
+    pos += 4u;
+    little_endian_store_32(buffer, 0, block_type);
+    little_endian_store_32(buffer, 4, pos + 4u);
+    little_endian_store_32(buffer, pos, pos + 4u);
+    return (uint16_t) (pos + 4u);
+}
+
+static void hci_dump_posix_pcapng_write_block(uint16_t block_len){
+    ssize_t bytes_written = write(dump_file, block_buffer, block_len);
+    if (bytes_written > 0){
+        file_offset += bytes_written;
+    }
+}
+
+static void hci_dump_posix_pcapng_write_section_header(void){
+    uint16_t pos = 8;
+    little_endian_store_32(block_buffer, pos, BYTE_ORDER_MAGIC);
+    little_endian_store_16(block_buffer, pos + 4u, 1);      // major version
+    little_endian_store_16(block_buffer, pos + 6u, 0);      // minor version
+    little_endian_store_32(block_buffer, pos + 8u, 0xffffffffu); // section length not specified
+    little_endian_store_32(block_buffer, pos + 12u, 0xffffffffu);
+    pos += 16u;
+    const char * user_application = "BTstack";
+    pos = hci_dump_posix_pcapng_store_option(block_buffer, pos, OPTION_SHB_USERAPPL, user_application, (uint16_t) strlen(user_application));
+    hci_dump_posix_pcapng_write_block(hci_dump_posix_pcapng_finalize_block(block_buffer, pos, BLOCK_TYPE_SECTION_HEADER));
+}
+
+static void hci_dump_posix_pcapng_write_interface_description(uint32_t interface_id){
+    uint16_t pos = 8;
+    little_endian_store_16(block_buffer, pos, LINKTYPE_BLUETOOTH_LINUX_MONITOR);
+    little_endian_store_16(block_buffer, pos + 2u, 0);      // reserved
+    little_endian_store_32(block_buffer, pos + 4u, 0);      // no snaplen
+    pos += 8u;
+    const char * name = interfaces[interface_id].name;
+    pos = hci_dump_posix_pcapng_store_option(block_buffer, pos, OPTION_IF_NAME, name, (uint16_t) strlen(name));
+    const uint8_t resolution_ns = 9;
+    pos = hci_dump_posix_pcapng_store_option(block_buffer, pos, OPTION_IF_TSRESOL, &resolution_ns, 1);
+    hci_dump_posix_pcapng_write_block(hci_dump_posix_pcapng_finalize_block(block_buffer, pos, BLOCK_TYPE_INTERFACE_DESCRIPTION));
+}
+
+static void hci_dump_posix_pcapng_write_interface_statistics(uint32_t interface_id, uint64_t timestamp_ns){
+    hci_dump_posix_pcapng_interface_t * interface = &interfaces[interface_id];
+    uint16_t pos = 8;
+    little_endian_store_32(block_buffer, pos, interface_id);
+    pos = hci_dump_posix_pcapng_store_timestamp(block_buffer, pos + 4u, timestamp_ns);
+    pos = hci_dump_posix_pcapng_store_option_timestamp(block_buffer, pos, OPTION_ISB_STARTTIME, interface->start_time_ns);
+    pos = hci_dump_posix_pcapng_store_option_timestamp(block_buffer, pos, OPTION_ISB_ENDTIME, timestamp_ns);
+    pos = hci_dump_posix_pcapng_store_option_64(block_buffer, pos, OPTION_ISB_IFRECV, interface->num_packets + interface->num_dropped);
+    pos = hci_dump_posix_pcapng_store_option_64(block_buffer, pos, OPTION_ISB_IFDROP, interface->num_dropped);
+    hci_dump_posix_pcapng_write_block(hci_dump_posix_pcapng_finalize_block(block_buffer, pos, BLOCK_TYPE_INTERFACE_STATISTICS));
+}
+
+static uint16_t hci_dump_posix_pcapng_get_monitor_opcode(uint8_t packet_type, uint8_t in){
+    switch (packet_type){
+        case HCI_COMMAND_DATA_PACKET:
+            return MONITOR_COMMAND_PKT;
+        case HCI_EVENT_PACKET:
+            return MONITOR_EVENT_PKT;
+        case HCI_ACL_DATA_PACKET:
+            return in ? MONITOR_ACL_RX_PKT : MONITOR_ACL_TX_PKT;
+        case HCI_SCO_DATA_PACKET:
+            return in ? MONITOR_SCO_RX_PKT : MONITOR_SCO_TX_PKT;
+        case HCI_ISO_DATA_PACKET:
+            return in ? MONITOR_ISO_RX_PKT : MONITOR_ISO_TX_PKT;
+        case LOG_MESSAGE_PACKET:
+            return MONITOR_SYSTEM_NOTE;
+        default:
+            return 0;
+    }
+}
+
+static void hci_dump_posix_pcapng_write_enhanced_packet(uint32_t interface_id, uint8_t packet_type, uint8_t in,
+                                                        const uint8_t * packet, uint16_t len, uint16_t original_len, const char * comment){
+    uint16_t opcode = hci_dump_posix_pcapng_get_monitor_opcode(packet_type, in);
+    if (opcode == 0u) return;
+
+    hci_dump_posix_pcapng_interface_t * interface = &interfaces[interface_id];
+    uint8_t header[ENHANCED_PACKET_HEADER_SIZE];
+
+    // options after packet data, padded to 32 bit
+    uint32_t captured_len = MONITOR_HEADER_SIZE + len;
+    uint16_t padding = (uint16_t) ((4u - (captured_len & 3u)) & 3u);
+    (void) memset(trailer_buffer, 0, padding);
+    uint16_t trailer_len = padding;
+    if (interface->num_dropped_pending > 0u){
+        trailer_len = hci_dump_posix_pcapng_store_option_64(trailer_buffer, trailer_len, OPTION_EPB_DROPCOUNT, interface->num_dropped_pending);
+    }
+    if (comment != NULL){
+        trailer_len = hci_dump_posix_pcapng_store_option(trailer_buffer, trailer_len, OPTION_COMMENT, comment, (uint16_t) strlen(comment));
+    }
+    if (trailer_len > padding){
+        little_endian_store_32(trailer_buffer, trailer_len, OPTION_END_OF_OPT);
+        trailer_len += 4u;
+    }
+    uint32_t block_len = ENHANCED_PACKET_HEADER_SIZE + len + trailer_len + 4u;
+    little_endian_store_32(trailer_buffer, trailer_len, block_len);
+    trailer_len += 4u;
+
+    little_endian_store_32(header, 0, BLOCK_TYPE_ENHANCED_PACKET);
+    little_endian_store_32(header, 4, block_len);
+    little_endian_store_32(header, 8, interface_id);
+    hci_dump_posix_pcapng_store_timestamp(header, 12, hci_dump_posix_pcapng_get_time_ns());
+    little_endian_store_32(header, 20, captured_len);
+    little_endian_store_32(header, 24, MONITOR_HEADER_SIZE + original_len);
+    big_endian_store_16(header, 28, (uint16_t) interface_id);
+    big_endian_store_16(header, 30, opcode);
+
+    struct iovec iov[3];
+    iov[0].iov_base = header;
+    iov[0].iov_len  = sizeof(header);
+    iov[1].iov_base = (void *) packet;
+    iov[1].iov_len  = len;
+    iov[2].iov_base = trailer_buffer;
+    iov[2].iov_len  = trailer_len;
+    ssize_t bytes_written = writev(dump_file, iov, 3);
+    if (bytes_written != (ssize_t) block_len){
+        // remove partial block
+        if (bytes_written > 0){
+            int err = ftruncate(dump_file, file_offset);
+            UNUSED(err);
+            (void) lseek(dump_file, file_offset, SEEK_SET);
+        }
+        // report as dropped with next packet
+        interface->num_dropped_pending++;
+        interface->num_dropped++;
+        return;
+    }
+    file_offset += bytes_written;
+    interface->num_dropped_pending = 0;
+    interface->num_packets++;
+}
+
+// add default interface if none was added
+static bool hci_dump_posix_pcapng_ready(void){
+    if (dump_file < 0) return false;
+    if (num_interfaces == 0u){
+        hci_dump_posix_pcapng_add_interface("hci0");
+    }
+    return current_interface_id < num_interfaces;
+}
+
+static void hci_dump_posix_pcapng_reset(void){
+    btstack_assert(dump_file >= 0);
+    (void) lseek(dump_file, 0, SEEK_SET);
+    int err = ftruncate(dump_file, 0);
+    UNUSED(err);
+    file_offset = 0;
+    hci_dump_posix_pcapng_write_section_header();
+    uint64_t timestamp_ns = hci_dump_posix_pcapng_get_time_ns();
+    uint32_t interface_id;
+    for (interface_id = 0; interface_id < num_interfaces; interface_id++){
+        hci_dump_posix_pcapng_write_interface_description(interface_id);
+        interfaces[interface_id].start_time_ns = timestamp_ns;
+        interfaces[interface_id].num_packets = 0;
+        interfaces[interface_id].num_dropped = interfaces[interface_id].num_dropped_pending;
+    }
+}
+
+static void hci_dump_posix_pcapng_log_packet_current(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len) {
+    if (hci_dump_posix_pcapng_ready() == false) return;
+    hci_dump_posix_pcapng_write_enhanced_packet(current_interface_id, packet_type, in, packet, len, len, NULL);
+}
+
+static void hci_dump_posix_pcapng_log_packet_truncated(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len) {
+    if (hci_dump_posix_pcapng_ready() == false) return;
+    hci_dump_posix_pcapng_write_enhanced_packet(current_interface_id, packet_type, in, packet, len, original_len, NULL);
+}
+
+static void hci_dump_posix_pcapng_log_message(int log_level, const char * format, va_list argptr){
+    UNUSED(log_level);
+    if (hci_dump_posix_pcapng_ready() == false) return;
+    int full_string_len = vsnprintf(log_message_buffer, sizeof(log_message_buffer), format, argptr);
+    if (full_string_len < 0) return;
+    uint16_t len = (uint16_t) btstack_min(sizeof(log_message_buffer) - 1u, (uint32_t) full_string_len);
+    // system note shows up in packet list, comment in packet comments and expert info
+    hci_dump_posix_pcapng_write_enhanced_packet(current_interface_id, LOG_MESSAGE_PACKET, 0, (const uint8_t *) log_message_buffer, len, len, log_message_buffer);
+}
+
+int hci_dump_posix_pcapng_open(const char *filename){
+    btstack_assert(dump_file < 0);
+    int oflags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_BINARY
+    oflags |= O_BINARY;
+#endif
+    int fd = open(filename, oflags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd < 0){
+        int err = errno;
+        log_error("open %s failed, errno %d", filename, err);
+        return err;
+    }
+    dump_file = fd;
+    file_offset = 0;
+    num_interfaces = 0;
+    current_interface_id = 0;
+    hci_dump_posix_pcapng_write_section_header();
+    return 0;
+}
+
+uint32_t hci_dump_posix_pcapng_add_interface(const char * name){
+    if (num_interfaces >= HCI_DUMP_POSIX_PCAPNG_MAX_INTERFACES){
+        return HCI_DUMP_POSIX_PCAPNG_INVALID_INTERFACE;
+    }
+    uint32_t interface_id = num_interfaces++;
+    hci_dump_posix_pcapng_interface_t * interface = &interfaces[interface_id];
+    (void) memset(interface, 0, sizeof(hci_dump_posix_pcapng_interface_t));
+    btstack_strcpy(interface->name, sizeof(interface->name), name);
+    interface->start_time_ns = hci_dump_posix_pcapng_get_time_ns();
+    if (dump_file >= 0){
+        hci_dump_posix_pcapng_write_interface_description(interface_id);
+    }
+    return interface_id;
+}
+
+void hci_dump_posix_pcapng_set_interface(uint32_t interface_id){
+    btstack_assert(interface_id < num_interfaces);
+    current_interface_id = interface_id;
+}
+
+void hci_dump_posix_pcapng_log_packet(uint32_t interface_id, uint8_t packet_type, uint8_t in, const uint8_t * packet, uint16_t len){
+    if (dump_file < 0) return;
+    if (interface_id >= num_interfaces) return;
+    hci_dump_posix_pcapng_write_enhanced_packet(interface_id, packet_type, in, packet, len, len, NULL);
+}
+
+void hci_dump_posix_pcapng_add_dropped_packets(uint32_t interface_id, uint32_t num_packets){
+    if (interface_id >= num_interfaces) return;
+    interfaces[interface_id].num_dropped_pending += num_packets;
+    interfaces[interface_id].num_dropped += num_packets;
+}
+
+void hci_dump_posix_pcapng_close(void){
+    if (dump_file < 0) return;
+    uint64_t timestamp_ns = hci_dump_posix_pcapng_get_time_ns();
+    uint32_t interface_id;
+    for (interface_id = 0; interface_id < num_interfaces; interface_id++){
+        hci_dump_posix_pcapng_write_interface_statistics(interface_id, timestamp_ns);
+    }
+    close(dump_file);
+    dump_file = -1;
+    num_interfaces = 0;
+    current_interface_id = 0;
+}
+
+const hci_dump_t * hci_dump_posix_pcapng_get_instance(void){
+    static const hci_dump_t hci_dump_instance = {
+        // void (*reset)(void);
+        &hci_dump_posix_pcapng_reset,
+        // void (*log_packet)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len);
+        &hci_dump_posix_pcapng_log_packet_current,
+        // void (*log_message)(int log_level, const char * format, va_list argptr);
+        &hci_dump_posix_pcapng_log_message,
+        // void (*snapshot)(void);
+        NULL,
+        // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+        &hci_dump_posix_pcapng_log_packet_truncated,
+    };
+    return &hci_dump_instance;
+}
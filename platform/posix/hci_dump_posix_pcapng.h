@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+/*
+ *  Dump HCI trace in pcapng format with one interface per HCI transport
+ *
+ *  Each interface uses the Linux Monitor link type with nanosecond timestamps. Log messages are stored as
+ *  system notes with the message as packet comment. Dropped packets are reported in the drop count of the
+ *  next packet and in the interface statistics written on close.
+ */
+
+#ifndef HCI_DUMP_POSIX_PCAPNG_H
+#define HCI_DUMP_POSIX_PCAPNG_H
+
+#include <stdint.h>
+#include "hci_dump.h"
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#define HCI_DUMP_POSIX_PCAPNG_INVALID_INTERFACE 0xffffffffu
+
+/* API_START */
+
+/**
+ * @brief Get HCI Dump POSIX pcapng Instance
+ * @return hci_dump_impl
+ */
+const hci_dump_t * hci_dump_posix_pcapng_get_instance(void);
+
+/**
+ * @brief Open Log file and write Section Header Block
+ * @param filename or path
+ * @returns 0 if ok, errno otherwise
+ */
+int hci_dump_posix_pcapng_open(const char *filename);
+
+/**
+ * @brief Add interface for an HCI transport, e.g. "hci0" or "/dev/ttyUSB0"
+ * @note If no interface was added, the first packet adds interface "hci0"
+ * @param name
+ * @return interface_id or HCI_DUMP_POSIX_PCAPNG_INVALID_INTERFACE if HCI_DUMP_POSIX_PCAPNG_MAX_INTERFACES reached
+ */
+uint32_t hci_dump_posix_pcapng_add_interface(const char * name);
+
+/**
+ * @brief Select interface for packets and messages logged via hci_dump
+ * @param interface_id
+ */
+void hci_dump_posix_pcapng_set_interface(uint32_t interface_id);
+
+/**
+ * @brief Log packet on given interface, e.g. for hosts that drive multiple HCI transports
+ * @param interface_id
+ * @param packet_type
+ * @param in is 1 for packets received from the Controller
+ * @param packet
+ * @param len
+ */
+void hci_dump_posix_pcapng_log_packet(uint32_t interface_id, uint8_t packet_type, uint8_t in, const uint8_t * packet, uint16_t len);
+
+/**
+ * @brief Report packets lost before they could be logged, e.g. by a transport or ring buffer
+ * @param interface_id
+ * @param num_packets
+ */
+void hci_dump_posix_pcapng_add_dropped_packets(uint32_t interface_id, uint32_t num_packets);
+
+/**
+ * @brief Write Interface Statistics Blocks and close Log file
+ */
+void hci_dump_posix_pcapng_close(void);
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+#endif // HCI_DUMP_POSIX_PCAPNG_H
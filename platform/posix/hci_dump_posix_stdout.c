@@ -149,6 +149,10 @@ const hci_dump_t * hci_dump_posix_stdout_get_instance(void){
         &hci_dump_posix_posix_stdout_log_packet,
         // void (*log_message)(int log_level, const char * format, va_list argptr);
         &hci_dump_posix_stdout_log_message,
+        // void (*snapshot)(void);
+        NULL,
+        // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+        NULL,
     };
     return &hci_dump_instance;
 }
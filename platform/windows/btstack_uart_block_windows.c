@@ -472,6 +472,8 @@ static const btstack_uart_block_t btstack_uart_windows = {
     /* void (*set_sleep)(btstack_uart_sleep_mode_t sleep_mode); */    NULL,
     /* void (*set_wakeup_handler)(void (*handler)(void)); */          NULL,
     NULL, NULL, NULL, NULL,
+    /* void (*set_bytes_received)(void (*bytes_handler)(uint16_t bytes_received)); */ NULL,
+    /* void (*receive_bytes)(uint8_t *buffer, uint16_t len); */       NULL,
 };
 
 const btstack_uart_block_t * btstack_uart_block_windows_instance(void){
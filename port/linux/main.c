@@ -61,7 +61,7 @@
 #include "btstack_event.h"
 #include "btstack_memory.h"
 #include "btstack_run_loop.h"
-#include "btstack_run_loop_posix.h"
+#include "btstack_run_loop_epoll.h"
 #include "btstack_signal.h"
 #include "btstack_stdin.h"
 #include "btstack_tlv_posix.h"
@@ -243,7 +243,7 @@ int main(int argc, const char * argv[]){
     }
     /// GET STARTED with BTstack ///
 	btstack_memory_init();
-    btstack_run_loop_init(btstack_run_loop_posix_get_instance());
+    btstack_run_loop_init(btstack_run_loop_epoll_get_instance());
 	    
     char pklg_path[PATH_MAX] = "/tmp/hci_dump_";
     // log into file using HCI_DUMP_PACKETLOGGER format
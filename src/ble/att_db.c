@@ -94,8 +94,49 @@ typedef struct att_iterator {
     uint8_t  const * uuid;
     uint16_t value_len;
     uint8_t  const * value;
+#ifdef ENABLE_ATT_DB_INDEX
+    // private: visit only attributes selected by index
+    uint8_t  index_mode;
+    uint16_t index_uuid16;
+    uint16_t index_pos;
+#endif
 } att_iterator_t;
 
+#ifdef ENABLE_ATT_DB_INDEX
+
+// 10 bytes RAM per attribute
+#ifndef ATT_DB_INDEX_MAX_ATTRIBUTES
+#define ATT_DB_INDEX_MAX_ATTRIBUTES 512
+#endif
+
+typedef enum {
+    ATT_ITERATOR_INDEX_NONE = 0,
+    ATT_ITERATOR_INDEX_UUID16,
+    ATT_ITERATOR_INDEX_SERVICE_GROUPS,
+} att_iterator_index_mode_t;
+
+// index over att_database, attributes are stored by position in ascending handle order
+static bool     att_db_index_valid;
+static uint16_t att_db_index_num_attributes;
+static uint8_t const * att_db_index_end_tag;
+static const uint16_t * att_db_index_handle;
+static const uint16_t * att_db_index_offset;
+static const uint16_t * att_db_index_uuid16;
+// position of last attribute before the next service declaration
+static const uint16_t * att_db_index_group_end;
+// positions sorted by UUID16, then by handle
+static const uint16_t * att_db_index_by_uuid16;
+
+#if ATT_DB_INDEX_MAX_ATTRIBUTES > 0
+// index built by att_set_db
+static uint16_t att_db_index_storage_handle[ATT_DB_INDEX_MAX_ATTRIBUTES];
+static uint16_t att_db_index_storage_offset[ATT_DB_INDEX_MAX_ATTRIBUTES];
+static uint16_t att_db_index_storage_uuid16[ATT_DB_INDEX_MAX_ATTRIBUTES];
+static uint16_t att_db_index_storage_group_end[ATT_DB_INDEX_MAX_ATTRIBUTES];
+static uint16_t att_db_index_storage_by_uuid16[ATT_DB_INDEX_MAX_ATTRIBUTES];
+#endif
+#endif
+
 static void att_persistent_ccc_cache(att_iterator_t * it);
 
 static uint8_t const * att_database = NULL;
@@ -110,13 +151,23 @@ static uint16_t att_persistent_ccc_uuid16;
 
 static void att_iterator_init(att_iterator_t *it){
     it->att_ptr = att_database;
+#ifdef ENABLE_ATT_DB_INDEX
+    it->index_mode = ATT_ITERATOR_INDEX_NONE;
+#endif
 }
 
 static bool att_iterator_has_next(att_iterator_t *it){
     return it->att_ptr != NULL;
 }
 
+#ifdef ENABLE_ATT_DB_INDEX
+static void att_iterator_index_seek_next(att_iterator_t *it);
+#endif
+
 static void att_iterator_fetch_next(att_iterator_t *it){
+#ifdef ENABLE_ATT_DB_INDEX
+    att_iterator_index_seek_next(it);
+#endif
     it->size   = little_endian_read_16(it->att_ptr, 0);
     if (it->size == 0u){
         it->flags = 0;
@@ -186,10 +237,244 @@ static bool att_db_is_handle_range_valid(uint16_t start_handle, uint16_t end_han
     return (start_handle <= end_handle) && (start_handle != 0u);
 }
 
+#ifdef ENABLE_ATT_DB_INDEX
+
+static bool att_db_index_is_service(uint16_t pos){
+    switch (att_db_index_uuid16[pos]){
+        case GATT_PRIMARY_SERVICE_UUID:
+        case GATT_SECONDARY_SERVICE_UUID:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void att_db_index_build(void){
+    att_db_index_valid = false;
+    att_db_index_num_attributes = 0;
+    att_db_index_end_tag = NULL;
+    if (att_database == NULL){
+        return;
+    }
+
+    // collect handle, offset and UUID16 for all attributes, walk to end tag in any case
+    bool handles_valid = true;
+    uint32_t num_attributes_total = 0;
+    uint16_t num_attributes = 0;
+    uint16_t prev_handle = 0;
+    att_iterator_t it;
+    att_iterator_init(&it);
+    while (att_iterator_has_next(&it)){
+        uint8_t const * att_ptr = it.att_ptr;
+        uintptr_t offset = (uintptr_t) (att_ptr - att_database);
+        att_iterator_fetch_next(&it);
+        if (it.handle == 0u){
+            att_db_index_end_tag = att_ptr;
+            break;
+        }
+        num_attributes_total++;
+        if ((it.handle <= prev_handle) || (offset > 0xffffu)){
+            handles_valid = false;
+        }
+        prev_handle = it.handle;
+        if ((handles_valid == false) || (num_attributes == ATT_DB_INDEX_MAX_ATTRIBUTES)){
+            continue;
+        }
+#if ATT_DB_INDEX_MAX_ATTRIBUTES > 0
+        att_db_index_storage_handle[num_attributes] = it.handle;
+        att_db_index_storage_offset[num_attributes] = (uint16_t) offset;
+        att_db_index_storage_uuid16[num_attributes] = att_iterator_get_uuid16(&it);
+#endif
+        num_attributes++;
+    }
+
+#if ATT_DB_INDEX_MAX_ATTRIBUTES > 0
+    // RAM index enabled but not usable for this ATT DB
+    if (handles_valid == false){
+        log_info("ATT DB index: not used, handles not ascending or ATT DB larger than 64 kB");
+        return;
+    }
+    if (num_attributes_total > ATT_DB_INDEX_MAX_ATTRIBUTES){
+        log_info("ATT DB index: not used, %u attributes > ATT_DB_INDEX_MAX_ATTRIBUTES %u", (unsigned int) num_attributes_total, ATT_DB_INDEX_MAX_ATTRIBUTES);
+        return;
+    }
+
+    att_db_index_handle    = att_db_index_storage_handle;
+    att_db_index_offset    = att_db_index_storage_offset;
+    att_db_index_uuid16    = att_db_index_storage_uuid16;
+    att_db_index_group_end = att_db_index_storage_group_end;
+    att_db_index_by_uuid16 = att_db_index_storage_by_uuid16;
+
+    // service groups
+    uint16_t pos = num_attributes;
+    uint16_t group_end = num_attributes - 1u;
+    while (pos > 0u){
+        pos--;
+        att_db_index_storage_group_end[pos] = group_end;
+        if (att_db_index_is_service(pos) && (pos > 0u)){
+            group_end = pos - 1u;
+        }
+    }
+
+    // sort positions by UUID16 with stable insertion sort, attributes are already sorted by handle
+    for (pos = 0; pos < num_attributes; pos++){
+        uint16_t uuid16 = att_db_index_storage_uuid16[pos];
+        uint16_t i = pos;
+        while ((i > 0u) && (att_db_index_storage_uuid16[att_db_index_storage_by_uuid16[i - 1u]] > uuid16)){
+            att_db_index_storage_by_uuid16[i] = att_db_index_storage_by_uuid16[i - 1u];
+            i--;
+        }
+        att_db_index_storage_by_uuid16[i] = pos;
+    }
+
+    att_db_index_num_attributes = num_attributes;
+    att_db_index_valid = true;
+    log_info("ATT DB index: %u attributes", num_attributes);
+#else
+    // RAM index disabled, only end tag needed for att_set_db_index
+    UNUSED(handles_valid);
+    UNUSED(num_attributes_total);
+#endif
+}
+
+static bool att_db_index_ready(void){
+    if (att_database == NULL){
+        return false;
+    }
+    // att_db_util appends attributes in place, rebuild if end tag was overwritten
+    if ((att_db_index_end_tag == NULL) || (little_endian_read_16(att_db_index_end_tag, 0) != 0u)){
+        att_db_index_build();
+    }
+    return att_db_index_valid;
+}
+
+// returns position of first attribute with handle >= given handle
+static uint16_t att_db_index_lower_bound(uint16_t handle){
+    uint16_t low  = 0;
+    uint16_t high = att_db_index_num_attributes;
+    while (low < high){
+        uint16_t mid = (low + high) / 2u;
+        if (att_db_index_handle[mid] < handle){
+            low = mid + 1u;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// returns index into att_db_index_by_uuid16 of first attribute with given UUID16 and handle >= given handle
+static uint16_t att_db_index_lower_bound_uuid16(uint16_t uuid16, uint16_t handle){
+    uint16_t low  = 0;
+    uint16_t high = att_db_index_num_attributes;
+    while (low < high){
+        uint16_t mid = (low + high) / 2u;
+        uint16_t pos = att_db_index_by_uuid16[mid];
+        if ((att_db_index_uuid16[pos] < uuid16) || ((att_db_index_uuid16[pos] == uuid16) && (att_db_index_handle[pos] < handle))){
+            low = mid + 1u;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// position == number of attributes selects end tag
+static void att_iterator_set_position(att_iterator_t *it, uint16_t pos){
+    if (pos < att_db_index_num_attributes){
+        it->att_ptr = &att_database[att_db_index_offset[pos]];
+    } else {
+        it->att_ptr = att_db_index_end_tag;
+    }
+}
+
+static void att_iterator_index_seek_next(att_iterator_t *it){
+    uint16_t pos = it->index_pos;
+    switch (it->index_mode){
+        case ATT_ITERATOR_INDEX_UUID16:
+            if ((pos < att_db_index_num_attributes) && (att_db_index_uuid16[att_db_index_by_uuid16[pos]] == it->index_uuid16)){
+                att_iterator_set_position(it, att_db_index_by_uuid16[pos]);
+                it->index_pos++;
+            } else {
+                att_iterator_set_position(it, att_db_index_num_attributes);
+            }
+            break;
+        case ATT_ITERATOR_INDEX_SERVICE_GROUPS:
+            // visit service declaration and last attribute of its group
+            att_iterator_set_position(it, pos);
+            if ((pos < att_db_index_num_attributes) && att_db_index_is_service(pos) && (att_db_index_group_end[pos] != pos)){
+                it->index_pos = att_db_index_group_end[pos];
+            } else {
+                it->index_pos = pos + 1u;
+            }
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
+// visit attributes with handle >= start_handle
+static void att_iterator_init_from_handle(att_iterator_t *it, uint16_t start_handle){
+    att_iterator_init(it);
+#ifdef ENABLE_ATT_DB_INDEX
+    if (att_db_index_ready()){
+        att_iterator_set_position(it, att_db_index_lower_bound(start_handle));
+    }
+#else
+    UNUSED(start_handle);
+#endif
+}
+
+// visit attributes with handle >= start_handle, with index only the ones with matching UUID16
+static void att_iterator_init_uuid16(att_iterator_t *it, uint16_t start_handle, uint16_t uuid16){
+#ifdef ENABLE_ATT_DB_INDEX
+    if ((uuid16 != 0u) && att_db_index_ready()){
+        att_iterator_init(it);
+        it->index_mode   = ATT_ITERATOR_INDEX_UUID16;
+        it->index_uuid16 = uuid16;
+        it->index_pos    = att_db_index_lower_bound_uuid16(uuid16, start_handle);
+        return;
+    }
+#else
+    UNUSED(uuid16);
+#endif
+    att_iterator_init_from_handle(it, start_handle);
+}
+
+// visit attributes with handle >= start_handle, with index only service declarations and the last attribute of each group
+static void att_iterator_init_service_groups(att_iterator_t *it, uint16_t start_handle){
+#ifdef ENABLE_ATT_DB_INDEX
+    if (att_db_index_ready()){
+        uint16_t pos = att_db_index_lower_bound(start_handle);
+        if ((pos < att_db_index_num_attributes) && !att_db_index_is_service(pos)){
+            pos = att_db_index_group_end[pos] + 1u;
+        }
+        att_iterator_init(it);
+        it->index_mode = ATT_ITERATOR_INDEX_SERVICE_GROUPS;
+        it->index_pos  = pos;
+        return;
+    }
+#endif
+    att_iterator_init_from_handle(it, start_handle);
+}
+
 static bool att_find_handle(att_iterator_t *it, uint16_t handle){
     if (handle == 0u){
         return false;
     }
+#ifdef ENABLE_ATT_DB_INDEX
+    if (att_db_index_ready()){
+        uint16_t pos = att_db_index_lower_bound(handle);
+        if ((pos == att_db_index_num_attributes) || (att_db_index_handle[pos] != handle)){
+            return false;
+        }
+        att_iterator_init(it);
+        att_iterator_set_position(it, pos);
+        att_iterator_fetch_next(it);
+        return true;
+    }
+#endif
     att_iterator_init(it);
     while (att_iterator_has_next(it)){
         att_iterator_fetch_next(it);
@@ -272,7 +557,54 @@ void att_set_db(uint8_t const * db){
     log_info("att_set_db %p", db);
     // ignore db version
     att_database = &db[1];
+#ifdef ENABLE_ATT_DB_INDEX
+    att_db_index_build();
+#endif
+}
+
+#ifdef ENABLE_ATT_DB_INDEX
+void att_set_db_index(const uint16_t * index){
+    if ((att_database == NULL) || (index == NULL)){
+        return;
+    }
+    uint16_t num_attributes = index[0];
+    const uint16_t * handles = &index[2];
+    const uint16_t * offsets = &index[2u + num_attributes];
+
+    // verify that index matches current db
+    uint16_t pos = 0;
+    att_iterator_t it;
+    att_iterator_init(&it);
+    while (att_iterator_has_next(&it)){
+        uintptr_t offset = (uintptr_t) (it.att_ptr - att_database);
+        att_iterator_fetch_next(&it);
+        if (it.handle == 0u){
+            if (offset == index[1]){
+                break;
+            }
+        } else if ((pos < num_attributes) && (offset == offsets[pos]) && (it.handle == handles[pos])){
+            pos++;
+            continue;
+        }
+        log_error("ATT DB index does not match ATT DB, please regenerate .h from .gatt file");
+        return;
+    }
+    if (pos != num_attributes){
+        log_error("ATT DB index does not match ATT DB, please regenerate .h from .gatt file");
+        return;
+    }
+
+    att_db_index_num_attributes = num_attributes;
+    att_db_index_end_tag   = &att_database[index[1]];
+    att_db_index_handle    = handles;
+    att_db_index_offset    = offsets;
+    att_db_index_uuid16    = &index[2u + (2u * num_attributes)];
+    att_db_index_group_end = &index[2u + (3u * num_attributes)];
+    att_db_index_by_uuid16 = &index[2u + (4u * num_attributes)];
+    att_db_index_valid = true;
+    log_info("ATT DB index: %u attributes from %p", num_attributes, index);
 }
+#endif
 
 void att_set_read_callback(att_read_callback_t callback){
     att_read_callback = callback;
@@ -476,7 +808,7 @@ static uint16_t handle_find_information_request2(att_connection_t * att_connecti
     uint16_t uuid_len = 0;
     
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_from_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if (!it.handle){
@@ -581,7 +913,11 @@ static uint16_t handle_find_by_type_value_request(att_connection_t * att_connect
     uint16_t prev_handle = 0;
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    if ((attribute_type == (uint16_t)GATT_PRIMARY_SERVICE_UUID) || (attribute_type == (uint16_t)GATT_SECONDARY_SERVICE_UUID)){
+        att_iterator_init_service_groups(&it, start_handle);
+    } else {
+        att_iterator_init_from_handle(&it, start_handle);
+    }
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
 
@@ -648,7 +984,7 @@ static uint16_t handle_read_by_type_request2(att_connection_t * att_connection,
     uint16_t pair_len = 0;
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_uuid16(&it, start_handle, uuid16_from_uuid(attribute_type_len, attribute_type));
     uint8_t error_code = 0;
     uint16_t first_matching_but_unreadable_handle = 0;
 
@@ -1037,7 +1373,7 @@ static uint16_t handle_read_by_group_type_request2(att_connection_t * att_connec
     uint16_t prev_handle = 0;
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_service_groups(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         
@@ -1482,7 +1818,7 @@ bool gatt_server_get_handle_range_for_service_with_uuid16(uint16_t uuid16, uint1
 // returns false if not found
 uint16_t gatt_server_get_value_handle_for_characteristic_with_uuid16(uint16_t start_handle, uint16_t end_handle, uint16_t uuid16){
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_uuid16(&it, start_handle, uuid16);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if ((it.handle != 0u) && (it.handle < start_handle)){
@@ -1503,7 +1839,7 @@ uint16_t gatt_server_get_value_handle_for_characteristic_with_uuid16(uint16_t st
 
 uint16_t gatt_server_get_descriptor_handle_for_characteristic_with_uuid16(uint16_t start_handle, uint16_t end_handle, uint16_t characteristic_uuid16, uint16_t descriptor_uuid16){
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_from_handle(&it, start_handle);
     bool characteristic_found = false;
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
@@ -1595,7 +1931,7 @@ uint16_t gatt_server_get_value_handle_for_characteristic_with_uuid128(uint16_t s
     uint8_t attribute_value[16];
     reverse_128(uuid128, attribute_value);
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_from_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if ((it.handle != 0u) && (it.handle < start_handle)){
@@ -1619,7 +1955,7 @@ uint16_t gatt_server_get_client_configuration_handle_for_characteristic_with_uui
     uint8_t attribute_value[16];
     reverse_128(uuid128, attribute_value);
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_from_handle(&it, start_handle);
     bool characteristic_found = false;
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
@@ -1658,7 +1994,7 @@ bool gatt_server_get_included_service_with_uuid16(uint16_t start_handle, uint16_
     uint16_t * out_included_service_handle, uint16_t * out_included_service_start_handle, uint16_t * out_included_service_end_handle){
 
     att_iterator_t it;
-    att_iterator_init(&it);
+    att_iterator_init_from_handle(&it, start_handle);
     while (att_iterator_has_next(&it)){
         att_iterator_fetch_next(&it);
         if ((it.handle != 0u) && (it.handle < start_handle)){
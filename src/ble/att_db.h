@@ -189,6 +189,13 @@ typedef struct att_service_handler {
  */
 void att_set_db(uint8_t const * db);
 
+/**
+ * @brief use constant index tables generated by compile_gatt.py --index instead of building index in RAM
+ * @note requires ENABLE_ATT_DB_INDEX, call after att_set_db / att_server_init
+ * @param index e.g. profile_data_index
+ */
+void att_set_db_index(const uint16_t * index);
+
 /*
  * @brief set callback for read of dynamic attributes
  * @param callback
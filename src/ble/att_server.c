@@ -80,6 +80,9 @@
 #define ATT_SERVER_FLAGS_DELAYED_RESPONSE       (1u<<0u)
 #define ATT_SERVER_FLAGS_VALIDATE_DATABASE_HASH (1u<<1u)
 
+// Client Supported Features
+#define ATT_SERVER_CLIENT_SUPPORTED_FEATURES_MULTIPLE_HANDLE_VALUE_NOTIFICATIONS (1u<<2u)
+
 static void att_run_for_context(att_server_t * att_server, att_connection_t * att_connection);
 static att_write_callback_t att_server_write_callback_for_handle(uint16_t handle);
 static btstack_packet_handler_t att_server_packet_handler_for_handle(uint16_t handle);
@@ -87,6 +90,10 @@ static void att_server_handle_can_send_now(void);
 static void att_server_persistent_ccc_restore(att_server_t * att_server, att_connection_t * att_connection);
 static void att_server_persistent_ccc_clear(int le_device_db_index);
 static void att_server_handle_att_pdu(att_server_t * att_server, att_connection_t * att_connection, uint8_t * packet, uint16_t size);
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+static void att_server_notification_coalescing_track_client_supported_features(hci_con_handle_t con_handle, uint16_t attribute_handle, const uint8_t * value, uint16_t value_len);
+static void att_server_notification_coalescing_reset(att_server_t * att_server);
+#endif
 
 typedef enum {
     ATT_SERVER_RUN_PHASE_1_REQUESTS = 0,
@@ -393,6 +400,9 @@ static void att_server_event_packet_handler (uint8_t packet_type, uint16_t chann
                     att_connection->con_handle = 0;
                     att_server->pairing_active = false;
                     att_server->state = ATT_SERVER_IDLE;
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+                    att_server_notification_coalescing_reset(att_server);
+#endif
                     if (att_server->value_indication_handle != 0u){
                         btstack_run_loop_remove_timer(&att_server->value_indication_timer);
                         uint16_t att_handle = att_server->value_indication_handle;
@@ -1036,6 +1046,48 @@ static uint32_t att_server_tag_for_hash(void){
     return (((uint8_t)'B') << 24u) | (((uint8_t)'T') << 16u) | (((uint8_t)'D') << 8u) | ((uint8_t)'B');
 }
 
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+static uint32_t att_server_persistent_client_supported_features_tag_for_index(uint8_t le_device_index){
+    return (((uint8_t)'B') << 24u) | (((uint8_t)'T') << 16u) | (((uint8_t)'F') << 8u) | le_device_index;
+}
+
+static void att_server_persistent_client_supported_features_write(att_server_t * att_server, uint8_t client_supported_features){
+    // check if bonded
+    int le_device_index = att_server->ir_le_device_db_index;
+    if ((le_device_index < 0) || (le_device_index > 0xff)) return;
+
+    // get btstack_tlv
+    const btstack_tlv_t * tlv_impl = NULL;
+    void * tlv_context;
+    btstack_tlv_get_instance(&tlv_impl, &tlv_context);
+    if (!tlv_impl) return;
+
+    uint32_t tag = att_server_persistent_client_supported_features_tag_for_index((uint8_t) le_device_index);
+    uint8_t stored_value;
+    int len = tlv_impl->get_tag(tlv_context, tag, &stored_value, 1);
+    if ((len == 1) && (stored_value == client_supported_features)) return;
+    log_info("Store Client Supported Features 0x%02x for le device id %d", client_supported_features, le_device_index);
+    int result = tlv_impl->store_tag(tlv_context, tag, &client_supported_features, 1);
+    if (result != 0){
+        log_error("Store Client Supported Features failed");
+    }
+}
+
+static void att_server_persistent_client_supported_features_restore(att_server_t * att_server, const btstack_tlv_t * tlv_impl, void * tlv_context){
+    // check if bonded
+    int le_device_index = att_server->ir_le_device_db_index;
+    if ((le_device_index < 0) || (le_device_index > 0xff)) return;
+
+    uint32_t tag = att_server_persistent_client_supported_features_tag_for_index((uint8_t) le_device_index);
+    uint8_t client_supported_features;
+    int len = tlv_impl->get_tag(tlv_context, tag, &client_supported_features, 1);
+    if (len != 1) return;
+    att_server->multiple_notifications_supported =
+        (client_supported_features & ATT_SERVER_CLIENT_SUPPORTED_FEATURES_MULTIPLE_HANDLE_VALUE_NOTIFICATIONS) != 0u;
+    log_info("Restore Client Supported Features 0x%02x, multiple notifications supported %u", client_supported_features, att_server->multiple_notifications_supported);
+}
+#endif
+
 static void att_server_persistent_ccc_write(hci_con_handle_t con_handle, uint16_t att_handle, uint16_t value){
     // lookup att_server instance
     hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
@@ -1137,6 +1189,11 @@ static void att_server_persistent_ccc_clear(int le_device_index){
     void * tlv_context;
     btstack_tlv_get_instance(&tlv_impl, &tlv_context);
     if (!tlv_impl) return;
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+    if ((le_device_index >= 0) && (le_device_index <= 0xff)){
+        tlv_impl->delete_tag(tlv_context, att_server_persistent_client_supported_features_tag_for_index((uint8_t) le_device_index));
+    }
+#endif
     // get all ccc tag
     int index;
     persistent_ccc_entry_t entry;
@@ -1200,6 +1257,11 @@ static void att_server_persistent_ccc_restore(att_server_t * att_server, att_con
     btstack_tlv_get_instance(&tlv_impl, &tlv_context);
     if (!tlv_impl) return;
 
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+    // Client Supported Features do not refer to attribute handles
+    att_server_persistent_client_supported_features_restore(att_server, tlv_impl, tlv_context);
+#endif
+
     // validate database hash
     if ((att_server_flags & ((uint8_t)ATT_SERVER_FLAGS_VALIDATE_DATABASE_HASH)) != 0u) {
         att_server_flags &= ((uint8_t)~ATT_SERVER_FLAGS_VALIDATE_DATABASE_HASH);
@@ -1322,6 +1384,12 @@ static int att_server_write_callback(hci_con_handle_t con_handle, uint16_t attri
         att_server_persistent_ccc_write(con_handle, attribute_handle, little_endian_read_16(buffer, 0));
     }
 
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+    if (offset == 0u){
+        att_server_notification_coalescing_track_client_supported_features(con_handle, attribute_handle, buffer, buffer_size);
+    }
+#endif
+
     att_write_callback_t callback = att_server_write_callback_for_handle(attribute_handle);
     if (!callback) return 0;
     return (*callback)(con_handle, attribute_handle, transaction_mode, offset, buffer, buffer_size);
@@ -1469,19 +1537,165 @@ static uint8_t att_server_prepare_server_message(hci_con_handle_t con_handle, at
     return ERROR_CODE_SUCCESS;
 }
 
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+static void att_server_notification_coalescing_track_client_supported_features(hci_con_handle_t con_handle, uint16_t attribute_handle, const uint8_t * value, uint16_t value_len){
+    if (value_len == 0u) return;
+    if (att_uuid_for_handle(attribute_handle) != GATT_CLIENT_SUPPORTED_FEATURES) return;
+    hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
+    if (hci_connection == NULL) return;
+    hci_connection->att_server.multiple_notifications_supported =
+        (value[0] & ATT_SERVER_CLIENT_SUPPORTED_FEATURES_MULTIPLE_HANDLE_VALUE_NOTIFICATIONS) != 0u;
+    log_info("Multiple Handle Value Notifications supported by client: %u", hci_connection->att_server.multiple_notifications_supported);
+    att_server_persistent_client_supported_features_write(&hci_connection->att_server, value[0]);
+}
+
+static void att_server_notification_coalescing_reset(att_server_t * att_server){
+    btstack_run_loop_remove_timer(&att_server->notification_coalescing_timer);
+    att_server->notification_coalescing_size = 0;
+    att_server->multiple_notifications_supported = false;
+}
+
+static uint16_t att_server_notification_coalescing_mtu(hci_connection_t * hci_connection){
+#ifdef ENABLE_GATT_OVER_EATT
+    att_server_eatt_bearer_t * eatt_bearer = att_server_eatt_bearer_for_con_handle(hci_connection->con_handle);
+    if (eatt_bearer != NULL){
+        return eatt_bearer->att_connection.mtu;
+    }
+#endif
+    return hci_connection->att_connection.mtu;
+}
+
+// send queued notifications that fit into the ATT MTU, remaining ones are sent on next can send now
+static void att_server_notification_coalescing_flush(hci_connection_t * hci_connection){
+    att_server_t * queue = &hci_connection->att_server;
+    if (queue->notification_coalescing_size == 0u) return;
+
+    att_server_t * att_server = NULL;
+    att_connection_t * att_connection = NULL;
+    uint8_t * packet_buffer = NULL;
+    uint8_t status = att_server_prepare_server_message(hci_connection->con_handle, &att_server, &att_connection, &packet_buffer);
+    if (status != ERROR_CODE_SUCCESS){
+        (void) att_server_request_to_send_notification(&queue->notification_coalescing_request, hci_connection->con_handle);
+        return;
+    }
+
+    const uint8_t * tuples = queue->notification_coalescing_buffer;
+    uint16_t tuples_size = 0;
+    uint8_t num_notifications = 0;
+    while (tuples_size < queue->notification_coalescing_size){
+        uint16_t tuple_size = 4u + little_endian_read_16(tuples, tuples_size + 2u);
+        if ((1u + tuples_size + tuple_size) > att_connection->mtu) break;
+        tuples_size += tuple_size;
+        num_notifications++;
+    }
+
+    uint16_t size;
+    if (num_notifications > 1u){
+        packet_buffer[0] = ATT_MULTIPLE_HANDLE_VALUE_NTF;
+        (void) memcpy(&packet_buffer[1], tuples, tuples_size);
+        size = 1u + tuples_size;
+    } else {
+        // single notification, or MTU reduced by bearer change
+        uint16_t value_len = little_endian_read_16(tuples, 2);
+        size = att_prepare_handle_value_notification(att_connection, little_endian_read_16(tuples, 0), &tuples[4], value_len, packet_buffer);
+        tuples_size = 4u + value_len;
+    }
+
+    queue->notification_coalescing_size -= tuples_size;
+    if (queue->notification_coalescing_size > 0u){
+        (void) memmove(queue->notification_coalescing_buffer, &queue->notification_coalescing_buffer[tuples_size], queue->notification_coalescing_size);
+        (void) att_server_request_to_send_notification(&queue->notification_coalescing_request, hci_connection->con_handle);
+    } else {
+        btstack_run_loop_remove_timer(&queue->notification_coalescing_timer);
+    }
+
+    (void) att_server_send_prepared(att_server, att_connection, packet_buffer, size);
+}
+
+static void att_server_notification_coalescing_handler(void * context){
+    hci_con_handle_t con_handle = (hci_con_handle_t) (uintptr_t) context;
+    hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
+    if (hci_connection == NULL) return;
+    att_server_notification_coalescing_flush(hci_connection);
+}
+
+static void att_server_notification_coalescing_timeout(btstack_timer_source_t * ts){
+    att_server_notification_coalescing_handler(btstack_run_loop_get_timer_context(ts));
+}
+
+// @return true if notification was queued or could not be queued (status set), false to send it directly
+static bool att_server_notification_coalescing_queue(hci_connection_t * hci_connection, uint16_t attribute_handle, const uint8_t *value, uint16_t value_len, uint8_t * status){
+    att_server_t * att_server = &hci_connection->att_server;
+    if (att_server->multiple_notifications_supported == false) return false;
+    // connection interval only known for LE connections
+    if (hci_connection->le_connection_interval == 0u) return false;
+
+    att_server->notification_coalescing_request.callback = &att_server_notification_coalescing_handler;
+    att_server->notification_coalescing_request.context = (void *) (uintptr_t) hci_connection->con_handle;
+
+    uint16_t max_size = btstack_min(ATT_NOTIFICATION_COALESCING_BUFFER_SIZE, att_server_notification_coalescing_mtu(hci_connection) - 1u);
+    uint32_t tuple_size = 4u + (uint32_t) value_len;
+    if (tuple_size > max_size){
+        // send queued notifications first to keep order
+        att_server_notification_coalescing_flush(hci_connection);
+        if (att_server->notification_coalescing_size == 0u) return false;
+        *status = BTSTACK_ACL_BUFFERS_FULL;
+        return true;
+    }
+
+    if ((att_server->notification_coalescing_size + tuple_size) > max_size){
+        att_server_notification_coalescing_flush(hci_connection);
+        if ((att_server->notification_coalescing_size + tuple_size) > max_size){
+            *status = BTSTACK_ACL_BUFFERS_FULL;
+            return true;
+        }
+    }
+
+    uint8_t * tuple = &att_server->notification_coalescing_buffer[att_server->notification_coalescing_size];
+    little_endian_store_16(tuple, 0, attribute_handle);
+    little_endian_store_16(tuple, 2, value_len);
+    (void) memcpy(&tuple[4], value, value_len);
+    att_server->notification_coalescing_size += (uint16_t) tuple_size;
+    *status = ERROR_CODE_SUCCESS;
+
+    if ((uint16_t) (max_size - att_server->notification_coalescing_size) < 5u){
+        // no space left for another notification
+        att_server_notification_coalescing_flush(hci_connection);
+    } else if (att_server->notification_coalescing_size == tuple_size){
+        // send after one connection interval, interval is in 1.25 ms units
+        uint32_t timeout_ms = ((uint32_t) hci_connection->le_connection_interval * 5u) / 4u;
+        btstack_run_loop_set_timer_handler(&att_server->notification_coalescing_timer, att_server_notification_coalescing_timeout);
+        btstack_run_loop_set_timer_context(&att_server->notification_coalescing_timer, (void *) (uintptr_t) hci_connection->con_handle);
+        btstack_run_loop_set_timer(&att_server->notification_coalescing_timer, timeout_ms);
+        btstack_run_loop_add_timer(&att_server->notification_coalescing_timer);
+    } else {
+        // timer already running
+    }
+    return true;
+}
+#endif
+
 uint8_t att_server_notify(hci_con_handle_t con_handle, uint16_t attribute_handle, const uint8_t *value, uint16_t value_len){
     att_server_t * att_server = NULL;
     att_connection_t * att_connection = NULL;
     uint8_t * packet_buffer = NULL;
+    uint8_t status;
 
-    uint8_t status = att_server_prepare_server_message(con_handle, &att_server, &att_connection, &packet_buffer);
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+    hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
+    if ((hci_connection != NULL) && att_server_notification_coalescing_queue(hci_connection, attribute_handle, value, value_len, &status)){
+        return status;
+    }
+#endif
+
+    status = att_server_prepare_server_message(con_handle, &att_server, &att_connection, &packet_buffer);
     if (status != ERROR_CODE_SUCCESS){
         return status;
     }
 
     uint16_t size = att_prepare_handle_value_notification(att_connection, attribute_handle, value, value_len, packet_buffer);
 
-    return att_server_send_prepared(att_server, att_connection, NULL, size);
+    return att_server_send_prepared(att_server, att_connection, packet_buffer, size);
 }
 
 /**
@@ -142,6 +142,8 @@ uint8_t att_server_request_to_send_indication(btstack_context_callback_registrat
 
 /**
  * @brief notify client about attribute value change
+ * @note With ENABLE_ATT_NOTIFICATION_COALESCING, notifications to LE clients that support Multiple Handle Value Notifications
+ *       are queued for one connection interval and sent in a single ATT_MULTIPLE_HANDLE_VALUE_NTF up to the ATT MTU
  * @param con_handle
  * @param attribute_handle
  * @param value
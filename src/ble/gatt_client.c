@@ -68,6 +68,10 @@
 #error "GATT Over EATT requires support for L2CAP Enhanced CoC. Please enable ENABLE_L2CAP_ENHANCED_CREDIT_BASED_FLOW_CONTROL_MODE"
 #endif
 
+#if defined(ENABLE_GATT_CLIENT_DISCOVERY_CACHE) && !defined(ENABLE_GATT_CLIENT_CACHING)
+#error "GATT Discovery Cache is validated by the Database Hash. Please enable ENABLE_GATT_CLIENT_CACHING"
+#endif
+
 // L2CAP Test Spec p35 defines a minimum of 100 ms, but PTS might indicate an error if we sent after 100 ms
 #define GATT_CLIENT_COLLISION_BACKOFF_MS 150
 
@@ -77,6 +81,9 @@ static btstack_linked_list_t gatt_client_service_value_listeners;
 #ifdef ENABLE_GATT_CLIENT_CACHING
 static btstack_linked_list_t gatt_client_caching_service_changed_handler;
 #endif
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+static btstack_context_callback_registration_t gatt_client_discovery_cache_delivery;
+#endif
 static btstack_packet_callback_registration_t hci_event_callback_registration;
 static btstack_packet_callback_registration_t sm_event_callback_registration;
 static btstack_context_callback_registration_t gatt_client_deferred_event_emit;
@@ -105,6 +112,13 @@ static uint8_t gatt_client_write_client_characteristic_configuration_internal(ga
 static void att_signed_write_handle_cmac_result(uint8_t hash[8]);
 #endif
 
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+static void gatt_client_run(void);
+static void gatt_client_handle_att_response(gatt_client_t * gatt_client, uint8_t * packet, uint16_t size);
+static bool gatt_client_discovery_cache_handle_request(gatt_client_t * gatt_client, uint16_t request_len);
+static void gatt_client_discovery_cache_handle_response(gatt_client_t * gatt_client, const uint8_t * response, uint16_t response_len);
+#endif
+
 #ifdef ENABLE_GATT_OVER_CLASSIC
 static gatt_client_t * gatt_client_get_context_for_l2cap_cid(uint16_t l2cap_cid);
 static void gatt_client_classic_handle_connected(gatt_client_t * gatt_client, uint8_t status);
@@ -284,6 +298,21 @@ static bool gatt_client_internal_query_pending(const gatt_client_t * gatt_client
     return false;
 }
 
+#ifdef ENABLE_GATT_OVER_EATT
+// find idle eatt channel
+static gatt_client_t * gatt_client_le_enhanced_get_ready_client(gatt_client_t * gatt_client){
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &gatt_client->eatt_clients);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        gatt_client_t * eatt_client = (gatt_client_t *) btstack_linked_list_iterator_next(&it);
+        if (eatt_client->state == P_READY){
+            return eatt_client;
+        }
+    }
+    return NULL;
+}
+#endif
+
 static bool gatt_cilent_is_ready_internal(gatt_client_t * gatt_client){
     if (gatt_client_internal_query_pending(gatt_client)){
         return false;
@@ -300,17 +329,7 @@ static uint8_t gatt_client_provide_context_for_request(hci_con_handle_t con_hand
 
 #ifdef ENABLE_GATT_OVER_EATT
     if ((gatt_client->eatt_state == GATT_CLIENT_EATT_READY) && gatt_client_eatt_enabled){
-        btstack_linked_list_iterator_t it;
-        gatt_client_t * eatt_client = NULL;
-        // find free eatt client
-        btstack_linked_list_iterator_init(&it, &gatt_client->eatt_clients);
-        while (btstack_linked_list_iterator_has_next(&it)){
-            gatt_client_t * client = (gatt_client_t *) btstack_linked_list_iterator_next(&it);
-            if (client->state == P_READY){
-                eatt_client = client;
-                break;
-            }
-        }
+        gatt_client_t * eatt_client = gatt_client_le_enhanced_get_ready_client(gatt_client);
         if (eatt_client == NULL){
             return ERROR_CODE_COMMAND_DISALLOWED;
         }
@@ -381,6 +400,11 @@ static uint8_t *gatt_client_reserve_request_buffer(gatt_client_t *gatt_client) {
 static uint8_t gatt_client_send(gatt_client_t * gatt_client, uint16_t len){
     switch (gatt_client->bearer_type){
         case ATT_BEARER_UNENHANCED_LE:
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+            if (gatt_client_discovery_cache_handle_request(gatt_client, len)){
+                return ERROR_CODE_SUCCESS;
+            }
+#endif
             return l2cap_send_prepared_connectionless(gatt_client->con_handle, L2CAP_CID_ATTRIBUTE_PROTOCOL, len);
 #ifdef ENABLE_GATT_OVER_CLASSIC
         case ATT_BEARER_UNENHANCED_CLASSIC:
@@ -823,6 +847,225 @@ static bool gatt_client_service_query_handle_can_send_query(gatt_client_t * gatt
 }
 #endif
 
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+static uint32_t gatt_client_discovery_cache_tag_for_index(uint8_t index){
+    return (((uint8_t)'G') << 24u) | (((uint8_t)'D') << 16u) | (((uint8_t)'C') << 8u) | index;
+}
+
+// discovery requests, their responses only change together with the Database Hash
+static bool gatt_client_discovery_cache_request_cacheable(const uint8_t * request, uint16_t request_len){
+    // longest discovery request is Read By Type with UUID128
+    if ((request_len < 1u) || (request_len > 21u)){
+        return false;
+    }
+    switch (request[0]){
+        case ATT_READ_BY_GROUP_TYPE_REQUEST:
+        case ATT_FIND_BY_TYPE_VALUE_REQUEST:
+        case ATT_FIND_INFORMATION_REQUEST:
+            return true;
+        case ATT_READ_BY_TYPE_REQUEST:
+            if (request_len != 7u){
+                return false;
+            }
+            switch (little_endian_read_16(request, 5)){
+                case GATT_CHARACTERISTICS_UUID:
+                case GATT_INCLUDE_SERVICE_UUID:
+                    return true;
+                default:
+                    return false;
+            }
+        default:
+            return false;
+    }
+}
+
+// @return offset of record or 0 if not found
+static uint16_t gatt_client_discovery_cache_find_record(const gatt_client_t * gatt_client, const uint8_t * request, uint16_t request_len){
+    const gatt_client_discovery_cache_t * cache = gatt_client->discovery_cache;
+    uint16_t offset = 16;
+    while ((offset + 3u) <= cache->size){
+        uint16_t record_request_len  = cache->data[offset];
+        uint16_t record_response_len = little_endian_read_16(cache->data, offset + 1u);
+        uint16_t record_len = 3u + record_request_len + record_response_len;
+        if ((offset + record_len) > cache->size){
+            break;
+        }
+        // skip responses that don't fit into current MTU, e.g. stored with larger MTU
+        if ((record_request_len == request_len) && (record_response_len <= gatt_client->mtu)
+        && (memcmp(&cache->data[offset + 3u], request, request_len) == 0)){
+            return offset;
+        }
+        offset += record_len;
+    }
+    return 0;
+}
+
+static void gatt_client_discovery_cache_deliver_responses(void * context){
+    UNUSED(context);
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &gatt_client_connections);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        gatt_client_t * gatt_client = (gatt_client_t *) btstack_linked_list_iterator_next(&it);
+        gatt_client_discovery_cache_t * cache = gatt_client->discovery_cache;
+        if ((cache == NULL) || (cache->response_pending == false)){
+            continue;
+        }
+        cache->response_pending = false;
+        uint16_t offset = cache->response_offset;
+        uint16_t request_len  = cache->data[offset];
+        uint16_t response_len = little_endian_read_16(cache->data, offset + 1u);
+        gatt_client_handle_att_response(gatt_client, &cache->data[offset + 3u + request_len], response_len);
+    }
+    gatt_client_run();
+}
+
+// @return true if response is served from cache
+static bool gatt_client_discovery_cache_handle_request(gatt_client_t * gatt_client, uint16_t request_len){
+    gatt_client_discovery_cache_t * cache = gatt_client->discovery_cache;
+    if (cache == NULL){
+        return false;
+    }
+    cache->request_len = 0;
+    if (cache->active == false){
+        return false;
+    }
+    const uint8_t * request = l2cap_get_outgoing_buffer();
+    if (gatt_client_discovery_cache_request_cacheable(request, request_len) == false){
+        return false;
+    }
+    uint16_t offset = gatt_client_discovery_cache_find_record(gatt_client, request, request_len);
+    if (offset == 0u){
+        // store response when received
+        (void) memcpy(cache->request, request, request_len);
+        cache->request_len = request_len;
+        return false;
+    }
+    log_info("Discovery Cache: serve request 0x%02x", request[0]);
+    l2cap_release_packet_buffer();
+    // deliver response on next run loop iteration
+    cache->response_offset = offset;
+    cache->response_pending = true;
+    gatt_client_discovery_cache_delivery.callback = &gatt_client_discovery_cache_deliver_responses;
+    btstack_run_loop_execute_on_main_thread(&gatt_client_discovery_cache_delivery);
+    return true;
+}
+
+static void gatt_client_discovery_cache_handle_response(gatt_client_t * gatt_client, const uint8_t * response, uint16_t response_len){
+    gatt_client_discovery_cache_t * cache = gatt_client->discovery_cache;
+    if (cache == NULL){
+        return;
+    }
+    uint16_t request_len = cache->request_len;
+    if (request_len == 0u){
+        return;
+    }
+    // ignore notifications and indications, only store 'attribute not found' errors
+    uint8_t request_opcode = cache->request[0];
+    if (response[0] == ATT_ERROR_RESPONSE){
+        if ((response_len != 5u) || (response[1] != request_opcode) || (response[4] != ATT_ERROR_ATTRIBUTE_NOT_FOUND)){
+            return;
+        }
+    } else if (response[0] != (request_opcode + 1u)){
+        return;
+    }
+    cache->request_len = 0;
+
+    uint16_t record_len = 3u + request_len + response_len;
+    if ((cache->size + record_len) > GATT_CLIENT_DISCOVERY_CACHE_SIZE){
+        log_info("Discovery Cache full, increase GATT_CLIENT_DISCOVERY_CACHE_SIZE");
+        return;
+    }
+    uint8_t * record = &cache->data[cache->size];
+    record[0] = (uint8_t) request_len;
+    little_endian_store_16(record, 1, response_len);
+    (void) memcpy(&record[3], cache->request, request_len);
+    (void) memcpy(&record[3u + request_len], response, response_len);
+    cache->size += record_len;
+    cache->dirty = true;
+}
+
+static void gatt_client_discovery_cache_activate(gatt_client_t * gatt_client, const uint8_t * database_hash){
+    // only the ATT bearer uses the cache, EATT bearers send discovery requests directly
+    if (gatt_client->bearer_type != ATT_BEARER_UNENHANCED_LE){
+        return;
+    }
+    if (gatt_client->discovery_cache == NULL){
+        gatt_client->discovery_cache = btstack_memory_gatt_client_discovery_cache_get();
+        if (gatt_client->discovery_cache == NULL){
+            log_info("Discovery Cache: no memory, increase MAX_NR_GATT_CLIENT_DISCOVERY_CACHES");
+            return;
+        }
+    }
+    gatt_client_discovery_cache_t * cache = gatt_client->discovery_cache;
+    cache->active = true;
+    cache->request_len = 0;
+
+    // keep cache if Database Hash didn't change, e.g. after Service Changed indication
+    if ((cache->size >= 16u) && (memcmp(cache->data, database_hash, 16) == 0)){
+        return;
+    }
+
+    // load cache of bonded device if Database Hash matches
+    int le_device_db_index = sm_le_device_index(gatt_client->con_handle);
+    if (le_device_db_index >= 0) {
+        const btstack_tlv_t * tlv_impl = NULL;
+        void * tlv_context;
+        btstack_tlv_get_instance(&tlv_impl, &tlv_context);
+        if (tlv_impl != NULL) {
+            uint32_t tag = gatt_client_discovery_cache_tag_for_index((uint8_t) le_device_db_index);
+            int len = tlv_impl->get_tag(tlv_context, tag, cache->data, sizeof(cache->data));
+            if ((len >= 16) && (len <= (int) sizeof(cache->data)) && (memcmp(cache->data, database_hash, 16) == 0)) {
+                log_info("Discovery Cache: loaded %u bytes", len);
+                cache->size = (uint16_t) len;
+                cache->dirty = false;
+                return;
+            }
+        }
+    }
+
+    // start with empty cache for current Database Hash
+    (void) memcpy(cache->data, database_hash, 16);
+    cache->size = 16;
+    cache->dirty = true;
+}
+
+static void gatt_client_discovery_cache_store(gatt_client_t * gatt_client){
+    gatt_client_discovery_cache_t * cache = gatt_client->discovery_cache;
+    if ((cache == NULL) || (cache->dirty == false)){
+        return;
+    }
+    int le_device_db_index = sm_le_device_index(gatt_client->con_handle);
+    if (le_device_db_index < 0){
+        return;
+    }
+    const btstack_tlv_t * tlv_impl = NULL;
+    void * tlv_context;
+    btstack_tlv_get_instance(&tlv_impl, &tlv_context);
+    if (tlv_impl != NULL) {
+        uint32_t tag = gatt_client_discovery_cache_tag_for_index((uint8_t) le_device_db_index);
+        (void) tlv_impl->store_tag(tlv_context, tag, cache->data, cache->size);
+        cache->dirty = false;
+    }
+}
+
+static void gatt_client_discovery_cache_free(gatt_client_t * gatt_client){
+    if (gatt_client->discovery_cache != NULL){
+        btstack_memory_gatt_client_discovery_cache_free(gatt_client->discovery_cache);
+        gatt_client->discovery_cache = NULL;
+    }
+}
+
+static void gatt_client_discovery_cache_delete(int le_device_db_index) {
+    const btstack_tlv_t * tlv_impl = NULL;
+    void * tlv_context;
+    btstack_tlv_get_instance(&tlv_impl, &tlv_context);
+    if (tlv_impl != NULL) {
+        uint32_t tag = gatt_client_discovery_cache_tag_for_index((uint8_t) le_device_db_index);
+        tlv_impl->delete_tag(tlv_context, tag);
+    }
+}
+#endif
+
 #ifdef ENABLE_GATT_CLIENT_CACHING
 typedef struct {
     uint8_t  database_hash[16];
@@ -903,6 +1146,9 @@ static void gatt_client_caching_handle_database_hash(gatt_client_t * gatt_client
             }
         }
     }
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+    gatt_client_discovery_cache_activate(gatt_client, database_hash);
+#endif
     gatt_client_caching_emit_database_hash(gatt_client, database_hash, database_version);
 }
 
@@ -1060,21 +1306,29 @@ static bool gatt_client_caching_handle_can_send_query(gatt_client_t * gatt_clien
 static void gatt_client_notify_can_send_query(gatt_client_t * gatt_client){
 
 #ifdef ENABLE_GATT_OVER_EATT
-    // if eatt is ready, notify all clients that can send a query
+    // queries are queued on the unenhanced client, serve them when an eatt channel becomes ready
+    if (gatt_client->bearer_type == ATT_BEARER_ENHANCED_LE){
+        gatt_client = gatt_client_get_context_for_handle(gatt_client->con_handle);
+        if (gatt_client == NULL){
+            return;
+        }
+    }
+
+    // if eatt is ready, dispatch queued queries to all idle channels
     if (gatt_client->eatt_state == GATT_CLIENT_EATT_READY){
-        btstack_linked_list_iterator_t it;
-        btstack_linked_list_iterator_init(&it, &gatt_client->eatt_clients);
-        while (btstack_linked_list_iterator_has_next(&it)){
-            gatt_client_t * client = (gatt_client_t *) btstack_linked_list_iterator_next(&it);
-            if (client->state == P_READY){
-                // call callback
-                btstack_context_callback_registration_t * callback = (btstack_context_callback_registration_t *) btstack_linked_list_pop(&gatt_client->query_requests);
-                if (callback == NULL) {
-                    return;
-                }
-                (*callback->callback)(callback->context);
-            }
+        // requests registered from a callback are served when the next channel becomes ready
+        if (gatt_client->eatt_dispatch_active){
+            return;
         }
+        gatt_client->eatt_dispatch_active = true;
+        // only serve requests queued on entry, a callback might re-register without sending a query
+        int num_requests = btstack_linked_list_count(&gatt_client->query_requests);
+        while ((num_requests > 0) && (gatt_client_le_enhanced_get_ready_client(gatt_client) != NULL)){
+            btstack_context_callback_registration_t * callback = (btstack_context_callback_registration_t *) btstack_linked_list_pop(&gatt_client->query_requests);
+            (*callback->callback)(callback->context);
+            num_requests--;
+        }
+        gatt_client->eatt_dispatch_active = false;
         return;
     }
 #endif
@@ -1449,6 +1703,12 @@ static void report_gatt_indication(gatt_client_t *gatt_client, uint16_t value_ha
         gatt_client_caching_emit_service_changed(gatt_client, value, length);
         log_info("GATT Service Changed, restart caching");
         gatt_client->caching_state = GATT_CLIENT_CACHING_DISCOVER_CHARACTERISTICS_W2_SEND;
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+        // don't serve discovery until Database Hash was read again
+        if (gatt_client->discovery_cache != NULL){
+            gatt_client->discovery_cache->active = false;
+        }
+#endif
         gatt_client_notify_can_send_query(gatt_client);
     }
 #endif
@@ -2088,6 +2348,10 @@ static void gatt_client_handle_disconnection_complete(const uint8_t * packet){
 
     gatt_client_report_error_if_pending(gatt_client, ATT_ERROR_HCI_DISCONNECT_RECEIVED);
     gatt_client_timeout_stop(gatt_client);
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+    gatt_client_discovery_cache_store(gatt_client);
+    gatt_client_discovery_cache_free(gatt_client);
+#endif
     btstack_linked_list_remove(&gatt_client_connections, (btstack_linked_item_t *) gatt_client);
     btstack_memory_gatt_client_free(gatt_client);
 }
@@ -2151,6 +2415,9 @@ static void gatt_client_event_packet_handler(uint8_t packet_type, uint16_t chann
             switch (hci_event_gap_meta_get_subevent_code(packet)) {
                 case GAP_SUBEVENT_BONDING_DELETED:
                     gatt_client_caching_delete_database_hash(gap_subevent_bonding_deleted_get_index(packet));
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+                    gatt_client_discovery_cache_delete(gap_subevent_bonding_deleted_get_index(packet));
+#endif
                     break;
                 default:
                     break;
@@ -2806,6 +3073,9 @@ static void gatt_client_att_packet_handler(uint8_t packet_type, uint16_t handle,
             }
 
             if (gatt_client != NULL) {
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+                gatt_client_discovery_cache_handle_response(gatt_client, packet, size);
+#endif
                 gatt_client_handle_att_response(gatt_client, packet, size);
                 gatt_client_run();
             }
@@ -3931,7 +4201,7 @@ static void gatt_client_le_enhanced_handle_connected(gatt_client_t * gatt_client
             gatt_client->eatt_state = GATT_CLIENT_EATT_READY;
             // free unused channels
             btstack_linked_list_iterator_t it;
-            btstack_linked_list_iterator_init(&it, &gatt_client_connections);
+            btstack_linked_list_iterator_init(&it, &gatt_client->eatt_clients);
             while (btstack_linked_list_iterator_has_next(&it)) {
                 gatt_client_t *eatt_client = (gatt_client_t *) btstack_linked_list_iterator_next(&it);
                 if (eatt_client->state == P_L2CAP_CLOSED){
@@ -3961,7 +4231,7 @@ static void gatt_client_le_enhanced_handle_connected(gatt_client_t * gatt_client
         gatt_client->eatt_state = GATT_CLIENT_EATT_IDLE;
     }
 
-    gatt_client_emit_connected(gatt_client->callback, status, gatt_client->addr_type, gatt_client->addr, gatt_client->con_handle);
+    gatt_client_emit_connected(gatt_client->eatt_callback, status, gatt_client->addr_type, gatt_client->addr, gatt_client->con_handle);
 }
 
 // single channel disconnected
@@ -3983,7 +4253,7 @@ static void gatt_client_le_enhanced_handle_ecbm_disconnected(gatt_client_t * gat
             // report disconnected if last channel closed
             uint8_t buffer[20];
             uint16_t len = hci_event_create_from_template_and_arguments(buffer, sizeof(buffer), &gatt_client_disconnected, gatt_client->con_handle);
-            (*gatt_client->callback)(HCI_EVENT_PACKET, 0, buffer, len);
+            (*gatt_client->eatt_callback)(HCI_EVENT_PACKET, 0, buffer, len);
         }
     }
 }
@@ -4126,10 +4396,10 @@ static void gatt_client_le_enhanced_packet_handler(uint8_t packet_type, uint16_t
                     btstack_assert(eatt_client != NULL);
                     btstack_assert(eatt_client->state == P_W4_L2CAP_CONNECTION);
 
-                    status = l2cap_event_channel_opened_get_status(packet);
+                    status = l2cap_event_ecbm_channel_opened_get_status(packet);
                     if (status == ERROR_CODE_SUCCESS){
                         eatt_client->state = P_READY;
-                        eatt_client->mtu = l2cap_event_channel_opened_get_remote_mtu(packet);
+                        eatt_client->mtu = l2cap_event_ecbm_channel_opened_get_remote_mtu(packet);
                     } else {
                         eatt_client->state = P_L2CAP_CLOSED;
                     }
@@ -4258,7 +4528,8 @@ uint8_t gatt_client_le_enhanced_connect(btstack_packet_handler_t callback, hci_c
     hci_connection_t * hci_connection = hci_connection_for_handle(con_handle);
     hci_connection->att_server.eatt_outgoing_active = true;
 
-    gatt_client->callback = callback;
+    // gatt_client->callback is used by the EATT setup queries
+    gatt_client->eatt_callback = callback;
     gatt_client->eatt_num_clients   = num_channels;
     gatt_client->eatt_storage_buffer = storage_buffer;
     gatt_client->eatt_storage_size   = storage_size;
@@ -56,6 +56,11 @@ extern "C" {
 #define ENABLE_GATT_FIND_INFORMATION_FOR_CCC_DISCOVERY
 #endif
 
+// Default size of GATT Discovery Cache per connection, including the 16 byte Database Hash
+#if defined(ENABLE_GATT_CLIENT_DISCOVERY_CACHE) && !defined(GATT_CLIENT_DISCOVERY_CACHE_SIZE)
+#define GATT_CLIENT_DISCOVERY_CACHE_SIZE 512
+#endif
+
 // We need to query remote GATT Service for Caching or EATT support
 #if defined(ENABLE_GATT_CLIENT_CACHING) || defined (ENABLE_GATT_OVER_EATT)
 #define ENABLE_GATT_CLIENT_SERVICE_QUERY
@@ -194,6 +199,20 @@ typedef enum {
 } gatt_client_eatt_state_t;
 #endif
 
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+// GATT Discovery Cache: Database Hash followed by (request len, response len, request, response) records
+typedef struct {
+    bool     active;
+    bool     dirty;
+    bool     response_pending;
+    uint16_t response_offset;
+    uint16_t request_len;
+    uint8_t  request[21];
+    uint16_t size;
+    uint8_t  data[GATT_CLIENT_DISCOVERY_CACHE_SIZE];
+} gatt_client_discovery_cache_t;
+#endif
+
 typedef struct gatt_client{
     btstack_linked_item_t    item;
 
@@ -228,6 +247,8 @@ typedef struct gatt_client{
 
 #ifdef ENABLE_GATT_OVER_EATT
     gatt_client_eatt_state_t eatt_state;
+    btstack_packet_handler_t eatt_callback;
+    bool eatt_dispatch_active;
     btstack_linked_list_t eatt_clients;
     uint8_t * eatt_storage_buffer;
     uint16_t eatt_storage_size;
@@ -307,6 +328,11 @@ typedef struct gatt_client{
     bool                        database_hash_valid;
     uint16_t                    cache_id;
 #endif
+
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+    // GATT Discovery Cache, only used by ATT bearer on LE
+    gatt_client_discovery_cache_t * discovery_cache;
+#endif
 } gatt_client_t;
 
 // Single characteristic, with wildcards for con_handle and attribute_handle
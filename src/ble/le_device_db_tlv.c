@@ -45,6 +45,11 @@
 #include <string.h>
 #include "btstack_debug.h"
 
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+#include "btstack_event.h"
+#include "hci.h"
+#endif
+
 // LE Device DB Implementation storing entries in btstack_tlv
 
 // Local cache is used to keep track of deleted entries in TLV
@@ -97,6 +102,21 @@ typedef struct le_device_db_entry_t {
 static uint8_t  entry_map[NVM_NUM_DEVICE_DB_ENTRIES];
 static uint32_t num_valid_entries;
 
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+
+// number of counter updates that are collected before the entry is written to TLV
+#ifndef LE_DEVICE_DB_TLV_CACHE_COUNTER_WRITE_BACK
+#define LE_DEVICE_DB_TLV_CACHE_COUNTER_WRITE_BACK 16
+#endif
+
+// copy of all valid entries, read once in le_device_db_tlv_scan
+static le_device_db_entry_t le_device_db_tlv_cache[NVM_NUM_DEVICE_DB_ENTRIES];
+// number of counter updates not written to TLV yet
+static uint16_t le_device_db_tlv_cache_dirty[NVM_NUM_DEVICE_DB_ENTRIES];
+
+static btstack_packet_callback_registration_t le_device_db_tlv_hci_event_callback_registration;
+#endif
+
 static const btstack_tlv_t * le_device_db_tlv_btstack_tlv_impl;
 static       void *          le_device_db_tlv_btstack_tlv_context;
 
@@ -111,7 +131,7 @@ static uint32_t le_device_db_tlv_tag_for_index(uint8_t index){
 
 // @return success
 // @param index = entry_pos
-static bool le_device_db_tlv_fetch(int index, le_device_db_entry_t * entry){
+static bool le_device_db_tlv_read(int index, le_device_db_entry_t * entry){
     btstack_assert(le_device_db_tlv_btstack_tlv_impl != NULL);
     btstack_assert(index >= 0);
     btstack_assert(index < NVM_NUM_DEVICE_DB_ENTRIES);
@@ -121,6 +141,21 @@ static bool le_device_db_tlv_fetch(int index, le_device_db_entry_t * entry){
 	return size == sizeof(le_device_db_entry_t);
 }
 
+// @return success
+// @param index = entry_pos
+static bool le_device_db_tlv_fetch(int index, le_device_db_entry_t * entry){
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+    btstack_assert(index >= 0);
+    btstack_assert(index < NVM_NUM_DEVICE_DB_ENTRIES);
+
+    if (entry_map[index] == 0u) return false;
+    (void)memcpy(entry, &le_device_db_tlv_cache[index], sizeof(le_device_db_entry_t));
+    return true;
+#else
+    return le_device_db_tlv_read(index, entry);
+#endif
+}
+
 // @return success
 // @param index = entry_pos
 static bool le_device_db_tlv_store(int index, le_device_db_entry_t * entry){
@@ -130,9 +165,30 @@ static bool le_device_db_tlv_store(int index, le_device_db_entry_t * entry){
 
     uint32_t tag = le_device_db_tlv_tag_for_index(index);
     int result = le_device_db_tlv_btstack_tlv_impl->store_tag(le_device_db_tlv_btstack_tlv_context, tag, (uint8_t*) entry, sizeof(le_device_db_entry_t));
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+    if (result == 0){
+        if (entry != &le_device_db_tlv_cache[index]){
+            (void)memcpy(&le_device_db_tlv_cache[index], entry, sizeof(le_device_db_entry_t));
+        }
+        le_device_db_tlv_cache_dirty[index] = 0;
+    }
+#endif
     return result == 0;
 }
 
+#ifdef ENABLE_LE_SIGNED_WRITE
+// @param index = entry_pos
+static void le_device_db_tlv_store_counter(int index, le_device_db_entry_t * entry){
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+    // update cache and write back after LE_DEVICE_DB_TLV_CACHE_COUNTER_WRITE_BACK updates or on le_device_db_tlv_flush
+    (void)memcpy(&le_device_db_tlv_cache[index], entry, sizeof(le_device_db_entry_t));
+    le_device_db_tlv_cache_dirty[index]++;
+    if (le_device_db_tlv_cache_dirty[index] < LE_DEVICE_DB_TLV_CACHE_COUNTER_WRITE_BACK) return;
+#endif
+    le_device_db_tlv_store(index, entry);
+}
+#endif
+
 // @param index = entry_pos
 static bool le_device_db_tlv_delete(int index){
     btstack_assert(le_device_db_tlv_btstack_tlv_impl != NULL);
@@ -141,6 +197,9 @@ static bool le_device_db_tlv_delete(int index){
 
     uint32_t tag = le_device_db_tlv_tag_for_index(index);
     le_device_db_tlv_btstack_tlv_impl->delete_tag(le_device_db_tlv_btstack_tlv_context, tag);
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+    le_device_db_tlv_cache_dirty[index] = 0;
+#endif
 	return true;
 }
 
@@ -148,10 +207,17 @@ static void le_device_db_tlv_scan(void){
     int i;
     num_valid_entries = 0;
     memset(entry_map, 0, sizeof(entry_map));
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+    memset(le_device_db_tlv_cache_dirty, 0, sizeof(le_device_db_tlv_cache_dirty));
+#endif
     for (i=0;i<NVM_NUM_DEVICE_DB_ENTRIES;i++){
         // lookup entry
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+        if (!le_device_db_tlv_read(i, &le_device_db_tlv_cache[i])) continue;
+#else
         le_device_db_entry_t entry;
-        if (!le_device_db_tlv_fetch(i, &entry)) continue;
+        if (!le_device_db_tlv_read(i, &entry)) continue;
+#endif
 
         entry_map[i] = 1;
         num_valid_entries++;
@@ -426,7 +492,7 @@ void le_device_db_remote_counter_set(int index, uint32_t counter){
     entry.remote_counter = counter;
 
     // store
-    le_device_db_tlv_store(index, &entry);
+    le_device_db_tlv_store_counter(index, &entry);
 }
 
 // query last used/seen signing counter
@@ -452,7 +518,7 @@ void le_device_db_local_counter_set(int index, uint32_t counter){
     entry.local_counter = counter;
 
     // store
-    le_device_db_tlv_store(index, &entry);
+    le_device_db_tlv_store_counter(index, &entry);
 }
 
 #endif
@@ -476,7 +542,36 @@ void le_device_db_dump(void){
     }
 }
 
+void le_device_db_tlv_flush(void){
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+    int i;
+    for (i=0;i<NVM_NUM_DEVICE_DB_ENTRIES;i++){
+        if (entry_map[i] == 0u) continue;
+        if (le_device_db_tlv_cache_dirty[i] == 0u) continue;
+        log_info("write back entry %u", (unsigned int) i);
+        le_device_db_tlv_store(i, &le_device_db_tlv_cache[i]);
+    }
+#endif
+}
+
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+static void le_device_db_tlv_hci_event_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (hci_event_packet_get_type(packet) != HCI_EVENT_DISCONNECTION_COMPLETE) return;
+    // write back signing counters of all entries
+    le_device_db_tlv_flush();
+}
+#endif
+
 void le_device_db_tlv_configure(const btstack_tlv_t * btstack_tlv_impl, void * btstack_tlv_context){
+#ifdef ENABLE_LE_DEVICE_DB_TLV_CACHE
+    if (le_device_db_tlv_hci_event_callback_registration.callback == NULL){
+        le_device_db_tlv_hci_event_callback_registration.callback = &le_device_db_tlv_hci_event_handler;
+        hci_add_event_handler(&le_device_db_tlv_hci_event_callback_registration);
+    }
+#endif
 	le_device_db_tlv_btstack_tlv_impl = btstack_tlv_impl;
 	le_device_db_tlv_btstack_tlv_context = btstack_tlv_context;
     le_device_db_tlv_scan();
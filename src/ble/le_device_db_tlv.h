@@ -61,6 +61,12 @@ extern "C" {
 
 void le_device_db_tlv_configure(const btstack_tlv_t * btstack_tlv_impl, void * btstack_tlv_context);
 
+/**
+ * @brief write pending signing counter updates to btstack tlv, e.g. before power down
+ * @note only used with ENABLE_LE_DEVICE_DB_TLV_CACHE, also called on HCI Disconnection Complete
+ */
+void le_device_db_tlv_flush(void);
+
 /* API_END */
 
 #if defined __cplusplus
@@ -96,6 +96,17 @@
 #define USE_CMAC_ENGINE
 #endif
 
+// with AES128 in software, AES128 and CMAC are calculated directly, e.g. ah() for all IRKs in a single pass
+#if defined(ENABLE_SOFTWARE_AES128) || defined(HAVE_AES128)
+#define USE_BTSTACK_AES128
+#endif
+
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+#ifndef SM_ADDRESS_RESOLUTION_CACHE_SIZE
+#define SM_ADDRESS_RESOLUTION_CACHE_SIZE 8
+#endif
+#endif
+
 
 #define BTSTACK_TAG32(A,B,C,D) (((A) << 24) | ((B) << 16) | ((C) << 8) | (D))
 
@@ -243,7 +254,9 @@ static bd_addr_t sm_random_address;
 
 #ifdef USE_CMAC_ENGINE
 // CMAC Calculation: General
+#ifndef USE_BTSTACK_AES128
 static btstack_crypto_aes128_cmac_t sm_cmac_request;
+#endif
 static void (*sm_cmac_done_callback)(uint8_t hash[8]);
 static uint8_t sm_cmac_active;
 static uint8_t sm_cmac_hash[16];
@@ -270,6 +283,20 @@ static bd_addr_t sm_address_resolution_address;
 static void *    sm_address_resolution_context;
 static address_resolution_mode_t sm_address_resolution_mode;
 static btstack_linked_list_t sm_address_resolution_general_queue;
+static uint32_t  sm_address_resolution_request_time_ms;
+static sm_address_resolution_stats_t sm_address_resolution_stats;
+
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+// recently resolved private addresses, most recently used first
+typedef struct {
+    bd_addr_t address;
+    sm_key_t  irk;
+    int       le_device_db_index;
+} sm_address_resolution_cache_entry_t;
+
+static sm_address_resolution_cache_entry_t sm_address_resolution_cache[SM_ADDRESS_RESOLUTION_CACHE_SIZE];
+static uint8_t sm_address_resolution_cache_num_entries;
+#endif
 
 // aes128 crypto engine.
 static sm_aes128_state_t  sm_aes128_state;
@@ -283,7 +310,9 @@ static btstack_crypto_ecc_p256_t sm_crypto_ecc_p256_request;
 
 // temp storage for random data
 static uint8_t sm_random_data[8];
+#ifndef USE_BTSTACK_AES128
 static uint8_t sm_aes128_key[16];
+#endif
 static uint8_t sm_aes128_plaintext[16];
 static uint8_t sm_aes128_ciphertext[16];
 
@@ -418,7 +447,9 @@ static bool sm_ctkd_from_le_could_update(const sm_connection_t * sm_connection);
 #endif
 static inline int sm_calc_actual_encryption_key_size(int other);
 static int sm_validate_stk_generation_method(void);
+#ifndef USE_BTSTACK_AES128
 static void sm_handle_encryption_result_address_resolution(void *arg);
+#endif
 static void sm_handle_encryption_result_dkg_dhk(void *arg);
 static void sm_handle_encryption_result_dkg_irk(void *arg);
 static void sm_handle_encryption_result_enc_a(void *arg);
@@ -969,15 +1000,70 @@ static bool sm_address_resolution_idle(void){
     return sm_address_resolution_mode == ADDRESS_RESOLUTION_IDLE;
 }
 
-static void sm_address_resolution_start_lookup(uint8_t addr_type, hci_con_handle_t con_handle, bd_addr_t addr, address_resolution_mode_t mode, void * context){
+static void sm_address_resolution_start_lookup(uint8_t addr_type, hci_con_handle_t con_handle, bd_addr_t addr, address_resolution_mode_t mode, void * context, uint32_t request_time_ms){
     (void)memcpy(sm_address_resolution_address, addr, 6);
     sm_address_resolution_addr_type = addr_type;
     sm_address_resolution_test = 0;
     sm_address_resolution_mode = mode;
     sm_address_resolution_context = context;
+    sm_address_resolution_request_time_ms = request_time_ms;
+    sm_address_resolution_stats.num_lookups++;
     sm_notify_client_base(SM_EVENT_IDENTITY_RESOLVING_STARTED, con_handle, addr_type, addr);
 }
 
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+static void sm_address_resolution_cache_remove(uint8_t pos){
+    sm_address_resolution_cache_num_entries--;
+    (void)memmove(&sm_address_resolution_cache[pos], &sm_address_resolution_cache[pos + 1u],
+                  (sm_address_resolution_cache_num_entries - pos) * sizeof(sm_address_resolution_cache_entry_t));
+}
+
+static void sm_address_resolution_cache_add(const bd_addr_t address, const sm_key_t irk, int le_device_db_index){
+    sm_address_resolution_cache_entry_t entry;
+    (void)memcpy(entry.address, address, 6);
+    (void)memcpy(entry.irk, irk, 16);
+    entry.le_device_db_index = le_device_db_index;
+    // drop least recently used entry if full
+    if (sm_address_resolution_cache_num_entries == SM_ADDRESS_RESOLUTION_CACHE_SIZE){
+        sm_address_resolution_cache_num_entries--;
+    }
+    (void)memmove(&sm_address_resolution_cache[1], &sm_address_resolution_cache[0],
+                  sm_address_resolution_cache_num_entries * sizeof(sm_address_resolution_cache_entry_t));
+    sm_address_resolution_cache[0] = entry;
+    sm_address_resolution_cache_num_entries++;
+}
+
+// @return le device db index or -1 if not found
+static int sm_address_resolution_cache_lookup(const bd_addr_t address){
+    uint8_t pos;
+    for (pos = 0; pos < sm_address_resolution_cache_num_entries; pos++){
+        if (memcmp(sm_address_resolution_cache[pos].address, address, 6) != 0) continue;
+        sm_address_resolution_cache_entry_t entry = sm_address_resolution_cache[pos];
+        sm_address_resolution_cache_remove(pos);
+        // drop entry if le device db entry was removed or replaced
+        int addr_type = BD_ADDR_TYPE_UNKNOWN;
+        bd_addr_t addr;
+        sm_key_t irk;
+        le_device_db_info(entry.le_device_db_index, &addr_type, addr, irk);
+        if ((addr_type == BD_ADDR_TYPE_UNKNOWN) || (memcmp(irk, entry.irk, 16) != 0)){
+            return -1;
+        }
+        // move to front
+        sm_address_resolution_cache_add(entry.address, entry.irk, entry.le_device_db_index);
+        return entry.le_device_db_index;
+    }
+    return -1;
+}
+#endif
+
+void sm_address_resolution_get_stats(sm_address_resolution_stats_t * stats){
+    *stats = sm_address_resolution_stats;
+}
+
+void sm_address_resolution_reset_stats(void){
+    memset(&sm_address_resolution_stats, 0, sizeof(sm_address_resolution_stats_t));
+}
+
 int sm_address_resolution_lookup(uint8_t address_type, bd_addr_t address){
     // check if already in list
     btstack_linked_list_iterator_t it;
@@ -994,6 +1080,7 @@ int sm_address_resolution_lookup(uint8_t address_type, bd_addr_t address){
     if (!entry) return BTSTACK_MEMORY_ALLOC_FAILED;
     entry->address_type = (bd_addr_type_t) address_type;
     (void)memcpy(entry->address, address, 6);
+    entry->request_time_ms = btstack_run_loop_get_time_ms();
     btstack_linked_list_add(&sm_address_resolution_general_queue, (btstack_linked_item_t *) entry);
     sm_trigger_run();
     return 0;
@@ -1019,7 +1106,12 @@ int sm_cmac_ready(void){
 static void sm_cmac_message_start(const sm_key_t key, uint16_t message_len, const uint8_t * message, void (*done_callback)(uint8_t * hash)){
     sm_cmac_active = 1;
     sm_cmac_done_callback = done_callback;
+#ifdef USE_BTSTACK_AES128
+    btstack_crypto_aes128_cmac_message_sync(key, message_len, message, sm_cmac_hash);
+    sm_cmac_done_trampoline(NULL);
+#else
     btstack_crypto_aes128_cmac_message(&sm_cmac_request, key, message_len, message, sm_cmac_hash, sm_cmac_done_trampoline, NULL);
+#endif
 }
 #endif
 
@@ -1029,7 +1121,12 @@ static void sm_cmac_message_start(const sm_key_t key, uint16_t message_len, cons
 static void sm_cmac_generator_start(const sm_key_t key, uint16_t message_len, uint8_t (*get_byte_callback)(uint16_t offset), void (*done_callback)(uint8_t * hash)){
     sm_cmac_active = 1;
     sm_cmac_done_callback = done_callback;
+#ifdef USE_BTSTACK_AES128
+    btstack_crypto_aes128_cmac_generator_sync(key, message_len, get_byte_callback, sm_cmac_hash);
+    sm_cmac_done_trampoline(NULL);
+#else
     btstack_crypto_aes128_cmac_generator(&sm_cmac_request, key, message_len, get_byte_callback, sm_cmac_hash, sm_cmac_done_trampoline, NULL);
+#endif
 }
 
 static uint8_t sm_cmac_signed_write_message_get_byte(uint16_t offset){
@@ -1322,6 +1419,16 @@ static void sm_address_resolution_handle_event(address_resolution_event_t event)
     sm_address_resolution_context = NULL;
     sm_address_resolution_test = -1;
 
+    // update stats
+    uint32_t latency_ms = btstack_run_loop_get_time_ms() - sm_address_resolution_request_time_ms;
+    sm_address_resolution_stats.latency_total_ms += latency_ms;
+    sm_address_resolution_stats.latency_max_ms = btstack_max(sm_address_resolution_stats.latency_max_ms, latency_ms);
+    if (event == ADDRESS_RESOLUTION_SUCCEEDED){
+        sm_address_resolution_stats.num_resolved++;
+    } else {
+        sm_address_resolution_stats.num_failed++;
+    }
+
     hci_con_handle_t con_handle = HCI_CON_HANDLE_INVALID;
     sm_connection_t * sm_connection;
     sm_key_t ltk;
@@ -2295,7 +2402,8 @@ static bool sm_run_irk_lookup(void){
             sm_connection_t  * sm_connection  = &hci_connection->sm_connection;
             if (sm_connection->sm_irk_lookup_state == IRK_LOOKUP_W4_READY){
                 // and start lookup
-                sm_address_resolution_start_lookup(sm_connection->sm_peer_addr_type, sm_connection->sm_handle, sm_connection->sm_peer_address, ADDRESS_RESOLUTION_FOR_CONNECTION, sm_connection);
+                sm_address_resolution_start_lookup(sm_connection->sm_peer_addr_type, sm_connection->sm_handle, sm_connection->sm_peer_address,
+                                                   ADDRESS_RESOLUTION_FOR_CONNECTION, sm_connection, btstack_run_loop_get_time_ms());
                 sm_connection->sm_irk_lookup_state = IRK_LOOKUP_STARTED;
                 break;
             }
@@ -2307,13 +2415,28 @@ static bool sm_run_irk_lookup(void){
         if (!btstack_linked_list_empty(&sm_address_resolution_general_queue)){
             sm_lookup_entry_t * entry = (sm_lookup_entry_t *) sm_address_resolution_general_queue;
             btstack_linked_list_remove(&sm_address_resolution_general_queue, (btstack_linked_item_t *) entry);
-            sm_address_resolution_start_lookup(entry->address_type, 0, entry->address, ADDRESS_RESOLUTION_GENERAL, NULL);
+            sm_address_resolution_start_lookup(entry->address_type, 0, entry->address, ADDRESS_RESOLUTION_GENERAL, NULL, entry->request_time_ms);
             btstack_memory_sm_lookup_entry_free(entry);
         }
     }
 
     // -- Continue with device lookup by public or resolvable private address
     if (!sm_address_resolution_idle()){
+
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+        // check recently resolved private addresses first
+        if ((sm_address_resolution_test == 0) && (sm_address_resolution_addr_type == BD_ADDR_TYPE_LE_RANDOM)){
+            int cached_index = sm_address_resolution_cache_lookup(sm_address_resolution_address);
+            if (cached_index >= 0){
+                log_info("LE Device Lookup: found in cache");
+                sm_address_resolution_stats.num_cache_hits++;
+                sm_address_resolution_test = cached_index;
+                sm_address_resolution_handle_event(ADDRESS_RESOLUTION_SUCCEEDED);
+                return false;
+            }
+        }
+#endif
+
         bool started_aes128 = false;
         while (sm_address_resolution_test < le_device_db_max_count()){
             int addr_type = BD_ADDR_TYPE_UNKNOWN;
@@ -2350,9 +2473,27 @@ static bool sm_run_irk_lookup(void){
                 continue;
             }
 
+#ifdef USE_BTSTACK_AES128
+            // calculate AH directly and continue with next entry
+            sm_address_resolution_stats.num_ah_calculations++;
+            uint8_t r_prime[16];
+            uint8_t hash[16];
+            sm_ah_r_prime(sm_address_resolution_address, r_prime);
+            btstack_aes128_calc(irk, r_prime, hash);
+            if (memcmp(&sm_address_resolution_address[3], &hash[13], 3) == 0){
+                log_info("LE Device Lookup: matched resolvable private address");
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+                sm_address_resolution_cache_add(sm_address_resolution_address, irk, sm_address_resolution_test);
+#endif
+                sm_address_resolution_handle_event(ADDRESS_RESOLUTION_SUCCEEDED);
+                break;
+            }
+            sm_address_resolution_test++;
+#else
             if (sm_aes128_state == SM_AES128_ACTIVE) break;
 
             log_info("LE Device Lookup: calculate AH");
+            sm_address_resolution_stats.num_ah_calculations++;
             log_info_key("IRK", irk);
 
             (void)memcpy(sm_aes128_key, irk, 16);
@@ -2361,6 +2502,7 @@ static bool sm_run_irk_lookup(void){
             btstack_crypto_aes128_encrypt(&sm_crypto_aes128_request, sm_aes128_key, sm_aes128_plaintext, sm_aes128_ciphertext, sm_handle_encryption_result_address_resolution, NULL);
             started_aes128 = true;
             break;
+#endif
         }
 
         if (started_aes128){
@@ -3608,6 +3750,7 @@ static void sm_handle_encryption_result_enc_ph4_ltk(void *arg){
 }
 #endif
 
+#ifndef USE_BTSTACK_AES128
 static void sm_handle_encryption_result_address_resolution(void *arg){
     UNUSED(arg);
     sm_aes128_state = SM_AES128_IDLE;
@@ -3616,6 +3759,9 @@ static void sm_handle_encryption_result_address_resolution(void *arg){
     uint8_t * hash = &sm_aes128_ciphertext[13];
     if (memcmp(&sm_address_resolution_address[3], hash, 3) == 0){
         log_info("LE Device Lookup: matched resolvable private address");
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+        sm_address_resolution_cache_add(sm_address_resolution_address, sm_aes128_key, sm_address_resolution_test);
+#endif
         sm_address_resolution_handle_event(ADDRESS_RESOLUTION_SUCCEEDED);
         sm_trigger_run();
         return;
@@ -3624,6 +3770,7 @@ static void sm_handle_encryption_result_address_resolution(void *arg){
     sm_address_resolution_test++;
     sm_trigger_run();
 }
+#endif
 
 static void sm_handle_encryption_result_dkg_irk(void *arg){
     UNUSED(arg);
@@ -5203,6 +5350,9 @@ static void sm_state_reset(void) {
     sm_address_resolution_test = -1;    // no private address to resolve yet
     sm_address_resolution_mode = ADDRESS_RESOLUTION_IDLE;
     sm_address_resolution_general_queue = NULL;
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+    sm_address_resolution_cache_num_entries = 0;
+#endif
     sm_active_connection_handle = HCI_CON_HANDLE_INVALID;
     sm_persistent_keys_random_active = false;
 #ifdef ENABLE_LE_SECURE_CONNECTIONS
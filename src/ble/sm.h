@@ -58,8 +58,19 @@ typedef struct {
     btstack_linked_item_t  item;
     bd_addr_t      address;
     bd_addr_type_t address_type;
+    uint32_t       request_time_ms;
 } sm_lookup_entry_t;
 
+typedef struct {
+    uint32_t num_lookups;
+    uint32_t num_resolved;
+    uint32_t num_failed;
+    uint32_t num_cache_hits;
+    uint32_t num_ah_calculations;
+    uint32_t latency_total_ms;
+    uint32_t latency_max_ms;
+} sm_address_resolution_stats_t;
+
 /* API_START */
 
 /**
@@ -222,6 +233,18 @@ void sm_cmac_signed_write_start(const sm_key_t key, uint8_t opcode, uint16_t att
  */
 int sm_address_resolution_lookup(uint8_t address_type, bd_addr_t address);
 
+/**
+ * @brief Get address resolution statistics
+ * @param stats
+ * @note latency is measured from the lookup request (or connection) until SM_IDENTITY_RESOLVING_SUCCEEDED/FAILED
+ */
+void sm_address_resolution_get_stats(sm_address_resolution_stats_t * stats);
+
+/**
+ * @brief Reset address resolution statistics
+ */
+void sm_address_resolution_reset_stats(void);
+
 /**
  * @brief Get Identity Resolving state
  * @param con_handle
@@ -61,6 +61,23 @@
 #ifdef ENABLE_SOFTWARE_AES128
 #define HAVE_AES128
 #include "rijndael.h"
+
+// AES instructions are used if supported by compiler and detected at runtime, with rijndael as fallback
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define USE_AES128_X86_AESNI
+#include <wmmintrin.h>
+#endif
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define USE_AES128_ARMV8_CRYPTO
+#include <arm_neon.h>
+#ifdef __linux__
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+#if defined(USE_AES128_X86_AESNI) || defined(USE_AES128_ARMV8_CRYPTO)
+#define USE_AES128_INSTRUCTIONS
+#endif
 #endif
 
 #ifdef HAVE_AES128
@@ -218,11 +235,168 @@ static int btstack_crypto_mbedtls_write_x_coordinate(const mbedtls_ecp_point * p
 #endif /* ENABLE_ECC_P256 */
 
 #ifdef ENABLE_SOFTWARE_AES128
-// AES128 using public domain rijndael implementation
-void btstack_aes128_calc(const uint8_t * key, const uint8_t * plaintext, uint8_t * ciphertext){
+
+// key schedule of last key is kept as CMAC, CCM and address resolution use the same key for consecutive blocks
+static bool     btstack_aes128_key_valid;
+static uint8_t  btstack_aes128_key[16];
+static uint32_t btstack_aes128_rk[RKLENGTH(KEYBITS)];
+static int      btstack_aes128_nrounds;
+
+#ifdef USE_AES128_INSTRUCTIONS
+typedef enum {
+    BTSTACK_AES128_INSTRUCTIONS_UNKNOWN = 0,
+    BTSTACK_AES128_INSTRUCTIONS_AVAILABLE,
+    BTSTACK_AES128_INSTRUCTIONS_NOT_AVAILABLE,
+} btstack_aes128_instructions_t;
+
+static btstack_aes128_instructions_t btstack_aes128_instructions;
+static bool btstack_aes128_instructions_disabled;
+#endif
+
+#ifdef USE_AES128_X86_AESNI
+static __m128i btstack_aes128_aesni_rk[11];
+
+static bool btstack_aes128_instructions_supported(void){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") != 0;
+}
+
+__attribute__((target("aes,sse2")))
+static __m128i btstack_aes128_aesni_expand(__m128i key, __m128i keygened){
+    keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3,3,3,3));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, keygened);
+}
+
+// round constant has to be an immediate value
+#define BTSTACK_AES128_AESNI_EXPAND(round, rcon) \
+    btstack_aes128_aesni_rk[round] = btstack_aes128_aesni_expand(btstack_aes128_aesni_rk[round-1], \
+                                         _mm_aeskeygenassist_si128(btstack_aes128_aesni_rk[round-1], rcon))
+
+__attribute__((target("aes,sse2")))
+static void btstack_aes128_instructions_setup(const uint8_t * key){
+    btstack_aes128_aesni_rk[0] = _mm_loadu_si128((const __m128i *) key);
+    BTSTACK_AES128_AESNI_EXPAND( 1, 0x01);
+    BTSTACK_AES128_AESNI_EXPAND( 2, 0x02);
+    BTSTACK_AES128_AESNI_EXPAND( 3, 0x04);
+    BTSTACK_AES128_AESNI_EXPAND( 4, 0x08);
+    BTSTACK_AES128_AESNI_EXPAND( 5, 0x10);
+    BTSTACK_AES128_AESNI_EXPAND( 6, 0x20);
+    BTSTACK_AES128_AESNI_EXPAND( 7, 0x40);
+    BTSTACK_AES128_AESNI_EXPAND( 8, 0x80);
+    BTSTACK_AES128_AESNI_EXPAND( 9, 0x1b);
+    BTSTACK_AES128_AESNI_EXPAND(10, 0x36);
+}
+
+__attribute__((target("aes,sse2")))
+static void btstack_aes128_instructions_encrypt(const uint8_t * plaintext, uint8_t * ciphertext){
+    __m128i state = _mm_loadu_si128((const __m128i *) plaintext);
+    state = _mm_xor_si128(state, btstack_aes128_aesni_rk[0]);
+    int round;
+    for (round = 1; round < 10; round++){
+        state = _mm_aesenc_si128(state, btstack_aes128_aesni_rk[round]);
+    }
+    state = _mm_aesenclast_si128(state, btstack_aes128_aesni_rk[10]);
+    _mm_storeu_si128((__m128i *) ciphertext, state);
+}
+#endif
+
+#ifdef USE_AES128_ARMV8_CRYPTO
+static uint8x16_t btstack_aes128_armv8_rk[11];
+
+static bool btstack_aes128_instructions_supported(void){
+#ifdef __linux__
+    return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#else
+    // compiler targets CPU with crypto extension
+    return true;
+#endif
+}
+
+static void btstack_aes128_instructions_setup(const uint8_t * key){
+    // no key expansion instructions, convert rijndael key schedule into byte order
     uint32_t rk[RKLENGTH(KEYBITS)];
-    int nrounds = rijndaelSetupEncrypt(rk, &key[0], KEYBITS);
-    rijndaelEncrypt(rk, nrounds, plaintext, ciphertext);
+    (void) rijndaelSetupEncrypt(rk, key, KEYBITS);
+    uint8_t round_key[16];
+    int round;
+    for (round = 0; round < 11; round++){
+        int i;
+        for (i = 0; i < 4; i++){
+            big_endian_store_32(round_key, i * 4, rk[round * 4 + i]);
+        }
+        btstack_aes128_armv8_rk[round] = vld1q_u8(round_key);
+    }
+}
+
+static void btstack_aes128_instructions_encrypt(const uint8_t * plaintext, uint8_t * ciphertext){
+    uint8x16_t state = vld1q_u8(plaintext);
+    int round;
+    for (round = 0; round < 9; round++){
+        state = vaesmcq_u8(vaeseq_u8(state, btstack_aes128_armv8_rk[round]));
+    }
+    state = vaeseq_u8(state, btstack_aes128_armv8_rk[9]);
+    state = veorq_u8(state, btstack_aes128_armv8_rk[10]);
+    vst1q_u8(ciphertext, state);
+}
+#endif
+
+#ifdef USE_AES128_INSTRUCTIONS
+static bool btstack_aes128_use_instructions(void){
+    if (btstack_aes128_instructions_disabled){
+        return false;
+    }
+    if (btstack_aes128_instructions == BTSTACK_AES128_INSTRUCTIONS_UNKNOWN){
+        btstack_aes128_instructions = btstack_aes128_instructions_supported() ?
+                BTSTACK_AES128_INSTRUCTIONS_AVAILABLE : BTSTACK_AES128_INSTRUCTIONS_NOT_AVAILABLE;
+        log_info("AES128 instructions %s", (btstack_aes128_instructions == BTSTACK_AES128_INSTRUCTIONS_AVAILABLE) ? "available" : "not available");
+    }
+    return btstack_aes128_instructions == BTSTACK_AES128_INSTRUCTIONS_AVAILABLE;
+}
+#endif
+
+bool btstack_aes128_instructions_active(void){
+#ifdef USE_AES128_INSTRUCTIONS
+    return btstack_aes128_use_instructions();
+#else
+    return false;
+#endif
+}
+
+void btstack_aes128_instructions_enable(bool enabled){
+#ifdef USE_AES128_INSTRUCTIONS
+    btstack_aes128_instructions_disabled = !enabled;
+#else
+    UNUSED(enabled);
+#endif
+    btstack_aes128_key_valid = false;
+}
+
+// AES128 using AES instructions or public domain rijndael implementation
+void btstack_aes128_calc(const uint8_t * key, const uint8_t * plaintext, uint8_t * ciphertext){
+#ifdef USE_AES128_INSTRUCTIONS
+    bool use_instructions = btstack_aes128_use_instructions();
+#endif
+    if (!btstack_aes128_key_valid || (memcmp(btstack_aes128_key, key, 16) != 0)){
+#ifdef USE_AES128_INSTRUCTIONS
+        if (use_instructions){
+            btstack_aes128_instructions_setup(key);
+        } else
+#endif
+        {
+            btstack_aes128_nrounds = rijndaelSetupEncrypt(btstack_aes128_rk, &key[0], KEYBITS);
+        }
+        (void)memcpy(btstack_aes128_key, key, 16);
+        btstack_aes128_key_valid = true;
+    }
+#ifdef USE_AES128_INSTRUCTIONS
+    if (use_instructions){
+        btstack_aes128_instructions_encrypt(plaintext, ciphertext);
+        return;
+    }
+#endif
+    rijndaelEncrypt(btstack_aes128_rk, btstack_aes128_nrounds, plaintext, ciphertext);
 }
 #endif
 
@@ -1417,6 +1591,100 @@ void btstack_crypto_ccm_decrypt_block(btstack_crypto_ccm_t * request, uint16_t l
     btstack_crypto_run();
 }
 
+#ifdef USE_BTSTACK_AES128
+void btstack_crypto_aes128_cmac_message_sync(const uint8_t * key, uint16_t size, const uint8_t * message, uint8_t * hash){
+    btstack_crypto_aes128_cmac_t request;
+    request.btstack_crypto.operation = BTSTACK_CRYPTO_CMAC_MESSAGE;
+    request.key                      = key;
+    request.size                     = size;
+    request.data.message             = message;
+    request.hash                     = hash;
+    btstack_crypto_cmac_calc(&request);
+}
+
+void btstack_crypto_aes128_cmac_generator_sync(const uint8_t * key, uint16_t size, uint8_t (*get_byte_callback)(uint16_t pos), uint8_t * hash){
+    btstack_crypto_aes128_cmac_t request;
+    request.btstack_crypto.operation = BTSTACK_CRYPTO_CMAC_GENERATOR;
+    request.key                      = key;
+    request.size                     = size;
+    request.data.get_byte_callback   = get_byte_callback;
+    request.hash                     = hash;
+    btstack_crypto_cmac_calc(&request);
+}
+
+static void btstack_crypto_ccm_calc_sync(btstack_crypto_ccm_t * request, const uint8_t * additional_authenticated_data,
+                                         const uint8_t * input, uint8_t * output, bool encrypt, uint8_t * authentication_value){
+    uint8_t block[16];
+    uint16_t i;
+
+    // X_1 = E(K, B_0)
+    btstack_crypto_ccm_setup_b_0(request, block);
+    btstack_aes128_calc(request->key, block, request->x_i);
+
+    // additional authenticated data, prefixed with 16-bit length and padded with zeros
+    if (request->aad_len > 0u){
+        uint16_t pos = 2;
+        request->x_i[0] ^= (uint8_t) (request->aad_len >> 8);
+        request->x_i[1] ^= (uint8_t) request->aad_len;
+        for (i = 0; i < request->aad_len; i++){
+            request->x_i[pos++] ^= additional_authenticated_data[i];
+            if (pos == 16u){
+                btstack_aes128_calc(request->key, request->x_i, request->x_i);
+                pos = 0;
+            }
+        }
+        if (pos > 0u){
+            btstack_aes128_calc(request->key, request->x_i, request->x_i);
+        }
+    }
+
+    // message: X_i+1 = E(K, X_i XOR B_i), output = input XOR S_i
+    uint16_t offset;
+    for (offset = 0; offset < request->message_len; offset += 16u){
+        uint16_t bytes_to_process = btstack_min(request->message_len - offset, 16u);
+        btstack_crypto_ccm_setup_a_i(request, request->counter++);
+        btstack_aes128_calc(request->key, btstack_crypto_ccm_s, block);
+        if (encrypt){
+            for (i = 0; i < bytes_to_process; i++){
+                request->x_i[i] ^= input[offset + i];
+            }
+            btstack_aes128_calc(request->key, request->x_i, request->x_i);
+            for (i = 0; i < bytes_to_process; i++){
+                output[offset + i] = input[offset + i] ^ block[i];
+            }
+        } else {
+            for (i = 0; i < bytes_to_process; i++){
+                output[offset + i] = input[offset + i] ^ block[i];
+                request->x_i[i] ^= output[offset + i];
+            }
+            btstack_aes128_calc(request->key, request->x_i, request->x_i);
+        }
+    }
+
+    // T = X_n+1 XOR S_0
+    btstack_crypto_ccm_setup_a_i(request, 0);
+    btstack_aes128_calc(request->key, btstack_crypto_ccm_s, block);
+    for (i = 0; i < request->auth_len; i++){
+        authentication_value[i] = request->x_i[i] ^ block[i];
+    }
+}
+
+void btstack_crypto_ccm_encrypt_sync(const uint8_t * key, const uint8_t * nonce, const uint8_t * additional_authenticated_data,
+                                     uint16_t additional_authenticated_data_len, const uint8_t * plaintext, uint16_t message_len,
+                                     uint8_t * ciphertext, uint8_t auth_len, uint8_t * authentication_value){
+    btstack_crypto_ccm_t request;
+    btstack_crypto_ccm_init(&request, key, nonce, message_len, additional_authenticated_data_len, auth_len);
+    btstack_crypto_ccm_calc_sync(&request, additional_authenticated_data, plaintext, ciphertext, true, authentication_value);
+}
+
+void btstack_crypto_ccm_decrypt_sync(const uint8_t * key, const uint8_t * nonce, const uint8_t * additional_authenticated_data,
+                                     uint16_t additional_authenticated_data_len, const uint8_t * ciphertext, uint16_t message_len,
+                                     uint8_t * plaintext, uint8_t auth_len, uint8_t * authentication_value){
+    btstack_crypto_ccm_t request;
+    btstack_crypto_ccm_init(&request, key, nonce, message_len, additional_authenticated_data_len, auth_len);
+    btstack_crypto_ccm_calc_sync(&request, additional_authenticated_data, ciphertext, plaintext, false, authentication_value);
+}
+#endif
 
 static void btstack_crypto_state_reset(void) {
 #ifndef USE_BTSTACK_AES128
@@ -1449,6 +1717,18 @@ void btstack_crypto_init(void){
 // De-Init
 void btstack_crypto_deinit(void) {
     btstack_crypto_initialized = false;
+#ifdef ENABLE_SOFTWARE_AES128
+    // clear cached key schedule
+    btstack_aes128_key_valid = false;
+    memset(btstack_aes128_key, 0, sizeof(btstack_aes128_key));
+    memset(btstack_aes128_rk, 0, sizeof(btstack_aes128_rk));
+#ifdef USE_AES128_X86_AESNI
+    memset(btstack_aes128_aesni_rk, 0, sizeof(btstack_aes128_aesni_rk));
+#endif
+#ifdef USE_AES128_ARMV8_CRYPTO
+    memset(btstack_aes128_armv8_rk, 0, sizeof(btstack_aes128_armv8_rk));
+#endif
+#endif
 }
 
 // PTS only
@@ -47,6 +47,7 @@
 
 #include "btstack_defines.h"
 #include "btstack_config.h"
+#include "btstack_bool.h"
 
 #if defined __cplusplus
 extern "C" {
@@ -283,6 +284,74 @@ void btstack_crypto_ccm_decrypt_block(btstack_crypto_ccm_t * request, uint16_t l
  * @param ciphertext (16 bytes)
  */
 void btstack_aes128_calc(const uint8_t * key, const uint8_t * plaintext, uint8_t * ciphertext);
+
+/**
+ * @brief Calculate AES128-CMAC for message synchronously
+ * @note Only available with software/custom AES128 implementation
+ * @param key (16 bytes)
+ * @param size of message
+ * @param message
+ * @param hash result (16 bytes)
+ */
+void btstack_crypto_aes128_cmac_message_sync(const uint8_t * key, uint16_t size, const uint8_t * message, uint8_t * hash);
+
+/**
+ * @brief Calculate AES128-CMAC for message provided by callback synchronously
+ * @note Only available with software/custom AES128 implementation
+ * @param key (16 bytes)
+ * @param size of message
+ * @param get_byte_callback
+ * @param hash result (16 bytes)
+ */
+void btstack_crypto_aes128_cmac_generator_sync(const uint8_t * key, uint16_t size, uint8_t (*get_byte_callback)(uint16_t pos), uint8_t * hash);
+
+/**
+ * @brief Encrypt message with AES128-CCM synchronously, plaintext and ciphertext may point to the same buffer
+ * @note Only available with software/custom AES128 implementation
+ * @param key (16 bytes)
+ * @param nonce (13 bytes)
+ * @param additional_authenticated_data
+ * @param additional_authenticated_data_len
+ * @param plaintext
+ * @param message_len
+ * @param ciphertext
+ * @param auth_len
+ * @param authentication_value (auth_len bytes)
+ */
+void btstack_crypto_ccm_encrypt_sync(const uint8_t * key, const uint8_t * nonce, const uint8_t * additional_authenticated_data,
+                                     uint16_t additional_authenticated_data_len, const uint8_t * plaintext, uint16_t message_len,
+                                     uint8_t * ciphertext, uint8_t auth_len, uint8_t * authentication_value);
+
+/**
+ * @brief Decrypt message with AES128-CCM synchronously, ciphertext and plaintext may point to the same buffer
+ * @note Only available with software/custom AES128 implementation. Caller has to compare authentication value
+ * @param key (16 bytes)
+ * @param nonce (13 bytes)
+ * @param additional_authenticated_data
+ * @param additional_authenticated_data_len
+ * @param ciphertext
+ * @param message_len
+ * @param plaintext
+ * @param auth_len
+ * @param authentication_value (auth_len bytes)
+ */
+void btstack_crypto_ccm_decrypt_sync(const uint8_t * key, const uint8_t * nonce, const uint8_t * additional_authenticated_data,
+                                     uint16_t additional_authenticated_data_len, const uint8_t * ciphertext, uint16_t message_len,
+                                     uint8_t * plaintext, uint8_t auth_len, uint8_t * authentication_value);
+#endif
+
+#ifdef ENABLE_SOFTWARE_AES128
+/**
+ * @brief Check if AES instructions (x86 AES-NI, ARMv8 Crypto Extension) are used for software AES128
+ * @return true if supported by compiler and CPU and not disabled
+ */
+bool btstack_aes128_instructions_active(void);
+
+/**
+ * @brief Enable/disable use of AES instructions for software AES128, enabled by default
+ * @param enabled
+ */
+void btstack_aes128_instructions_enable(bool enabled);
 #endif
 
 /**
@@ -113,6 +113,27 @@ static void btstack_memory_tracking_remove(btstack_memory_buffer_t * buffer){
 }
 #endif
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+typedef struct {
+    uint16_t num_in_use;
+    uint16_t max_in_use;
+} btstack_memory_usage_t;
+
+#ifdef HAVE_MALLOC
+static void btstack_memory_usage_get(btstack_memory_usage_t * usage){
+    usage->num_in_use++;
+    if (usage->num_in_use > usage->max_in_use){
+        usage->max_in_use = usage->num_in_use;
+    }
+}
+
+static void btstack_memory_usage_free(btstack_memory_usage_t * usage){
+    btstack_assert(usage->num_in_use > 0u);
+    usage->num_in_use--;
+}
+#endif
+#endif
+
 void btstack_memory_deinit(void){
 #ifdef HAVE_MALLOC
     while (btstack_memory_malloc_buffers != NULL){
@@ -138,16 +159,29 @@ void btstack_memory_deinit(void){
 #ifdef MAX_NR_HCI_CONNECTIONS
 #if MAX_NR_HCI_CONNECTIONS > 0
 static hci_connection_t hci_connection_storage[MAX_NR_HCI_CONNECTIONS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t hci_connection_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_HCI_CONNECTIONS)];
+static btstack_memory_tracked_pool_t hci_connection_pool;
+#else
 static btstack_memory_pool_t hci_connection_pool;
+#endif
 hci_connection_t * btstack_memory_hci_connection_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&hci_connection_pool);
+#else
     void * buffer = btstack_memory_pool_get(&hci_connection_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(hci_connection_t));
     }
     return (hci_connection_t *) buffer;
 }
 void btstack_memory_hci_connection_free(hci_connection_t *hci_connection){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&hci_connection_pool, hci_connection);
+#else
     btstack_memory_pool_free(&hci_connection_pool, hci_connection);
+#endif
 }
 #else
 hci_connection_t * btstack_memory_hci_connection_get(void){
@@ -164,11 +198,18 @@ typedef struct {
     hci_connection_t data;
 } btstack_memory_hci_connection_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t hci_connection_usage;
+#endif
+
 hci_connection_t * btstack_memory_hci_connection_get(void){
     btstack_memory_hci_connection_t * buffer = (btstack_memory_hci_connection_t *) malloc(sizeof(btstack_memory_hci_connection_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_hci_connection_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&hci_connection_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -179,6 +220,9 @@ void btstack_memory_hci_connection_free(hci_connection_t *hci_connection){
     btstack_memory_hci_connection_t *buffer = (btstack_memory_hci_connection_t *)
         ((uint8_t *)hci_connection - offsetof(btstack_memory_hci_connection_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&hci_connection_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -197,16 +241,29 @@ void btstack_memory_hci_connection_free(hci_connection_t *hci_connection){
 #ifdef MAX_NR_L2CAP_SERVICES
 #if MAX_NR_L2CAP_SERVICES > 0
 static l2cap_service_t l2cap_service_storage[MAX_NR_L2CAP_SERVICES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t l2cap_service_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_L2CAP_SERVICES)];
+static btstack_memory_tracked_pool_t l2cap_service_pool;
+#else
 static btstack_memory_pool_t l2cap_service_pool;
+#endif
 l2cap_service_t * btstack_memory_l2cap_service_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&l2cap_service_pool);
+#else
     void * buffer = btstack_memory_pool_get(&l2cap_service_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(l2cap_service_t));
     }
     return (l2cap_service_t *) buffer;
 }
 void btstack_memory_l2cap_service_free(l2cap_service_t *l2cap_service){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&l2cap_service_pool, l2cap_service);
+#else
     btstack_memory_pool_free(&l2cap_service_pool, l2cap_service);
+#endif
 }
 #else
 l2cap_service_t * btstack_memory_l2cap_service_get(void){
@@ -223,11 +280,18 @@ typedef struct {
     l2cap_service_t data;
 } btstack_memory_l2cap_service_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t l2cap_service_usage;
+#endif
+
 l2cap_service_t * btstack_memory_l2cap_service_get(void){
     btstack_memory_l2cap_service_t * buffer = (btstack_memory_l2cap_service_t *) malloc(sizeof(btstack_memory_l2cap_service_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_l2cap_service_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&l2cap_service_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -238,6 +302,9 @@ void btstack_memory_l2cap_service_free(l2cap_service_t *l2cap_service){
     btstack_memory_l2cap_service_t *buffer = (btstack_memory_l2cap_service_t *)
         ((uint8_t *)l2cap_service - offsetof(btstack_memory_l2cap_service_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&l2cap_service_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -255,16 +322,29 @@ void btstack_memory_l2cap_service_free(l2cap_service_t *l2cap_service){
 #ifdef MAX_NR_L2CAP_CHANNELS
 #if MAX_NR_L2CAP_CHANNELS > 0
 static l2cap_channel_t l2cap_channel_storage[MAX_NR_L2CAP_CHANNELS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t l2cap_channel_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_L2CAP_CHANNELS)];
+static btstack_memory_tracked_pool_t l2cap_channel_pool;
+#else
 static btstack_memory_pool_t l2cap_channel_pool;
+#endif
 l2cap_channel_t * btstack_memory_l2cap_channel_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&l2cap_channel_pool);
+#else
     void * buffer = btstack_memory_pool_get(&l2cap_channel_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(l2cap_channel_t));
     }
     return (l2cap_channel_t *) buffer;
 }
 void btstack_memory_l2cap_channel_free(l2cap_channel_t *l2cap_channel){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&l2cap_channel_pool, l2cap_channel);
+#else
     btstack_memory_pool_free(&l2cap_channel_pool, l2cap_channel);
+#endif
 }
 #else
 l2cap_channel_t * btstack_memory_l2cap_channel_get(void){
@@ -281,11 +361,18 @@ typedef struct {
     l2cap_channel_t data;
 } btstack_memory_l2cap_channel_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t l2cap_channel_usage;
+#endif
+
 l2cap_channel_t * btstack_memory_l2cap_channel_get(void){
     btstack_memory_l2cap_channel_t * buffer = (btstack_memory_l2cap_channel_t *) malloc(sizeof(btstack_memory_l2cap_channel_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_l2cap_channel_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&l2cap_channel_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -296,6 +383,9 @@ void btstack_memory_l2cap_channel_free(l2cap_channel_t *l2cap_channel){
     btstack_memory_l2cap_channel_t *buffer = (btstack_memory_l2cap_channel_t *)
         ((uint8_t *)l2cap_channel - offsetof(btstack_memory_l2cap_channel_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&l2cap_channel_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -315,16 +405,29 @@ void btstack_memory_l2cap_channel_free(l2cap_channel_t *l2cap_channel){
 #ifdef MAX_NR_RFCOMM_MULTIPLEXERS
 #if MAX_NR_RFCOMM_MULTIPLEXERS > 0
 static rfcomm_multiplexer_t rfcomm_multiplexer_storage[MAX_NR_RFCOMM_MULTIPLEXERS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t rfcomm_multiplexer_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_RFCOMM_MULTIPLEXERS)];
+static btstack_memory_tracked_pool_t rfcomm_multiplexer_pool;
+#else
 static btstack_memory_pool_t rfcomm_multiplexer_pool;
+#endif
 rfcomm_multiplexer_t * btstack_memory_rfcomm_multiplexer_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&rfcomm_multiplexer_pool);
+#else
     void * buffer = btstack_memory_pool_get(&rfcomm_multiplexer_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(rfcomm_multiplexer_t));
     }
     return (rfcomm_multiplexer_t *) buffer;
 }
 void btstack_memory_rfcomm_multiplexer_free(rfcomm_multiplexer_t *rfcomm_multiplexer){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&rfcomm_multiplexer_pool, rfcomm_multiplexer);
+#else
     btstack_memory_pool_free(&rfcomm_multiplexer_pool, rfcomm_multiplexer);
+#endif
 }
 #else
 rfcomm_multiplexer_t * btstack_memory_rfcomm_multiplexer_get(void){
@@ -341,11 +444,18 @@ typedef struct {
     rfcomm_multiplexer_t data;
 } btstack_memory_rfcomm_multiplexer_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t rfcomm_multiplexer_usage;
+#endif
+
 rfcomm_multiplexer_t * btstack_memory_rfcomm_multiplexer_get(void){
     btstack_memory_rfcomm_multiplexer_t * buffer = (btstack_memory_rfcomm_multiplexer_t *) malloc(sizeof(btstack_memory_rfcomm_multiplexer_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_rfcomm_multiplexer_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&rfcomm_multiplexer_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -356,6 +466,9 @@ void btstack_memory_rfcomm_multiplexer_free(rfcomm_multiplexer_t *rfcomm_multipl
     btstack_memory_rfcomm_multiplexer_t *buffer = (btstack_memory_rfcomm_multiplexer_t *)
         ((uint8_t *)rfcomm_multiplexer - offsetof(btstack_memory_rfcomm_multiplexer_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&rfcomm_multiplexer_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -373,16 +486,29 @@ void btstack_memory_rfcomm_multiplexer_free(rfcomm_multiplexer_t *rfcomm_multipl
 #ifdef MAX_NR_RFCOMM_SERVICES
 #if MAX_NR_RFCOMM_SERVICES > 0
 static rfcomm_service_t rfcomm_service_storage[MAX_NR_RFCOMM_SERVICES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t rfcomm_service_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_RFCOMM_SERVICES)];
+static btstack_memory_tracked_pool_t rfcomm_service_pool;
+#else
 static btstack_memory_pool_t rfcomm_service_pool;
+#endif
 rfcomm_service_t * btstack_memory_rfcomm_service_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&rfcomm_service_pool);
+#else
     void * buffer = btstack_memory_pool_get(&rfcomm_service_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(rfcomm_service_t));
     }
     return (rfcomm_service_t *) buffer;
 }
 void btstack_memory_rfcomm_service_free(rfcomm_service_t *rfcomm_service){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&rfcomm_service_pool, rfcomm_service);
+#else
     btstack_memory_pool_free(&rfcomm_service_pool, rfcomm_service);
+#endif
 }
 #else
 rfcomm_service_t * btstack_memory_rfcomm_service_get(void){
@@ -399,11 +525,18 @@ typedef struct {
     rfcomm_service_t data;
 } btstack_memory_rfcomm_service_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t rfcomm_service_usage;
+#endif
+
 rfcomm_service_t * btstack_memory_rfcomm_service_get(void){
     btstack_memory_rfcomm_service_t * buffer = (btstack_memory_rfcomm_service_t *) malloc(sizeof(btstack_memory_rfcomm_service_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_rfcomm_service_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&rfcomm_service_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -414,6 +547,9 @@ void btstack_memory_rfcomm_service_free(rfcomm_service_t *rfcomm_service){
     btstack_memory_rfcomm_service_t *buffer = (btstack_memory_rfcomm_service_t *)
         ((uint8_t *)rfcomm_service - offsetof(btstack_memory_rfcomm_service_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&rfcomm_service_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -431,16 +567,29 @@ void btstack_memory_rfcomm_service_free(rfcomm_service_t *rfcomm_service){
 #ifdef MAX_NR_RFCOMM_CHANNELS
 #if MAX_NR_RFCOMM_CHANNELS > 0
 static rfcomm_channel_t rfcomm_channel_storage[MAX_NR_RFCOMM_CHANNELS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t rfcomm_channel_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_RFCOMM_CHANNELS)];
+static btstack_memory_tracked_pool_t rfcomm_channel_pool;
+#else
 static btstack_memory_pool_t rfcomm_channel_pool;
+#endif
 rfcomm_channel_t * btstack_memory_rfcomm_channel_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&rfcomm_channel_pool);
+#else
     void * buffer = btstack_memory_pool_get(&rfcomm_channel_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(rfcomm_channel_t));
     }
     return (rfcomm_channel_t *) buffer;
 }
 void btstack_memory_rfcomm_channel_free(rfcomm_channel_t *rfcomm_channel){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&rfcomm_channel_pool, rfcomm_channel);
+#else
     btstack_memory_pool_free(&rfcomm_channel_pool, rfcomm_channel);
+#endif
 }
 #else
 rfcomm_channel_t * btstack_memory_rfcomm_channel_get(void){
@@ -457,11 +606,18 @@ typedef struct {
     rfcomm_channel_t data;
 } btstack_memory_rfcomm_channel_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t rfcomm_channel_usage;
+#endif
+
 rfcomm_channel_t * btstack_memory_rfcomm_channel_get(void){
     btstack_memory_rfcomm_channel_t * buffer = (btstack_memory_rfcomm_channel_t *) malloc(sizeof(btstack_memory_rfcomm_channel_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_rfcomm_channel_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&rfcomm_channel_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -472,6 +628,9 @@ void btstack_memory_rfcomm_channel_free(rfcomm_channel_t *rfcomm_channel){
     btstack_memory_rfcomm_channel_t *buffer = (btstack_memory_rfcomm_channel_t *)
         ((uint8_t *)rfcomm_channel - offsetof(btstack_memory_rfcomm_channel_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&rfcomm_channel_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -490,16 +649,29 @@ void btstack_memory_rfcomm_channel_free(rfcomm_channel_t *rfcomm_channel){
 #ifdef MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES
 #if MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES > 0
 static btstack_link_key_db_memory_entry_t btstack_link_key_db_memory_entry_storage[MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t btstack_link_key_db_memory_entry_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES)];
+static btstack_memory_tracked_pool_t btstack_link_key_db_memory_entry_pool;
+#else
 static btstack_memory_pool_t btstack_link_key_db_memory_entry_pool;
+#endif
 btstack_link_key_db_memory_entry_t * btstack_memory_btstack_link_key_db_memory_entry_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&btstack_link_key_db_memory_entry_pool);
+#else
     void * buffer = btstack_memory_pool_get(&btstack_link_key_db_memory_entry_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(btstack_link_key_db_memory_entry_t));
     }
     return (btstack_link_key_db_memory_entry_t *) buffer;
 }
 void btstack_memory_btstack_link_key_db_memory_entry_free(btstack_link_key_db_memory_entry_t *btstack_link_key_db_memory_entry){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&btstack_link_key_db_memory_entry_pool, btstack_link_key_db_memory_entry);
+#else
     btstack_memory_pool_free(&btstack_link_key_db_memory_entry_pool, btstack_link_key_db_memory_entry);
+#endif
 }
 #else
 btstack_link_key_db_memory_entry_t * btstack_memory_btstack_link_key_db_memory_entry_get(void){
@@ -516,11 +688,18 @@ typedef struct {
     btstack_link_key_db_memory_entry_t data;
 } btstack_memory_btstack_link_key_db_memory_entry_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t btstack_link_key_db_memory_entry_usage;
+#endif
+
 btstack_link_key_db_memory_entry_t * btstack_memory_btstack_link_key_db_memory_entry_get(void){
     btstack_memory_btstack_link_key_db_memory_entry_t * buffer = (btstack_memory_btstack_link_key_db_memory_entry_t *) malloc(sizeof(btstack_memory_btstack_link_key_db_memory_entry_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_btstack_link_key_db_memory_entry_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&btstack_link_key_db_memory_entry_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -531,6 +710,9 @@ void btstack_memory_btstack_link_key_db_memory_entry_free(btstack_link_key_db_me
     btstack_memory_btstack_link_key_db_memory_entry_t *buffer = (btstack_memory_btstack_link_key_db_memory_entry_t *)
         ((uint8_t *)btstack_link_key_db_memory_entry - offsetof(btstack_memory_btstack_link_key_db_memory_entry_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&btstack_link_key_db_memory_entry_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -549,16 +731,29 @@ void btstack_memory_btstack_link_key_db_memory_entry_free(btstack_link_key_db_me
 #ifdef MAX_NR_BNEP_SERVICES
 #if MAX_NR_BNEP_SERVICES > 0
 static bnep_service_t bnep_service_storage[MAX_NR_BNEP_SERVICES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t bnep_service_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_BNEP_SERVICES)];
+static btstack_memory_tracked_pool_t bnep_service_pool;
+#else
 static btstack_memory_pool_t bnep_service_pool;
+#endif
 bnep_service_t * btstack_memory_bnep_service_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&bnep_service_pool);
+#else
     void * buffer = btstack_memory_pool_get(&bnep_service_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(bnep_service_t));
     }
     return (bnep_service_t *) buffer;
 }
 void btstack_memory_bnep_service_free(bnep_service_t *bnep_service){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&bnep_service_pool, bnep_service);
+#else
     btstack_memory_pool_free(&bnep_service_pool, bnep_service);
+#endif
 }
 #else
 bnep_service_t * btstack_memory_bnep_service_get(void){
@@ -575,11 +770,18 @@ typedef struct {
     bnep_service_t data;
 } btstack_memory_bnep_service_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t bnep_service_usage;
+#endif
+
 bnep_service_t * btstack_memory_bnep_service_get(void){
     btstack_memory_bnep_service_t * buffer = (btstack_memory_bnep_service_t *) malloc(sizeof(btstack_memory_bnep_service_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_bnep_service_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&bnep_service_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -590,6 +792,9 @@ void btstack_memory_bnep_service_free(bnep_service_t *bnep_service){
     btstack_memory_bnep_service_t *buffer = (btstack_memory_bnep_service_t *)
         ((uint8_t *)bnep_service - offsetof(btstack_memory_bnep_service_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&bnep_service_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -607,16 +812,29 @@ void btstack_memory_bnep_service_free(bnep_service_t *bnep_service){
 #ifdef MAX_NR_BNEP_CHANNELS
 #if MAX_NR_BNEP_CHANNELS > 0
 static bnep_channel_t bnep_channel_storage[MAX_NR_BNEP_CHANNELS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t bnep_channel_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_BNEP_CHANNELS)];
+static btstack_memory_tracked_pool_t bnep_channel_pool;
+#else
 static btstack_memory_pool_t bnep_channel_pool;
+#endif
 bnep_channel_t * btstack_memory_bnep_channel_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&bnep_channel_pool);
+#else
     void * buffer = btstack_memory_pool_get(&bnep_channel_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(bnep_channel_t));
     }
     return (bnep_channel_t *) buffer;
 }
 void btstack_memory_bnep_channel_free(bnep_channel_t *bnep_channel){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&bnep_channel_pool, bnep_channel);
+#else
     btstack_memory_pool_free(&bnep_channel_pool, bnep_channel);
+#endif
 }
 #else
 bnep_channel_t * btstack_memory_bnep_channel_get(void){
@@ -633,11 +851,18 @@ typedef struct {
     bnep_channel_t data;
 } btstack_memory_bnep_channel_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t bnep_channel_usage;
+#endif
+
 bnep_channel_t * btstack_memory_bnep_channel_get(void){
     btstack_memory_bnep_channel_t * buffer = (btstack_memory_bnep_channel_t *) malloc(sizeof(btstack_memory_bnep_channel_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_bnep_channel_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&bnep_channel_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -648,6 +873,9 @@ void btstack_memory_bnep_channel_free(bnep_channel_t *bnep_channel){
     btstack_memory_bnep_channel_t *buffer = (btstack_memory_bnep_channel_t *)
         ((uint8_t *)bnep_channel - offsetof(btstack_memory_bnep_channel_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&bnep_channel_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -666,16 +894,29 @@ void btstack_memory_bnep_channel_free(bnep_channel_t *bnep_channel){
 #ifdef MAX_NR_GOEP_SERVER_SERVICES
 #if MAX_NR_GOEP_SERVER_SERVICES > 0
 static goep_server_service_t goep_server_service_storage[MAX_NR_GOEP_SERVER_SERVICES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t goep_server_service_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_GOEP_SERVER_SERVICES)];
+static btstack_memory_tracked_pool_t goep_server_service_pool;
+#else
 static btstack_memory_pool_t goep_server_service_pool;
+#endif
 goep_server_service_t * btstack_memory_goep_server_service_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&goep_server_service_pool);
+#else
     void * buffer = btstack_memory_pool_get(&goep_server_service_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(goep_server_service_t));
     }
     return (goep_server_service_t *) buffer;
 }
 void btstack_memory_goep_server_service_free(goep_server_service_t *goep_server_service){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&goep_server_service_pool, goep_server_service);
+#else
     btstack_memory_pool_free(&goep_server_service_pool, goep_server_service);
+#endif
 }
 #else
 goep_server_service_t * btstack_memory_goep_server_service_get(void){
@@ -692,11 +933,18 @@ typedef struct {
     goep_server_service_t data;
 } btstack_memory_goep_server_service_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t goep_server_service_usage;
+#endif
+
 goep_server_service_t * btstack_memory_goep_server_service_get(void){
     btstack_memory_goep_server_service_t * buffer = (btstack_memory_goep_server_service_t *) malloc(sizeof(btstack_memory_goep_server_service_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_goep_server_service_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&goep_server_service_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -707,6 +955,9 @@ void btstack_memory_goep_server_service_free(goep_server_service_t *goep_server_
     btstack_memory_goep_server_service_t *buffer = (btstack_memory_goep_server_service_t *)
         ((uint8_t *)goep_server_service - offsetof(btstack_memory_goep_server_service_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&goep_server_service_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -724,16 +975,29 @@ void btstack_memory_goep_server_service_free(goep_server_service_t *goep_server_
 #ifdef MAX_NR_GOEP_SERVER_CONNECTIONS
 #if MAX_NR_GOEP_SERVER_CONNECTIONS > 0
 static goep_server_connection_t goep_server_connection_storage[MAX_NR_GOEP_SERVER_CONNECTIONS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t goep_server_connection_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_GOEP_SERVER_CONNECTIONS)];
+static btstack_memory_tracked_pool_t goep_server_connection_pool;
+#else
 static btstack_memory_pool_t goep_server_connection_pool;
+#endif
 goep_server_connection_t * btstack_memory_goep_server_connection_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&goep_server_connection_pool);
+#else
     void * buffer = btstack_memory_pool_get(&goep_server_connection_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(goep_server_connection_t));
     }
     return (goep_server_connection_t *) buffer;
 }
 void btstack_memory_goep_server_connection_free(goep_server_connection_t *goep_server_connection){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&goep_server_connection_pool, goep_server_connection);
+#else
     btstack_memory_pool_free(&goep_server_connection_pool, goep_server_connection);
+#endif
 }
 #else
 goep_server_connection_t * btstack_memory_goep_server_connection_get(void){
@@ -750,11 +1014,18 @@ typedef struct {
     goep_server_connection_t data;
 } btstack_memory_goep_server_connection_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t goep_server_connection_usage;
+#endif
+
 goep_server_connection_t * btstack_memory_goep_server_connection_get(void){
     btstack_memory_goep_server_connection_t * buffer = (btstack_memory_goep_server_connection_t *) malloc(sizeof(btstack_memory_goep_server_connection_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_goep_server_connection_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&goep_server_connection_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -765,6 +1036,9 @@ void btstack_memory_goep_server_connection_free(goep_server_connection_t *goep_s
     btstack_memory_goep_server_connection_t *buffer = (btstack_memory_goep_server_connection_t *)
         ((uint8_t *)goep_server_connection - offsetof(btstack_memory_goep_server_connection_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&goep_server_connection_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -783,16 +1057,29 @@ void btstack_memory_goep_server_connection_free(goep_server_connection_t *goep_s
 #ifdef MAX_NR_HFP_CONNECTIONS
 #if MAX_NR_HFP_CONNECTIONS > 0
 static hfp_connection_t hfp_connection_storage[MAX_NR_HFP_CONNECTIONS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t hfp_connection_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_HFP_CONNECTIONS)];
+static btstack_memory_tracked_pool_t hfp_connection_pool;
+#else
 static btstack_memory_pool_t hfp_connection_pool;
+#endif
 hfp_connection_t * btstack_memory_hfp_connection_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&hfp_connection_pool);
+#else
     void * buffer = btstack_memory_pool_get(&hfp_connection_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(hfp_connection_t));
     }
     return (hfp_connection_t *) buffer;
 }
 void btstack_memory_hfp_connection_free(hfp_connection_t *hfp_connection){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&hfp_connection_pool, hfp_connection);
+#else
     btstack_memory_pool_free(&hfp_connection_pool, hfp_connection);
+#endif
 }
 #else
 hfp_connection_t * btstack_memory_hfp_connection_get(void){
@@ -809,11 +1096,18 @@ typedef struct {
     hfp_connection_t data;
 } btstack_memory_hfp_connection_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t hfp_connection_usage;
+#endif
+
 hfp_connection_t * btstack_memory_hfp_connection_get(void){
     btstack_memory_hfp_connection_t * buffer = (btstack_memory_hfp_connection_t *) malloc(sizeof(btstack_memory_hfp_connection_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_hfp_connection_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&hfp_connection_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -824,6 +1118,9 @@ void btstack_memory_hfp_connection_free(hfp_connection_t *hfp_connection){
     btstack_memory_hfp_connection_t *buffer = (btstack_memory_hfp_connection_t *)
         ((uint8_t *)hfp_connection - offsetof(btstack_memory_hfp_connection_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&hfp_connection_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -842,16 +1139,29 @@ void btstack_memory_hfp_connection_free(hfp_connection_t *hfp_connection){
 #ifdef MAX_NR_HID_HOST_CONNECTIONS
 #if MAX_NR_HID_HOST_CONNECTIONS > 0
 static hid_host_connection_t hid_host_connection_storage[MAX_NR_HID_HOST_CONNECTIONS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t hid_host_connection_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_HID_HOST_CONNECTIONS)];
+static btstack_memory_tracked_pool_t hid_host_connection_pool;
+#else
 static btstack_memory_pool_t hid_host_connection_pool;
+#endif
 hid_host_connection_t * btstack_memory_hid_host_connection_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&hid_host_connection_pool);
+#else
     void * buffer = btstack_memory_pool_get(&hid_host_connection_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(hid_host_connection_t));
     }
     return (hid_host_connection_t *) buffer;
 }
 void btstack_memory_hid_host_connection_free(hid_host_connection_t *hid_host_connection){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&hid_host_connection_pool, hid_host_connection);
+#else
     btstack_memory_pool_free(&hid_host_connection_pool, hid_host_connection);
+#endif
 }
 #else
 hid_host_connection_t * btstack_memory_hid_host_connection_get(void){
@@ -868,11 +1178,18 @@ typedef struct {
     hid_host_connection_t data;
 } btstack_memory_hid_host_connection_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t hid_host_connection_usage;
+#endif
+
 hid_host_connection_t * btstack_memory_hid_host_connection_get(void){
     btstack_memory_hid_host_connection_t * buffer = (btstack_memory_hid_host_connection_t *) malloc(sizeof(btstack_memory_hid_host_connection_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_hid_host_connection_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&hid_host_connection_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -883,6 +1200,9 @@ void btstack_memory_hid_host_connection_free(hid_host_connection_t *hid_host_con
     btstack_memory_hid_host_connection_t *buffer = (btstack_memory_hid_host_connection_t *)
         ((uint8_t *)hid_host_connection - offsetof(btstack_memory_hid_host_connection_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&hid_host_connection_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -901,16 +1221,29 @@ void btstack_memory_hid_host_connection_free(hid_host_connection_t *hid_host_con
 #ifdef MAX_NR_SERVICE_RECORD_ITEMS
 #if MAX_NR_SERVICE_RECORD_ITEMS > 0
 static service_record_item_t service_record_item_storage[MAX_NR_SERVICE_RECORD_ITEMS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t service_record_item_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_SERVICE_RECORD_ITEMS)];
+static btstack_memory_tracked_pool_t service_record_item_pool;
+#else
 static btstack_memory_pool_t service_record_item_pool;
+#endif
 service_record_item_t * btstack_memory_service_record_item_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&service_record_item_pool);
+#else
     void * buffer = btstack_memory_pool_get(&service_record_item_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(service_record_item_t));
     }
     return (service_record_item_t *) buffer;
 }
 void btstack_memory_service_record_item_free(service_record_item_t *service_record_item){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&service_record_item_pool, service_record_item);
+#else
     btstack_memory_pool_free(&service_record_item_pool, service_record_item);
+#endif
 }
 #else
 service_record_item_t * btstack_memory_service_record_item_get(void){
@@ -927,11 +1260,18 @@ typedef struct {
     service_record_item_t data;
 } btstack_memory_service_record_item_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t service_record_item_usage;
+#endif
+
 service_record_item_t * btstack_memory_service_record_item_get(void){
     btstack_memory_service_record_item_t * buffer = (btstack_memory_service_record_item_t *) malloc(sizeof(btstack_memory_service_record_item_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_service_record_item_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&service_record_item_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -942,6 +1282,9 @@ void btstack_memory_service_record_item_free(service_record_item_t *service_reco
     btstack_memory_service_record_item_t *buffer = (btstack_memory_service_record_item_t *)
         ((uint8_t *)service_record_item - offsetof(btstack_memory_service_record_item_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&service_record_item_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -960,16 +1303,29 @@ void btstack_memory_service_record_item_free(service_record_item_t *service_reco
 #ifdef MAX_NR_AVDTP_STREAM_ENDPOINTS
 #if MAX_NR_AVDTP_STREAM_ENDPOINTS > 0
 static avdtp_stream_endpoint_t avdtp_stream_endpoint_storage[MAX_NR_AVDTP_STREAM_ENDPOINTS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t avdtp_stream_endpoint_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_AVDTP_STREAM_ENDPOINTS)];
+static btstack_memory_tracked_pool_t avdtp_stream_endpoint_pool;
+#else
 static btstack_memory_pool_t avdtp_stream_endpoint_pool;
+#endif
 avdtp_stream_endpoint_t * btstack_memory_avdtp_stream_endpoint_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&avdtp_stream_endpoint_pool);
+#else
     void * buffer = btstack_memory_pool_get(&avdtp_stream_endpoint_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(avdtp_stream_endpoint_t));
     }
     return (avdtp_stream_endpoint_t *) buffer;
 }
 void btstack_memory_avdtp_stream_endpoint_free(avdtp_stream_endpoint_t *avdtp_stream_endpoint){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&avdtp_stream_endpoint_pool, avdtp_stream_endpoint);
+#else
     btstack_memory_pool_free(&avdtp_stream_endpoint_pool, avdtp_stream_endpoint);
+#endif
 }
 #else
 avdtp_stream_endpoint_t * btstack_memory_avdtp_stream_endpoint_get(void){
@@ -986,11 +1342,18 @@ typedef struct {
     avdtp_stream_endpoint_t data;
 } btstack_memory_avdtp_stream_endpoint_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t avdtp_stream_endpoint_usage;
+#endif
+
 avdtp_stream_endpoint_t * btstack_memory_avdtp_stream_endpoint_get(void){
     btstack_memory_avdtp_stream_endpoint_t * buffer = (btstack_memory_avdtp_stream_endpoint_t *) malloc(sizeof(btstack_memory_avdtp_stream_endpoint_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_avdtp_stream_endpoint_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&avdtp_stream_endpoint_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1001,6 +1364,9 @@ void btstack_memory_avdtp_stream_endpoint_free(avdtp_stream_endpoint_t *avdtp_st
     btstack_memory_avdtp_stream_endpoint_t *buffer = (btstack_memory_avdtp_stream_endpoint_t *)
         ((uint8_t *)avdtp_stream_endpoint - offsetof(btstack_memory_avdtp_stream_endpoint_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&avdtp_stream_endpoint_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1019,16 +1385,29 @@ void btstack_memory_avdtp_stream_endpoint_free(avdtp_stream_endpoint_t *avdtp_st
 #ifdef MAX_NR_AVDTP_CONNECTIONS
 #if MAX_NR_AVDTP_CONNECTIONS > 0
 static avdtp_connection_t avdtp_connection_storage[MAX_NR_AVDTP_CONNECTIONS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t avdtp_connection_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_AVDTP_CONNECTIONS)];
+static btstack_memory_tracked_pool_t avdtp_connection_pool;
+#else
 static btstack_memory_pool_t avdtp_connection_pool;
+#endif
 avdtp_connection_t * btstack_memory_avdtp_connection_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&avdtp_connection_pool);
+#else
     void * buffer = btstack_memory_pool_get(&avdtp_connection_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(avdtp_connection_t));
     }
     return (avdtp_connection_t *) buffer;
 }
 void btstack_memory_avdtp_connection_free(avdtp_connection_t *avdtp_connection){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&avdtp_connection_pool, avdtp_connection);
+#else
     btstack_memory_pool_free(&avdtp_connection_pool, avdtp_connection);
+#endif
 }
 #else
 avdtp_connection_t * btstack_memory_avdtp_connection_get(void){
@@ -1045,11 +1424,18 @@ typedef struct {
     avdtp_connection_t data;
 } btstack_memory_avdtp_connection_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t avdtp_connection_usage;
+#endif
+
 avdtp_connection_t * btstack_memory_avdtp_connection_get(void){
     btstack_memory_avdtp_connection_t * buffer = (btstack_memory_avdtp_connection_t *) malloc(sizeof(btstack_memory_avdtp_connection_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_avdtp_connection_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&avdtp_connection_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1060,6 +1446,9 @@ void btstack_memory_avdtp_connection_free(avdtp_connection_t *avdtp_connection){
     btstack_memory_avdtp_connection_t *buffer = (btstack_memory_avdtp_connection_t *)
         ((uint8_t *)avdtp_connection - offsetof(btstack_memory_avdtp_connection_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&avdtp_connection_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1078,16 +1467,29 @@ void btstack_memory_avdtp_connection_free(avdtp_connection_t *avdtp_connection){
 #ifdef MAX_NR_AVRCP_CONNECTIONS
 #if MAX_NR_AVRCP_CONNECTIONS > 0
 static avrcp_connection_t avrcp_connection_storage[MAX_NR_AVRCP_CONNECTIONS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t avrcp_connection_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_AVRCP_CONNECTIONS)];
+static btstack_memory_tracked_pool_t avrcp_connection_pool;
+#else
 static btstack_memory_pool_t avrcp_connection_pool;
+#endif
 avrcp_connection_t * btstack_memory_avrcp_connection_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&avrcp_connection_pool);
+#else
     void * buffer = btstack_memory_pool_get(&avrcp_connection_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(avrcp_connection_t));
     }
     return (avrcp_connection_t *) buffer;
 }
 void btstack_memory_avrcp_connection_free(avrcp_connection_t *avrcp_connection){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&avrcp_connection_pool, avrcp_connection);
+#else
     btstack_memory_pool_free(&avrcp_connection_pool, avrcp_connection);
+#endif
 }
 #else
 avrcp_connection_t * btstack_memory_avrcp_connection_get(void){
@@ -1104,11 +1506,18 @@ typedef struct {
     avrcp_connection_t data;
 } btstack_memory_avrcp_connection_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t avrcp_connection_usage;
+#endif
+
 avrcp_connection_t * btstack_memory_avrcp_connection_get(void){
     btstack_memory_avrcp_connection_t * buffer = (btstack_memory_avrcp_connection_t *) malloc(sizeof(btstack_memory_avrcp_connection_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_avrcp_connection_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&avrcp_connection_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1119,6 +1528,9 @@ void btstack_memory_avrcp_connection_free(avrcp_connection_t *avrcp_connection){
     btstack_memory_avrcp_connection_t *buffer = (btstack_memory_avrcp_connection_t *)
         ((uint8_t *)avrcp_connection - offsetof(btstack_memory_avrcp_connection_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&avrcp_connection_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1137,16 +1549,29 @@ void btstack_memory_avrcp_connection_free(avrcp_connection_t *avrcp_connection){
 #ifdef MAX_NR_AVRCP_BROWSING_CONNECTIONS
 #if MAX_NR_AVRCP_BROWSING_CONNECTIONS > 0
 static avrcp_browsing_connection_t avrcp_browsing_connection_storage[MAX_NR_AVRCP_BROWSING_CONNECTIONS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t avrcp_browsing_connection_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_AVRCP_BROWSING_CONNECTIONS)];
+static btstack_memory_tracked_pool_t avrcp_browsing_connection_pool;
+#else
 static btstack_memory_pool_t avrcp_browsing_connection_pool;
+#endif
 avrcp_browsing_connection_t * btstack_memory_avrcp_browsing_connection_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&avrcp_browsing_connection_pool);
+#else
     void * buffer = btstack_memory_pool_get(&avrcp_browsing_connection_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(avrcp_browsing_connection_t));
     }
     return (avrcp_browsing_connection_t *) buffer;
 }
 void btstack_memory_avrcp_browsing_connection_free(avrcp_browsing_connection_t *avrcp_browsing_connection){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&avrcp_browsing_connection_pool, avrcp_browsing_connection);
+#else
     btstack_memory_pool_free(&avrcp_browsing_connection_pool, avrcp_browsing_connection);
+#endif
 }
 #else
 avrcp_browsing_connection_t * btstack_memory_avrcp_browsing_connection_get(void){
@@ -1163,11 +1588,18 @@ typedef struct {
     avrcp_browsing_connection_t data;
 } btstack_memory_avrcp_browsing_connection_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t avrcp_browsing_connection_usage;
+#endif
+
 avrcp_browsing_connection_t * btstack_memory_avrcp_browsing_connection_get(void){
     btstack_memory_avrcp_browsing_connection_t * buffer = (btstack_memory_avrcp_browsing_connection_t *) malloc(sizeof(btstack_memory_avrcp_browsing_connection_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_avrcp_browsing_connection_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&avrcp_browsing_connection_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1178,6 +1610,9 @@ void btstack_memory_avrcp_browsing_connection_free(avrcp_browsing_connection_t *
     btstack_memory_avrcp_browsing_connection_t *buffer = (btstack_memory_avrcp_browsing_connection_t *)
         ((uint8_t *)avrcp_browsing_connection - offsetof(btstack_memory_avrcp_browsing_connection_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&avrcp_browsing_connection_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1198,16 +1633,29 @@ void btstack_memory_avrcp_browsing_connection_free(avrcp_browsing_connection_t *
 #ifdef MAX_NR_BATTERY_SERVICE_CLIENTS
 #if MAX_NR_BATTERY_SERVICE_CLIENTS > 0
 static battery_service_client_t battery_service_client_storage[MAX_NR_BATTERY_SERVICE_CLIENTS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t battery_service_client_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_BATTERY_SERVICE_CLIENTS)];
+static btstack_memory_tracked_pool_t battery_service_client_pool;
+#else
 static btstack_memory_pool_t battery_service_client_pool;
+#endif
 battery_service_client_t * btstack_memory_battery_service_client_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&battery_service_client_pool);
+#else
     void * buffer = btstack_memory_pool_get(&battery_service_client_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(battery_service_client_t));
     }
     return (battery_service_client_t *) buffer;
 }
 void btstack_memory_battery_service_client_free(battery_service_client_t *battery_service_client){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&battery_service_client_pool, battery_service_client);
+#else
     btstack_memory_pool_free(&battery_service_client_pool, battery_service_client);
+#endif
 }
 #else
 battery_service_client_t * btstack_memory_battery_service_client_get(void){
@@ -1224,11 +1672,18 @@ typedef struct {
     battery_service_client_t data;
 } btstack_memory_battery_service_client_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t battery_service_client_usage;
+#endif
+
 battery_service_client_t * btstack_memory_battery_service_client_get(void){
     btstack_memory_battery_service_client_t * buffer = (btstack_memory_battery_service_client_t *) malloc(sizeof(btstack_memory_battery_service_client_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_battery_service_client_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&battery_service_client_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1239,6 +1694,9 @@ void btstack_memory_battery_service_client_free(battery_service_client_t *batter
     btstack_memory_battery_service_client_t *buffer = (btstack_memory_battery_service_client_t *)
         ((uint8_t *)battery_service_client - offsetof(btstack_memory_battery_service_client_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&battery_service_client_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1256,16 +1714,29 @@ void btstack_memory_battery_service_client_free(battery_service_client_t *batter
 #ifdef MAX_NR_GATT_CLIENTS
 #if MAX_NR_GATT_CLIENTS > 0
 static gatt_client_t gatt_client_storage[MAX_NR_GATT_CLIENTS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t gatt_client_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_GATT_CLIENTS)];
+static btstack_memory_tracked_pool_t gatt_client_pool;
+#else
 static btstack_memory_pool_t gatt_client_pool;
+#endif
 gatt_client_t * btstack_memory_gatt_client_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&gatt_client_pool);
+#else
     void * buffer = btstack_memory_pool_get(&gatt_client_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(gatt_client_t));
     }
     return (gatt_client_t *) buffer;
 }
 void btstack_memory_gatt_client_free(gatt_client_t *gatt_client){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&gatt_client_pool, gatt_client);
+#else
     btstack_memory_pool_free(&gatt_client_pool, gatt_client);
+#endif
 }
 #else
 gatt_client_t * btstack_memory_gatt_client_get(void){
@@ -1282,11 +1753,18 @@ typedef struct {
     gatt_client_t data;
 } btstack_memory_gatt_client_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t gatt_client_usage;
+#endif
+
 gatt_client_t * btstack_memory_gatt_client_get(void){
     btstack_memory_gatt_client_t * buffer = (btstack_memory_gatt_client_t *) malloc(sizeof(btstack_memory_gatt_client_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_gatt_client_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&gatt_client_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1297,6 +1775,9 @@ void btstack_memory_gatt_client_free(gatt_client_t *gatt_client){
     btstack_memory_gatt_client_t *buffer = (btstack_memory_gatt_client_t *)
         ((uint8_t *)gatt_client - offsetof(btstack_memory_gatt_client_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&gatt_client_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1314,16 +1795,29 @@ void btstack_memory_gatt_client_free(gatt_client_t *gatt_client){
 #ifdef MAX_NR_HIDS_HOSTS
 #if MAX_NR_HIDS_HOSTS > 0
 static hids_host_t hids_host_storage[MAX_NR_HIDS_HOSTS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t hids_host_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_HIDS_HOSTS)];
+static btstack_memory_tracked_pool_t hids_host_pool;
+#else
 static btstack_memory_pool_t hids_host_pool;
+#endif
 hids_host_t * btstack_memory_hids_host_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&hids_host_pool);
+#else
     void * buffer = btstack_memory_pool_get(&hids_host_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(hids_host_t));
     }
     return (hids_host_t *) buffer;
 }
 void btstack_memory_hids_host_free(hids_host_t *hids_host){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&hids_host_pool, hids_host);
+#else
     btstack_memory_pool_free(&hids_host_pool, hids_host);
+#endif
 }
 #else
 hids_host_t * btstack_memory_hids_host_get(void){
@@ -1340,11 +1834,18 @@ typedef struct {
     hids_host_t data;
 } btstack_memory_hids_host_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t hids_host_usage;
+#endif
+
 hids_host_t * btstack_memory_hids_host_get(void){
     btstack_memory_hids_host_t * buffer = (btstack_memory_hids_host_t *) malloc(sizeof(btstack_memory_hids_host_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_hids_host_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&hids_host_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1355,6 +1856,9 @@ void btstack_memory_hids_host_free(hids_host_t *hids_host){
     btstack_memory_hids_host_t *buffer = (btstack_memory_hids_host_t *)
         ((uint8_t *)hids_host - offsetof(btstack_memory_hids_host_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&hids_host_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1372,16 +1876,29 @@ void btstack_memory_hids_host_free(hids_host_t *hids_host){
 #ifdef MAX_NR_SM_LOOKUP_ENTRIES
 #if MAX_NR_SM_LOOKUP_ENTRIES > 0
 static sm_lookup_entry_t sm_lookup_entry_storage[MAX_NR_SM_LOOKUP_ENTRIES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t sm_lookup_entry_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_SM_LOOKUP_ENTRIES)];
+static btstack_memory_tracked_pool_t sm_lookup_entry_pool;
+#else
 static btstack_memory_pool_t sm_lookup_entry_pool;
+#endif
 sm_lookup_entry_t * btstack_memory_sm_lookup_entry_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&sm_lookup_entry_pool);
+#else
     void * buffer = btstack_memory_pool_get(&sm_lookup_entry_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(sm_lookup_entry_t));
     }
     return (sm_lookup_entry_t *) buffer;
 }
 void btstack_memory_sm_lookup_entry_free(sm_lookup_entry_t *sm_lookup_entry){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&sm_lookup_entry_pool, sm_lookup_entry);
+#else
     btstack_memory_pool_free(&sm_lookup_entry_pool, sm_lookup_entry);
+#endif
 }
 #else
 sm_lookup_entry_t * btstack_memory_sm_lookup_entry_get(void){
@@ -1398,11 +1915,18 @@ typedef struct {
     sm_lookup_entry_t data;
 } btstack_memory_sm_lookup_entry_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t sm_lookup_entry_usage;
+#endif
+
 sm_lookup_entry_t * btstack_memory_sm_lookup_entry_get(void){
     btstack_memory_sm_lookup_entry_t * buffer = (btstack_memory_sm_lookup_entry_t *) malloc(sizeof(btstack_memory_sm_lookup_entry_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_sm_lookup_entry_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&sm_lookup_entry_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1413,6 +1937,9 @@ void btstack_memory_sm_lookup_entry_free(sm_lookup_entry_t *sm_lookup_entry){
     btstack_memory_sm_lookup_entry_t *buffer = (btstack_memory_sm_lookup_entry_t *)
         ((uint8_t *)sm_lookup_entry - offsetof(btstack_memory_sm_lookup_entry_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&sm_lookup_entry_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1430,16 +1957,29 @@ void btstack_memory_sm_lookup_entry_free(sm_lookup_entry_t *sm_lookup_entry){
 #ifdef MAX_NR_WHITELIST_ENTRIES
 #if MAX_NR_WHITELIST_ENTRIES > 0
 static whitelist_entry_t whitelist_entry_storage[MAX_NR_WHITELIST_ENTRIES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t whitelist_entry_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_WHITELIST_ENTRIES)];
+static btstack_memory_tracked_pool_t whitelist_entry_pool;
+#else
 static btstack_memory_pool_t whitelist_entry_pool;
+#endif
 whitelist_entry_t * btstack_memory_whitelist_entry_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&whitelist_entry_pool);
+#else
     void * buffer = btstack_memory_pool_get(&whitelist_entry_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(whitelist_entry_t));
     }
     return (whitelist_entry_t *) buffer;
 }
 void btstack_memory_whitelist_entry_free(whitelist_entry_t *whitelist_entry){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&whitelist_entry_pool, whitelist_entry);
+#else
     btstack_memory_pool_free(&whitelist_entry_pool, whitelist_entry);
+#endif
 }
 #else
 whitelist_entry_t * btstack_memory_whitelist_entry_get(void){
@@ -1456,11 +1996,18 @@ typedef struct {
     whitelist_entry_t data;
 } btstack_memory_whitelist_entry_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t whitelist_entry_usage;
+#endif
+
 whitelist_entry_t * btstack_memory_whitelist_entry_get(void){
     btstack_memory_whitelist_entry_t * buffer = (btstack_memory_whitelist_entry_t *) malloc(sizeof(btstack_memory_whitelist_entry_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_whitelist_entry_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&whitelist_entry_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1471,6 +2018,9 @@ void btstack_memory_whitelist_entry_free(whitelist_entry_t *whitelist_entry){
     btstack_memory_whitelist_entry_t *buffer = (btstack_memory_whitelist_entry_t *)
         ((uint8_t *)whitelist_entry - offsetof(btstack_memory_whitelist_entry_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&whitelist_entry_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1488,16 +2038,29 @@ void btstack_memory_whitelist_entry_free(whitelist_entry_t *whitelist_entry){
 #ifdef MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES
 #if MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES > 0
 static periodic_advertiser_list_entry_t periodic_advertiser_list_entry_storage[MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t periodic_advertiser_list_entry_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES)];
+static btstack_memory_tracked_pool_t periodic_advertiser_list_entry_pool;
+#else
 static btstack_memory_pool_t periodic_advertiser_list_entry_pool;
+#endif
 periodic_advertiser_list_entry_t * btstack_memory_periodic_advertiser_list_entry_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&periodic_advertiser_list_entry_pool);
+#else
     void * buffer = btstack_memory_pool_get(&periodic_advertiser_list_entry_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(periodic_advertiser_list_entry_t));
     }
     return (periodic_advertiser_list_entry_t *) buffer;
 }
 void btstack_memory_periodic_advertiser_list_entry_free(periodic_advertiser_list_entry_t *periodic_advertiser_list_entry){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&periodic_advertiser_list_entry_pool, periodic_advertiser_list_entry);
+#else
     btstack_memory_pool_free(&periodic_advertiser_list_entry_pool, periodic_advertiser_list_entry);
+#endif
 }
 #else
 periodic_advertiser_list_entry_t * btstack_memory_periodic_advertiser_list_entry_get(void){
@@ -1514,11 +2077,18 @@ typedef struct {
     periodic_advertiser_list_entry_t data;
 } btstack_memory_periodic_advertiser_list_entry_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t periodic_advertiser_list_entry_usage;
+#endif
+
 periodic_advertiser_list_entry_t * btstack_memory_periodic_advertiser_list_entry_get(void){
     btstack_memory_periodic_advertiser_list_entry_t * buffer = (btstack_memory_periodic_advertiser_list_entry_t *) malloc(sizeof(btstack_memory_periodic_advertiser_list_entry_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_periodic_advertiser_list_entry_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&periodic_advertiser_list_entry_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1529,6 +2099,9 @@ void btstack_memory_periodic_advertiser_list_entry_free(periodic_advertiser_list
     btstack_memory_periodic_advertiser_list_entry_t *buffer = (btstack_memory_periodic_advertiser_list_entry_t *)
         ((uint8_t *)periodic_advertiser_list_entry - offsetof(btstack_memory_periodic_advertiser_list_entry_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&periodic_advertiser_list_entry_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1549,16 +2122,29 @@ void btstack_memory_periodic_advertiser_list_entry_free(periodic_advertiser_list
 #ifdef MAX_NR_MESH_NETWORK_PDUS
 #if MAX_NR_MESH_NETWORK_PDUS > 0
 static mesh_network_pdu_t mesh_network_pdu_storage[MAX_NR_MESH_NETWORK_PDUS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t mesh_network_pdu_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_MESH_NETWORK_PDUS)];
+static btstack_memory_tracked_pool_t mesh_network_pdu_pool;
+#else
 static btstack_memory_pool_t mesh_network_pdu_pool;
+#endif
 mesh_network_pdu_t * btstack_memory_mesh_network_pdu_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&mesh_network_pdu_pool);
+#else
     void * buffer = btstack_memory_pool_get(&mesh_network_pdu_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(mesh_network_pdu_t));
     }
     return (mesh_network_pdu_t *) buffer;
 }
 void btstack_memory_mesh_network_pdu_free(mesh_network_pdu_t *mesh_network_pdu){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&mesh_network_pdu_pool, mesh_network_pdu);
+#else
     btstack_memory_pool_free(&mesh_network_pdu_pool, mesh_network_pdu);
+#endif
 }
 #else
 mesh_network_pdu_t * btstack_memory_mesh_network_pdu_get(void){
@@ -1575,11 +2161,18 @@ typedef struct {
     mesh_network_pdu_t data;
 } btstack_memory_mesh_network_pdu_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t mesh_network_pdu_usage;
+#endif
+
 mesh_network_pdu_t * btstack_memory_mesh_network_pdu_get(void){
     btstack_memory_mesh_network_pdu_t * buffer = (btstack_memory_mesh_network_pdu_t *) malloc(sizeof(btstack_memory_mesh_network_pdu_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_mesh_network_pdu_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&mesh_network_pdu_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1590,6 +2183,9 @@ void btstack_memory_mesh_network_pdu_free(mesh_network_pdu_t *mesh_network_pdu){
     btstack_memory_mesh_network_pdu_t *buffer = (btstack_memory_mesh_network_pdu_t *)
         ((uint8_t *)mesh_network_pdu - offsetof(btstack_memory_mesh_network_pdu_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&mesh_network_pdu_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1607,16 +2203,29 @@ void btstack_memory_mesh_network_pdu_free(mesh_network_pdu_t *mesh_network_pdu){
 #ifdef MAX_NR_MESH_SEGMENTED_PDUS
 #if MAX_NR_MESH_SEGMENTED_PDUS > 0
 static mesh_segmented_pdu_t mesh_segmented_pdu_storage[MAX_NR_MESH_SEGMENTED_PDUS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t mesh_segmented_pdu_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_MESH_SEGMENTED_PDUS)];
+static btstack_memory_tracked_pool_t mesh_segmented_pdu_pool;
+#else
 static btstack_memory_pool_t mesh_segmented_pdu_pool;
+#endif
 mesh_segmented_pdu_t * btstack_memory_mesh_segmented_pdu_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&mesh_segmented_pdu_pool);
+#else
     void * buffer = btstack_memory_pool_get(&mesh_segmented_pdu_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(mesh_segmented_pdu_t));
     }
     return (mesh_segmented_pdu_t *) buffer;
 }
 void btstack_memory_mesh_segmented_pdu_free(mesh_segmented_pdu_t *mesh_segmented_pdu){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&mesh_segmented_pdu_pool, mesh_segmented_pdu);
+#else
     btstack_memory_pool_free(&mesh_segmented_pdu_pool, mesh_segmented_pdu);
+#endif
 }
 #else
 mesh_segmented_pdu_t * btstack_memory_mesh_segmented_pdu_get(void){
@@ -1633,11 +2242,18 @@ typedef struct {
     mesh_segmented_pdu_t data;
 } btstack_memory_mesh_segmented_pdu_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t mesh_segmented_pdu_usage;
+#endif
+
 mesh_segmented_pdu_t * btstack_memory_mesh_segmented_pdu_get(void){
     btstack_memory_mesh_segmented_pdu_t * buffer = (btstack_memory_mesh_segmented_pdu_t *) malloc(sizeof(btstack_memory_mesh_segmented_pdu_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_mesh_segmented_pdu_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&mesh_segmented_pdu_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1648,6 +2264,9 @@ void btstack_memory_mesh_segmented_pdu_free(mesh_segmented_pdu_t *mesh_segmented
     btstack_memory_mesh_segmented_pdu_t *buffer = (btstack_memory_mesh_segmented_pdu_t *)
         ((uint8_t *)mesh_segmented_pdu - offsetof(btstack_memory_mesh_segmented_pdu_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&mesh_segmented_pdu_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1665,16 +2284,29 @@ void btstack_memory_mesh_segmented_pdu_free(mesh_segmented_pdu_t *mesh_segmented
 #ifdef MAX_NR_MESH_UPPER_TRANSPORT_PDUS
 #if MAX_NR_MESH_UPPER_TRANSPORT_PDUS > 0
 static mesh_upper_transport_pdu_t mesh_upper_transport_pdu_storage[MAX_NR_MESH_UPPER_TRANSPORT_PDUS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t mesh_upper_transport_pdu_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_MESH_UPPER_TRANSPORT_PDUS)];
+static btstack_memory_tracked_pool_t mesh_upper_transport_pdu_pool;
+#else
 static btstack_memory_pool_t mesh_upper_transport_pdu_pool;
+#endif
 mesh_upper_transport_pdu_t * btstack_memory_mesh_upper_transport_pdu_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&mesh_upper_transport_pdu_pool);
+#else
     void * buffer = btstack_memory_pool_get(&mesh_upper_transport_pdu_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(mesh_upper_transport_pdu_t));
     }
     return (mesh_upper_transport_pdu_t *) buffer;
 }
 void btstack_memory_mesh_upper_transport_pdu_free(mesh_upper_transport_pdu_t *mesh_upper_transport_pdu){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&mesh_upper_transport_pdu_pool, mesh_upper_transport_pdu);
+#else
     btstack_memory_pool_free(&mesh_upper_transport_pdu_pool, mesh_upper_transport_pdu);
+#endif
 }
 #else
 mesh_upper_transport_pdu_t * btstack_memory_mesh_upper_transport_pdu_get(void){
@@ -1691,11 +2323,18 @@ typedef struct {
     mesh_upper_transport_pdu_t data;
 } btstack_memory_mesh_upper_transport_pdu_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t mesh_upper_transport_pdu_usage;
+#endif
+
 mesh_upper_transport_pdu_t * btstack_memory_mesh_upper_transport_pdu_get(void){
     btstack_memory_mesh_upper_transport_pdu_t * buffer = (btstack_memory_mesh_upper_transport_pdu_t *) malloc(sizeof(btstack_memory_mesh_upper_transport_pdu_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_mesh_upper_transport_pdu_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&mesh_upper_transport_pdu_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1706,6 +2345,9 @@ void btstack_memory_mesh_upper_transport_pdu_free(mesh_upper_transport_pdu_t *me
     btstack_memory_mesh_upper_transport_pdu_t *buffer = (btstack_memory_mesh_upper_transport_pdu_t *)
         ((uint8_t *)mesh_upper_transport_pdu - offsetof(btstack_memory_mesh_upper_transport_pdu_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&mesh_upper_transport_pdu_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1723,16 +2365,29 @@ void btstack_memory_mesh_upper_transport_pdu_free(mesh_upper_transport_pdu_t *me
 #ifdef MAX_NR_MESH_NETWORK_KEYS
 #if MAX_NR_MESH_NETWORK_KEYS > 0
 static mesh_network_key_t mesh_network_key_storage[MAX_NR_MESH_NETWORK_KEYS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t mesh_network_key_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_MESH_NETWORK_KEYS)];
+static btstack_memory_tracked_pool_t mesh_network_key_pool;
+#else
 static btstack_memory_pool_t mesh_network_key_pool;
+#endif
 mesh_network_key_t * btstack_memory_mesh_network_key_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&mesh_network_key_pool);
+#else
     void * buffer = btstack_memory_pool_get(&mesh_network_key_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(mesh_network_key_t));
     }
     return (mesh_network_key_t *) buffer;
 }
 void btstack_memory_mesh_network_key_free(mesh_network_key_t *mesh_network_key){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&mesh_network_key_pool, mesh_network_key);
+#else
     btstack_memory_pool_free(&mesh_network_key_pool, mesh_network_key);
+#endif
 }
 #else
 mesh_network_key_t * btstack_memory_mesh_network_key_get(void){
@@ -1749,11 +2404,18 @@ typedef struct {
     mesh_network_key_t data;
 } btstack_memory_mesh_network_key_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t mesh_network_key_usage;
+#endif
+
 mesh_network_key_t * btstack_memory_mesh_network_key_get(void){
     btstack_memory_mesh_network_key_t * buffer = (btstack_memory_mesh_network_key_t *) malloc(sizeof(btstack_memory_mesh_network_key_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_mesh_network_key_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&mesh_network_key_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1764,6 +2426,9 @@ void btstack_memory_mesh_network_key_free(mesh_network_key_t *mesh_network_key){
     btstack_memory_mesh_network_key_t *buffer = (btstack_memory_mesh_network_key_t *)
         ((uint8_t *)mesh_network_key - offsetof(btstack_memory_mesh_network_key_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&mesh_network_key_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1781,16 +2446,29 @@ void btstack_memory_mesh_network_key_free(mesh_network_key_t *mesh_network_key){
 #ifdef MAX_NR_MESH_TRANSPORT_KEYS
 #if MAX_NR_MESH_TRANSPORT_KEYS > 0
 static mesh_transport_key_t mesh_transport_key_storage[MAX_NR_MESH_TRANSPORT_KEYS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t mesh_transport_key_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_MESH_TRANSPORT_KEYS)];
+static btstack_memory_tracked_pool_t mesh_transport_key_pool;
+#else
 static btstack_memory_pool_t mesh_transport_key_pool;
+#endif
 mesh_transport_key_t * btstack_memory_mesh_transport_key_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&mesh_transport_key_pool);
+#else
     void * buffer = btstack_memory_pool_get(&mesh_transport_key_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(mesh_transport_key_t));
     }
     return (mesh_transport_key_t *) buffer;
 }
 void btstack_memory_mesh_transport_key_free(mesh_transport_key_t *mesh_transport_key){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&mesh_transport_key_pool, mesh_transport_key);
+#else
     btstack_memory_pool_free(&mesh_transport_key_pool, mesh_transport_key);
+#endif
 }
 #else
 mesh_transport_key_t * btstack_memory_mesh_transport_key_get(void){
@@ -1807,11 +2485,18 @@ typedef struct {
     mesh_transport_key_t data;
 } btstack_memory_mesh_transport_key_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t mesh_transport_key_usage;
+#endif
+
 mesh_transport_key_t * btstack_memory_mesh_transport_key_get(void){
     btstack_memory_mesh_transport_key_t * buffer = (btstack_memory_mesh_transport_key_t *) malloc(sizeof(btstack_memory_mesh_transport_key_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_mesh_transport_key_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&mesh_transport_key_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1822,6 +2507,9 @@ void btstack_memory_mesh_transport_key_free(mesh_transport_key_t *mesh_transport
     btstack_memory_mesh_transport_key_t *buffer = (btstack_memory_mesh_transport_key_t *)
         ((uint8_t *)mesh_transport_key - offsetof(btstack_memory_mesh_transport_key_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&mesh_transport_key_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1839,16 +2527,29 @@ void btstack_memory_mesh_transport_key_free(mesh_transport_key_t *mesh_transport
 #ifdef MAX_NR_MESH_VIRTUAL_ADDRESSS
 #if MAX_NR_MESH_VIRTUAL_ADDRESSS > 0
 static mesh_virtual_address_t mesh_virtual_address_storage[MAX_NR_MESH_VIRTUAL_ADDRESSS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t mesh_virtual_address_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_MESH_VIRTUAL_ADDRESSS)];
+static btstack_memory_tracked_pool_t mesh_virtual_address_pool;
+#else
 static btstack_memory_pool_t mesh_virtual_address_pool;
+#endif
 mesh_virtual_address_t * btstack_memory_mesh_virtual_address_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&mesh_virtual_address_pool);
+#else
     void * buffer = btstack_memory_pool_get(&mesh_virtual_address_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(mesh_virtual_address_t));
     }
     return (mesh_virtual_address_t *) buffer;
 }
 void btstack_memory_mesh_virtual_address_free(mesh_virtual_address_t *mesh_virtual_address){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&mesh_virtual_address_pool, mesh_virtual_address);
+#else
     btstack_memory_pool_free(&mesh_virtual_address_pool, mesh_virtual_address);
+#endif
 }
 #else
 mesh_virtual_address_t * btstack_memory_mesh_virtual_address_get(void){
@@ -1865,11 +2566,18 @@ typedef struct {
     mesh_virtual_address_t data;
 } btstack_memory_mesh_virtual_address_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t mesh_virtual_address_usage;
+#endif
+
 mesh_virtual_address_t * btstack_memory_mesh_virtual_address_get(void){
     btstack_memory_mesh_virtual_address_t * buffer = (btstack_memory_mesh_virtual_address_t *) malloc(sizeof(btstack_memory_mesh_virtual_address_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_mesh_virtual_address_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&mesh_virtual_address_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1880,6 +2588,9 @@ void btstack_memory_mesh_virtual_address_free(mesh_virtual_address_t *mesh_virtu
     btstack_memory_mesh_virtual_address_t *buffer = (btstack_memory_mesh_virtual_address_t *)
         ((uint8_t *)mesh_virtual_address - offsetof(btstack_memory_mesh_virtual_address_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&mesh_virtual_address_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1897,16 +2608,29 @@ void btstack_memory_mesh_virtual_address_free(mesh_virtual_address_t *mesh_virtu
 #ifdef MAX_NR_MESH_SUBNETS
 #if MAX_NR_MESH_SUBNETS > 0
 static mesh_subnet_t mesh_subnet_storage[MAX_NR_MESH_SUBNETS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t mesh_subnet_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_MESH_SUBNETS)];
+static btstack_memory_tracked_pool_t mesh_subnet_pool;
+#else
 static btstack_memory_pool_t mesh_subnet_pool;
+#endif
 mesh_subnet_t * btstack_memory_mesh_subnet_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&mesh_subnet_pool);
+#else
     void * buffer = btstack_memory_pool_get(&mesh_subnet_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(mesh_subnet_t));
     }
     return (mesh_subnet_t *) buffer;
 }
 void btstack_memory_mesh_subnet_free(mesh_subnet_t *mesh_subnet){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&mesh_subnet_pool, mesh_subnet);
+#else
     btstack_memory_pool_free(&mesh_subnet_pool, mesh_subnet);
+#endif
 }
 #else
 mesh_subnet_t * btstack_memory_mesh_subnet_get(void){
@@ -1923,11 +2647,18 @@ typedef struct {
     mesh_subnet_t data;
 } btstack_memory_mesh_subnet_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t mesh_subnet_usage;
+#endif
+
 mesh_subnet_t * btstack_memory_mesh_subnet_get(void){
     btstack_memory_mesh_subnet_t * buffer = (btstack_memory_mesh_subnet_t *) malloc(sizeof(btstack_memory_mesh_subnet_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_mesh_subnet_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&mesh_subnet_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1938,6 +2669,9 @@ void btstack_memory_mesh_subnet_free(mesh_subnet_t *mesh_subnet){
     btstack_memory_mesh_subnet_t *buffer = (btstack_memory_mesh_subnet_t *)
         ((uint8_t *)mesh_subnet - offsetof(btstack_memory_mesh_subnet_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&mesh_subnet_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -1958,16 +2692,29 @@ void btstack_memory_mesh_subnet_free(mesh_subnet_t *mesh_subnet){
 #ifdef MAX_NR_HCI_ISO_STREAMS
 #if MAX_NR_HCI_ISO_STREAMS > 0
 static hci_iso_stream_t hci_iso_stream_storage[MAX_NR_HCI_ISO_STREAMS];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t hci_iso_stream_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_HCI_ISO_STREAMS)];
+static btstack_memory_tracked_pool_t hci_iso_stream_pool;
+#else
 static btstack_memory_pool_t hci_iso_stream_pool;
+#endif
 hci_iso_stream_t * btstack_memory_hci_iso_stream_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&hci_iso_stream_pool);
+#else
     void * buffer = btstack_memory_pool_get(&hci_iso_stream_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(hci_iso_stream_t));
     }
     return (hci_iso_stream_t *) buffer;
 }
 void btstack_memory_hci_iso_stream_free(hci_iso_stream_t *hci_iso_stream){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&hci_iso_stream_pool, hci_iso_stream);
+#else
     btstack_memory_pool_free(&hci_iso_stream_pool, hci_iso_stream);
+#endif
 }
 #else
 hci_iso_stream_t * btstack_memory_hci_iso_stream_get(void){
@@ -1984,11 +2731,18 @@ typedef struct {
     hci_iso_stream_t data;
 } btstack_memory_hci_iso_stream_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t hci_iso_stream_usage;
+#endif
+
 hci_iso_stream_t * btstack_memory_hci_iso_stream_get(void){
     btstack_memory_hci_iso_stream_t * buffer = (btstack_memory_hci_iso_stream_t *) malloc(sizeof(btstack_memory_hci_iso_stream_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_hci_iso_stream_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&hci_iso_stream_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -1999,6 +2753,93 @@ void btstack_memory_hci_iso_stream_free(hci_iso_stream_t *hci_iso_stream){
     btstack_memory_hci_iso_stream_t *buffer = (btstack_memory_hci_iso_stream_t *)
         ((uint8_t *)hci_iso_stream - offsetof(btstack_memory_hci_iso_stream_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&hci_iso_stream_usage);
+#endif
+    free(buffer);
+}
+#endif
+
+
+#endif
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+
+// MARK: gatt_client_discovery_cache_t
+#if !defined(HAVE_MALLOC) && !defined(MAX_NR_GATT_CLIENT_DISCOVERY_CACHES)
+    #if defined(MAX_NO_GATT_CLIENT_DISCOVERY_CACHES)
+        #error "Deprecated MAX_NO_GATT_CLIENT_DISCOVERY_CACHES defined instead of MAX_NR_GATT_CLIENT_DISCOVERY_CACHES. Please update your btstack_config.h to use MAX_NR_GATT_CLIENT_DISCOVERY_CACHES."
+    #else
+        #define MAX_NR_GATT_CLIENT_DISCOVERY_CACHES 0
+    #endif
+#endif
+
+#ifdef MAX_NR_GATT_CLIENT_DISCOVERY_CACHES
+#if MAX_NR_GATT_CLIENT_DISCOVERY_CACHES > 0
+static gatt_client_discovery_cache_t gatt_client_discovery_cache_storage[MAX_NR_GATT_CLIENT_DISCOVERY_CACHES];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t gatt_client_discovery_cache_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NR_GATT_CLIENT_DISCOVERY_CACHES)];
+static btstack_memory_tracked_pool_t gatt_client_discovery_cache_pool;
+#else
+static btstack_memory_pool_t gatt_client_discovery_cache_pool;
+#endif
+gatt_client_discovery_cache_t * btstack_memory_gatt_client_discovery_cache_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&gatt_client_discovery_cache_pool);
+#else
+    void * buffer = btstack_memory_pool_get(&gatt_client_discovery_cache_pool);
+#endif
+    if (buffer){
+        memset(buffer, 0, sizeof(gatt_client_discovery_cache_t));
+    }
+    return (gatt_client_discovery_cache_t *) buffer;
+}
+void btstack_memory_gatt_client_discovery_cache_free(gatt_client_discovery_cache_t *gatt_client_discovery_cache){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&gatt_client_discovery_cache_pool, gatt_client_discovery_cache);
+#else
+    btstack_memory_pool_free(&gatt_client_discovery_cache_pool, gatt_client_discovery_cache);
+#endif
+}
+#else
+gatt_client_discovery_cache_t * btstack_memory_gatt_client_discovery_cache_get(void){
+    return NULL;
+}
+void btstack_memory_gatt_client_discovery_cache_free(gatt_client_discovery_cache_t *gatt_client_discovery_cache){
+    UNUSED(gatt_client_discovery_cache);
+}
+#endif
+#elif defined(HAVE_MALLOC)
+
+typedef struct {
+    btstack_memory_buffer_t tracking;
+    gatt_client_discovery_cache_t data;
+} btstack_memory_gatt_client_discovery_cache_t;
+
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t gatt_client_discovery_cache_usage;
+#endif
+
+gatt_client_discovery_cache_t * btstack_memory_gatt_client_discovery_cache_get(void){
+    btstack_memory_gatt_client_discovery_cache_t * buffer = (btstack_memory_gatt_client_discovery_cache_t *) malloc(sizeof(btstack_memory_gatt_client_discovery_cache_t));
+    if (buffer){
+        memset(buffer, 0, sizeof(btstack_memory_gatt_client_discovery_cache_t));
+        btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&gatt_client_discovery_cache_usage);
+#endif
+        return &buffer->data;
+    } else {
+        return NULL;
+    }
+}
+void btstack_memory_gatt_client_discovery_cache_free(gatt_client_discovery_cache_t *gatt_client_discovery_cache){
+    // reconstruct buffer start
+    btstack_memory_gatt_client_discovery_cache_t *buffer = (btstack_memory_gatt_client_discovery_cache_t *)
+        ((uint8_t *)gatt_client_discovery_cache - offsetof(btstack_memory_gatt_client_discovery_cache_t, data));
+    btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&gatt_client_discovery_cache_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -2014,123 +2855,823 @@ void btstack_memory_init(void){
 #endif
   
 #if MAX_NR_HCI_CONNECTIONS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&hci_connection_pool, hci_connection_storage, MAX_NR_HCI_CONNECTIONS, sizeof(hci_connection_t), hci_connection_bitmap);
+#else
     btstack_memory_pool_create(&hci_connection_pool, hci_connection_storage, MAX_NR_HCI_CONNECTIONS, sizeof(hci_connection_t));
 #endif
+#endif
 
 #if MAX_NR_L2CAP_SERVICES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&l2cap_service_pool, l2cap_service_storage, MAX_NR_L2CAP_SERVICES, sizeof(l2cap_service_t), l2cap_service_bitmap);
+#else
     btstack_memory_pool_create(&l2cap_service_pool, l2cap_service_storage, MAX_NR_L2CAP_SERVICES, sizeof(l2cap_service_t));
 #endif
+#endif
 #if MAX_NR_L2CAP_CHANNELS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&l2cap_channel_pool, l2cap_channel_storage, MAX_NR_L2CAP_CHANNELS, sizeof(l2cap_channel_t), l2cap_channel_bitmap);
+#else
     btstack_memory_pool_create(&l2cap_channel_pool, l2cap_channel_storage, MAX_NR_L2CAP_CHANNELS, sizeof(l2cap_channel_t));
 #endif
+#endif
 
 #ifdef ENABLE_CLASSIC
 #if MAX_NR_RFCOMM_MULTIPLEXERS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&rfcomm_multiplexer_pool, rfcomm_multiplexer_storage, MAX_NR_RFCOMM_MULTIPLEXERS, sizeof(rfcomm_multiplexer_t), rfcomm_multiplexer_bitmap);
+#else
     btstack_memory_pool_create(&rfcomm_multiplexer_pool, rfcomm_multiplexer_storage, MAX_NR_RFCOMM_MULTIPLEXERS, sizeof(rfcomm_multiplexer_t));
 #endif
+#endif
 #if MAX_NR_RFCOMM_SERVICES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&rfcomm_service_pool, rfcomm_service_storage, MAX_NR_RFCOMM_SERVICES, sizeof(rfcomm_service_t), rfcomm_service_bitmap);
+#else
     btstack_memory_pool_create(&rfcomm_service_pool, rfcomm_service_storage, MAX_NR_RFCOMM_SERVICES, sizeof(rfcomm_service_t));
 #endif
+#endif
 #if MAX_NR_RFCOMM_CHANNELS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&rfcomm_channel_pool, rfcomm_channel_storage, MAX_NR_RFCOMM_CHANNELS, sizeof(rfcomm_channel_t), rfcomm_channel_bitmap);
+#else
     btstack_memory_pool_create(&rfcomm_channel_pool, rfcomm_channel_storage, MAX_NR_RFCOMM_CHANNELS, sizeof(rfcomm_channel_t));
 #endif
+#endif
 
 #if MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&btstack_link_key_db_memory_entry_pool, btstack_link_key_db_memory_entry_storage, MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES, sizeof(btstack_link_key_db_memory_entry_t), btstack_link_key_db_memory_entry_bitmap);
+#else
     btstack_memory_pool_create(&btstack_link_key_db_memory_entry_pool, btstack_link_key_db_memory_entry_storage, MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES, sizeof(btstack_link_key_db_memory_entry_t));
 #endif
+#endif
 
 #if MAX_NR_BNEP_SERVICES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&bnep_service_pool, bnep_service_storage, MAX_NR_BNEP_SERVICES, sizeof(bnep_service_t), bnep_service_bitmap);
+#else
     btstack_memory_pool_create(&bnep_service_pool, bnep_service_storage, MAX_NR_BNEP_SERVICES, sizeof(bnep_service_t));
 #endif
+#endif
 #if MAX_NR_BNEP_CHANNELS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&bnep_channel_pool, bnep_channel_storage, MAX_NR_BNEP_CHANNELS, sizeof(bnep_channel_t), bnep_channel_bitmap);
+#else
     btstack_memory_pool_create(&bnep_channel_pool, bnep_channel_storage, MAX_NR_BNEP_CHANNELS, sizeof(bnep_channel_t));
 #endif
+#endif
 
 #if MAX_NR_GOEP_SERVER_SERVICES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&goep_server_service_pool, goep_server_service_storage, MAX_NR_GOEP_SERVER_SERVICES, sizeof(goep_server_service_t), goep_server_service_bitmap);
+#else
     btstack_memory_pool_create(&goep_server_service_pool, goep_server_service_storage, MAX_NR_GOEP_SERVER_SERVICES, sizeof(goep_server_service_t));
 #endif
+#endif
 #if MAX_NR_GOEP_SERVER_CONNECTIONS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&goep_server_connection_pool, goep_server_connection_storage, MAX_NR_GOEP_SERVER_CONNECTIONS, sizeof(goep_server_connection_t), goep_server_connection_bitmap);
+#else
     btstack_memory_pool_create(&goep_server_connection_pool, goep_server_connection_storage, MAX_NR_GOEP_SERVER_CONNECTIONS, sizeof(goep_server_connection_t));
 #endif
+#endif
 
 #if MAX_NR_HFP_CONNECTIONS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&hfp_connection_pool, hfp_connection_storage, MAX_NR_HFP_CONNECTIONS, sizeof(hfp_connection_t), hfp_connection_bitmap);
+#else
     btstack_memory_pool_create(&hfp_connection_pool, hfp_connection_storage, MAX_NR_HFP_CONNECTIONS, sizeof(hfp_connection_t));
 #endif
+#endif
 
 #if MAX_NR_HID_HOST_CONNECTIONS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&hid_host_connection_pool, hid_host_connection_storage, MAX_NR_HID_HOST_CONNECTIONS, sizeof(hid_host_connection_t), hid_host_connection_bitmap);
+#else
     btstack_memory_pool_create(&hid_host_connection_pool, hid_host_connection_storage, MAX_NR_HID_HOST_CONNECTIONS, sizeof(hid_host_connection_t));
 #endif
+#endif
 
 #if MAX_NR_SERVICE_RECORD_ITEMS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&service_record_item_pool, service_record_item_storage, MAX_NR_SERVICE_RECORD_ITEMS, sizeof(service_record_item_t), service_record_item_bitmap);
+#else
     btstack_memory_pool_create(&service_record_item_pool, service_record_item_storage, MAX_NR_SERVICE_RECORD_ITEMS, sizeof(service_record_item_t));
 #endif
+#endif
 
 #if MAX_NR_AVDTP_STREAM_ENDPOINTS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&avdtp_stream_endpoint_pool, avdtp_stream_endpoint_storage, MAX_NR_AVDTP_STREAM_ENDPOINTS, sizeof(avdtp_stream_endpoint_t), avdtp_stream_endpoint_bitmap);
+#else
     btstack_memory_pool_create(&avdtp_stream_endpoint_pool, avdtp_stream_endpoint_storage, MAX_NR_AVDTP_STREAM_ENDPOINTS, sizeof(avdtp_stream_endpoint_t));
 #endif
+#endif
 
 #if MAX_NR_AVDTP_CONNECTIONS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&avdtp_connection_pool, avdtp_connection_storage, MAX_NR_AVDTP_CONNECTIONS, sizeof(avdtp_connection_t), avdtp_connection_bitmap);
+#else
     btstack_memory_pool_create(&avdtp_connection_pool, avdtp_connection_storage, MAX_NR_AVDTP_CONNECTIONS, sizeof(avdtp_connection_t));
 #endif
+#endif
 
 #if MAX_NR_AVRCP_CONNECTIONS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&avrcp_connection_pool, avrcp_connection_storage, MAX_NR_AVRCP_CONNECTIONS, sizeof(avrcp_connection_t), avrcp_connection_bitmap);
+#else
     btstack_memory_pool_create(&avrcp_connection_pool, avrcp_connection_storage, MAX_NR_AVRCP_CONNECTIONS, sizeof(avrcp_connection_t));
 #endif
+#endif
 
 #if MAX_NR_AVRCP_BROWSING_CONNECTIONS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&avrcp_browsing_connection_pool, avrcp_browsing_connection_storage, MAX_NR_AVRCP_BROWSING_CONNECTIONS, sizeof(avrcp_browsing_connection_t), avrcp_browsing_connection_bitmap);
+#else
     btstack_memory_pool_create(&avrcp_browsing_connection_pool, avrcp_browsing_connection_storage, MAX_NR_AVRCP_BROWSING_CONNECTIONS, sizeof(avrcp_browsing_connection_t));
 #endif
+#endif
 
 #endif
 #ifdef ENABLE_BLE
 #if MAX_NR_BATTERY_SERVICE_CLIENTS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&battery_service_client_pool, battery_service_client_storage, MAX_NR_BATTERY_SERVICE_CLIENTS, sizeof(battery_service_client_t), battery_service_client_bitmap);
+#else
     btstack_memory_pool_create(&battery_service_client_pool, battery_service_client_storage, MAX_NR_BATTERY_SERVICE_CLIENTS, sizeof(battery_service_client_t));
 #endif
+#endif
 #if MAX_NR_GATT_CLIENTS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&gatt_client_pool, gatt_client_storage, MAX_NR_GATT_CLIENTS, sizeof(gatt_client_t), gatt_client_bitmap);
+#else
     btstack_memory_pool_create(&gatt_client_pool, gatt_client_storage, MAX_NR_GATT_CLIENTS, sizeof(gatt_client_t));
 #endif
+#endif
 #if MAX_NR_HIDS_HOSTS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&hids_host_pool, hids_host_storage, MAX_NR_HIDS_HOSTS, sizeof(hids_host_t), hids_host_bitmap);
+#else
     btstack_memory_pool_create(&hids_host_pool, hids_host_storage, MAX_NR_HIDS_HOSTS, sizeof(hids_host_t));
 #endif
+#endif
 #if MAX_NR_SM_LOOKUP_ENTRIES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&sm_lookup_entry_pool, sm_lookup_entry_storage, MAX_NR_SM_LOOKUP_ENTRIES, sizeof(sm_lookup_entry_t), sm_lookup_entry_bitmap);
+#else
     btstack_memory_pool_create(&sm_lookup_entry_pool, sm_lookup_entry_storage, MAX_NR_SM_LOOKUP_ENTRIES, sizeof(sm_lookup_entry_t));
 #endif
+#endif
 #if MAX_NR_WHITELIST_ENTRIES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&whitelist_entry_pool, whitelist_entry_storage, MAX_NR_WHITELIST_ENTRIES, sizeof(whitelist_entry_t), whitelist_entry_bitmap);
+#else
     btstack_memory_pool_create(&whitelist_entry_pool, whitelist_entry_storage, MAX_NR_WHITELIST_ENTRIES, sizeof(whitelist_entry_t));
 #endif
+#endif
 #if MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&periodic_advertiser_list_entry_pool, periodic_advertiser_list_entry_storage, MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES, sizeof(periodic_advertiser_list_entry_t), periodic_advertiser_list_entry_bitmap);
+#else
     btstack_memory_pool_create(&periodic_advertiser_list_entry_pool, periodic_advertiser_list_entry_storage, MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES, sizeof(periodic_advertiser_list_entry_t));
 #endif
+#endif
 
 #endif
 #ifdef ENABLE_MESH
 #if MAX_NR_MESH_NETWORK_PDUS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&mesh_network_pdu_pool, mesh_network_pdu_storage, MAX_NR_MESH_NETWORK_PDUS, sizeof(mesh_network_pdu_t), mesh_network_pdu_bitmap);
+#else
     btstack_memory_pool_create(&mesh_network_pdu_pool, mesh_network_pdu_storage, MAX_NR_MESH_NETWORK_PDUS, sizeof(mesh_network_pdu_t));
 #endif
+#endif
 #if MAX_NR_MESH_SEGMENTED_PDUS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&mesh_segmented_pdu_pool, mesh_segmented_pdu_storage, MAX_NR_MESH_SEGMENTED_PDUS, sizeof(mesh_segmented_pdu_t), mesh_segmented_pdu_bitmap);
+#else
     btstack_memory_pool_create(&mesh_segmented_pdu_pool, mesh_segmented_pdu_storage, MAX_NR_MESH_SEGMENTED_PDUS, sizeof(mesh_segmented_pdu_t));
 #endif
+#endif
 #if MAX_NR_MESH_UPPER_TRANSPORT_PDUS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&mesh_upper_transport_pdu_pool, mesh_upper_transport_pdu_storage, MAX_NR_MESH_UPPER_TRANSPORT_PDUS, sizeof(mesh_upper_transport_pdu_t), mesh_upper_transport_pdu_bitmap);
+#else
     btstack_memory_pool_create(&mesh_upper_transport_pdu_pool, mesh_upper_transport_pdu_storage, MAX_NR_MESH_UPPER_TRANSPORT_PDUS, sizeof(mesh_upper_transport_pdu_t));
 #endif
+#endif
 #if MAX_NR_MESH_NETWORK_KEYS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&mesh_network_key_pool, mesh_network_key_storage, MAX_NR_MESH_NETWORK_KEYS, sizeof(mesh_network_key_t), mesh_network_key_bitmap);
+#else
     btstack_memory_pool_create(&mesh_network_key_pool, mesh_network_key_storage, MAX_NR_MESH_NETWORK_KEYS, sizeof(mesh_network_key_t));
 #endif
+#endif
 #if MAX_NR_MESH_TRANSPORT_KEYS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&mesh_transport_key_pool, mesh_transport_key_storage, MAX_NR_MESH_TRANSPORT_KEYS, sizeof(mesh_transport_key_t), mesh_transport_key_bitmap);
+#else
     btstack_memory_pool_create(&mesh_transport_key_pool, mesh_transport_key_storage, MAX_NR_MESH_TRANSPORT_KEYS, sizeof(mesh_transport_key_t));
 #endif
+#endif
 #if MAX_NR_MESH_VIRTUAL_ADDRESSS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&mesh_virtual_address_pool, mesh_virtual_address_storage, MAX_NR_MESH_VIRTUAL_ADDRESSS, sizeof(mesh_virtual_address_t), mesh_virtual_address_bitmap);
+#else
     btstack_memory_pool_create(&mesh_virtual_address_pool, mesh_virtual_address_storage, MAX_NR_MESH_VIRTUAL_ADDRESSS, sizeof(mesh_virtual_address_t));
 #endif
+#endif
 #if MAX_NR_MESH_SUBNETS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&mesh_subnet_pool, mesh_subnet_storage, MAX_NR_MESH_SUBNETS, sizeof(mesh_subnet_t), mesh_subnet_bitmap);
+#else
     btstack_memory_pool_create(&mesh_subnet_pool, mesh_subnet_storage, MAX_NR_MESH_SUBNETS, sizeof(mesh_subnet_t));
 #endif
+#endif
 
 #endif
 #ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
 #if MAX_NR_HCI_ISO_STREAMS > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&hci_iso_stream_pool, hci_iso_stream_storage, MAX_NR_HCI_ISO_STREAMS, sizeof(hci_iso_stream_t), hci_iso_stream_bitmap);
+#else
     btstack_memory_pool_create(&hci_iso_stream_pool, hci_iso_stream_storage, MAX_NR_HCI_ISO_STREAMS, sizeof(hci_iso_stream_t));
 #endif
+#endif
+
+#endif
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+#if MAX_NR_GATT_CLIENT_DISCOVERY_CACHES > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&gatt_client_discovery_cache_pool, gatt_client_discovery_cache_storage, MAX_NR_GATT_CLIENT_DISCOVERY_CACHES, sizeof(gatt_client_discovery_cache_t), gatt_client_discovery_cache_bitmap);
+#else
+    btstack_memory_pool_create(&gatt_client_discovery_cache_pool, gatt_client_discovery_cache_storage, MAX_NR_GATT_CLIENT_DISCOVERY_CACHES, sizeof(gatt_client_discovery_cache_t));
+#endif
+#endif
 
 #endif
 }
+
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+// btstack_memory_log_stats is only used for pools with storage or malloc
+#ifdef MAX_NR_HCI_CONNECTIONS
+#if MAX_NR_HCI_CONNECTIONS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_L2CAP_SERVICES
+#if MAX_NR_L2CAP_SERVICES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_L2CAP_CHANNELS
+#if MAX_NR_L2CAP_CHANNELS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef ENABLE_CLASSIC
+#ifdef MAX_NR_RFCOMM_MULTIPLEXERS
+#if MAX_NR_RFCOMM_MULTIPLEXERS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_RFCOMM_SERVICES
+#if MAX_NR_RFCOMM_SERVICES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_RFCOMM_CHANNELS
+#if MAX_NR_RFCOMM_CHANNELS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES
+#if MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_BNEP_SERVICES
+#if MAX_NR_BNEP_SERVICES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_BNEP_CHANNELS
+#if MAX_NR_BNEP_CHANNELS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_GOEP_SERVER_SERVICES
+#if MAX_NR_GOEP_SERVER_SERVICES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_GOEP_SERVER_CONNECTIONS
+#if MAX_NR_GOEP_SERVER_CONNECTIONS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_HFP_CONNECTIONS
+#if MAX_NR_HFP_CONNECTIONS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_HID_HOST_CONNECTIONS
+#if MAX_NR_HID_HOST_CONNECTIONS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_SERVICE_RECORD_ITEMS
+#if MAX_NR_SERVICE_RECORD_ITEMS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_AVDTP_STREAM_ENDPOINTS
+#if MAX_NR_AVDTP_STREAM_ENDPOINTS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_AVDTP_CONNECTIONS
+#if MAX_NR_AVDTP_CONNECTIONS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_AVRCP_CONNECTIONS
+#if MAX_NR_AVRCP_CONNECTIONS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#ifdef MAX_NR_AVRCP_BROWSING_CONNECTIONS
+#if MAX_NR_AVRCP_BROWSING_CONNECTIONS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#endif
+#ifdef ENABLE_BLE
+#ifdef MAX_NR_BATTERY_SERVICE_CLIENTS
+#if MAX_NR_BATTERY_SERVICE_CLIENTS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_GATT_CLIENTS
+#if MAX_NR_GATT_CLIENTS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_HIDS_HOSTS
+#if MAX_NR_HIDS_HOSTS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_SM_LOOKUP_ENTRIES
+#if MAX_NR_SM_LOOKUP_ENTRIES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_WHITELIST_ENTRIES
+#if MAX_NR_WHITELIST_ENTRIES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES
+#if MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#endif
+#ifdef ENABLE_MESH
+#ifdef MAX_NR_MESH_NETWORK_PDUS
+#if MAX_NR_MESH_NETWORK_PDUS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_MESH_SEGMENTED_PDUS
+#if MAX_NR_MESH_SEGMENTED_PDUS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_MESH_UPPER_TRANSPORT_PDUS
+#if MAX_NR_MESH_UPPER_TRANSPORT_PDUS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_MESH_NETWORK_KEYS
+#if MAX_NR_MESH_NETWORK_KEYS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_MESH_TRANSPORT_KEYS
+#if MAX_NR_MESH_TRANSPORT_KEYS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_MESH_VIRTUAL_ADDRESSS
+#if MAX_NR_MESH_VIRTUAL_ADDRESSS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#ifdef MAX_NR_MESH_SUBNETS
+#if MAX_NR_MESH_SUBNETS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#endif
+#ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
+#ifdef MAX_NR_HCI_ISO_STREAMS
+#if MAX_NR_HCI_ISO_STREAMS > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#endif
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+#ifdef MAX_NR_GATT_CLIENT_DISCOVERY_CACHES
+#if MAX_NR_GATT_CLIENT_DISCOVERY_CACHES > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+
+#endif
+
+#ifdef BTSTACK_MEMORY_LOG_STATS_USED
+static void btstack_memory_log_stats(const char * name, uint16_t num_in_use, uint16_t max_in_use, uint16_t count){
+    log_info("%-32s in use %3u, max %3u, pool size %3u", name, num_in_use, max_in_use, count);
+}
+#endif
+
+void btstack_memory_dump_stats(void){
+#ifdef MAX_NR_HCI_CONNECTIONS
+#if MAX_NR_HCI_CONNECTIONS > 0
+    btstack_memory_log_stats("hci_connection", btstack_memory_tracked_pool_num_in_use(&hci_connection_pool),
+                             btstack_memory_tracked_pool_max_in_use(&hci_connection_pool), MAX_NR_HCI_CONNECTIONS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("hci_connection", hci_connection_usage.num_in_use, hci_connection_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_L2CAP_SERVICES
+#if MAX_NR_L2CAP_SERVICES > 0
+    btstack_memory_log_stats("l2cap_service", btstack_memory_tracked_pool_num_in_use(&l2cap_service_pool),
+                             btstack_memory_tracked_pool_max_in_use(&l2cap_service_pool), MAX_NR_L2CAP_SERVICES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("l2cap_service", l2cap_service_usage.num_in_use, l2cap_service_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_L2CAP_CHANNELS
+#if MAX_NR_L2CAP_CHANNELS > 0
+    btstack_memory_log_stats("l2cap_channel", btstack_memory_tracked_pool_num_in_use(&l2cap_channel_pool),
+                             btstack_memory_tracked_pool_max_in_use(&l2cap_channel_pool), MAX_NR_L2CAP_CHANNELS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("l2cap_channel", l2cap_channel_usage.num_in_use, l2cap_channel_usage.max_in_use, 0);
+#endif
+
+#ifdef ENABLE_CLASSIC
+#ifdef MAX_NR_RFCOMM_MULTIPLEXERS
+#if MAX_NR_RFCOMM_MULTIPLEXERS > 0
+    btstack_memory_log_stats("rfcomm_multiplexer", btstack_memory_tracked_pool_num_in_use(&rfcomm_multiplexer_pool),
+                             btstack_memory_tracked_pool_max_in_use(&rfcomm_multiplexer_pool), MAX_NR_RFCOMM_MULTIPLEXERS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("rfcomm_multiplexer", rfcomm_multiplexer_usage.num_in_use, rfcomm_multiplexer_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_RFCOMM_SERVICES
+#if MAX_NR_RFCOMM_SERVICES > 0
+    btstack_memory_log_stats("rfcomm_service", btstack_memory_tracked_pool_num_in_use(&rfcomm_service_pool),
+                             btstack_memory_tracked_pool_max_in_use(&rfcomm_service_pool), MAX_NR_RFCOMM_SERVICES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("rfcomm_service", rfcomm_service_usage.num_in_use, rfcomm_service_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_RFCOMM_CHANNELS
+#if MAX_NR_RFCOMM_CHANNELS > 0
+    btstack_memory_log_stats("rfcomm_channel", btstack_memory_tracked_pool_num_in_use(&rfcomm_channel_pool),
+                             btstack_memory_tracked_pool_max_in_use(&rfcomm_channel_pool), MAX_NR_RFCOMM_CHANNELS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("rfcomm_channel", rfcomm_channel_usage.num_in_use, rfcomm_channel_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES
+#if MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES > 0
+    btstack_memory_log_stats("btstack_link_key_db_memory_entry", btstack_memory_tracked_pool_num_in_use(&btstack_link_key_db_memory_entry_pool),
+                             btstack_memory_tracked_pool_max_in_use(&btstack_link_key_db_memory_entry_pool), MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("btstack_link_key_db_memory_entry", btstack_link_key_db_memory_entry_usage.num_in_use, btstack_link_key_db_memory_entry_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_BNEP_SERVICES
+#if MAX_NR_BNEP_SERVICES > 0
+    btstack_memory_log_stats("bnep_service", btstack_memory_tracked_pool_num_in_use(&bnep_service_pool),
+                             btstack_memory_tracked_pool_max_in_use(&bnep_service_pool), MAX_NR_BNEP_SERVICES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("bnep_service", bnep_service_usage.num_in_use, bnep_service_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_BNEP_CHANNELS
+#if MAX_NR_BNEP_CHANNELS > 0
+    btstack_memory_log_stats("bnep_channel", btstack_memory_tracked_pool_num_in_use(&bnep_channel_pool),
+                             btstack_memory_tracked_pool_max_in_use(&bnep_channel_pool), MAX_NR_BNEP_CHANNELS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("bnep_channel", bnep_channel_usage.num_in_use, bnep_channel_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_GOEP_SERVER_SERVICES
+#if MAX_NR_GOEP_SERVER_SERVICES > 0
+    btstack_memory_log_stats("goep_server_service", btstack_memory_tracked_pool_num_in_use(&goep_server_service_pool),
+                             btstack_memory_tracked_pool_max_in_use(&goep_server_service_pool), MAX_NR_GOEP_SERVER_SERVICES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("goep_server_service", goep_server_service_usage.num_in_use, goep_server_service_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_GOEP_SERVER_CONNECTIONS
+#if MAX_NR_GOEP_SERVER_CONNECTIONS > 0
+    btstack_memory_log_stats("goep_server_connection", btstack_memory_tracked_pool_num_in_use(&goep_server_connection_pool),
+                             btstack_memory_tracked_pool_max_in_use(&goep_server_connection_pool), MAX_NR_GOEP_SERVER_CONNECTIONS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("goep_server_connection", goep_server_connection_usage.num_in_use, goep_server_connection_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_HFP_CONNECTIONS
+#if MAX_NR_HFP_CONNECTIONS > 0
+    btstack_memory_log_stats("hfp_connection", btstack_memory_tracked_pool_num_in_use(&hfp_connection_pool),
+                             btstack_memory_tracked_pool_max_in_use(&hfp_connection_pool), MAX_NR_HFP_CONNECTIONS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("hfp_connection", hfp_connection_usage.num_in_use, hfp_connection_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_HID_HOST_CONNECTIONS
+#if MAX_NR_HID_HOST_CONNECTIONS > 0
+    btstack_memory_log_stats("hid_host_connection", btstack_memory_tracked_pool_num_in_use(&hid_host_connection_pool),
+                             btstack_memory_tracked_pool_max_in_use(&hid_host_connection_pool), MAX_NR_HID_HOST_CONNECTIONS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("hid_host_connection", hid_host_connection_usage.num_in_use, hid_host_connection_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_SERVICE_RECORD_ITEMS
+#if MAX_NR_SERVICE_RECORD_ITEMS > 0
+    btstack_memory_log_stats("service_record_item", btstack_memory_tracked_pool_num_in_use(&service_record_item_pool),
+                             btstack_memory_tracked_pool_max_in_use(&service_record_item_pool), MAX_NR_SERVICE_RECORD_ITEMS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("service_record_item", service_record_item_usage.num_in_use, service_record_item_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_AVDTP_STREAM_ENDPOINTS
+#if MAX_NR_AVDTP_STREAM_ENDPOINTS > 0
+    btstack_memory_log_stats("avdtp_stream_endpoint", btstack_memory_tracked_pool_num_in_use(&avdtp_stream_endpoint_pool),
+                             btstack_memory_tracked_pool_max_in_use(&avdtp_stream_endpoint_pool), MAX_NR_AVDTP_STREAM_ENDPOINTS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("avdtp_stream_endpoint", avdtp_stream_endpoint_usage.num_in_use, avdtp_stream_endpoint_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_AVDTP_CONNECTIONS
+#if MAX_NR_AVDTP_CONNECTIONS > 0
+    btstack_memory_log_stats("avdtp_connection", btstack_memory_tracked_pool_num_in_use(&avdtp_connection_pool),
+                             btstack_memory_tracked_pool_max_in_use(&avdtp_connection_pool), MAX_NR_AVDTP_CONNECTIONS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("avdtp_connection", avdtp_connection_usage.num_in_use, avdtp_connection_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_AVRCP_CONNECTIONS
+#if MAX_NR_AVRCP_CONNECTIONS > 0
+    btstack_memory_log_stats("avrcp_connection", btstack_memory_tracked_pool_num_in_use(&avrcp_connection_pool),
+                             btstack_memory_tracked_pool_max_in_use(&avrcp_connection_pool), MAX_NR_AVRCP_CONNECTIONS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("avrcp_connection", avrcp_connection_usage.num_in_use, avrcp_connection_usage.max_in_use, 0);
+#endif
+
+#ifdef MAX_NR_AVRCP_BROWSING_CONNECTIONS
+#if MAX_NR_AVRCP_BROWSING_CONNECTIONS > 0
+    btstack_memory_log_stats("avrcp_browsing_connection", btstack_memory_tracked_pool_num_in_use(&avrcp_browsing_connection_pool),
+                             btstack_memory_tracked_pool_max_in_use(&avrcp_browsing_connection_pool), MAX_NR_AVRCP_BROWSING_CONNECTIONS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("avrcp_browsing_connection", avrcp_browsing_connection_usage.num_in_use, avrcp_browsing_connection_usage.max_in_use, 0);
+#endif
+
+#endif
+#ifdef ENABLE_BLE
+#ifdef MAX_NR_BATTERY_SERVICE_CLIENTS
+#if MAX_NR_BATTERY_SERVICE_CLIENTS > 0
+    btstack_memory_log_stats("battery_service_client", btstack_memory_tracked_pool_num_in_use(&battery_service_client_pool),
+                             btstack_memory_tracked_pool_max_in_use(&battery_service_client_pool), MAX_NR_BATTERY_SERVICE_CLIENTS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("battery_service_client", battery_service_client_usage.num_in_use, battery_service_client_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_GATT_CLIENTS
+#if MAX_NR_GATT_CLIENTS > 0
+    btstack_memory_log_stats("gatt_client", btstack_memory_tracked_pool_num_in_use(&gatt_client_pool),
+                             btstack_memory_tracked_pool_max_in_use(&gatt_client_pool), MAX_NR_GATT_CLIENTS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("gatt_client", gatt_client_usage.num_in_use, gatt_client_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_HIDS_HOSTS
+#if MAX_NR_HIDS_HOSTS > 0
+    btstack_memory_log_stats("hids_host", btstack_memory_tracked_pool_num_in_use(&hids_host_pool),
+                             btstack_memory_tracked_pool_max_in_use(&hids_host_pool), MAX_NR_HIDS_HOSTS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("hids_host", hids_host_usage.num_in_use, hids_host_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_SM_LOOKUP_ENTRIES
+#if MAX_NR_SM_LOOKUP_ENTRIES > 0
+    btstack_memory_log_stats("sm_lookup_entry", btstack_memory_tracked_pool_num_in_use(&sm_lookup_entry_pool),
+                             btstack_memory_tracked_pool_max_in_use(&sm_lookup_entry_pool), MAX_NR_SM_LOOKUP_ENTRIES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("sm_lookup_entry", sm_lookup_entry_usage.num_in_use, sm_lookup_entry_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_WHITELIST_ENTRIES
+#if MAX_NR_WHITELIST_ENTRIES > 0
+    btstack_memory_log_stats("whitelist_entry", btstack_memory_tracked_pool_num_in_use(&whitelist_entry_pool),
+                             btstack_memory_tracked_pool_max_in_use(&whitelist_entry_pool), MAX_NR_WHITELIST_ENTRIES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("whitelist_entry", whitelist_entry_usage.num_in_use, whitelist_entry_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES
+#if MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES > 0
+    btstack_memory_log_stats("periodic_advertiser_list_entry", btstack_memory_tracked_pool_num_in_use(&periodic_advertiser_list_entry_pool),
+                             btstack_memory_tracked_pool_max_in_use(&periodic_advertiser_list_entry_pool), MAX_NR_PERIODIC_ADVERTISER_LIST_ENTRIES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("periodic_advertiser_list_entry", periodic_advertiser_list_entry_usage.num_in_use, periodic_advertiser_list_entry_usage.max_in_use, 0);
+#endif
+
+#endif
+#ifdef ENABLE_MESH
+#ifdef MAX_NR_MESH_NETWORK_PDUS
+#if MAX_NR_MESH_NETWORK_PDUS > 0
+    btstack_memory_log_stats("mesh_network_pdu", btstack_memory_tracked_pool_num_in_use(&mesh_network_pdu_pool),
+                             btstack_memory_tracked_pool_max_in_use(&mesh_network_pdu_pool), MAX_NR_MESH_NETWORK_PDUS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("mesh_network_pdu", mesh_network_pdu_usage.num_in_use, mesh_network_pdu_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_MESH_SEGMENTED_PDUS
+#if MAX_NR_MESH_SEGMENTED_PDUS > 0
+    btstack_memory_log_stats("mesh_segmented_pdu", btstack_memory_tracked_pool_num_in_use(&mesh_segmented_pdu_pool),
+                             btstack_memory_tracked_pool_max_in_use(&mesh_segmented_pdu_pool), MAX_NR_MESH_SEGMENTED_PDUS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("mesh_segmented_pdu", mesh_segmented_pdu_usage.num_in_use, mesh_segmented_pdu_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_MESH_UPPER_TRANSPORT_PDUS
+#if MAX_NR_MESH_UPPER_TRANSPORT_PDUS > 0
+    btstack_memory_log_stats("mesh_upper_transport_pdu", btstack_memory_tracked_pool_num_in_use(&mesh_upper_transport_pdu_pool),
+                             btstack_memory_tracked_pool_max_in_use(&mesh_upper_transport_pdu_pool), MAX_NR_MESH_UPPER_TRANSPORT_PDUS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("mesh_upper_transport_pdu", mesh_upper_transport_pdu_usage.num_in_use, mesh_upper_transport_pdu_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_MESH_NETWORK_KEYS
+#if MAX_NR_MESH_NETWORK_KEYS > 0
+    btstack_memory_log_stats("mesh_network_key", btstack_memory_tracked_pool_num_in_use(&mesh_network_key_pool),
+                             btstack_memory_tracked_pool_max_in_use(&mesh_network_key_pool), MAX_NR_MESH_NETWORK_KEYS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("mesh_network_key", mesh_network_key_usage.num_in_use, mesh_network_key_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_MESH_TRANSPORT_KEYS
+#if MAX_NR_MESH_TRANSPORT_KEYS > 0
+    btstack_memory_log_stats("mesh_transport_key", btstack_memory_tracked_pool_num_in_use(&mesh_transport_key_pool),
+                             btstack_memory_tracked_pool_max_in_use(&mesh_transport_key_pool), MAX_NR_MESH_TRANSPORT_KEYS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("mesh_transport_key", mesh_transport_key_usage.num_in_use, mesh_transport_key_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_MESH_VIRTUAL_ADDRESSS
+#if MAX_NR_MESH_VIRTUAL_ADDRESSS > 0
+    btstack_memory_log_stats("mesh_virtual_address", btstack_memory_tracked_pool_num_in_use(&mesh_virtual_address_pool),
+                             btstack_memory_tracked_pool_max_in_use(&mesh_virtual_address_pool), MAX_NR_MESH_VIRTUAL_ADDRESSS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("mesh_virtual_address", mesh_virtual_address_usage.num_in_use, mesh_virtual_address_usage.max_in_use, 0);
+#endif
+#ifdef MAX_NR_MESH_SUBNETS
+#if MAX_NR_MESH_SUBNETS > 0
+    btstack_memory_log_stats("mesh_subnet", btstack_memory_tracked_pool_num_in_use(&mesh_subnet_pool),
+                             btstack_memory_tracked_pool_max_in_use(&mesh_subnet_pool), MAX_NR_MESH_SUBNETS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("mesh_subnet", mesh_subnet_usage.num_in_use, mesh_subnet_usage.max_in_use, 0);
+#endif
+
+#endif
+#ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
+#ifdef MAX_NR_HCI_ISO_STREAMS
+#if MAX_NR_HCI_ISO_STREAMS > 0
+    btstack_memory_log_stats("hci_iso_stream", btstack_memory_tracked_pool_num_in_use(&hci_iso_stream_pool),
+                             btstack_memory_tracked_pool_max_in_use(&hci_iso_stream_pool), MAX_NR_HCI_ISO_STREAMS);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("hci_iso_stream", hci_iso_stream_usage.num_in_use, hci_iso_stream_usage.max_in_use, 0);
+#endif
+
+#endif
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+#ifdef MAX_NR_GATT_CLIENT_DISCOVERY_CACHES
+#if MAX_NR_GATT_CLIENT_DISCOVERY_CACHES > 0
+    btstack_memory_log_stats("gatt_client_discovery_cache", btstack_memory_tracked_pool_num_in_use(&gatt_client_discovery_cache_pool),
+                             btstack_memory_tracked_pool_max_in_use(&gatt_client_discovery_cache_pool), MAX_NR_GATT_CLIENT_DISCOVERY_CACHES);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("gatt_client_discovery_cache", gatt_client_discovery_cache_usage.num_in_use, gatt_client_discovery_cache_usage.max_in_use, 0);
+#endif
+
+#endif
+}
+#endif
@@ -99,6 +99,13 @@ void btstack_memory_init(void);
  */
 void btstack_memory_deinit(void);
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+/**
+ * @brief Log current and max number of buffers in use for all memory pools
+ */
+void btstack_memory_dump_stats(void);
+#endif
+
 /* API_END */
 
 hci_connection_t * btstack_memory_hci_connection_get(void);
@@ -188,6 +195,11 @@ void   btstack_memory_mesh_subnet_free(mesh_subnet_t *mesh_subnet);
 hci_iso_stream_t * btstack_memory_hci_iso_stream_get(void);
 void   btstack_memory_hci_iso_stream_free(hci_iso_stream_t *hci_iso_stream);
 
+#endif
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+gatt_client_discovery_cache_t * btstack_memory_gatt_client_discovery_cache_get(void);
+void   btstack_memory_gatt_client_discovery_cache_free(gatt_client_discovery_cache_t *gatt_client_discovery_cache);
+
 #endif
 
 
@@ -44,11 +44,14 @@
  *
  *  Free blocks are kept in singly linked list
  *
+ *  Tracked pools additionally keep an allocation bitmap and usage counters
+ *
  */
 
 #include "btstack_memory_pool.h"
 
 #include <stddef.h>
+#include <string.h>
 #include "btstack_debug.h"
 
 typedef struct node {
@@ -94,3 +97,79 @@ void btstack_memory_pool_free(btstack_memory_pool_t *pool, void * block){
     node->next          = free_blocks->next;
     free_blocks->next   = node;
 }
+
+void btstack_memory_tracked_pool_create(btstack_memory_tracked_pool_t *pool, void * storage, uint16_t count, uint16_t block_size, uint8_t * bitmap){
+    btstack_assert(block_size >= sizeof(node_t));
+    pool->storage    = (uint8_t *) storage;
+    pool->allocated  = bitmap;
+    pool->count      = count;
+    pool->block_size = block_size;
+    pool->num_in_use = 0;
+    pool->max_in_use = 0;
+    memset(bitmap, 0, BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(count));
+
+    // create singly linked list of all available blocks, first block at head
+    node_t * free_blocks = NULL;
+    uint16_t i = count;
+    while (i > 0u){
+        i--;
+        node_t * node = (node_t *) &pool->storage[i * block_size];
+        node->next = free_blocks;
+        free_blocks = node;
+    }
+    pool->free_blocks = free_blocks;
+}
+
+void * btstack_memory_tracked_pool_get(btstack_memory_tracked_pool_t *pool){
+    node_t * node = (node_t *) pool->free_blocks;
+    if (node == NULL) return NULL;
+
+    // remove first
+    pool->free_blocks = node->next;
+
+    uint16_t index = (uint16_t) ((((uint8_t *) node) - pool->storage) / pool->block_size);
+    pool->allocated[index >> 3] |= (uint8_t) (1u << (index & 7u));
+
+    pool->num_in_use++;
+    if (pool->num_in_use > pool->max_in_use){
+        pool->max_in_use = pool->num_in_use;
+    }
+    return (void *) node;
+}
+
+void btstack_memory_tracked_pool_free(btstack_memory_tracked_pool_t *pool, void * block){
+    uint8_t * ptr = (uint8_t *) block;
+
+    // verify that block belongs to pool and is in use
+    bool valid = false;
+    uint16_t index = 0;
+    uint8_t mask = 0;
+    if (ptr >= pool->storage){
+        uint32_t offset = (uint32_t) (ptr - pool->storage);
+        index = (uint16_t) (offset / pool->block_size);
+        mask  = (uint8_t) (1u << (index & 7u));
+        valid = ((offset % pool->block_size) == 0u) && (offset < ((uint32_t) pool->count * pool->block_size)) &&
+                ((pool->allocated[index >> 3] & mask) != 0u);
+    }
+    if (valid == false){
+        log_error("free of invalid or unused block %p", block);
+        btstack_assert(false);
+        return;
+    }
+    pool->allocated[index >> 3] &= (uint8_t) ~mask;
+
+    // add block as node to list
+    node_t * node     = (node_t *) block;
+    node->next        = (node_t *) pool->free_blocks;
+    pool->free_blocks = node;
+
+    pool->num_in_use--;
+}
+
+uint16_t btstack_memory_tracked_pool_num_in_use(const btstack_memory_tracked_pool_t *pool){
+    return pool->num_in_use;
+}
+
+uint16_t btstack_memory_tracked_pool_max_in_use(const btstack_memory_tracked_pool_t *pool){
+    return pool->max_in_use;
+}
@@ -49,12 +49,30 @@
 #ifndef btstack_memory_pool_H
 #define btstack_memory_pool_H
 
+#include <stdint.h>
+
 #if defined __cplusplus
 extern "C" {
 #endif
 
 typedef void * btstack_memory_pool_t;
 
+// memory pool with allocation bitmap for O(1) double-free detection and usage statistics
+typedef struct {
+    // singly linked list of free blocks
+    void     * free_blocks;
+    uint8_t  * storage;
+    // one bit per block, set if block is in use
+    uint8_t  * allocated;
+    uint16_t   count;
+    uint16_t   block_size;
+    uint16_t   num_in_use;
+    uint16_t   max_in_use;
+} btstack_memory_tracked_pool_t;
+
+// size of allocation bitmap for tracked pool with count blocks
+#define BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(count) (((count) + 7) / 8)
+
 // initialize memory pool with with given storage, block size and count
 void   btstack_memory_pool_create(btstack_memory_pool_t *pool, void * storage, int count, int block_size);
 
@@ -64,6 +82,21 @@ void * btstack_memory_pool_get(btstack_memory_pool_t *pool);
 // return previously reserved block to memory pool
 void   btstack_memory_pool_free(btstack_memory_pool_t *pool, void * block);
 
+// initialize tracked memory pool with given storage, block size, count, and allocation bitmap of BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(count) bytes
+void   btstack_memory_tracked_pool_create(btstack_memory_tracked_pool_t *pool, void * storage, uint16_t count, uint16_t block_size, uint8_t * bitmap);
+
+// get free block from tracked pool, @return NULL or pointer to block
+void * btstack_memory_tracked_pool_get(btstack_memory_tracked_pool_t *pool);
+
+// return previously reserved block to tracked memory pool, asserts that block belongs to pool and is in use
+void   btstack_memory_tracked_pool_free(btstack_memory_tracked_pool_t *pool, void * block);
+
+// @return number of blocks currently in use
+uint16_t btstack_memory_tracked_pool_num_in_use(const btstack_memory_tracked_pool_t *pool);
+
+// @return max number of blocks in use at the same time since create
+uint16_t btstack_memory_tracked_pool_max_in_use(const btstack_memory_tracked_pool_t *pool);
+
 #if defined __cplusplus
 }
 #endif
@@ -50,6 +50,8 @@
 #include "btstack_util.h"
 
 #include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
 
 static const btstack_run_loop_t * the_run_loop = NULL;
 
@@ -64,10 +66,17 @@ btstack_linked_list_t  btstack_run_loop_base_timers;
 btstack_linked_list_t  btstack_run_loop_base_data_sources;
 btstack_linked_list_t  btstack_run_loop_base_callbacks;
 
+#ifdef ENABLE_RUN_LOOP_TIMER_WHEEL
+static void btstack_run_loop_timer_wheel_init(void);
+#endif
+
 void btstack_run_loop_base_init(void){
     btstack_run_loop_base_timers = NULL;
     btstack_run_loop_base_data_sources = NULL;
     btstack_run_loop_base_callbacks = NULL;
+#ifdef ENABLE_RUN_LOOP_TIMER_WHEEL
+    btstack_run_loop_timer_wheel_init();
+#endif
 }
 
 void btstack_run_loop_base_add_data_source(btstack_data_source_t * data_source){
@@ -86,6 +95,300 @@ void btstack_run_loop_base_disable_data_source_callbacks(btstack_data_source_t *
     data_source->flags &= ~callback_types;
 }
 
+#ifdef ENABLE_RUN_LOOP_TIMER_WHEEL
+
+/*
+ * Hierarchical timer wheel
+ *
+ * Timers are stored in TIMER_WHEEL_LEVELS levels with TIMER_WHEEL_SLOTS slots each. A timer is stored on the level that
+ * corresponds to the most significant group of TIMER_WHEEL_LEVEL_BITS bits in which its timeout differs from
+ * timer_wheel_now, and in the slot given by this group of its timeout. When timer_wheel_now advances, the slot that
+ * becomes current on each higher level is re-distributed to the lower levels. Timers on level 0 have an exact timeout.
+ * Timers with a timeout before timer_wheel_now are kept in a sorted list.
+ */
+
+#define TIMER_WHEEL_LEVEL_BITS 6
+#define TIMER_WHEEL_SLOTS      (1u << TIMER_WHEEL_LEVEL_BITS)
+#define TIMER_WHEEL_SLOT_MASK  (TIMER_WHEEL_SLOTS - 1u)
+// 6 levels x 6 bits cover the 32-bit time range
+#define TIMER_WHEEL_LEVELS     6
+#define TIMER_WHEEL_BITMAP_WORDS (TIMER_WHEEL_SLOTS / 32u)
+
+static btstack_timer_wheel_link_t timer_wheel_slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+static uint32_t                   timer_wheel_occupied[TIMER_WHEEL_LEVELS][TIMER_WHEEL_BITMAP_WORDS];
+static btstack_timer_wheel_link_t timer_wheel_early;
+static uint32_t                   timer_wheel_now;
+static uint32_t                   timer_wheel_num_timers;
+// cached earliest timer, NULL if unknown
+static btstack_timer_source_t *   timer_wheel_earliest;
+
+static btstack_timer_source_t * btstack_run_loop_timer_wheel_timer_for_link(btstack_timer_wheel_link_t * link){
+    return (btstack_timer_source_t *) (void *) ((uint8_t *) link - offsetof(btstack_timer_source_t, wheel_link));
+}
+
+static void btstack_run_loop_timer_wheel_link_init(btstack_timer_wheel_link_t * head){
+    head->next = head;
+    head->prev = head;
+}
+
+// timers are not required to be initialized, only dereference wheel_head if it points to a slot of the wheel
+static bool btstack_run_loop_timer_wheel_is_registered(btstack_timer_source_t * timer){
+    btstack_timer_wheel_link_t * head = timer->wheel_head;
+    uintptr_t first = (uintptr_t) &timer_wheel_slots[0][0];
+    uintptr_t last  = (uintptr_t) &timer_wheel_slots[TIMER_WHEEL_LEVELS - 1u][TIMER_WHEEL_SLOTS - 1u];
+    bool is_slot = ((uintptr_t) head >= first) && ((uintptr_t) head <= last) &&
+                   ((((uintptr_t) head - first) % sizeof(btstack_timer_wheel_link_t)) == 0u);
+    if ((is_slot == false) && (head != &timer_wheel_early)) return false;
+    btstack_timer_wheel_link_t * it;
+    for (it = head->next; it != head; it = it->next){
+        if (it == &timer->wheel_link) return true;
+    }
+    return false;
+}
+
+static void btstack_run_loop_timer_wheel_link_append(btstack_timer_wheel_link_t * head, btstack_timer_wheel_link_t * link){
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+static void btstack_run_loop_timer_wheel_init(void){
+    uint16_t level;
+    uint16_t slot;
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++){
+        for (slot = 0; slot < TIMER_WHEEL_SLOTS; slot++){
+            btstack_run_loop_timer_wheel_link_init(&timer_wheel_slots[level][slot]);
+        }
+    }
+    memset(timer_wheel_occupied, 0, sizeof(timer_wheel_occupied));
+    btstack_run_loop_timer_wheel_link_init(&timer_wheel_early);
+    timer_wheel_now = 0;
+    timer_wheel_num_timers = 0;
+    timer_wheel_earliest = NULL;
+}
+
+static uint16_t btstack_run_loop_timer_wheel_slot_for_level(uint32_t time, uint16_t level){
+    return (uint16_t) ((time >> (level * TIMER_WHEEL_LEVEL_BITS)) & TIMER_WHEEL_SLOT_MASK);
+}
+
+// @return first occupied slot in [start, TIMER_WHEEL_SLOTS) or TIMER_WHEEL_SLOTS
+static uint16_t btstack_run_loop_timer_wheel_find_occupied(uint16_t level, uint16_t start){
+    uint16_t slot = start;
+    while (slot < TIMER_WHEEL_SLOTS){
+        uint32_t word = timer_wheel_occupied[level][slot >> 5] >> (slot & 31u);
+        if (word == 0u){
+            // skip to next word
+            slot = (uint16_t) ((slot | 31u) + 1u);
+            continue;
+        }
+        while ((word & 1u) == 0u){
+            word >>= 1;
+            slot++;
+        }
+        return slot;
+    }
+    return TIMER_WHEEL_SLOTS;
+}
+
+static void btstack_run_loop_timer_wheel_insert(btstack_timer_source_t * timer){
+    uint32_t timeout = (uint32_t) timer->timeout;
+    btstack_timer_wheel_link_t * link = &timer->wheel_link;
+
+    // timeouts before timer_wheel_now are kept in sorted list
+    if (btstack_time_delta(timeout, timer_wheel_now) < 0){
+        btstack_timer_wheel_link_t * it;
+        for (it = timer_wheel_early.next; it != &timer_wheel_early; it = it->next){
+            btstack_timer_source_t * next = btstack_run_loop_timer_wheel_timer_for_link(it);
+            if (btstack_time_delta(timeout, (uint32_t) next->timeout) < 0) break;
+        }
+        // insert before it
+        btstack_run_loop_timer_wheel_link_append(it, link);
+        timer->wheel_head = &timer_wheel_early;
+        return;
+    }
+
+    // find most significant level where timeout differs from now
+    uint32_t diff = timeout ^ timer_wheel_now;
+    uint16_t level = 0;
+    uint16_t i;
+    for (i = 1; i < TIMER_WHEEL_LEVELS; i++){
+        if ((diff >> (i * TIMER_WHEEL_LEVEL_BITS)) != 0u){
+            level = i;
+        }
+    }
+    uint16_t slot = btstack_run_loop_timer_wheel_slot_for_level(timeout, level);
+    btstack_run_loop_timer_wheel_link_append(&timer_wheel_slots[level][slot], link);
+    timer->wheel_head = &timer_wheel_slots[level][slot];
+    timer_wheel_occupied[level][slot >> 5] |= 1u << (slot & 31u);
+}
+
+static void btstack_run_loop_timer_wheel_unlink(btstack_timer_source_t * timer){
+    btstack_timer_wheel_link_t * link = &timer->wheel_link;
+    btstack_timer_wheel_link_t * head = timer->wheel_head;
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+    timer->wheel_head = NULL;
+    // clear occupied bit if slot became empty
+    if ((head->next == head) && (head != &timer_wheel_early)){
+        uint32_t index = (uint32_t) (head - &timer_wheel_slots[0][0]);
+        uint16_t level = (uint16_t) (index / TIMER_WHEEL_SLOTS);
+        uint16_t slot  = (uint16_t) (index % TIMER_WHEEL_SLOTS);
+        timer_wheel_occupied[level][slot >> 5] &= ~(1u << (slot & 31u));
+    }
+}
+
+// move timer_wheel_now forward. requires that no timer in the wheel has a timeout before new_now
+static void btstack_run_loop_timer_wheel_advance(uint32_t new_now){
+    uint32_t diff = timer_wheel_now ^ new_now;
+    timer_wheel_now = new_now;
+    uint16_t level;
+    for (level = TIMER_WHEEL_LEVELS - 1u; level > 0u; level--){
+        if ((diff >> (level * TIMER_WHEEL_LEVEL_BITS)) == 0u) continue;
+        uint16_t slot = btstack_run_loop_timer_wheel_slot_for_level(new_now, level);
+        btstack_timer_wheel_link_t * head = &timer_wheel_slots[level][slot];
+        if (head->next == head) continue;
+        // detach slot and re-insert timers on lower levels
+        btstack_timer_wheel_link_t pending;
+        pending.next = head->next;
+        pending.prev = head->prev;
+        pending.next->prev = &pending;
+        pending.prev->next = &pending;
+        btstack_run_loop_timer_wheel_link_init(head);
+        timer_wheel_occupied[level][slot >> 5] &= ~(1u << (slot & 31u));
+        while (pending.next != &pending){
+            btstack_timer_wheel_link_t * link = pending.next;
+            pending.next = link->next;
+            link->next->prev = &pending;
+            btstack_run_loop_timer_wheel_insert(btstack_run_loop_timer_wheel_timer_for_link(link));
+        }
+    }
+}
+
+static btstack_timer_source_t * btstack_run_loop_timer_wheel_find_earliest(void){
+    if (timer_wheel_num_timers == 0u) return NULL;
+    if (timer_wheel_earliest != NULL) return timer_wheel_earliest;
+
+    btstack_timer_source_t * earliest = NULL;
+    if (timer_wheel_early.next != &timer_wheel_early){
+        earliest = btstack_run_loop_timer_wheel_timer_for_link(timer_wheel_early.next);
+    } else {
+        uint16_t level;
+        for (level = 0; level < TIMER_WHEEL_LEVELS; level++){
+            uint16_t current = btstack_run_loop_timer_wheel_slot_for_level(timer_wheel_now, level);
+            // slot of now is empty on higher levels
+            uint16_t slot = btstack_run_loop_timer_wheel_find_occupied(level, current);
+            if ((slot == TIMER_WHEEL_SLOTS) && (level == (TIMER_WHEEL_LEVELS - 1u))){
+                // top level wraps around
+                slot = btstack_run_loop_timer_wheel_find_occupied(level, 0);
+            }
+            if (slot == TIMER_WHEEL_SLOTS) continue;
+            // level 0 slots contain timers with identical timeout, others need to be searched
+            btstack_timer_wheel_link_t * head = &timer_wheel_slots[level][slot];
+            btstack_timer_wheel_link_t * it;
+            for (it = head->next; it != head; it = it->next){
+                btstack_timer_source_t * timer = btstack_run_loop_timer_wheel_timer_for_link(it);
+                if ((earliest == NULL) || (btstack_time_delta((uint32_t) timer->timeout, (uint32_t) earliest->timeout) < 0)){
+                    earliest = timer;
+                }
+                if (level == 0u) break;
+            }
+            break;
+        }
+    }
+    timer_wheel_earliest = earliest;
+    return earliest;
+}
+
+bool btstack_run_loop_base_remove_timer(btstack_timer_source_t * timer){
+    if (btstack_run_loop_timer_wheel_is_registered(timer) == false) return false;
+    btstack_run_loop_timer_wheel_unlink(timer);
+    timer_wheel_num_timers--;
+    if (timer == timer_wheel_earliest){
+        timer_wheel_earliest = NULL;
+    }
+    return true;
+}
+
+void btstack_run_loop_base_add_timer(btstack_timer_source_t * timer){
+    if (btstack_run_loop_timer_wheel_is_registered(timer)){
+        log_error("Timer %p already registered! Please read source code comment.", (void*)timer);
+        // see btstack_run_loop_base_add_timer below
+        btstack_assert(false);
+        return;
+    }
+    if ((timer_wheel_num_timers == 0u) && (btstack_time_delta((uint32_t) timer->timeout, timer_wheel_now) < 0)){
+        // timer_wheel_now is only updated by btstack_run_loop_base_process_timers, restart wheel at timeout
+        timer_wheel_now = (uint32_t) timer->timeout;
+    }
+    btstack_run_loop_timer_wheel_insert(timer);
+    timer_wheel_num_timers++;
+    // update cached earliest timer
+    if ((timer_wheel_earliest != NULL) && (btstack_time_delta((uint32_t) timer->timeout, (uint32_t) timer_wheel_earliest->timeout) < 0)){
+        timer_wheel_earliest = timer;
+    }
+}
+
+void btstack_run_loop_base_process_timers(uint32_t now){
+    // process timers, exit when timeout is in the future
+    while (true) {
+        btstack_timer_source_t * timer = btstack_run_loop_timer_wheel_find_earliest();
+        if (timer == NULL) break;
+        uint32_t timeout = (uint32_t) timer->timeout;
+        int32_t delta = btstack_time_delta(timeout, now);
+        if (delta > 0) break;
+        if (btstack_time_delta(timeout, timer_wheel_now) > 0){
+            btstack_run_loop_timer_wheel_advance(timeout);
+        }
+        btstack_run_loop_base_remove_timer(timer);
+        timer->process(timer);
+    }
+    // all remaining timers are in the future
+    if (btstack_time_delta(now, timer_wheel_now) > 0){
+        btstack_run_loop_timer_wheel_advance(now);
+    }
+}
+
+void btstack_run_loop_base_dump_timer(void){
+#ifdef ENABLE_LOG_INFO
+    uint16_t i = 0;
+    btstack_timer_wheel_link_t * it;
+    for (it = timer_wheel_early.next; it != &timer_wheel_early; it = it->next){
+        btstack_timer_source_t * timer = btstack_run_loop_timer_wheel_timer_for_link(it);
+        log_info("timer %u (%p): timeout %" PRIbtstack_time_t "\n", i++, (void *) timer, timer->timeout);
+    }
+    uint16_t level;
+    uint16_t slot;
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++){
+        for (slot = 0; slot < TIMER_WHEEL_SLOTS; slot++){
+            btstack_timer_wheel_link_t * head = &timer_wheel_slots[level][slot];
+            for (it = head->next; it != head; it = it->next){
+                btstack_timer_source_t * timer = btstack_run_loop_timer_wheel_timer_for_link(it);
+                log_info("timer %u (%p): timeout %" PRIbtstack_time_t ", level %u, slot %u\n", i++, (void *) timer, timer->timeout, level, slot);
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Get time until first timer fires
+ * @return -1 if no timers, time until next timeout otherwise
+ */
+int32_t btstack_run_loop_base_get_time_until_timeout(uint32_t now){
+    btstack_timer_source_t * timer = btstack_run_loop_timer_wheel_find_earliest();
+    if (timer == NULL) return -1;
+    int32_t delta = btstack_time_delta((uint32_t) timer->timeout, now);
+    if (delta < 0){
+        delta = 0;
+    }
+    return delta;
+}
+
+#else
+
 bool btstack_run_loop_base_remove_timer(btstack_timer_source_t * timer){
     return btstack_linked_list_remove(&btstack_run_loop_base_timers, (btstack_linked_item_t *) timer);
 }
@@ -156,6 +459,8 @@ int32_t btstack_run_loop_base_get_time_until_timeout(uint32_t now){
     return delta;
 }
 
+#endif
+
 void btstack_run_loop_base_poll_data_sources(void){
     // poll data sources
     btstack_data_source_t *ds;
@@ -98,6 +98,14 @@ typedef struct btstack_data_source {
 
 } btstack_data_source_t;
 
+#ifdef ENABLE_RUN_LOOP_TIMER_WHEEL
+// doubly linked list entry for timer wheel slots
+typedef struct btstack_timer_wheel_link {
+    struct btstack_timer_wheel_link * next;
+    struct btstack_timer_wheel_link * prev;
+} btstack_timer_wheel_link_t;
+#endif
+
 typedef struct btstack_timer_source {
     btstack_linked_item_t item;
     // timeout in system ticks (HAVE_EMBEDDED_TICK) or milliseconds (HAVE_EMBEDDED_TIME_MS)
@@ -105,6 +113,12 @@ typedef struct btstack_timer_source {
     // will be called when timer fired
     void  (*process)(struct btstack_timer_source *ts);
     void * context;
+#ifdef ENABLE_RUN_LOOP_TIMER_WHEEL
+    // entry in timer wheel slot
+    btstack_timer_wheel_link_t wheel_link;
+    // head of timer wheel slot, only valid if timer is found in this slot
+    btstack_timer_wheel_link_t * wheel_head;
+#endif
 } btstack_timer_source_t;
 
 typedef struct btstack_run_loop {
@@ -131,6 +145,7 @@ typedef struct btstack_run_loop {
  */
 
 // private data (access only by run loop implementations)
+// - with ENABLE_RUN_LOOP_TIMER_WHEEL, timers are kept in a hierarchical timer wheel and btstack_run_loop_base_timers is unused
 extern btstack_linked_list_t btstack_run_loop_base_timers;
 extern btstack_linked_list_t btstack_run_loop_base_data_sources;
 extern btstack_linked_list_t btstack_run_loop_base_callbacks;
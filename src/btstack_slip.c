@@ -49,7 +49,9 @@ typedef enum {
 	SLIP_ENCODER_DEFAULT,
 	SLIP_ENCODER_SEND_C0,
 	SLIP_ENCODER_SEND_DC,
-	SLIP_ENCODER_SEND_DD
+	SLIP_ENCODER_SEND_DD,
+	SLIP_ENCODER_SEND_DE,
+	SLIP_ENCODER_SEND_DF
 } btstack_slip_encoder_state_t;
 
 // h5 slip state machine
@@ -66,16 +68,26 @@ typedef enum {
 static btstack_slip_encoder_state_t encoder_state;
 static const uint8_t * encoder_data;
 static uint16_t  encoder_len;
+static bool      encoder_escape_xon_xoff;
 
 // decoder 
 static btstack_slip_decoder_state_t decoder_state;
 static uint8_t * decoder_buffer;
 static uint16_t  decoder_max_size;
 static uint16_t  decoder_pos;
+static void (*decoder_xon_xoff_handler)(bool xon);
 
 
 // ENCODER
 
+/**
+ * @brief Escape XON (0x11) and XOFF (0x13) as 0xDB 0xDE and 0xDB 0xDF, used for H5 OOF Flow Control
+ * @param enabled
+ */
+void btstack_slip_encoder_set_xon_xoff_escaping(bool enabled){
+	encoder_escape_xon_xoff = enabled;
+}
+
 /**
  * @brief Initialise SLIP encoder with data
  * @param data
@@ -115,6 +127,19 @@ uint8_t btstack_slip_encoder_get_byte(void){
 				case 0xdb:
 					encoder_state = SLIP_ENCODER_SEND_DD;
 					next_byte = 0xdb;
+					break;
+				case BTSTACK_SLIP_XON:
+					if (encoder_escape_xon_xoff){
+						encoder_state = SLIP_ENCODER_SEND_DE;
+						next_byte = 0xdb;
+					}
+					break;
+				case BTSTACK_SLIP_XOFF:
+					if (encoder_escape_xon_xoff){
+						encoder_state = SLIP_ENCODER_SEND_DF;
+						next_byte = 0xdb;
+					}
+					break;
 				default:
                     break;
 			}
@@ -130,6 +155,14 @@ uint8_t btstack_slip_encoder_get_byte(void){
 			encoder_state = SLIP_ENCODER_DEFAULT;
 			next_byte = 0x0dd;
 			break;
+		case SLIP_ENCODER_SEND_DE:
+			encoder_state = SLIP_ENCODER_DEFAULT;
+			next_byte = 0xde;
+			break;
+		case SLIP_ENCODER_SEND_DF:
+			encoder_state = SLIP_ENCODER_DEFAULT;
+			next_byte = 0xdf;
+			break;
         default:
             log_error("btstack_slip_encoder_get_byte invalid state %x", encoder_state);
             return 0x00;
@@ -168,12 +201,34 @@ void btstack_slip_decoder_init(uint8_t * buffer, uint16_t max_size){
 	btstack_slip_decoder_reset();
 }
 
+/**
+ * @brief Set handler for XON/XOFF, enables H5 OOF Flow Control. NULL disables callback
+ * @param handler
+ */
+void btstack_slip_decoder_set_xon_xoff_handler(void (*handler)(bool xon)){
+	decoder_xon_xoff_handler = handler;
+}
+
 /**
  * @brief Process received byte
  * @param data
  */
 
 void btstack_slip_decoder_process(uint8_t input){
+	// with OOF Flow Control, XON/XOFF are escaped within frames
+	if (decoder_xon_xoff_handler != NULL){
+		switch (input){
+			case BTSTACK_SLIP_XON:
+				(*decoder_xon_xoff_handler)(true);
+				return;
+			case BTSTACK_SLIP_XOFF:
+				(*decoder_xon_xoff_handler)(false);
+				return;
+			default:
+				break;
+		}
+	}
+
 	switch(decoder_state){
         case SLIP_DECODER_UNKNOWN:
             if (input != BTSTACK_SLIP_SOF) break;
@@ -207,6 +262,14 @@ void btstack_slip_decoder_process(uint8_t input){
                     btstack_slip_decoder_store_byte(0xdb);
                     decoder_state = SLIP_DECODER_ACTIVE;
                     break;
+                case 0xde:
+                    btstack_slip_decoder_store_byte(BTSTACK_SLIP_XON);
+                    decoder_state = SLIP_DECODER_ACTIVE;
+                    break;
+                case 0xdf:
+                    btstack_slip_decoder_store_byte(BTSTACK_SLIP_XOFF);
+                    decoder_state = SLIP_DECODER_ACTIVE;
+                    break;
                 default:
                     btstack_slip_decoder_reset();
                     break;
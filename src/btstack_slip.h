@@ -44,6 +44,7 @@
 #define BTSTACK_SLIP_H
 
 #include <stdint.h>
+#include "btstack_bool.h"
 
 #if defined __cplusplus
 extern "C" {
@@ -51,6 +52,10 @@ extern "C" {
 
 #define BTSTACK_SLIP_SOF 0xc0
 
+// software flow control, used by H5 OOF Flow Control
+#define BTSTACK_SLIP_XON  0x11
+#define BTSTACK_SLIP_XOFF 0x13
+
 /* API_START */
 
 // ENCODER
@@ -74,6 +79,12 @@ int  btstack_slip_encoder_has_data(void);
  */
 uint8_t btstack_slip_encoder_get_byte(void);
 
+/**
+ * @brief Escape XON (0x11) and XOFF (0x13) as 0xDB 0xDE and 0xDB 0xDF, used for H5 OOF Flow Control
+ * @param enabled
+ */
+void btstack_slip_encoder_set_xon_xoff_escaping(bool enabled);
+
 // DECODER
 
 /**
@@ -97,6 +108,13 @@ void btstack_slip_decoder_process(uint8_t input);
 
 uint16_t btstack_slip_decoder_frame_size(void);
 
+/**
+ * @brief Set handler for XON/XOFF received outside of escaped data, enables H5 OOF Flow Control. NULL disables callback
+ * @note Escaped XON/XOFF (0xDB 0xDE / 0xDB 0xDF) are always decoded
+ * @param handler
+ */
+void btstack_slip_decoder_set_xon_xoff_handler(void (*handler)(bool xon));
+
 /* API_END */
 
 #if defined __cplusplus
@@ -184,6 +184,19 @@ typedef struct {
      */
     void (*send_frame)(const uint8_t *buffer, uint16_t length);
 
+
+    /** Support for streaming receive, used by H4 with ENABLE_H4_STREAMING_RX - can be set to NULL */
+
+    /**
+     * set callback for bytes received. NULL disables callback
+     */
+    void (*set_bytes_received)(void (*bytes_handler)(uint16_t bytes_received));
+
+    /**
+     * receive bytes: callback is called as soon as at least one and up to len bytes have been received
+     */
+    void (*receive_bytes)(uint8_t *buffer, uint16_t len);
+
 } btstack_uart_t;
 
 /* API_END */
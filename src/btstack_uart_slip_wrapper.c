@@ -243,7 +243,10 @@ const btstack_uart_t * btstack_uart_slip_wrapper_instance(const btstack_uart_t *
             /* void (*set_frame_received)(void (*cb)(uint16_t frame_size) */  &btstack_uart_slip_wrapper_set_frame_received,
             /* void (*set_frame_sent)(void (*block_handler)(void)); */        &btstack_uart_slip_wrapper_set_frame_sent,
             /* void (*receive_frame)(uint8_t *buffer, uint16_t len); */       &btstack_uart_slip_wrapper_receive_frame,
-            /* void (*send_frame)(const uint8_t *buffer, uint16_t length); */ &btstack_uart_slip_wrapper_send_frame
+            /* void (*send_frame)(const uint8_t *buffer, uint16_t length); */ &btstack_uart_slip_wrapper_send_frame,
+
+            /* void (*set_bytes_received)(void (*bytes_handler)(uint16_t bytes_received)); */ NULL,
+            /* void (*receive_bytes)(uint8_t *buffer, uint16_t len); */       NULL
     };
     original_uart = uart_without_slip;
     return &btstack_uart_slip_wrapper;
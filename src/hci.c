@@ -71,6 +71,7 @@
 #include "gap.h"
 #include "hci.h"
 #include "hci_cmd.h"
+#include "hci_cmd_serializer.h"
 #include "hci_dump.h"
 #include "ad_parser.h"
 
@@ -316,6 +317,182 @@ static void hci_connection_init(hci_connection_t * conn){
 #endif
 }
 
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+
+#if (HCI_CONNECTION_INDEX_SIZE & (HCI_CONNECTION_INDEX_SIZE - 1)) != 0
+#error "HCI_CONNECTION_INDEX_SIZE must be a power of two"
+#endif
+
+#define HCI_CONNECTION_INDEX_MASK (HCI_CONNECTION_INDEX_SIZE - 1u)
+
+static uint16_t hci_connection_index_key_for_address(const bd_addr_t addr, bd_addr_type_t addr_type){
+    // FNV-1a over address and type, folded to 16 bit
+    uint32_t hash = 2166136261u;
+    uint8_t i;
+    for (i = 0; i < 6; i++){
+        hash = (hash ^ addr[i]) * 16777619u;
+    }
+    hash = (hash ^ (uint8_t) addr_type) * 16777619u;
+    return (uint16_t) ((hash >> 16) ^ hash);
+}
+
+static void hci_connection_index_remove_slot(hci_connection_index_t * index, uint16_t slot){
+    // backward shift deletion keeps probe sequences intact without tombstones
+    uint16_t next = (slot + 1u) & HCI_CONNECTION_INDEX_MASK;
+    while (index->entries[next].connection != NULL){
+        uint16_t home = index->entries[next].key & HCI_CONNECTION_INDEX_MASK;
+        // move entry into hole if its home slot is not within (slot, next]
+        if (((next - home) & HCI_CONNECTION_INDEX_MASK) >= ((next - slot) & HCI_CONNECTION_INDEX_MASK)){
+            index->entries[slot] = index->entries[next];
+            slot = next;
+        }
+        next = (next + 1u) & HCI_CONNECTION_INDEX_MASK;
+    }
+    index->entries[slot].connection = NULL;
+    index->num_entries--;
+}
+
+static void hci_connection_index_add(hci_connection_index_t * index, uint16_t key, hci_connection_t * connection){
+    // keep at least one free slot to terminate probing, lookup falls back to linear search otherwise
+    if ((index->num_entries + 1u) >= HCI_CONNECTION_INDEX_SIZE) {
+        index->incomplete = true;
+        return;
+    }
+    uint16_t slot = key & HCI_CONNECTION_INDEX_MASK;
+    while (index->entries[slot].connection != NULL){
+        slot = (slot + 1u) & HCI_CONNECTION_INDEX_MASK;
+    }
+    index->entries[slot].connection = connection;
+    index->entries[slot].key = key;
+    index->num_entries++;
+}
+
+static void hci_connection_index_remove_connection(hci_connection_index_t * index, const hci_connection_t * connection){
+    uint16_t slot = 0;
+    while ((index->num_entries > 0u) && (slot < HCI_CONNECTION_INDEX_SIZE)){
+        if (index->entries[slot].connection == connection){
+            hci_connection_index_remove_slot(index, slot);
+        } else {
+            slot++;
+        }
+    }
+}
+
+static hci_connection_t * hci_connection_index_lookup_handle(hci_con_handle_t con_handle){
+    hci_connection_index_t * index = &hci_stack->connection_index_by_handle;
+    uint16_t slot = con_handle & HCI_CONNECTION_INDEX_MASK;
+    while (index->entries[slot].connection != NULL){
+        hci_connection_index_entry_t * entry = &index->entries[slot];
+        if ((entry->key == con_handle) && (entry->connection->con_handle == con_handle)){
+            return entry->connection;
+        }
+        slot = (slot + 1u) & HCI_CONNECTION_INDEX_MASK;
+    }
+    return NULL;
+}
+
+static hci_connection_t * hci_connection_index_lookup_address(uint16_t key, const bd_addr_t addr, bd_addr_type_t addr_type){
+    hci_connection_index_t * index = &hci_stack->connection_index_by_address;
+    uint16_t slot = key & HCI_CONNECTION_INDEX_MASK;
+    while (index->entries[slot].connection != NULL){
+        hci_connection_index_entry_t * entry = &index->entries[slot];
+        if (entry->key == key){
+            hci_connection_t * connection = entry->connection;
+            if ((connection->address_type == addr_type) && (memcmp(addr, connection->address, 6) == 0)){
+                return connection;
+            }
+            // collision
+        }
+        slot = (slot + 1u) & HCI_CONNECTION_INDEX_MASK;
+    }
+    return NULL;
+}
+
+static void hci_connection_index_add_handle(hci_connection_t * connection){
+    // connections without handle are not indexed
+    if (connection->con_handle == HCI_CON_HANDLE_INVALID) return;
+    hci_connection_index_add(&hci_stack->connection_index_by_handle, connection->con_handle, connection);
+}
+
+static void hci_connection_index_add_address(hci_connection_t * connection){
+    // only the most recent connection for an address is indexed, as it is found first in the connections list
+    uint16_t key = hci_connection_index_key_for_address(connection->address, connection->address_type);
+    hci_connection_t * indexed = hci_connection_index_lookup_address(key, connection->address, connection->address_type);
+    if (indexed != NULL){
+        hci_connection_index_remove_connection(&hci_stack->connection_index_by_address, indexed);
+    }
+    hci_connection_index_add(&hci_stack->connection_index_by_address, key, connection);
+}
+
+static void hci_connection_index_reset(void){
+    memset(&hci_stack->connection_index_by_handle,  0, sizeof(hci_connection_index_t));
+    memset(&hci_stack->connection_index_by_address, 0, sizeof(hci_connection_index_t));
+}
+
+static void hci_connection_index_rebuild(void){
+    hci_connection_index_reset();
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_stack->connections);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        hci_connection_t * connection = (hci_connection_t *) btstack_linked_list_iterator_next(&it);
+        hci_connection_index_add_handle(connection);
+        // first connection in list wins for shared addresses
+        uint16_t key = hci_connection_index_key_for_address(connection->address, connection->address_type);
+        if (hci_connection_index_lookup_address(key, connection->address, connection->address_type) == NULL){
+            hci_connection_index_add(&hci_stack->connection_index_by_address, key, connection);
+        }
+    }
+}
+
+static void hci_connection_index_remove_address(const hci_connection_t * connection){
+    hci_connection_index_remove_connection(&hci_stack->connection_index_by_address, connection);
+    // index next connection with same address
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_stack->connections);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        hci_connection_t * item = (hci_connection_t *) btstack_linked_list_iterator_next(&it);
+        if (item == connection) continue;
+        if (item->address_type != connection->address_type)  continue;
+        if (memcmp(item->address, connection->address, 6) != 0) continue;
+        hci_connection_index_add_address(item);
+        break;
+    }
+}
+
+static void hci_connection_index_remove(const hci_connection_t * connection){
+    // connections might have been skipped if index was full
+    if (hci_stack->connection_index_by_handle.incomplete || hci_stack->connection_index_by_address.incomplete){
+        hci_connection_index_rebuild();
+        return;
+    }
+    hci_connection_index_remove_connection(&hci_stack->connection_index_by_handle, connection);
+    hci_connection_index_remove_address(connection);
+}
+#endif
+
+static void hci_connection_set_con_handle(hci_connection_t * connection, hci_con_handle_t con_handle){
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_remove_connection(&hci_stack->connection_index_by_handle, connection);
+#endif
+    connection->con_handle = con_handle;
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_add_handle(connection);
+#endif
+}
+
+#if defined(ENABLE_LE_PERIPHERAL) && defined(ENABLE_LE_EXTENDED_ADVERTISING)
+static void hci_connection_set_address(hci_connection_t * connection, const bd_addr_t addr, bd_addr_type_t addr_type){
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_remove_address(connection);
+#endif
+    (void) memcpy(connection->address, addr, 6);
+    connection->address_type = addr_type;
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_add_address(connection);
+#endif
+}
+#endif
+
 /**
  * create connection for given address
  *
@@ -334,6 +511,9 @@ create_connection_for_bd_addr_and_type(const bd_addr_t addr, bd_addr_type_t addr
     conn->con_handle = HCI_CON_HANDLE_INVALID;
     conn->role = role;
     btstack_linked_list_add(&hci_stack->connections, (btstack_linked_item_t *) conn);
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_add_address(conn);
+#endif
 
     return conn;
 }
@@ -399,12 +579,32 @@ void hci_connections_get_iterator(btstack_linked_list_iterator_t *it){
     btstack_linked_list_iterator_init(it, &hci_stack->connections);
 }
 
+/**
+ * remove connection from connections list and free it
+ */
+static void hci_connection_free(hci_connection_t * connection){
+    btstack_linked_list_remove(&hci_stack->connections, (btstack_linked_item_t *) connection);
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_remove(connection);
+#endif
+    btstack_memory_hci_connection_free(connection);
+}
+
 /**
  * get connection for a given handle
  *
  * @return connection OR NULL, if not found
  */
 hci_connection_t * hci_connection_for_handle(hci_con_handle_t con_handle){
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    // connections without handle are not indexed, linear search if index is incomplete
+    if (con_handle != HCI_CON_HANDLE_INVALID){
+        hci_connection_t * connection = hci_connection_index_lookup_handle(con_handle);
+        if ((connection != NULL) || (hci_stack->connection_index_by_handle.incomplete == false)){
+            return connection;
+        }
+    }
+#endif
     btstack_linked_list_iterator_t it;
     btstack_linked_list_iterator_init(&it, &hci_stack->connections);
     while (btstack_linked_list_iterator_has_next(&it)){
@@ -422,6 +622,14 @@ hci_connection_t * hci_connection_for_handle(hci_con_handle_t con_handle){
  * @return connection OR NULL, if not found
  */
 hci_connection_t * hci_connection_for_bd_addr_and_type(const bd_addr_t  addr, bd_addr_type_t addr_type){
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    // linear search if index is incomplete
+    uint16_t key = hci_connection_index_key_for_address(addr, addr_type);
+    hci_connection_t * indexed = hci_connection_index_lookup_address(key, addr, addr_type);
+    if ((indexed != NULL) || (hci_stack->connection_index_by_address.incomplete == false)){
+        return indexed;
+    }
+#endif
     btstack_linked_list_iterator_t it;
     btstack_linked_list_iterator_init(&it, &hci_stack->connections);
     while (btstack_linked_list_iterator_has_next(&it)){
@@ -1352,8 +1560,7 @@ static void hci_shutdown_connection(hci_connection_t *connection){
 
     hci_connection_stop_timer(connection);
 
-    btstack_linked_list_remove(&hci_stack->connections, (btstack_linked_item_t *) connection);
-    btstack_memory_hci_connection_free( connection );
+    hci_connection_free(connection);
     
     // now it's gone
     hci_emit_nr_connections_changed();
@@ -2771,8 +2978,7 @@ static void hci_handle_connection_failed(hci_connection_t * conn, uint8_t status
 #endif
     
     // connection failed, remove entry
-    btstack_linked_list_remove(&hci_stack->connections, (btstack_linked_item_t *) conn);
-    btstack_memory_hci_connection_free( conn );
+    hci_connection_free(conn);
 
 #ifdef ENABLE_CLASSIC
     // notify client if dedicated bonding
@@ -3670,8 +3876,7 @@ static void hci_handle_le_connection_complete_event(const uint8_t * hci_event){
 	        bool cancelled_by_user = hci_stack->le_connecting_request == LE_CONNECTING_IDLE;
 	        if ((conn != NULL) && cancelled_by_user){
 	            // remove entry
-	            btstack_linked_list_remove(&hci_stack->connections, (btstack_linked_item_t *) conn);
-	            btstack_memory_hci_connection_free( conn );
+	            hci_connection_free(conn);
 	        }
 
 	        // emit GAP_SUBEVENT_LE_CONNECTION_COMPLETE for:
@@ -3735,8 +3940,7 @@ static void hci_handle_le_connection_complete_event(const uint8_t * hci_event){
             // set missing peer address + address type
             conn = hci_connection_for_handle(con_handle);
             if (conn != NULL){
-                memcpy(conn->address, addr, 6);
-                conn->address_type = addr_type;
+                hci_connection_set_address(conn, addr, addr_type);
             }
         }
         else
@@ -3765,7 +3969,7 @@ static void hci_handle_le_connection_complete_event(const uint8_t * hci_event){
 	}
 
 	conn->state = OPEN;
-	conn->con_handle             = con_handle;
+    hci_connection_set_con_handle(conn, con_handle);
     conn->le_connection_interval = conn_interval;
 
 #ifdef ENABLE_LE_ISOCHRONOUS_STREAMS
@@ -3858,7 +4062,7 @@ static void hci_handle_le_meta_event(uint8_t * packet, uint16_t size){
                     conn = create_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_UNKNOWN, HCI_ROLE_SLAVE);
                     if (conn != NULL){
                         conn->state = ANNOUNCED;
-                        conn->con_handle = handle;
+                        hci_connection_set_con_handle(conn, handle);
                     }
                 }
             }
@@ -4448,6 +4652,7 @@ static void hci_handle_disconnection_complete_event(uint8_t * packet, uint16_t s
 static void hci_handle_hardware_error_event(uint8_t * packet, uint16_t size){
     if (size < 3u) return;
     log_error("Hardware Error: 0x%02x", packet[2]);
+    hci_dump_snapshot();
     if (hci_stack->hardware_error_callback){
         (*hci_stack->hardware_error_callback)(packet[2]);
     } else {
@@ -4604,7 +4809,7 @@ static void event_handler(uint8_t *packet, uint16_t size){
                 }
                 if (hci_event_connection_complete_get_status(packet) == ERROR_CODE_SUCCESS){
                     conn->state = OPEN;
-                    conn->con_handle = little_endian_read_16(packet, 3);
+                    hci_connection_set_con_handle(conn, little_endian_read_16(packet, 3));
 
                     // trigger write supervision timeout if we're master
                     if ((hci_stack->link_supervision_timeout != HCI_LINK_SUPERVISION_TIMEOUT_DEFAULT) && (conn->role == HCI_ROLE_MASTER)){
@@ -4651,7 +4856,7 @@ static void event_handler(uint8_t *packet, uint16_t size){
             }
 
             conn->state = OPEN;
-            conn->con_handle = little_endian_read_16(packet, 3);            
+            hci_connection_set_con_handle(conn, little_endian_read_16(packet, 3));
 
             // update sco payload length for eSCO connections
             if (hci_event_synchronous_connection_complete_get_tx_packet_length(packet) > 0){
@@ -5420,6 +5625,9 @@ void hci_register_iso_packet_handler(btstack_packet_handler_t handler){
 static void hci_state_reset(void){
     // no connections yet
     hci_stack->connections = NULL;
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_reset();
+#endif
 
     // keep discoverable/connectable as this has been requested by the client(s)
     // hci_stack->discoverable = 0;
@@ -6438,30 +6646,34 @@ static void hci_host_num_completed_packets(void){
     hci_reserve_packet_buffer();
     uint8_t * packet = hci_get_outgoing_packet_buffer();
 
-    uint16_t size = 0;
+    uint16_t size = 4;  // opcode, param len, num handles
     uint16_t num_handles = 0;
-    packet[size++] = 0x35;
-    packet[size++] = 0x0c;
-    size++;  // skip param len
-    size++;  // skip num handles
 
     // add { handle, packets } entries
     btstack_linked_item_t * it;
     for (it = (btstack_linked_item_t *) hci_stack->connections; it ; it = it->next){
         hci_connection_t * connection = (hci_connection_t *) it;
         if (connection->num_packets_completed){
-            little_endian_store_16(packet, size, connection->con_handle);
-            size += 2;
-            little_endian_store_16(packet, size, connection->num_packets_completed);
-            size += 2;
-            //
+            if (num_handles == 0u){
+                // usually a single handle, create command with fixed layout
+                size = hci_cmd_serialize_host_number_of_completed_packets(packet, 1, connection->con_handle, connection->num_packets_completed);
+            } else {
+                little_endian_store_16(packet, size, connection->con_handle);
+                size += 2;
+                little_endian_store_16(packet, size, connection->num_packets_completed);
+                size += 2;
+            }
             num_handles++;
             connection->num_packets_completed = 0;
         }
     }    
 
-    packet[2] = size - 3;
-    packet[3] = num_handles;
+    if (num_handles != 1u){
+        packet[0] = 0x35;
+        packet[1] = 0x0c;
+        packet[2] = size - 3;
+        packet[3] = num_handles;
+    }
 
     hci_stack->host_completed_packets = 0;
 
@@ -7208,7 +7420,9 @@ static bool hci_run_general_gap_le(void){
 #ifdef ENABLE_LE_EXTENDED_ADVERTISING
         if (hci_le_extended_advertising_supported()){
             hci_stack->le_advertising_set_in_current_command = 0;
-            hci_send_cmd(&hci_le_set_extended_advertising_data, 0, 0x03, 0x01, hci_stack->le_advertisements_data_len, adv_data_clean);
+            hci_reserve_packet_buffer();
+            hci_cmd_serialize_le_set_extended_advertising_data(hci_stack->hci_packet_buffer, 0, 0x03, 0x01, hci_stack->le_advertisements_data_len, adv_data_clean);
+            hci_send_prepared_cmd_packet();
         } else
 #endif
         {
@@ -7288,7 +7502,9 @@ static bool hci_run_general_gap_le(void){
                     advertising_set->adv_data_pos += data_to_upload;
                 }
                 hci_stack->le_advertising_set_in_current_command = advertising_set->advertising_handle;
-                hci_send_cmd(&hci_le_set_extended_advertising_data, advertising_set->advertising_handle, operation, 0x01, data_to_upload, &advertising_set->adv_data[pos]);
+                hci_reserve_packet_buffer();
+                hci_cmd_serialize_le_set_extended_advertising_data(hci_stack->hci_packet_buffer, advertising_set->advertising_handle, operation, 0x01, (uint8_t) data_to_upload, &advertising_set->adv_data[pos]);
+                hci_send_prepared_cmd_packet();
                 return true;
             }
             if ((advertising_set->tasks & LE_ADVERTISEMENT_TASKS_SET_SCAN_DATA) != 0) {
@@ -8246,8 +8462,10 @@ static bool hci_run_general_pending_commands(void){
                     connection->gap_connection_tasks_pending &= ~GAP_CONNECTION_TASK_LE_SET_DATA_LENGTH;
                     connection->gap_connection_tasks_active  |= GAP_CONNECTION_TASK_LE_SET_DATA_LENGTH;
                     hci_stack->le_active_command_con_handle = connection->con_handle;
-                    hci_send_cmd(&hci_le_set_data_length, connection->con_handle,
-                                 connection->le_set_data_length_tx_octets, connection->le_set_data_length_tx_time);
+                    hci_reserve_packet_buffer();
+                    hci_cmd_serialize_le_set_data_length(hci_stack->hci_packet_buffer, connection->con_handle,
+                                                         connection->le_set_data_length_tx_octets, connection->le_set_data_length_tx_time);
+                    hci_send_prepared_cmd_packet();
                     return true;
                 }
 #endif
@@ -9369,8 +9587,7 @@ uint8_t gap_connect_cancel(void){
                     case SEND_CREATE_CONNECTION:
                         // skip sending create connection and emit event instead
                         hci_emit_le_connection_complete(conn->address_type, conn->address, 0, ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER);
-                        btstack_linked_list_remove(&hci_stack->connections, (btstack_linked_item_t *) conn);
-                        btstack_memory_hci_connection_free( conn );
+                        hci_connection_free(conn);
                         break;
                     case SENT_CREATE_CONNECTION:
                         // let hci_run_general_gap_le cancel outgoing connection
@@ -11737,35 +11954,35 @@ void hci_setup_test_connections_fuzz(void){
     // setup incoming Classic ACL connection with con handle 0x0001, 66:55:44:33:22:01
     addr[5] = 0x01;
     conn = create_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_ACL, HCI_ROLE_SLAVE);
-    conn->con_handle = addr[5];
+    hci_connection_set_con_handle(conn, addr[5]);
     conn->state = RECEIVED_CONNECTION_REQUEST;
     conn->sm_connection.sm_role = HCI_ROLE_SLAVE;
 
     // setup incoming Classic SCO connection with con handle 0x0002
     addr[5] = 0x02;
     conn = create_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_SCO, HCI_ROLE_SLAVE);
-    conn->con_handle = addr[5];
+    hci_connection_set_con_handle(conn, addr[5]);
     conn->state = RECEIVED_CONNECTION_REQUEST;
     conn->sm_connection.sm_role = HCI_ROLE_SLAVE;
 
     // setup ready Classic ACL connection with con handle 0x0003
     addr[5] = 0x03;
     conn = create_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_ACL, HCI_ROLE_SLAVE);
-    conn->con_handle = addr[5];
+    hci_connection_set_con_handle(conn, addr[5]);
     conn->state = OPEN;
     conn->sm_connection.sm_role = HCI_ROLE_SLAVE;
 
     // setup ready Classic SCO connection with con handle 0x0004
     addr[5] = 0x04;
     conn = create_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_SCO, HCI_ROLE_SLAVE);
-    conn->con_handle = addr[5];
+    hci_connection_set_con_handle(conn, addr[5]);
     conn->state = OPEN;
     conn->sm_connection.sm_role = HCI_ROLE_SLAVE;
 
     // setup ready LE ACL connection with con handle 0x005 and public address
     addr[5] = 0x05;
     conn = create_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_LE_PUBLIC, HCI_ROLE_SLAVE);
-    conn->con_handle = addr[5];
+    hci_connection_set_con_handle(conn, addr[5]);
     conn->state = OPEN;
     conn->sm_connection.sm_role = HCI_ROLE_SLAVE;
     conn->sm_connection.sm_connection_encrypted = 1;
@@ -11780,6 +11997,9 @@ void hci_free_connections_fuzz(void){
         btstack_linked_list_iterator_remove(&it);                                            // LCOV_EXCL_LINE
         btstack_memory_hci_connection_free(con);                                             // LCOV_EXCL_LINE
     }                                                                                        // LCOV_EXCL_LINE
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    hci_connection_index_reset();
+#endif
 }                                                                                            // LCOV_EXCL_LINE
 
 void hci_simulate_working_fuzz(void){
@@ -501,6 +501,12 @@ typedef struct sm_connection {
 #define ATT_REQUEST_BUFFER_SIZE HCI_ACL_PAYLOAD_SIZE
 #endif
 
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+#ifndef ATT_NOTIFICATION_COALESCING_BUFFER_SIZE
+#define ATT_NOTIFICATION_COALESCING_BUFFER_SIZE ATT_REQUEST_BUFFER_SIZE
+#endif
+#endif
+
 typedef enum {
     ATT_SERVER_IDLE,
     ATT_SERVER_REQUEST_RECEIVED,
@@ -539,6 +545,15 @@ typedef struct {
     uint16_t                request_size;
     uint8_t                 request_buffer[ATT_REQUEST_BUFFER_SIZE];
 
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+    // notifications queued within current connection interval as (handle, length, value) tuples
+    bool                    multiple_notifications_supported;
+    btstack_timer_source_t  notification_coalescing_timer;
+    btstack_context_callback_registration_t notification_coalescing_request;
+    uint16_t                notification_coalescing_size;
+    uint8_t                 notification_coalescing_buffer[ATT_NOTIFICATION_COALESCING_BUFFER_SIZE];
+#endif
+
 } att_server_t;
 
 #endif
@@ -556,6 +571,10 @@ typedef struct {
     l2cap_information_state_t information_state;
     uint16_t                  extended_feature_mask;
     uint16_t                  fixed_channels_supported;    // Core V5.3 - only first octet used
+#ifdef ENABLE_L2CAP_CHANNEL_INDEX
+    // dynamic l2cap channels on this connection, linked via l2cap_channel_t.connection_item
+    btstack_linked_list_t     channels;
+#endif
 } l2cap_state_t;
 
 //
@@ -763,6 +782,28 @@ typedef struct {
 
 } hci_connection_t;
 
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+
+// number of slots in connection index, must be a power of two and larger than the number of connections
+#ifndef HCI_CONNECTION_INDEX_SIZE
+#define HCI_CONNECTION_INDEX_SIZE 64
+#endif
+
+typedef struct {
+    hci_connection_t * connection;
+    uint16_t key;
+} hci_connection_index_entry_t;
+
+// open addressing hash table with linear probing, updated when connections are created, changed or freed
+typedef struct {
+    hci_connection_index_entry_t entries[HCI_CONNECTION_INDEX_SIZE];
+    uint16_t num_entries;
+    // connection could not be added as table was full, lookup falls back to linear search
+    bool     incomplete;
+} hci_connection_index_t;
+
+#endif
+
 typedef enum {
     HCI_ISO_TYPE_INVALID = 0,
     HCI_ISO_TYPE_BIS,
@@ -1109,6 +1150,12 @@ typedef struct {
     // list of existing baseband connections
     btstack_linked_list_t     connections;
 
+#ifdef ENABLE_HCI_CONNECTION_INDEX
+    // lookup caches for connections list
+    hci_connection_index_t    connection_index_by_handle;
+    hci_connection_index_t    connection_index_by_address;
+#endif
+
     /* callback to L2CAP layer */
     btstack_packet_handler_t acl_packet_handler;
 
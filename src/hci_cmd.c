@@ -303,6 +303,13 @@ uint16_t hci_cmd_create_from_template_with_vargs(uint8_t * hci_cmd_buffer, const
     return size;
 }
 
+void hci_cmd_store_variable_length_data(uint8_t * hci_cmd_buffer, uint16_t pos, const uint8_t * data, uint16_t len){
+    // avoid calling memcpy with NULL and size = 0 <- undefined behaviour
+    if (len > 0u){
+        (void)memcpy(&hci_cmd_buffer[pos], data, len);
+    }
+}
+
 /**
  *  Link Control Commands 
  */
@@ -758,6 +758,17 @@ uint16_t hci_cmd_create_from_template(uint8_t *hci_cmd_buffer, const hci_cmd_t *
  */
 uint16_t hci_cmd_create_from_template_with_vargs(uint8_t * hci_cmd_buffer, const hci_cmd_t * cmd, ...);
 
+/**
+ * Store variable length field 'V' for serializers in hci_cmd_serializer.h
+ * Not inlined, so that memcpy is called instead of being expanded for the bounded length
+ *
+ * @param hci_cmd_buffer for command
+ * @param pos of field
+ * @param data can be NULL if len == 0
+ * @param len of data
+ */
+void hci_cmd_store_variable_length_data(uint8_t * hci_cmd_buffer, uint16_t pos, const uint8_t * data, uint16_t len);
+
 #if defined __cplusplus
 }
 #endif
@@ -0,0 +1,5550 @@
+/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+
+
+/**
+ * HCI Command Serializer
+ *
+ * Typed alternative to hci_cmd_create_from_template for commands with fixed field layout.
+ * Fields are stored at offsets known at compile time, without parsing the format string
+ * or passing arguments via va_list.
+ *
+ * Note: Don't edit this file. It is generated by tool/hci_cmd_serializer_generator.py
+ *
+ */
+
+#ifndef HCI_CMD_SERIALIZER_H
+#define HCI_CMD_SERIALIZER_H
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#include "btstack_util.h"
+#include "hci_cmd.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* API_START */
+
+/**
+ * @brief Serialize hci_inquiry into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param lap
+ * @param inquiry_length
+ * @param num_responses
+ * @return size of HCI command
+ * @note: btstack_type 311
+ */
+static inline uint16_t hci_cmd_serialize_inquiry(uint8_t * buffer, uint32_t lap, uint8_t inquiry_length, uint8_t num_responses){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x01);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x01) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = (uint8_t) lap;
+    buffer[4u] = (uint8_t) (lap >> 8);
+    buffer[5u] = (uint8_t) (lap >> 16);
+    buffer[6u] = inquiry_length;
+    buffer[7u] = num_responses;
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_inquiry_cancel into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_inquiry_cancel(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x02);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x02) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_periodic_inquiry_mode into buffer
+ * @param buffer for HCI command of 12 bytes
+ * @param max_period_length
+ * @param min_period_length
+ * @param lap
+ * @param inquiry_length
+ * @param num_responses
+ * @return size of HCI command
+ * @note: btstack_type 22311
+ */
+static inline uint16_t hci_cmd_serialize_periodic_inquiry_mode(uint8_t * buffer, uint16_t max_period_length, uint16_t min_period_length, uint32_t lap, uint8_t inquiry_length, uint8_t num_responses){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x03);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x03) >> 8);
+    buffer[2] = 9u;
+    buffer[3u] = (uint8_t) max_period_length;
+    buffer[4u] = (uint8_t) (max_period_length >> 8);
+    buffer[5u] = (uint8_t) min_period_length;
+    buffer[6u] = (uint8_t) (min_period_length >> 8);
+    buffer[7u] = (uint8_t) lap;
+    buffer[8u] = (uint8_t) (lap >> 8);
+    buffer[9u] = (uint8_t) (lap >> 16);
+    buffer[10u] = inquiry_length;
+    buffer[11u] = num_responses;
+    return 12u;
+}
+
+/**
+ * @brief Serialize hci_exit_periodic_inquiry_mode into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_exit_periodic_inquiry_mode(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x04);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x04) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_create_connection into buffer
+ * @param buffer for HCI command of 16 bytes
+ * @param bd_addr
+ * @param packet_type
+ * @param page_scan_repetition_mode
+ * @param reserved
+ * @param clock_offset
+ * @param allow_role_switch
+ * @return size of HCI command
+ * @note: btstack_type B21121
+ */
+static inline uint16_t hci_cmd_serialize_create_connection(uint8_t * buffer, const bd_addr_t bd_addr, uint16_t packet_type, uint8_t page_scan_repetition_mode, uint8_t reserved, uint16_t clock_offset, uint8_t allow_role_switch){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x05);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x05) >> 8);
+    buffer[2] = 13u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = (uint8_t) packet_type;
+    buffer[10u] = (uint8_t) (packet_type >> 8);
+    buffer[11u] = page_scan_repetition_mode;
+    buffer[12u] = reserved;
+    buffer[13u] = (uint8_t) clock_offset;
+    buffer[14u] = (uint8_t) (clock_offset >> 8);
+    buffer[15u] = allow_role_switch;
+    return 16u;
+}
+
+/**
+ * @brief Serialize hci_disconnect into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param handle
+ * @param reason
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_disconnect(uint8_t * buffer, hci_con_handle_t handle, uint8_t reason){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x06);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x06) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = reason;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_create_connection_cancel into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_create_connection_cancel(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x08);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x08) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_accept_connection_request into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param bd_addr
+ * @param role
+ * @return size of HCI command
+ * @note: btstack_type B1
+ */
+static inline uint16_t hci_cmd_serialize_accept_connection_request(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t role){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x09);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x09) >> 8);
+    buffer[2] = 7u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = role;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_reject_connection_request into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param bd_addr
+ * @param reason
+ * @return size of HCI command
+ * @note: btstack_type B1
+ */
+static inline uint16_t hci_cmd_serialize_reject_connection_request(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t reason){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0a) >> 8);
+    buffer[2] = 7u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = reason;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_link_key_request_reply into buffer
+ * @param buffer for HCI command of 25 bytes
+ * @param bd_addr
+ * @param link_key
+ * @return size of HCI command
+ * @note: btstack_type BP
+ */
+static inline uint16_t hci_cmd_serialize_link_key_request_reply(uint8_t * buffer, const bd_addr_t bd_addr, const uint8_t * link_key){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0b) >> 8);
+    buffer[2] = 22u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    (void)memcpy(&buffer[9u], link_key, 16);
+    return 25u;
+}
+
+/**
+ * @brief Serialize hci_link_key_request_negative_reply into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_link_key_request_negative_reply(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0c) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_pin_code_request_reply into buffer
+ * @param buffer for HCI command of 26 bytes
+ * @param bd_addr
+ * @param pin_length
+ * @param pin
+ * @return size of HCI command
+ * @note: btstack_type B1P
+ */
+static inline uint16_t hci_cmd_serialize_pin_code_request_reply(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t pin_length, const uint8_t * pin){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0d) >> 8);
+    buffer[2] = 23u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = pin_length;
+    (void)memcpy(&buffer[10u], pin, 16);
+    return 26u;
+}
+
+/**
+ * @brief Serialize hci_pin_code_request_negative_reply into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_pin_code_request_negative_reply(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0e) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_change_connection_packet_type into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param handle
+ * @param packet_type
+ * @return size of HCI command
+ * @note: btstack_type H2
+ */
+static inline uint16_t hci_cmd_serialize_change_connection_packet_type(uint8_t * buffer, hci_con_handle_t handle, uint16_t packet_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0f) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) packet_type;
+    buffer[6u] = (uint8_t) (packet_type >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_authentication_requested into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_authentication_requested(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x11);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x11) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_set_connection_encryption into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param handle
+ * @param encryption_enable
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_set_connection_encryption(uint8_t * buffer, hci_con_handle_t handle, uint8_t encryption_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x13);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x13) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = encryption_enable;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_change_connection_link_key into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_change_connection_link_key(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x15);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x15) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_remote_name_request into buffer
+ * @param buffer for HCI command of 13 bytes
+ * @param bd_addr
+ * @param page_scan_repetition_mode
+ * @param reserved
+ * @param clock_offset
+ * @return size of HCI command
+ * @note: btstack_type B112
+ */
+static inline uint16_t hci_cmd_serialize_remote_name_request(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t page_scan_repetition_mode, uint8_t reserved, uint16_t clock_offset){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x19);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x19) >> 8);
+    buffer[2] = 10u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = page_scan_repetition_mode;
+    buffer[10u] = reserved;
+    buffer[11u] = (uint8_t) clock_offset;
+    buffer[12u] = (uint8_t) (clock_offset >> 8);
+    return 13u;
+}
+
+/**
+ * @brief Serialize hci_remote_name_request_cancel into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_remote_name_request_cancel(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x1A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x1A) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_read_remote_supported_features_command into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_remote_supported_features_command(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x1B);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x1B) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_read_remote_extended_features_command into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param arg1
+ * @param arg2
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_read_remote_extended_features_command(uint8_t * buffer, hci_con_handle_t arg1, uint8_t arg2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x1C);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x1C) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) arg1;
+    buffer[4u] = (uint8_t) (arg1 >> 8);
+    buffer[5u] = arg2;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_read_remote_version_information into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_remote_version_information(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x1D);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x1D) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_read_clock_offset into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_clock_offset(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x1F);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x1F) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_setup_synchronous_connection into buffer
+ * @param buffer for HCI command of 20 bytes
+ * @param handle
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param max_latency
+ * @param voice_settings
+ * @param retransmission_effort
+ * @param packet_type
+ * @return size of HCI command
+ * @note: btstack_type H442212
+ */
+static inline uint16_t hci_cmd_serialize_setup_synchronous_connection(uint8_t * buffer, hci_con_handle_t handle, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint16_t max_latency, uint16_t voice_settings, uint8_t retransmission_effort, uint16_t packet_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0028);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0028) >> 8);
+    buffer[2] = 17u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) transmit_bandwidth;
+    buffer[6u] = (uint8_t) (transmit_bandwidth >> 8);
+    buffer[7u] = (uint8_t) (transmit_bandwidth >> 16);
+    buffer[8u] = (uint8_t) (transmit_bandwidth >> 24);
+    buffer[9u] = (uint8_t) receive_bandwidth;
+    buffer[10u] = (uint8_t) (receive_bandwidth >> 8);
+    buffer[11u] = (uint8_t) (receive_bandwidth >> 16);
+    buffer[12u] = (uint8_t) (receive_bandwidth >> 24);
+    buffer[13u] = (uint8_t) max_latency;
+    buffer[14u] = (uint8_t) (max_latency >> 8);
+    buffer[15u] = (uint8_t) voice_settings;
+    buffer[16u] = (uint8_t) (voice_settings >> 8);
+    buffer[17u] = retransmission_effort;
+    buffer[18u] = (uint8_t) packet_type;
+    buffer[19u] = (uint8_t) (packet_type >> 8);
+    return 20u;
+}
+
+/**
+ * @brief Serialize hci_accept_synchronous_connection into buffer
+ * @param buffer for HCI command of 24 bytes
+ * @param bd_addr
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param max_latency
+ * @param voice_settings
+ * @param retransmission_effort
+ * @param packet_type
+ * @return size of HCI command
+ * @note: btstack_type B442212
+ */
+static inline uint16_t hci_cmd_serialize_accept_synchronous_connection(uint8_t * buffer, const bd_addr_t bd_addr, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint16_t max_latency, uint16_t voice_settings, uint8_t retransmission_effort, uint16_t packet_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x0029);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x0029) >> 8);
+    buffer[2] = 21u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = (uint8_t) transmit_bandwidth;
+    buffer[10u] = (uint8_t) (transmit_bandwidth >> 8);
+    buffer[11u] = (uint8_t) (transmit_bandwidth >> 16);
+    buffer[12u] = (uint8_t) (transmit_bandwidth >> 24);
+    buffer[13u] = (uint8_t) receive_bandwidth;
+    buffer[14u] = (uint8_t) (receive_bandwidth >> 8);
+    buffer[15u] = (uint8_t) (receive_bandwidth >> 16);
+    buffer[16u] = (uint8_t) (receive_bandwidth >> 24);
+    buffer[17u] = (uint8_t) max_latency;
+    buffer[18u] = (uint8_t) (max_latency >> 8);
+    buffer[19u] = (uint8_t) voice_settings;
+    buffer[20u] = (uint8_t) (voice_settings >> 8);
+    buffer[21u] = retransmission_effort;
+    buffer[22u] = (uint8_t) packet_type;
+    buffer[23u] = (uint8_t) (packet_type >> 8);
+    return 24u;
+}
+
+/**
+ * @brief Serialize hci_reject_synchronous_connection into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param bd_addr
+ * @param reason
+ * @return size of HCI command
+ * @note: btstack_type B1
+ */
+static inline uint16_t hci_cmd_serialize_reject_synchronous_connection(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t reason){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x002A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x002A) >> 8);
+    buffer[2] = 7u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = reason;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_io_capability_request_reply into buffer
+ * @param buffer for HCI command of 12 bytes
+ * @param bd_addr
+ * @param io_capability
+ * @param oob_data_present
+ * @param authentication_requirements
+ * @return size of HCI command
+ * @note: btstack_type B111
+ */
+static inline uint16_t hci_cmd_serialize_io_capability_request_reply(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t io_capability, uint8_t oob_data_present, uint8_t authentication_requirements){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x2b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x2b) >> 8);
+    buffer[2] = 9u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = io_capability;
+    buffer[10u] = oob_data_present;
+    buffer[11u] = authentication_requirements;
+    return 12u;
+}
+
+/**
+ * @brief Serialize hci_user_confirmation_request_reply into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_user_confirmation_request_reply(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x2c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x2c) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_user_confirmation_request_negative_reply into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_user_confirmation_request_negative_reply(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x2d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x2d) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_user_passkey_request_reply into buffer
+ * @param buffer for HCI command of 13 bytes
+ * @param bd_addr
+ * @param numeric_value
+ * @return size of HCI command
+ * @note: btstack_type B4
+ */
+static inline uint16_t hci_cmd_serialize_user_passkey_request_reply(uint8_t * buffer, const bd_addr_t bd_addr, uint32_t numeric_value){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x2e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x2e) >> 8);
+    buffer[2] = 10u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = (uint8_t) numeric_value;
+    buffer[10u] = (uint8_t) (numeric_value >> 8);
+    buffer[11u] = (uint8_t) (numeric_value >> 16);
+    buffer[12u] = (uint8_t) (numeric_value >> 24);
+    return 13u;
+}
+
+/**
+ * @brief Serialize hci_user_passkey_request_negative_reply into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_user_passkey_request_negative_reply(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x2f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x2f) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_remote_oob_data_request_reply into buffer
+ * @param buffer for HCI command of 41 bytes
+ * @param bd_addr
+ * @param c
+ * @param r
+ * @return size of HCI command
+ * @note: btstack_type BKK
+ */
+static inline uint16_t hci_cmd_serialize_remote_oob_data_request_reply(uint8_t * buffer, const bd_addr_t bd_addr, const uint8_t * c, const uint8_t * r){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x30);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x30) >> 8);
+    buffer[2] = 38u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    reverse_bytes(c, &buffer[9u], 16);
+    reverse_bytes(r, &buffer[25u], 16);
+    return 41u;
+}
+
+/**
+ * @brief Serialize hci_remote_oob_data_request_negative_reply into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_remote_oob_data_request_negative_reply(uint8_t * buffer, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x33);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x33) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_io_capability_request_negative_reply into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param bd_addr
+ * @param reason
+ * @return size of HCI command
+ * @note: btstack_type B1
+ */
+static inline uint16_t hci_cmd_serialize_io_capability_request_negative_reply(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t reason){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x34);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x34) >> 8);
+    buffer[2] = 7u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = reason;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_enhanced_setup_synchronous_connection into buffer
+ * @param buffer for HCI command of 62 bytes
+ * @param handle
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param transmit_coding_format_type
+ * @param transmit_coding_format_company
+ * @param transmit_coding_format_codec
+ * @param receive_coding_format_type
+ * @param receive_coding_format_company
+ * @param receive_coding_format_codec
+ * @param transmit_coding_frame_size
+ * @param receive_coding_frame_size
+ * @param input_bandwidth
+ * @param output_bandwidth
+ * @param input_coding_format_type
+ * @param input_coding_format_company
+ * @param input_coding_format_codec
+ * @param output_coding_format_type
+ * @param output_coding_format_company
+ * @param output_coding_format_codec
+ * @param input_coded_data_size
+ * @param outupt_coded_data_size
+ * @param input_pcm_data_format
+ * @param output_pcm_data_format
+ * @param input_pcm_sample_payload_msb_position
+ * @param output_pcm_sample_payload_msb_position
+ * @param input_data_path
+ * @param output_data_path
+ * @param input_transport_unit_size
+ * @param output_transport_unit_size
+ * @param max_latency
+ * @param packet_type
+ * @param retransmission_effort
+ * @return size of HCI command
+ * @note: btstack_type H4412212222441221222211111111221
+ */
+static inline uint16_t hci_cmd_serialize_enhanced_setup_synchronous_connection(uint8_t * buffer, hci_con_handle_t handle, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint8_t transmit_coding_format_type, uint16_t transmit_coding_format_company, uint16_t transmit_coding_format_codec, uint8_t receive_coding_format_type, uint16_t receive_coding_format_company, uint16_t receive_coding_format_codec, uint16_t transmit_coding_frame_size, uint16_t receive_coding_frame_size, uint32_t input_bandwidth, uint32_t output_bandwidth, uint8_t input_coding_format_type, uint16_t input_coding_format_company, uint16_t input_coding_format_codec, uint8_t output_coding_format_type, uint16_t output_coding_format_company, uint16_t output_coding_format_codec, uint16_t input_coded_data_size, uint16_t outupt_coded_data_size, uint8_t input_pcm_data_format, uint8_t output_pcm_data_format, uint8_t input_pcm_sample_payload_msb_position, uint8_t output_pcm_sample_payload_msb_position, uint8_t input_data_path, uint8_t output_data_path, uint8_t input_transport_unit_size, uint8_t output_transport_unit_size, uint16_t max_latency, uint16_t packet_type, uint8_t retransmission_effort){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x3d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x3d) >> 8);
+    buffer[2] = 59u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) transmit_bandwidth;
+    buffer[6u] = (uint8_t) (transmit_bandwidth >> 8);
+    buffer[7u] = (uint8_t) (transmit_bandwidth >> 16);
+    buffer[8u] = (uint8_t) (transmit_bandwidth >> 24);
+    buffer[9u] = (uint8_t) receive_bandwidth;
+    buffer[10u] = (uint8_t) (receive_bandwidth >> 8);
+    buffer[11u] = (uint8_t) (receive_bandwidth >> 16);
+    buffer[12u] = (uint8_t) (receive_bandwidth >> 24);
+    buffer[13u] = transmit_coding_format_type;
+    buffer[14u] = (uint8_t) transmit_coding_format_company;
+    buffer[15u] = (uint8_t) (transmit_coding_format_company >> 8);
+    buffer[16u] = (uint8_t) transmit_coding_format_codec;
+    buffer[17u] = (uint8_t) (transmit_coding_format_codec >> 8);
+    buffer[18u] = receive_coding_format_type;
+    buffer[19u] = (uint8_t) receive_coding_format_company;
+    buffer[20u] = (uint8_t) (receive_coding_format_company >> 8);
+    buffer[21u] = (uint8_t) receive_coding_format_codec;
+    buffer[22u] = (uint8_t) (receive_coding_format_codec >> 8);
+    buffer[23u] = (uint8_t) transmit_coding_frame_size;
+    buffer[24u] = (uint8_t) (transmit_coding_frame_size >> 8);
+    buffer[25u] = (uint8_t) receive_coding_frame_size;
+    buffer[26u] = (uint8_t) (receive_coding_frame_size >> 8);
+    buffer[27u] = (uint8_t) input_bandwidth;
+    buffer[28u] = (uint8_t) (input_bandwidth >> 8);
+    buffer[29u] = (uint8_t) (input_bandwidth >> 16);
+    buffer[30u] = (uint8_t) (input_bandwidth >> 24);
+    buffer[31u] = (uint8_t) output_bandwidth;
+    buffer[32u] = (uint8_t) (output_bandwidth >> 8);
+    buffer[33u] = (uint8_t) (output_bandwidth >> 16);
+    buffer[34u] = (uint8_t) (output_bandwidth >> 24);
+    buffer[35u] = input_coding_format_type;
+    buffer[36u] = (uint8_t) input_coding_format_company;
+    buffer[37u] = (uint8_t) (input_coding_format_company >> 8);
+    buffer[38u] = (uint8_t) input_coding_format_codec;
+    buffer[39u] = (uint8_t) (input_coding_format_codec >> 8);
+    buffer[40u] = output_coding_format_type;
+    buffer[41u] = (uint8_t) output_coding_format_company;
+    buffer[42u] = (uint8_t) (output_coding_format_company >> 8);
+    buffer[43u] = (uint8_t) output_coding_format_codec;
+    buffer[44u] = (uint8_t) (output_coding_format_codec >> 8);
+    buffer[45u] = (uint8_t) input_coded_data_size;
+    buffer[46u] = (uint8_t) (input_coded_data_size >> 8);
+    buffer[47u] = (uint8_t) outupt_coded_data_size;
+    buffer[48u] = (uint8_t) (outupt_coded_data_size >> 8);
+    buffer[49u] = input_pcm_data_format;
+    buffer[50u] = output_pcm_data_format;
+    buffer[51u] = input_pcm_sample_payload_msb_position;
+    buffer[52u] = output_pcm_sample_payload_msb_position;
+    buffer[53u] = input_data_path;
+    buffer[54u] = output_data_path;
+    buffer[55u] = input_transport_unit_size;
+    buffer[56u] = output_transport_unit_size;
+    buffer[57u] = (uint8_t) max_latency;
+    buffer[58u] = (uint8_t) (max_latency >> 8);
+    buffer[59u] = (uint8_t) packet_type;
+    buffer[60u] = (uint8_t) (packet_type >> 8);
+    buffer[61u] = retransmission_effort;
+    return 62u;
+}
+
+/**
+ * @brief Serialize hci_enhanced_accept_synchronous_connection into buffer
+ * @param buffer for HCI command of 66 bytes
+ * @param bd_addr
+ * @param transmit_bandwidth
+ * @param receive_bandwidth
+ * @param transmit_coding_format_type
+ * @param transmit_coding_format_company
+ * @param transmit_coding_format_codec
+ * @param receive_coding_format_type
+ * @param receive_coding_format_company
+ * @param receive_coding_format_codec
+ * @param transmit_coding_frame_size
+ * @param receive_coding_frame_size
+ * @param input_bandwidth
+ * @param output_bandwidth
+ * @param input_coding_format_type
+ * @param input_coding_format_company
+ * @param input_coding_format_codec
+ * @param output_coding_format_type
+ * @param output_coding_format_company
+ * @param output_coding_format_codec
+ * @param input_coded_data_size
+ * @param outupt_coded_data_size
+ * @param input_pcm_data_format
+ * @param output_pcm_data_format
+ * @param input_pcm_sample_payload_msb_position
+ * @param output_pcm_sample_payload_msb_position
+ * @param input_data_path
+ * @param output_data_path
+ * @param input_transport_unit_size
+ * @param output_transport_unit_size
+ * @param max_latency
+ * @param packet_type
+ * @param retransmission_effort
+ * @return size of HCI command
+ * @note: btstack_type B4412212222441221222211111111221
+ */
+static inline uint16_t hci_cmd_serialize_enhanced_accept_synchronous_connection(uint8_t * buffer, const bd_addr_t bd_addr, uint32_t transmit_bandwidth, uint32_t receive_bandwidth, uint8_t transmit_coding_format_type, uint16_t transmit_coding_format_company, uint16_t transmit_coding_format_codec, uint8_t receive_coding_format_type, uint16_t receive_coding_format_company, uint16_t receive_coding_format_codec, uint16_t transmit_coding_frame_size, uint16_t receive_coding_frame_size, uint32_t input_bandwidth, uint32_t output_bandwidth, uint8_t input_coding_format_type, uint16_t input_coding_format_company, uint16_t input_coding_format_codec, uint8_t output_coding_format_type, uint16_t output_coding_format_company, uint16_t output_coding_format_codec, uint16_t input_coded_data_size, uint16_t outupt_coded_data_size, uint8_t input_pcm_data_format, uint8_t output_pcm_data_format, uint8_t input_pcm_sample_payload_msb_position, uint8_t output_pcm_sample_payload_msb_position, uint8_t input_data_path, uint8_t output_data_path, uint8_t input_transport_unit_size, uint8_t output_transport_unit_size, uint16_t max_latency, uint16_t packet_type, uint8_t retransmission_effort){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x3e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x3e) >> 8);
+    buffer[2] = 63u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = (uint8_t) transmit_bandwidth;
+    buffer[10u] = (uint8_t) (transmit_bandwidth >> 8);
+    buffer[11u] = (uint8_t) (transmit_bandwidth >> 16);
+    buffer[12u] = (uint8_t) (transmit_bandwidth >> 24);
+    buffer[13u] = (uint8_t) receive_bandwidth;
+    buffer[14u] = (uint8_t) (receive_bandwidth >> 8);
+    buffer[15u] = (uint8_t) (receive_bandwidth >> 16);
+    buffer[16u] = (uint8_t) (receive_bandwidth >> 24);
+    buffer[17u] = transmit_coding_format_type;
+    buffer[18u] = (uint8_t) transmit_coding_format_company;
+    buffer[19u] = (uint8_t) (transmit_coding_format_company >> 8);
+    buffer[20u] = (uint8_t) transmit_coding_format_codec;
+    buffer[21u] = (uint8_t) (transmit_coding_format_codec >> 8);
+    buffer[22u] = receive_coding_format_type;
+    buffer[23u] = (uint8_t) receive_coding_format_company;
+    buffer[24u] = (uint8_t) (receive_coding_format_company >> 8);
+    buffer[25u] = (uint8_t) receive_coding_format_codec;
+    buffer[26u] = (uint8_t) (receive_coding_format_codec >> 8);
+    buffer[27u] = (uint8_t) transmit_coding_frame_size;
+    buffer[28u] = (uint8_t) (transmit_coding_frame_size >> 8);
+    buffer[29u] = (uint8_t) receive_coding_frame_size;
+    buffer[30u] = (uint8_t) (receive_coding_frame_size >> 8);
+    buffer[31u] = (uint8_t) input_bandwidth;
+    buffer[32u] = (uint8_t) (input_bandwidth >> 8);
+    buffer[33u] = (uint8_t) (input_bandwidth >> 16);
+    buffer[34u] = (uint8_t) (input_bandwidth >> 24);
+    buffer[35u] = (uint8_t) output_bandwidth;
+    buffer[36u] = (uint8_t) (output_bandwidth >> 8);
+    buffer[37u] = (uint8_t) (output_bandwidth >> 16);
+    buffer[38u] = (uint8_t) (output_bandwidth >> 24);
+    buffer[39u] = input_coding_format_type;
+    buffer[40u] = (uint8_t) input_coding_format_company;
+    buffer[41u] = (uint8_t) (input_coding_format_company >> 8);
+    buffer[42u] = (uint8_t) input_coding_format_codec;
+    buffer[43u] = (uint8_t) (input_coding_format_codec >> 8);
+    buffer[44u] = output_coding_format_type;
+    buffer[45u] = (uint8_t) output_coding_format_company;
+    buffer[46u] = (uint8_t) (output_coding_format_company >> 8);
+    buffer[47u] = (uint8_t) output_coding_format_codec;
+    buffer[48u] = (uint8_t) (output_coding_format_codec >> 8);
+    buffer[49u] = (uint8_t) input_coded_data_size;
+    buffer[50u] = (uint8_t) (input_coded_data_size >> 8);
+    buffer[51u] = (uint8_t) outupt_coded_data_size;
+    buffer[52u] = (uint8_t) (outupt_coded_data_size >> 8);
+    buffer[53u] = input_pcm_data_format;
+    buffer[54u] = output_pcm_data_format;
+    buffer[55u] = input_pcm_sample_payload_msb_position;
+    buffer[56u] = output_pcm_sample_payload_msb_position;
+    buffer[57u] = input_data_path;
+    buffer[58u] = output_data_path;
+    buffer[59u] = input_transport_unit_size;
+    buffer[60u] = output_transport_unit_size;
+    buffer[61u] = (uint8_t) max_latency;
+    buffer[62u] = (uint8_t) (max_latency >> 8);
+    buffer[63u] = (uint8_t) packet_type;
+    buffer[64u] = (uint8_t) (packet_type >> 8);
+    buffer[65u] = retransmission_effort;
+    return 66u;
+}
+
+/**
+ * @brief Serialize hci_remote_oob_extended_data_request_reply into buffer
+ * @param buffer for HCI command of 73 bytes
+ * @param bd_addr
+ * @param c_192
+ * @param r_192
+ * @param c_256
+ * @param r_256
+ * @return size of HCI command
+ * @note: btstack_type BKKKK
+ */
+static inline uint16_t hci_cmd_serialize_remote_oob_extended_data_request_reply(uint8_t * buffer, const bd_addr_t bd_addr, const uint8_t * c_192, const uint8_t * r_192, const uint8_t * c_256, const uint8_t * r_256){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_CONTROL, 0x45);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_CONTROL, 0x45) >> 8);
+    buffer[2] = 70u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    reverse_bytes(c_192, &buffer[9u], 16);
+    reverse_bytes(r_192, &buffer[25u], 16);
+    reverse_bytes(c_256, &buffer[41u], 16);
+    reverse_bytes(r_256, &buffer[57u], 16);
+    return 73u;
+}
+
+/**
+ * @brief Serialize hci_hold_mode into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param handle
+ * @param hold_mode_max_interval
+ * @param hold_mode_min_interval
+ * @return size of HCI command
+ * @note: btstack_type H22
+ */
+static inline uint16_t hci_cmd_serialize_hold_mode(uint8_t * buffer, hci_con_handle_t handle, uint16_t hold_mode_max_interval, uint16_t hold_mode_min_interval){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x01);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x01) >> 8);
+    buffer[2] = 6u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) hold_mode_max_interval;
+    buffer[6u] = (uint8_t) (hold_mode_max_interval >> 8);
+    buffer[7u] = (uint8_t) hold_mode_min_interval;
+    buffer[8u] = (uint8_t) (hold_mode_min_interval >> 8);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_sniff_mode into buffer
+ * @param buffer for HCI command of 13 bytes
+ * @param handle
+ * @param sniff_max_interval
+ * @param sniff_min_interval
+ * @param sniff_attempt
+ * @param sniff_timeout
+ * @return size of HCI command
+ * @note: btstack_type H2222
+ */
+static inline uint16_t hci_cmd_serialize_sniff_mode(uint8_t * buffer, hci_con_handle_t handle, uint16_t sniff_max_interval, uint16_t sniff_min_interval, uint16_t sniff_attempt, uint16_t sniff_timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x03);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x03) >> 8);
+    buffer[2] = 10u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) sniff_max_interval;
+    buffer[6u] = (uint8_t) (sniff_max_interval >> 8);
+    buffer[7u] = (uint8_t) sniff_min_interval;
+    buffer[8u] = (uint8_t) (sniff_min_interval >> 8);
+    buffer[9u] = (uint8_t) sniff_attempt;
+    buffer[10u] = (uint8_t) (sniff_attempt >> 8);
+    buffer[11u] = (uint8_t) sniff_timeout;
+    buffer[12u] = (uint8_t) (sniff_timeout >> 8);
+    return 13u;
+}
+
+/**
+ * @brief Serialize hci_exit_sniff_mode into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_exit_sniff_mode(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x04);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x04) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_park_state into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @return size of HCI command
+ * @note: btstack_type H22
+ */
+static inline uint16_t hci_cmd_serialize_park_state(uint8_t * buffer, hci_con_handle_t arg1, uint16_t arg2, uint16_t arg3){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x05);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x05) >> 8);
+    buffer[2] = 6u;
+    buffer[3u] = (uint8_t) arg1;
+    buffer[4u] = (uint8_t) (arg1 >> 8);
+    buffer[5u] = (uint8_t) arg2;
+    buffer[6u] = (uint8_t) (arg2 >> 8);
+    buffer[7u] = (uint8_t) arg3;
+    buffer[8u] = (uint8_t) (arg3 >> 8);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_exit_park_state into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_exit_park_state(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x06);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x06) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_qos_setup into buffer
+ * @param buffer for HCI command of 23 bytes
+ * @param handle
+ * @param flags
+ * @param service_type
+ * @param token_rate
+ * @param peak_bandwith
+ * @param latency
+ * @param delay_variation
+ * @return size of HCI command
+ * @note: btstack_type H114444
+ */
+static inline uint16_t hci_cmd_serialize_qos_setup(uint8_t * buffer, hci_con_handle_t handle, uint8_t flags, uint8_t service_type, uint32_t token_rate, uint32_t peak_bandwith, uint32_t latency, uint32_t delay_variation){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x07);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x07) >> 8);
+    buffer[2] = 20u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = flags;
+    buffer[6u] = service_type;
+    buffer[7u] = (uint8_t) token_rate;
+    buffer[8u] = (uint8_t) (token_rate >> 8);
+    buffer[9u] = (uint8_t) (token_rate >> 16);
+    buffer[10u] = (uint8_t) (token_rate >> 24);
+    buffer[11u] = (uint8_t) peak_bandwith;
+    buffer[12u] = (uint8_t) (peak_bandwith >> 8);
+    buffer[13u] = (uint8_t) (peak_bandwith >> 16);
+    buffer[14u] = (uint8_t) (peak_bandwith >> 24);
+    buffer[15u] = (uint8_t) latency;
+    buffer[16u] = (uint8_t) (latency >> 8);
+    buffer[17u] = (uint8_t) (latency >> 16);
+    buffer[18u] = (uint8_t) (latency >> 24);
+    buffer[19u] = (uint8_t) delay_variation;
+    buffer[20u] = (uint8_t) (delay_variation >> 8);
+    buffer[21u] = (uint8_t) (delay_variation >> 16);
+    buffer[22u] = (uint8_t) (delay_variation >> 24);
+    return 23u;
+}
+
+/**
+ * @brief Serialize hci_role_discovery into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_role_discovery(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x09);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x09) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_switch_role_command into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param bd_addr
+ * @param role
+ * @return size of HCI command
+ * @note: btstack_type B1
+ */
+static inline uint16_t hci_cmd_serialize_switch_role_command(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t role){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x0b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x0b) >> 8);
+    buffer[2] = 7u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = role;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_read_link_policy_settings into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_link_policy_settings(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x0c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x0c) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_write_link_policy_settings into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param handle
+ * @param settings
+ * @return size of HCI command
+ * @note: btstack_type H2
+ */
+static inline uint16_t hci_cmd_serialize_write_link_policy_settings(uint8_t * buffer, hci_con_handle_t handle, uint16_t settings){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x0d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x0d) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) settings;
+    buffer[6u] = (uint8_t) (settings >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_sniff_subrating into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param handle
+ * @param max_latency
+ * @param min_remote_timeout
+ * @param min_local_timeout
+ * @return size of HCI command
+ * @note: btstack_type H222
+ */
+static inline uint16_t hci_cmd_serialize_sniff_subrating(uint8_t * buffer, hci_con_handle_t handle, uint16_t max_latency, uint16_t min_remote_timeout, uint16_t min_local_timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x11);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x11) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) max_latency;
+    buffer[6u] = (uint8_t) (max_latency >> 8);
+    buffer[7u] = (uint8_t) min_remote_timeout;
+    buffer[8u] = (uint8_t) (min_remote_timeout >> 8);
+    buffer[9u] = (uint8_t) min_local_timeout;
+    buffer[10u] = (uint8_t) (min_local_timeout >> 8);
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_write_default_link_policy_setting into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param policy
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_write_default_link_policy_setting(uint8_t * buffer, uint16_t policy){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x0F);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x0F) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) policy;
+    buffer[4u] = (uint8_t) (policy >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_flow_specification into buffer
+ * @param buffer for HCI command of 24 bytes
+ * @param handle
+ * @param unused
+ * @param flow_direction
+ * @param service_type
+ * @param token_rate
+ * @param token_bucket_size
+ * @param peak_bandwidth
+ * @param access_latency
+ * @return size of HCI command
+ * @note: btstack_type H1114444
+ */
+static inline uint16_t hci_cmd_serialize_flow_specification(uint8_t * buffer, hci_con_handle_t handle, uint8_t unused, uint8_t flow_direction, uint8_t service_type, uint32_t token_rate, uint32_t token_bucket_size, uint32_t peak_bandwidth, uint32_t access_latency){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LINK_POLICY, 0x10);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LINK_POLICY, 0x10) >> 8);
+    buffer[2] = 21u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = unused;
+    buffer[6u] = flow_direction;
+    buffer[7u] = service_type;
+    buffer[8u] = (uint8_t) token_rate;
+    buffer[9u] = (uint8_t) (token_rate >> 8);
+    buffer[10u] = (uint8_t) (token_rate >> 16);
+    buffer[11u] = (uint8_t) (token_rate >> 24);
+    buffer[12u] = (uint8_t) token_bucket_size;
+    buffer[13u] = (uint8_t) (token_bucket_size >> 8);
+    buffer[14u] = (uint8_t) (token_bucket_size >> 16);
+    buffer[15u] = (uint8_t) (token_bucket_size >> 24);
+    buffer[16u] = (uint8_t) peak_bandwidth;
+    buffer[17u] = (uint8_t) (peak_bandwidth >> 8);
+    buffer[18u] = (uint8_t) (peak_bandwidth >> 16);
+    buffer[19u] = (uint8_t) (peak_bandwidth >> 24);
+    buffer[20u] = (uint8_t) access_latency;
+    buffer[21u] = (uint8_t) (access_latency >> 8);
+    buffer[22u] = (uint8_t) (access_latency >> 16);
+    buffer[23u] = (uint8_t) (access_latency >> 24);
+    return 24u;
+}
+
+/**
+ * @brief Serialize hci_set_event_mask into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param event_mask_lower_octets
+ * @param event_mask_higher_octets
+ * @return size of HCI command
+ * @note: btstack_type 44
+ */
+static inline uint16_t hci_cmd_serialize_set_event_mask(uint8_t * buffer, uint32_t event_mask_lower_octets, uint32_t event_mask_higher_octets){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x01);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x01) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = (uint8_t) event_mask_lower_octets;
+    buffer[4u] = (uint8_t) (event_mask_lower_octets >> 8);
+    buffer[5u] = (uint8_t) (event_mask_lower_octets >> 16);
+    buffer[6u] = (uint8_t) (event_mask_lower_octets >> 24);
+    buffer[7u] = (uint8_t) event_mask_higher_octets;
+    buffer[8u] = (uint8_t) (event_mask_higher_octets >> 8);
+    buffer[9u] = (uint8_t) (event_mask_higher_octets >> 16);
+    buffer[10u] = (uint8_t) (event_mask_higher_octets >> 24);
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_reset into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_reset(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x03);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x03) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_flush into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_flush(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x08);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x08) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_read_pin_type into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_pin_type(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x09);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x09) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_pin_type into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_pin_type(uint8_t * buffer, uint8_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x0A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x0A) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = handle;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_delete_stored_link_key into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param bd_addr
+ * @param delete_all_flags
+ * @return size of HCI command
+ * @note: btstack_type B1
+ */
+static inline uint16_t hci_cmd_serialize_delete_stored_link_key(uint8_t * buffer, const bd_addr_t bd_addr, uint8_t delete_all_flags){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x12);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x12) >> 8);
+    buffer[2] = 7u;
+    reverse_bd_addr(bd_addr, &buffer[3u]);
+    buffer[9u] = delete_all_flags;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_write_local_name into buffer
+ * @param buffer for HCI command of 251 bytes
+ * @param local_name
+ * @return size of HCI command
+ * @note: btstack_type N
+ */
+static inline uint16_t hci_cmd_serialize_write_local_name(uint8_t * buffer, const char * local_name){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x13);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x13) >> 8);
+    buffer[2] = 248u;
+    uint16_t local_name_len = (uint16_t) btstack_min((uint32_t) strlen(local_name), 248u);
+    (void)memcpy(&buffer[3u], local_name, local_name_len);
+    memset(&buffer[3u + local_name_len], 0, 248u - local_name_len);
+    return 251u;
+}
+
+/**
+ * @brief Serialize hci_read_local_name into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_local_name(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x14);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x14) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_page_timeout into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_page_timeout(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x17);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x17) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_page_timeout into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param page_timeout
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_write_page_timeout(uint8_t * buffer, uint16_t page_timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x18);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x18) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) page_timeout;
+    buffer[4u] = (uint8_t) (page_timeout >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_write_scan_enable into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param scan_enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_scan_enable(uint8_t * buffer, uint8_t scan_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1A) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = scan_enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_read_page_scan_activity into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_page_scan_activity(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1B);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1B) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_page_scan_activity into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param page_scan_interval
+ * @param page_scan_window
+ * @return size of HCI command
+ * @note: btstack_type 22
+ */
+static inline uint16_t hci_cmd_serialize_write_page_scan_activity(uint8_t * buffer, uint16_t page_scan_interval, uint16_t page_scan_window){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1C);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1C) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) page_scan_interval;
+    buffer[4u] = (uint8_t) (page_scan_interval >> 8);
+    buffer[5u] = (uint8_t) page_scan_window;
+    buffer[6u] = (uint8_t) (page_scan_window >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_read_inquiry_scan_activity into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_inquiry_scan_activity(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1D);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1D) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_inquiry_scan_activity into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param inquiry_scan_interval
+ * @param inquiry_scan_window
+ * @return size of HCI command
+ * @note: btstack_type 22
+ */
+static inline uint16_t hci_cmd_serialize_write_inquiry_scan_activity(uint8_t * buffer, uint16_t inquiry_scan_interval, uint16_t inquiry_scan_window){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1E);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x1E) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) inquiry_scan_interval;
+    buffer[4u] = (uint8_t) (inquiry_scan_interval >> 8);
+    buffer[5u] = (uint8_t) inquiry_scan_window;
+    buffer[6u] = (uint8_t) (inquiry_scan_window >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_write_authentication_enable into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param authentication_enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_authentication_enable(uint8_t * buffer, uint8_t authentication_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x20);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x20) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = authentication_enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_write_automatic_flush_timeout into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param handle
+ * @param timeout
+ * @return size of HCI command
+ * @note: btstack_type H2
+ */
+static inline uint16_t hci_cmd_serialize_write_automatic_flush_timeout(uint8_t * buffer, hci_con_handle_t handle, uint16_t timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x28);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x28) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) timeout;
+    buffer[6u] = (uint8_t) (timeout >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_write_class_of_device into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param class_of_device
+ * @return size of HCI command
+ * @note: btstack_type 3
+ */
+static inline uint16_t hci_cmd_serialize_write_class_of_device(uint8_t * buffer, uint32_t class_of_device){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x24);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x24) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) class_of_device;
+    buffer[4u] = (uint8_t) (class_of_device >> 8);
+    buffer[5u] = (uint8_t) (class_of_device >> 16);
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_read_num_broadcast_retransmissions into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_num_broadcast_retransmissions(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x29);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x29) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_num_broadcast_retransmissions into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param num_broadcast_retransmissions
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_num_broadcast_retransmissions(uint8_t * buffer, uint8_t num_broadcast_retransmissions){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x2a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x2a) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = num_broadcast_retransmissions;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_read_transmit_power_level into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param type
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_read_transmit_power_level(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x2D);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x2D) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = type;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_write_synchronous_flow_control_enable into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param synchronous_flow_control_enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_synchronous_flow_control_enable(uint8_t * buffer, uint8_t synchronous_flow_control_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x2f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x2f) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = synchronous_flow_control_enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_set_controller_to_host_flow_control into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param flow_control_enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_set_controller_to_host_flow_control(uint8_t * buffer, uint8_t flow_control_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x31);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x31) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = flow_control_enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_host_buffer_size into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param host_acl_data_packet_length
+ * @param host_synchronous_data_packet_length
+ * @param host_total_num_acl_data_packets
+ * @param host_total_num_synchronous_data_packets
+ * @return size of HCI command
+ * @note: btstack_type 2122
+ */
+static inline uint16_t hci_cmd_serialize_host_buffer_size(uint8_t * buffer, uint16_t host_acl_data_packet_length, uint8_t host_synchronous_data_packet_length, uint16_t host_total_num_acl_data_packets, uint16_t host_total_num_synchronous_data_packets){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x33);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x33) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = (uint8_t) host_acl_data_packet_length;
+    buffer[4u] = (uint8_t) (host_acl_data_packet_length >> 8);
+    buffer[5u] = host_synchronous_data_packet_length;
+    buffer[6u] = (uint8_t) host_total_num_acl_data_packets;
+    buffer[7u] = (uint8_t) (host_total_num_acl_data_packets >> 8);
+    buffer[8u] = (uint8_t) host_total_num_synchronous_data_packets;
+    buffer[9u] = (uint8_t) (host_total_num_synchronous_data_packets >> 8);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_host_number_of_completed_packets into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param number_of_handles
+ * @param connection_handle
+ * @param host_num_of_completed_packets
+ * @return size of HCI command
+ * @note: btstack_type 1H2
+ */
+static inline uint16_t hci_cmd_serialize_host_number_of_completed_packets(uint8_t * buffer, uint8_t number_of_handles, hci_con_handle_t connection_handle, uint16_t host_num_of_completed_packets){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x35);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x35) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = number_of_handles;
+    buffer[4u] = (uint8_t) connection_handle;
+    buffer[5u] = (uint8_t) (connection_handle >> 8);
+    buffer[6u] = (uint8_t) host_num_of_completed_packets;
+    buffer[7u] = (uint8_t) (host_num_of_completed_packets >> 8);
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_read_link_supervision_timeout into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_link_supervision_timeout(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x36);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x36) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_write_link_supervision_timeout into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param handle
+ * @param timeout
+ * @return size of HCI command
+ * @note: btstack_type H2
+ */
+static inline uint16_t hci_cmd_serialize_write_link_supervision_timeout(uint8_t * buffer, hci_con_handle_t handle, uint16_t timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x37);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x37) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = (uint8_t) timeout;
+    buffer[6u] = (uint8_t) (timeout >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_write_current_iac_lap_two_iacs into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param num_current_iac
+ * @param iac_lap1
+ * @param iac_lap2
+ * @return size of HCI command
+ * @note: btstack_type 133
+ */
+static inline uint16_t hci_cmd_serialize_write_current_iac_lap_two_iacs(uint8_t * buffer, uint8_t num_current_iac, uint32_t iac_lap1, uint32_t iac_lap2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x3A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x3A) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = num_current_iac;
+    buffer[4u] = (uint8_t) iac_lap1;
+    buffer[5u] = (uint8_t) (iac_lap1 >> 8);
+    buffer[6u] = (uint8_t) (iac_lap1 >> 16);
+    buffer[7u] = (uint8_t) iac_lap2;
+    buffer[8u] = (uint8_t) (iac_lap2 >> 8);
+    buffer[9u] = (uint8_t) (iac_lap2 >> 16);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_write_inquiry_mode into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param arg1
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_inquiry_mode(uint8_t * buffer, uint8_t arg1){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x45);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x45) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = arg1;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_write_page_scan_type into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param page_scan_type
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_page_scan_type(uint8_t * buffer, uint8_t page_scan_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x47);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x47) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = page_scan_type;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_write_extended_inquiry_response into buffer
+ * @param buffer for HCI command of 244 bytes
+ * @param fec_required
+ * @param exstended_inquiry_response
+ * @return size of HCI command
+ * @note: btstack_type 1E
+ */
+static inline uint16_t hci_cmd_serialize_write_extended_inquiry_response(uint8_t * buffer, uint8_t fec_required, const uint8_t * exstended_inquiry_response){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x52);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x52) >> 8);
+    buffer[2] = 241u;
+    buffer[3u] = fec_required;
+    (void)memcpy(&buffer[4u], exstended_inquiry_response, 240);
+    return 244u;
+}
+
+/**
+ * @brief Serialize hci_write_simple_pairing_mode into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param mode
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_simple_pairing_mode(uint8_t * buffer, uint8_t mode){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x56);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x56) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = mode;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_read_local_oob_data into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_local_oob_data(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x57);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x57) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_inquiry_response_transmit_power_level into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_inquiry_response_transmit_power_level(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x58);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x58) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_inquiry_transmit_power_level into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param arg1
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_inquiry_transmit_power_level(uint8_t * buffer, uint8_t arg1){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x59);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x59) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = arg1;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_write_default_erroneous_data_reporting into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param mode
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_default_erroneous_data_reporting(uint8_t * buffer, uint8_t mode){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x5B);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x5B) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = mode;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_set_event_mask_2 into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param event_mask_page_2_lower_octets
+ * @param event_mask_page_2_higher_octets
+ * @return size of HCI command
+ * @note: btstack_type 44
+ */
+static inline uint16_t hci_cmd_serialize_set_event_mask_2(uint8_t * buffer, uint32_t event_mask_page_2_lower_octets, uint32_t event_mask_page_2_higher_octets){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x63);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x63) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = (uint8_t) event_mask_page_2_lower_octets;
+    buffer[4u] = (uint8_t) (event_mask_page_2_lower_octets >> 8);
+    buffer[5u] = (uint8_t) (event_mask_page_2_lower_octets >> 16);
+    buffer[6u] = (uint8_t) (event_mask_page_2_lower_octets >> 24);
+    buffer[7u] = (uint8_t) event_mask_page_2_higher_octets;
+    buffer[8u] = (uint8_t) (event_mask_page_2_higher_octets >> 8);
+    buffer[9u] = (uint8_t) (event_mask_page_2_higher_octets >> 16);
+    buffer[10u] = (uint8_t) (event_mask_page_2_higher_octets >> 24);
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_read_le_host_supported into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_le_host_supported(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x6c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x6c) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_le_host_supported into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param le_supported_host
+ * @param simultaneous_le_host
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_write_le_host_supported(uint8_t * buffer, uint8_t le_supported_host, uint8_t simultaneous_le_host){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x6d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x6d) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = le_supported_host;
+    buffer[4u] = simultaneous_le_host;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_write_secure_connections_host_support into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param secure_connections_host_support
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_secure_connections_host_support(uint8_t * buffer, uint8_t secure_connections_host_support){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7a) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = secure_connections_host_support;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_read_local_extended_oob_data into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_local_extended_oob_data(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7d) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_extended_page_timeout into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_extended_page_timeout(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7e) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_extended_page_timeout into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param extended_page_timeout
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_write_extended_page_timeout(uint8_t * buffer, uint16_t extended_page_timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x7f) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) extended_page_timeout;
+    buffer[4u] = (uint8_t) (extended_page_timeout >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_read_extended_inquiry_length into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_extended_inquiry_length(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x80);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x80) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_extended_inquiry_length into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param extended_inquiry_length
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_write_extended_inquiry_length(uint8_t * buffer, uint16_t extended_inquiry_length){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x81);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x81) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) extended_inquiry_length;
+    buffer[4u] = (uint8_t) (extended_inquiry_length >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_set_ecosystem_base_interval into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param interval
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_set_ecosystem_base_interval(uint8_t * buffer, uint16_t interval){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x82);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x82) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) interval;
+    buffer[4u] = (uint8_t) (interval >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_configure_data_path into buffer
+ * @param buffer for HCI command of up to 261 bytes
+ * @param data_path_direction
+ * @param data_path_id
+ * @param vendor_specific_config_length
+ * @param vendor_specific_config
+ * @return size of HCI command
+ * @note: btstack_type 11JV
+ */
+static inline uint16_t hci_cmd_serialize_configure_data_path(uint8_t * buffer, uint8_t data_path_direction, uint8_t data_path_id, uint8_t vendor_specific_config_length, const uint8_t * vendor_specific_config){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x83);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x83) >> 8);
+    buffer[3u] = data_path_direction;
+    buffer[4u] = data_path_id;
+    buffer[5u] = vendor_specific_config_length;
+    hci_cmd_store_variable_length_data(buffer, 6u, vendor_specific_config, vendor_specific_config_length);
+    uint16_t pos = 6u + vendor_specific_config_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_set_min_encryption_key_size into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param min_encryption_key_size
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_set_min_encryption_key_size(uint8_t * buffer, uint8_t min_encryption_key_size){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x84);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_CONTROLLER_BASEBAND, 0x84) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = min_encryption_key_size;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_read_loopback_mode into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_loopback_mode(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_TESTING, 0x01);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_TESTING, 0x01) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_loopback_mode into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param loopback_mode
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_loopback_mode(uint8_t * buffer, uint8_t loopback_mode){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_TESTING, 0x02);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_TESTING, 0x02) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = loopback_mode;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_enable_device_under_test_mode into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_enable_device_under_test_mode(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_TESTING, 0x03);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_TESTING, 0x03) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_write_simple_pairing_debug_mode into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param simple_pairing_debug_mode
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_write_simple_pairing_debug_mode(uint8_t * buffer, uint8_t simple_pairing_debug_mode){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_TESTING, 0x04);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_TESTING, 0x04) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = simple_pairing_debug_mode;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_write_secure_connections_test_mode into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param handle
+ * @param dm1_acl_u_mode
+ * @param esco_loopback_mode
+ * @return size of HCI command
+ * @note: btstack_type H11
+ */
+static inline uint16_t hci_cmd_serialize_write_secure_connections_test_mode(uint8_t * buffer, hci_con_handle_t handle, uint8_t dm1_acl_u_mode, uint8_t esco_loopback_mode){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_TESTING, 0x0a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_TESTING, 0x0a) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = dm1_acl_u_mode;
+    buffer[6u] = esco_loopback_mode;
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_read_local_version_information into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_local_version_information(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x01);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x01) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_local_supported_commands into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_local_supported_commands(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x02);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x02) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_local_supported_features into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_local_supported_features(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x03);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x03) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_buffer_size into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_buffer_size(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x05);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x05) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_bd_addr into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_read_bd_addr(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x09);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_INFORMATIONAL_PARAMETERS, 0x09) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_read_failed_contact_counter into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_failed_contact_counter(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x01);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x01) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_reset_failed_contact_counter into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_reset_failed_contact_counter(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x02);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x02) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_read_link_quality into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_link_quality(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x03);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x03) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_read_rssi into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_rssi(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x05);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x05) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_read_clock into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param handle
+ * @param which_clock
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_read_clock(uint8_t * buffer, hci_con_handle_t handle, uint8_t which_clock){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x07);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x07) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    buffer[5u] = which_clock;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_read_encryption_key_size into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_read_encryption_key_size(uint8_t * buffer, hci_con_handle_t handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x08);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_STATUS_PARAMETERS, 0x08) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) handle;
+    buffer[4u] = (uint8_t) (handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_set_event_mask into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param event_mask_lower_octets
+ * @param event_mask_higher_octets
+ * @return size of HCI command
+ * @note: btstack_type 44
+ */
+static inline uint16_t hci_cmd_serialize_le_set_event_mask(uint8_t * buffer, uint32_t event_mask_lower_octets, uint32_t event_mask_higher_octets){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x01);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x01) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = (uint8_t) event_mask_lower_octets;
+    buffer[4u] = (uint8_t) (event_mask_lower_octets >> 8);
+    buffer[5u] = (uint8_t) (event_mask_lower_octets >> 16);
+    buffer[6u] = (uint8_t) (event_mask_lower_octets >> 24);
+    buffer[7u] = (uint8_t) event_mask_higher_octets;
+    buffer[8u] = (uint8_t) (event_mask_higher_octets >> 8);
+    buffer[9u] = (uint8_t) (event_mask_higher_octets >> 16);
+    buffer[10u] = (uint8_t) (event_mask_higher_octets >> 24);
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_le_read_buffer_size into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_buffer_size(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x02);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x02) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_local_supported_features into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_local_supported_features(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x03);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x03) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_set_random_address into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param random_bd_addr
+ * @return size of HCI command
+ * @note: btstack_type B
+ */
+static inline uint16_t hci_cmd_serialize_le_set_random_address(uint8_t * buffer, const bd_addr_t random_bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x05);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x05) >> 8);
+    buffer[2] = 6u;
+    reverse_bd_addr(random_bd_addr, &buffer[3u]);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_le_set_advertising_parameters into buffer
+ * @param buffer for HCI command of 18 bytes
+ * @param advertising_interval_min
+ * @param advertising_interval_max
+ * @param advertising_type
+ * @param own_address_type
+ * @param direct_address_type
+ * @param direct_address
+ * @param advertising_channel_map
+ * @param advertising_filter_policy
+ * @return size of HCI command
+ * @note: btstack_type 22111B11
+ */
+static inline uint16_t hci_cmd_serialize_le_set_advertising_parameters(uint8_t * buffer, uint16_t advertising_interval_min, uint16_t advertising_interval_max, uint8_t advertising_type, uint8_t own_address_type, uint8_t direct_address_type, const bd_addr_t direct_address, uint8_t advertising_channel_map, uint8_t advertising_filter_policy){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x06);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x06) >> 8);
+    buffer[2] = 15u;
+    buffer[3u] = (uint8_t) advertising_interval_min;
+    buffer[4u] = (uint8_t) (advertising_interval_min >> 8);
+    buffer[5u] = (uint8_t) advertising_interval_max;
+    buffer[6u] = (uint8_t) (advertising_interval_max >> 8);
+    buffer[7u] = advertising_type;
+    buffer[8u] = own_address_type;
+    buffer[9u] = direct_address_type;
+    reverse_bd_addr(direct_address, &buffer[10u]);
+    buffer[16u] = advertising_channel_map;
+    buffer[17u] = advertising_filter_policy;
+    return 18u;
+}
+
+/**
+ * @brief Serialize hci_le_read_advertising_channel_tx_power into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_advertising_channel_tx_power(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x07);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x07) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_set_advertising_data into buffer
+ * @param buffer for HCI command of 35 bytes
+ * @param advertising_data_length
+ * @param advertising_data
+ * @return size of HCI command
+ * @note: btstack_type 1A
+ */
+static inline uint16_t hci_cmd_serialize_le_set_advertising_data(uint8_t * buffer, uint8_t advertising_data_length, const uint8_t * advertising_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x08);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x08) >> 8);
+    buffer[2] = 32u;
+    buffer[3u] = advertising_data_length;
+    (void)memcpy(&buffer[4u], advertising_data, 31);
+    return 35u;
+}
+
+/**
+ * @brief Serialize hci_le_set_scan_response_data into buffer
+ * @param buffer for HCI command of 35 bytes
+ * @param scan_response_data_length
+ * @param scan_response_data
+ * @return size of HCI command
+ * @note: btstack_type 1A
+ */
+static inline uint16_t hci_cmd_serialize_le_set_scan_response_data(uint8_t * buffer, uint8_t scan_response_data_length, const uint8_t * scan_response_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x09);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x09) >> 8);
+    buffer[2] = 32u;
+    buffer[3u] = scan_response_data_length;
+    (void)memcpy(&buffer[4u], scan_response_data, 31);
+    return 35u;
+}
+
+/**
+ * @brief Serialize hci_le_set_advertise_enable into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param advertise_enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_set_advertise_enable(uint8_t * buffer, uint8_t advertise_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x0a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x0a) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = advertise_enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_set_scan_parameters into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param le_scan_type
+ * @param le_scan_interval
+ * @param le_scan_window
+ * @param own_address_type
+ * @param scanning_filter_policy
+ * @return size of HCI command
+ * @note: btstack_type 12211
+ */
+static inline uint16_t hci_cmd_serialize_le_set_scan_parameters(uint8_t * buffer, uint8_t le_scan_type, uint16_t le_scan_interval, uint16_t le_scan_window, uint8_t own_address_type, uint8_t scanning_filter_policy){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x0b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x0b) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = le_scan_type;
+    buffer[4u] = (uint8_t) le_scan_interval;
+    buffer[5u] = (uint8_t) (le_scan_interval >> 8);
+    buffer[6u] = (uint8_t) le_scan_window;
+    buffer[7u] = (uint8_t) (le_scan_window >> 8);
+    buffer[8u] = own_address_type;
+    buffer[9u] = scanning_filter_policy;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_set_scan_enable into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param le_scan_enable
+ * @param filter_duplices
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_le_set_scan_enable(uint8_t * buffer, uint8_t le_scan_enable, uint8_t filter_duplices){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x0c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x0c) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = le_scan_enable;
+    buffer[4u] = filter_duplices;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_create_connection into buffer
+ * @param buffer for HCI command of 28 bytes
+ * @param le_scan_interval
+ * @param le_scan_window
+ * @param initiator_filter_policy
+ * @param peer_address_type
+ * @param peer_address
+ * @param own_address_type
+ * @param conn_interval_min
+ * @param conn_interval_max
+ * @param conn_latency
+ * @param supervision_timeout
+ * @param minimum_ce_length
+ * @param maximum_ce_length
+ * @return size of HCI command
+ * @note: btstack_type 2211B1222222
+ */
+static inline uint16_t hci_cmd_serialize_le_create_connection(uint8_t * buffer, uint16_t le_scan_interval, uint16_t le_scan_window, uint8_t initiator_filter_policy, uint8_t peer_address_type, const bd_addr_t peer_address, uint8_t own_address_type, uint16_t conn_interval_min, uint16_t conn_interval_max, uint16_t conn_latency, uint16_t supervision_timeout, uint16_t minimum_ce_length, uint16_t maximum_ce_length){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x0d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x0d) >> 8);
+    buffer[2] = 25u;
+    buffer[3u] = (uint8_t) le_scan_interval;
+    buffer[4u] = (uint8_t) (le_scan_interval >> 8);
+    buffer[5u] = (uint8_t) le_scan_window;
+    buffer[6u] = (uint8_t) (le_scan_window >> 8);
+    buffer[7u] = initiator_filter_policy;
+    buffer[8u] = peer_address_type;
+    reverse_bd_addr(peer_address, &buffer[9u]);
+    buffer[15u] = own_address_type;
+    buffer[16u] = (uint8_t) conn_interval_min;
+    buffer[17u] = (uint8_t) (conn_interval_min >> 8);
+    buffer[18u] = (uint8_t) conn_interval_max;
+    buffer[19u] = (uint8_t) (conn_interval_max >> 8);
+    buffer[20u] = (uint8_t) conn_latency;
+    buffer[21u] = (uint8_t) (conn_latency >> 8);
+    buffer[22u] = (uint8_t) supervision_timeout;
+    buffer[23u] = (uint8_t) (supervision_timeout >> 8);
+    buffer[24u] = (uint8_t) minimum_ce_length;
+    buffer[25u] = (uint8_t) (minimum_ce_length >> 8);
+    buffer[26u] = (uint8_t) maximum_ce_length;
+    buffer[27u] = (uint8_t) (maximum_ce_length >> 8);
+    return 28u;
+}
+
+/**
+ * @brief Serialize hci_le_create_connection_cancel into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_create_connection_cancel(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x0e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x0e) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_white_list_size into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_white_list_size(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x0f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x0f) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_clear_white_list into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_clear_white_list(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x10);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x10) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_add_device_to_white_list into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param address_type
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type 1B
+ */
+static inline uint16_t hci_cmd_serialize_le_add_device_to_white_list(uint8_t * buffer, uint8_t address_type, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x11);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x11) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = address_type;
+    reverse_bd_addr(bd_addr, &buffer[4u]);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_remove_device_from_white_list into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param address_type
+ * @param bd_addr
+ * @return size of HCI command
+ * @note: btstack_type 1B
+ */
+static inline uint16_t hci_cmd_serialize_le_remove_device_from_white_list(uint8_t * buffer, uint8_t address_type, const bd_addr_t bd_addr){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x12);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x12) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = address_type;
+    reverse_bd_addr(bd_addr, &buffer[4u]);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_connection_update into buffer
+ * @param buffer for HCI command of 17 bytes
+ * @param conn_handle
+ * @param conn_interval_min
+ * @param conn_interval_max
+ * @param conn_latency
+ * @param supervision_timeout
+ * @param minimum_ce_length
+ * @param maximum_ce_length
+ * @return size of HCI command
+ * @note: btstack_type H222222
+ */
+static inline uint16_t hci_cmd_serialize_le_connection_update(uint8_t * buffer, hci_con_handle_t conn_handle, uint16_t conn_interval_min, uint16_t conn_interval_max, uint16_t conn_latency, uint16_t supervision_timeout, uint16_t minimum_ce_length, uint16_t maximum_ce_length){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x13);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x13) >> 8);
+    buffer[2] = 14u;
+    buffer[3u] = (uint8_t) conn_handle;
+    buffer[4u] = (uint8_t) (conn_handle >> 8);
+    buffer[5u] = (uint8_t) conn_interval_min;
+    buffer[6u] = (uint8_t) (conn_interval_min >> 8);
+    buffer[7u] = (uint8_t) conn_interval_max;
+    buffer[8u] = (uint8_t) (conn_interval_max >> 8);
+    buffer[9u] = (uint8_t) conn_latency;
+    buffer[10u] = (uint8_t) (conn_latency >> 8);
+    buffer[11u] = (uint8_t) supervision_timeout;
+    buffer[12u] = (uint8_t) (supervision_timeout >> 8);
+    buffer[13u] = (uint8_t) minimum_ce_length;
+    buffer[14u] = (uint8_t) (minimum_ce_length >> 8);
+    buffer[15u] = (uint8_t) maximum_ce_length;
+    buffer[16u] = (uint8_t) (maximum_ce_length >> 8);
+    return 17u;
+}
+
+/**
+ * @brief Serialize hci_le_set_host_channel_classification into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param channel_map_lower_32bits
+ * @param channel_map_higher_5bits
+ * @return size of HCI command
+ * @note: btstack_type 41
+ */
+static inline uint16_t hci_cmd_serialize_le_set_host_channel_classification(uint8_t * buffer, uint32_t channel_map_lower_32bits, uint8_t channel_map_higher_5bits){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x14);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x14) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = (uint8_t) channel_map_lower_32bits;
+    buffer[4u] = (uint8_t) (channel_map_lower_32bits >> 8);
+    buffer[5u] = (uint8_t) (channel_map_lower_32bits >> 16);
+    buffer[6u] = (uint8_t) (channel_map_lower_32bits >> 24);
+    buffer[7u] = channel_map_higher_5bits;
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_le_read_channel_map into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param conn_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_read_channel_map(uint8_t * buffer, hci_con_handle_t conn_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x15);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x15) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) conn_handle;
+    buffer[4u] = (uint8_t) (conn_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_read_remote_used_features into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param conn_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_read_remote_used_features(uint8_t * buffer, hci_con_handle_t conn_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x16);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x16) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) conn_handle;
+    buffer[4u] = (uint8_t) (conn_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_encrypt into buffer
+ * @param buffer for HCI command of 35 bytes
+ * @param key
+ * @param plain_text
+ * @return size of HCI command
+ * @note: btstack_type PP
+ */
+static inline uint16_t hci_cmd_serialize_le_encrypt(uint8_t * buffer, const uint8_t * key, const uint8_t * plain_text){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x17);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x17) >> 8);
+    buffer[2] = 32u;
+    (void)memcpy(&buffer[3u], key, 16);
+    (void)memcpy(&buffer[19u], plain_text, 16);
+    return 35u;
+}
+
+/**
+ * @brief Serialize hci_le_rand into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_rand(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x18);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x18) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_start_encryption into buffer
+ * @param buffer for HCI command of 31 bytes
+ * @param conn_handle
+ * @param random_number_lower_32bits
+ * @param random_number_higher_32bits
+ * @param encryption_diversifier
+ * @param long_term_key
+ * @return size of HCI command
+ * @note: btstack_type H442P
+ */
+static inline uint16_t hci_cmd_serialize_le_start_encryption(uint8_t * buffer, hci_con_handle_t conn_handle, uint32_t random_number_lower_32bits, uint32_t random_number_higher_32bits, uint16_t encryption_diversifier, const uint8_t * long_term_key){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x19);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x19) >> 8);
+    buffer[2] = 28u;
+    buffer[3u] = (uint8_t) conn_handle;
+    buffer[4u] = (uint8_t) (conn_handle >> 8);
+    buffer[5u] = (uint8_t) random_number_lower_32bits;
+    buffer[6u] = (uint8_t) (random_number_lower_32bits >> 8);
+    buffer[7u] = (uint8_t) (random_number_lower_32bits >> 16);
+    buffer[8u] = (uint8_t) (random_number_lower_32bits >> 24);
+    buffer[9u] = (uint8_t) random_number_higher_32bits;
+    buffer[10u] = (uint8_t) (random_number_higher_32bits >> 8);
+    buffer[11u] = (uint8_t) (random_number_higher_32bits >> 16);
+    buffer[12u] = (uint8_t) (random_number_higher_32bits >> 24);
+    buffer[13u] = (uint8_t) encryption_diversifier;
+    buffer[14u] = (uint8_t) (encryption_diversifier >> 8);
+    (void)memcpy(&buffer[15u], long_term_key, 16);
+    return 31u;
+}
+
+/**
+ * @brief Serialize hci_le_long_term_key_request_reply into buffer
+ * @param buffer for HCI command of 21 bytes
+ * @param connection_handle
+ * @param long_term_key
+ * @return size of HCI command
+ * @note: btstack_type HP
+ */
+static inline uint16_t hci_cmd_serialize_le_long_term_key_request_reply(uint8_t * buffer, hci_con_handle_t connection_handle, const uint8_t * long_term_key){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x1a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x1a) >> 8);
+    buffer[2] = 18u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    (void)memcpy(&buffer[5u], long_term_key, 16);
+    return 21u;
+}
+
+/**
+ * @brief Serialize hci_le_long_term_key_negative_reply into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param conn_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_long_term_key_negative_reply(uint8_t * buffer, hci_con_handle_t conn_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x1b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x1b) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) conn_handle;
+    buffer[4u] = (uint8_t) (conn_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_read_supported_states into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param conn_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_read_supported_states(uint8_t * buffer, hci_con_handle_t conn_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x1c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x1c) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) conn_handle;
+    buffer[4u] = (uint8_t) (conn_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_receiver_test into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param rx_frequency
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_receiver_test(uint8_t * buffer, uint8_t rx_frequency){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x1d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x1d) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = rx_frequency;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_transmitter_test into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param tx_frequency
+ * @param test_payload_lengh
+ * @param packet_payload
+ * @return size of HCI command
+ * @note: btstack_type 111
+ */
+static inline uint16_t hci_cmd_serialize_le_transmitter_test(uint8_t * buffer, uint8_t tx_frequency, uint8_t test_payload_lengh, uint8_t packet_payload){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x1e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x1e) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = tx_frequency;
+    buffer[4u] = test_payload_lengh;
+    buffer[5u] = packet_payload;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_test_end into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_test_end(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x1f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x1f) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_remote_connection_parameter_request_reply into buffer
+ * @param buffer for HCI command of 17 bytes
+ * @param conn_handle
+ * @param conn_interval_min
+ * @param conn_interval_max
+ * @param conn_latency
+ * @param supervision_timeout
+ * @param minimum_ce_length
+ * @param maximum_ce_length
+ * @return size of HCI command
+ * @note: btstack_type H222222
+ */
+static inline uint16_t hci_cmd_serialize_le_remote_connection_parameter_request_reply(uint8_t * buffer, hci_con_handle_t conn_handle, uint16_t conn_interval_min, uint16_t conn_interval_max, uint16_t conn_latency, uint16_t supervision_timeout, uint16_t minimum_ce_length, uint16_t maximum_ce_length){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x20);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x20) >> 8);
+    buffer[2] = 14u;
+    buffer[3u] = (uint8_t) conn_handle;
+    buffer[4u] = (uint8_t) (conn_handle >> 8);
+    buffer[5u] = (uint8_t) conn_interval_min;
+    buffer[6u] = (uint8_t) (conn_interval_min >> 8);
+    buffer[7u] = (uint8_t) conn_interval_max;
+    buffer[8u] = (uint8_t) (conn_interval_max >> 8);
+    buffer[9u] = (uint8_t) conn_latency;
+    buffer[10u] = (uint8_t) (conn_latency >> 8);
+    buffer[11u] = (uint8_t) supervision_timeout;
+    buffer[12u] = (uint8_t) (supervision_timeout >> 8);
+    buffer[13u] = (uint8_t) minimum_ce_length;
+    buffer[14u] = (uint8_t) (minimum_ce_length >> 8);
+    buffer[15u] = (uint8_t) maximum_ce_length;
+    buffer[16u] = (uint8_t) (maximum_ce_length >> 8);
+    return 17u;
+}
+
+/**
+ * @brief Serialize hci_le_remote_connection_parameter_request_negative_reply into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param con_handle
+ * @param reason
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_remote_connection_parameter_request_negative_reply(uint8_t * buffer, hci_con_handle_t con_handle, uint8_t reason){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x21);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x21) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) con_handle;
+    buffer[4u] = (uint8_t) (con_handle >> 8);
+    buffer[5u] = reason;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_set_data_length into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param con_handle
+ * @param tx_octets
+ * @param tx_time
+ * @return size of HCI command
+ * @note: btstack_type H22
+ */
+static inline uint16_t hci_cmd_serialize_le_set_data_length(uint8_t * buffer, hci_con_handle_t con_handle, uint16_t tx_octets, uint16_t tx_time){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x22);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x22) >> 8);
+    buffer[2] = 6u;
+    buffer[3u] = (uint8_t) con_handle;
+    buffer[4u] = (uint8_t) (con_handle >> 8);
+    buffer[5u] = (uint8_t) tx_octets;
+    buffer[6u] = (uint8_t) (tx_octets >> 8);
+    buffer[7u] = (uint8_t) tx_time;
+    buffer[8u] = (uint8_t) (tx_time >> 8);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_le_read_suggested_default_data_length into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_suggested_default_data_length(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x23);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x23) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_write_suggested_default_data_length into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param suggested_max_tx_octets
+ * @param suggested_max_tx_time
+ * @return size of HCI command
+ * @note: btstack_type 22
+ */
+static inline uint16_t hci_cmd_serialize_le_write_suggested_default_data_length(uint8_t * buffer, uint16_t suggested_max_tx_octets, uint16_t suggested_max_tx_time){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x24);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x24) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) suggested_max_tx_octets;
+    buffer[4u] = (uint8_t) (suggested_max_tx_octets >> 8);
+    buffer[5u] = (uint8_t) suggested_max_tx_time;
+    buffer[6u] = (uint8_t) (suggested_max_tx_time >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_le_read_local_p256_public_key into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_local_p256_public_key(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x25);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x25) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_generate_dhkey into buffer
+ * @param buffer for HCI command of 67 bytes
+ * @param arg1
+ * @param arg2
+ * @return size of HCI command
+ * @note: btstack_type QQ
+ */
+static inline uint16_t hci_cmd_serialize_le_generate_dhkey(uint8_t * buffer, const uint8_t * arg1, const uint8_t * arg2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x26);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x26) >> 8);
+    buffer[2] = 64u;
+    reverse_bytes(arg1, &buffer[3u], 32);
+    reverse_bytes(arg2, &buffer[35u], 32);
+    return 67u;
+}
+
+/**
+ * @brief Serialize hci_le_add_device_to_resolving_list into buffer
+ * @param buffer for HCI command of 42 bytes
+ * @param peer_identity_address_type
+ * @param peer_identity_address
+ * @param peer_irk
+ * @param local_irk
+ * @return size of HCI command
+ * @note: btstack_type 1BPP
+ */
+static inline uint16_t hci_cmd_serialize_le_add_device_to_resolving_list(uint8_t * buffer, uint8_t peer_identity_address_type, const bd_addr_t peer_identity_address, const uint8_t * peer_irk, const uint8_t * local_irk){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x27);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x27) >> 8);
+    buffer[2] = 39u;
+    buffer[3u] = peer_identity_address_type;
+    reverse_bd_addr(peer_identity_address, &buffer[4u]);
+    (void)memcpy(&buffer[10u], peer_irk, 16);
+    (void)memcpy(&buffer[26u], local_irk, 16);
+    return 42u;
+}
+
+/**
+ * @brief Serialize hci_le_remove_device_from_resolving_list into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param peer_identity_address_type
+ * @param peer_identity_address
+ * @return size of HCI command
+ * @note: btstack_type 1B
+ */
+static inline uint16_t hci_cmd_serialize_le_remove_device_from_resolving_list(uint8_t * buffer, uint8_t peer_identity_address_type, const bd_addr_t peer_identity_address){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x28);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x28) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = peer_identity_address_type;
+    reverse_bd_addr(peer_identity_address, &buffer[4u]);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_clear_resolving_list into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_clear_resolving_list(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x29);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x29) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_resolving_list_size into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_resolving_list_size(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x2A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x2A) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_peer_resolvable_address into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_peer_resolvable_address(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x2B);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x2B) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_local_resolvable_address into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_local_resolvable_address(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x2C);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x2C) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_set_address_resolution_enabled into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param address_resolution_enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_set_address_resolution_enabled(uint8_t * buffer, uint8_t address_resolution_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x2D);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x2D) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = address_resolution_enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_set_resolvable_private_address_timeout into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param rpa_timeout
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_le_set_resolvable_private_address_timeout(uint8_t * buffer, uint16_t rpa_timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x2E);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x2E) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) rpa_timeout;
+    buffer[4u] = (uint8_t) (rpa_timeout >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_read_maximum_data_length into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_maximum_data_length(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x2F);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x2F) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_phy into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param con_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_read_phy(uint8_t * buffer, hci_con_handle_t con_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x30);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x30) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) con_handle;
+    buffer[4u] = (uint8_t) (con_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_set_default_phy into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param all_phys
+ * @param tx_phys
+ * @param rx_phys
+ * @return size of HCI command
+ * @note: btstack_type 111
+ */
+static inline uint16_t hci_cmd_serialize_le_set_default_phy(uint8_t * buffer, uint8_t all_phys, uint8_t tx_phys, uint8_t rx_phys){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x31);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x31) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = all_phys;
+    buffer[4u] = tx_phys;
+    buffer[5u] = rx_phys;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_set_phy into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param con_handle
+ * @param all_phys
+ * @param tx_phys
+ * @param rx_phys
+ * @param phy_options
+ * @return size of HCI command
+ * @note: btstack_type H1112
+ */
+static inline uint16_t hci_cmd_serialize_le_set_phy(uint8_t * buffer, hci_con_handle_t con_handle, uint8_t all_phys, uint8_t tx_phys, uint8_t rx_phys, uint16_t phy_options){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x32);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x32) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = (uint8_t) con_handle;
+    buffer[4u] = (uint8_t) (con_handle >> 8);
+    buffer[5u] = all_phys;
+    buffer[6u] = tx_phys;
+    buffer[7u] = rx_phys;
+    buffer[8u] = (uint8_t) phy_options;
+    buffer[9u] = (uint8_t) (phy_options >> 8);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_receiver_test_v2 into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param rx_channel
+ * @param phy
+ * @param modulation_index
+ * @return size of HCI command
+ * @note: btstack_type 111
+ */
+static inline uint16_t hci_cmd_serialize_le_receiver_test_v2(uint8_t * buffer, uint8_t rx_channel, uint8_t phy, uint8_t modulation_index){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x33);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x33) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = rx_channel;
+    buffer[4u] = phy;
+    buffer[5u] = modulation_index;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_transmitter_test_v2 into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param tx_channel
+ * @param test_data_length
+ * @param packet_payload
+ * @param phy
+ * @return size of HCI command
+ * @note: btstack_type 1111
+ */
+static inline uint16_t hci_cmd_serialize_le_transmitter_test_v2(uint8_t * buffer, uint8_t tx_channel, uint8_t test_data_length, uint8_t packet_payload, uint8_t phy){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x34);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x34) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = tx_channel;
+    buffer[4u] = test_data_length;
+    buffer[5u] = packet_payload;
+    buffer[6u] = phy;
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_le_set_advertising_set_random_address into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param advertising_handle
+ * @param random_address
+ * @return size of HCI command
+ * @note: btstack_type 1B
+ */
+static inline uint16_t hci_cmd_serialize_le_set_advertising_set_random_address(uint8_t * buffer, uint8_t advertising_handle, const bd_addr_t random_address){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x35);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x35) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = advertising_handle;
+    reverse_bd_addr(random_address, &buffer[4u]);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_set_extended_advertising_parameters into buffer
+ * @param buffer for HCI command of 28 bytes
+ * @param advertising_handle
+ * @param advertising_event_properties
+ * @param primary_advertising_interval_min
+ * @param primary_advertising_interval_max
+ * @param primary_advertising_channel_map
+ * @param own_address_type
+ * @param peer_address_type
+ * @param peer_address
+ * @param advertising_filter_policy
+ * @param advertising_tx_power
+ * @param primary_advertising_phy
+ * @param secondary_advertising_max_skip
+ * @param secondary_advertising_phy
+ * @param advertising_sid
+ * @param scan_request_notification_enable
+ * @return size of HCI command
+ * @note: btstack_type 1233111B1111111
+ */
+static inline uint16_t hci_cmd_serialize_le_set_extended_advertising_parameters(uint8_t * buffer, uint8_t advertising_handle, uint16_t advertising_event_properties, uint32_t primary_advertising_interval_min, uint32_t primary_advertising_interval_max, uint8_t primary_advertising_channel_map, uint8_t own_address_type, uint8_t peer_address_type, const bd_addr_t peer_address, uint8_t advertising_filter_policy, uint8_t advertising_tx_power, uint8_t primary_advertising_phy, uint8_t secondary_advertising_max_skip, uint8_t secondary_advertising_phy, uint8_t advertising_sid, uint8_t scan_request_notification_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x36);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x36) >> 8);
+    buffer[2] = 25u;
+    buffer[3u] = advertising_handle;
+    buffer[4u] = (uint8_t) advertising_event_properties;
+    buffer[5u] = (uint8_t) (advertising_event_properties >> 8);
+    buffer[6u] = (uint8_t) primary_advertising_interval_min;
+    buffer[7u] = (uint8_t) (primary_advertising_interval_min >> 8);
+    buffer[8u] = (uint8_t) (primary_advertising_interval_min >> 16);
+    buffer[9u] = (uint8_t) primary_advertising_interval_max;
+    buffer[10u] = (uint8_t) (primary_advertising_interval_max >> 8);
+    buffer[11u] = (uint8_t) (primary_advertising_interval_max >> 16);
+    buffer[12u] = primary_advertising_channel_map;
+    buffer[13u] = own_address_type;
+    buffer[14u] = peer_address_type;
+    reverse_bd_addr(peer_address, &buffer[15u]);
+    buffer[21u] = advertising_filter_policy;
+    buffer[22u] = advertising_tx_power;
+    buffer[23u] = primary_advertising_phy;
+    buffer[24u] = secondary_advertising_max_skip;
+    buffer[25u] = secondary_advertising_phy;
+    buffer[26u] = advertising_sid;
+    buffer[27u] = scan_request_notification_enable;
+    return 28u;
+}
+
+/**
+ * @brief Serialize hci_le_set_extended_advertising_data into buffer
+ * @param buffer for HCI command of up to 262 bytes
+ * @param advertising_handle
+ * @param operation
+ * @param fragment_preference
+ * @param advertising_data_length
+ * @param advertising_data
+ * @return size of HCI command
+ * @note: btstack_type 111JV
+ */
+static inline uint16_t hci_cmd_serialize_le_set_extended_advertising_data(uint8_t * buffer, uint8_t advertising_handle, uint8_t operation, uint8_t fragment_preference, uint8_t advertising_data_length, const uint8_t * advertising_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x37);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x37) >> 8);
+    buffer[3u] = advertising_handle;
+    buffer[4u] = operation;
+    buffer[5u] = fragment_preference;
+    buffer[6u] = advertising_data_length;
+    hci_cmd_store_variable_length_data(buffer, 7u, advertising_data, advertising_data_length);
+    uint16_t pos = 7u + advertising_data_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_set_extended_scan_response_data into buffer
+ * @param buffer for HCI command of up to 262 bytes
+ * @param advertising_handle
+ * @param operation
+ * @param fragment_preference
+ * @param scan_response_data_length
+ * @param scan_response_data
+ * @return size of HCI command
+ * @note: btstack_type 111JV
+ */
+static inline uint16_t hci_cmd_serialize_le_set_extended_scan_response_data(uint8_t * buffer, uint8_t advertising_handle, uint8_t operation, uint8_t fragment_preference, uint8_t scan_response_data_length, const uint8_t * scan_response_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x38);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x38) >> 8);
+    buffer[3u] = advertising_handle;
+    buffer[4u] = operation;
+    buffer[5u] = fragment_preference;
+    buffer[6u] = scan_response_data_length;
+    hci_cmd_store_variable_length_data(buffer, 7u, scan_response_data, scan_response_data_length);
+    uint16_t pos = 7u + scan_response_data_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_read_maximum_advertising_data_length into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_maximum_advertising_data_length(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x3a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x3a) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_number_of_supported_advertising_sets into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_number_of_supported_advertising_sets(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x3b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x3b) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_remove_advertising_set into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param advertising_handle
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_remove_advertising_set(uint8_t * buffer, uint8_t advertising_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x3c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x3c) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = advertising_handle;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_clear_advertising_sets into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_clear_advertising_sets(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x3d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x3d) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_set_periodic_advertising_parameters into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param advertising_handle
+ * @param periodic_advertising_interval_min
+ * @param periodic_advertising_interval_max
+ * @param periodic_advertising_properties
+ * @return size of HCI command
+ * @note: btstack_type 1222
+ */
+static inline uint16_t hci_cmd_serialize_le_set_periodic_advertising_parameters(uint8_t * buffer, uint8_t advertising_handle, uint16_t periodic_advertising_interval_min, uint16_t periodic_advertising_interval_max, uint16_t periodic_advertising_properties){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x3e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x3e) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = advertising_handle;
+    buffer[4u] = (uint8_t) periodic_advertising_interval_min;
+    buffer[5u] = (uint8_t) (periodic_advertising_interval_min >> 8);
+    buffer[6u] = (uint8_t) periodic_advertising_interval_max;
+    buffer[7u] = (uint8_t) (periodic_advertising_interval_max >> 8);
+    buffer[8u] = (uint8_t) periodic_advertising_properties;
+    buffer[9u] = (uint8_t) (periodic_advertising_properties >> 8);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_set_periodic_advertising_data into buffer
+ * @param buffer for HCI command of up to 261 bytes
+ * @param advertising_handle
+ * @param operation
+ * @param advertising_data_length
+ * @param advertising_data
+ * @return size of HCI command
+ * @note: btstack_type 11JV
+ */
+static inline uint16_t hci_cmd_serialize_le_set_periodic_advertising_data(uint8_t * buffer, uint8_t advertising_handle, uint8_t operation, uint8_t advertising_data_length, const uint8_t * advertising_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x3f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x3f) >> 8);
+    buffer[3u] = advertising_handle;
+    buffer[4u] = operation;
+    buffer[5u] = advertising_data_length;
+    hci_cmd_store_variable_length_data(buffer, 6u, advertising_data, advertising_data_length);
+    uint16_t pos = 6u + advertising_data_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_set_periodic_advertising_enable into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param enable
+ * @param advertising_handle
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_le_set_periodic_advertising_enable(uint8_t * buffer, uint8_t enable, uint8_t advertising_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x40);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x40) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = enable;
+    buffer[4u] = advertising_handle;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_set_extended_scan_enable into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @return size of HCI command
+ * @note: btstack_type 1122
+ */
+static inline uint16_t hci_cmd_serialize_le_set_extended_scan_enable(uint8_t * buffer, uint8_t arg1, uint8_t arg2, uint16_t arg3, uint16_t arg4){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x42);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x42) >> 8);
+    buffer[2] = 6u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    buffer[5u] = (uint8_t) arg3;
+    buffer[6u] = (uint8_t) (arg3 >> 8);
+    buffer[7u] = (uint8_t) arg4;
+    buffer[8u] = (uint8_t) (arg4 >> 8);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_le_periodic_advertising_create_sync into buffer
+ * @param buffer for HCI command of 17 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @return size of HCI command
+ * @note: btstack_type 111B221
+ */
+static inline uint16_t hci_cmd_serialize_le_periodic_advertising_create_sync(uint8_t * buffer, uint8_t arg1, uint8_t arg2, uint8_t arg3, const bd_addr_t arg4, uint16_t arg5, uint16_t arg6, uint8_t arg7){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x44);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x44) >> 8);
+    buffer[2] = 14u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    buffer[5u] = arg3;
+    reverse_bd_addr(arg4, &buffer[6u]);
+    buffer[12u] = (uint8_t) arg5;
+    buffer[13u] = (uint8_t) (arg5 >> 8);
+    buffer[14u] = (uint8_t) arg6;
+    buffer[15u] = (uint8_t) (arg6 >> 8);
+    buffer[16u] = arg7;
+    return 17u;
+}
+
+/**
+ * @brief Serialize hci_le_periodic_advertising_create_sync_cancel into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_periodic_advertising_create_sync_cancel(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x45);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x45) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_periodic_advertising_terminate_sync into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param sync_handle
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_le_periodic_advertising_terminate_sync(uint8_t * buffer, uint16_t sync_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x46);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x46) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) sync_handle;
+    buffer[4u] = (uint8_t) (sync_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_add_device_to_periodic_advertiser_list into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param advertiser_address_type
+ * @param advertiser_address
+ * @param advertising_sid
+ * @return size of HCI command
+ * @note: btstack_type 1B1
+ */
+static inline uint16_t hci_cmd_serialize_le_add_device_to_periodic_advertiser_list(uint8_t * buffer, uint8_t advertiser_address_type, const bd_addr_t advertiser_address, uint8_t advertising_sid){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x47);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x47) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = advertiser_address_type;
+    reverse_bd_addr(advertiser_address, &buffer[4u]);
+    buffer[10u] = advertising_sid;
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_le_remove_device_from_periodic_advertiser_list into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param advertiser_address_type
+ * @param advertiser_address
+ * @param advertising_sid
+ * @return size of HCI command
+ * @note: btstack_type 1B1
+ */
+static inline uint16_t hci_cmd_serialize_le_remove_device_from_periodic_advertiser_list(uint8_t * buffer, uint8_t advertiser_address_type, const bd_addr_t advertiser_address, uint8_t advertising_sid){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x48);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x48) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = advertiser_address_type;
+    reverse_bd_addr(advertiser_address, &buffer[4u]);
+    buffer[10u] = advertising_sid;
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_le_clear_periodic_advertiser_list into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_clear_periodic_advertiser_list(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x49);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x49) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_periodic_advertiser_list_size into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_periodic_advertiser_list_size(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x4a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x4a) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_transmit_power into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_transmit_power(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x4b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x4b) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_rf_path_compensation into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_rf_path_compensation(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x4c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x4c) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_write_rf_path_compensation into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param rf_tx_path_compensation_value
+ * @param rf_rx_path_compensation_value
+ * @return size of HCI command
+ * @note: btstack_type 22
+ */
+static inline uint16_t hci_cmd_serialize_le_write_rf_path_compensation(uint8_t * buffer, uint16_t rf_tx_path_compensation_value, uint16_t rf_rx_path_compensation_value){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x4d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x4d) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) rf_tx_path_compensation_value;
+    buffer[4u] = (uint8_t) (rf_tx_path_compensation_value >> 8);
+    buffer[5u] = (uint8_t) rf_rx_path_compensation_value;
+    buffer[6u] = (uint8_t) (rf_rx_path_compensation_value >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_le_set_privacy_mode into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param peer_identity_address_type
+ * @param peer_identity_address
+ * @param privacy_mode
+ * @return size of HCI command
+ * @note: btstack_type 1B1
+ */
+static inline uint16_t hci_cmd_serialize_le_set_privacy_mode(uint8_t * buffer, uint8_t peer_identity_address_type, const bd_addr_t peer_identity_address, uint8_t privacy_mode){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x4e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x4e) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = peer_identity_address_type;
+    reverse_bd_addr(peer_identity_address, &buffer[4u]);
+    buffer[10u] = privacy_mode;
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_le_set_connectionless_cte_transmit_enable into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param arg1
+ * @param arg2
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_le_set_connectionless_cte_transmit_enable(uint8_t * buffer, uint8_t arg1, uint8_t arg2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x52);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x52) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_connection_cte_request_enable into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @return size of HCI command
+ * @note: btstack_type H1211
+ */
+static inline uint16_t hci_cmd_serialize_le_connection_cte_request_enable(uint8_t * buffer, hci_con_handle_t arg1, uint8_t arg2, uint16_t arg3, uint8_t arg4, uint8_t arg5){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x56);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x56) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = (uint8_t) arg1;
+    buffer[4u] = (uint8_t) (arg1 >> 8);
+    buffer[5u] = arg2;
+    buffer[6u] = (uint8_t) arg3;
+    buffer[7u] = (uint8_t) (arg3 >> 8);
+    buffer[8u] = arg4;
+    buffer[9u] = arg5;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_connection_cte_response_enable into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param enable
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_connection_cte_response_enable(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x57);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x57) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = enable;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_read_antenna_information into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_antenna_information(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x58);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x58) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_set_periodic_advertising_receive_enable into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param sync_handle
+ * @param enable
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_set_periodic_advertising_receive_enable(uint8_t * buffer, hci_con_handle_t sync_handle, uint8_t enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x59);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x59) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) sync_handle;
+    buffer[4u] = (uint8_t) (sync_handle >> 8);
+    buffer[5u] = enable;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_periodic_advertising_sync_transfer into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param connection_handle
+ * @param service_data
+ * @param sync_handle
+ * @return size of HCI command
+ * @note: btstack_type H22
+ */
+static inline uint16_t hci_cmd_serialize_le_periodic_advertising_sync_transfer(uint8_t * buffer, hci_con_handle_t connection_handle, uint16_t service_data, uint16_t sync_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x5a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x5a) >> 8);
+    buffer[2] = 6u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = (uint8_t) service_data;
+    buffer[6u] = (uint8_t) (service_data >> 8);
+    buffer[7u] = (uint8_t) sync_handle;
+    buffer[8u] = (uint8_t) (sync_handle >> 8);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_le_periodic_advertising_set_info_transfer into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param connection_handle
+ * @param service_data
+ * @param advertising_handle
+ * @return size of HCI command
+ * @note: btstack_type H21
+ */
+static inline uint16_t hci_cmd_serialize_le_periodic_advertising_set_info_transfer(uint8_t * buffer, hci_con_handle_t connection_handle, uint16_t service_data, uint8_t advertising_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x5b);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x5b) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = (uint8_t) service_data;
+    buffer[6u] = (uint8_t) (service_data >> 8);
+    buffer[7u] = advertising_handle;
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_le_set_periodic_advertising_sync_transfer_parameters into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param connection_handle
+ * @param mode
+ * @param skip
+ * @param sync_timeout
+ * @param cte_type
+ * @return size of HCI command
+ * @note: btstack_type H1221
+ */
+static inline uint16_t hci_cmd_serialize_le_set_periodic_advertising_sync_transfer_parameters(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t mode, uint16_t skip, uint16_t sync_timeout, uint8_t cte_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x5c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x5c) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = mode;
+    buffer[6u] = (uint8_t) skip;
+    buffer[7u] = (uint8_t) (skip >> 8);
+    buffer[8u] = (uint8_t) sync_timeout;
+    buffer[9u] = (uint8_t) (sync_timeout >> 8);
+    buffer[10u] = cte_type;
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_le_set_default_periodic_advertising_sync_transfer_parameters into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param mode
+ * @param skip
+ * @param sync_timeout
+ * @param cte_type
+ * @return size of HCI command
+ * @note: btstack_type 1221
+ */
+static inline uint16_t hci_cmd_serialize_le_set_default_periodic_advertising_sync_transfer_parameters(uint8_t * buffer, uint8_t mode, uint16_t skip, uint16_t sync_timeout, uint8_t cte_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x5d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x5d) >> 8);
+    buffer[2] = 6u;
+    buffer[3u] = mode;
+    buffer[4u] = (uint8_t) skip;
+    buffer[5u] = (uint8_t) (skip >> 8);
+    buffer[6u] = (uint8_t) sync_timeout;
+    buffer[7u] = (uint8_t) (sync_timeout >> 8);
+    buffer[8u] = cte_type;
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_le_generate_dhkey_v2 into buffer
+ * @param buffer for HCI command of 68 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @return size of HCI command
+ * @note: btstack_type QQ1
+ */
+static inline uint16_t hci_cmd_serialize_le_generate_dhkey_v2(uint8_t * buffer, const uint8_t * arg1, const uint8_t * arg2, uint8_t arg3){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x5e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x5e) >> 8);
+    buffer[2] = 65u;
+    reverse_bytes(arg1, &buffer[3u], 32);
+    reverse_bytes(arg2, &buffer[35u], 32);
+    buffer[67u] = arg3;
+    return 68u;
+}
+
+/**
+ * @brief Serialize hci_le_modify_sleep_clock_accuracy into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param action
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_modify_sleep_clock_accuracy(uint8_t * buffer, uint8_t action){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x5f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x5f) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = action;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_read_buffer_size_v2 into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_buffer_size_v2(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x60);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x60) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_iso_tx_sync into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_read_iso_tx_sync(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x61);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x61) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_remove_cig into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param arg1
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_remove_cig(uint8_t * buffer, uint8_t arg1){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x65);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x65) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = arg1;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_accept_cis_request into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_accept_cis_request(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x66);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x66) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_reject_cis_request into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param arg1
+ * @param arg2
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_reject_cis_request(uint8_t * buffer, hci_con_handle_t arg1, uint8_t arg2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x67);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x67) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) arg1;
+    buffer[4u] = (uint8_t) (arg1 >> 8);
+    buffer[5u] = arg2;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_create_big into buffer
+ * @param buffer for HCI command of 34 bytes
+ * @param big_handle
+ * @param advertising_handle
+ * @param num_bis
+ * @param sdu_interval
+ * @param max_sdu
+ * @param max_transport_latency
+ * @param rtn
+ * @param phy
+ * @param packing
+ * @param framing
+ * @param encryption
+ * @param broadcast_code
+ * @return size of HCI command
+ * @note: btstack_type 11132211111K
+ */
+static inline uint16_t hci_cmd_serialize_le_create_big(uint8_t * buffer, uint8_t big_handle, uint8_t advertising_handle, uint8_t num_bis, uint32_t sdu_interval, uint16_t max_sdu, uint16_t max_transport_latency, uint8_t rtn, uint8_t phy, uint8_t packing, uint8_t framing, uint8_t encryption, const uint8_t * broadcast_code){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x68);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x68) >> 8);
+    buffer[2] = 31u;
+    buffer[3u] = big_handle;
+    buffer[4u] = advertising_handle;
+    buffer[5u] = num_bis;
+    buffer[6u] = (uint8_t) sdu_interval;
+    buffer[7u] = (uint8_t) (sdu_interval >> 8);
+    buffer[8u] = (uint8_t) (sdu_interval >> 16);
+    buffer[9u] = (uint8_t) max_sdu;
+    buffer[10u] = (uint8_t) (max_sdu >> 8);
+    buffer[11u] = (uint8_t) max_transport_latency;
+    buffer[12u] = (uint8_t) (max_transport_latency >> 8);
+    buffer[13u] = rtn;
+    buffer[14u] = phy;
+    buffer[15u] = packing;
+    buffer[16u] = framing;
+    buffer[17u] = encryption;
+    reverse_bytes(broadcast_code, &buffer[18u], 16);
+    return 34u;
+}
+
+/**
+ * @brief Serialize hci_le_create_big_test into buffer
+ * @param buffer for HCI command of 39 bytes
+ * @param big_handle
+ * @param advertising_handle
+ * @param num_bis
+ * @param sdu_interval
+ * @param iso_interval
+ * @param nse
+ * @param max_sdu
+ * @param max_pdu
+ * @param phy
+ * @param packing
+ * @param framing
+ * @param bn
+ * @param irc
+ * @param pto
+ * @param encryption
+ * @param broadcast_code
+ * @return size of HCI command
+ * @note: btstack_type 111321221111111K
+ */
+static inline uint16_t hci_cmd_serialize_le_create_big_test(uint8_t * buffer, uint8_t big_handle, uint8_t advertising_handle, uint8_t num_bis, uint32_t sdu_interval, uint16_t iso_interval, uint8_t nse, uint16_t max_sdu, uint16_t max_pdu, uint8_t phy, uint8_t packing, uint8_t framing, uint8_t bn, uint8_t irc, uint8_t pto, uint8_t encryption, const uint8_t * broadcast_code){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x69);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x69) >> 8);
+    buffer[2] = 36u;
+    buffer[3u] = big_handle;
+    buffer[4u] = advertising_handle;
+    buffer[5u] = num_bis;
+    buffer[6u] = (uint8_t) sdu_interval;
+    buffer[7u] = (uint8_t) (sdu_interval >> 8);
+    buffer[8u] = (uint8_t) (sdu_interval >> 16);
+    buffer[9u] = (uint8_t) iso_interval;
+    buffer[10u] = (uint8_t) (iso_interval >> 8);
+    buffer[11u] = nse;
+    buffer[12u] = (uint8_t) max_sdu;
+    buffer[13u] = (uint8_t) (max_sdu >> 8);
+    buffer[14u] = (uint8_t) max_pdu;
+    buffer[15u] = (uint8_t) (max_pdu >> 8);
+    buffer[16u] = phy;
+    buffer[17u] = packing;
+    buffer[18u] = framing;
+    buffer[19u] = bn;
+    buffer[20u] = irc;
+    buffer[21u] = pto;
+    buffer[22u] = encryption;
+    reverse_bytes(broadcast_code, &buffer[23u], 16);
+    return 39u;
+}
+
+/**
+ * @brief Serialize hci_le_terminate_big into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param big_handle
+ * @param reason
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_le_terminate_big(uint8_t * buffer, uint8_t big_handle, uint8_t reason){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x6a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x6a) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = big_handle;
+    buffer[4u] = reason;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_big_terminate_sync into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param arg1
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_big_terminate_sync(uint8_t * buffer, uint8_t arg1){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x6c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x6c) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = arg1;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_request_peer_sca into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_request_peer_sca(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x6d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x6d) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_setup_iso_data_path into buffer
+ * @param buffer for HCI command of up to 271 bytes
+ * @param connection_handle
+ * @param data_path_direction
+ * @param data_path_id
+ * @param codec_id_coding_format
+ * @param codec_id_company_identifier
+ * @param codec_id_vendor_codec_id
+ * @param controller_delay
+ * @param codec_configuration_length
+ * @param codec_configuration
+ * @return size of HCI command
+ * @note: btstack_type H111223JV
+ */
+static inline uint16_t hci_cmd_serialize_le_setup_iso_data_path(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t data_path_direction, uint8_t data_path_id, uint8_t codec_id_coding_format, uint16_t codec_id_company_identifier, uint16_t codec_id_vendor_codec_id, uint32_t controller_delay, uint8_t codec_configuration_length, const uint8_t * codec_configuration){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x6e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x6e) >> 8);
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = data_path_direction;
+    buffer[6u] = data_path_id;
+    buffer[7u] = codec_id_coding_format;
+    buffer[8u] = (uint8_t) codec_id_company_identifier;
+    buffer[9u] = (uint8_t) (codec_id_company_identifier >> 8);
+    buffer[10u] = (uint8_t) codec_id_vendor_codec_id;
+    buffer[11u] = (uint8_t) (codec_id_vendor_codec_id >> 8);
+    buffer[12u] = (uint8_t) controller_delay;
+    buffer[13u] = (uint8_t) (controller_delay >> 8);
+    buffer[14u] = (uint8_t) (controller_delay >> 16);
+    buffer[15u] = codec_configuration_length;
+    hci_cmd_store_variable_length_data(buffer, 16u, codec_configuration, codec_configuration_length);
+    uint16_t pos = 16u + codec_configuration_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_remove_iso_data_path into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param arg1
+ * @param arg2
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_remove_iso_data_path(uint8_t * buffer, hci_con_handle_t arg1, uint8_t arg2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x6f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x6f) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) arg1;
+    buffer[4u] = (uint8_t) (arg1 >> 8);
+    buffer[5u] = arg2;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_iso_transmit_test into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param paylaod_type
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_iso_transmit_test(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t paylaod_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x70);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x70) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = paylaod_type;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_iso_receive_test into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param paylaod_type
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_iso_receive_test(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t paylaod_type){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x71);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x71) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = paylaod_type;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_iso_read_test_counters into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_iso_read_test_counters(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x72);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x72) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_iso_test_end into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_iso_test_end(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x73);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x73) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_set_host_feature into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param bit_number
+ * @param bit_value
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_le_set_host_feature(uint8_t * buffer, uint8_t bit_number, uint8_t bit_value){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x74);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x74) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = bit_number;
+    buffer[4u] = bit_value;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_read_iso_link_quality into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_read_iso_link_quality(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x75);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x75) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_enhanced_read_transmit_power_level into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param phy
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_enhanced_read_transmit_power_level(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t phy){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x76);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x76) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = phy;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_read_remote_transmit_power_level into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param phy
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_read_remote_transmit_power_level(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t phy){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x77);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x77) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = phy;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_set_path_loss_reporting_parameters into buffer
+ * @param buffer for HCI command of 11 bytes
+ * @param connection_handle
+ * @param high_threshold
+ * @param high_hysteresis
+ * @param low_threshold
+ * @param low_hysteresis
+ * @param min_time_spent
+ * @return size of HCI command
+ * @note: btstack_type 211112
+ */
+static inline uint16_t hci_cmd_serialize_le_set_path_loss_reporting_parameters(uint8_t * buffer, uint16_t connection_handle, uint8_t high_threshold, uint8_t high_hysteresis, uint8_t low_threshold, uint8_t low_hysteresis, uint16_t min_time_spent){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x78);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x78) >> 8);
+    buffer[2] = 8u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = high_threshold;
+    buffer[6u] = high_hysteresis;
+    buffer[7u] = low_threshold;
+    buffer[8u] = low_hysteresis;
+    buffer[9u] = (uint8_t) min_time_spent;
+    buffer[10u] = (uint8_t) (min_time_spent >> 8);
+    return 11u;
+}
+
+/**
+ * @brief Serialize hci_le_set_path_loss_reporting_enable into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param enable
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_set_path_loss_reporting_enable(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x79);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x79) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = enable;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_set_transmit_power_reporting_enable into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param connection_handle
+ * @param local_enable
+ * @param remote_enable
+ * @return size of HCI command
+ * @note: btstack_type H11
+ */
+static inline uint16_t hci_cmd_serialize_le_set_transmit_power_reporting_enable(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t local_enable, uint8_t remote_enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x7a);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x7a) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = local_enable;
+    buffer[6u] = remote_enable;
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_le_set_data_related_address_change into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param arg1
+ * @param arg2
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_le_set_data_related_address_change(uint8_t * buffer, uint8_t arg1, uint8_t arg2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x7C);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x7C) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_set_default_subrate into buffer
+ * @param buffer for HCI command of 13 bytes
+ * @param subrate_min
+ * @param subrate_max
+ * @param max_latency
+ * @param continuation_number
+ * @param supervision_timeout
+ * @return size of HCI command
+ * @note: btstack_type 22222
+ */
+static inline uint16_t hci_cmd_serialize_le_set_default_subrate(uint8_t * buffer, uint16_t subrate_min, uint16_t subrate_max, uint16_t max_latency, uint16_t continuation_number, uint16_t supervision_timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x7D);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x7D) >> 8);
+    buffer[2] = 10u;
+    buffer[3u] = (uint8_t) subrate_min;
+    buffer[4u] = (uint8_t) (subrate_min >> 8);
+    buffer[5u] = (uint8_t) subrate_max;
+    buffer[6u] = (uint8_t) (subrate_max >> 8);
+    buffer[7u] = (uint8_t) max_latency;
+    buffer[8u] = (uint8_t) (max_latency >> 8);
+    buffer[9u] = (uint8_t) continuation_number;
+    buffer[10u] = (uint8_t) (continuation_number >> 8);
+    buffer[11u] = (uint8_t) supervision_timeout;
+    buffer[12u] = (uint8_t) (supervision_timeout >> 8);
+    return 13u;
+}
+
+/**
+ * @brief Serialize hci_le_subrate_request into buffer
+ * @param buffer for HCI command of 15 bytes
+ * @param connection_handle
+ * @param subrate_min
+ * @param subrate_max
+ * @param max_latency
+ * @param continuation_number
+ * @param supervision_timeout
+ * @return size of HCI command
+ * @note: btstack_type H22222
+ */
+static inline uint16_t hci_cmd_serialize_le_subrate_request(uint8_t * buffer, hci_con_handle_t connection_handle, uint16_t subrate_min, uint16_t subrate_max, uint16_t max_latency, uint16_t continuation_number, uint16_t supervision_timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x7E);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x7E) >> 8);
+    buffer[2] = 12u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = (uint8_t) subrate_min;
+    buffer[6u] = (uint8_t) (subrate_min >> 8);
+    buffer[7u] = (uint8_t) subrate_max;
+    buffer[8u] = (uint8_t) (subrate_max >> 8);
+    buffer[9u] = (uint8_t) max_latency;
+    buffer[10u] = (uint8_t) (max_latency >> 8);
+    buffer[11u] = (uint8_t) continuation_number;
+    buffer[12u] = (uint8_t) (continuation_number >> 8);
+    buffer[13u] = (uint8_t) supervision_timeout;
+    buffer[14u] = (uint8_t) (supervision_timeout >> 8);
+    return 15u;
+}
+
+/**
+ * @brief Serialize hci_le_set_decision_data into buffer
+ * @param buffer for HCI command of up to 261 bytes
+ * @param advertising_handle
+ * @param decision_type_flags
+ * @param decision_data_length
+ * @param decision_data
+ * @return size of HCI command
+ * @note: btstack_type 11JV
+ */
+static inline uint16_t hci_cmd_serialize_le_set_decision_data(uint8_t * buffer, uint8_t advertising_handle, uint8_t decision_type_flags, uint8_t decision_data_length, const uint8_t * decision_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x80);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x80) >> 8);
+    buffer[3u] = advertising_handle;
+    buffer[4u] = decision_type_flags;
+    buffer[5u] = decision_data_length;
+    hci_cmd_store_variable_length_data(buffer, 6u, decision_data, decision_data_length);
+    uint16_t pos = 6u + decision_data_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_set_periodic_advertising_response_data into buffer
+ * @param buffer for HCI command of up to 266 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @return size of HCI command
+ * @note: btstack_type H2111JV
+ */
+static inline uint16_t hci_cmd_serialize_le_set_periodic_advertising_response_data(uint8_t * buffer, hci_con_handle_t arg1, uint16_t arg2, uint8_t arg3, uint8_t arg4, uint8_t arg5, uint8_t arg6, const uint8_t * arg7){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x83);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x83) >> 8);
+    buffer[3u] = (uint8_t) arg1;
+    buffer[4u] = (uint8_t) (arg1 >> 8);
+    buffer[5u] = (uint8_t) arg2;
+    buffer[6u] = (uint8_t) (arg2 >> 8);
+    buffer[7u] = arg3;
+    buffer[8u] = arg4;
+    buffer[9u] = arg5;
+    buffer[10u] = arg6;
+    hci_cmd_store_variable_length_data(buffer, 11u, arg7, arg6);
+    uint16_t pos = 11u + arg6;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_read_all_local_supported_features into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_all_local_supported_features(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x87);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x87) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_all_remote_features into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param pages_requested
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_read_all_remote_features(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t pages_requested){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x88);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x88) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = pages_requested;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_read_local_supported_capabilities into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_read_local_supported_capabilities(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x89);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x89) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_read_remote_supported_capabilities into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_read_remote_supported_capabilities(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x8A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x8A) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_write_cached_remote_supported_capabilities into buffer
+ * @param buffer for HCI command of 32 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @param arg8
+ * @param arg9
+ * @param arg10
+ * @param arg11
+ * @param arg12
+ * @param arg13
+ * @param arg14
+ * @param arg15
+ * @param arg16
+ * @param arg17
+ * @param arg18
+ * @param arg19
+ * @param arg20
+ * @return size of HCI command
+ * @note: btstack_type H1211111111221222221
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_write_cached_remote_supported_capabilities(uint8_t * buffer, hci_con_handle_t arg1, uint8_t arg2, uint16_t arg3, uint8_t arg4, uint8_t arg5, uint8_t arg6, uint8_t arg7, uint8_t arg8, uint8_t arg9, uint8_t arg10, uint8_t arg11, uint16_t arg12, uint16_t arg13, uint8_t arg14, uint16_t arg15, uint16_t arg16, uint16_t arg17, uint16_t arg18, uint16_t arg19, uint8_t arg20){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x8B);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x8B) >> 8);
+    buffer[2] = 29u;
+    buffer[3u] = (uint8_t) arg1;
+    buffer[4u] = (uint8_t) (arg1 >> 8);
+    buffer[5u] = arg2;
+    buffer[6u] = (uint8_t) arg3;
+    buffer[7u] = (uint8_t) (arg3 >> 8);
+    buffer[8u] = arg4;
+    buffer[9u] = arg5;
+    buffer[10u] = arg6;
+    buffer[11u] = arg7;
+    buffer[12u] = arg8;
+    buffer[13u] = arg9;
+    buffer[14u] = arg10;
+    buffer[15u] = arg11;
+    buffer[16u] = (uint8_t) arg12;
+    buffer[17u] = (uint8_t) (arg12 >> 8);
+    buffer[18u] = (uint8_t) arg13;
+    buffer[19u] = (uint8_t) (arg13 >> 8);
+    buffer[20u] = arg14;
+    buffer[21u] = (uint8_t) arg15;
+    buffer[22u] = (uint8_t) (arg15 >> 8);
+    buffer[23u] = (uint8_t) arg16;
+    buffer[24u] = (uint8_t) (arg16 >> 8);
+    buffer[25u] = (uint8_t) arg17;
+    buffer[26u] = (uint8_t) (arg17 >> 8);
+    buffer[27u] = (uint8_t) arg18;
+    buffer[28u] = (uint8_t) (arg18 >> 8);
+    buffer[29u] = (uint8_t) arg19;
+    buffer[30u] = (uint8_t) (arg19 >> 8);
+    buffer[31u] = arg20;
+    return 32u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_security_enable into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_security_enable(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x8C);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x8C) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_set_default_settings into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param connection_handle
+ * @param role_enable
+ * @param cs_sync_ant_sel
+ * @param max_tx_power
+ * @return size of HCI command
+ * @note: btstack_type H111
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_set_default_settings(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t role_enable, uint8_t cs_sync_ant_sel, uint8_t max_tx_power){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x8D);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x8D) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = role_enable;
+    buffer[6u] = cs_sync_ant_sel;
+    buffer[7u] = max_tx_power;
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_read_remote_fae_table into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param connection_handle
+ * @return size of HCI command
+ * @note: btstack_type H
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_read_remote_fae_table(uint8_t * buffer, hci_con_handle_t connection_handle){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x8E);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x8E) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_write_cached_remote_fae_table into buffer
+ * @param buffer for HCI command of 77 bytes
+ * @param connection_handle
+ * @param remote_fae_table_0
+ * @param remote_fae_table_1
+ * @param remote_fae_table_2
+ * @param remote_fae_table_3
+ * @param remote_fae_table_4
+ * @return size of HCI command
+ * @note: btstack_type HPPPPD
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_write_cached_remote_fae_table(uint8_t * buffer, hci_con_handle_t connection_handle, const uint8_t * remote_fae_table_0, const uint8_t * remote_fae_table_1, const uint8_t * remote_fae_table_2, const uint8_t * remote_fae_table_3, const uint8_t * remote_fae_table_4){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x8F);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x8F) >> 8);
+    buffer[2] = 74u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    (void)memcpy(&buffer[5u], remote_fae_table_0, 16);
+    (void)memcpy(&buffer[21u], remote_fae_table_1, 16);
+    (void)memcpy(&buffer[37u], remote_fae_table_2, 16);
+    (void)memcpy(&buffer[53u], remote_fae_table_3, 16);
+    (void)memcpy(&buffer[69u], remote_fae_table_4, 8);
+    return 77u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_create_config into buffer
+ * @param buffer for HCI command of 31 bytes
+ * @param connection_handle
+ * @param config_id
+ * @param create_context
+ * @param main_mode_type
+ * @param sub_mode_type
+ * @param min_main_mode_steps
+ * @param max_main_mode_steps
+ * @param main_mode_repetition
+ * @param mode_0_steps
+ * @param role
+ * @param rtt_type
+ * @param cs_sync_phy
+ * @param channel_map_0_3
+ * @param channel_map_4_7
+ * @param channel_map_8_9
+ * @param channel_map_repetition
+ * @param channel_selection_type
+ * @param ch3c_shape
+ * @param ch3c_jump
+ * @param reserved
+ * @return size of HCI command
+ * @note: btstack_type H1111111111144211111
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_create_config(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t config_id, uint8_t create_context, uint8_t main_mode_type, uint8_t sub_mode_type, uint8_t min_main_mode_steps, uint8_t max_main_mode_steps, uint8_t main_mode_repetition, uint8_t mode_0_steps, uint8_t role, uint8_t rtt_type, uint8_t cs_sync_phy, uint32_t channel_map_0_3, uint32_t channel_map_4_7, uint16_t channel_map_8_9, uint8_t channel_map_repetition, uint8_t channel_selection_type, uint8_t ch3c_shape, uint8_t ch3c_jump, uint8_t reserved){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x90);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x90) >> 8);
+    buffer[2] = 28u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = config_id;
+    buffer[6u] = create_context;
+    buffer[7u] = main_mode_type;
+    buffer[8u] = sub_mode_type;
+    buffer[9u] = min_main_mode_steps;
+    buffer[10u] = max_main_mode_steps;
+    buffer[11u] = main_mode_repetition;
+    buffer[12u] = mode_0_steps;
+    buffer[13u] = role;
+    buffer[14u] = rtt_type;
+    buffer[15u] = cs_sync_phy;
+    buffer[16u] = (uint8_t) channel_map_0_3;
+    buffer[17u] = (uint8_t) (channel_map_0_3 >> 8);
+    buffer[18u] = (uint8_t) (channel_map_0_3 >> 16);
+    buffer[19u] = (uint8_t) (channel_map_0_3 >> 24);
+    buffer[20u] = (uint8_t) channel_map_4_7;
+    buffer[21u] = (uint8_t) (channel_map_4_7 >> 8);
+    buffer[22u] = (uint8_t) (channel_map_4_7 >> 16);
+    buffer[23u] = (uint8_t) (channel_map_4_7 >> 24);
+    buffer[24u] = (uint8_t) channel_map_8_9;
+    buffer[25u] = (uint8_t) (channel_map_8_9 >> 8);
+    buffer[26u] = channel_map_repetition;
+    buffer[27u] = channel_selection_type;
+    buffer[28u] = ch3c_shape;
+    buffer[29u] = ch3c_jump;
+    buffer[30u] = reserved;
+    return 31u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_remove_config into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param connection_handle
+ * @param config_id
+ * @return size of HCI command
+ * @note: btstack_type H1
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_remove_config(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t config_id){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x91);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x91) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = config_id;
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_set_channel_classification into buffer
+ * @param buffer for HCI command of 13 bytes
+ * @param ch_classification_0_3
+ * @param ch_classification_4_7
+ * @param ch_classification_8_9
+ * @return size of HCI command
+ * @note: btstack_type 442
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_set_channel_classification(uint8_t * buffer, uint32_t ch_classification_0_3, uint32_t ch_classification_4_7, uint16_t ch_classification_8_9){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x92);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x92) >> 8);
+    buffer[2] = 10u;
+    buffer[3u] = (uint8_t) ch_classification_0_3;
+    buffer[4u] = (uint8_t) (ch_classification_0_3 >> 8);
+    buffer[5u] = (uint8_t) (ch_classification_0_3 >> 16);
+    buffer[6u] = (uint8_t) (ch_classification_0_3 >> 24);
+    buffer[7u] = (uint8_t) ch_classification_4_7;
+    buffer[8u] = (uint8_t) (ch_classification_4_7 >> 8);
+    buffer[9u] = (uint8_t) (ch_classification_4_7 >> 16);
+    buffer[10u] = (uint8_t) (ch_classification_4_7 >> 24);
+    buffer[11u] = (uint8_t) ch_classification_8_9;
+    buffer[12u] = (uint8_t) (ch_classification_8_9 >> 8);
+    return 13u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_set_procedure_parameters into buffer
+ * @param buffer for HCI command of 26 bytes
+ * @param connection_handle
+ * @param config_id
+ * @param max_procedure_len
+ * @param min_procedure_interval
+ * @param max_procedure_interval
+ * @param max_procedure_count
+ * @param min_subevent_len
+ * @param max_subevent_len
+ * @param tone_antenna_config_selection
+ * @param phy
+ * @param tx_power_delta
+ * @param preferred_peer_antenna
+ * @param snr_control_initiator
+ * @param snr_control_reflector
+ * @return size of HCI command
+ * @note: btstack_type H1222233111111
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_set_procedure_parameters(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t config_id, uint16_t max_procedure_len, uint16_t min_procedure_interval, uint16_t max_procedure_interval, uint16_t max_procedure_count, uint32_t min_subevent_len, uint32_t max_subevent_len, uint8_t tone_antenna_config_selection, uint8_t phy, uint8_t tx_power_delta, uint8_t preferred_peer_antenna, uint8_t snr_control_initiator, uint8_t snr_control_reflector){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x93);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x93) >> 8);
+    buffer[2] = 23u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = config_id;
+    buffer[6u] = (uint8_t) max_procedure_len;
+    buffer[7u] = (uint8_t) (max_procedure_len >> 8);
+    buffer[8u] = (uint8_t) min_procedure_interval;
+    buffer[9u] = (uint8_t) (min_procedure_interval >> 8);
+    buffer[10u] = (uint8_t) max_procedure_interval;
+    buffer[11u] = (uint8_t) (max_procedure_interval >> 8);
+    buffer[12u] = (uint8_t) max_procedure_count;
+    buffer[13u] = (uint8_t) (max_procedure_count >> 8);
+    buffer[14u] = (uint8_t) min_subevent_len;
+    buffer[15u] = (uint8_t) (min_subevent_len >> 8);
+    buffer[16u] = (uint8_t) (min_subevent_len >> 16);
+    buffer[17u] = (uint8_t) max_subevent_len;
+    buffer[18u] = (uint8_t) (max_subevent_len >> 8);
+    buffer[19u] = (uint8_t) (max_subevent_len >> 16);
+    buffer[20u] = tone_antenna_config_selection;
+    buffer[21u] = phy;
+    buffer[22u] = tx_power_delta;
+    buffer[23u] = preferred_peer_antenna;
+    buffer[24u] = snr_control_initiator;
+    buffer[25u] = snr_control_reflector;
+    return 26u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_set_procedure_enable into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param connection_handle
+ * @param config_id
+ * @param enable
+ * @return size of HCI command
+ * @note: btstack_type H11
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_set_procedure_enable(uint8_t * buffer, hci_con_handle_t connection_handle, uint8_t config_id, uint8_t enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x94);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x94) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = config_id;
+    buffer[6u] = enable;
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_le_cs_test into buffer
+ * @param buffer for HCI command of up to 288 bytes
+ * @param main_mode_type
+ * @param sub_mode_type
+ * @param main_mode_repetition
+ * @param mode_0_steps
+ * @param role
+ * @param rtt_type
+ * @param cs_sync_phy
+ * @param cs_sync_antenna_selection
+ * @param subevent_len
+ * @param subevent_interval
+ * @param max_num_subevents
+ * @param transmit_power_level
+ * @param t_ip1_time
+ * @param t_ip2_time
+ * @param t_fcs_time
+ * @param t_pm_time
+ * @param t_sw_time
+ * @param tone_antenna_config_selection
+ * @param reserved
+ * @param snr_control_initiator
+ * @param snr_control_reflector
+ * @param drbg_nonce
+ * @param channel_map_repetition
+ * @param override_config
+ * @param override_parameters_length
+ * @param override_parameters_data
+ * @return size of HCI command
+ * @note: btstack_type 111111113211111111111212JV
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_test(uint8_t * buffer, uint8_t main_mode_type, uint8_t sub_mode_type, uint8_t main_mode_repetition, uint8_t mode_0_steps, uint8_t role, uint8_t rtt_type, uint8_t cs_sync_phy, uint8_t cs_sync_antenna_selection, uint32_t subevent_len, uint16_t subevent_interval, uint8_t max_num_subevents, uint8_t transmit_power_level, uint8_t t_ip1_time, uint8_t t_ip2_time, uint8_t t_fcs_time, uint8_t t_pm_time, uint8_t t_sw_time, uint8_t tone_antenna_config_selection, uint8_t reserved, uint8_t snr_control_initiator, uint8_t snr_control_reflector, uint16_t drbg_nonce, uint8_t channel_map_repetition, uint16_t override_config, uint8_t override_parameters_length, const uint8_t * override_parameters_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x95);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x95) >> 8);
+    buffer[3u] = main_mode_type;
+    buffer[4u] = sub_mode_type;
+    buffer[5u] = main_mode_repetition;
+    buffer[6u] = mode_0_steps;
+    buffer[7u] = role;
+    buffer[8u] = rtt_type;
+    buffer[9u] = cs_sync_phy;
+    buffer[10u] = cs_sync_antenna_selection;
+    buffer[11u] = (uint8_t) subevent_len;
+    buffer[12u] = (uint8_t) (subevent_len >> 8);
+    buffer[13u] = (uint8_t) (subevent_len >> 16);
+    buffer[14u] = (uint8_t) subevent_interval;
+    buffer[15u] = (uint8_t) (subevent_interval >> 8);
+    buffer[16u] = max_num_subevents;
+    buffer[17u] = transmit_power_level;
+    buffer[18u] = t_ip1_time;
+    buffer[19u] = t_ip2_time;
+    buffer[20u] = t_fcs_time;
+    buffer[21u] = t_pm_time;
+    buffer[22u] = t_sw_time;
+    buffer[23u] = tone_antenna_config_selection;
+    buffer[24u] = reserved;
+    buffer[25u] = snr_control_initiator;
+    buffer[26u] = snr_control_reflector;
+    buffer[27u] = (uint8_t) drbg_nonce;
+    buffer[28u] = (uint8_t) (drbg_nonce >> 8);
+    buffer[29u] = channel_map_repetition;
+    buffer[30u] = (uint8_t) override_config;
+    buffer[31u] = (uint8_t) (override_config >> 8);
+    buffer[32u] = override_parameters_length;
+    hci_cmd_store_variable_length_data(buffer, 33u, override_parameters_data, override_parameters_length);
+    uint16_t pos = 33u + override_parameters_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_cs_test_end into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_cs_test_end(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x96);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x96) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_add_device_to_monitored_advertisers_list into buffer
+ * @param buffer for HCI command of 13 bytes
+ * @param address_type
+ * @param address
+ * @param rssi_low_threshold
+ * @param rssi_high_threshold
+ * @param timeout
+ * @return size of HCI command
+ * @note: btstack_type 1B111
+ */
+static inline uint16_t hci_cmd_serialize_le_add_device_to_monitored_advertisers_list(uint8_t * buffer, uint8_t address_type, const bd_addr_t address, uint8_t rssi_low_threshold, uint8_t rssi_high_threshold, uint8_t timeout){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x98);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x98) >> 8);
+    buffer[2] = 10u;
+    buffer[3u] = address_type;
+    reverse_bd_addr(address, &buffer[4u]);
+    buffer[10u] = rssi_low_threshold;
+    buffer[11u] = rssi_high_threshold;
+    buffer[12u] = timeout;
+    return 13u;
+}
+
+/**
+ * @brief Serialize hci_le_remove_device_from_monitored_advertisers_list into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param address_type
+ * @param address
+ * @return size of HCI command
+ * @note: btstack_type 1B
+ */
+static inline uint16_t hci_cmd_serialize_le_remove_device_from_monitored_advertisers_list(uint8_t * buffer, uint8_t address_type, const bd_addr_t address){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x99);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x99) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = address_type;
+    reverse_bd_addr(address, &buffer[4u]);
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_le_clear_monitored_advertisers_list into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_clear_monitored_advertisers_list(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x9A);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x9A) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_read_monitored_advertisers_list_size into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_monitored_advertisers_list_size(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x9B);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x9B) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_le_enable_monitoring_advertisers into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_enable_monitoring_advertisers(uint8_t * buffer, uint8_t enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x9C);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x9C) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_frame_space_update into buffer
+ * @param buffer for HCI command of 12 bytes
+ * @param connection_handle
+ * @param frame_space_min
+ * @param frame_space_max
+ * @param phys
+ * @param spacing_types
+ * @return size of HCI command
+ * @note: btstack_type H2212
+ */
+static inline uint16_t hci_cmd_serialize_le_frame_space_update(uint8_t * buffer, hci_con_handle_t connection_handle, uint16_t frame_space_min, uint16_t frame_space_max, uint8_t phys, uint16_t spacing_types){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x9D);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x9D) >> 8);
+    buffer[2] = 9u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = (uint8_t) frame_space_min;
+    buffer[6u] = (uint8_t) (frame_space_min >> 8);
+    buffer[7u] = (uint8_t) frame_space_max;
+    buffer[8u] = (uint8_t) (frame_space_max >> 8);
+    buffer[9u] = phys;
+    buffer[10u] = (uint8_t) spacing_types;
+    buffer[11u] = (uint8_t) (spacing_types >> 8);
+    return 12u;
+}
+
+/**
+ * @brief Serialize hci_le_enable_utp_ota_mode into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param enable
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_le_enable_utp_ota_mode(uint8_t * buffer, uint8_t enable){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0x9F);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0x9F) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = enable;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_le_utp_send into buffer
+ * @param buffer for HCI command of up to 259 bytes
+ * @param utp_data_length
+ * @param utp_data
+ * @return size of HCI command
+ * @note: btstack_type JV
+ */
+static inline uint16_t hci_cmd_serialize_le_utp_send(uint8_t * buffer, uint8_t utp_data_length, const uint8_t * utp_data){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0xA0);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0xA0) >> 8);
+    buffer[3u] = utp_data_length;
+    hci_cmd_store_variable_length_data(buffer, 4u, utp_data, utp_data_length);
+    uint16_t pos = 4u + utp_data_length;
+    buffer[2] = (uint8_t) (pos - 3u);
+    return pos;
+}
+
+/**
+ * @brief Serialize hci_le_connection_rate_request into buffer
+ * @param buffer for HCI command of 23 bytes
+ * @param connection_handle
+ * @param connection_interval_min
+ * @param connection_interval_max
+ * @param subrate_min
+ * @param subrate_max
+ * @param max_latency
+ * @param continuation_number
+ * @param supervision_timeout
+ * @param min_ce_length
+ * @param max_ce_length
+ * @return size of HCI command
+ * @note: btstack_type H222222222
+ */
+static inline uint16_t hci_cmd_serialize_le_connection_rate_request(uint8_t * buffer, hci_con_handle_t connection_handle, uint16_t connection_interval_min, uint16_t connection_interval_max, uint16_t subrate_min, uint16_t subrate_max, uint16_t max_latency, uint16_t continuation_number, uint16_t supervision_timeout, uint16_t min_ce_length, uint16_t max_ce_length){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0xA1);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0xA1) >> 8);
+    buffer[2] = 20u;
+    buffer[3u] = (uint8_t) connection_handle;
+    buffer[4u] = (uint8_t) (connection_handle >> 8);
+    buffer[5u] = (uint8_t) connection_interval_min;
+    buffer[6u] = (uint8_t) (connection_interval_min >> 8);
+    buffer[7u] = (uint8_t) connection_interval_max;
+    buffer[8u] = (uint8_t) (connection_interval_max >> 8);
+    buffer[9u] = (uint8_t) subrate_min;
+    buffer[10u] = (uint8_t) (subrate_min >> 8);
+    buffer[11u] = (uint8_t) subrate_max;
+    buffer[12u] = (uint8_t) (subrate_max >> 8);
+    buffer[13u] = (uint8_t) max_latency;
+    buffer[14u] = (uint8_t) (max_latency >> 8);
+    buffer[15u] = (uint8_t) continuation_number;
+    buffer[16u] = (uint8_t) (continuation_number >> 8);
+    buffer[17u] = (uint8_t) supervision_timeout;
+    buffer[18u] = (uint8_t) (supervision_timeout >> 8);
+    buffer[19u] = (uint8_t) min_ce_length;
+    buffer[20u] = (uint8_t) (min_ce_length >> 8);
+    buffer[21u] = (uint8_t) max_ce_length;
+    buffer[22u] = (uint8_t) (max_ce_length >> 8);
+    return 23u;
+}
+
+/**
+ * @brief Serialize hci_le_set_default_rate_parameters into buffer
+ * @param buffer for HCI command of 21 bytes
+ * @param connection_interval_min
+ * @param connection_interval_max
+ * @param subrate_min
+ * @param subrate_max
+ * @param max_latency
+ * @param continuation_number
+ * @param supervision_timeout
+ * @param min_ce_length
+ * @param max_ce_length
+ * @return size of HCI command
+ * @note: btstack_type 222222222
+ */
+static inline uint16_t hci_cmd_serialize_le_set_default_rate_parameters(uint8_t * buffer, uint16_t connection_interval_min, uint16_t connection_interval_max, uint16_t subrate_min, uint16_t subrate_max, uint16_t max_latency, uint16_t continuation_number, uint16_t supervision_timeout, uint16_t min_ce_length, uint16_t max_ce_length){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0xA2);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0xA2) >> 8);
+    buffer[2] = 18u;
+    buffer[3u] = (uint8_t) connection_interval_min;
+    buffer[4u] = (uint8_t) (connection_interval_min >> 8);
+    buffer[5u] = (uint8_t) connection_interval_max;
+    buffer[6u] = (uint8_t) (connection_interval_max >> 8);
+    buffer[7u] = (uint8_t) subrate_min;
+    buffer[8u] = (uint8_t) (subrate_min >> 8);
+    buffer[9u] = (uint8_t) subrate_max;
+    buffer[10u] = (uint8_t) (subrate_max >> 8);
+    buffer[11u] = (uint8_t) max_latency;
+    buffer[12u] = (uint8_t) (max_latency >> 8);
+    buffer[13u] = (uint8_t) continuation_number;
+    buffer[14u] = (uint8_t) (continuation_number >> 8);
+    buffer[15u] = (uint8_t) supervision_timeout;
+    buffer[16u] = (uint8_t) (supervision_timeout >> 8);
+    buffer[17u] = (uint8_t) min_ce_length;
+    buffer[18u] = (uint8_t) (min_ce_length >> 8);
+    buffer[19u] = (uint8_t) max_ce_length;
+    buffer[20u] = (uint8_t) (max_ce_length >> 8);
+    return 21u;
+}
+
+/**
+ * @brief Serialize hci_le_read_minimum_supported_connection_interval into buffer
+ * @param buffer for HCI command of 3 bytes
+ * @return size of HCI command
+ * @note: btstack_type
+ */
+static inline uint16_t hci_cmd_serialize_le_read_minimum_supported_connection_interval(uint8_t * buffer){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_LE_CONTROLLER, 0xA3);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_LE_CONTROLLER, 0xA3) >> 8);
+    buffer[2] = 0u;
+    return 3u;
+}
+
+/**
+ * @brief Serialize hci_bcm_enable_wbs into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param enable_wbs
+ * @param uuid_wbs
+ * @return size of HCI command
+ * @note: btstack_type 12
+ */
+static inline uint16_t hci_cmd_serialize_bcm_enable_wbs(uint8_t * buffer, uint8_t enable_wbs, uint16_t uuid_wbs){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x7e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x7e) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = enable_wbs;
+    buffer[4u] = (uint8_t) uuid_wbs;
+    buffer[5u] = (uint8_t) (uuid_wbs >> 8);
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_bcm_pcm2_setup into buffer
+ * @param buffer for HCI command of 29 bytes
+ * @param action
+ * @param test_options
+ * @param op_mode
+ * @param sync_and_clock_options
+ * @param pcm_clock_freq
+ * @param sync_signal_width
+ * @param slot_width
+ * @param number_of_slots
+ * @param bank_0_fill_mode
+ * @param bank_0_number_of_fill_bits
+ * @param bank_0_programmable_fill_data
+ * @param bank_1_fill_mode
+ * @param bank_1_number_of_fill_bits
+ * @param bank_1_programmable_fill_data
+ * @param data_justify_and_bit_order_options
+ * @param ch_0_slot_number
+ * @param ch_1_slot_number
+ * @param ch_2_slot_number
+ * @param ch_3_slot_number
+ * @param ch_4_slot_number
+ * @param ch_0_period
+ * @param ch_1_period
+ * @param ch_2_period
+ * @return size of HCI command
+ * @note: btstack_type 11114111111111111111111
+ */
+static inline uint16_t hci_cmd_serialize_bcm_pcm2_setup(uint8_t * buffer, uint8_t action, uint8_t test_options, uint8_t op_mode, uint8_t sync_and_clock_options, uint32_t pcm_clock_freq, uint8_t sync_signal_width, uint8_t slot_width, uint8_t number_of_slots, uint8_t bank_0_fill_mode, uint8_t bank_0_number_of_fill_bits, uint8_t bank_0_programmable_fill_data, uint8_t bank_1_fill_mode, uint8_t bank_1_number_of_fill_bits, uint8_t bank_1_programmable_fill_data, uint8_t data_justify_and_bit_order_options, uint8_t ch_0_slot_number, uint8_t ch_1_slot_number, uint8_t ch_2_slot_number, uint8_t ch_3_slot_number, uint8_t ch_4_slot_number, uint8_t ch_0_period, uint8_t ch_1_period, uint8_t ch_2_period){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0xae);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0xae) >> 8);
+    buffer[2] = 26u;
+    buffer[3u] = action;
+    buffer[4u] = test_options;
+    buffer[5u] = op_mode;
+    buffer[6u] = sync_and_clock_options;
+    buffer[7u] = (uint8_t) pcm_clock_freq;
+    buffer[8u] = (uint8_t) (pcm_clock_freq >> 8);
+    buffer[9u] = (uint8_t) (pcm_clock_freq >> 16);
+    buffer[10u] = (uint8_t) (pcm_clock_freq >> 24);
+    buffer[11u] = sync_signal_width;
+    buffer[12u] = slot_width;
+    buffer[13u] = number_of_slots;
+    buffer[14u] = bank_0_fill_mode;
+    buffer[15u] = bank_0_number_of_fill_bits;
+    buffer[16u] = bank_0_programmable_fill_data;
+    buffer[17u] = bank_1_fill_mode;
+    buffer[18u] = bank_1_number_of_fill_bits;
+    buffer[19u] = bank_1_programmable_fill_data;
+    buffer[20u] = data_justify_and_bit_order_options;
+    buffer[21u] = ch_0_slot_number;
+    buffer[22u] = ch_1_slot_number;
+    buffer[23u] = ch_2_slot_number;
+    buffer[24u] = ch_3_slot_number;
+    buffer[25u] = ch_4_slot_number;
+    buffer[26u] = ch_0_period;
+    buffer[27u] = ch_1_period;
+    buffer[28u] = ch_2_period;
+    return 29u;
+}
+
+/**
+ * @brief Serialize hci_bcm_write_sco_pcm_int into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param sco_routing
+ * @param pcm_interface_rate
+ * @param frame_type
+ * @param sync_mode
+ * @param clock_mode
+ * @return size of HCI command
+ * @note: btstack_type 11111
+ */
+static inline uint16_t hci_cmd_serialize_bcm_write_sco_pcm_int(uint8_t * buffer, uint8_t sco_routing, uint8_t pcm_interface_rate, uint8_t frame_type, uint8_t sync_mode, uint8_t clock_mode){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x1c);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x1c) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = sco_routing;
+    buffer[4u] = pcm_interface_rate;
+    buffer[5u] = frame_type;
+    buffer[6u] = sync_mode;
+    buffer[7u] = clock_mode;
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_bcm_write_pcm_data_format_param into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param lsb_position
+ * @param fill_bits_value
+ * @param fill_data_selection
+ * @param number_of_fill_bits
+ * @param right_left_justification
+ * @return size of HCI command
+ * @note: btstack_type 11111
+ */
+static inline uint16_t hci_cmd_serialize_bcm_write_pcm_data_format_param(uint8_t * buffer, uint8_t lsb_position, uint8_t fill_bits_value, uint8_t fill_data_selection, uint8_t number_of_fill_bits, uint8_t right_left_justification){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x1e);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x1e) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = lsb_position;
+    buffer[4u] = fill_bits_value;
+    buffer[5u] = fill_data_selection;
+    buffer[6u] = number_of_fill_bits;
+    buffer[7u] = right_left_justification;
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_bcm_write_i2spcm_interface_param into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param i2s_enable
+ * @param is_master
+ * @param sample_rate
+ * @param clock_rate
+ * @return size of HCI command
+ * @note: btstack_type 1111
+ */
+static inline uint16_t hci_cmd_serialize_bcm_write_i2spcm_interface_param(uint8_t * buffer, uint8_t i2s_enable, uint8_t is_master, uint8_t sample_rate, uint8_t clock_rate){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x6d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x6d) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = i2s_enable;
+    buffer[4u] = is_master;
+    buffer[5u] = sample_rate;
+    buffer[6u] = clock_rate;
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_bcm_set_sleep_mode into buffer
+ * @param buffer for HCI command of 15 bytes
+ * @param sleep_mode
+ * @param idle_threshold_host
+ * @param idle_threshold_controller
+ * @param bt_wake_active_mode
+ * @param host_wake_active_mode
+ * @param allow_host_sleep_during_sco
+ * @param combine_sleep_mode_and_lpm
+ * @param enable_tristate_control_of_uart_tx_line
+ * @param active_connection_handling_on_suspend
+ * @param resume_timeout
+ * @param enable_break_to_host
+ * @param pulsed_host_wake
+ * @return size of HCI command
+ * @note: btstack_type 111111111111
+ */
+static inline uint16_t hci_cmd_serialize_bcm_set_sleep_mode(uint8_t * buffer, uint8_t sleep_mode, uint8_t idle_threshold_host, uint8_t idle_threshold_controller, uint8_t bt_wake_active_mode, uint8_t host_wake_active_mode, uint8_t allow_host_sleep_during_sco, uint8_t combine_sleep_mode_and_lpm, uint8_t enable_tristate_control_of_uart_tx_line, uint8_t active_connection_handling_on_suspend, uint8_t resume_timeout, uint8_t enable_break_to_host, uint8_t pulsed_host_wake){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x27);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x27) >> 8);
+    buffer[2] = 12u;
+    buffer[3u] = sleep_mode;
+    buffer[4u] = idle_threshold_host;
+    buffer[5u] = idle_threshold_controller;
+    buffer[6u] = bt_wake_active_mode;
+    buffer[7u] = host_wake_active_mode;
+    buffer[8u] = allow_host_sleep_during_sco;
+    buffer[9u] = combine_sleep_mode_and_lpm;
+    buffer[10u] = enable_tristate_control_of_uart_tx_line;
+    buffer[11u] = active_connection_handling_on_suspend;
+    buffer[12u] = resume_timeout;
+    buffer[13u] = enable_break_to_host;
+    buffer[14u] = pulsed_host_wake;
+    return 15u;
+}
+
+/**
+ * @brief Serialize hci_bcm_write_tx_power_table into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param is_le
+ * @param chip_max_tx_pwr_db
+ * @return size of HCI command
+ * @note: btstack_type 11
+ */
+static inline uint16_t hci_cmd_serialize_bcm_write_tx_power_table(uint8_t * buffer, uint8_t is_le, uint8_t chip_max_tx_pwr_db){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x1C9);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x1C9) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = is_le;
+    buffer[4u] = chip_max_tx_pwr_db;
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_bcm_set_tx_pwr into buffer
+ * @param buffer for HCI command of 7 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @return size of HCI command
+ * @note: btstack_type 11H
+ */
+static inline uint16_t hci_cmd_serialize_bcm_set_tx_pwr(uint8_t * buffer, uint8_t arg1, uint8_t arg2, hci_con_handle_t arg3){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x1A5);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x1A5) >> 8);
+    buffer[2] = 4u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    buffer[5u] = (uint8_t) arg3;
+    buffer[6u] = (uint8_t) (arg3 >> 8);
+    return 7u;
+}
+
+/**
+ * @brief Serialize hci_ti_configure_ddip into buffer
+ * @param buffer for HCI command of 10 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @return size of HCI command
+ * @note: btstack_type 1111111
+ */
+static inline uint16_t hci_cmd_serialize_ti_configure_ddip(uint8_t * buffer, uint8_t arg1, uint8_t arg2, uint8_t arg3, uint8_t arg4, uint8_t arg5, uint8_t arg6, uint8_t arg7){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x155);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x155) >> 8);
+    buffer[2] = 7u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    buffer[5u] = arg3;
+    buffer[6u] = arg4;
+    buffer[7u] = arg5;
+    buffer[8u] = arg6;
+    buffer[9u] = arg7;
+    return 10u;
+}
+
+/**
+ * @brief Serialize hci_rtk_configure_sco_routing into buffer
+ * @param buffer for HCI command of 12 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @param arg6
+ * @param arg7
+ * @param arg8
+ * @param arg9
+ * @return size of HCI command
+ * @note: btstack_type 111111111
+ */
+static inline uint16_t hci_cmd_serialize_rtk_configure_sco_routing(uint8_t * buffer, uint8_t arg1, uint8_t arg2, uint8_t arg3, uint8_t arg4, uint8_t arg5, uint8_t arg6, uint8_t arg7, uint8_t arg8, uint8_t arg9){
+    buffer[0] = (uint8_t) HCI_OPCODE(0x3f, 0x93);
+    buffer[1] = (uint8_t) (HCI_OPCODE(0x3f, 0x93) >> 8);
+    buffer[2] = 9u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    buffer[5u] = arg3;
+    buffer[6u] = arg4;
+    buffer[7u] = arg5;
+    buffer[8u] = arg6;
+    buffer[9u] = arg7;
+    buffer[10u] = arg8;
+    buffer[11u] = arg9;
+    return 12u;
+}
+
+/**
+ * @brief Serialize hci_rtk_read_card_info into buffer
+ * @param buffer for HCI command of 8 bytes
+ * @param arg1
+ * @param arg2
+ * @param arg3
+ * @param arg4
+ * @param arg5
+ * @return size of HCI command
+ * @note: btstack_type 11111
+ */
+static inline uint16_t hci_cmd_serialize_rtk_read_card_info(uint8_t * buffer, uint8_t arg1, uint8_t arg2, uint8_t arg3, uint8_t arg4, uint8_t arg5){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x061);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x061) >> 8);
+    buffer[2] = 5u;
+    buffer[3u] = arg1;
+    buffer[4u] = arg2;
+    buffer[5u] = arg3;
+    buffer[6u] = arg4;
+    buffer[7u] = arg5;
+    return 8u;
+}
+
+/**
+ * @brief Serialize hci_nxp_set_sco_data_path into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param voice_path
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_nxp_set_sco_data_path(uint8_t * buffer, uint8_t voice_path){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x01d);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x01d) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = voice_path;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_nxp_write_pcm_i2s_settings into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param settings
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_nxp_write_pcm_i2s_settings(uint8_t * buffer, uint8_t settings){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x007);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x007) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = settings;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_nxp_write_pcm_i2s_sync_settings into buffer
+ * @param buffer for HCI command of 6 bytes
+ * @param sync_settings_1
+ * @param sync_settings_2
+ * @return size of HCI command
+ * @note: btstack_type 12
+ */
+static inline uint16_t hci_cmd_serialize_nxp_write_pcm_i2s_sync_settings(uint8_t * buffer, uint8_t sync_settings_1, uint16_t sync_settings_2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x028);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x028) >> 8);
+    buffer[2] = 3u;
+    buffer[3u] = sync_settings_1;
+    buffer[4u] = (uint8_t) sync_settings_2;
+    buffer[5u] = (uint8_t) (sync_settings_2 >> 8);
+    return 6u;
+}
+
+/**
+ * @brief Serialize hci_nxp_write_pcm_link_settings into buffer
+ * @param buffer for HCI command of 5 bytes
+ * @param settings
+ * @return size of HCI command
+ * @note: btstack_type 2
+ */
+static inline uint16_t hci_cmd_serialize_nxp_write_pcm_link_settings(uint8_t * buffer, uint16_t settings){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x029);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x029) >> 8);
+    buffer[2] = 2u;
+    buffer[3u] = (uint8_t) settings;
+    buffer[4u] = (uint8_t) (settings >> 8);
+    return 5u;
+}
+
+/**
+ * @brief Serialize hci_nxp_set_wbs_connection into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param next_connection_wbs
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_nxp_set_wbs_connection(uint8_t * buffer, uint8_t next_connection_wbs){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x073);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x073) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = next_connection_wbs;
+    return 4u;
+}
+
+/**
+ * @brief Serialize hci_nxp_host_pcm_i2s_audio_config into buffer
+ * @param buffer for HCI command of 9 bytes
+ * @param action
+ * @param operation
+ * @param sco_handle_1
+ * @param sco_handle_2
+ * @return size of HCI command
+ * @note: btstack_type 11HH
+ */
+static inline uint16_t hci_cmd_serialize_nxp_host_pcm_i2s_audio_config(uint8_t * buffer, uint8_t action, uint8_t operation, hci_con_handle_t sco_handle_1, hci_con_handle_t sco_handle_2){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x06f);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x06f) >> 8);
+    buffer[2] = 6u;
+    buffer[3u] = action;
+    buffer[4u] = operation;
+    buffer[5u] = (uint8_t) sco_handle_1;
+    buffer[6u] = (uint8_t) (sco_handle_1 >> 8);
+    buffer[7u] = (uint8_t) sco_handle_2;
+    buffer[8u] = (uint8_t) (sco_handle_2 >> 8);
+    return 9u;
+}
+
+/**
+ * @brief Serialize hci_nxp_host_pcm_i2s_control_enable into buffer
+ * @param buffer for HCI command of 4 bytes
+ * @param action
+ * @return size of HCI command
+ * @note: btstack_type 1
+ */
+static inline uint16_t hci_cmd_serialize_nxp_host_pcm_i2s_control_enable(uint8_t * buffer, uint8_t action){
+    buffer[0] = (uint8_t) HCI_OPCODE(OGF_VENDOR, 0x070);
+    buffer[1] = (uint8_t) (HCI_OPCODE(OGF_VENDOR, 0x070) >> 8);
+    buffer[2] = 1u;
+    buffer[3u] = action;
+    return 4u;
+}
+
+
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // HCI_CMD_SERIALIZER_H
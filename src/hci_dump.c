@@ -52,6 +52,20 @@
 #include <stdio.h>
 #endif
 
+#ifdef ENABLE_HCI_DUMP_FILTER
+#include "l2cap_signaling.h"
+
+// max number of dynamic L2CAP channels tracked for PSM and local CID lookup
+#ifndef HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS
+#define HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS 8
+#endif
+
+// max number of ACL connections tracked for snaplen of fragmented L2CAP PDUs
+#ifndef HCI_DUMP_FILTER_MAX_CONNECTIONS
+#define HCI_DUMP_FILTER_MAX_CONNECTIONS 4
+#endif
+#endif
+
 static const hci_dump_t * hci_dump_implementation;
 static int  max_nr_packets;
 static int  nr_packets;
@@ -70,6 +84,251 @@ static bool packet_log_enabled;
 // levels: debug, info, error
 static bool log_level_enabled[3] = { 1, 1, 1};
 
+#ifdef ENABLE_HCI_DUMP_FILTER
+typedef struct {
+    hci_con_handle_t con_handle;
+    uint16_t psm;
+    // 0 until known from connection request or response
+    uint16_t local_cid;
+    uint16_t remote_cid;
+    uint8_t  identifier;
+} hci_dump_filter_channel_t;
+
+typedef struct {
+    hci_con_handle_t con_handle;
+    // snaplen left for continuation fragments of current L2CAP PDU, per direction
+    uint16_t snaplen_remaining[2];
+} hci_dump_filter_connection_t;
+
+static btstack_linked_list_t        hci_dump_filters;
+static uint16_t                     hci_dump_filter_default_snaplen = HCI_DUMP_SNAPLEN_UNLIMITED;
+static hci_dump_filter_channel_t    hci_dump_filter_channels[HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS];
+static hci_dump_filter_connection_t hci_dump_filter_connections[HCI_DUMP_FILTER_MAX_CONNECTIONS];
+
+static void hci_dump_filter_reset_state(void){
+    uint16_t i;
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS; i++){
+        hci_dump_filter_channels[i].con_handle = HCI_CON_HANDLE_INVALID;
+    }
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_CONNECTIONS; i++){
+        hci_dump_filter_connections[i].con_handle = HCI_CON_HANDLE_INVALID;
+    }
+}
+
+static void hci_dump_filter_handle_disconnect(hci_con_handle_t con_handle){
+    uint16_t i;
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS; i++){
+        if (hci_dump_filter_channels[i].con_handle == con_handle){
+            hci_dump_filter_channels[i].con_handle = HCI_CON_HANDLE_INVALID;
+        }
+    }
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_CONNECTIONS; i++){
+        if (hci_dump_filter_connections[i].con_handle == con_handle){
+            hci_dump_filter_connections[i].con_handle = HCI_CON_HANDLE_INVALID;
+        }
+    }
+}
+
+static hci_dump_filter_connection_t * hci_dump_filter_get_connection(hci_con_handle_t con_handle){
+    hci_dump_filter_connection_t * free_connection = NULL;
+    uint16_t i;
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_CONNECTIONS; i++){
+        hci_dump_filter_connection_t * connection = &hci_dump_filter_connections[i];
+        if (connection->con_handle == con_handle){
+            return connection;
+        }
+        if ((connection->con_handle == HCI_CON_HANDLE_INVALID) && (free_connection == NULL)){
+            free_connection = connection;
+        }
+    }
+    if (free_connection != NULL){
+        free_connection->con_handle = con_handle;
+        free_connection->snaplen_remaining[0] = HCI_DUMP_SNAPLEN_UNLIMITED;
+        free_connection->snaplen_remaining[1] = HCI_DUMP_SNAPLEN_UNLIMITED;
+    }
+    return free_connection;
+}
+
+// incoming packets are sent to local CID, outgoing packets to remote CID
+static hci_dump_filter_channel_t * hci_dump_filter_get_channel(hci_con_handle_t con_handle, uint8_t in, uint16_t cid){
+    uint16_t i;
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS; i++){
+        hci_dump_filter_channel_t * channel = &hci_dump_filter_channels[i];
+        if (channel->con_handle != con_handle) continue;
+        if (((in != 0u) ? channel->local_cid : channel->remote_cid) == cid){
+            return channel;
+        }
+    }
+    return NULL;
+}
+
+static void hci_dump_filter_handle_connection_request(hci_con_handle_t con_handle, uint8_t in, uint8_t identifier, uint16_t psm, uint16_t source_cid){
+    uint16_t i;
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS; i++){
+        hci_dump_filter_channel_t * channel = &hci_dump_filter_channels[i];
+        if (channel->con_handle != HCI_CON_HANDLE_INVALID) continue;
+        channel->con_handle = con_handle;
+        channel->psm        = psm;
+        channel->identifier = identifier;
+        channel->local_cid  = (in != 0u) ? 0 : source_cid;
+        channel->remote_cid = (in != 0u) ? source_cid : 0;
+        return;
+    }
+}
+
+// complete first pending channel of the request with the same identifier, sent in the opposite direction
+static void hci_dump_filter_handle_connection_response(hci_con_handle_t con_handle, uint8_t in, uint8_t identifier, uint16_t destination_cid, bool success){
+    uint16_t i;
+    for (i = 0; i < HCI_DUMP_FILTER_MAX_L2CAP_CHANNELS; i++){
+        hci_dump_filter_channel_t * channel = &hci_dump_filter_channels[i];
+        if (channel->con_handle != con_handle) continue;
+        if (channel->identifier != identifier) continue;
+        uint16_t * responder_cid = (in != 0u) ? &channel->remote_cid : &channel->local_cid;
+        if (*responder_cid != 0u) continue;
+        if (success){
+            *responder_cid = destination_cid;
+        } else {
+            channel->con_handle = HCI_CON_HANDLE_INVALID;
+        }
+        return;
+    }
+}
+
+static void hci_dump_filter_handle_signaling(hci_con_handle_t con_handle, uint8_t in, const uint8_t * packet, uint16_t len){
+    uint16_t pos = 8;
+    while ((pos + 4u) <= len){
+        uint8_t  code       = packet[pos];
+        uint8_t  identifier = packet[pos + 1u];
+        uint16_t cmd_len    = little_endian_read_16(packet, pos + 2u);
+        pos += 4u;
+        if ((pos + cmd_len) > len) break;
+        const uint8_t * command = &packet[pos];
+        pos += cmd_len;
+        uint16_t result;
+        uint16_t i;
+        switch (code){
+            case CONNECTION_REQUEST:
+            case LE_CREDIT_BASED_CONNECTION_REQUEST:
+                // psm, source cid
+                if (cmd_len < 4u) break;
+                hci_dump_filter_handle_connection_request(con_handle, in, identifier, little_endian_read_16(command, 0), little_endian_read_16(command, 2));
+                break;
+            case CONNECTION_RESPONSE:
+                // destination cid, source cid, result, status
+                if (cmd_len < 6u) break;
+                result = little_endian_read_16(command, 4);
+                if (result == 0x0001u) break; // pending
+                hci_dump_filter_handle_connection_response(con_handle, in, identifier, little_endian_read_16(command, 0), result == 0u);
+                break;
+            case LE_CREDIT_BASED_CONNECTION_RESPONSE:
+                // destination cid, mtu, mps, initial credits, result
+                if (cmd_len < 10u) break;
+                hci_dump_filter_handle_connection_response(con_handle, in, identifier, little_endian_read_16(command, 0), little_endian_read_16(command, 8) == 0u);
+                break;
+            case L2CAP_CREDIT_BASED_CONNECTION_REQUEST:
+                // spsm, mtu, mps, initial credits, source cids
+                for (i = 8; (i + 2u) <= cmd_len; i += 2u){
+                    hci_dump_filter_handle_connection_request(con_handle, in, identifier, little_endian_read_16(command, 0), little_endian_read_16(command, i));
+                }
+                break;
+            case L2CAP_CREDIT_BASED_CONNECTION_RESPONSE:
+                // mtu, mps, initial credits, result, destination cids - 0 if refused
+                for (i = 8; (i + 2u) <= cmd_len; i += 2u){
+                    uint16_t cid = little_endian_read_16(command, i);
+                    hci_dump_filter_handle_connection_response(con_handle, in, identifier, cid, cid != 0u);
+                }
+                break;
+            case DISCONNECTION_REQUEST: {
+                // destination cid, source cid
+                if (cmd_len < 4u) break;
+                uint16_t local_cid = little_endian_read_16(command, (in != 0u) ? 0 : 2);
+                hci_dump_filter_channel_t * channel = hci_dump_filter_get_channel(con_handle, 1, local_cid);
+                if (channel != NULL){
+                    channel->con_handle = HCI_CON_HANDLE_INVALID;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+// returns number of bytes to log, 0 to drop packet
+static uint16_t hci_dump_filter_packet(uint8_t packet_type, uint8_t in, const uint8_t * packet, uint16_t len){
+    hci_con_handle_t con_handle = HCI_CON_HANDLE_INVALID;
+    hci_dump_filter_connection_t * connection = NULL;
+    bool     l2cap_header = false;
+    uint16_t l2cap_cid = 0;
+    uint16_t l2cap_psm = 0;
+    uint8_t  event_code = 0;
+
+    switch (packet_type){
+        case HCI_EVENT_PACKET:
+            if (len < 2u) break;
+            event_code = packet[0];
+            if ((event_code == HCI_EVENT_DISCONNECTION_COMPLETE) && (len >= 6u) && (packet[2] == ERROR_CODE_SUCCESS)){
+                hci_dump_filter_handle_disconnect(little_endian_read_16(packet, 3) & 0x0fffu);
+            }
+            break;
+        case HCI_ACL_DATA_PACKET:
+            if (len < 4u) break;
+            con_handle = little_endian_read_16(packet, 0) & 0x0fffu;
+            connection = hci_dump_filter_get_connection(con_handle);
+            if (((packet[1] >> 4) & 0x03u) == 0x01u){
+                // continuation fragment
+                if (connection == NULL) break;
+                uint16_t snaplen_remaining = connection->snaplen_remaining[in];
+                if (snaplen_remaining == HCI_DUMP_SNAPLEN_UNLIMITED) return len;
+                uint16_t payload_len = (uint16_t) btstack_min(len - 4u, snaplen_remaining);
+                connection->snaplen_remaining[in] = (uint16_t) (snaplen_remaining - payload_len);
+                return (payload_len > 0u) ? (uint16_t) (4u + payload_len) : 0u;
+            }
+            if (len < 8u) break;
+            l2cap_header = true;
+            l2cap_cid = little_endian_read_16(packet, 6);
+            if ((l2cap_cid == L2CAP_CID_SIGNALING) || (l2cap_cid == L2CAP_CID_SIGNALING_LE)){
+                hci_dump_filter_handle_signaling(con_handle, in, packet, len);
+            } else {
+                hci_dump_filter_channel_t * channel = hci_dump_filter_get_channel(con_handle, in, l2cap_cid);
+                if (channel != NULL){
+                    l2cap_cid = channel->local_cid;
+                    l2cap_psm = channel->psm;
+                }
+            }
+            break;
+        case HCI_SCO_DATA_PACKET:
+        case HCI_ISO_DATA_PACKET:
+            if (len < 2u) break;
+            con_handle = little_endian_read_16(packet, 0) & 0x0fffu;
+            break;
+        default:
+            break;
+    }
+
+    // first matching rule
+    uint16_t snaplen = hci_dump_filter_default_snaplen;
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_dump_filters);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        const hci_dump_filter_t * filter = (const hci_dump_filter_t *) btstack_linked_list_iterator_next(&it);
+        if (((filter->match & HCI_DUMP_FILTER_MATCH_PACKET_TYPE) != 0u) && (filter->packet_type != packet_type)) continue;
+        if (((filter->match & HCI_DUMP_FILTER_MATCH_CON_HANDLE) != 0u) && (filter->con_handle != con_handle)) continue;
+        if (((filter->match & HCI_DUMP_FILTER_MATCH_L2CAP_CID) != 0u) && (!l2cap_header || (filter->l2cap_cid != l2cap_cid))) continue;
+        if (((filter->match & HCI_DUMP_FILTER_MATCH_L2CAP_PSM) != 0u) && ((l2cap_psm == 0u) || (filter->l2cap_psm != l2cap_psm))) continue;
+        if (((filter->match & HCI_DUMP_FILTER_MATCH_EVENT_CODE) != 0u) && ((packet_type != HCI_EVENT_PACKET) || (filter->event_code != event_code))) continue;
+        snaplen = filter->snaplen;
+        break;
+    }
+
+    uint16_t log_len = (uint16_t) btstack_min(len, snaplen);
+    if (l2cap_header && (connection != NULL)){
+        connection->snaplen_remaining[in] = (snaplen == HCI_DUMP_SNAPLEN_UNLIMITED) ? HCI_DUMP_SNAPLEN_UNLIMITED : (uint16_t) (snaplen - log_len);
+    }
+    return log_len;
+}
+#endif
+
 static bool hci_dump_log_level_active(int log_level){
     if (hci_dump_implementation == NULL) return false;
     if (log_level >= HCI_DUMP_LOG_LEVEL_PRINT) return true;
@@ -82,12 +341,71 @@ void hci_dump_init(const hci_dump_t * hci_dump_impl){
     nr_packets = 0;
     hci_dump_implementation = hci_dump_impl;
     packet_log_enabled = true;
+#ifdef ENABLE_HCI_DUMP_FILTER
+    hci_dump_filter_reset_state();
+#endif
 }
 
 void hci_dump_set_max_packets(int packets){
     max_nr_packets = packets;
 }
 
+#ifdef ENABLE_HCI_DUMP_FILTER
+// truncated packets need to contain the HCI header
+static bool hci_dump_filter_snaplen_valid(uint16_t snaplen, uint8_t packet_type){
+    if (snaplen == 0u) return true;
+    uint16_t header_len;
+    switch (packet_type){
+        case HCI_EVENT_PACKET:
+            header_len = 2;
+            break;
+        case HCI_COMMAND_DATA_PACKET:
+        case HCI_SCO_DATA_PACKET:
+            header_len = 3;
+            break;
+        default:
+            // ACL and ISO, or any packet type
+            header_len = 4;
+            break;
+    }
+    return snaplen >= header_len;
+}
+
+uint8_t hci_dump_filter_add(hci_dump_filter_t * filter){
+    uint8_t packet_type = ((filter->match & HCI_DUMP_FILTER_MATCH_PACKET_TYPE) != 0u) ? filter->packet_type : 0u;
+    if ((filter->match & HCI_DUMP_FILTER_MATCH_EVENT_CODE) != 0u){
+        packet_type = HCI_EVENT_PACKET;
+    }
+    if (hci_dump_filter_snaplen_valid(filter->snaplen, packet_type) == false){
+        return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+    }
+    btstack_linked_list_add_tail(&hci_dump_filters, (btstack_linked_item_t *) filter);
+    return ERROR_CODE_SUCCESS;
+}
+
+void hci_dump_filter_remove(hci_dump_filter_t * filter){
+    btstack_linked_list_remove(&hci_dump_filters, (btstack_linked_item_t *) filter);
+}
+
+uint8_t hci_dump_filter_set_default_snaplen(uint16_t snaplen){
+    if (hci_dump_filter_snaplen_valid(snaplen, 0) == false){
+        return ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS;
+    }
+    hci_dump_filter_default_snaplen = snaplen;
+    return ERROR_CODE_SUCCESS;
+}
+#endif
+
+void hci_dump_snapshot(void){
+    if (hci_dump_implementation == NULL) {
+        return;
+    }
+    if (hci_dump_implementation->snapshot == NULL) {
+        return;
+    }
+    (*hci_dump_implementation->snapshot)();
+}
+
 void hci_dump_enable_packet_log(bool enabled){
     packet_log_enabled = enabled;
 }
@@ -100,6 +418,14 @@ void hci_dump_packet(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t
         return;
     }
 
+    uint16_t original_len = len;
+#ifdef ENABLE_HCI_DUMP_FILTER
+    len = hci_dump_filter_packet(packet_type, in, packet, len);
+    if (len == 0u) {
+        return;
+    }
+#endif
+
     if (max_nr_packets > 0){
         if ((nr_packets >= max_nr_packets) && (hci_dump_implementation->reset != NULL)) {
             nr_packets = 0;
@@ -107,6 +433,10 @@ void hci_dump_packet(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t
         }
         nr_packets++;
     }
+    if ((len < original_len) && (hci_dump_implementation->log_packet_truncated != NULL)){
+        (*hci_dump_implementation->log_packet_truncated)(packet_type, in, packet, len, original_len);
+        return;
+    }
     (*hci_dump_implementation->log_packet)(packet_type, in, packet, len);
 }
 
@@ -198,6 +528,10 @@ void hci_dump_setup_header_bluez(uint8_t * buffer, uint32_t tv_sec, uint32_t tv_
 
 // BTSnoop with Linux Monitor data link type uses the flags field for adapter id and packet opcode.
 void hci_dump_setup_header_btsnoop(uint8_t * buffer, uint32_t ts_usec_high, uint32_t ts_usec_low, uint32_t cumulative_drops, uint8_t packet_type, uint8_t in, uint16_t len) {
+    hci_dump_setup_header_btsnoop_truncated(buffer, ts_usec_high, ts_usec_low, cumulative_drops, packet_type, in, len, len);
+}
+
+void hci_dump_setup_header_btsnoop_truncated(uint8_t * buffer, uint32_t ts_usec_high, uint32_t ts_usec_low, uint32_t cumulative_drops, uint8_t packet_type, uint8_t in, uint16_t len, uint16_t original_len) {
     uint16_t opcode;
     switch (packet_type){
         case HCI_COMMAND_DATA_PACKET:
@@ -221,7 +555,7 @@ void hci_dump_setup_header_btsnoop(uint8_t * buffer, uint32_t ts_usec_high, uint
         default:
             return;
     }
-    big_endian_store_32(buffer,  0, len);               // Original Length
+    big_endian_store_32(buffer,  0, original_len);      // Original Length
     big_endian_store_32(buffer,  4, len);               // Included Length
     big_endian_store_32(buffer,  8, opcode);            // Adapter ID (0) and Packet Opcode
     big_endian_store_32(buffer, 12, cumulative_drops);  // Cumulativ Drops
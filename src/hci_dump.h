@@ -48,6 +48,7 @@
 #include <stdint.h>
 #include <stdarg.h>       // for va_list
 #include "btstack_bool.h"
+#include "btstack_linked_list.h"
 
 #ifdef __AVR__
 #include <avr/pgmspace.h>
@@ -69,6 +70,16 @@ extern "C" {
 // we expect that there's no log_x call that creates a longer message string without the time header
 #define HCI_DUMP_MAX_MESSAGE_LEN        256
 
+// snaplen to log complete packets
+#define HCI_DUMP_SNAPLEN_UNLIMITED 0xffffu
+
+// fields of hci_dump_filter_t that need to match
+#define HCI_DUMP_FILTER_MATCH_PACKET_TYPE 0x01u
+#define HCI_DUMP_FILTER_MATCH_CON_HANDLE  0x02u
+#define HCI_DUMP_FILTER_MATCH_L2CAP_CID   0x04u
+#define HCI_DUMP_FILTER_MATCH_L2CAP_PSM   0x08u
+#define HCI_DUMP_FILTER_MATCH_EVENT_CODE  0x10u
+
 /* API_START */
 
 typedef enum {
@@ -89,8 +100,26 @@ typedef struct {
     // log message - AVR
     void (*log_message_P)(int log_level, PGM_P * format, va_list argptr);
 #endif
+    // optional: preserve recent history, e.g. write in-memory log to file, called on Controller Hardware Error
+    void (*snapshot)(void);
+    // optional: log packet truncated by filter, len of original_len bytes provided. log_packet is used if NULL
+    void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
 } hci_dump_t;
 
+typedef struct {
+    btstack_linked_item_t item;
+    // HCI_DUMP_FILTER_MATCH_x flags
+    uint8_t  match;
+    uint8_t  packet_type;
+    uint16_t con_handle;
+    // local CID as reported in BTstack events, or fixed channel CID
+    uint16_t l2cap_cid;
+    uint16_t l2cap_psm;
+    uint8_t  event_code;
+    // max number of bytes to log incl. HCI header, 0 to drop packet, HCI_DUMP_SNAPLEN_UNLIMITED for complete packet
+    uint16_t snaplen;
+} hci_dump_filter_t;
+
 /**
  * @brief Init HCI Dump
  * @param hci_dump_impl - platform-specific implementation
@@ -114,6 +143,35 @@ void hci_dump_enable_log_level(int log_level, int enable);
  */
 void hci_dump_set_max_packets(int packets);
 
+/**
+ * @brief Add filter rule to drop or truncate packets. Rules are checked in the order they were added,
+ *        the first matching rule provides the snaplen. Requires ENABLE_HCI_DUMP_FILTER
+ * @note L2CAP CID/PSM match first fragment of an L2CAP PDU, the remaining fragments are logged until snaplen is reached
+ * @note Truncated packets keep their original HCI length field. Formats with separate original length (BTSnoop, PCAPNG)
+ *       also store it in their record header if the hci_dump_t implementation provides log_packet_truncated
+ * @param filter
+ * @return status ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS if snaplen is not 0 and shorter than the HCI header
+ */
+uint8_t hci_dump_filter_add(hci_dump_filter_t * filter);
+
+/**
+ * @brief Remove filter rule
+ * @param filter
+ */
+void hci_dump_filter_remove(hci_dump_filter_t * filter);
+
+/**
+ * @brief Set snaplen for packets that don't match any filter rule. Requires ENABLE_HCI_DUMP_FILTER
+ * @param snaplen in bytes, 0 to drop packets, default: HCI_DUMP_SNAPLEN_UNLIMITED
+ * @return status ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS if snaplen is not 0 and shorter than ACL/ISO header
+ */
+uint8_t hci_dump_filter_set_default_snaplen(uint16_t snaplen);
+
+/**
+ * @brief Preserve recent history if supported by implementation, e.g. write flight recorder to file
+ */
+void hci_dump_snapshot(void);
+
 /**
  * @brief Dump Packet
  * @param packet_type
@@ -189,6 +247,19 @@ void hci_dump_setup_header_bluez(uint8_t * buffer, uint32_t tv_sec, uint32_t tv_
  */
 void hci_dump_setup_header_btsnoop(uint8_t * buffer, uint32_t ts_usec_high, uint32_t ts_usec_low, uint32_t cumulative_drops, uint8_t packet_type, uint8_t in, uint16_t len);
 
+/**
+ * @brief Setup header for BT Snoop format with included length smaller than original length
+ * @param buffer
+ * @param ts_usec_high upper 32-bit of 64-bit microsecond timestamp
+ * @param ts_usec_low  lower 32-bit of 64-bit microsecond timestamp
+ * @param cumulative_drops since last packet was recorded
+ * @param packet_type
+ * @param in
+ * @param len included length
+ * @param original_len
+ */
+void hci_dump_setup_header_btsnoop_truncated(uint8_t * buffer, uint32_t ts_usec_high, uint32_t ts_usec_low, uint32_t cumulative_drops, uint8_t packet_type, uint8_t in, uint16_t len, uint16_t original_len);
+
 /* API_END */
 
 
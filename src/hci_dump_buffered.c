@@ -50,6 +50,29 @@
 
 #define HCI_DUMP_BUFFERED_ENTRY_HEADER_SIZE 4u
 
+// ring header offsets
+#define RING_HEADER_OFFSET_MAGIC            0u
+#define RING_HEADER_OFFSET_VERSION          8u
+#define RING_HEADER_OFFSET_HEADER_SIZE     12u
+#define RING_HEADER_OFFSET_RING_SIZE       16u
+#define RING_HEADER_OFFSET_FLAGS           20u
+#define RING_HEADER_OFFSET_WRITE_INDEX     24u
+#define RING_HEADER_OFFSET_TAIL_INDEX      28u
+#define RING_HEADER_OFFSET_FIRST_SEQUENCE  32u
+#define RING_HEADER_OFFSET_NEXT_SEQUENCE   36u
+
+// ring record offsets
+#define RING_RECORD_OFFSET_LEN              0u
+#define RING_RECORD_OFFSET_PACKET_TYPE      2u
+#define RING_RECORD_OFFSET_IN               3u
+#define RING_RECORD_OFFSET_SEQUENCE         4u
+#define RING_RECORD_OFFSET_TIMESTAMP        8u
+
+#define RING_RECORD_HEADER_SIZE            16u
+#define RING_RECORD_MAX_LEN            0xfffcu
+
+static const uint8_t hci_dump_buffered_ring_magic[8] = { 'B', 'T', 'S', 'T', 'K', 'R', 'N', 'G' };
+
 typedef struct {
     uint8_t * buffer;
     uint32_t buffer_size;
@@ -57,6 +80,9 @@ typedef struct {
     uint32_t flush_timeout_ms;
     const hci_dump_t * output;
     btstack_timer_source_t flush_timer;
+    // ring mode
+    uint8_t * ring_header;
+    uint64_t (*get_time_us)(void);
 } hci_dump_buffered_state_t;
 
 static hci_dump_buffered_state_t hci_dump_buffered_state;
@@ -70,6 +96,10 @@ static void hci_dump_buffered_flush_timeout_handler(btstack_timer_source_t * ts)
 }
 
 static void hci_dump_buffered_stop_timer(void){
+    // timer is only used with flush timeout, ring mode works without run loop
+    if (hci_dump_buffered_state.flush_timeout_ms == 0u) {
+        return;
+    }
     btstack_run_loop_remove_timer(&hci_dump_buffered_state.flush_timer);
 }
 
@@ -97,7 +127,181 @@ static bool hci_dump_buffered_can_store(uint32_t entry_size){
     return (hci_dump_buffered_state.buffer != NULL) && hci_dump_buffered_state.buffer_size >= entry_size;
 }
 
+// ring mode: header and records are stored little endian in the caller-provided buffer, which is
+// typically a memory-mapped file. Records are only published after they have been written completely,
+// so that a reader can recover all complete records after a crash of the logging process.
+
+static uint32_t hci_dump_buffered_ring_get(uint16_t offset){
+    return little_endian_read_32(hci_dump_buffered_state.ring_header, offset);
+}
+
+static void hci_dump_buffered_ring_set(uint16_t offset, uint32_t value){
+    little_endian_store_32(hci_dump_buffered_state.ring_header, offset, value);
+}
+
+// stores to the mapping must not be reordered by the compiler, the CPU keeps program order for the
+// process itself, which is sufficient to survive a crash of the process
+static inline void hci_dump_buffered_ring_barrier(void){
+#ifdef __GNUC__
+    __asm__ volatile("" ::: "memory");
+#endif
+}
+
+static uint32_t hci_dump_buffered_ring_record_size(uint16_t record_len){
+    return ((uint32_t) record_len + 3u) & ~3u;
+}
+
+static uint16_t hci_dump_buffered_ring_record_len(uint32_t offset){
+    if ((offset + RING_RECORD_HEADER_SIZE) > hci_dump_buffered_state.buffer_size){
+        return 0;
+    }
+    return little_endian_read_16(hci_dump_buffered_state.buffer, (int) (offset + RING_RECORD_OFFSET_LEN));
+}
+
+// follow wrap marker or end of ring
+static uint32_t hci_dump_buffered_ring_skip_wrap(uint32_t offset){
+    return (hci_dump_buffered_ring_record_len(offset) == 0u) ? 0u : offset;
+}
+
+static bool hci_dump_buffered_ring_empty(void){
+    return hci_dump_buffered_ring_get(RING_HEADER_OFFSET_FIRST_SEQUENCE) == hci_dump_buffered_ring_get(RING_HEADER_OFFSET_NEXT_SEQUENCE);
+}
+
+// drop oldest record, tail always points to a record unless ring is empty
+static void hci_dump_buffered_ring_evict_oldest(void){
+    uint32_t tail = hci_dump_buffered_ring_skip_wrap(hci_dump_buffered_ring_get(RING_HEADER_OFFSET_TAIL_INDEX));
+    uint32_t first_sequence = hci_dump_buffered_ring_get(RING_HEADER_OFFSET_FIRST_SEQUENCE) + 1u;
+    tail += hci_dump_buffered_ring_record_size(hci_dump_buffered_ring_record_len(tail));
+    if (first_sequence != hci_dump_buffered_ring_get(RING_HEADER_OFFSET_NEXT_SEQUENCE)){
+        tail = hci_dump_buffered_ring_skip_wrap(tail);
+    }
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_TAIL_INDEX, tail);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_FIRST_SEQUENCE, first_sequence);
+}
+
+// evict all records starting within [start, end) before they get overwritten
+static void hci_dump_buffered_ring_evict(uint32_t start, uint32_t end){
+    while (hci_dump_buffered_ring_empty() == false){
+        uint32_t tail = hci_dump_buffered_ring_get(RING_HEADER_OFFSET_TAIL_INDEX);
+        if ((tail < start) || (tail >= end)){
+            break;
+        }
+        hci_dump_buffered_ring_evict_oldest();
+    }
+}
+
+static void hci_dump_buffered_ring_store_packet(uint8_t packet_type, uint8_t in, const uint8_t * packet, uint16_t len){
+    uint32_t ring_size = hci_dump_buffered_state.buffer_size;
+
+    // truncate packet that does not fit into ring
+    uint32_t max_len = btstack_min(ring_size, RING_RECORD_MAX_LEN) - RING_RECORD_HEADER_SIZE;
+    if (len > max_len){
+        len = (uint16_t) max_len;
+    }
+    uint16_t record_len = (uint16_t) (RING_RECORD_HEADER_SIZE + len);
+    uint32_t record_size = hci_dump_buffered_ring_record_size(record_len);
+
+    // wrap around with marker if record does not fit before end of ring
+    uint32_t write_index = hci_dump_buffered_ring_get(RING_HEADER_OFFSET_WRITE_INDEX);
+    if ((write_index + record_size) > ring_size){
+        hci_dump_buffered_ring_evict(write_index, ring_size);
+        if (write_index < ring_size){
+            // position of little_endian_store_16 is limited to 16 bit, ring might be larger
+            hci_dump_buffered_state.buffer[write_index]      = 0;
+            hci_dump_buffered_state.buffer[write_index + 1u] = 0;
+        }
+        write_index = 0;
+    }
+    hci_dump_buffered_ring_evict(write_index, write_index + record_size);
+    if (hci_dump_buffered_ring_empty()){
+        hci_dump_buffered_ring_set(RING_HEADER_OFFSET_TAIL_INDEX, write_index);
+    }
+
+    // write record, sequence number last as it marks the record as complete
+    uint32_t sequence_number = hci_dump_buffered_ring_get(RING_HEADER_OFFSET_NEXT_SEQUENCE);
+    uint64_t timestamp_us = hci_dump_buffered_state.get_time_us();
+    uint8_t * record = &hci_dump_buffered_state.buffer[write_index];
+    little_endian_store_16(record, RING_RECORD_OFFSET_LEN, record_len);
+    record[RING_RECORD_OFFSET_PACKET_TYPE] = packet_type;
+    record[RING_RECORD_OFFSET_IN] = in;
+    little_endian_store_32(record, RING_RECORD_OFFSET_TIMESTAMP, (uint32_t) timestamp_us);
+    little_endian_store_32(record, RING_RECORD_OFFSET_TIMESTAMP + 4u, (uint32_t) (timestamp_us >> 32));
+    if ((len > 0u) && (packet != NULL)) {
+        (void) memcpy(&record[RING_RECORD_HEADER_SIZE], packet, len);
+    }
+    hci_dump_buffered_ring_barrier();
+    little_endian_store_32(record, RING_RECORD_OFFSET_SEQUENCE, sequence_number);
+    hci_dump_buffered_ring_barrier();
+
+    // publish record
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_WRITE_INDEX, write_index + record_size);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_NEXT_SEQUENCE, sequence_number + 1u);
+}
+
+// walk records from tail and update header up to the last complete record, which might not have been
+// published if the previous process crashed while logging
+static void hci_dump_buffered_ring_recover(void){
+    uint32_t ring_size = hci_dump_buffered_state.buffer_size;
+    uint32_t tail = hci_dump_buffered_ring_get(RING_HEADER_OFFSET_TAIL_INDEX);
+    uint32_t write_index = hci_dump_buffered_ring_get(RING_HEADER_OFFSET_WRITE_INDEX);
+    uint32_t next_sequence = hci_dump_buffered_ring_get(RING_HEADER_OFFSET_NEXT_SEQUENCE);
+    bool     has_records = hci_dump_buffered_ring_empty() == false;
+    uint32_t first_sequence = next_sequence;
+    uint32_t num_records = 0;
+    uint32_t pos = tail;
+    bool wrapped = false;
+
+    if (((tail & 3u) != 0u) || (tail > ring_size) || ((write_index & 3u) != 0u) || (write_index > ring_size)){
+        pos = 0;
+    }
+    uint32_t end = pos;
+    while (num_records < (ring_size / RING_RECORD_HEADER_SIZE)){
+        uint16_t record_len = hci_dump_buffered_ring_record_len(pos);
+        if (record_len == 0u){
+            if (wrapped || (pos == 0u)){
+                break;
+            }
+            wrapped = true;
+            pos = 0;
+            continue;
+        }
+        uint32_t record_size = hci_dump_buffered_ring_record_size(record_len);
+        if ((record_len < RING_RECORD_HEADER_SIZE) || ((pos + record_size) > ring_size)){
+            break;
+        }
+        uint32_t sequence_number = little_endian_read_32(hci_dump_buffered_state.buffer, (int) (pos + RING_RECORD_OFFSET_SEQUENCE));
+        // record at write index is either the oldest one of a full ring or a complete but unpublished one
+        if ((pos == write_index) && (sequence_number != next_sequence)){
+            if ((num_records > 0u) || (has_records == false)){
+                break;
+            }
+        }
+        if (num_records == 0u){
+            tail = pos;
+            first_sequence = sequence_number;
+        } else if (sequence_number != (first_sequence + num_records)){
+            break;
+        }
+        num_records++;
+        pos += record_size;
+        end = pos;
+    }
+    if (num_records == 0u){
+        tail = end;
+    }
+
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_TAIL_INDEX, tail);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_WRITE_INDEX, end);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_FIRST_SEQUENCE, first_sequence);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_NEXT_SEQUENCE, first_sequence + num_records);
+}
+
 static void hci_dump_buffered_store_packet(uint8_t packet_type, uint8_t in, uint8_t * packet, uint16_t len){
+    if (hci_dump_buffered_state.ring_header != NULL){
+        hci_dump_buffered_ring_store_packet(packet_type, in, packet, len);
+        return;
+    }
+
     uint32_t entry_size = HCI_DUMP_BUFFERED_ENTRY_HEADER_SIZE + len;
 
     // if packet is bigger than our buffer, flush buffer and forward current packet
@@ -116,7 +320,7 @@ static void hci_dump_buffered_store_packet(uint8_t packet_type, uint8_t in, uint
     uint32_t offset = hci_dump_buffered_state.bytes_stored;
     hci_dump_buffered_state.buffer[offset] = packet_type;
     hci_dump_buffered_state.buffer[offset + 1u] = in;
-    little_endian_store_16(hci_dump_buffered_state.buffer, (uint16_t)(offset + 2u), len);
+    little_endian_store_16(&hci_dump_buffered_state.buffer[offset], 2, len);
     if ((len > 0u) && (packet != NULL)) {
         memcpy(&hci_dump_buffered_state.buffer[offset + HCI_DUMP_BUFFERED_ENTRY_HEADER_SIZE], packet, len);
     }
@@ -134,9 +338,43 @@ void hci_dump_buffered_init(const hci_dump_t * hci_dump_impl, uint8_t * buffer,
     hci_dump_buffered_state.bytes_stored = 0;
     hci_dump_buffered_state.flush_timeout_ms = flush_timeout_ms;
     hci_dump_buffered_state.output = hci_dump_impl;
+    hci_dump_buffered_state.ring_header = NULL;
     btstack_run_loop_set_timer_handler(&hci_dump_buffered_state.flush_timer, &hci_dump_buffered_flush_timeout_handler);
 }
 
+static uint64_t hci_dump_buffered_ring_get_time_us(void){
+    return (uint64_t) btstack_run_loop_get_time_ms() * 1000u;
+}
+
+void hci_dump_buffered_init_ring(uint8_t * buffer, uint32_t buffer_size, uint64_t (*get_time_us)(void)){
+    btstack_assert(buffer_size >= (HCI_DUMP_BUFFERED_RING_HEADER_SIZE + (2u * RING_RECORD_HEADER_SIZE)));
+    hci_dump_buffered_stop_timer();
+    hci_dump_buffered_state.ring_header = buffer;
+    hci_dump_buffered_state.buffer = &buffer[HCI_DUMP_BUFFERED_RING_HEADER_SIZE];
+    hci_dump_buffered_state.buffer_size = (buffer_size - HCI_DUMP_BUFFERED_RING_HEADER_SIZE) & ~3u;
+    hci_dump_buffered_state.bytes_stored = 0;
+    hci_dump_buffered_state.flush_timeout_ms = 0;
+    hci_dump_buffered_state.output = NULL;
+    hci_dump_buffered_state.get_time_us = (get_time_us != NULL) ? get_time_us : &hci_dump_buffered_ring_get_time_us;
+
+    // append to existing ring with same layout
+    if ((memcmp(buffer, hci_dump_buffered_ring_magic, sizeof(hci_dump_buffered_ring_magic)) == 0)
+    &&  (hci_dump_buffered_ring_get(RING_HEADER_OFFSET_VERSION) == HCI_DUMP_BUFFERED_RING_VERSION)
+    &&  (hci_dump_buffered_ring_get(RING_HEADER_OFFSET_HEADER_SIZE) == HCI_DUMP_BUFFERED_RING_HEADER_SIZE)
+    &&  (hci_dump_buffered_ring_get(RING_HEADER_OFFSET_RING_SIZE) == hci_dump_buffered_state.buffer_size)){
+        hci_dump_buffered_ring_recover();
+        return;
+    }
+
+    // set up empty ring, magic last
+    memset(buffer, 0, buffer_size);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_VERSION, HCI_DUMP_BUFFERED_RING_VERSION);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_HEADER_SIZE, HCI_DUMP_BUFFERED_RING_HEADER_SIZE);
+    hci_dump_buffered_ring_set(RING_HEADER_OFFSET_RING_SIZE, hci_dump_buffered_state.buffer_size);
+    hci_dump_buffered_ring_barrier();
+    (void) memcpy(buffer, hci_dump_buffered_ring_magic, sizeof(hci_dump_buffered_ring_magic));
+}
+
 void hci_dump_buffered_flush(void){
     uint32_t offset = 0;
 
@@ -163,6 +401,14 @@ static void hci_dump_buffered_reset(void){
     }
 }
 
+// flush buffered packets before output preserves its history
+static void hci_dump_buffered_snapshot(void){
+    hci_dump_buffered_flush();
+    if ((hci_dump_buffered_state.output != NULL) && (hci_dump_buffered_state.output->snapshot != NULL)) {
+        hci_dump_buffered_state.output->snapshot();
+    }
+}
+
 static void hci_dump_buffered_log_packet(uint8_t packet_type, uint8_t in, uint8_t * packet, uint16_t len){
     hci_dump_buffered_store_packet(packet_type, in, packet, len);
 }
@@ -188,7 +434,8 @@ static void hci_dump_buffered_log_message(int log_level, const char * format, va
 static const hci_dump_t hci_dump_buffered_instance = {
     .reset = hci_dump_buffered_reset,
     .log_packet = hci_dump_buffered_log_packet,
-    .log_message = hci_dump_buffered_log_message
+    .log_message = hci_dump_buffered_log_message,
+    .snapshot = hci_dump_buffered_snapshot
 };
 
 const hci_dump_t * hci_dump_buffered_get_instance(void){
@@ -63,6 +63,16 @@
  *                                    100);
  *     hci_dump_init(hci_dump_buffered);
  *
+ * Alternatively, packets can be stored in a ring buffer that is never flushed, e.g. in a memory-mapped file
+ * or in RAM that is retained across a reset, see hci_dump_buffered_init_ring. The oldest packets are dropped
+ * when the ring is full and the ring can be converted into a PacketLogger or BTSnoop file with
+ * tool/convert_hci_dump_ring.py.
+ *
+ * Ring layout, all fields little endian:
+ * - header (64 bytes): magic "BTSTKRNG", version, header size, ring size, reserved, write index,
+ *   tail index, first sequence number, next sequence number, reserved
+ * - records, 4-byte aligned: record len (incl. 16 byte record header), packet type, direction,
+ *   sequence number, timestamp in us (64 bit), packet. A record len of 0 marks the end of the ring.
  */
 
 #ifndef HCI_DUMP_BUFFERED_H
@@ -76,6 +86,9 @@
 extern "C" {
 #endif
 
+#define HCI_DUMP_BUFFERED_RING_HEADER_SIZE 64u
+#define HCI_DUMP_BUFFERED_RING_VERSION      1u
+
 /* API_START */
 
 /**
@@ -90,6 +103,17 @@ extern "C" {
  */
 void hci_dump_buffered_init(const hci_dump_t * hci_dump_impl, uint8_t * buffer, uint32_t buffer_size, uint32_t flush_timeout_ms);
 
+/**
+ * @brief Configure buffered HCI dump instance to store packets in a ring buffer without output
+ * @param buffer caller-provided buffer for ring header and records, e.g. memory-mapped file
+ * @param buffer_size size of buffer in bytes
+ * @param get_time_us returns timestamp in us for each record, NULL to use btstack_run_loop_get_time_ms
+ *
+ * @note If the buffer already contains a ring of the same size, e.g. from a previous run, new packets are appended.
+ *       Packets larger than the ring get truncated. Reset and flush don't affect the ring.
+ */
+void hci_dump_buffered_init_ring(uint8_t * buffer, uint32_t buffer_size, uint64_t (*get_time_us)(void));
+
 /**
  * @brief Flush buffered packets immediately
  */
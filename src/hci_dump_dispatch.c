@@ -66,6 +66,19 @@ static void hci_dump_log_packet_all(uint8_t packet_type, uint8_t in, uint8_t *pa
     }
 }
 
+static void hci_dump_log_packet_truncated_all(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len) {
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_dump_list);
+    while (btstack_linked_list_iterator_has_next(&it)) {
+        hci_dump_dispatch_item_t *list_item = (hci_dump_dispatch_item_t *)btstack_linked_list_iterator_next(&it);
+        if (list_item->hci_dump->log_packet_truncated) {
+            list_item->hci_dump->log_packet_truncated(packet_type, in, packet, len, original_len);
+        } else if (list_item->hci_dump->log_packet) {
+            list_item->hci_dump->log_packet(packet_type, in, packet, len);
+        }
+    }
+}
+
 static void hci_dump_log_message_all(int log_level, const char *format, va_list argptr) {
     btstack_linked_list_iterator_t it;
     btstack_linked_list_iterator_init(&it, &hci_dump_list);
@@ -77,6 +90,17 @@ static void hci_dump_log_message_all(int log_level, const char *format, va_list
     }
 }
 
+static void hci_dump_snapshot_all(void) {
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &hci_dump_list);
+    while (btstack_linked_list_iterator_has_next(&it)) {
+        hci_dump_dispatch_item_t *list_item = (hci_dump_dispatch_item_t *)btstack_linked_list_iterator_next(&it);
+        if (list_item->hci_dump->snapshot) {
+            list_item->hci_dump->snapshot();
+        }
+    }
+}
+
 void hci_dump_dispatch_init(void){
 }
 
@@ -96,7 +120,9 @@ void hci_dump_dispatch_deinit(void){
 static const hci_dump_t hci_dump_dispatch = {
     .reset = hci_dump_reset_all,
     .log_packet = hci_dump_log_packet_all,
-    .log_message = hci_dump_log_message_all
+    .log_message = hci_dump_log_message_all,
+    .snapshot = hci_dump_snapshot_all,
+    .log_packet_truncated = hci_dump_log_packet_truncated_all
 };
 
 const hci_dump_t * hci_dump_dispatch_instance(void){
@@ -153,6 +153,15 @@ static bool hci_transport_h4_read_active;
 static uint8_t hci_packet_with_pre_buffer[HCI_INCOMING_PRE_BUFFER_SIZE + HCI_INCOMING_PACKET_BUFFER_SIZE + 1]; // packet type + max(acl header + acl payload, event header + event data)
 static uint8_t * hci_packet = &hci_packet_with_pre_buffer[HCI_INCOMING_PRE_BUFFER_SIZE];
 
+#ifdef ENABLE_H4_STREAMING_RX
+// streaming receive: read all available bytes at once and frame packets from it
+#ifndef HCI_TRANSPORT_H4_RX_BUFFER_SIZE
+#define HCI_TRANSPORT_H4_RX_BUFFER_SIZE 1024
+#endif
+static uint8_t hci_transport_h4_rx_buffer[HCI_TRANSPORT_H4_RX_BUFFER_SIZE];
+static bool    hci_transport_h4_streaming;
+#endif
+
 // Baudrate change bugs in TI CC256x and CYW20704
 #ifdef ENABLE_CC256X_BAUDRATE_CHANGE_FLOWCONTROL_BUG_WORKAROUND
 #define ENABLE_BAUDRATE_CHANGE_FLOWCONTROL_BUG_WORKAROUND
@@ -191,6 +200,12 @@ static void hci_transport_h4_reset_statemachine(void){
 static void hci_transport_h4_trigger_next_read(void){
     // log_info("hci_transport_h4_trigger_next_read: %u bytes", bytes_to_read);
     hci_transport_h4_read_active = true;
+#ifdef ENABLE_H4_STREAMING_RX
+    if (hci_transport_h4_streaming){
+        btstack_uart->receive_bytes(hci_transport_h4_rx_buffer, sizeof(hci_transport_h4_rx_buffer));
+        return;
+    }
+#endif
     btstack_uart->receive_block(&hci_packet[read_pos], bytes_to_read);  
 }
 
@@ -229,9 +244,8 @@ static void hci_transport_h4_packet_complete(void){
     hci_transport_h4_packet_handler(hci_packet[0], &hci_packet[1], packet_len);
 }
 
-static void hci_transport_h4_block_read(void){
-    hci_transport_h4_read_active = false;
-
+// process bytes_to_read bytes stored at hci_packet[read_pos]
+static void hci_transport_h4_process_block(void){
     read_pos += bytes_to_read;
 
     switch (h4_state) {
@@ -344,6 +358,12 @@ static void hci_transport_h4_block_read(void){
     if (h4_state == H4_W4_PAYLOAD && bytes_to_read == 0u) {
         hci_transport_h4_packet_complete();
     }
+}
+
+static void hci_transport_h4_block_read(void){
+    hci_transport_h4_read_active = false;
+
+    hci_transport_h4_process_block();
 
     // Packet delivery may power-cycle the transport and trigger a new read via hci_transport_h4_open().
     if ((h4_state != H4_OFF) && !hci_transport_h4_read_active) {
@@ -351,6 +371,33 @@ static void hci_transport_h4_block_read(void){
     }
 }
 
+#ifdef ENABLE_H4_STREAMING_RX
+static void hci_transport_h4_bytes_received(uint16_t bytes_received){
+    hci_transport_h4_read_active = false;
+
+    // frame all packets contained in the received bytes, keep partial packet in hci_packet
+    uint16_t pos = 0;
+    while (pos < bytes_received){
+        // stop if transport was closed or re-opened during packet delivery
+        if ((h4_state == H4_OFF) || hci_transport_h4_read_active) break;
+        uint16_t bytes_to_copy = btstack_min(bytes_to_read, bytes_received - pos);
+        (void) memcpy(&hci_packet[read_pos], &hci_transport_h4_rx_buffer[pos], bytes_to_copy);
+        pos += bytes_to_copy;
+        if (bytes_to_copy < bytes_to_read){
+            read_pos      += bytes_to_copy;
+            bytes_to_read -= bytes_to_copy;
+            break;
+        }
+        hci_transport_h4_process_block();
+    }
+
+    // Packet delivery may power-cycle the transport and trigger a new read via hci_transport_h4_open().
+    if ((h4_state != H4_OFF) && !hci_transport_h4_read_active) {
+        hci_transport_h4_trigger_next_read();
+    }
+}
+#endif
+
 static void hci_transport_h4_block_sent(void){
 
     static const uint8_t packet_sent_event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
@@ -452,6 +499,16 @@ static void hci_transport_h4_init(const void * transport_config){
     btstack_uart->init(&hci_transport_h4_uart_config);
     btstack_uart->set_block_received(&hci_transport_h4_block_read);
     btstack_uart->set_block_sent(&hci_transport_h4_block_sent);
+
+#ifdef ENABLE_H4_STREAMING_RX
+    // use streaming receive if supported by UART driver
+    hci_transport_h4_streaming = (btstack_uart->receive_bytes != NULL) && (btstack_uart->set_bytes_received != NULL);
+    if (hci_transport_h4_streaming){
+        btstack_uart->set_bytes_received(&hci_transport_h4_bytes_received);
+    } else {
+        log_info("hci_transport_h4: UART driver does not support streaming receive");
+    }
+#endif
 }
 
 static int hci_transport_h4_open(void){
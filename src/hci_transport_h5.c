@@ -50,16 +50,30 @@
 #include "hci_transport_h5.h"
 
 #include "btstack_debug.h"
+#include "btstack_util.h"
 #include "hci.h"
 #include "hci_transport.h"
 
 #include <inttypes.h>
 
+#ifdef ENABLE_H5_OOF_FLOW_CONTROL
+#include "btstack_slip.h"
+#endif
+
 // assert pre-buffer for packet type is available
 #if !defined(HCI_OUTGOING_PRE_BUFFER_SIZE) || (HCI_OUTGOING_PRE_BUFFER_SIZE < 4)
 #error HCI_OUTGOING_PRE_BUFFER_SIZE not defined or smaller than 4. Please update hci.h
 #endif
 
+// max number of unacknowledged reliable packets, announced in link config
+#ifndef HCI_TRANSPORT_H5_WINDOW_SIZE
+#define HCI_TRANSPORT_H5_WINDOW_SIZE 1
+#endif
+
+#if (HCI_TRANSPORT_H5_WINDOW_SIZE < 1) || (HCI_TRANSPORT_H5_WINDOW_SIZE > 7)
+#error "HCI_TRANSPORT_H5_WINDOW_SIZE must be between 1 and 7"
+#endif
+
 typedef enum {
     LINK_UNINITIALIZED,
     LINK_INITIALIZED,
@@ -75,19 +89,25 @@ typedef enum {
     HCI_TRANSPORT_LINK_SEND_SLEEP                 = 1 <<  5,
     HCI_TRANSPORT_LINK_SEND_WOKEN                 = 1 <<  6,
     HCI_TRANSPORT_LINK_SEND_WAKEUP                = 1 <<  7,
-    HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET         = 1 <<  8,
-    HCI_TRANSPORT_LINK_SEND_ACK_PACKET            = 1 <<  9,
-    HCI_TRANSPORT_LINK_ENTER_SLEEP                = 1 << 10,
-    HCI_TRANSPORT_LINK_SET_BAUDRATE               = 1 << 11,
+    HCI_TRANSPORT_LINK_SEND_ACK_PACKET            = 1 <<  8,
+    HCI_TRANSPORT_LINK_ENTER_SLEEP                = 1 <<  9,
+    HCI_TRANSPORT_LINK_SET_BAUDRATE               = 1 << 10,
 
 } hci_transport_link_actions_t;
 
-// Configuration Field. No packet buffers -> sliding window = 1, no OOF flow control, support data integrity check
-#define LINK_CONFIG_SLIDING_WINDOW_SIZE 1
+// Configuration Field. Sliding window = HCI_TRANSPORT_H5_WINDOW_SIZE, OOF flow control if enabled, support data integrity check
+#define LINK_CONFIG_SLIDING_WINDOW_SIZE HCI_TRANSPORT_H5_WINDOW_SIZE
+#ifdef ENABLE_H5_OOF_FLOW_CONTROL
+#define LINK_CONFIG_OOF_FLOW_CONTROL 1
+#else
 #define LINK_CONFIG_OOF_FLOW_CONTROL 0
+#endif
 #define LINK_CONFIG_DATA_INTEGRITY_CHECK 1
 #define LINK_CONFIG_VERSION_NR 0
 #define LINK_CONFIG_FIELD (LINK_CONFIG_SLIDING_WINDOW_SIZE | (LINK_CONFIG_OOF_FLOW_CONTROL << 3) | (LINK_CONFIG_DATA_INTEGRITY_CHECK << 4) | (LINK_CONFIG_VERSION_NR << 5))
+#define LINK_CONFIG_SLIDING_WINDOW_SIZE_MASK 0x07
+#define LINK_CONFIG_OOF_FLOW_CONTROL_FLAG    0x08
+#define LINK_CONFIG_DATA_INTEGRITY_CHECK_FLAG 0x10
 
 // periodic sending during link establishment
 #define LINK_PERIOD_MS 250
@@ -105,7 +125,7 @@ static const uint8_t link_control_sync_response[] = { 0x02, 0x7d};
 static const uint8_t link_control_config[] = { 0x03, 0xfc, LINK_CONFIG_FIELD};
 static const uint8_t link_control_config_prefix_len  = 2;
 static const uint8_t link_control_config_response_empty[] = { 0x04, 0x7b};
-static const uint8_t link_control_config_response[] = { 0x04, 0x7b, LINK_CONFIG_FIELD};
+static const uint8_t link_control_config_response[] = { 0x04, 0x7b};
 static const uint8_t link_control_config_response_prefix_len  = 2;
 static const uint8_t link_control_wakeup[] = { 0x05, 0xfa};
 static const uint8_t link_control_woken[] =  { 0x06, 0xf9};
@@ -129,15 +149,41 @@ static uint16_t link_resend_timeout_ms;
 static uint8_t  link_peer_asleep;
 static uint8_t  link_peer_supports_data_integrity_check;
 static uint32_t link_new_baudrate;
+static uint8_t  link_window_size;
+static uint8_t  link_config_response_field;
+#ifdef ENABLE_H5_OOF_FLOW_CONTROL
+static bool     link_peer_xoff;
+#endif
 
 // auto sleep-mode
 static btstack_timer_source_t inactivity_timer;
 static uint16_t link_inactivity_timeout_ms; // auto-sleep if set
 
-// Outgoing packet
-static uint8_t   hci_packet_type;
-static uint16_t  hci_packet_size;
-static uint8_t * hci_packet;
+// Outgoing reliable packets, first entry has sequence number link_seq_nr
+typedef struct {
+    uint8_t * packet;
+    uint16_t  size;
+    uint8_t   type;
+} hci_transport_link_queue_entry_t;
+
+static hci_transport_link_queue_entry_t link_queue[HCI_TRANSPORT_H5_WINDOW_SIZE];
+static uint8_t link_queue_head;
+static uint8_t link_queue_len;
+// number of queued packets sent since last (re)transmission started at head
+static uint8_t link_queue_sent;
+
+#if HCI_TRANSPORT_H5_WINDOW_SIZE > 1
+// HCI re-uses its outgoing buffer after HCI_EVENT_TRANSPORT_PACKET_SENT, keep copy with room for header and DIC
+static uint8_t link_queue_storage[HCI_TRANSPORT_H5_WINDOW_SIZE][4 + HCI_OUTGOING_PACKET_BUFFER_SIZE + 2];
+#endif
+
+// Outgoing unreliable packet (SCO)
+static uint8_t * link_unreliable_packet;
+static uint16_t  link_unreliable_packet_size;
+static bool      link_unreliable_packet_in_flight;
+
+// HCI_EVENT_TRANSPORT_PACKET_SENT has not been emitted for last packet from upper stack
+static bool link_packet_sent_pending;
 
 // restore 2 bytes temp overwritten by DIC
 static uint8_t * hci_packet_restore_dic_address;
@@ -160,6 +206,7 @@ static void hci_transport_h5_frame_sent(void);
 static void hci_transport_h5_process_frame(uint16_t frame_size);
 static void hci_transport_link_run(void);
 static void hci_transport_link_send_queued_packet(void);
+static void hci_transport_link_send_unreliable_packet(void);
 static void hci_transport_link_set_timer(uint16_t timeout_ms);
 static void hci_transport_link_timeout_handler(btstack_timer_source_t * timer);
 static void hci_transport_slip_init(void);
@@ -264,16 +311,38 @@ static void hci_transport_slip_send_frame_with_dic(uint8_t * frame, uint16_t fra
 }
 
 static void hci_transport_link_send_queued_packet(void){
-    uint8_t * buffer =      hci_packet      - 4;
-    uint16_t  buffer_size = hci_packet_size + 4;
+    const hci_transport_link_queue_entry_t * entry = &link_queue[(link_queue_head + link_queue_sent) % HCI_TRANSPORT_H5_WINDOW_SIZE];
+    uint8_t   seq_nr      = (link_seq_nr + link_queue_sent) & 0x07;
+    uint8_t * buffer      = entry->packet - 4;
+    uint16_t  buffer_size = entry->size   + 4;
+    link_queue_sent++;
 
     // setup header
-    int reliable = hci_packet_type == HCI_SCO_DATA_PACKET ? 0 : 1;
-    hci_transport_link_calc_header(buffer, link_seq_nr, link_ack_nr, link_peer_supports_data_integrity_check, reliable, hci_packet_type, hci_packet_size);
+    hci_transport_link_calc_header(buffer, seq_nr, link_ack_nr, link_peer_supports_data_integrity_check, 1, entry->type, entry->size);
 
     // send frame with dic
-    log_debug("send queued packet: seq %u, ack %u, size %u, append dic %u", link_seq_nr, link_ack_nr, hci_packet_size, link_peer_supports_data_integrity_check);
-    log_debug_hexdump(hci_packet, hci_packet_size);
+    log_debug("send queued packet: seq %u, ack %u, size %u, append dic %u", seq_nr, link_ack_nr, entry->size, link_peer_supports_data_integrity_check);
+    log_debug_hexdump(entry->packet, entry->size);
+    hci_transport_slip_send_frame_with_dic(buffer, buffer_size);
+
+    // (re)start resend timer
+    hci_transport_link_set_timer(link_resend_timeout_ms);
+
+    // reset inactvitiy timer
+    hci_transport_inactivity_timer_set();
+}
+
+static void hci_transport_link_send_unreliable_packet(void){
+    uint8_t * buffer      = link_unreliable_packet      - 4;
+    uint16_t  buffer_size = link_unreliable_packet_size + 4;
+    link_unreliable_packet_in_flight = true;
+
+    // setup header
+    hci_transport_link_calc_header(buffer, 0, link_ack_nr, link_peer_supports_data_integrity_check, 0, HCI_SCO_DATA_PACKET, link_unreliable_packet_size);
+
+    // send frame with dic
+    log_debug("send unreliable packet: ack %u, size %u, append dic %u", link_ack_nr, link_unreliable_packet_size, link_peer_supports_data_integrity_check);
+    log_debug_hexdump(link_unreliable_packet, link_unreliable_packet_size);
     hci_transport_slip_send_frame_with_dic(buffer, buffer_size);
 
     // reset inactvitiy timer
@@ -320,8 +389,11 @@ static void hci_transport_link_send_config(void){
 }
 
 static void hci_transport_link_send_config_response(void){
-    log_debug("link send config response");
-    hci_transport_link_send_control(link_control_config_response, sizeof(link_control_config_response));
+    log_debug("link send config response 0x%02x", link_config_response_field);
+    uint8_t config_response[sizeof(link_control_config_response) + 1];
+    memcpy(config_response, link_control_config_response, sizeof(link_control_config_response));
+    config_response[sizeof(link_control_config_response)] = link_config_response_field;
+    hci_transport_link_send_control(config_response, sizeof(config_response));
 }
 
 static void hci_transport_link_send_config_response_empty(void){
@@ -344,10 +416,26 @@ static void hci_transport_link_send_sleep(void){
     hci_transport_link_send_control(link_control_sleep, sizeof(link_control_sleep));
 }
 
+static bool hci_transport_link_can_send_queued_packet(void){
+    if (link_peer_asleep) return false;
+    return link_queue_sent < link_queue_len;
+}
+
+static bool hci_transport_link_can_send_unreliable_packet(void){
+    if (link_peer_asleep) return false;
+    if (link_unreliable_packet == NULL) return false;
+    return link_unreliable_packet_in_flight == false;
+}
+
 static void hci_transport_link_run(void){
     // exit if outgoing active
     if (slip_write_active) return;
 
+#ifdef ENABLE_H5_OOF_FLOW_CONTROL
+    // peer sent XOFF, don't start new frame
+    if (link_peer_xoff) return;
+#endif
+
     // process queued requests
     if (hci_transport_link_actions & HCI_TRANSPORT_LINK_SEND_SYNC){
         hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_SYNC;
@@ -384,8 +472,13 @@ static void hci_transport_link_run(void){
         hci_transport_link_send_wakeup();
         return;
     }
-    if (hci_transport_link_actions & HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET){
-        hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
+    if (hci_transport_link_can_send_unreliable_packet()){
+        // packet already contains ack, no need to send addtitional one
+        hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_ACK_PACKET;
+        hci_transport_link_send_unreliable_packet();
+        return;
+    }
+    if (hci_transport_link_can_send_queued_packet()){
         // packet already contains ack, no need to send addtitional one
         hci_transport_link_actions &= ~HCI_TRANSPORT_LINK_SEND_ACK_PACKET;
         hci_transport_link_send_queued_packet();
@@ -408,6 +501,7 @@ static void hci_transport_link_run(void){
 static void hci_transport_link_set_timer(uint16_t timeout_ms){
     btstack_run_loop_set_timer_handler(&link_timer, &hci_transport_link_timeout_handler);
     btstack_run_loop_set_timer(&link_timer, timeout_ms);
+    btstack_run_loop_remove_timer(&link_timer);
     btstack_run_loop_add_timer(&link_timer);
 }
 
@@ -431,8 +525,9 @@ static void hci_transport_link_timeout_handler(btstack_timer_source_t * timer){
                 hci_transport_link_set_timer(LINK_WAKEUP_MS);
                 break;
             }
-            // resend packet
-            hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
+            // go-back-n: resend all unacknowledged packets, starting with the oldest one
+            log_info("resend %u unacknowledged packets, first seq %u", link_queue_len, link_seq_nr);
+            link_queue_sent = 0;
             hci_transport_link_set_timer(link_resend_timeout_ms);
             break;
         default:
@@ -446,6 +541,12 @@ static void hci_transport_link_init(void){
     link_state = LINK_UNINITIALIZED;
     link_peer_asleep = 0;
     link_peer_supports_data_integrity_check = 0;
+    link_window_size = 1;
+#ifdef ENABLE_H5_OOF_FLOW_CONTROL
+    link_peer_xoff = false;
+    btstack_slip_encoder_set_xon_xoff_escaping(false);
+    btstack_slip_decoder_set_xon_xoff_handler(NULL);
+#endif
  
     // get started
     hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_SYNC;
@@ -458,20 +559,79 @@ static int hci_transport_link_inc_seq_nr(int seq_nr){
 }
 
 static int hci_transport_link_have_outgoing_packet(void){
-    return hci_packet != 0;
+    return (link_queue_len > 0) || (link_unreliable_packet != NULL);
 }
 
 static void hci_transport_link_clear_queue(void){
     btstack_run_loop_remove_timer(&link_timer);
-    hci_packet = NULL;
+    link_queue_head = 0;
+    link_queue_len  = 0;
+    link_queue_sent = 0;
+    link_unreliable_packet = NULL;
+    link_unreliable_packet_in_flight = false;
+    link_packet_sent_pending = false;
+}
+
+static void hci_transport_link_queue_packet(uint8_t packet_type, uint8_t *packet, int size){
+    uint8_t index = (link_queue_head + link_queue_len) % HCI_TRANSPORT_H5_WINDOW_SIZE;
+    hci_transport_link_queue_entry_t * entry = &link_queue[index];
+#if HCI_TRANSPORT_H5_WINDOW_SIZE > 1
+    btstack_assert(size <= HCI_OUTGOING_PACKET_BUFFER_SIZE);
+    entry->packet = &link_queue_storage[index][4];
+    memcpy(entry->packet, packet, size);
+#else
+    entry->packet = packet;
+#endif
+    entry->type = packet_type;
+    entry->size = size;
+    link_queue_len++;
+}
+
+static void hci_transport_link_process_ack(uint8_t ack_nr){
+    // peer expects ack_nr as next sequence number
+    uint8_t num_acked = (ack_nr - link_seq_nr) & 0x07;
+    if (num_acked == 0) return;
+    if (num_acked > link_queue_len){
+        log_info("ack %u for unsent packet, seq %u, queued %u", ack_nr, link_seq_nr, link_queue_len);
+        return;
+    }
+    log_debug("%u outgoing packets with seq %u.. ack'ed", num_acked, link_seq_nr);
+    link_seq_nr     = ack_nr;
+    link_queue_head = (link_queue_head + num_acked) % HCI_TRANSPORT_H5_WINDOW_SIZE;
+    link_queue_len -= num_acked;
+    link_queue_sent = (link_queue_sent > num_acked) ? (link_queue_sent - num_acked) : 0;
+    if (link_queue_len == 0){
+        btstack_run_loop_remove_timer(&link_timer);
+    } else {
+        hci_transport_link_set_timer(link_resend_timeout_ms);
+    }
 }
 
-static void hci_transport_h5_queue_packet(uint8_t packet_type, uint8_t *packet, int size){
-    hci_packet = packet;
-    hci_packet_type = packet_type;
-    hci_packet_size = size;
+// notify upper stack that it can send again, if packet was queued/sent and there's room for the next one
+static void hci_transport_link_emit_packet_sent_if_ready(void){
+    if (link_packet_sent_pending == false) return;
+    if (link_unreliable_packet != NULL) return;
+    if (link_queue_len >= link_window_size) return;
+    link_packet_sent_pending = false;
+    uint8_t event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
+    packet_handler(HCI_EVENT_PACKET, &event[0], sizeof(event));
 }
 
+// config response: min sliding window size, OOF flow control and DIC if supported by both
+static uint8_t hci_transport_link_calc_config_response(uint8_t peer_config){
+    uint8_t window_size = btstack_min(peer_config & LINK_CONFIG_SLIDING_WINDOW_SIZE_MASK, LINK_CONFIG_SLIDING_WINDOW_SIZE);
+    uint8_t flags = peer_config & LINK_CONFIG_FIELD & (LINK_CONFIG_OOF_FLOW_CONTROL_FLAG | LINK_CONFIG_DATA_INTEGRITY_CHECK_FLAG);
+    return window_size | flags | (LINK_CONFIG_VERSION_NR << 5);
+}
+
+#ifdef ENABLE_H5_OOF_FLOW_CONTROL
+static void hci_transport_h5_xon_xoff_received(bool xon){
+    log_debug("link received %s", xon ? "XON" : "XOFF");
+    link_peer_xoff = !xon;
+    hci_transport_link_run();
+}
+#endif
+
 static void hci_transport_h5_emit_sleep_state(int sleep_active){
     static int last_state = 0;
     if (sleep_active == last_state) return;
@@ -584,14 +744,29 @@ static void hci_transport_h5_process_frame(uint16_t frame_size){
                     hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_CONFIG_RESPONSE_EMPTY;
                 } else {
                     log_debug("link received config, 0x%02x", slip_payload[2]);
+                    link_config_response_field = hci_transport_link_calc_config_response(slip_payload[2]);
                     hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_CONFIG_RESPONSE;
                 }
                 break;
             }
             if (hci_transport_h5_payload_has_prefix(slip_payload, link_payload_len, link_control_config_response, link_control_config_response_prefix_len)){
                 uint8_t config = (link_payload_len > link_control_config_response_prefix_len) ? slip_payload[2] : 0;
-                link_peer_supports_data_integrity_check = (config & 0x10) != 0;
-                log_info("link received config response 0x%02x, data integrity check supported %u", config, link_peer_supports_data_integrity_check);
+                link_peer_supports_data_integrity_check = (config & LINK_CONFIG_DATA_INTEGRITY_CHECK_FLAG) != 0;
+                link_window_size = btstack_min(config & LINK_CONFIG_SLIDING_WINDOW_SIZE_MASK, LINK_CONFIG_SLIDING_WINDOW_SIZE);
+                if (link_window_size == 0){
+                    link_window_size = 1;
+                }
+#ifdef ENABLE_H5_OOF_FLOW_CONTROL
+                // peer escapes XON/XOFF in frames and may send them between frames
+                bool oof_flow_control = (config & LINK_CONFIG_OOF_FLOW_CONTROL_FLAG) != 0;
+                btstack_slip_encoder_set_xon_xoff_escaping(oof_flow_control);
+                btstack_slip_decoder_set_xon_xoff_handler(oof_flow_control ? &hci_transport_h5_xon_xoff_received : NULL);
+                log_info("link received config response 0x%02x, data integrity check supported %u, window size %u, oof flow control %u",
+                         config, link_peer_supports_data_integrity_check, link_window_size, oof_flow_control);
+#else
+                log_info("link received config response 0x%02x, data integrity check supported %u, window size %u",
+                         config, link_peer_supports_data_integrity_check, link_window_size);
+#endif
                 link_state = LINK_ACTIVE;
                 btstack_run_loop_remove_timer(&link_timer);
                 log_info("link activated");
@@ -620,27 +795,19 @@ static void hci_transport_h5_process_frame(uint16_t frame_size){
 
             // Process ACKs in reliable packet and explicit ack packets
             if (reliable_packet || link_packet_type == LINK_ACKNOWLEDGEMENT_TYPE){
-                // our packet is good if the remote expects our seq nr + 1
-                int next_seq_nr = hci_transport_link_inc_seq_nr(link_seq_nr);
-                if (hci_transport_link_have_outgoing_packet() && next_seq_nr == ack_nr){
-                    log_debug("outoing packet with seq %u ack'ed", link_seq_nr);
-                    link_seq_nr = next_seq_nr;
-                    hci_transport_link_clear_queue();
-
-                    // notify upper stack that it can send again
-                    uint8_t event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
-                    packet_handler(HCI_EVENT_PACKET, &event[0], sizeof(event));
-                }
+                hci_transport_link_process_ack(ack_nr);
+                hci_transport_link_emit_packet_sent_if_ready();
             } 
 
             switch (link_packet_type){
                 case LINK_CONTROL_PACKET_TYPE:
-                    if (hci_transport_h5_payload_matches(slip_payload, link_payload_len, link_control_config, sizeof(link_control_config))){
+                    if (hci_transport_h5_payload_has_prefix(slip_payload, link_payload_len, link_control_config, link_control_config_prefix_len)){
                         if (link_payload_len == link_control_config_prefix_len){
                             log_debug("link received config, no config field");
                             hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_CONFIG_RESPONSE_EMPTY;
                         } else {
                             log_debug("link received config, 0x%02x", slip_payload[2]);
+                            link_config_response_field = hci_transport_link_calc_config_response(slip_payload[2]);
                             hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_CONFIG_RESPONSE;
                         }
                         break;
@@ -751,13 +918,14 @@ static void hci_transport_h5_frame_sent(void){
     }
 
     // SCO packets are sent as unreliable, so we're done now
-    if (hci_packet_type == HCI_SCO_DATA_PACKET){
-        hci_transport_link_clear_queue();
-        // notify upper stack that it can send again
-        uint8_t event[] = { HCI_EVENT_TRANSPORT_PACKET_SENT, 0};
-        packet_handler(HCI_EVENT_PACKET, &event[0], sizeof(event));
+    if (link_unreliable_packet_in_flight){
+        link_unreliable_packet_in_flight = false;
+        link_unreliable_packet = NULL;
     }
 
+    // notify upper stack that it can send again, if window is not full
+    hci_transport_link_emit_packet_sent_if_ready();
+
     hci_transport_link_run();
 }
 
@@ -831,9 +999,11 @@ static void hci_transport_h5_register_packet_handler(void (*handler)(uint8_t pac
 }
 
 static int hci_transport_h5_can_send_packet_now(uint8_t packet_type){
-    int res = !hci_transport_link_have_outgoing_packet() && link_state == LINK_ACTIVE;
-    // log_info("can_send_packet_now: %u", res);
-    return res;
+    UNUSED(packet_type);
+    if (link_state != LINK_ACTIVE) return 0;
+    if (link_packet_sent_pending) return 0;
+    if (link_unreliable_packet != NULL) return 0;
+    return link_queue_len < link_window_size;
 }
 
 static int hci_transport_h5_send_packet(uint8_t packet_type, uint8_t *packet, int size){
@@ -842,8 +1012,14 @@ static int hci_transport_h5_send_packet(uint8_t packet_type, uint8_t *packet, in
         return -1;
     }
 
-    // store request
-    hci_transport_h5_queue_packet(packet_type, packet, size);
+    // store request, reliable packets get copied for window size > 1
+    if (packet_type == HCI_SCO_DATA_PACKET){
+        link_unreliable_packet = packet;
+        link_unreliable_packet_size = size;
+    } else {
+        hci_transport_link_queue_packet(packet_type, packet, size);
+    }
+    link_packet_sent_pending = true;
 
     // send wakeup first
     if (link_peer_asleep){
@@ -854,9 +1030,6 @@ static int hci_transport_h5_send_packet(uint8_t packet_type, uint8_t *packet, in
         }
         hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_WAKEUP;
         hci_transport_link_set_timer(LINK_WAKEUP_MS);
-    } else {
-        hci_transport_link_actions |= HCI_TRANSPORT_LINK_SEND_QUEUED_PACKET;
-        hci_transport_link_set_timer(link_resend_timeout_ms);
     }
     hci_transport_link_run();
     return 0;
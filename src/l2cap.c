@@ -58,6 +58,7 @@
 #endif
 
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 
 /*
@@ -153,6 +154,23 @@ typedef enum {
 #define L2CAP_USES_CHANNELS
 #endif
 
+#if defined(ENABLE_L2CAP_CHANNEL_INDEX) && defined(L2CAP_USES_CHANNELS)
+#define L2CAP_USES_CHANNEL_INDEX
+
+// number of slots in local cid index, must be a power of two
+#ifndef L2CAP_CHANNEL_INDEX_SIZE
+#define L2CAP_CHANNEL_INDEX_SIZE 64
+#endif
+
+#if (L2CAP_CHANNEL_INDEX_SIZE & (L2CAP_CHANNEL_INDEX_SIZE - 1)) != 0
+#error "L2CAP_CHANNEL_INDEX_SIZE must be a power of two"
+#endif
+
+#define L2CAP_CHANNEL_INDEX_MASK            (L2CAP_CHANNEL_INDEX_SIZE - 1u)
+#define L2CAP_CHANNEL_INDEX_SLOT_UNINDEXED  0xfffeu
+#define L2CAP_CHANNEL_INDEX_SLOT_NONE       0xffffu
+#endif
+
 // prototypes
 static void l2cap_run(void);
 static void l2cap_hci_event_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size);
@@ -242,6 +260,12 @@ static btstack_linked_list_t l2cap_channels;
 // next channel id for new connections
 static uint16_t  l2cap_local_source_cid;
 #endif
+#ifdef L2CAP_USES_CHANNEL_INDEX
+// dynamic channels stored at local_cid & L2CAP_CHANNEL_INDEX_MASK
+static l2cap_channel_t * l2cap_channel_index[L2CAP_CHANNEL_INDEX_SIZE];
+// channels that did not get a slot in the index and require linear search
+static uint16_t l2cap_channel_index_num_unindexed;
+#endif
 // next signaling sequence number
 static uint8_t   l2cap_sig_seq_nr;
 
@@ -942,13 +966,27 @@ static void l2cap_ertm_channel_send_information_frame(l2cap_channel_t * channel)
 #endif
 
 #ifdef L2CAP_USES_CHANNELS
+static void l2cap_increment_local_cid(void){
+    if (l2cap_local_source_cid == 0xfffeu) {
+        l2cap_local_source_cid = 0x40;
+    } else {
+        l2cap_local_source_cid++;
+    }
+}
+
 static uint16_t l2cap_next_local_cid(void){
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    // pick local cid with free slot in index
+    uint16_t i;
+    for (i = 0; i < L2CAP_CHANNEL_INDEX_SIZE; i++){
+        l2cap_increment_local_cid();
+        if (l2cap_channel_index[l2cap_local_source_cid & L2CAP_CHANNEL_INDEX_MASK] != NULL) continue;
+        if ((l2cap_channel_index_num_unindexed > 0u) && (l2cap_get_channel_for_local_cid(l2cap_local_source_cid) != NULL)) continue;
+        return l2cap_local_source_cid;
+    }
+#endif
     do {
-        if (l2cap_local_source_cid == 0xfffeu) {
-            l2cap_local_source_cid = 0x40;
-        } else {
-            l2cap_local_source_cid++;
-        }
+        l2cap_increment_local_cid();
     } while (l2cap_get_channel_for_local_cid(l2cap_local_source_cid) != NULL);
     return l2cap_local_source_cid;
 }
@@ -1020,6 +1058,10 @@ void l2cap_init(void){
  */
 void l2cap_deinit(void){
     l2cap_channels = NULL;
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    (void)memset(l2cap_channel_index, 0, sizeof(l2cap_channel_index));
+    l2cap_channel_index_num_unindexed = 0;
+#endif
     l2cap_signaling_responses_pending = 0;
 #ifdef ENABLE_CLASSIC
     l2cap_require_security_level2_for_outgoing_sdp = 0;
@@ -1270,14 +1312,88 @@ static int l2cap_is_dynamic_channel_type(l2cap_channel_type_t channel_type) {
     }
 }
 
+#ifdef L2CAP_USES_CHANNEL_INDEX
+static l2cap_channel_t * l2cap_channel_for_connection_item(btstack_linked_item_t * item){
+    return (l2cap_channel_t *) (((uint8_t *) item) - offsetof(l2cap_channel_t, connection_item));
+}
+
+static void l2cap_channel_connection_link(l2cap_channel_t * channel){
+    if (channel->con_handle == HCI_CON_HANDLE_INVALID) return;
+    hci_connection_t * connection = hci_connection_for_handle(channel->con_handle);
+    if (connection == NULL) return;
+    btstack_linked_list_add_tail(&connection->l2cap_state.channels, &channel->connection_item);
+}
+
+static void l2cap_channel_connection_unlink(l2cap_channel_t * channel){
+    if (channel->con_handle == HCI_CON_HANDLE_INVALID) return;
+    hci_connection_t * connection = hci_connection_for_handle(channel->con_handle);
+    if (connection == NULL) return;
+    btstack_linked_list_remove(&connection->l2cap_state.channels, &channel->connection_item);
+}
+
+static void l2cap_channel_index_add(l2cap_channel_t * channel){
+    uint16_t slot = channel->local_cid & L2CAP_CHANNEL_INDEX_MASK;
+    if (l2cap_channel_index[slot] == NULL){
+        l2cap_channel_index[slot] = channel;
+        channel->local_cid_index_slot = slot;
+    } else {
+        log_info("no index slot for local_cid 0x%04x", channel->local_cid);
+        channel->local_cid_index_slot = L2CAP_CHANNEL_INDEX_SLOT_UNINDEXED;
+        l2cap_channel_index_num_unindexed++;
+    }
+}
+
+// called when channel is removed from l2cap_channels, can be called multiple times
+static void l2cap_channel_index_remove(l2cap_channel_t * channel){
+    uint16_t slot = channel->local_cid_index_slot;
+    if (slot == L2CAP_CHANNEL_INDEX_SLOT_UNINDEXED){
+        l2cap_channel_index_num_unindexed--;
+    } else if (slot != L2CAP_CHANNEL_INDEX_SLOT_NONE){
+        btstack_assert(l2cap_channel_index[slot] == channel);
+        l2cap_channel_index[slot] = NULL;
+    } else {
+        return;
+    }
+    channel->local_cid_index_slot = L2CAP_CHANNEL_INDEX_SLOT_NONE;
+    l2cap_channel_connection_unlink(channel);
+}
+
+static void l2cap_channel_index_remove_list(btstack_linked_list_t * channels){
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, channels);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        l2cap_channel_t * channel = (l2cap_channel_t *) btstack_linked_list_iterator_next(&it);
+        l2cap_channel_index_remove(channel);
+    }
+}
+#endif
+
+static void l2cap_channel_set_con_handle(l2cap_channel_t * channel, hci_con_handle_t con_handle){
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    l2cap_channel_connection_unlink(channel);
+    channel->con_handle = con_handle;
+    l2cap_channel_connection_link(channel);
+#else
+    channel->con_handle = con_handle;
+#endif
+}
+
 static l2cap_channel_t * l2cap_get_channel_for_local_cid(uint16_t local_cid){
     if (local_cid < 0x40u) return NULL;
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    l2cap_channel_t * channel = l2cap_channel_index[local_cid & L2CAP_CHANNEL_INDEX_MASK];
+    if ((channel != NULL) && (channel->local_cid == local_cid)) {
+        return channel;
+    }
+    if (l2cap_channel_index_num_unindexed == 0u) {
+        return NULL;
+    }
+#endif
     return (l2cap_channel_t*) l2cap_channel_item_by_cid(local_cid);
 }
 
 static l2cap_channel_t * l2cap_get_channel_for_local_cid_and_handle(uint16_t local_cid, hci_con_handle_t con_handle){
-    if (local_cid < 0x40u) return NULL;
-    l2cap_channel_t * l2cap_channel = (l2cap_channel_t*) l2cap_channel_item_by_cid(local_cid);
+    l2cap_channel_t * l2cap_channel = l2cap_get_channel_for_local_cid(local_cid);
     if (l2cap_channel == NULL)  return NULL;
     if (l2cap_channel->con_handle != con_handle) return NULL;
     return l2cap_channel;
@@ -1287,6 +1403,19 @@ static l2cap_channel_t * l2cap_get_channel_for_local_cid_and_handle(uint16_t loc
 #ifdef L2CAP_USES_CREDIT_BASED_CHANNELS
 static l2cap_channel_t * l2cap_get_channel_for_remote_handle_and_cid(hci_con_handle_t con_handle, uint16_t remote_cid){
     btstack_linked_list_iterator_t it;
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    // only check channels on this connection
+    hci_connection_t * connection = hci_connection_for_handle(con_handle);
+    if (connection == NULL) return NULL;
+    btstack_linked_list_iterator_init(&it, &connection->l2cap_state.channels);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        l2cap_channel_t * channel = l2cap_channel_for_connection_item(btstack_linked_list_iterator_next(&it));
+        if (channel->con_handle != con_handle) continue;
+        if (channel->remote_cid != remote_cid) continue;
+        return channel;
+    }
+    return NULL;
+#else
     btstack_linked_list_iterator_init(&it, &l2cap_channels);
     while (btstack_linked_list_iterator_has_next(&it)){
         l2cap_fixed_channel_t * channel = (l2cap_fixed_channel_t*) btstack_linked_list_iterator_next(&it);
@@ -1297,6 +1426,7 @@ static l2cap_channel_t * l2cap_get_channel_for_remote_handle_and_cid(hci_con_han
         return dynamic_channel;
     }
     return NULL;
+#endif
 }
 #endif
 
@@ -2310,6 +2440,9 @@ static void l2cap_ecbm_run_channels(void) {
             } else {
                 result = channel->reason;
                 btstack_linked_list_iterator_remove(&it);
+#ifdef L2CAP_USES_CHANNEL_INDEX
+                l2cap_channel_index_remove(channel);
+#endif
                 btstack_memory_l2cap_channel_free(channel);
             }
         }
@@ -2446,7 +2579,7 @@ static void l2cap_handle_connection_complete(hci_con_handle_t con_handle, l2cap_
     if ((channel->state == L2CAP_STATE_WAIT_CONNECTION_COMPLETE) || (channel->state == L2CAP_STATE_WILL_SEND_CREATE_CONNECTION)) {
         log_info("connection complete con_handle %04x - for channel %p cid 0x%04x",
             (int) con_handle, (void *) channel, channel->local_cid);
-        channel->con_handle = con_handle;
+        l2cap_channel_set_con_handle(channel, con_handle);
         // query remote features if pairing is required
         if (channel->required_security_level > LEVEL_0){
             channel->state = L2CAP_STATE_WAIT_REMOTE_SUPPORTED_FEATURES;
@@ -2530,6 +2663,9 @@ static l2cap_channel_t * l2cap_create_channel_entry(btstack_packet_handler_t pac
     // 
     channel->local_cid = l2cap_next_local_cid();
     channel->con_handle = HCI_CON_HANDLE_INVALID;
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    l2cap_channel_index_add(channel);
+#endif
 
     // set initial state
     channel->state = L2CAP_STATE_CLOSED;
@@ -2549,6 +2685,9 @@ static void l2cap_free_channel_entry(l2cap_channel_t * channel){
 #ifdef ENABLE_L2CAP_ENHANCED_RETRANSMISSION_MODE
     l2cap_ertm_stop_retransmission_timer(channel);
     l2cap_ertm_stop_monitor_timer(channel);
+#endif
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    l2cap_channel_index_remove(channel);
 #endif
     // free  memory
     btstack_memory_l2cap_channel_free(channel);
@@ -2987,6 +3126,9 @@ static void l2cap_handle_security_level(hci_con_handle_t handle, gap_security_le
     btstack_linked_list_t failed_channels = NULL;
     struct channel_and_security_level context = { handle, actual_level};
     btstack_linked_list_filter(&l2cap_channels, &failed_channels, l2cap_outgoing_channel_with_insufficient_security, &context);
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    l2cap_channel_index_remove_list(&failed_channels);
+#endif
     btstack_linked_list_iterator_init(&it, &failed_channels);
     while (btstack_linked_list_iterator_has_next(&it)) {
         l2cap_channel_t * channel = (l2cap_channel_t *) btstack_linked_list_iterator_next(&it);
@@ -3013,6 +3155,9 @@ static void l2cap_handle_disconnection_complete(hci_con_handle_t handle){
     btstack_linked_list_t channels_to_close = NULL;
     btstack_linked_list_filter(&l2cap_channels, &channels_to_close,
         l2cap_channel_matches_con_handle, (void *)(uintptr_t) handle);
+#ifdef L2CAP_USES_CHANNEL_INDEX
+    l2cap_channel_index_remove_list(&channels_to_close);
+#endif
 
     // send l2cap open failed or closed events for all channels on this handle and free them
     btstack_linked_list_iterator_t it;
@@ -3233,7 +3378,7 @@ static void l2cap_handle_connection_request(hci_con_handle_t handle, uint8_t sig
         return;
     }
 
-    channel->con_handle = handle;
+    l2cap_channel_set_con_handle(channel, handle);
     channel->remote_cid = source_cid;
     channel->remote_sig_id = sig_id;
 
@@ -3937,7 +4082,7 @@ static uint8_t l2cap_ecbm_setup_channels(btstack_linked_list_t * channels,
             status = BTSTACK_MEMORY_ALLOC_FAILED;
             break;
         }
-        channel->con_handle = connection->con_handle;
+        l2cap_channel_set_con_handle(channel, connection->con_handle);
         btstack_linked_list_add_tail(channels, (btstack_linked_item_t *) channel);
     }
 
@@ -4043,6 +4188,9 @@ static void l2cap_ecbm_handle_security_level_incoming(l2cap_channel_t * channel)
             channel->state = L2CAP_STATE_WAIT_CLIENT_ACCEPT_OR_REJECT;
         } else {
             btstack_linked_list_iterator_remove(&it);
+#ifdef L2CAP_USES_CHANNEL_INDEX
+            l2cap_channel_index_remove(channel);
+#endif
             btstack_memory_l2cap_channel_free(channel);
         }
     }
@@ -4191,7 +4339,7 @@ static int l2cap_ecbm_signaling_handler_dispatch(hci_con_handle_t handle, uint16
                     // setup state
                     channel->state = L2CAP_STATE_WAIT_INCOMING_SECURITY_LEVEL_UPDATE;
                     channel->state_var |= L2CAP_CHANNEL_STATE_VAR_INCOMING;
-                    channel->con_handle = connection->con_handle;
+                    l2cap_channel_set_con_handle(channel, connection->con_handle);
                     channel->remote_sig_id = sig_id;
                     channel->remote_cid = source_cid;
                     channel->remote_mtu = remote_mtu;
@@ -4282,6 +4430,9 @@ static int l2cap_ecbm_signaling_handler_dispatch(hci_con_handle_t handle, uint16
                 l2cap_ecbm_emit_channel_opened(channel, channel_status);
                 // drop failed channel
                 btstack_linked_list_iterator_remove(&it);
+#ifdef L2CAP_USES_CHANNEL_INDEX
+                l2cap_channel_index_remove(channel);
+#endif
                 btstack_memory_l2cap_channel_free(channel);
             }
             return 1;
@@ -4578,7 +4729,7 @@ static int l2cap_le_signaling_handler_dispatch(hci_con_handle_t handle, uint8_t
                     return 1;
                 }
 
-                channel->con_handle = handle;
+                l2cap_channel_set_con_handle(channel, handle);
                 channel->remote_cid = source_cid;
                 channel->remote_sig_id = sig_id; 
                 channel->remote_mtu = little_endian_read_16(command, 8);
@@ -5570,7 +5721,7 @@ uint8_t l2cap_cbm_create_channel(btstack_packet_handler_t packet_handler, hci_co
     }
 
     // setup channel entry
-    channel->con_handle = con_handle;
+    l2cap_channel_set_con_handle(channel, con_handle);
     channel->receive_sdu_buffer = receive_sdu_buffer;
     channel->new_credits_incoming = initial_credits;
     channel->automatic_credits    = initial_credits == L2CAP_LE_AUTOMATIC_CREDITS;
@@ -5972,7 +6123,7 @@ void l2cap_setup_test_channels_fuzz(void) {
     channel->state = L2CAP_STATE_WILL_SEND_CREATE_CONNECTION;
     l2cap_ertm_configure_channel(channel, &ertm_config, l2cap_ertm_fuzz_storage, sizeof(l2cap_ertm_fuzz_storage));
     channel->state = L2CAP_STATE_OPEN;
-    channel->con_handle = 0x0000;
+    l2cap_channel_set_con_handle(channel, 0x0000);
     channel->remote_cid = 0x0044;
     channel->remote_mtu = 100;
     channel->remote_mps = channel->local_mps;
@@ -6002,6 +6153,9 @@ void l2cap_free_channels_fuzz(void){
         }
         if (fixed_channel == false) {
             btstack_linked_list_iterator_remove(&it);
+#ifdef L2CAP_USES_CHANNEL_INDEX
+            l2cap_channel_index_remove(channel);
+#endif
             btstack_memory_l2cap_channel_free(channel);
         }
     }
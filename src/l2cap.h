@@ -242,6 +242,14 @@ typedef struct {
     // info
     hci_con_handle_t con_handle;
 
+#ifdef ENABLE_L2CAP_CHANNEL_INDEX
+    // entry in per-connection channel list, see l2cap_state_t
+    btstack_linked_item_t connection_item;
+
+    // slot in local cid index or L2CAP_CHANNEL_INDEX_SLOT_NONE
+    uint16_t  local_cid_index_slot;
+#endif
+
     bd_addr_t address;
     bd_addr_type_t address_type;
     
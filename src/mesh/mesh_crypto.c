@@ -44,6 +44,21 @@
 
 #include "mesh/mesh_crypto.h"
 
+// with AES128 in software, CMACs are calculated directly without btstack_crypto request queue
+#if defined(ENABLE_SOFTWARE_AES128) || defined(HAVE_AES128)
+#define USE_BTSTACK_AES128
+#endif
+
+#ifdef USE_BTSTACK_AES128
+void mesh_k1(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint16_t n_len, const uint8_t * salt,
+    const uint8_t * p, const uint16_t p_len, uint8_t * result, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    uint8_t t[16];
+    btstack_crypto_aes128_cmac_message_sync(salt, n_len, n, t);
+    btstack_crypto_aes128_cmac_message_sync(t, p_len, p, result);
+    (*callback)(callback_arg);
+}
+#else
 // mesh k1 - might get moved to btstack_crypto and all vars go into btstack_crypto_mesh_k1_t struct
 static uint8_t         mesh_k1_temp[16];
 static void (*         mesh_k1_callback)(void * arg);
@@ -66,7 +81,34 @@ void mesh_k1(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint16_t
     mesh_k1_result   = result;
     btstack_crypto_aes128_cmac_message(request, salt, n_len, n, mesh_k1_temp, mesh_k1_temp_calculated, request);
 }
+#endif
 
+static const uint8_t mesh_salt_smk2[] = { 0x4f, 0x90, 0x48, 0x0c, 0x18, 0x71, 0xbf, 0xbf, 0xfd, 0x16, 0x97, 0x1f, 0x4d, 0x8d, 0x10, 0xb1 };
+
+#ifdef USE_BTSTACK_AES128
+void mesh_k2(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint8_t * result, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    uint8_t t[16];
+    uint8_t t1[18];
+    uint8_t t2[16];
+    btstack_crypto_aes128_cmac_message_sync(mesh_salt_smk2, 16, n, t);
+    // T1 = CMAC(T, P || 0x01), NID
+    t1[0] = 0; // p
+    t1[1] = 0x01;
+    btstack_crypto_aes128_cmac_message_sync(t, 2, t1, t2);
+    result[0] = t2[15] & 0x7f;
+    // T2 = CMAC(T, T1 || P || 0x02), EncryptionKey
+    (void)memcpy(t1, t2, 16);
+    t1[16] = 0; // p
+    t1[17] = 0x02;
+    btstack_crypto_aes128_cmac_message_sync(t, 18, t1, &result[1]);
+    // T3 = CMAC(T, T2 || P || 0x03), PrivacyKey
+    (void)memcpy(t1, &result[1], 16);
+    t1[17] = 0x03;
+    btstack_crypto_aes128_cmac_message_sync(t, 18, t1, &result[17]);
+    (*callback)(callback_arg);
+}
+#else
 // mesh k2 - might get moved to btstack_crypto and all vars go into btstack_crypto_mesh_k2_t struct
 static void (*         mesh_k2_callback)(void * arg);
 static void *          mesh_k2_arg;
@@ -75,8 +117,6 @@ static uint8_t         mesh_k2_t[16];
 static uint8_t         mesh_k2_t1[18];
 static uint8_t         mesh_k2_t2[16];
 
-static const uint8_t mesh_salt_smk2[] = { 0x4f, 0x90, 0x48, 0x0c, 0x18, 0x71, 0xbf, 0xbf, 0xfd, 0x16, 0x97, 0x1f, 0x4d, 0x8d, 0x10, 0xb1 };
-
 static void mesh_k2_callback_d(void * arg){
     // btstack_crypto_aes128_cmac_t * request = (btstack_crypto_aes128_cmac_t*) arg;
     UNUSED(arg);
@@ -124,10 +164,26 @@ void mesh_k2(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint8_t
     mesh_k2_result   = result;
     btstack_crypto_aes128_cmac_message(request, mesh_salt_smk2, 16, n, mesh_k2_t, mesh_k2_callback_a, request);
 }
+#endif
 
 
 // mesh k3 - might get moved to btstack_crypto and all vars go into btstack_crypto_mesh_k3_t struct
 static const uint8_t   mesh_k3_tag[5] = { 'i', 'd', '6', '4', 0x01}; 
+
+// AES-CMAC_ZERO('smk3')
+static const uint8_t mesh_salt_smk3[] = { 0x00, 0x36, 0x44, 0x35, 0x03, 0xf1, 0x95, 0xcc, 0x8a, 0x71, 0x6e, 0x13, 0x62, 0x91, 0xc3, 0x02, };
+
+#ifdef USE_BTSTACK_AES128
+void mesh_k3(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint8_t * result, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    uint8_t temp[16];
+    uint8_t result128[16];
+    btstack_crypto_aes128_cmac_message_sync(mesh_salt_smk3, 16, n, temp);
+    btstack_crypto_aes128_cmac_message_sync(temp, sizeof(mesh_k3_tag), mesh_k3_tag, result128);
+    (void)memcpy(result, &result128[8], 8);
+    (*callback)(callback_arg);
+}
+#else
 static uint8_t         mesh_k3_temp[16];
 static uint8_t         mesh_k3_result128[16];
 static void (*         mesh_k3_callback)(void * arg);
@@ -135,9 +191,6 @@ static void *          mesh_k3_arg;
 static const uint8_t * mesh_k3_n;
 static uint8_t       * mesh_k3_result;
 
-// AES-CMAC_ZERO('smk3')
-static const uint8_t mesh_salt_smk3[] = { 0x00, 0x36, 0x44, 0x35, 0x03, 0xf1, 0x95, 0xcc, 0x8a, 0x71, 0x6e, 0x13, 0x62, 0x91, 0xc3, 0x02, };
-
 static void mesh_k3_result128_calculated(void * arg){
     UNUSED(arg);
     (void)memcpy(mesh_k3_result, &mesh_k3_result128[8], 8);
@@ -154,6 +207,7 @@ void mesh_k3(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint8_t
     mesh_k3_result   = result;
     btstack_crypto_aes128_cmac_message(request, mesh_salt_smk3, 16, mesh_k3_n, mesh_k3_temp, mesh_k3_temp_callback, request);
 }
+#endif
 
 // mesh k4 - might get moved to btstack_crypto and all vars go into btstack_crypto_mesh_k4_t struct
 // k4N     63964771734fbd76e3b40519d1d94a48
@@ -162,6 +216,21 @@ void mesh_k3(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint8_t
 // k4 CMAC(id6|0x01) 5f79cf09bbdab560e7f1ee404fd341a6
 // AID 26
 static const uint8_t   mesh_k4_tag[4] = { 'i', 'd', '6', 0x01}; 
+
+// AES-CMAC_ZERO('smk4')
+static const uint8_t mesh_salt_smk4[] = { 0x0E, 0x9A, 0xC1, 0xB7, 0xCE, 0xFA, 0x66, 0x87, 0x4C, 0x97, 0xEE, 0x54, 0xAC, 0x5F, 0x49, 0xBE };
+
+#ifdef USE_BTSTACK_AES128
+void mesh_k4(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint8_t * result, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    uint8_t temp[16];
+    uint8_t result128[16];
+    btstack_crypto_aes128_cmac_message_sync(mesh_salt_smk4, 16, n, temp);
+    btstack_crypto_aes128_cmac_message_sync(temp, sizeof(mesh_k4_tag), mesh_k4_tag, result128);
+    result[0] = result128[15] & 0x3f;
+    (*callback)(callback_arg);
+}
+#else
 static uint8_t         mesh_k4_temp[16];
 static uint8_t         mesh_k4_result128[16];
 static void (*         mesh_k4_callback)(void * arg);
@@ -169,8 +238,6 @@ static void *          mesh_k4_arg;
 static const uint8_t * mesh_k4_n;
 static uint8_t       * mesh_k4_result;
 
-// AES-CMAC_ZERO('smk4')
-static const uint8_t mesh_salt_smk4[] = { 0x0E, 0x9A, 0xC1, 0xB7, 0xCE, 0xFA, 0x66, 0x87, 0x4C, 0x97, 0xEE, 0x54, 0xAC, 0x5F, 0x49, 0xBE };
 static void mesh_k4_result128_calculated(void * arg){
     UNUSED(arg);
     mesh_k4_result[0] = mesh_k4_result128[15] & 0x3f;
@@ -187,10 +254,21 @@ void mesh_k4(btstack_crypto_aes128_cmac_t * request, const uint8_t * n, uint8_t
     mesh_k4_result   = result;
     btstack_crypto_aes128_cmac_message(request, mesh_salt_smk4, 16, mesh_k4_n, mesh_k4_temp, mesh_k4_temp_callback, request);
 }
+#endif
 
 // mesh virtual address hash - might get moved to btstack_crypto and all vars go into btstack_crypto_mesh_virtual_address_t struct
 
 static uint8_t mesh_salt_vtad[] = { 0xce, 0xf7, 0xfa, 0x9d, 0xc4, 0x7b, 0xaf, 0x5d, 0xaa, 0xee, 0xd1, 0x94, 0x06, 0x09, 0x4f, 0x37, };
+
+#ifdef USE_BTSTACK_AES128
+void mesh_virtual_address(btstack_crypto_aes128_cmac_t * request, const uint8_t * label_uuid, uint16_t * addr, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    uint8_t temp[16];
+    btstack_crypto_aes128_cmac_message_sync(mesh_salt_vtad, 16, label_uuid, temp);
+    *addr = (big_endian_read_16(temp, 14) & 0x3fff) | 0x8000;
+    (*callback)(callback_arg);
+}
+#else
 static void *  mesh_virtual_address_arg;
 static void (* mesh_virtual_address_callback)(void * arg);
 static uint16_t * mesh_virtual_address_hash;
@@ -209,6 +287,7 @@ void mesh_virtual_address(btstack_crypto_aes128_cmac_t * request, const uint8_t
     mesh_virtual_address_hash      = addr;
     btstack_crypto_aes128_cmac_message(request, mesh_salt_vtad, 16, label_uuid, mesh_virtual_address_temp, mesh_virtual_address_temp_callback, request);
 }
+#endif
 
 //
 static void *  mesh_network_key_derive_arg;
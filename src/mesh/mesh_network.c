@@ -66,6 +66,11 @@
 // configuration
 #define MESH_NETWORK_CACHE_SIZE 2
 
+// with AES128 in software, NetMIC is calculated directly without btstack_crypto request queue
+#if defined(ENABLE_SOFTWARE_AES128) || defined(HAVE_AES128)
+#define USE_BTSTACK_AES128
+#endif
+
 // debug config
 #define LOG_NETWORK
 
@@ -317,16 +322,21 @@ static void mesh_network_send_c(void *arg){
 }
 
 static void mesh_network_send_b(void *arg){
-    UNUSED(arg);
 
     uint32_t iv_index = mesh_get_iv_index_for_tx();
 
     // store NetMIC
+    uint8_t net_mic_len = outgoing_pdu->data[1] & 0x80 ? 8 : 4;
     uint8_t net_mic[8];
+#ifdef USE_BTSTACK_AES128
+    // calculated by btstack_crypto_ccm_encrypt_sync
+    (void)memcpy(net_mic, (const uint8_t *) arg, net_mic_len);
+#else
+    UNUSED(arg);
     btstack_crypto_ccm_get_authentication_value(&mesh_network_crypto_request.ccm, net_mic);
+#endif
 
     // store MIC
-    uint8_t net_mic_len = outgoing_pdu->data[1] & 0x80 ? 8 : 4;
     (void)memcpy(&outgoing_pdu->data[outgoing_pdu->len], net_mic, net_mic_len);
     outgoing_pdu->len += net_mic_len;
 
@@ -394,8 +404,14 @@ static void mesh_network_send_a(void){
     // start ccm
     uint8_t cypher_len  = outgoing_pdu->len - 7;
     uint8_t net_mic_len = outgoing_pdu->data[1] & 0x80 ? 8 : 4;
+#ifdef USE_BTSTACK_AES128
+    uint8_t net_mic[8];
+    btstack_crypto_ccm_encrypt_sync(current_network_key->encryption_key, network_nonce, NULL, 0, &outgoing_pdu->data[7], cypher_len, &outgoing_pdu->data[7], net_mic_len, net_mic);
+    mesh_network_send_b(net_mic);
+#else
     btstack_crypto_ccm_init(&mesh_network_crypto_request.ccm, current_network_key->encryption_key, network_nonce, cypher_len, 0, net_mic_len);
     btstack_crypto_ccm_encrypt_block(&mesh_network_crypto_request.ccm, cypher_len, &outgoing_pdu->data[7], &outgoing_pdu->data[7], &mesh_network_send_b, NULL);
+#endif
 }
 
 #if defined(ENABLE_MESH_RELAY) || defined (ENABLE_MESH_PROXY_SERVER)
@@ -488,8 +504,6 @@ static void process_network_pdu_done(void){
 }
 
 static void process_network_pdu_validate_d(void * arg){
-    UNUSED(arg);
-    // mesh_network_pdu_t * network_pdu = (mesh_network_pdu_t *) arg;
 
     uint8_t ctl_ttl     = incoming_pdu_decoded->data[1];
     uint8_t ctl         = ctl_ttl >> 7;
@@ -497,7 +511,13 @@ static void process_network_pdu_validate_d(void * arg){
 
     // store NetMIC
     uint8_t net_mic[8];
+#ifdef USE_BTSTACK_AES128
+    // calculated by btstack_crypto_ccm_decrypt_sync
+    (void)memcpy(net_mic, (const uint8_t *) arg, net_mic_len);
+#else
+    UNUSED(arg);
     btstack_crypto_ccm_get_authentication_value(&mesh_network_crypto_request.ccm, net_mic);
+#endif
 #ifdef LOG_NETWORK
     printf("RX-NetMIC (%p): ", incoming_pdu_decoded); 
     printf_hexdump(net_mic, net_mic_len);
@@ -652,8 +672,14 @@ static void process_network_pdu_validate_b(void * arg){
 
 #endif
 
+#ifdef USE_BTSTACK_AES128
+    uint8_t net_mic[8];
+    btstack_crypto_ccm_decrypt_sync(current_network_key->encryption_key, network_nonce, NULL, 0, &incoming_pdu_raw->data[7], cypher_len, &incoming_pdu_decoded->data[7], net_mic_len, net_mic);
+    process_network_pdu_validate_d(net_mic);
+#else
     btstack_crypto_ccm_init(&mesh_network_crypto_request.ccm, current_network_key->encryption_key, network_nonce, cypher_len, 0, net_mic_len);
-    btstack_crypto_ccm_decrypt_block(&mesh_network_crypto_request.ccm, cypher_len, &incoming_pdu_raw->data[7], &incoming_pdu_decoded->data[7], &process_network_pdu_validate_d, incoming_pdu_decoded);
+    btstack_crypto_ccm_decrypt_block(&mesh_network_crypto_request.ccm, cypher_len, &incoming_pdu_raw->data[7], &incoming_pdu_decoded->data[7], &process_network_pdu_validate_d, NULL);
+#endif
 }
 
 static void process_network_pdu_validate(void){
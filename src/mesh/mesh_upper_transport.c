@@ -84,10 +84,17 @@ static void mesh_upper_transport_validate_access_message(void);
 static void (*mesh_access_message_handler)( mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu);
 static void (*mesh_control_message_handler)( mesh_transport_callback_type_t callback_type, mesh_transport_status_t status, mesh_pdu_t * pdu);
 
+// with AES128 in software, TransMIC is calculated directly without btstack_crypto request queue
+#if defined(ENABLE_SOFTWARE_AES128) || defined(HAVE_AES128)
+#define USE_BTSTACK_AES128
+#endif
+
 //
 static int crypto_active;
 static uint8_t application_nonce[13];
+#ifndef USE_BTSTACK_AES128
 static btstack_crypto_ccm_t ccm;
+#endif
 static mesh_transport_key_and_virtual_address_iterator_t mesh_transport_key_it;
 
 // incoming segmented (mesh_segmented_pdu_t) or unsegmented (network_pdu_t)
@@ -472,8 +479,6 @@ void mesh_upper_transport_request_to_send(btstack_context_callback_registration_
 }
 
 static void mesh_upper_transport_validate_access_message_ccm(void * arg){
-    UNUSED(arg);
-
     uint8_t transmic_len = ((incoming_access_decrypted->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
     uint8_t * upper_transport_pdu     = incoming_access_decrypted->data;
     uint8_t   upper_transport_pdu_len = incoming_access_decrypted->len - transmic_len;
@@ -482,7 +487,13 @@ static void mesh_upper_transport_validate_access_message_ccm(void * arg){
 
     // store TransMIC
     uint8_t trans_mic[8];
+#ifdef USE_BTSTACK_AES128
+    // calculated by btstack_crypto_ccm_decrypt_sync
+    (void)memcpy(trans_mic, (const uint8_t *) arg, transmic_len);
+#else
+    UNUSED(arg);
     btstack_crypto_ccm_get_authentication_value(&ccm, trans_mic);
+#endif
     mesh_print_hex("TransMIC", trans_mic, transmic_len);
 
     if (memcmp(trans_mic, &upper_transport_pdu[upper_transport_pdu_len], transmic_len) == 0){
@@ -513,6 +524,25 @@ static void mesh_upper_transport_validate_access_message_ccm(void * arg){
     }
 }
 
+static void mesh_upper_transport_validate_access_message_decrypt(uint8_t * upper_transport_pdu_data, uint8_t upper_transport_pdu_len){
+#ifdef USE_BTSTACK_AES128
+    uint8_t   transmic_len = ((incoming_access_decrypted->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
+    const uint8_t * label_uuid = NULL;
+    uint16_t  aad_len = 0;
+    if (mesh_network_address_virtual(incoming_access_decrypted->dst)){
+        label_uuid = mesh_transport_key_it.address->label_uuid;
+        aad_len    = 16;
+    }
+    uint8_t trans_mic[8];
+    btstack_crypto_ccm_decrypt_sync(mesh_transport_key_it.key->key, application_nonce, label_uuid, aad_len, upper_transport_pdu_data,
+                                    upper_transport_pdu_len, upper_transport_pdu_data, transmic_len, trans_mic);
+    mesh_upper_transport_validate_access_message_ccm(trans_mic);
+#else
+    btstack_crypto_ccm_decrypt_block(&ccm, upper_transport_pdu_len, upper_transport_pdu_data, upper_transport_pdu_data,
+                                     &mesh_upper_transport_validate_access_message_ccm, NULL);
+#endif
+}
+
 static void mesh_upper_transport_validate_access_message_digest(void * arg){
     UNUSED(arg);
     uint8_t   transmic_len = ((incoming_access_decrypted->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
@@ -526,14 +556,12 @@ static void mesh_upper_transport_validate_access_message_digest(void * arg){
             segmented_pdu = (mesh_segmented_pdu_t *) incoming_access_encrypted;
             mesh_segmented_pdu_flatten(&segmented_pdu->segments, 12, upper_transport_pdu_data_out);
             mesh_print_hex("Encrypted Payload:", upper_transport_pdu_data_out, upper_transport_pdu_len);
-            btstack_crypto_ccm_decrypt_block(&ccm, upper_transport_pdu_len, upper_transport_pdu_data_out, upper_transport_pdu_data_out,
-                                             &mesh_upper_transport_validate_access_message_ccm, NULL);
+            mesh_upper_transport_validate_access_message_decrypt(upper_transport_pdu_data_out, upper_transport_pdu_len);
             break;
         case MESH_PDU_TYPE_UNSEGMENTED:
             unsegmented_pdu = (mesh_network_pdu_t *) incoming_access_encrypted;
             (void)memcpy(upper_transport_pdu_data_out, &unsegmented_pdu->data[10], incoming_access_decrypted->len);
-            btstack_crypto_ccm_decrypt_block(&ccm, upper_transport_pdu_len, upper_transport_pdu_data_out, upper_transport_pdu_data_out,
-                                             &mesh_upper_transport_validate_access_message_ccm, NULL);
+            mesh_upper_transport_validate_access_message_decrypt(upper_transport_pdu_data_out, upper_transport_pdu_len);
             break;
         default:
             btstack_assert(false);
@@ -569,6 +597,10 @@ static void mesh_upper_transport_validate_access_message(void){
 
     // decrypt ccm
     crypto_active = 1;
+#ifdef USE_BTSTACK_AES128
+    // label uuid is passed to btstack_crypto_ccm_decrypt_sync as additional data
+    mesh_upper_transport_validate_access_message_digest(NULL);
+#else
     uint16_t aad_len  = 0;
     if (mesh_network_address_virtual(incoming_access_decrypted->dst)){
         aad_len  = 16;
@@ -581,6 +613,7 @@ static void mesh_upper_transport_validate_access_message(void){
     } else {
         mesh_upper_transport_validate_access_message_digest(NULL);
     }
+#endif
 }
 
 static void mesh_upper_transport_process_access_message(void){
@@ -669,8 +702,10 @@ static void mesh_upper_transport_send_access_ccm(void * arg){
 
     mesh_upper_transport_pdu_t * upper_pdu = (mesh_upper_transport_pdu_t *) arg;
     mesh_print_hex("EncAccessPayload", incoming_pdu_singleton.access.data, upper_pdu->len);
-    // store TransMIC
+#ifndef USE_BTSTACK_AES128
+    // store TransMIC, btstack_crypto_ccm_encrypt_sync stores it directly
     btstack_crypto_ccm_get_authentication_value(&ccm, &incoming_pdu_singleton.access.data[upper_pdu->len]);
+#endif
     uint8_t transmic_len = ((upper_pdu->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
     mesh_print_hex("TransMIC", &incoming_pdu_singleton.access.data[upper_pdu->len], transmic_len);
     upper_pdu->len += transmic_len;
@@ -687,12 +722,14 @@ static void mesh_upper_transport_send_access_ccm(void * arg){
     }
 }
 
+#ifndef USE_BTSTACK_AES128
 static void mesh_upper_transport_send_access_digest(void *arg){
     mesh_upper_transport_pdu_t * upper_pdu = (mesh_upper_transport_pdu_t *) arg;
     uint16_t  access_pdu_len  = upper_pdu->len;
     btstack_crypto_ccm_encrypt_block(&ccm, access_pdu_len, incoming_pdu_singleton.access.data, incoming_pdu_singleton.access.data,
                                      &mesh_upper_transport_send_access_ccm, upper_pdu);
 }
+#endif
 
 static void mesh_upper_transport_send_access(mesh_upper_transport_pdu_t * upper_pdu){
 
@@ -754,6 +791,16 @@ static void mesh_upper_transport_send_access(mesh_upper_transport_pdu_t * upper_
     // encrypt ccm
     uint8_t   transmic_len = ((upper_pdu->flags & MESH_TRANSPORT_FLAG_TRANSMIC_64) != 0) ? 8 : 4;
     uint16_t  access_pdu_len  = upper_pdu->len;
+#ifdef USE_BTSTACK_AES128
+    const uint8_t * label_uuid = NULL;
+    if (virtual_address){
+        mesh_print_hex("LabelUUID", virtual_address->label_uuid, 16);
+        label_uuid = virtual_address->label_uuid;
+    }
+    btstack_crypto_ccm_encrypt_sync(appkey->key, application_nonce, label_uuid, aad_len, incoming_pdu_singleton.access.data, access_pdu_len,
+                                    incoming_pdu_singleton.access.data, transmic_len, &incoming_pdu_singleton.access.data[access_pdu_len]);
+    mesh_upper_transport_send_access_ccm(upper_pdu);
+#else
     btstack_crypto_ccm_init(&ccm, appkey->key, application_nonce, access_pdu_len, aad_len, transmic_len);
     if (virtual_address){
         mesh_print_hex("LabelUUID", virtual_address->label_uuid, 16);
@@ -762,6 +809,7 @@ static void mesh_upper_transport_send_access(mesh_upper_transport_pdu_t * upper_
     } else {
         mesh_upper_transport_send_access_digest(upper_pdu);
     }
+#endif
 }
 
 static void mesh_upper_transport_send_unsegmented_control_pdu(mesh_network_pdu_t * network_pdu){
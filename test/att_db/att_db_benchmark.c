@@ -0,0 +1,185 @@
+// Benchmark for ATT DB discovery and reads
+//
+// Build with and without ENABLE_ATT_DB_INDEX (make benchmark) to compare linear iterator and attribute index
+
+#define _POSIX_C_SOURCE 200809
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ble/att_db.h"
+#include "ble/att_db_util.h"
+#include "bluetooth_gatt.h"
+#include "btstack_crypto.h"
+#include "btstack_util.h"
+
+#define NUM_SERVICES                  30
+#define NUM_CHARACTERISTICS_PER_SERVICE 4
+#define NUM_ROUNDS                   200
+
+static att_connection_t att_connection;
+static uint8_t att_request[23];
+static uint8_t att_response[ATT_DEFAULT_MTU];
+static uint8_t characteristic_value[4];
+static uint32_t num_requests;
+
+static uint16_t service_start_handles[NUM_SERVICES];
+static uint16_t service_end_handles[NUM_SERVICES];
+static uint16_t value_handles[NUM_SERVICES * NUM_CHARACTERISTICS_PER_SERVICE];
+static uint16_t num_value_handles;
+
+// database hash not needed
+void btstack_crypto_aes128_cmac_generator(btstack_crypto_aes128_cmac_t * request, const uint8_t * key, uint16_t size, uint8_t (*get_byte_callback)(uint16_t pos), uint8_t * hash, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    UNUSED(key);
+    UNUSED(size);
+    UNUSED(get_byte_callback);
+    UNUSED(hash);
+    UNUSED(callback);
+    UNUSED(callback_arg);
+}
+
+static uint64_t get_time_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000u) + ((uint64_t) ts.tv_nsec / 1000u);
+}
+
+static uint16_t send_range_request(uint8_t opcode, uint16_t start_handle, uint16_t end_handle, uint16_t uuid16){
+    att_request[0] = opcode;
+    little_endian_store_16(att_request, 1, start_handle);
+    little_endian_store_16(att_request, 3, end_handle);
+    uint16_t request_len = 5;
+    if (uuid16 != 0u){
+        little_endian_store_16(att_request, 5, uuid16);
+        request_len = 7;
+    }
+    num_requests++;
+    return att_handle_request(&att_connection, att_request, request_len, att_response);
+}
+
+static void setup_db(void){
+    att_db_util_init();
+    uint16_t i;
+    uint16_t j;
+    for (i = 0; i < NUM_SERVICES; i++){
+        att_db_util_add_service_uuid16(0x1800 + 0x10 + i);
+        for (j = 0; j < NUM_CHARACTERISTICS_PER_SERVICE; j++){
+            att_db_util_add_characteristic_uuid16(0x2a00 + (i * NUM_CHARACTERISTICS_PER_SERVICE) + j,
+                ATT_PROPERTY_READ | ATT_PROPERTY_NOTIFY, ATT_SECURITY_NONE, ATT_SECURITY_NONE,
+                characteristic_value, sizeof(characteristic_value));
+        }
+    }
+    att_set_db(att_db_util_get_address());
+    memset(&att_connection, 0, sizeof(att_connection));
+    att_connection.mtu = ATT_DEFAULT_MTU;
+    att_connection.max_mtu = ATT_DEFAULT_MTU;
+}
+
+static uint16_t discover_services(void){
+    uint16_t num_services = 0;
+    uint16_t start_handle = 1;
+    while (true){
+        uint16_t response_len = send_range_request(ATT_READ_BY_GROUP_TYPE_REQUEST, start_handle, 0xffff, GATT_PRIMARY_SERVICE_UUID);
+        if (att_response[0] != ATT_READ_BY_GROUP_TYPE_RESPONSE) break;
+        uint16_t pair_len = att_response[1];
+        uint16_t pos;
+        uint16_t end_handle = 0;
+        for (pos = 2; (pos + pair_len) <= response_len; pos += pair_len){
+            end_handle = little_endian_read_16(att_response, pos + 2);
+            if (num_services < NUM_SERVICES){
+                service_start_handles[num_services] = little_endian_read_16(att_response, pos);
+                service_end_handles[num_services]   = end_handle;
+            }
+            num_services++;
+        }
+        if (end_handle == 0xffff) break;
+        start_handle = end_handle + 1;
+    }
+    return num_services;
+}
+
+static void discover_characteristics(uint16_t start_handle, uint16_t end_handle){
+    while (start_handle <= end_handle){
+        uint16_t response_len = send_range_request(ATT_READ_BY_TYPE_REQUEST, start_handle, end_handle, GATT_CHARACTERISTICS_UUID);
+        if (att_response[0] != ATT_READ_BY_TYPE_RESPONSE) break;
+        uint16_t pair_len = att_response[1];
+        uint16_t pos;
+        uint16_t last_handle = 0;
+        for (pos = 2; (pos + pair_len) <= response_len; pos += pair_len){
+            last_handle = little_endian_read_16(att_response, pos);
+            if (num_value_handles < (NUM_SERVICES * NUM_CHARACTERISTICS_PER_SERVICE)){
+                value_handles[num_value_handles++] = little_endian_read_16(att_response, pos + 3);
+            }
+        }
+        start_handle = last_handle + 1;
+    }
+}
+
+static void discover_descriptors(uint16_t start_handle, uint16_t end_handle){
+    while (start_handle <= end_handle){
+        uint16_t response_len = send_range_request(ATT_FIND_INFORMATION_REQUEST, start_handle, end_handle, 0);
+        if (att_response[0] != ATT_FIND_INFORMATION_REPLY) break;
+        uint16_t pair_len = (att_response[1] == 1u) ? 4u : 18u;
+        uint16_t pos;
+        uint16_t last_handle = 0;
+        for (pos = 2; (pos + pair_len) <= response_len; pos += pair_len){
+            last_handle = little_endian_read_16(att_response, pos);
+        }
+        start_handle = last_handle + 1;
+    }
+}
+
+static void read_values(void){
+    uint16_t i;
+    for (i = 0; i < num_value_handles; i++){
+        att_request[0] = ATT_READ_REQUEST;
+        little_endian_store_16(att_request, 1, value_handles[i]);
+        num_requests++;
+        (void) att_handle_request(&att_connection, att_request, 3, att_response);
+    }
+}
+
+int main(void){
+#ifdef ENABLE_ATT_DB_INDEX
+    printf("Attribute index\n");
+#else
+    printf("Linear iterator\n");
+#endif
+    setup_db();
+
+    uint16_t round;
+    uint16_t num_services = 0;
+    uint64_t discovery_us = 0;
+    uint64_t read_us = 0;
+    uint32_t num_discovery_requests = 0;
+    uint32_t num_read_requests = 0;
+    for (round = 0; round < NUM_ROUNDS; round++){
+        num_value_handles = 0;
+        num_requests = 0;
+        uint64_t start_us = get_time_us();
+        num_services = discover_services();
+        uint16_t i;
+        for (i = 0; i < num_services; i++){
+            discover_characteristics(service_start_handles[i], service_end_handles[i]);
+            discover_descriptors(service_start_handles[i], service_end_handles[i]);
+        }
+        discovery_us += get_time_us() - start_us;
+        num_discovery_requests += num_requests;
+
+        num_requests = 0;
+        start_us = get_time_us();
+        read_values();
+        read_us += get_time_us() - start_us;
+        num_read_requests += num_requests;
+    }
+
+    printf("%u services, %u characteristics, %u rounds\n", num_services, num_value_handles, NUM_ROUNDS);
+    printf("discovery: %8u requests in %8u us, %6.3f us per request\n", (unsigned int) num_discovery_requests,
+           (unsigned int) discovery_us, (double) discovery_us / (double) num_discovery_requests);
+    printf("read:      %8u requests in %8u us, %6.3f us per request\n", (unsigned int) num_read_requests,
+           (unsigned int) read_us, (double) read_us / (double) num_read_requests);
+    return 0;
+}
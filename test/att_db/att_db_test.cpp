@@ -45,6 +45,7 @@
 #include "CppUTest/CommandLineTestRunner.h"
 
 #include "hci.h"
+#include "hci_dump.h"
 #include "ble/att_db.h"
 #include "ble/att_db_util.h"
 #include "btstack_util.h"
@@ -53,6 +54,10 @@
 #include "btstack_crypto.h"
 #include "bluetooth_gatt.h"
 
+#ifdef ENABLE_ATT_DB_INDEX
+#include "att_db_index_profile.h"
+#endif
+
 typedef enum {
 	READ_CALLBACK_MODE_RETURN_DEFAULT = 0,
 	READ_CALLBACK_MODE_RETURN_ONE_BYTE,
@@ -943,6 +948,190 @@ TEST(AttDb, att_read_callback_handle_little_endian_32){
 	}
 }
 
+TEST(AttDb, discovery_requests){
+	uint8_t request[21];
+
+	// primary services
+	request[0] = ATT_READ_BY_GROUP_TYPE_REQUEST;
+	little_endian_store_16(request, 1, 0x0001);
+	little_endian_store_16(request, 3, 0xffff);
+	little_endian_store_16(request, 5, GATT_PRIMARY_SERVICE_UUID);
+	att_response_len = att_handle_request(&att_connection, request, 7, att_response);
+	const uint8_t expected_services[] = { ATT_READ_BY_GROUP_TYPE_RESPONSE, 0x06, 0x01, 0x00, 0x1d, 0x00, 0x0f, 0x18 };
+	CHECK_EQUAL(sizeof(expected_services), att_response_len);
+	MEMCMP_EQUAL(expected_services, att_response, att_response_len);
+
+	// primary service with 128-bit UUID ends at end of db
+	little_endian_store_16(request, 1, 0x001e);
+	att_response_len = att_handle_request(&att_connection, request, 7, att_response);
+	CHECK_EQUAL(22, att_response_len);
+	CHECK_EQUAL(ATT_READ_BY_GROUP_TYPE_RESPONSE, att_response[0]);
+	CHECK_EQUAL(0x001e, little_endian_read_16(att_response, 2));
+	CHECK_EQUAL(0x0024, little_endian_read_16(att_response, 4));
+
+	// primary service by UUID
+	request[0] = ATT_FIND_BY_TYPE_VALUE_REQUEST;
+	little_endian_store_16(request, 1, 0x0001);
+	little_endian_store_16(request, 3, 0xffff);
+	little_endian_store_16(request, 5, GATT_PRIMARY_SERVICE_UUID);
+	little_endian_store_16(request, 7, ORG_BLUETOOTH_SERVICE_BATTERY_SERVICE);
+	att_response_len = att_handle_request(&att_connection, request, 9, att_response);
+	const uint8_t expected_service_range[] = { ATT_FIND_BY_TYPE_VALUE_RESPONSE, 0x01, 0x00, 0x1d, 0x00 };
+	CHECK_EQUAL(sizeof(expected_service_range), att_response_len);
+	MEMCMP_EQUAL(expected_service_range, att_response, att_response_len);
+
+	// end of service group outside of range is not reported
+	little_endian_store_16(request, 3, 0x0010);
+	att_response_len = att_handle_request(&att_connection, request, 9, att_response);
+	CHECK_EQUAL(3, att_response_len);
+	CHECK_EQUAL(ATT_FIND_BY_TYPE_VALUE_RESPONSE, att_response[0]);
+	CHECK_EQUAL(0x0001, little_endian_read_16(att_response, 1));
+
+	// characteristics
+	request[0] = ATT_READ_BY_TYPE_REQUEST;
+	little_endian_store_16(request, 1, 0x0002);
+	little_endian_store_16(request, 3, 0xffff);
+	little_endian_store_16(request, 5, GATT_CHARACTERISTICS_UUID);
+	att_response_len = att_handle_request(&att_connection, request, 7, att_response);
+	const uint8_t expected_characteristics[] = { ATT_READ_BY_TYPE_RESPONSE, 0x07,
+		0x02, 0x00, 0x1a, 0x03, 0x00, 0x19, 0x2a,
+		0x05, 0x00, 0x10, 0x06, 0x00, 0x1b, 0x2a,
+		0x08, 0x00, 0x12, 0x09, 0x00, 0x1a, 0x2a };
+	CHECK_EQUAL(sizeof(expected_characteristics), att_response_len);
+	MEMCMP_EQUAL(expected_characteristics, att_response, att_response_len);
+
+	// descriptors
+	request[0] = ATT_FIND_INFORMATION_REQUEST;
+	little_endian_store_16(request, 1, 0x0004);
+	little_endian_store_16(request, 3, 0x0006);
+	att_response_len = att_handle_request(&att_connection, request, 5, att_response);
+	const uint8_t expected_information[] = { ATT_FIND_INFORMATION_REPLY, 0x01,
+		0x04, 0x00, 0x02, 0x29,
+		0x05, 0x00, 0x03, 0x28,
+		0x06, 0x00, 0x1b, 0x2a };
+	CHECK_EQUAL(sizeof(expected_information), att_response_len);
+	MEMCMP_EQUAL(expected_information, att_response, att_response_len);
+}
+#ifdef ENABLE_ATT_DB_INDEX
+static char last_log_message[200];
+
+static void test_log_message(int log_level, const char * format, va_list argptr){
+	UNUSED(log_level);
+	vsnprintf(last_log_message, sizeof(last_log_message), format, argptr);
+}
+
+static const hci_dump_t hci_dump_test_instance = {
+	// void (*reset)(void);
+	NULL,
+	// void (*log_packet)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len);
+	NULL,
+	// void (*log_message)(int log_level, const char * format, va_list argptr);
+	&test_log_message,
+	// void (*snapshot)(void);
+	NULL,
+	// void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+	NULL,
+};
+
+TEST(AttDb, index_attributes_added_after_set_db){
+	// 0x2A37, value handle 0x0026
+	att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_HEART_RATE_MEASUREMENT, ATT_PROPERTY_READ, ATT_SECURITY_NONE, ATT_SECURITY_NONE, &battery_level, 1);
+	CHECK_EQUAL(ORG_BLUETOOTH_CHARACTERISTIC_HEART_RATE_MEASUREMENT, att_uuid_for_handle(0x0026));
+
+	uint8_t request[7];
+	request[0] = ATT_READ_BY_TYPE_REQUEST;
+	little_endian_store_16(request, 1, 0x0001);
+	little_endian_store_16(request, 3, 0xffff);
+	little_endian_store_16(request, 5, ORG_BLUETOOTH_CHARACTERISTIC_HEART_RATE_MEASUREMENT);
+	att_response_len = att_handle_request(&att_connection, request, sizeof(request), att_response);
+	const uint8_t expected_response[] = { ATT_READ_BY_TYPE_RESPONSE, 0x03, 0x26, 0x00, 100 };
+	CHECK_EQUAL(sizeof(expected_response), att_response_len);
+	MEMCMP_EQUAL(expected_response, att_response, att_response_len);
+}
+
+TEST(AttDb, index_too_many_attributes){
+	// two attributes per characteristic exceed ATT_DB_INDEX_MAX_ATTRIBUTES, att_db falls back to linear search
+	att_db_util_init();
+	att_db_util_add_service_uuid16(ORG_BLUETOOTH_SERVICE_BATTERY_SERVICE);
+	uint16_t i;
+	for (i = 0; i < ATT_DB_INDEX_MAX_ATTRIBUTES; i++){
+		att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL, ATT_PROPERTY_READ, ATT_SECURITY_NONE, ATT_SECURITY_NONE, &battery_level, 1);
+	}
+	last_log_message[0] = 0;
+	hci_dump_init(&hci_dump_test_instance);
+	att_set_db(att_db_util_get_address());
+	hci_dump_init(NULL);
+
+	// bypass of index is logged with number of attributes
+	char expected_log_message[100];
+	snprintf(expected_log_message, sizeof(expected_log_message), "ATT DB index: not used, %u attributes > ATT_DB_INDEX_MAX_ATTRIBUTES %u",
+			 1 + (2 * ATT_DB_INDEX_MAX_ATTRIBUTES), ATT_DB_INDEX_MAX_ATTRIBUTES);
+	CHECK(strstr(last_log_message, expected_log_message) != NULL);
+
+	uint16_t last_value_handle = 1 + (2 * ATT_DB_INDEX_MAX_ATTRIBUTES);
+	CHECK_EQUAL(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL, att_uuid_for_handle(last_value_handle));
+	CHECK_EQUAL(0, att_uuid_for_handle(last_value_handle + 1));
+	CHECK_EQUAL(last_value_handle, gatt_server_get_value_handle_for_characteristic_with_uuid16(last_value_handle - 1, 0xffff, ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL));
+}
+// run discovery and read requests for all start handles and collect responses
+static uint16_t att_db_index_collect_responses(att_connection_t * att_connection, uint8_t * responses){
+	const uint16_t group_types[] = { GATT_PRIMARY_SERVICE_UUID, GATT_SECONDARY_SERVICE_UUID };
+	const uint16_t attribute_types[] = { GATT_CHARACTERISTICS_UUID, GATT_CLIENT_CHARACTERISTICS_CONFIGURATION, ORG_BLUETOOTH_CHARACTERISTIC_REPORT };
+	uint16_t responses_len = 0;
+	uint16_t start_handle;
+	uint16_t i;
+	for (start_handle = 1; start_handle < 0x60; start_handle++){
+		for (i = 0; i < 2; i++){
+			att_request[0] = ATT_READ_BY_GROUP_TYPE_REQUEST;
+			little_endian_store_16(att_request, 1, start_handle);
+			little_endian_store_16(att_request, 3, 0xffff);
+			little_endian_store_16(att_request, 5, group_types[i]);
+			responses_len += att_handle_request(att_connection, att_request, 7, &responses[responses_len]);
+		}
+		for (i = 0; i < 3; i++){
+			att_request[0] = ATT_READ_BY_TYPE_REQUEST;
+			little_endian_store_16(att_request, 1, start_handle);
+			little_endian_store_16(att_request, 3, 0xffff);
+			little_endian_store_16(att_request, 5, attribute_types[i]);
+			responses_len += att_handle_request(att_connection, att_request, 7, &responses[responses_len]);
+		}
+		att_request[0] = ATT_FIND_BY_TYPE_VALUE_REQUEST;
+		little_endian_store_16(att_request, 1, start_handle);
+		little_endian_store_16(att_request, 3, 0xffff);
+		little_endian_store_16(att_request, 5, GATT_PRIMARY_SERVICE_UUID);
+		little_endian_store_16(att_request, 7, ORG_BLUETOOTH_SERVICE_HEART_RATE);
+		responses_len += att_handle_request(att_connection, att_request, 9, &responses[responses_len]);
+		att_request[0] = ATT_FIND_INFORMATION_REQUEST;
+		little_endian_store_16(att_request, 1, start_handle);
+		little_endian_store_16(att_request, 3, start_handle + 5);
+		responses_len += att_handle_request(att_connection, att_request, 5, &responses[responses_len]);
+		att_request[0] = ATT_READ_REQUEST;
+		little_endian_store_16(att_request, 1, start_handle);
+		responses_len += att_handle_request(att_connection, att_request, 3, &responses[responses_len]);
+	}
+	return responses_len;
+}
+
+TEST(AttDb, index_from_compile_gatt){
+	static uint8_t expected_responses[0x60 * 8 * ATT_DEFAULT_MTU];
+	static uint8_t responses[0x60 * 8 * ATT_DEFAULT_MTU];
+
+	// ATT DB exceeds ATT_DB_INDEX_MAX_ATTRIBUTES, att_db uses linear search
+	att_set_db(profile_data);
+	uint16_t expected_responses_len = att_db_index_collect_responses(&att_connection, expected_responses);
+
+	att_set_db_index(profile_data_index);
+	uint16_t responses_len = att_db_index_collect_responses(&att_connection, responses);
+	CHECK_EQUAL(expected_responses_len, responses_len);
+	MEMCMP_EQUAL(expected_responses, responses, responses_len);
+}
+
+TEST(AttDb, index_from_compile_gatt_for_other_db){
+	// index does not match ATT DB set in setup
+	att_set_db_index(profile_data_index);
+	CHECK_EQUAL(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL, att_uuid_for_handle(0x0003));
+}
+#endif
 
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
@@ -123,6 +123,60 @@ TEST(MemoryPool, CreateAndFree){
     CHECK(next_node == NULL);
 }
 
+TEST_GROUP(TrackedMemoryPool){
+    test_pdu_t pdu_storage[MAX_NUM_PDUS];
+    uint8_t pdu_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(MAX_NUM_PDUS)];
+    btstack_memory_tracked_pool_t pdu_pool;
+
+    void setup(void){
+        int i;
+        for (i = 0; i < MAX_NUM_PDUS; i++){
+            pdu_storage[i].value = i;
+        }
+    }
+};
+
+TEST(TrackedMemoryPool, CreateAndGetZero){
+    btstack_memory_tracked_pool_create(&pdu_pool, pdu_storage, 0, sizeof(test_pdu_t), pdu_bitmap);
+    test_pdu_t * node = (test_pdu_t *) btstack_memory_tracked_pool_get(&pdu_pool);
+    CHECK(node == NULL);
+    CHECK_EQUAL(0, btstack_memory_tracked_pool_num_in_use(&pdu_pool));
+}
+
+TEST(TrackedMemoryPool, GetAll){
+    btstack_memory_tracked_pool_create(&pdu_pool, pdu_storage, MAX_NUM_PDUS, sizeof(test_pdu_t), pdu_bitmap);
+    int i;
+    for (i = 0; i < MAX_NUM_PDUS; i++){
+        test_pdu_t * node = (test_pdu_t *) btstack_memory_tracked_pool_get(&pdu_pool);
+        CHECK(node == &pdu_storage[i]);
+    }
+    CHECK(btstack_memory_tracked_pool_get(&pdu_pool) == NULL);
+    CHECK_EQUAL(MAX_NUM_PDUS, btstack_memory_tracked_pool_num_in_use(&pdu_pool));
+    CHECK_EQUAL(MAX_NUM_PDUS, btstack_memory_tracked_pool_max_in_use(&pdu_pool));
+}
+
+TEST(TrackedMemoryPool, UsageCounters){
+    btstack_memory_tracked_pool_create(&pdu_pool, pdu_storage, 3, sizeof(test_pdu_t), pdu_bitmap);
+
+    test_pdu_t * node_0 = (test_pdu_t *) btstack_memory_tracked_pool_get(&pdu_pool);
+    test_pdu_t * node_1 = (test_pdu_t *) btstack_memory_tracked_pool_get(&pdu_pool);
+    CHECK_EQUAL(2, btstack_memory_tracked_pool_num_in_use(&pdu_pool));
+    CHECK_EQUAL(2, btstack_memory_tracked_pool_max_in_use(&pdu_pool));
+
+    btstack_memory_tracked_pool_free(&pdu_pool, node_0);
+    CHECK_EQUAL(1, btstack_memory_tracked_pool_num_in_use(&pdu_pool));
+    CHECK_EQUAL(2, btstack_memory_tracked_pool_max_in_use(&pdu_pool));
+
+    // freed block is reused first
+    test_pdu_t * node = (test_pdu_t *) btstack_memory_tracked_pool_get(&pdu_pool);
+    CHECK(node == node_0);
+
+    btstack_memory_tracked_pool_free(&pdu_pool, node_1);
+    btstack_memory_tracked_pool_free(&pdu_pool, node);
+    CHECK_EQUAL(0, btstack_memory_tracked_pool_num_in_use(&pdu_pool));
+    CHECK_EQUAL(2, btstack_memory_tracked_pool_max_in_use(&pdu_pool));
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
@@ -1444,6 +1444,51 @@ TEST(btstack_memory, hci_iso_stream_NotEnoughBuffers){
 }
 
 
+#endif
+#ifdef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+
+
+TEST(btstack_memory, gatt_client_discovery_cache_GetAndFree){
+    gatt_client_discovery_cache_t * context;
+#ifdef HAVE_MALLOC
+    context = btstack_memory_gatt_client_discovery_cache_get();
+    CHECK(context != NULL);
+    btstack_memory_gatt_client_discovery_cache_free(context);
+#else
+#ifdef MAX_NR_GATT_CLIENT_DISCOVERY_CACHES
+    // single
+    context = btstack_memory_gatt_client_discovery_cache_get();
+    CHECK(context != NULL);
+    btstack_memory_gatt_client_discovery_cache_free(context);
+#else
+    // none
+    context = btstack_memory_gatt_client_discovery_cache_get();
+    CHECK(context == NULL);
+    btstack_memory_gatt_client_discovery_cache_free(context);
+#endif
+#endif
+}
+
+TEST(btstack_memory, gatt_client_discovery_cache_NotEnoughBuffers){
+    gatt_client_discovery_cache_t * context;
+#ifdef HAVE_MALLOC
+    btstack_memory_simulate_malloc_failure(true);
+#else
+#ifdef MAX_NR_GATT_CLIENT_DISCOVERY_CACHES
+    int i;
+    // alloc all static buffers
+    for (i = 0; i < MAX_NR_GATT_CLIENT_DISCOVERY_CACHES; i++){
+        context = btstack_memory_gatt_client_discovery_cache_get();
+        CHECK(context != NULL);
+    }
+#endif
+#endif
+    // get one more
+    context = btstack_memory_gatt_client_discovery_cache_get();
+    CHECK(context == NULL);
+}
+
+
 #endif
 
 int main (int argc, const char * argv[]){
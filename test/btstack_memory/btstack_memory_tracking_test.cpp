@@ -0,0 +1,120 @@
+// *****************************************************************************
+//
+// btstack_memory with ENABLE_MEMORY_POOL_TRACKING tests
+//
+// *****************************************************************************
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "btstack_config.h"
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_memory.h"
+#include "btstack_util.h"
+#include "hci_dump.h"
+
+static int num_failed_asserts;
+static std::vector<std::string> log_messages;
+
+// btstack_assert is mapped to test_assert with UNIT_TEST_ASSERT
+extern "C" void test_assert(bool condition){
+    if (condition == false){
+        num_failed_asserts++;
+    }
+}
+
+static void test_log_packet(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len){
+    UNUSED(packet_type);
+    UNUSED(in);
+    UNUSED(packet);
+    UNUSED(len);
+}
+
+static void test_log_message(int log_level, const char * format, va_list argptr){
+    UNUSED(log_level);
+    char message[200];
+    vsnprintf(message, sizeof(message), format, argptr);
+    log_messages.push_back(message);
+}
+
+static const hci_dump_t hci_dump_test_instance = {
+    // void (*reset)(void);
+    NULL,
+    // void (*log_packet)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len);
+    &test_log_packet,
+    // void (*log_message)(int log_level, const char * format, va_list argptr);
+    &test_log_message,
+    // void (*snapshot)(void);
+    NULL,
+    // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+    NULL,
+};
+
+static bool log_contains(const char * text){
+    for (const std::string & message : log_messages){
+        if (message.find(text) != std::string::npos) return true;
+    }
+    return false;
+}
+
+TEST_GROUP(btstack_memory_tracking){
+    void setup(void){
+        num_failed_asserts = 0;
+        log_messages.clear();
+        hci_dump_init(&hci_dump_test_instance);
+        btstack_memory_init();
+    }
+    void teardown(void){
+        hci_dump_init(NULL);
+    }
+};
+
+TEST(btstack_memory_tracking, DoubleFreeDetected){
+    hci_connection_t * connection = btstack_memory_hci_connection_get();
+    CHECK(connection != NULL);
+    btstack_memory_hci_connection_free(connection);
+    CHECK_EQUAL(0, num_failed_asserts);
+    btstack_memory_hci_connection_free(connection);
+    CHECK_EQUAL(1, num_failed_asserts);
+    CHECK(log_contains("free of invalid or unused block"));
+
+    // block only returned once to the pool
+    CHECK(btstack_memory_hci_connection_get() == connection);
+    CHECK(btstack_memory_hci_connection_get() == NULL);
+}
+
+TEST(btstack_memory_tracking, FreeOfForeignBlockDetected){
+    hci_connection_t connection;
+    btstack_memory_hci_connection_free(&connection);
+    CHECK_EQUAL(1, num_failed_asserts);
+    CHECK(btstack_memory_hci_connection_get() != NULL);
+    CHECK(btstack_memory_hci_connection_get() == NULL);
+}
+
+TEST(btstack_memory_tracking, DumpStats){
+    hci_connection_t * connection = btstack_memory_hci_connection_get();
+    CHECK(connection != NULL);
+    btstack_memory_dump_stats();
+    CHECK(log_contains("hci_connection                   in use   1, max   1, pool size   1"));
+    CHECK(log_contains("l2cap_channel                    in use   0, max   0, pool size   1"));
+
+    // max kept after free
+    log_messages.clear();
+    btstack_memory_hci_connection_free(connection);
+    btstack_memory_dump_stats();
+    CHECK(log_contains("hci_connection                   in use   0, max   1, pool size   1"));
+    CHECK_EQUAL(0, num_failed_asserts);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -13,6 +13,8 @@
 // BTstack features that can be enabled
 #define ENABLE_BLE
 #define ENABLE_CLASSIC
+#define ENABLE_GATT_CLIENT_CACHING
+#define ENABLE_GATT_CLIENT_DISCOVERY_CACHE
 #define ENABLE_LOG_ERROR
 #define ENABLE_LOG_INFO
 #define ENABLE_PRINTF_HEXDUMP
@@ -30,6 +32,7 @@
 #define MAX_NR_BNEP_SERVICES 1
 #define MAX_NR_BTSTACK_LINK_KEY_DB_MEMORY_ENTRIES 1
 #define MAX_NR_GATT_CLIENTS 1
+#define MAX_NR_GATT_CLIENT_DISCOVERY_CACHES 1
 #define MAX_NR_HCI_CONNECTIONS 1
 #define MAX_NR_HFP_CONNECTIONS 1
 #define MAX_NR_L2CAP_CHANNELS 1
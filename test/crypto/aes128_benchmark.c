@@ -0,0 +1,82 @@
+// Benchmark for software AES128 in btstack_crypto
+//
+// Compares rijndael tables against AES instructions (x86 AES-NI, ARMv8 Crypto Extension) if available (make benchmark)
+
+#define _POSIX_C_SOURCE 200809
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "btstack_crypto.h"
+#include "btstack_util.h"
+
+#define NUM_BLOCKS 1000000
+#define NUM_KEYS   16
+
+static uint8_t keys[NUM_KEYS][16];
+static uint8_t message[64];
+static btstack_crypto_aes128_cmac_t cmac_request;
+static uint8_t cmac_hash[16];
+
+static uint64_t get_time_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000u) + ((uint64_t) ts.tv_nsec / 1000u);
+}
+
+static void cmac_done(void * arg){
+    UNUSED(arg);
+}
+
+static void benchmark(const char * name){
+    uint8_t block[16];
+    uint32_t i;
+    memset(block, 0, sizeof(block));
+
+    // same key, e.g. CMAC/CCM over multiple blocks
+    uint64_t start_us = get_time_us();
+    for (i = 0; i < NUM_BLOCKS; i++){
+        btstack_aes128_calc(keys[0], block, block);
+    }
+    uint64_t same_key_us = get_time_us() - start_us;
+
+    // new key for each block, e.g. address resolution against multiple IRKs
+    start_us = get_time_us();
+    for (i = 0; i < NUM_BLOCKS; i++){
+        btstack_aes128_calc(keys[i % NUM_KEYS], block, block);
+    }
+    uint64_t key_change_us = get_time_us() - start_us;
+
+    // CMAC over 64 bytes
+    start_us = get_time_us();
+    for (i = 0; i < (NUM_BLOCKS / 10); i++){
+        btstack_crypto_aes128_cmac_message(&cmac_request, keys[0], sizeof(message), message, cmac_hash, &cmac_done, NULL);
+    }
+    uint64_t cmac_us = get_time_us() - start_us;
+
+    printf("%-12s: %u blocks same key %8u us, key change %8u us, %u CMAC(64) %8u us - %02x\n", name, NUM_BLOCKS,
+           (unsigned int) same_key_us, (unsigned int) key_change_us, NUM_BLOCKS / 10, (unsigned int) cmac_us, block[0]);
+}
+
+int main(void){
+    uint32_t i;
+    for (i = 0; i < sizeof(keys); i++){
+        keys[i / 16][i % 16] = (uint8_t) (i * 7u);
+    }
+    for (i = 0; i < sizeof(message); i++){
+        message[i] = (uint8_t) i;
+    }
+    btstack_crypto_init();
+
+    btstack_aes128_instructions_enable(false);
+    benchmark("rijndael");
+    btstack_aes128_instructions_enable(true);
+    if (btstack_aes128_instructions_active()){
+        benchmark("instructions");
+    } else {
+        printf("AES instructions not available\n");
+    }
+    return 0;
+}
@@ -138,6 +138,178 @@ TEST(AES_CMAC,CMAC_40){
     CHECK_EQUAL_ARRAY(cmac, cmac_calculated, 16);
 }
 
+TEST(AES_CMAC,CMAC_SYNC){
+    uint8_t k[16];
+    uint8_t cmac[16];
+    uint8_t m[40];
+    parse_hex(k, key_string);
+    parse_hex(m, example_40_string);
+    parse_hex(cmac, cmac_0_string);
+    btstack_crypto_aes128_cmac_message_sync(k, 0, NULL, cmac_calculated);
+    CHECK_EQUAL_ARRAY(cmac, cmac_calculated, 16);
+    parse_hex(cmac, cmac_16_string);
+    btstack_crypto_aes128_cmac_message_sync(k, 16, m, cmac_calculated);
+    CHECK_EQUAL_ARRAY(cmac, cmac_calculated, 16);
+    parse_hex(cmac, cmac_40_string);
+    btstack_crypto_aes128_cmac_message_sync(k, 40, m, cmac_calculated);
+    CHECK_EQUAL_ARRAY(cmac, cmac_calculated, 16);
+}
+
+static uint8_t cmac_generator_message[40];
+static uint8_t cmac_generator_get_byte(uint16_t pos){
+    return cmac_generator_message[pos];
+}
+
+TEST(AES_CMAC,CMAC_GENERATOR_SYNC){
+    uint8_t k[16];
+    uint8_t cmac[16];
+    parse_hex(k, key_string);
+    parse_hex(cmac_generator_message, example_40_string);
+    parse_hex(cmac, cmac_40_string);
+    btstack_crypto_aes128_cmac_generator_sync(k, 40, &cmac_generator_get_byte, cmac_calculated);
+    CHECK_EQUAL_ARRAY(cmac, cmac_calculated, 16);
+}
+
+// Mesh Profile Sample Data, Message #24
+static const char ccm_label_uuid_string[] = "f4a002c7 fb1e4ca0 a469a021 de0db875";
+static const char ccm_app_key_string[]    = "63964771 734fbd76 e3b40519 d1d94a48";
+static const char ccm_app_nonce_string[]  = "01800708 0d123497 36123456 77";
+static const char ccm_plaintext_string[]  = "ea0a0057 6f726c64";
+static const char ccm_ciphertext_string[] = "c3c51d8e 476b28e3";
+
+static void ccm_done(void * arg){
+    UNUSED(arg);
+}
+
+TEST_GROUP(CCM){
+};
+
+TEST(CCM,EncryptDecryptSync){
+    uint8_t label_uuid[16];
+    uint8_t key[16];
+    uint8_t nonce[13];
+    uint8_t plaintext[8];
+    uint8_t ciphertext[8];
+    uint8_t buffer[8];
+    uint8_t mic[8];
+    uint8_t mic_sync[8];
+    parse_hex(label_uuid, ccm_label_uuid_string);
+    parse_hex(key, ccm_app_key_string);
+    parse_hex(nonce, ccm_app_nonce_string);
+    parse_hex(plaintext, ccm_plaintext_string);
+    parse_hex(ciphertext, ccm_ciphertext_string);
+
+    // reference using btstack_crypto_ccm request
+    btstack_crypto_ccm_t request;
+    btstack_crypto_ccm_init(&request, key, nonce, sizeof(plaintext), sizeof(label_uuid), sizeof(mic));
+    btstack_crypto_ccm_digest(&request, label_uuid, sizeof(label_uuid), &ccm_done, NULL);
+    btstack_crypto_ccm_encrypt_block(&request, sizeof(plaintext), plaintext, buffer, &ccm_done, NULL);
+    btstack_crypto_ccm_get_authentication_value(&request, mic);
+    CHECK_EQUAL_ARRAY(ciphertext, buffer, sizeof(ciphertext));
+
+    btstack_crypto_ccm_encrypt_sync(key, nonce, label_uuid, sizeof(label_uuid), plaintext, sizeof(plaintext), buffer, sizeof(mic_sync), mic_sync);
+    CHECK_EQUAL_ARRAY(ciphertext, buffer, sizeof(ciphertext));
+    CHECK_EQUAL_ARRAY(mic, mic_sync, sizeof(mic));
+
+    // decrypt in place
+    memset(mic_sync, 0, sizeof(mic_sync));
+    btstack_crypto_ccm_decrypt_sync(key, nonce, label_uuid, sizeof(label_uuid), buffer, sizeof(buffer), buffer, sizeof(mic_sync), mic_sync);
+    CHECK_EQUAL_ARRAY(plaintext, buffer, sizeof(plaintext));
+    CHECK_EQUAL_ARRAY(mic, mic_sync, sizeof(mic));
+}
+
+TEST(CCM,MultipleBlocksSync){
+    uint8_t key[16];
+    uint8_t nonce[13];
+    uint8_t aad[20];
+    uint8_t plaintext[45];
+    uint8_t ciphertext[45];
+    uint8_t buffer[45];
+    uint8_t mic[4];
+    uint8_t mic_sync[4];
+    uint16_t i;
+    parse_hex(key, ccm_app_key_string);
+    parse_hex(nonce, ccm_app_nonce_string);
+    for (i = 0; i < sizeof(aad); i++){
+        aad[i] = (uint8_t) (0xa0 + i);
+    }
+    for (i = 0; i < sizeof(plaintext); i++){
+        plaintext[i] = (uint8_t) i;
+    }
+
+    btstack_crypto_ccm_t request;
+    btstack_crypto_ccm_init(&request, key, nonce, sizeof(plaintext), sizeof(aad), sizeof(mic));
+    btstack_crypto_ccm_digest(&request, aad, sizeof(aad), &ccm_done, NULL);
+    btstack_crypto_ccm_encrypt_block(&request, 16, &plaintext[0], &ciphertext[0], &ccm_done, NULL);
+    btstack_crypto_ccm_encrypt_block(&request, sizeof(plaintext) - 16, &plaintext[16], &ciphertext[16], &ccm_done, NULL);
+    btstack_crypto_ccm_get_authentication_value(&request, mic);
+
+    // encrypt in place
+    memcpy(buffer, plaintext, sizeof(plaintext));
+    btstack_crypto_ccm_encrypt_sync(key, nonce, aad, sizeof(aad), buffer, sizeof(buffer), buffer, sizeof(mic_sync), mic_sync);
+    CHECK_EQUAL_ARRAY(ciphertext, buffer, sizeof(ciphertext));
+    CHECK_EQUAL_ARRAY(mic, mic_sync, sizeof(mic));
+
+    btstack_crypto_ccm_decrypt_sync(key, nonce, aad, sizeof(aad), ciphertext, sizeof(ciphertext), buffer, sizeof(mic_sync), mic_sync);
+    CHECK_EQUAL_ARRAY(plaintext, buffer, sizeof(plaintext));
+    CHECK_EQUAL_ARRAY(mic, mic_sync, sizeof(mic));
+}
+
+TEST_GROUP(AES128){
+    void teardown(void){
+        btstack_aes128_instructions_enable(true);
+    }
+};
+
+// FIPS-197 Appendix C.1
+static const char aes128_key_string[]        = "00010203 04050607 08090a0b 0c0d0e0f";
+static const char aes128_plaintext_string[]  = "00112233 44556677 8899aabb ccddeeff";
+static const char aes128_ciphertext_string[] = "69c4e0d8 6a7b0430 d8cdb780 70b4c55a";
+
+TEST(AES128,FIPS197){
+    uint8_t k[16];
+    uint8_t plaintext[16];
+    uint8_t ciphertext[16];
+    uint8_t calculated[16];
+    parse_hex(k, aes128_key_string);
+    parse_hex(plaintext, aes128_plaintext_string);
+    parse_hex(ciphertext, aes128_ciphertext_string);
+    btstack_aes128_calc(k, plaintext, calculated);
+    CHECK_EQUAL_ARRAY(ciphertext, calculated, 16);
+    btstack_aes128_instructions_enable(false);
+    CHECK_FALSE(btstack_aes128_instructions_active());
+    btstack_aes128_calc(k, plaintext, calculated);
+    CHECK_EQUAL_ARRAY(ciphertext, calculated, 16);
+}
+
+TEST(AES128,InstructionsMatchRijndael){
+    printf("AES128 instructions active: %u\n", btstack_aes128_instructions_active());
+    uint8_t k[16];
+    uint8_t plaintext[16];
+    uint8_t expected[16];
+    uint8_t calculated[16];
+    uint32_t seed = 0x4711;
+    int i;
+    for (i = 0; i < 100; i++){
+        int j;
+        for (j = 0; j < 16; j++){
+            seed = seed * 1103515245u + 12345u;
+            // change key every fourth block to exercise key schedule cache
+            if ((i & 3) == 0){
+                k[j] = (uint8_t) (seed >> 16);
+            }
+            plaintext[j] = (uint8_t) (seed >> 8);
+        }
+        btstack_aes128_instructions_enable(false);
+        btstack_aes128_calc(k, plaintext, expected);
+        btstack_aes128_instructions_enable(true);
+        btstack_aes128_calc(k, plaintext, calculated);
+        CHECK_EQUAL_ARRAY(expected, calculated, 16);
+        btstack_aes128_calc(k, plaintext, calculated);
+        CHECK_EQUAL_ARRAY(expected, calculated, 16);
+    }
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
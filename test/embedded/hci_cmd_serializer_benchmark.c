@@ -0,0 +1,104 @@
+// Benchmark for creating HCI commands with hci_cmd_create_from_template and generated serializers
+//
+// Creates frequently sent commands with both variants (make benchmark) and reports time per command
+
+#define _POSIX_C_SOURCE 200809
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hci_cmd.h"
+#include "hci_cmd_serializer.h"
+#include "btstack_util.h"
+
+#define NUM_COMMANDS 10000000u
+
+static uint8_t hci_cmd_buffer[3 + 255];
+static uint8_t adv_data[LE_EXTENDED_ADVERTISING_MAX_CHUNK_LEN];
+static uint32_t checksum;
+
+// not compiled in without ENABLE_HCI_CONTROLLER_TO_HOST_FLOW_CONTROL
+static const hci_cmd_t cmd_host_number_of_completed_packets = {HCI_OPCODE_HCI_HOST_NUMBER_OF_COMPLETED_PACKETS, "1H2"};
+
+static uint64_t get_time_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec;
+}
+
+// same path as hci_send_cmd
+static uint16_t create_from_template(const hci_cmd_t * cmd, ...){
+    va_list argptr;
+    va_start(argptr, cmd);
+    uint16_t size = hci_cmd_create_from_template(hci_cmd_buffer, cmd, argptr);
+    va_end(argptr);
+    return size;
+}
+
+static void report(const char * name, uint64_t template_ns, uint64_t serializer_ns){
+    printf("%-40s template %5.1f ns, serializer %5.1f ns per command\n", name,
+           (double) template_ns / NUM_COMMANDS, (double) serializer_ns / NUM_COMMANDS);
+}
+
+static void benchmark_le_set_data_length(void){
+    uint32_t i;
+    uint64_t start_ns = get_time_ns();
+    for (i = 0; i < NUM_COMMANDS; i++){
+        checksum += create_from_template(&hci_le_set_data_length, (hci_con_handle_t) (i & 0x0fff), 251, 2120);
+        checksum += hci_cmd_buffer[3];
+    }
+    uint64_t template_ns = get_time_ns() - start_ns;
+    start_ns = get_time_ns();
+    for (i = 0; i < NUM_COMMANDS; i++){
+        checksum += hci_cmd_serialize_le_set_data_length(hci_cmd_buffer, (hci_con_handle_t) (i & 0x0fff), 251, 2120);
+        checksum += hci_cmd_buffer[3];
+    }
+    report("hci_le_set_data_length", template_ns, get_time_ns() - start_ns);
+}
+
+static void benchmark_le_set_extended_advertising_data(uint8_t data_len){
+    uint32_t i;
+    uint64_t start_ns = get_time_ns();
+    for (i = 0; i < NUM_COMMANDS; i++){
+        checksum += create_from_template(&hci_le_set_extended_advertising_data, (uint8_t) i, 0x03, 0x01, data_len, adv_data);
+        checksum += hci_cmd_buffer[3];
+    }
+    uint64_t template_ns = get_time_ns() - start_ns;
+    start_ns = get_time_ns();
+    for (i = 0; i < NUM_COMMANDS; i++){
+        checksum += hci_cmd_serialize_le_set_extended_advertising_data(hci_cmd_buffer, (uint8_t) i, 0x03, 0x01, data_len, adv_data);
+        checksum += hci_cmd_buffer[3];
+    }
+    char name[50];
+    snprintf(name, sizeof(name), "hci_le_set_extended_advertising_data %3u", data_len);
+    report(name, template_ns, get_time_ns() - start_ns);
+}
+
+static void benchmark_host_number_of_completed_packets(void){
+    uint32_t i;
+    uint64_t start_ns = get_time_ns();
+    for (i = 0; i < NUM_COMMANDS; i++){
+        checksum += create_from_template(&cmd_host_number_of_completed_packets, 1, (hci_con_handle_t) (i & 0x0fff), 1);
+        checksum += hci_cmd_buffer[4];
+    }
+    uint64_t template_ns = get_time_ns() - start_ns;
+    start_ns = get_time_ns();
+    for (i = 0; i < NUM_COMMANDS; i++){
+        checksum += hci_cmd_serialize_host_number_of_completed_packets(hci_cmd_buffer, 1, (hci_con_handle_t) (i & 0x0fff), 1);
+        checksum += hci_cmd_buffer[4];
+    }
+    report("hci_host_number_of_completed_packets", template_ns, get_time_ns() - start_ns);
+}
+
+int main(void){
+    memset(adv_data, 0x55, sizeof(adv_data));
+    benchmark_le_set_data_length();
+    benchmark_le_set_extended_advertising_data(31);
+    benchmark_le_set_extended_advertising_data(LE_EXTENDED_ADVERTISING_MAX_CHUNK_LEN);
+    benchmark_host_number_of_completed_packets();
+    printf("checksum %08x\n", (unsigned int) checksum);
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include "CppUTest/CommandLineTestRunner.h"
 
 #include "hci_cmd.h"
+#include "hci_cmd_serializer.h"
 #include "btstack_util.h"
 
 static uint8_t hci_cmd_buffer[350];
@@ -235,6 +236,91 @@ TEST(HCI_Command, format_INVALID){
     CHECK_EQUAL(expected_size, size);
 }
 
+// serializers have to match hci_cmd_create_from_template
+static void check_serializer(const uint8_t * serializer_buffer, uint16_t serializer_size, const hci_cmd_t * cmd, ...){
+    memset(hci_cmd_buffer, 0, sizeof(hci_cmd_buffer));
+    va_list argptr;
+    va_start(argptr, cmd);
+    uint16_t template_size = hci_cmd_create_from_template(hci_cmd_buffer, cmd, argptr);
+    va_end(argptr);
+    CHECK_EQUAL(template_size, serializer_size);
+    MEMCMP_EQUAL(hci_cmd_buffer, serializer_buffer, template_size);
+}
+
+// commands not available in this configuration
+const hci_cmd_t cmd_write_local_name = {HCI_OPCODE_HCI_WRITE_LOCAL_NAME, "N"};
+const hci_cmd_t cmd_host_number_of_completed_packets = {HCI_OPCODE_HCI_HOST_NUMBER_OF_COMPLETED_PACKETS, "1H2"};
+
+TEST_GROUP(HCI_Command_Serializer){
+    uint8_t serializer_buffer[350];
+    uint8_t data[350];
+    void setup(void){
+        uint16_t i;
+        for (i = 0; i < sizeof(data); i++){
+            data[i] = (uint8_t) (i + 1);
+        }
+        memset(serializer_buffer, 0, sizeof(serializer_buffer));
+    }
+};
+
+TEST(HCI_Command_Serializer, format_H22){
+    uint16_t size = hci_cmd_serialize_le_set_data_length(serializer_buffer, 0x0123, 251, 2120);
+    check_serializer(serializer_buffer, size, &hci_le_set_data_length, 0x0123, 251, 2120);
+}
+
+TEST(HCI_Command_Serializer, format_1H2){
+    uint16_t size = hci_cmd_serialize_host_number_of_completed_packets(serializer_buffer, 1, 0x0040, 0x1234);
+    check_serializer(serializer_buffer, size, &cmd_host_number_of_completed_packets, 1, 0x0040, 0x1234);
+}
+
+TEST(HCI_Command_Serializer, format_111JV){
+    uint16_t size = hci_cmd_serialize_le_set_extended_advertising_data(serializer_buffer, 1, 3, 1, 251, data);
+    CHECK_EQUAL(3 + 4 + 251, size);
+    check_serializer(serializer_buffer, size, &hci_le_set_extended_advertising_data, 1, 3, 1, 251, data);
+    size = hci_cmd_serialize_le_set_extended_advertising_data(serializer_buffer, 1, 3, 1, 0, NULL);
+    check_serializer(serializer_buffer, size, &hci_le_set_extended_advertising_data, 1, 3, 1, 0, NULL);
+}
+
+TEST(HCI_Command_Serializer, format_1A){
+    uint16_t size = hci_cmd_serialize_le_set_advertising_data(serializer_buffer, 31, data);
+    check_serializer(serializer_buffer, size, &hci_le_set_advertising_data, 31, data);
+}
+
+TEST(HCI_Command_Serializer, format_311){
+    uint16_t size = hci_cmd_serialize_inquiry(serializer_buffer, 0x9E8B33, 10, 0);
+    check_serializer(serializer_buffer, size, &hci_inquiry, 0x9E8B33, 10, 0);
+}
+
+TEST(HCI_Command_Serializer, format_BKK){
+    bd_addr_t address = { 1, 2, 3, 4, 5, 6};
+    uint16_t size = hci_cmd_serialize_remote_oob_data_request_reply(serializer_buffer, address, &data[0], &data[16]);
+    check_serializer(serializer_buffer, size, &hci_remote_oob_data_request_reply, address, &data[0], &data[16]);
+}
+
+TEST(HCI_Command_Serializer, format_H442P){
+    uint16_t size = hci_cmd_serialize_le_start_encryption(serializer_buffer, 0x0001, 0x01020304, 0x05060708, 0x1234, data);
+    check_serializer(serializer_buffer, size, &hci_le_start_encryption, 0x0001, 0x01020304, 0x05060708, 0x1234, data);
+}
+
+TEST(HCI_Command_Serializer, format_1E){
+    uint16_t size = hci_cmd_serialize_write_extended_inquiry_response(serializer_buffer, 0, data);
+    check_serializer(serializer_buffer, size, &hci_write_extended_inquiry_response, 0, data);
+}
+
+TEST(HCI_Command_Serializer, format_QQ){
+    uint16_t size = hci_cmd_serialize_le_generate_dhkey(serializer_buffer, &data[0], &data[32]);
+    check_serializer(serializer_buffer, size, &hci_le_generate_dhkey, &data[0], &data[32]);
+}
+
+TEST(HCI_Command_Serializer, format_N){
+    uint16_t size = hci_cmd_serialize_write_local_name(serializer_buffer, "BTstack 00:00:00:00:00:00");
+    check_serializer(serializer_buffer, size, &cmd_write_local_name, "BTstack 00:00:00:00:00:00");
+    memset(data, 'A', sizeof(data));
+    data[sizeof(data) - 1] = 0;
+    size = hci_cmd_serialize_write_local_name(serializer_buffer, (const char *) data);
+    check_serializer(serializer_buffer, size, &cmd_write_local_name, data);
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
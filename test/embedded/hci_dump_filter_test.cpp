@@ -0,0 +1,353 @@
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "hci_dump.h"
+#include "bluetooth_psm.h"
+#include "btstack_util.h"
+#include "l2cap_signaling.h"
+
+#include <string.h>
+
+#define TEST_CON_HANDLE 0x0040
+
+typedef struct {
+    uint8_t  packet_type;
+    uint8_t  in;
+    uint16_t len;
+    uint16_t original_len;
+} logged_packet_t;
+
+static logged_packet_t logged_packets[16];
+static int logged_packet_count;
+
+static void test_log_packet(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len){
+    UNUSED(packet);
+    CHECK_TRUE(logged_packet_count < (int)(sizeof(logged_packets) / sizeof(logged_packets[0])));
+    logged_packets[logged_packet_count].packet_type = packet_type;
+    logged_packets[logged_packet_count].in = in;
+    logged_packets[logged_packet_count].len = len;
+    logged_packets[logged_packet_count].original_len = len;
+    logged_packet_count++;
+}
+
+static void test_log_packet_truncated(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len){
+    test_log_packet(packet_type, in, packet, len);
+    logged_packets[logged_packet_count - 1].original_len = original_len;
+}
+
+static void test_log_message(int log_level, const char * format, va_list argptr){
+    UNUSED(log_level);
+    UNUSED(format);
+    UNUSED(argptr);
+}
+
+static const hci_dump_t hci_dump_test_instance = {
+    // void (*reset)(void);
+    NULL,
+    // void (*log_packet)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len);
+    &test_log_packet,
+    // void (*log_message)(int log_level, const char * format, va_list argptr);
+    &test_log_message,
+    // void (*snapshot)(void);
+    NULL,
+    // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+    NULL,
+};
+
+static const hci_dump_t hci_dump_test_truncated_instance = {
+    // void (*reset)(void);
+    NULL,
+    // void (*log_packet)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len);
+    &test_log_packet,
+    // void (*log_message)(int log_level, const char * format, va_list argptr);
+    &test_log_message,
+    // void (*snapshot)(void);
+    NULL,
+    // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+    &test_log_packet_truncated,
+};
+
+// returns logged length or 0 if dropped
+static uint16_t dump_packet(uint8_t packet_type, uint8_t in, uint8_t * packet, uint16_t len){
+    int count = logged_packet_count;
+    hci_dump_packet(packet_type, in, packet, len);
+    if (logged_packet_count == count) return 0;
+    return logged_packets[count].len;
+}
+
+static uint16_t dump_l2cap(uint8_t in, uint8_t pb, uint16_t cid, const uint8_t * payload, uint16_t payload_len){
+    uint8_t packet[100];
+    little_endian_store_16(packet, 0, TEST_CON_HANDLE | (pb << 12));
+    little_endian_store_16(packet, 2, 4 + payload_len);
+    little_endian_store_16(packet, 4, payload_len);
+    little_endian_store_16(packet, 6, cid);
+    memcpy(&packet[8], payload, payload_len);
+    return dump_packet(HCI_ACL_DATA_PACKET, in, packet, 8 + payload_len);
+}
+
+static uint16_t dump_l2cap_data(uint8_t in, uint16_t cid, uint16_t payload_len){
+    uint8_t payload[90];
+    memset(payload, 0x55, sizeof(payload));
+    return dump_l2cap(in, 0x02, cid, payload, payload_len);
+}
+
+static void dump_signaling(uint8_t in, uint16_t cid, uint8_t code, uint8_t identifier, const uint8_t * data, uint16_t data_len){
+    uint8_t command[40];
+    command[0] = code;
+    command[1] = identifier;
+    little_endian_store_16(command, 2, data_len);
+    memcpy(&command[4], data, data_len);
+    dump_l2cap(in, 0x02, cid, command, 4 + data_len);
+}
+
+TEST_GROUP(hci_dump_filter){
+    hci_dump_filter_t filters[3];
+    void setup(void){
+        memset(filters, 0, sizeof(filters));
+        logged_packet_count = 0;
+        hci_dump_init(&hci_dump_test_instance);
+        hci_dump_filter_set_default_snaplen(HCI_DUMP_SNAPLEN_UNLIMITED);
+    }
+    void teardown(void){
+        unsigned int i;
+        for (i = 0; i < sizeof(filters) / sizeof(filters[0]); i++){
+            hci_dump_filter_remove(&filters[i]);
+        }
+        hci_dump_init(NULL);
+    }
+    // outgoing classic connection request for psm, accepted by remote
+    void open_classic_channel(uint16_t psm, uint16_t local_cid, uint16_t remote_cid, uint8_t identifier){
+        uint8_t request[4];
+        little_endian_store_16(request, 0, psm);
+        little_endian_store_16(request, 2, local_cid);
+        dump_signaling(0, L2CAP_CID_SIGNALING, CONNECTION_REQUEST, identifier, request, sizeof(request));
+        uint8_t response[8] = { 0 };
+        little_endian_store_16(response, 0, remote_cid);
+        little_endian_store_16(response, 2, local_cid);
+        dump_signaling(1, L2CAP_CID_SIGNALING, CONNECTION_RESPONSE, identifier, response, sizeof(response));
+    }
+};
+
+TEST(hci_dump_filter, NoFilterLogsCompletePackets){
+    CHECK_EQUAL(50, dump_l2cap_data(1, 0x0041, 42));
+}
+
+TEST(hci_dump_filter, DropByPacketType){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_PACKET_TYPE;
+    filters[0].packet_type = HCI_SCO_DATA_PACKET;
+    filters[0].snaplen = 0;
+    hci_dump_filter_add(&filters[0]);
+
+    uint8_t sco[63] = { 0x40, 0x00, 60 };
+    CHECK_EQUAL(0, dump_packet(HCI_SCO_DATA_PACKET, 1, sco, sizeof(sco)));
+    CHECK_EQUAL(50, dump_l2cap_data(1, 0x0041, 42));
+}
+
+TEST(hci_dump_filter, TruncateByConHandle){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_PACKET_TYPE | HCI_DUMP_FILTER_MATCH_CON_HANDLE;
+    filters[0].packet_type = HCI_ISO_DATA_PACKET;
+    filters[0].con_handle = 0x0060;
+    filters[0].snaplen = 12;
+    hci_dump_filter_add(&filters[0]);
+
+    uint8_t iso[64] = { 0 };
+    little_endian_store_16(iso, 0, 0x0060);
+    CHECK_EQUAL(12, dump_packet(HCI_ISO_DATA_PACKET, 0, iso, sizeof(iso)));
+    little_endian_store_16(iso, 0, 0x0061);
+    CHECK_EQUAL(64, dump_packet(HCI_ISO_DATA_PACKET, 0, iso, sizeof(iso)));
+}
+
+TEST(hci_dump_filter, TruncatedPacketProvidesOriginalLength){
+    hci_dump_init(&hci_dump_test_truncated_instance);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_dump_filter_set_default_snaplen(20));
+    CHECK_EQUAL(20, dump_l2cap_data(1, 0x0041, 42));
+    CHECK_EQUAL(50, logged_packets[0].original_len);
+    // complete packets use log_packet
+    CHECK_EQUAL(10, dump_l2cap_data(1, 0x0041, 2));
+    CHECK_EQUAL(10, logged_packets[1].original_len);
+}
+
+TEST(hci_dump_filter, SnaplenShorterThanHeaderRejected){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_PACKET_TYPE;
+    filters[0].packet_type = HCI_ACL_DATA_PACKET;
+    filters[0].snaplen = 3;
+    CHECK_EQUAL(ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS, hci_dump_filter_add(&filters[0]));
+    filters[1].match = HCI_DUMP_FILTER_MATCH_EVENT_CODE;
+    filters[1].event_code = HCI_EVENT_COMMAND_COMPLETE;
+    filters[1].snaplen = 2;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_dump_filter_add(&filters[1]));
+    filters[2].match = HCI_DUMP_FILTER_MATCH_CON_HANDLE;
+    filters[2].con_handle = TEST_CON_HANDLE;
+    filters[2].snaplen = 0;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, hci_dump_filter_add(&filters[2]));
+    CHECK_EQUAL(ERROR_CODE_INVALID_HCI_COMMAND_PARAMETERS, hci_dump_filter_set_default_snaplen(1));
+
+    // rejected rule not used
+    CHECK_EQUAL(0, dump_l2cap_data(1, 0x0041, 42));
+    uint8_t command_complete[] = { HCI_EVENT_COMMAND_COMPLETE, 4, 1, 0x03, 0x0c, 0x00 };
+    CHECK_EQUAL(2, dump_packet(HCI_EVENT_PACKET, 1, command_complete, sizeof(command_complete)));
+}
+
+TEST(hci_dump_filter, DropByEventCode){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_EVENT_CODE;
+    filters[0].event_code = HCI_EVENT_NUMBER_OF_COMPLETED_PACKETS;
+    filters[0].snaplen = 0;
+    hci_dump_filter_add(&filters[0]);
+
+    uint8_t num_completed_packets[] = { HCI_EVENT_NUMBER_OF_COMPLETED_PACKETS, 5, 1, 0x40, 0x00, 0x01, 0x00 };
+    CHECK_EQUAL(0, dump_packet(HCI_EVENT_PACKET, 1, num_completed_packets, sizeof(num_completed_packets)));
+    uint8_t command_complete[] = { HCI_EVENT_COMMAND_COMPLETE, 4, 1, 0x03, 0x0c, 0x00 };
+    CHECK_EQUAL(6, dump_packet(HCI_EVENT_PACKET, 1, command_complete, sizeof(command_complete)));
+}
+
+TEST(hci_dump_filter, FirstMatchingRuleWins){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_EVENT_CODE;
+    filters[0].event_code = HCI_EVENT_COMMAND_COMPLETE;
+    filters[0].snaplen = HCI_DUMP_SNAPLEN_UNLIMITED;
+    hci_dump_filter_add(&filters[0]);
+    filters[1].match = HCI_DUMP_FILTER_MATCH_PACKET_TYPE;
+    filters[1].packet_type = HCI_EVENT_PACKET;
+    filters[1].snaplen = 3;
+    hci_dump_filter_add(&filters[1]);
+
+    uint8_t command_complete[] = { HCI_EVENT_COMMAND_COMPLETE, 4, 1, 0x03, 0x0c, 0x00 };
+    CHECK_EQUAL(6, dump_packet(HCI_EVENT_PACKET, 1, command_complete, sizeof(command_complete)));
+    uint8_t command_status[] = { HCI_EVENT_COMMAND_STATUS, 4, 0, 1, 0x05, 0x04 };
+    CHECK_EQUAL(3, dump_packet(HCI_EVENT_PACKET, 1, command_status, sizeof(command_status)));
+}
+
+TEST(hci_dump_filter, DefaultSnaplen){
+    hci_dump_filter_set_default_snaplen(20);
+    filters[0].match = HCI_DUMP_FILTER_MATCH_L2CAP_CID;
+    filters[0].l2cap_cid = L2CAP_CID_ATTRIBUTE_PROTOCOL;
+    filters[0].snaplen = HCI_DUMP_SNAPLEN_UNLIMITED;
+    hci_dump_filter_add(&filters[0]);
+
+    CHECK_EQUAL(50, dump_l2cap_data(1, L2CAP_CID_ATTRIBUTE_PROTOCOL, 42));
+    CHECK_EQUAL(20, dump_l2cap_data(1, 0x0041, 42));
+}
+
+TEST(hci_dump_filter, PsmOfClassicChannelInBothDirections){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_L2CAP_PSM;
+    filters[0].l2cap_psm = BLUETOOTH_PSM_AVDTP;
+    filters[0].snaplen = 16;
+    hci_dump_filter_add(&filters[0]);
+
+    open_classic_channel(BLUETOOTH_PSM_AVDTP, 0x0041, 0x0060, 1);
+    open_classic_channel(BLUETOOTH_PSM_RFCOMM, 0x0042, 0x0061, 2);
+
+    // incoming to local cid, outgoing to remote cid
+    CHECK_EQUAL(16, dump_l2cap_data(1, 0x0041, 42));
+    CHECK_EQUAL(16, dump_l2cap_data(0, 0x0060, 42));
+    CHECK_EQUAL(50, dump_l2cap_data(1, 0x0042, 42));
+    CHECK_EQUAL(50, dump_l2cap_data(0, 0x0061, 42));
+    // remote cid 0x0041 is not the local AVDTP cid
+    CHECK_EQUAL(50, dump_l2cap_data(0, 0x0041, 42));
+
+    // channel closed by remote
+    uint8_t disconnect[4];
+    little_endian_store_16(disconnect, 0, 0x0041);
+    little_endian_store_16(disconnect, 2, 0x0060);
+    dump_signaling(1, L2CAP_CID_SIGNALING, DISCONNECTION_REQUEST, 3, disconnect, sizeof(disconnect));
+    CHECK_EQUAL(50, dump_l2cap_data(1, 0x0041, 42));
+}
+
+TEST(hci_dump_filter, RefusedConnectionIsNotTracked){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_L2CAP_PSM;
+    filters[0].l2cap_psm = BLUETOOTH_PSM_AVDTP;
+    filters[0].snaplen = 0;
+    hci_dump_filter_add(&filters[0]);
+
+    uint8_t request[4];
+    little_endian_store_16(request, 0, BLUETOOTH_PSM_AVDTP);
+    little_endian_store_16(request, 2, 0x0070);
+    dump_signaling(1, L2CAP_CID_SIGNALING, CONNECTION_REQUEST, 7, request, sizeof(request));
+    uint8_t response[8] = { 0 };
+    little_endian_store_16(response, 2, 0x0070);
+    little_endian_store_16(response, 4, 0x0004);
+    dump_signaling(0, L2CAP_CID_SIGNALING, CONNECTION_RESPONSE, 7, response, sizeof(response));
+
+    CHECK_EQUAL(50, dump_l2cap_data(0, 0x0070, 42));
+}
+
+TEST(hci_dump_filter, LocalCidOfLeCreditBasedChannel){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_L2CAP_CID;
+    filters[0].l2cap_cid = 0x0041;
+    filters[0].snaplen = 0;
+    hci_dump_filter_add(&filters[0]);
+
+    // incoming request from remote cid 0x0040, accepted with local cid 0x0041
+    uint8_t request[10] = { 0 };
+    little_endian_store_16(request, 0, 0x0080);
+    little_endian_store_16(request, 2, 0x0040);
+    dump_signaling(1, L2CAP_CID_SIGNALING_LE, LE_CREDIT_BASED_CONNECTION_REQUEST, 5, request, sizeof(request));
+    uint8_t response[10] = { 0 };
+    little_endian_store_16(response, 0, 0x0041);
+    dump_signaling(0, L2CAP_CID_SIGNALING_LE, LE_CREDIT_BASED_CONNECTION_RESPONSE, 5, response, sizeof(response));
+
+    CHECK_EQUAL(0, dump_l2cap_data(1, 0x0041, 42));
+    CHECK_EQUAL(0, dump_l2cap_data(0, 0x0040, 42));
+    CHECK_EQUAL(50, dump_l2cap_data(1, 0x0040, 42));
+}
+
+TEST(hci_dump_filter, EnhancedCreditBasedChannels){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_L2CAP_PSM;
+    filters[0].l2cap_psm = BLUETOOTH_PSM_EATT;
+    filters[0].snaplen = 10;
+    hci_dump_filter_add(&filters[0]);
+
+    // outgoing request for two channels, second one refused
+    uint8_t request[12] = { 0 };
+    little_endian_store_16(request, 0, BLUETOOTH_PSM_EATT);
+    little_endian_store_16(request, 8, 0x0041);
+    little_endian_store_16(request, 10, 0x0042);
+    dump_signaling(0, L2CAP_CID_SIGNALING_LE, L2CAP_CREDIT_BASED_CONNECTION_REQUEST, 9, request, sizeof(request));
+    uint8_t response[12] = { 0 };
+    little_endian_store_16(response, 6, 0x0004);
+    little_endian_store_16(response, 8, 0x0050);
+    little_endian_store_16(response, 10, 0x0000);
+    dump_signaling(1, L2CAP_CID_SIGNALING_LE, L2CAP_CREDIT_BASED_CONNECTION_RESPONSE, 9, response, sizeof(response));
+
+    CHECK_EQUAL(10, dump_l2cap_data(1, 0x0041, 42));
+    CHECK_EQUAL(10, dump_l2cap_data(0, 0x0050, 42));
+    CHECK_EQUAL(50, dump_l2cap_data(1, 0x0042, 42));
+}
+
+TEST(hci_dump_filter, ContinuationFragmentsFollowFirstFragment){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_L2CAP_PSM;
+    filters[0].l2cap_psm = BLUETOOTH_PSM_AVDTP;
+    filters[0].snaplen = 60;
+    hci_dump_filter_add(&filters[0]);
+    open_classic_channel(BLUETOOTH_PSM_AVDTP, 0x0041, 0x0060, 1);
+
+    // 50 bytes logged from first fragment, 10 bytes from second, third dropped
+    uint8_t fragment[44];
+    memset(fragment, 0, sizeof(fragment));
+    little_endian_store_16(fragment, 0, TEST_CON_HANDLE | 0x1000);
+    little_endian_store_16(fragment, 2, 40);
+    CHECK_EQUAL(50, dump_l2cap_data(0, 0x0060, 42));
+    CHECK_EQUAL(14, dump_packet(HCI_ACL_DATA_PACKET, 0, fragment, sizeof(fragment)));
+    CHECK_EQUAL(0, dump_packet(HCI_ACL_DATA_PACKET, 0, fragment, sizeof(fragment)));
+    // other direction not affected
+    CHECK_EQUAL(44, dump_packet(HCI_ACL_DATA_PACKET, 1, fragment, sizeof(fragment)));
+    // next PDU on other channel
+    CHECK_EQUAL(50, dump_l2cap_data(0, 0x0070, 42));
+    CHECK_EQUAL(44, dump_packet(HCI_ACL_DATA_PACKET, 0, fragment, sizeof(fragment)));
+}
+
+TEST(hci_dump_filter, DisconnectionCompleteClearsChannels){
+    filters[0].match = HCI_DUMP_FILTER_MATCH_L2CAP_PSM;
+    filters[0].l2cap_psm = BLUETOOTH_PSM_AVDTP;
+    filters[0].snaplen = 0;
+    hci_dump_filter_add(&filters[0]);
+    open_classic_channel(BLUETOOTH_PSM_AVDTP, 0x0041, 0x0060, 1);
+    CHECK_EQUAL(0, dump_l2cap_data(1, 0x0041, 42));
+
+    uint8_t disconnection_complete[] = { HCI_EVENT_DISCONNECTION_COMPLETE, 4, 0, 0x40, 0x00, 0x13 };
+    dump_packet(HCI_EVENT_PACKET, 1, disconnection_complete, sizeof(disconnection_complete));
+    CHECK_EQUAL(50, dump_l2cap_data(1, 0x0041, 42));
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
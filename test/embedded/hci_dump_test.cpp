@@ -110,6 +110,10 @@ static const hci_dump_t hci_dump_instance_without_reset = {
     &hci_dump_embedded_stdout_log_packet,
     // void (*log_message)(int log_level, const char * format, va_list argptr);
     &hci_dump_embedded_stdout_log_message,
+    // void (*snapshot)(void);
+    NULL,
+    // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+    NULL,
 };
 
 static const hci_dump_t hci_dump_instance_with_reset = {
@@ -119,6 +123,10 @@ static const hci_dump_t hci_dump_instance_with_reset = {
         &hci_dump_embedded_stdout_log_packet,
         // void (*log_message)(int log_level, const char * format, va_list argptr);
         &hci_dump_embedded_stdout_log_message,
+        // void (*snapshot)(void);
+        NULL,
+        // void (*log_packet_truncated)(uint8_t packet_type, uint8_t in, uint8_t *packet, uint16_t len, uint16_t original_len);
+        NULL,
 };
 
 TEST_GROUP(hci_dump){
@@ -342,6 +350,225 @@ TEST(hci_dump, buffered_reset_clears_buffer_and_forwards_reset){
     CHECK_EQUAL(1, logged_packet_count);
 }
 
+typedef struct {
+    uint32_t sequence_number;
+    uint8_t  packet_type;
+    uint8_t  in;
+    uint64_t timestamp_us;
+    uint16_t len;
+    const uint8_t * data;
+} ring_record_t;
+
+// walk published records from tail to write index
+static int parse_ring(const uint8_t * buffer, ring_record_t * records, int max_records){
+    const uint8_t * ring = &buffer[HCI_DUMP_BUFFERED_RING_HEADER_SIZE];
+    uint32_t ring_size      = little_endian_read_32(buffer, 16);
+    uint32_t write_index    = little_endian_read_32(buffer, 24);
+    uint32_t pos            = little_endian_read_32(buffer, 28);
+    uint32_t first_sequence = little_endian_read_32(buffer, 32);
+    uint32_t next_sequence  = little_endian_read_32(buffer, 36);
+    int num_records = 0;
+    while (num_records < (int) (next_sequence - first_sequence)){
+        CHECK_TRUE(num_records < max_records);
+        if (((pos + 16u) > ring_size) || (little_endian_read_16(ring, pos) == 0u)){
+            pos = 0;
+        }
+        uint16_t record_len = little_endian_read_16(ring, pos);
+        CHECK_TRUE(record_len >= 16u);
+        records[num_records].packet_type = ring[pos + 2];
+        records[num_records].in = ring[pos + 3];
+        records[num_records].sequence_number = little_endian_read_32(ring, pos + 4);
+        records[num_records].timestamp_us = ((uint64_t) little_endian_read_32(ring, pos + 12) << 32) | little_endian_read_32(ring, pos + 8);
+        records[num_records].len = record_len - 16u;
+        records[num_records].data = &ring[pos + 16];
+        CHECK_EQUAL(first_sequence + num_records, records[num_records].sequence_number);
+        num_records++;
+        pos += (record_len + 3u) & ~3u;
+    }
+    CHECK_EQUAL(write_index, pos);
+    return num_records;
+}
+
+static void log_counter_packet(uint32_t counter, uint16_t len){
+    uint8_t packet[64];
+    memset(packet, 0, sizeof(packet));
+    little_endian_store_32(packet, 0, counter);
+    hci_dump_packet(HCI_ACL_DATA_PACKET, 1, packet, len);
+}
+
+TEST(hci_dump, ring_stores_records){
+    uint8_t buffer[256];
+    uint8_t packet[] = { 0x01, 0x02, 0x03 };
+    ring_record_t records[4];
+
+    memset(buffer, 0, sizeof(buffer));
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    hci_dump_init(hci_dump_buffered_get_instance());
+    MEMCMP_EQUAL("BTSTKRNG", buffer, 8);
+
+    mock_time_ms = 5;
+    hci_dump_packet(HCI_COMMAND_DATA_PACKET, 0, packet, sizeof(packet));
+    mock_time_ms = 7;
+    hci_dump_log(HCI_DUMP_LOG_LEVEL_INFO, "test %u", 7);
+    hci_dump_buffered_flush();
+    CHECK_EQUAL(0, logged_packet_count);
+
+    CHECK_EQUAL(2, parse_ring(buffer, records, 4));
+    CHECK_EQUAL(HCI_COMMAND_DATA_PACKET, records[0].packet_type);
+    CHECK_EQUAL(0, records[0].in);
+    CHECK_EQUAL(5000, records[0].timestamp_us);
+    CHECK_EQUAL(sizeof(packet), records[0].len);
+    MEMCMP_EQUAL(packet, records[0].data, sizeof(packet));
+    CHECK_EQUAL(LOG_MESSAGE_PACKET, records[1].packet_type);
+    CHECK_EQUAL(7000, records[1].timestamp_us);
+    CHECK_EQUAL(6, records[1].len);
+    MEMCMP_EQUAL("test 7", records[1].data, 6);
+}
+
+TEST(hci_dump, ring_drops_oldest_records){
+    uint8_t buffer[HCI_DUMP_BUFFERED_RING_HEADER_SIZE + 200];
+    ring_record_t records[16];
+
+    memset(buffer, 0, sizeof(buffer));
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    hci_dump_init(hci_dump_buffered_get_instance());
+    hci_dump_set_max_packets(10);
+
+    uint32_t i;
+    for (i = 0; i < 1000; i++){
+        log_counter_packet(i, 4 + (i % 37));
+        // newest record always available, older ones in order without gaps
+        int num_records = parse_ring(buffer, records, 16);
+        CHECK_TRUE(num_records > 0);
+        int j;
+        for (j = 0; j < num_records; j++){
+            uint32_t counter = i - (num_records - 1 - j);
+            CHECK_EQUAL(counter, records[j].sequence_number);
+            CHECK_EQUAL(4 + (counter % 37), records[j].len);
+            CHECK_EQUAL(counter, little_endian_read_32(records[j].data, 0));
+        }
+    }
+}
+
+TEST(hci_dump, ring_truncates_oversized_packet){
+    uint8_t buffer[HCI_DUMP_BUFFERED_RING_HEADER_SIZE + 48];
+    ring_record_t records[2];
+
+    memset(buffer, 0, sizeof(buffer));
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    hci_dump_init(hci_dump_buffered_get_instance());
+    log_counter_packet(1, 60);
+
+    CHECK_EQUAL(1, parse_ring(buffer, records, 2));
+    CHECK_EQUAL(32, records[0].len);
+    CHECK_EQUAL(1, little_endian_read_32(records[0].data, 0));
+}
+
+TEST(hci_dump, ring_appends_to_existing_ring){
+    uint8_t buffer[HCI_DUMP_BUFFERED_RING_HEADER_SIZE + 200];
+    ring_record_t records[16];
+
+    memset(buffer, 0, sizeof(buffer));
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    hci_dump_init(hci_dump_buffered_get_instance());
+    uint32_t i;
+    for (i = 0; i < 20; i++){
+        log_counter_packet(i, 20);
+    }
+
+    // restart with same buffer
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    log_counter_packet(20, 20);
+    int num_records = parse_ring(buffer, records, 16);
+    CHECK_EQUAL(5, num_records);
+    CHECK_EQUAL(20, records[num_records - 1].sequence_number);
+    CHECK_EQUAL(20, little_endian_read_32(records[num_records - 1].data, 0));
+
+    // buffer with different size is not used
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer) - 4, NULL);
+    log_counter_packet(21, 20);
+    CHECK_EQUAL(1, parse_ring(buffer, records, 16));
+    CHECK_EQUAL(0, records[0].sequence_number);
+}
+
+// crash after writing record but before publishing it in header
+static void log_counter_packet_unpublished(uint8_t * buffer, uint32_t counter){
+    uint32_t write_index   = little_endian_read_32(buffer, 24);
+    uint32_t next_sequence = little_endian_read_32(buffer, 36);
+    log_counter_packet(counter, 20);
+    little_endian_store_32(buffer, 24, write_index);
+    little_endian_store_32(buffer, 36, next_sequence);
+}
+
+TEST(hci_dump, ring_recovers_unpublished_record){
+    uint8_t buffer[HCI_DUMP_BUFFERED_RING_HEADER_SIZE + 200];
+    ring_record_t records[16];
+
+    memset(buffer, 0, sizeof(buffer));
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    hci_dump_init(hci_dump_buffered_get_instance());
+    uint32_t i;
+    for (i = 0; i < 20; i++){
+        log_counter_packet(i, 20);
+    }
+    log_counter_packet_unpublished(buffer, 20);
+    int num_records = parse_ring(buffer, records, 16);
+    CHECK_EQUAL(19, records[num_records - 1].sequence_number);
+
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    num_records = parse_ring(buffer, records, 16);
+    CHECK_EQUAL(20, records[num_records - 1].sequence_number);
+    CHECK_EQUAL(20, little_endian_read_32(records[num_records - 1].data, 0));
+
+    // incomplete record without sequence number is ignored
+    log_counter_packet_unpublished(buffer, 21);
+    uint32_t write_index = little_endian_read_32(buffer, 24) % 200u;
+    little_endian_store_32(buffer, HCI_DUMP_BUFFERED_RING_HEADER_SIZE + write_index + 4, 0);
+    hci_dump_buffered_init_ring(buffer, sizeof(buffer), NULL);
+    num_records = parse_ring(buffer, records, 16);
+    CHECK_EQUAL(20, records[num_records - 1].sequence_number);
+    log_counter_packet(22, 20);
+    num_records = parse_ring(buffer, records, 16);
+    CHECK_EQUAL(21, records[num_records - 1].sequence_number);
+    CHECK_EQUAL(22, little_endian_read_32(records[num_records - 1].data, 0));
+}
+
+// positions in rings larger than 64 kB must not be truncated to 16 bit
+static uint8_t large_ring_buffer[HCI_DUMP_BUFFERED_RING_HEADER_SIZE + 200000];
+static ring_record_t large_ring_records[2000];
+
+TEST(hci_dump, ring_larger_than_64k_wraps){
+    uint8_t packet[1020];
+    hci_dump_buffered_init_ring(large_ring_buffer, sizeof(large_ring_buffer), NULL);
+    hci_dump_init(hci_dump_buffered_get_instance());
+
+    uint32_t random_state = 0x4711;
+    uint32_t bytes_logged = 0;
+    uint32_t i;
+    for (i = 0; bytes_logged < (3u * sizeof(large_ring_buffer)); i++){
+        random_state = random_state * 1103515245u + 12345u;
+        uint16_t len = (uint16_t) (20u + ((random_state >> 8) % 1001u));
+        memset(packet, (uint8_t) i, len);
+        little_endian_store_32(packet, 0, i);
+        hci_dump_packet(HCI_ACL_DATA_PACKET, 1, packet, len);
+        bytes_logged += len;
+
+        // all published records intact
+        if ((i % 25u) != 0u) continue;
+        int num_records = parse_ring(large_ring_buffer, large_ring_records, 2000);
+        CHECK_TRUE(num_records > 0);
+        CHECK_EQUAL(i, large_ring_records[num_records - 1].sequence_number);
+        int j;
+        for (j = 0; j < num_records; j++){
+            const ring_record_t * record = &large_ring_records[j];
+            CHECK_EQUAL(record->sequence_number, little_endian_read_32(record->data, 0));
+            CHECK_EQUAL((uint8_t) record->sequence_number, record->data[record->len - 1u]);
+        }
+    }
+    // ring wrapped at least twice
+    CHECK_TRUE(little_endian_read_32(large_ring_buffer, 32) > 0u);
+}
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
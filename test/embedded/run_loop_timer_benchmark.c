@@ -0,0 +1,85 @@
+// Benchmark for btstack_run_loop_base timer management
+//
+// Build with and without ENABLE_RUN_LOOP_TIMER_WHEEL (make benchmark) to compare sorted list and timer wheel
+
+#define _POSIX_C_SOURCE 200809
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "btstack_run_loop.h"
+#include "btstack_util.h"
+
+#define MAX_TIMERS 10000
+
+static btstack_timer_source_t timers[MAX_TIMERS];
+static uint32_t num_fired;
+static uint32_t random_state = 0x4711;
+
+static uint32_t next_random(void){
+    random_state = random_state * 1103515245u + 12345u;
+    return random_state >> 8;
+}
+
+static uint64_t get_time_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000u) + ((uint64_t) ts.tv_nsec / 1000u);
+}
+
+static void timeout_handler(btstack_timer_source_t * ts){
+    UNUSED(ts);
+    num_fired++;
+}
+
+static void benchmark(uint32_t num_timers){
+    uint32_t i;
+    uint32_t now = 0;
+
+    btstack_run_loop_base_init();
+    memset(timers, 0, sizeof(timers));
+    num_fired = 0;
+
+    // arm timers with timeouts up to 60 seconds
+    uint64_t start_us = get_time_us();
+    for (i = 0; i < num_timers; i++){
+        btstack_run_loop_set_timer_handler(&timers[i], timeout_handler);
+        timers[i].timeout = now + (next_random() % 60000u);
+        btstack_run_loop_base_add_timer(&timers[i]);
+    }
+    uint64_t add_us = get_time_us() - start_us;
+
+    // restart all timers, e.g. supervision timeouts for received packets
+    start_us = get_time_us();
+    for (i = 0; i < num_timers; i++){
+        btstack_run_loop_base_remove_timer(&timers[i]);
+        timers[i].timeout = now + (next_random() % 60000u);
+        btstack_run_loop_base_add_timer(&timers[i]);
+    }
+    uint64_t restart_us = get_time_us() - start_us;
+
+    // process timers in 1 ms steps
+    start_us = get_time_us();
+    while (num_fired < num_timers){
+        now++;
+        (void) btstack_run_loop_base_get_time_until_timeout(now);
+        btstack_run_loop_base_process_timers(now);
+    }
+    uint64_t process_us = get_time_us() - start_us;
+
+    printf("%6u timers: add %8u us, restart %8u us, process %8u us\n", (unsigned int) num_timers,
+           (unsigned int) add_us, (unsigned int) restart_us, (unsigned int) process_us);
+}
+
+int main(void){
+#ifdef ENABLE_RUN_LOOP_TIMER_WHEEL
+    printf("Timer wheel\n");
+#else
+    printf("Sorted list\n");
+#endif
+    benchmark(1000);
+    benchmark(10000);
+    return 0;
+}
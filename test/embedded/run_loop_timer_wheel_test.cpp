@@ -0,0 +1,224 @@
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_run_loop.h"
+#include "btstack_memory.h"
+#include "btstack_util.h"
+
+#ifndef ENABLE_RUN_LOOP_TIMER_WHEEL
+#error "ENABLE_RUN_LOOP_TIMER_WHEEL required"
+#endif
+
+#define NUM_TIMERS 500
+
+static btstack_timer_source_t timers[NUM_TIMERS];
+static btstack_timer_source_t * fired_timers[NUM_TIMERS];
+static uint32_t fired_at[NUM_TIMERS];
+static uint16_t num_fired;
+static uint32_t current_time;
+
+static void timeout_handler(btstack_timer_source_t * ts){
+    fired_timers[num_fired] = ts;
+    fired_at[num_fired] = current_time;
+    num_fired++;
+}
+
+static void periodic_handler(btstack_timer_source_t * ts){
+    timeout_handler(ts);
+    if (num_fired < 5){
+        ts->timeout = current_time + 100;
+        btstack_run_loop_base_add_timer(ts);
+    }
+}
+
+static void setup_timer(btstack_timer_source_t * timer, uint32_t timeout){
+    memset(timer, 0, sizeof(btstack_timer_source_t));
+    btstack_run_loop_set_timer_handler(timer, timeout_handler);
+    timer->timeout = timeout;
+}
+
+static void process_until(uint32_t end, uint32_t step){
+    while (btstack_time_delta(end, current_time) > 0){
+        current_time += step;
+        btstack_run_loop_base_process_timers(current_time);
+    }
+}
+
+TEST_GROUP(RunLoopTimerWheel){
+    void setup(void){
+        btstack_memory_init();
+        btstack_run_loop_base_init();
+        num_fired = 0;
+        current_time = 0;
+    }
+    void teardown(void){
+        btstack_memory_deinit();
+    }
+};
+
+TEST(RunLoopTimerWheel, AddRemove){
+    setup_timer(&timers[0], 1000);
+    CHECK_EQUAL(-1, btstack_run_loop_base_get_time_until_timeout(0));
+    CHECK_FALSE(btstack_run_loop_base_remove_timer(&timers[0]));
+    btstack_run_loop_base_add_timer(&timers[0]);
+    CHECK_EQUAL(1000, btstack_run_loop_base_get_time_until_timeout(0));
+    CHECK_TRUE(btstack_run_loop_base_remove_timer(&timers[0]));
+    CHECK_FALSE(btstack_run_loop_base_remove_timer(&timers[0]));
+    CHECK_EQUAL(-1, btstack_run_loop_base_get_time_until_timeout(0));
+    btstack_run_loop_base_process_timers(2000);
+    CHECK_EQUAL(0, num_fired);
+}
+
+TEST(RunLoopTimerWheel, UninitializedTimer){
+    setup_timer(&timers[0], 1000);
+    btstack_run_loop_base_add_timer(&timers[0]);
+
+    // not registered, garbage in link fields
+    btstack_timer_source_t * timer = &timers[1];
+    memset(timer, 0xa5, sizeof(btstack_timer_source_t));
+    CHECK_FALSE(btstack_run_loop_base_remove_timer(timer));
+    // not registered, but head of slot with other timer
+    timer->wheel_head = timers[0].wheel_head;
+    CHECK_FALSE(btstack_run_loop_base_remove_timer(timer));
+    CHECK_EQUAL(1000, btstack_run_loop_base_get_time_until_timeout(0));
+
+    // can be added without initialization
+    btstack_run_loop_set_timer_handler(timer, timeout_handler);
+    timer->timeout = 500;
+    btstack_run_loop_base_add_timer(timer);
+    process_until(2000, 10);
+    CHECK_EQUAL(2, num_fired);
+    POINTERS_EQUAL(&timers[1], fired_timers[0]);
+    POINTERS_EQUAL(&timers[0], fired_timers[1]);
+}
+
+TEST(RunLoopTimerWheel, TimeUntilTimeoutOnAllLevels){
+    const uint32_t timeouts[] = { 70000000, 300000, 5000, 70, 3 };
+    uint16_t i;
+    for (i = 0; i < 5; i++){
+        setup_timer(&timers[i], timeouts[i]);
+        btstack_run_loop_base_add_timer(&timers[i]);
+        CHECK_EQUAL((int32_t) timeouts[i], btstack_run_loop_base_get_time_until_timeout(0));
+    }
+    for (i = 0; i < 5; i++){
+        btstack_run_loop_base_remove_timer(&timers[4 - i]);
+        if (i < 4){
+            CHECK_EQUAL((int32_t) timeouts[3 - i], btstack_run_loop_base_get_time_until_timeout(0));
+        }
+    }
+    CHECK_EQUAL(-1, btstack_run_loop_base_get_time_until_timeout(0));
+}
+
+TEST(RunLoopTimerWheel, FireInOrder){
+    uint16_t i;
+    // pseudo random timeouts up to 20 seconds
+    uint32_t seed = 12345;
+    for (i = 0; i < NUM_TIMERS; i++){
+        seed = seed * 1103515245u + 12345u;
+        setup_timer(&timers[i], (seed >> 8) % 20000u);
+        btstack_run_loop_base_add_timer(&timers[i]);
+    }
+    // remove every fifth timer
+    for (i = 0; i < NUM_TIMERS; i += 5){
+        CHECK_TRUE(btstack_run_loop_base_remove_timer(&timers[i]));
+    }
+    process_until(20000, 7);
+    CHECK_EQUAL(NUM_TIMERS - (NUM_TIMERS / 5), num_fired);
+    for (i = 0; i < num_fired; i++){
+        btstack_timer_source_t * timer = fired_timers[i];
+        // not fired too early or too late
+        CHECK(btstack_time_delta((uint32_t) timer->timeout, fired_at[i]) <= 0);
+        CHECK(btstack_time_delta(fired_at[i], (uint32_t) timer->timeout) < 7);
+        if (i > 0){
+            CHECK(btstack_time_delta((uint32_t) timer->timeout, (uint32_t) fired_timers[i-1]->timeout) >= 0);
+        }
+    }
+    CHECK_EQUAL(-1, btstack_run_loop_base_get_time_until_timeout(current_time));
+}
+
+TEST(RunLoopTimerWheel, SameTimeoutFifo){
+    uint16_t i;
+    for (i = 0; i < 10; i++){
+        setup_timer(&timers[i], 4711);
+        btstack_run_loop_base_add_timer(&timers[i]);
+    }
+    btstack_run_loop_base_process_timers(4710);
+    CHECK_EQUAL(0, num_fired);
+    btstack_run_loop_base_process_timers(5000);
+    CHECK_EQUAL(10, num_fired);
+    for (i = 0; i < 10; i++){
+        CHECK(fired_timers[i] == &timers[i]);
+    }
+}
+
+TEST(RunLoopTimerWheel, TimeoutBeforeWheel){
+    btstack_run_loop_base_process_timers(800);
+    setup_timer(&timers[0], 1000);
+    btstack_run_loop_base_add_timer(&timers[0]);
+    // timers before current wheel position are kept sorted
+    setup_timer(&timers[1], 500);
+    btstack_run_loop_base_add_timer(&timers[1]);
+    setup_timer(&timers[2], 300);
+    btstack_run_loop_base_add_timer(&timers[2]);
+    CHECK_EQUAL(0, btstack_run_loop_base_get_time_until_timeout(800));
+    btstack_run_loop_base_process_timers(900);
+    CHECK_EQUAL(2, num_fired);
+    CHECK(fired_timers[0] == &timers[2]);
+    CHECK(fired_timers[1] == &timers[1]);
+    CHECK_EQUAL(100, btstack_run_loop_base_get_time_until_timeout(900));
+    btstack_run_loop_base_process_timers(1000);
+    CHECK_EQUAL(3, num_fired);
+    CHECK(fired_timers[2] == &timers[0]);
+}
+
+TEST(RunLoopTimerWheel, Periodic){
+    setup_timer(&timers[0], 100);
+    btstack_run_loop_set_timer_handler(&timers[0], periodic_handler);
+    btstack_run_loop_base_add_timer(&timers[0]);
+    process_until(1000, 10);
+    CHECK_EQUAL(5, num_fired);
+    CHECK_EQUAL(500, fired_at[4]);
+}
+
+TEST(RunLoopTimerWheel, Overrun){
+    const uint32_t t1 = 0xfffffff0UL;   // -16
+    const uint32_t t2 = 0xfffffff8UL;   //  -8
+    const uint32_t t3 = 50UL;
+    btstack_run_loop_base_process_timers(t1);
+    setup_timer(&timers[0], t1 + 20);
+    btstack_run_loop_base_add_timer(&timers[0]);
+    setup_timer(&timers[1], t1 + 10);
+    btstack_run_loop_base_add_timer(&timers[1]);
+    CHECK_EQUAL(10, btstack_run_loop_base_get_time_until_timeout(t1));
+    btstack_run_loop_base_process_timers(t2);
+    CHECK_EQUAL(0, num_fired);
+    btstack_run_loop_base_process_timers(t3);
+    CHECK_EQUAL(2, num_fired);
+    CHECK(fired_timers[0] == &timers[1]);
+    CHECK(fired_timers[1] == &timers[0]);
+}
+
+TEST(RunLoopTimerWheel, LongSleep){
+    setup_timer(&timers[0], 10);
+    btstack_run_loop_base_add_timer(&timers[0]);
+    setup_timer(&timers[1], 3600000);
+    btstack_run_loop_base_add_timer(&timers[1]);
+    setup_timer(&timers[2], 3600001);
+    btstack_run_loop_base_add_timer(&timers[2]);
+    btstack_run_loop_base_process_timers(20);
+    CHECK_EQUAL(1, num_fired);
+    CHECK_EQUAL(3600000 - 20, btstack_run_loop_base_get_time_until_timeout(20));
+    btstack_run_loop_base_process_timers(3599999);
+    CHECK_EQUAL(1, num_fired);
+    CHECK_EQUAL(1, btstack_run_loop_base_get_time_until_timeout(3599999));
+    btstack_run_loop_base_process_timers(3600000);
+    CHECK_EQUAL(2, num_fired);
+    btstack_run_loop_base_process_timers(4000000);
+    CHECK_EQUAL(3, num_fired);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -306,6 +306,127 @@ TEST(BSTACK_TLV, TestFullBankPlusMigrate){
     CHECK_EQUAL(8 + 2 * (TAG_OVERHEAD + sizeof(blob)), btstack_tlv_context.write_offset);
 }
 
+#ifdef ENABLE_TLV_FLASH_INDEX
+
+// count flash reads of hal_flash_bank_memory
+static const hal_flash_bank_t * counting_hal_flash_bank_impl;
+static int counting_hal_flash_bank_num_reads;
+
+static uint32_t counting_hal_flash_bank_get_size(void * context){
+    return counting_hal_flash_bank_impl->get_size(context);
+}
+static uint32_t counting_hal_flash_bank_get_alignment(void * context){
+    return counting_hal_flash_bank_impl->get_alignment(context);
+}
+static void counting_hal_flash_bank_erase(void * context, int bank){
+    counting_hal_flash_bank_impl->erase(context, bank);
+}
+static void counting_hal_flash_bank_read(void * context, int bank, uint32_t offset, uint8_t * buffer, uint32_t size){
+    counting_hal_flash_bank_num_reads++;
+    counting_hal_flash_bank_impl->read(context, bank, offset, buffer, size);
+}
+static void counting_hal_flash_bank_write(void * context, int bank, uint32_t offset, const uint8_t * data, uint32_t size){
+    counting_hal_flash_bank_impl->write(context, bank, offset, data, size);
+}
+
+static const hal_flash_bank_t counting_hal_flash_bank = {
+    &counting_hal_flash_bank_get_size,
+    &counting_hal_flash_bank_get_alignment,
+    &counting_hal_flash_bank_erase,
+    &counting_hal_flash_bank_read,
+    &counting_hal_flash_bank_write,
+};
+
+TEST_GROUP(BSTACK_TLV_INDEX){
+	hal_flash_bank_memory_t  hal_flash_bank_context;
+
+	const btstack_tlv_t *    btstack_tlv_impl;
+	btstack_tlv_flash_bank_t btstack_tlv_context;
+
+    void setup(void){
+    	counting_hal_flash_bank_impl = hal_flash_bank_memory_init_instance(&hal_flash_bank_context, hal_flash_bank_memory_storage, HAL_FLASH_BANK_MEMORY_STORAGE_SIZE);
+		counting_hal_flash_bank_impl->erase(&hal_flash_bank_context, 0);
+		counting_hal_flash_bank_impl->erase(&hal_flash_bank_context, 1);
+		btstack_tlv_impl = btstack_tlv_flash_bank_init_instance(&btstack_tlv_context, &counting_hal_flash_bank, &hal_flash_bank_context);
+		counting_hal_flash_bank_num_reads = 0;
+    }
+};
+
+TEST(BSTACK_TLV_INDEX, TestLookupWithoutScan){
+	uint8_t data;
+	uint32_t tag;
+	for (tag = 1; tag <= 4; tag++){
+		data = (uint8_t) tag;
+		btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, &data, 1);
+	}
+	CHECK_TRUE(btstack_tlv_context.index_complete);
+
+	// only value is read
+	counting_hal_flash_bank_num_reads = 0;
+	CHECK_EQUAL(1, btstack_tlv_impl->get_tag(&btstack_tlv_context, 3, &data, 1));
+	CHECK_EQUAL(3, data);
+	CHECK_EQUAL(1, counting_hal_flash_bank_num_reads);
+
+	// missing tag is not searched in flash
+	counting_hal_flash_bank_num_reads = 0;
+	CHECK_EQUAL(0, btstack_tlv_impl->get_tag(&btstack_tlv_context, 5, &data, 1));
+	btstack_tlv_impl->delete_tag(&btstack_tlv_context, 5);
+	CHECK_EQUAL(0, counting_hal_flash_bank_num_reads);
+
+	// delete and overwrite
+	btstack_tlv_impl->delete_tag(&btstack_tlv_context, 2);
+	data = 7;
+	btstack_tlv_impl->store_tag(&btstack_tlv_context, 4, &data, 1);
+	CHECK_EQUAL(0, btstack_tlv_impl->get_tag(&btstack_tlv_context, 2, &data, 1));
+	CHECK_EQUAL(1, btstack_tlv_impl->get_tag(&btstack_tlv_context, 4, &data, 1));
+	CHECK_EQUAL(7, data);
+
+	// index rebuilt on init
+	btstack_tlv_impl = btstack_tlv_flash_bank_init_instance(&btstack_tlv_context, &counting_hal_flash_bank, &hal_flash_bank_context);
+	CHECK_TRUE(btstack_tlv_context.index_complete);
+	CHECK_EQUAL(0, btstack_tlv_impl->get_tag(&btstack_tlv_context, 2, &data, 1));
+	CHECK_EQUAL(1, btstack_tlv_impl->get_tag(&btstack_tlv_context, 1, &data, 1));
+	CHECK_EQUAL(1, data);
+	CHECK_EQUAL(1, btstack_tlv_impl->get_tag(&btstack_tlv_context, 4, &data, 1));
+	CHECK_EQUAL(7, data);
+}
+
+TEST(BSTACK_TLV_INDEX, TestIndexFull){
+	// more tags than index slots
+	uint8_t data;
+	uint32_t tag;
+	const uint32_t num_tags = BTSTACK_TLV_FLASH_INDEX_SIZE;
+	for (tag = 1; tag <= num_tags; tag++){
+		data = (uint8_t) tag;
+		btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, &data, 1);
+	}
+	CHECK_FALSE(btstack_tlv_context.index_complete);
+	for (tag = 1; tag <= num_tags; tag++){
+		CHECK_EQUAL(1, btstack_tlv_impl->get_tag(&btstack_tlv_context, tag, &data, 1));
+		CHECK_EQUAL(tag, data);
+	}
+
+	// overwrite and delete indexed and not indexed tags
+	data = 0x55;
+	btstack_tlv_impl->store_tag(&btstack_tlv_context, 1, &data, 1);
+	btstack_tlv_impl->store_tag(&btstack_tlv_context, num_tags, &data, 1);
+	btstack_tlv_impl->delete_tag(&btstack_tlv_context, 2);
+	btstack_tlv_impl->delete_tag(&btstack_tlv_context, num_tags - 1);
+
+	// fits into index after migration
+	btstack_tlv_impl = btstack_tlv_flash_bank_init_instance(&btstack_tlv_context, &counting_hal_flash_bank, &hal_flash_bank_context);
+	for (tag = 1; tag <= num_tags; tag++){
+		int expected_len = ((tag == 2) || (tag == (num_tags - 1))) ? 0 : 1;
+		uint8_t expected_data = ((tag == 1) || (tag == num_tags)) ? 0x55 : (uint8_t) tag;
+		CHECK_EQUAL(expected_len, btstack_tlv_impl->get_tag(&btstack_tlv_context, tag, &data, 1));
+		if (expected_len > 0){
+			CHECK_EQUAL(expected_data, data);
+		}
+	}
+}
+
+#endif
+
 //
 TEST_GROUP(LINK_KEY_DB){
 	const hal_flash_bank_t * hal_flash_bank_impl;
@@ -390,7 +511,11 @@ TEST(LINK_KEY_DB, KeyReplacement){
 
 int main (int argc, const char * argv[]){
     // log into file using HCI_DUMP_PACKETLOGGER format
-#ifdef ENABLE_TLV_FLASH_WRITE_ONCE
+#if defined(ENABLE_TLV_FLASH_INDEX) && defined(ENABLE_TLV_FLASH_WRITE_ONCE)
+    const char * pklg_path = "hci_dump_index_write_once.pklg";
+#elif defined(ENABLE_TLV_FLASH_INDEX)
+    const char * pklg_path = "hci_dump_index.pklg";
+#elif defined(ENABLE_TLV_FLASH_WRITE_ONCE)
     const char * pklg_path = "hci_dump_write_once.pklg";
 #elif defined(ENABLE_TLV_FLASH_EXPLICIT_DELETE_FIELD)
     const char * pklg_path = "hci_dump_delete_field.pklg";
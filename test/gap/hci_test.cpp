@@ -297,6 +297,98 @@ TEST(HCI, hci_connection_for_bd_addr_and_type){
     CHECK_EQUAL(NULL, con);
 }
 
+static void test_le_connection_complete(hci_con_handle_t con_handle, const bd_addr_t addr){
+    uint8_t event[21];
+    memset(event, 0, sizeof(event));
+    event[0] = HCI_EVENT_LE_META;
+    event[1] = sizeof(event) - 2;
+    event[2] = HCI_SUBEVENT_LE_CONNECTION_COMPLETE;
+    event[3] = ERROR_CODE_SUCCESS;
+    little_endian_store_16(event, 4, con_handle);
+    event[6] = HCI_ROLE_SLAVE;
+    event[7] = BD_ADDR_TYPE_LE_PUBLIC;
+    reverse_bd_addr(addr, &event[8]);
+    packet_handler(HCI_EVENT_PACKET, event, sizeof(event));
+}
+
+static void test_disconnection_complete(hci_con_handle_t con_handle){
+    uint8_t event[6];
+    event[0] = HCI_EVENT_DISCONNECTION_COMPLETE;
+    event[1] = sizeof(event) - 2;
+    event[2] = ERROR_CODE_SUCCESS;
+    little_endian_store_16(event, 3, con_handle);
+    event[5] = ERROR_CODE_REMOTE_USER_TERMINATED_CONNECTION;
+    packet_handler(HCI_EVENT_PACKET, event, sizeof(event));
+}
+
+TEST(HCI, connection_lookup_after_create){
+    bd_addr_t addr = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    CHECK_EQUAL(NULL, hci_connection_for_handle(0x40));
+    CHECK_EQUAL(NULL, hci_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_LE_PUBLIC));
+    test_le_connection_complete(0x40, addr);
+    hci_connection_t * con = hci_connection_for_handle(0x40);
+    CHECK(con != NULL);
+    CHECK_EQUAL(con, hci_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_LE_PUBLIC));
+    CHECK_EQUAL(NULL, hci_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_LE_RANDOM));
+    // connections from setup
+    bd_addr_t fuzz_addr = { 0x66, 0x55, 0x44, 0x33, 0x00, 0x05};
+    con = hci_connection_for_handle(0x05);
+    CHECK(con != NULL);
+    CHECK_EQUAL(con, hci_connection_for_bd_addr_and_type(fuzz_addr, BD_ADDR_TYPE_LE_PUBLIC));
+}
+
+TEST(HCI, connection_lookup_after_free){
+    bd_addr_t addr = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    test_le_connection_complete(0x40, addr);
+    CHECK(hci_connection_for_handle(0x40) != NULL);
+    test_disconnection_complete(0x40);
+    CHECK_EQUAL(NULL, hci_connection_for_handle(0x40));
+    CHECK_EQUAL(NULL, hci_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_LE_PUBLIC));
+    CHECK(hci_connection_for_handle(0x05) != NULL);
+}
+
+TEST(HCI, connection_lookup_handle_reuse){
+    bd_addr_t addr_a = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    bd_addr_t addr_b = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x77 };
+    test_le_connection_complete(0x40, addr_a);
+    test_disconnection_complete(0x40);
+    test_le_connection_complete(0x40, addr_b);
+    hci_connection_t * con = hci_connection_for_handle(0x40);
+    CHECK(con != NULL);
+    MEMCMP_EQUAL(addr_b, con->address, 6);
+    CHECK_EQUAL(con, hci_connection_for_bd_addr_and_type(addr_b, BD_ADDR_TYPE_LE_PUBLIC));
+    CHECK_EQUAL(NULL, hci_connection_for_bd_addr_and_type(addr_a, BD_ADDR_TYPE_LE_PUBLIC));
+}
+
+TEST(HCI, connection_lookup_many_connections){
+    // more connections than slots in connection index
+    bd_addr_t addr = { 0x11, 0x22, 0x33, 0x44, 0x00, 0x00 };
+    uint16_t i;
+    for (i = 0; i < 100; i++){
+        addr[5] = (uint8_t) i;
+        test_le_connection_complete(0x100 + i, addr);
+    }
+    for (i = 0; i < 100; i++){
+        addr[5] = (uint8_t) i;
+        hci_connection_t * con = hci_connection_for_handle(0x100 + i);
+        CHECK(con != NULL);
+        CHECK_EQUAL(con, hci_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_LE_PUBLIC));
+    }
+    for (i = 0; i < 100; i += 2){
+        test_disconnection_complete(0x100 + i);
+    }
+    for (i = 0; i < 100; i++){
+        addr[5] = (uint8_t) i;
+        hci_connection_t * con = hci_connection_for_handle(0x100 + i);
+        if ((i & 1u) == 0u){
+            CHECK_EQUAL(NULL, con);
+        } else {
+            CHECK(con != NULL);
+        }
+        CHECK_EQUAL(con, hci_connection_for_bd_addr_and_type(addr, BD_ADDR_TYPE_LE_PUBLIC));
+    }
+}
+
 TEST(HCI, hci_number_free_acl_slots_for_handle){
     int free_acl_slots_num = hci_number_free_acl_slots_for_handle(HCI_CON_HANDLE_INVALID);
     CHECK_EQUAL(0, free_acl_slots_num);
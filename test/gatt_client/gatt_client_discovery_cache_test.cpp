@@ -0,0 +1,285 @@
+// *****************************************************************************
+//
+// test GATT Client Discovery Cache
+//
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "hci.h"
+#include "btstack_event.h"
+#include "btstack_memory.h"
+#include "btstack_tlv.h"
+#include "ble/att_db.h"
+#include "ble/att_db_util.h"
+#include "ble/gatt_client.h"
+#include "bluetooth_gatt.h"
+#include "btstack_crypto.h"
+#include "mock_btstack_tlv.h"
+
+#ifndef ENABLE_GATT_CLIENT_DISCOVERY_CACHE
+#error "ENABLE_GATT_CLIENT_DISCOVERY_CACHE required"
+#endif
+
+extern "C" void hci_setup_le_connection(uint16_t con_handle);
+extern "C" uint16_t get_gatt_client_handle(void);
+extern "C" void mock_simulate_disconnected(void);
+extern "C" uint16_t mock_get_num_att_requests(void);
+extern "C" void mock_simulate_bonding_deleted(uint8_t le_device_db_index);
+
+#define MAX_SERVICES        8
+#define MAX_CHARACTERISTICS 16
+#define MAX_DESCRIPTORS     16
+
+typedef struct {
+    uint16_t num_services;
+    uint16_t num_characteristics;
+    uint16_t num_descriptors;
+    gatt_client_service_t        services[MAX_SERVICES];
+    gatt_client_characteristic_t characteristics[MAX_CHARACTERISTICS];
+    gatt_client_characteristic_descriptor_t descriptors[MAX_DESCRIPTORS];
+} discovery_result_t;
+
+static hci_con_handle_t con_handle;
+static mock_btstack_tlv_t tlv_context;
+static uint8_t database_hash[16];
+static uint8_t battery_level = 100;
+static uint8_t heart_rate[2];
+static btstack_context_callback_registration_t setup_request;
+static bool setup_done;
+static bool query_complete;
+static uint8_t query_status;
+static discovery_result_t * discovery_result;
+
+// Database Hash of local database not needed
+extern "C" void btstack_crypto_aes128_cmac_generator(btstack_crypto_aes128_cmac_t * request, const uint8_t * key, uint16_t size, uint8_t (*get_byte_callback)(uint16_t pos), uint8_t * hash, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    UNUSED(key);
+    UNUSED(size);
+    UNUSED(get_byte_callback);
+    UNUSED(hash);
+    UNUSED(callback);
+    UNUSED(callback_arg);
+}
+
+static void setup_db(bool with_body_sensor_location){
+    att_db_util_init();
+    att_db_util_add_service_uuid16(ORG_BLUETOOTH_SERVICE_GENERIC_ATTRIBUTE);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_GATT_SERVICE_CHANGED, ATT_PROPERTY_INDICATE,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, NULL, 0);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_DATABASE_HASH, ATT_PROPERTY_READ,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, database_hash, sizeof(database_hash));
+    att_db_util_add_service_uuid16(ORG_BLUETOOTH_SERVICE_BATTERY_SERVICE);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL, ATT_PROPERTY_READ | ATT_PROPERTY_NOTIFY,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, &battery_level, 1);
+    att_db_util_add_service_uuid16(ORG_BLUETOOTH_SERVICE_HEART_RATE);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_HEART_RATE_MEASUREMENT, ATT_PROPERTY_NOTIFY,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, heart_rate, sizeof(heart_rate));
+    if (with_body_sensor_location){
+        att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_BODY_SENSOR_LOCATION, ATT_PROPERTY_READ,
+                                              ATT_SECURITY_NONE, ATT_SECURITY_NONE, heart_rate, 1);
+    }
+    att_set_db(att_db_util_get_address());
+}
+
+static void handle_setup_done(void * context){
+    UNUSED(context);
+    setup_done = true;
+}
+
+static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    switch (hci_event_packet_get_type(packet)){
+        case GATT_EVENT_SERVICE_QUERY_RESULT:
+            CHECK(discovery_result->num_services < MAX_SERVICES);
+            gatt_event_service_query_result_get_service(packet, &discovery_result->services[discovery_result->num_services++]);
+            break;
+        case GATT_EVENT_CHARACTERISTIC_QUERY_RESULT:
+            CHECK(discovery_result->num_characteristics < MAX_CHARACTERISTICS);
+            gatt_event_characteristic_query_result_get_characteristic(packet, &discovery_result->characteristics[discovery_result->num_characteristics++]);
+            break;
+        case GATT_EVENT_ALL_CHARACTERISTIC_DESCRIPTORS_QUERY_RESULT:
+            CHECK(discovery_result->num_descriptors < MAX_DESCRIPTORS);
+            gatt_event_all_characteristic_descriptors_query_result_get_characteristic_descriptor(packet, &discovery_result->descriptors[discovery_result->num_descriptors++]);
+            break;
+        case GATT_EVENT_QUERY_COMPLETE:
+            query_status = gatt_event_query_complete_get_att_status(packet);
+            query_complete = true;
+            break;
+        default:
+            break;
+    }
+}
+
+// connect and wait for internal queries incl. Database Hash read
+static void connect(void){
+    hci_setup_le_connection(con_handle);
+    setup_done = false;
+    setup_request.callback = &handle_setup_done;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_request_to_send_gatt_query(&setup_request, con_handle));
+    CHECK_TRUE(setup_done);
+    MEMCMP_EQUAL(database_hash, gatt_client_get_database_hash(con_handle), 16);
+}
+
+static void check_query_complete(uint8_t status){
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    CHECK_TRUE(query_complete);
+    CHECK_EQUAL(ATT_ERROR_SUCCESS, query_status);
+    query_complete = false;
+}
+
+// discover all services, characteristics and descriptors, @return number of ATT requests
+static uint16_t discover(discovery_result_t * result){
+    uint16_t num_requests = mock_get_num_att_requests();
+    memset(result, 0, sizeof(discovery_result_t));
+    discovery_result = result;
+    query_complete = false;
+    check_query_complete(gatt_client_discover_primary_services(&handle_gatt_client_event, con_handle));
+    uint16_t num_services = result->num_services;
+    uint16_t i;
+    for (i = 0; i < num_services; i++){
+        check_query_complete(gatt_client_discover_characteristics_for_service(&handle_gatt_client_event, con_handle, &result->services[i]));
+    }
+    uint16_t num_characteristics = result->num_characteristics;
+    for (i = 0; i < num_characteristics; i++){
+        check_query_complete(gatt_client_discover_characteristic_descriptors(&handle_gatt_client_event, con_handle, &result->characteristics[i]));
+    }
+    return mock_get_num_att_requests() - num_requests;
+}
+
+static void check_equal_results(const discovery_result_t * a, const discovery_result_t * b){
+    CHECK_EQUAL(a->num_services, b->num_services);
+    CHECK_EQUAL(a->num_characteristics, b->num_characteristics);
+    CHECK_EQUAL(a->num_descriptors, b->num_descriptors);
+    MEMCMP_EQUAL(a->services, b->services, a->num_services * sizeof(gatt_client_service_t));
+    MEMCMP_EQUAL(a->characteristics, b->characteristics, a->num_characteristics * sizeof(gatt_client_characteristic_t));
+    MEMCMP_EQUAL(a->descriptors, b->descriptors, a->num_descriptors * sizeof(gatt_client_characteristic_descriptor_t));
+}
+
+TEST_GROUP(GATTClientDiscoveryCache){
+    discovery_result_t first;
+    discovery_result_t second;
+
+    void setup(void){
+        btstack_memory_init();
+        const btstack_tlv_t * tlv_impl = mock_btstack_tlv_init_instance(&tlv_context);
+        btstack_tlv_set_instance(tlv_impl, &tlv_context);
+        memset(database_hash, 0x11, sizeof(database_hash));
+        setup_db(false);
+        gatt_client_init();
+        con_handle = get_gatt_client_handle();
+    }
+    void teardown(void){
+        mock_btstack_tlv_deinit(&tlv_context);
+        btstack_tlv_set_instance(NULL, NULL);
+        btstack_memory_deinit();
+    }
+};
+
+TEST(GATTClientDiscoveryCache, ServeDiscoveryAfterReconnect){
+    connect();
+    uint16_t num_requests = discover(&first);
+    CHECK(num_requests > 0);
+    CHECK_EQUAL(3, first.num_services);
+    CHECK_EQUAL(4, first.num_characteristics);
+    mock_simulate_disconnected();
+
+    connect();
+    CHECK_EQUAL(0, discover(&second));
+    check_equal_results(&first, &second);
+}
+
+TEST(GATTClientDiscoveryCache, ServeRepeatedDiscoveryInSameConnection){
+    connect();
+    CHECK(discover(&first) > 0);
+    CHECK_EQUAL(0, discover(&second));
+    check_equal_results(&first, &second);
+}
+
+TEST(GATTClientDiscoveryCache, ServePrimaryServiceByUUID){
+    connect();
+    discovery_result_t result;
+    memset(&result, 0, sizeof(result));
+    discovery_result = &result;
+    check_query_complete(gatt_client_discover_primary_services_by_uuid16(&handle_gatt_client_event, con_handle, ORG_BLUETOOTH_SERVICE_HEART_RATE));
+    CHECK_EQUAL(1, result.num_services);
+    mock_simulate_disconnected();
+
+    connect();
+    uint16_t num_requests = mock_get_num_att_requests();
+    memset(&result, 0, sizeof(result));
+    check_query_complete(gatt_client_discover_primary_services_by_uuid16(&handle_gatt_client_event, con_handle, ORG_BLUETOOTH_SERVICE_HEART_RATE));
+    CHECK_EQUAL(1, result.num_services);
+    CHECK_EQUAL(ORG_BLUETOOTH_SERVICE_HEART_RATE, result.services[0].uuid16);
+    CHECK_EQUAL(num_requests, mock_get_num_att_requests());
+
+    // not cached yet
+    check_query_complete(gatt_client_discover_primary_services_by_uuid16(&handle_gatt_client_event, con_handle, ORG_BLUETOOTH_SERVICE_BATTERY_SERVICE));
+    CHECK(mock_get_num_att_requests() > num_requests);
+}
+
+TEST(GATTClientDiscoveryCache, DatabaseHashChanged){
+    connect();
+    CHECK(discover(&first) > 0);
+    mock_simulate_disconnected();
+
+    // add characteristic and update Database Hash
+    memset(database_hash, 0x22, sizeof(database_hash));
+    setup_db(true);
+    connect();
+    CHECK(discover(&second) > 0);
+    CHECK_EQUAL(first.num_characteristics + 1, second.num_characteristics);
+    mock_simulate_disconnected();
+
+    connect();
+    CHECK_EQUAL(0, discover(&first));
+    check_equal_results(&first, &second);
+}
+
+TEST(GATTClientDiscoveryCache, SkipResponsesLargerThanMtu){
+    connect();
+    CHECK(discover(&first) > 0);
+    mock_simulate_disconnected();
+
+    // cached responses don't fit into smaller MTU
+    connect();
+    gatt_client_t * gatt_client;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_get_client(con_handle, &gatt_client));
+    CHECK(gatt_client->discovery_cache != NULL);
+    gatt_client->mtu = 10;
+    CHECK(discover(&second) > 0);
+    check_equal_results(&first, &second);
+}
+
+TEST(GATTClientDiscoveryCache, ReadsNotCached){
+    connect();
+    CHECK(discover(&first) > 0);
+    uint16_t num_requests = mock_get_num_att_requests();
+    check_query_complete(gatt_client_read_value_of_characteristic(&handle_gatt_client_event, con_handle, &first.characteristics[2]));
+    check_query_complete(gatt_client_read_value_of_characteristic(&handle_gatt_client_event, con_handle, &first.characteristics[2]));
+    CHECK_EQUAL(num_requests + 2, mock_get_num_att_requests());
+}
+
+TEST(GATTClientDiscoveryCache, BondingDeleted){
+    connect();
+    CHECK(discover(&first) > 0);
+    mock_simulate_disconnected();
+
+    mock_simulate_bonding_deleted(0);
+
+    connect();
+    CHECK(discover(&second) > 0);
+    check_equal_results(&first, &second);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
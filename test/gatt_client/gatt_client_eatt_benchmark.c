@@ -0,0 +1,229 @@
+// Benchmark for GATT Client request pipelining over EATT
+//
+// Reads characteristic values queued with gatt_client_request_to_send_gatt_query over the unenhanced bearer
+// and over EATT with 1 to 5 channels (make benchmark). The mock delivers all pending ATT responses per round,
+// which simulates one round trip to the remote GATT Server.
+
+#define _POSIX_C_SOURCE 200809
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ble/att_db.h"
+#include "ble/att_db_util.h"
+#include "ble/gatt_client.h"
+#include "bluetooth_gatt.h"
+#include "btstack_crypto.h"
+#include "btstack_event.h"
+#include "btstack_memory.h"
+#include "btstack_util.h"
+
+#define NUM_CHARACTERISTICS 100
+#define VALUE_LEN            20
+#define MAX_EATT_CHANNELS     5
+#define EATT_BUFFER_SIZE    200
+
+// mock.c
+void hci_setup_le_connection(uint16_t con_handle);
+uint16_t get_gatt_client_handle(void);
+void mock_set_deferred_responses(bool deferred);
+uint16_t mock_deliver_responses(void);
+void mock_simulate_disconnected(void);
+
+static hci_con_handle_t con_handle;
+static uint8_t server_supported_features = 0x01;   // EATT
+static uint8_t client_supported_features;
+static uint8_t characteristic_values[NUM_CHARACTERISTICS][VALUE_LEN];
+static uint16_t value_handles[NUM_CHARACTERISTICS];
+static btstack_context_callback_registration_t read_requests[NUM_CHARACTERISTICS];
+static btstack_context_callback_registration_t setup_request;
+static uint8_t eatt_storage[MAX_EATT_CHANNELS * EATT_BUFFER_SIZE];
+
+static bool setup_done;
+static bool eatt_connected;
+static uint16_t num_reads_completed;
+static uint16_t num_errors;
+
+// database hash not needed
+void btstack_crypto_aes128_cmac_generator(btstack_crypto_aes128_cmac_t * request, const uint8_t * key, uint16_t size, uint8_t (*get_byte_callback)(uint16_t pos), uint8_t * hash, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    UNUSED(key);
+    UNUSED(size);
+    UNUSED(get_byte_callback);
+    UNUSED(hash);
+    UNUSED(callback);
+    UNUSED(callback_arg);
+}
+
+static uint64_t get_time_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000u) + ((uint64_t) ts.tv_nsec / 1000u);
+}
+
+static int att_write_callback(hci_con_handle_t connection_handle, uint16_t att_handle, uint16_t transaction_mode, uint16_t offset, uint8_t *buffer, uint16_t buffer_size){
+    UNUSED(connection_handle);
+    UNUSED(att_handle);
+    UNUSED(transaction_mode);
+    UNUSED(offset);
+    if (buffer_size > 0u){
+        client_supported_features = buffer[0];
+    }
+    return 0;
+}
+
+static void setup_db(void){
+    att_db_util_init();
+    att_db_util_add_service_uuid16(ORG_BLUETOOTH_SERVICE_GENERIC_ATTRIBUTE);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_SERVER_SUPPORTED_FEATURES, ATT_PROPERTY_READ,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, &server_supported_features, 1);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_CLIENT_SUPPORTED_FEATURES, ATT_PROPERTY_READ | ATT_PROPERTY_WRITE | ATT_PROPERTY_DYNAMIC,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, &client_supported_features, 1);
+    att_db_util_add_service_uuid16(0x1810);
+    uint16_t i;
+    for (i = 0; i < NUM_CHARACTERISTICS; i++){
+        memset(characteristic_values[i], (uint8_t) i, VALUE_LEN);
+        value_handles[i] = att_db_util_add_characteristic_uuid16(0x2a00 + i, ATT_PROPERTY_READ, ATT_SECURITY_NONE, ATT_SECURITY_NONE,
+                                                                 characteristic_values[i], VALUE_LEN);
+    }
+    att_set_db(att_db_util_get_address());
+    att_set_write_callback(&att_write_callback);
+}
+
+static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    switch (hci_event_packet_get_type(packet)){
+        case GATT_EVENT_CONNECTED:
+            if (gatt_event_connected_get_status(packet) != ERROR_CODE_SUCCESS){
+                num_errors++;
+            }
+            eatt_connected = true;
+            break;
+        default:
+            break;
+    }
+}
+
+static void handle_read_event(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    uint16_t value_handle;
+    uint16_t index;
+    switch (hci_event_packet_get_type(packet)){
+        case GATT_EVENT_CHARACTERISTIC_VALUE_QUERY_RESULT:
+            value_handle = gatt_event_characteristic_value_query_result_get_value_handle(packet);
+            for (index = 0; index < NUM_CHARACTERISTICS; index++){
+                if (value_handles[index] == value_handle) break;
+            }
+            if ((index == NUM_CHARACTERISTICS) ||
+                (gatt_event_characteristic_value_query_result_get_value_length(packet) != VALUE_LEN) ||
+                (memcmp(gatt_event_characteristic_value_query_result_get_value(packet), characteristic_values[index], VALUE_LEN) != 0)){
+                num_errors++;
+            }
+            break;
+        case GATT_EVENT_QUERY_COMPLETE:
+            if (gatt_event_query_complete_get_att_status(packet) != ATT_ERROR_SUCCESS){
+                num_errors++;
+            }
+            num_reads_completed++;
+            break;
+        default:
+            break;
+    }
+}
+
+static void handle_setup_done(void * context){
+    UNUSED(context);
+    setup_done = true;
+}
+
+static void send_read_request(void * context){
+    uint16_t index = (uint16_t) (uintptr_t) context;
+    uint8_t status = gatt_client_read_value_of_characteristic_using_value_handle(&handle_read_event, con_handle, value_handles[index]);
+    if (status != ERROR_CODE_SUCCESS){
+        num_errors++;
+    }
+}
+
+static uint32_t run_until(bool * done){
+    uint32_t num_rounds = 0;
+    while (*done == false){
+        if (mock_deliver_responses() == 0u){
+            num_errors++;
+            break;
+        }
+        num_rounds++;
+    }
+    return num_rounds;
+}
+
+static void benchmark(uint8_t num_channels){
+    hci_setup_le_connection(con_handle);
+
+    // service discovery and MTU exchange
+    setup_done = false;
+    setup_request.callback = &handle_setup_done;
+    (void) gatt_client_request_to_send_gatt_query(&setup_request, con_handle);
+    (void) run_until(&setup_done);
+
+    if (num_channels > 0u){
+        eatt_connected = false;
+        uint8_t status = gatt_client_le_enhanced_connect(&handle_gatt_client_event, con_handle, num_channels, eatt_storage, num_channels * EATT_BUFFER_SIZE);
+        if (status != ERROR_CODE_SUCCESS){
+            num_errors++;
+            return;
+        }
+        (void) run_until(&eatt_connected);
+    }
+
+    // queue all reads
+    num_reads_completed = 0;
+    uint64_t start_us = get_time_us();
+    uint16_t i;
+    for (i = 0; i < NUM_CHARACTERISTICS; i++){
+        read_requests[i].callback = &send_read_request;
+        read_requests[i].context = (void *) (uintptr_t) i;
+        (void) gatt_client_request_to_send_gatt_query(&read_requests[i], con_handle);
+    }
+    uint32_t num_rounds = 0;
+    while (num_reads_completed < NUM_CHARACTERISTICS){
+        if (mock_deliver_responses() == 0u){
+            num_errors++;
+            break;
+        }
+        num_rounds++;
+    }
+    uint64_t duration_us = get_time_us() - start_us;
+
+    if (num_channels == 0u){
+        printf("unenhanced bearer: ");
+    } else {
+        printf("EATT, %u channel%s:  ", num_channels, (num_channels == 1u) ? " " : "s");
+    }
+    printf("%u reads in %4u round trips, %6u us\n", num_reads_completed, (unsigned int) num_rounds, (unsigned int) duration_us);
+
+    mock_simulate_disconnected();
+}
+
+int main(void){
+    btstack_memory_init();
+    setup_db();
+    gatt_client_init();
+    mock_set_deferred_responses(true);
+    con_handle = get_gatt_client_handle();
+
+    uint8_t num_channels;
+    for (num_channels = 0; num_channels <= MAX_EATT_CHANNELS; num_channels++){
+        benchmark(num_channels);
+    }
+    if (num_errors > 0u){
+        printf("%u errors\n", num_errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,261 @@
+// *****************************************************************************
+//
+// GATT Client over EATT tests
+//
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "ble/att_db.h"
+#include "ble/att_db_util.h"
+#include "ble/gatt_client.h"
+#include "bluetooth_gatt.h"
+#include "btstack_crypto.h"
+#include "btstack_event.h"
+#include "btstack_memory.h"
+#include "btstack_util.h"
+
+#define NUM_CHARACTERISTICS   5
+#define VALUE_LEN            20
+#define MAX_EATT_CHANNELS     5
+#define EATT_BUFFER_SIZE    200
+
+// mock.c
+extern "C" void hci_setup_le_connection(uint16_t con_handle);
+extern "C" uint16_t get_gatt_client_handle(void);
+extern "C" void mock_set_deferred_responses(bool deferred);
+extern "C" uint16_t mock_deliver_responses(void);
+extern "C" void mock_simulate_disconnected(void);
+extern "C" void mock_set_eatt_remote_mtu(uint16_t remote_mtu);
+extern "C" void mock_set_eatt_num_refused_channels(uint8_t num_channels);
+
+static hci_con_handle_t con_handle;
+static uint8_t server_supported_features = 0x01;   // EATT
+static uint8_t client_supported_features;
+static uint8_t characteristic_values[NUM_CHARACTERISTICS][VALUE_LEN];
+static uint16_t value_handles[NUM_CHARACTERISTICS];
+static uint8_t eatt_storage[MAX_EATT_CHANNELS * EATT_BUFFER_SIZE];
+
+static btstack_context_callback_registration_t setup_request;
+static btstack_context_callback_registration_t read_requests[NUM_CHARACTERISTICS];
+
+static bool setup_done;
+static uint16_t num_connected_events;
+static uint8_t connected_status;
+static uint16_t num_disconnected_events;
+static uint16_t num_reads_completed;
+static uint16_t num_reregister_callbacks;
+
+// database hash not needed
+extern "C" void btstack_crypto_aes128_cmac_generator(btstack_crypto_aes128_cmac_t * request, const uint8_t * key, uint16_t size, uint8_t (*get_byte_callback)(uint16_t pos), uint8_t * hash, void (* callback)(void * arg), void * callback_arg){
+    UNUSED(request);
+    UNUSED(key);
+    UNUSED(size);
+    UNUSED(get_byte_callback);
+    UNUSED(hash);
+    UNUSED(callback);
+    UNUSED(callback_arg);
+}
+
+static int att_write_callback(hci_con_handle_t connection_handle, uint16_t att_handle, uint16_t transaction_mode, uint16_t offset, uint8_t *buffer, uint16_t buffer_size){
+    UNUSED(connection_handle);
+    UNUSED(att_handle);
+    UNUSED(transaction_mode);
+    UNUSED(offset);
+    if (buffer_size > 0u){
+        client_supported_features = buffer[0];
+    }
+    return 0;
+}
+
+static void setup_db(void){
+    att_db_util_init();
+    att_db_util_add_service_uuid16(ORG_BLUETOOTH_SERVICE_GENERIC_ATTRIBUTE);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_SERVER_SUPPORTED_FEATURES, ATT_PROPERTY_READ,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, &server_supported_features, 1);
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_CLIENT_SUPPORTED_FEATURES, ATT_PROPERTY_READ | ATT_PROPERTY_WRITE | ATT_PROPERTY_DYNAMIC,
+                                          ATT_SECURITY_NONE, ATT_SECURITY_NONE, &client_supported_features, 1);
+    att_db_util_add_service_uuid16(0x1810);
+    uint16_t i;
+    for (i = 0; i < NUM_CHARACTERISTICS; i++){
+        memset(characteristic_values[i], (uint8_t) i, VALUE_LEN);
+        value_handles[i] = att_db_util_add_characteristic_uuid16(0x2a00 + i, ATT_PROPERTY_READ, ATT_SECURITY_NONE, ATT_SECURITY_NONE,
+                                                                 characteristic_values[i], VALUE_LEN);
+    }
+    att_set_db(att_db_util_get_address());
+    att_set_write_callback(&att_write_callback);
+}
+
+static void handle_eatt_event(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    switch (hci_event_packet_get_type(packet)){
+        case GATT_EVENT_CONNECTED:
+            connected_status = gatt_event_connected_get_status(packet);
+            num_connected_events++;
+            break;
+        case GATT_EVENT_DISCONNECTED:
+            num_disconnected_events++;
+            break;
+        default:
+            break;
+    }
+}
+
+static void handle_read_event(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
+    UNUSED(channel);
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (hci_event_packet_get_type(packet) == GATT_EVENT_QUERY_COMPLETE){
+        num_reads_completed++;
+    }
+}
+
+static void handle_setup_done(void * context){
+    UNUSED(context);
+    setup_done = true;
+}
+
+static void send_read_request(void * context){
+    uint16_t index = (uint16_t) (uintptr_t) context;
+    uint8_t status = gatt_client_read_value_of_characteristic_using_value_handle(&handle_read_event, con_handle, value_handles[index]);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+}
+
+// re-registers itself without sending a query
+static void reregister_request(void * context){
+    btstack_context_callback_registration_t * request = (btstack_context_callback_registration_t *) context;
+    num_reregister_callbacks++;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_request_to_send_gatt_query(request, con_handle));
+}
+
+static void run_until(bool * done){
+    while (*done == false){
+        CHECK(mock_deliver_responses() > 0u);
+    }
+}
+
+static gatt_client_t * get_gatt_client(void){
+    gatt_client_t * gatt_client = NULL;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_get_client(con_handle, &gatt_client));
+    return gatt_client;
+}
+
+TEST_GROUP(GATTClientEATT){
+    bool connected;
+
+    void setup(void){
+        num_connected_events = 0;
+        connected_status = ERROR_CODE_COMMAND_DISALLOWED;
+        num_disconnected_events = 0;
+        num_reads_completed = 0;
+        num_reregister_callbacks = 0;
+        mock_set_eatt_remote_mtu(64);
+        mock_set_deferred_responses(true);
+        hci_setup_le_connection(con_handle);
+        connected = true;
+
+        // service discovery and MTU exchange
+        setup_done = false;
+        setup_request.callback = &handle_setup_done;
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_request_to_send_gatt_query(&setup_request, con_handle));
+        run_until(&setup_done);
+    }
+
+    void teardown(void){
+        if (connected){
+            mock_simulate_disconnected();
+        }
+    }
+
+    void connect_eatt(uint8_t num_channels){
+        uint8_t status = gatt_client_le_enhanced_connect(&handle_eatt_event, con_handle, num_channels, eatt_storage, num_channels * EATT_BUFFER_SIZE);
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+        while (num_connected_events == 0u){
+            CHECK(mock_deliver_responses() > 0u);
+        }
+    }
+};
+
+TEST(GATTClientEATT, connected_event_to_application){
+    connect_eatt(2);
+    CHECK_EQUAL(1, num_connected_events);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, connected_status);
+    CHECK_EQUAL(GATT_CLIENT_EATT_READY, get_gatt_client()->eatt_state);
+}
+
+TEST(GATTClientEATT, disconnected_event_to_application){
+    connect_eatt(2);
+    mock_simulate_disconnected();
+    connected = false;
+    CHECK_EQUAL(1, num_disconnected_events);
+}
+
+TEST(GATTClientEATT, remote_mtu_from_channel_opened){
+    mock_set_eatt_remote_mtu(100);
+    connect_eatt(2);
+    gatt_client_t * gatt_client = get_gatt_client();
+    CHECK_EQUAL(2, btstack_linked_list_count(&gatt_client->eatt_clients));
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &gatt_client->eatt_clients);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        gatt_client_t * eatt_client = (gatt_client_t *) btstack_linked_list_iterator_next(&it);
+        CHECK_EQUAL(P_READY, eatt_client->state);
+        CHECK_EQUAL(100, eatt_client->mtu);
+    }
+}
+
+TEST(GATTClientEATT, refused_channels_freed){
+    mock_set_eatt_num_refused_channels(2);
+    connect_eatt(4);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, connected_status);
+    gatt_client_t * gatt_client = get_gatt_client();
+    CHECK_EQUAL(2, btstack_linked_list_count(&gatt_client->eatt_clients));
+    btstack_linked_list_iterator_t it;
+    btstack_linked_list_iterator_init(&it, &gatt_client->eatt_clients);
+    while (btstack_linked_list_iterator_has_next(&it)){
+        gatt_client_t * eatt_client = (gatt_client_t *) btstack_linked_list_iterator_next(&it);
+        CHECK_EQUAL(P_READY, eatt_client->state);
+    }
+}
+
+TEST(GATTClientEATT, queued_requests_use_all_channels){
+    connect_eatt(3);
+    uint16_t i;
+    for (i = 0; i < NUM_CHARACTERISTICS; i++){
+        read_requests[i].callback = &send_read_request;
+        read_requests[i].context = (void *) (uintptr_t) i;
+        CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_request_to_send_gatt_query(&read_requests[i], con_handle));
+    }
+    // one read per channel per round trip
+    CHECK_EQUAL(3, mock_deliver_responses());
+    CHECK_EQUAL(3, num_reads_completed);
+    CHECK_EQUAL(2, mock_deliver_responses());
+    CHECK_EQUAL(NUM_CHARACTERISTICS, num_reads_completed);
+}
+
+TEST(GATTClientEATT, reregister_without_query){
+    connect_eatt(1);
+    btstack_context_callback_registration_t request;
+    request.callback = &reregister_request;
+    request.context = &request;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_request_to_send_gatt_query(&request, con_handle));
+    CHECK_EQUAL(1, num_reregister_callbacks);
+    // still queued, served again once a channel becomes ready
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, gatt_client_remove_gatt_query(&request, con_handle));
+}
+
+int main (int argc, const char * argv[]){
+    btstack_memory_init();
+    setup_db();
+    gatt_client_init();
+    con_handle = get_gatt_client_handle();
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -8,6 +8,7 @@
 
 #include "ble/att_db.h"
 #include "ble/sm.h"
+#include "bluetooth_psm.h"
 #include "gap.h"
 #include "btstack_debug.h"
 
@@ -25,6 +26,23 @@ static hci_connection_t hci_connection;
 static uint8_t packet_buffer[256];
 static uint16_t packet_buffer_len;
 
+// deferred ATT responses, delivered by mock_deliver_responses to simulate round trips
+#define MOCK_MAX_PENDING_RESPONSES 8
+#define MOCK_EATT_MTU 64
+#define MOCK_EATT_MAX_MTU 128
+typedef struct {
+	uint16_t cid;
+	uint16_t len;
+	uint8_t  data[PREBUFFER_SIZE + MOCK_EATT_MAX_MTU];
+} mock_pending_response_t;
+
+uint16_t mock_deliver_responses(void);
+
+static bool mock_deferred_responses;
+static uint16_t mock_num_att_requests;
+static mock_pending_response_t mock_pending_responses[MOCK_MAX_PENDING_RESPONSES];
+static uint8_t mock_num_pending_responses;
+
 uint16_t get_gatt_client_handle(void){
 	return gatt_client_handle;
 }
@@ -75,6 +93,13 @@ void mock_simulate_scan_response(void){
 	registered_hci_event_handler(HCI_EVENT_PACKET, 0, (uint8_t *)&packet, sizeof(packet));
 }
 
+void mock_simulate_bonding_deleted(uint8_t le_device_db_index){
+	uint8_t event[13] = { HCI_EVENT_META_GAP, 11, GAP_SUBEVENT_BONDING_DELETED };
+	event[10] = le_device_db_index;
+	little_endian_store_16(event, 11, gatt_client_handle);
+	registered_hci_event_handler(HCI_EVENT_PACKET, 0, event, sizeof(event));
+}
+
 bool gap_authenticated(hci_con_handle_t con_handle){
 	UNUSED(con_handle);
 	return false;
@@ -167,6 +192,8 @@ void hci_add_event_handler(btstack_packet_callback_registration_t * callback_han
 
 void l2cap_reserve_packet_buffer(void){}
 
+void l2cap_release_packet_buffer(void){}
+
 static bool _l2cap_can_send_fixed_channel_packet_now = true;
 
 void l2cap_set_can_send_fixed_channel_packet_now(bool value){
@@ -182,9 +209,29 @@ void l2cap_request_can_send_fix_channel_now_event(uint16_t handle, uint16_t chan
 	att_packet_handler(HCI_EVENT_PACKET, 0, (uint8_t*)event, sizeof(event));
 }
 
+static void mock_queue_response(att_connection_t * att_connection, uint16_t cid, const uint8_t * request, uint16_t request_len){
+	btstack_assert(mock_num_pending_responses < MOCK_MAX_PENDING_RESPONSES);
+	mock_pending_response_t * pending = &mock_pending_responses[mock_num_pending_responses];
+	uint16_t response_len = att_handle_request(att_connection, (uint8_t *) request, request_len, &pending->data[PREBUFFER_SIZE]);
+	if (response_len){
+		pending->cid = cid;
+		pending->len = response_len;
+		mock_num_pending_responses++;
+	}
+}
+
+uint16_t mock_get_num_att_requests(void){
+	return mock_num_att_requests;
+}
+
 uint8_t l2cap_send_prepared_connectionless(uint16_t handle, uint16_t cid, uint16_t len){
+	mock_num_att_requests++;
 	att_connection_t att_connection;
 	att_init_connection(&att_connection);
+	if (mock_deferred_responses){
+		mock_queue_response(&att_connection, L2CAP_CID_ATTRIBUTE_PROTOCOL, l2cap_get_outgoing_buffer(), len);
+		return ERROR_CODE_SUCCESS;
+	}
 	uint8_t response_buffer[PREBUFFER_SIZE + TEST_MAX_MTU];
 	uint8_t * response = &response_buffer[PREBUFFER_SIZE];
 	uint16_t response_len = att_handle_request(&att_connection, l2cap_get_outgoing_buffer(), len, response);
@@ -194,6 +241,144 @@ uint8_t l2cap_send_prepared_connectionless(uint16_t handle, uint16_t cid, uint16
 	return ERROR_CODE_SUCCESS;
 }
 
+#ifdef ENABLE_GATT_OVER_EATT
+#define MOCK_EATT_FIRST_CID 0x41
+#define MOCK_EATT_MAX_OPEN_CHANNELS 8
+static btstack_packet_handler_t mock_ecbm_packet_handler;
+static uint8_t mock_ecbm_num_pending_channels;
+static uint8_t mock_ecbm_num_refused_channels;
+static uint8_t mock_ecbm_num_pending_refused_channels;
+static uint16_t mock_ecbm_remote_mtu = MOCK_EATT_MTU;
+static uint16_t mock_ecbm_next_cid = MOCK_EATT_FIRST_CID;
+static uint16_t mock_ecbm_open_cids[MOCK_EATT_MAX_OPEN_CHANNELS];
+static uint8_t mock_ecbm_num_open_cids;
+
+// remote MTU reported in channel opened events, also used by the mock server on EATT channels
+void mock_set_eatt_remote_mtu(uint16_t remote_mtu){
+	btstack_assert(remote_mtu <= MOCK_EATT_MAX_MTU);
+	mock_ecbm_remote_mtu = remote_mtu;
+}
+
+// refuse the last channels of the next l2cap_ecbm_create_channels call
+void mock_set_eatt_num_refused_channels(uint8_t num_channels){
+	mock_ecbm_num_refused_channels = num_channels;
+}
+
+uint8_t l2cap_ecbm_create_channels(btstack_packet_handler_t packet_handler, hci_con_handle_t con_handle,
+                                   gap_security_level_t security_level,
+                                   uint16_t psm, uint8_t num_channels, uint16_t initial_credits, uint16_t receive_buffer_size,
+                                   uint8_t ** receive_buffers, uint16_t * out_local_cids){
+	UNUSED(con_handle);
+	UNUSED(security_level);
+	UNUSED(psm);
+	UNUSED(initial_credits);
+	UNUSED(receive_buffer_size);
+	UNUSED(receive_buffers);
+	mock_ecbm_packet_handler = packet_handler;
+	uint8_t i;
+	for (i = 0; i < num_channels; i++){
+		out_local_cids[i] = mock_ecbm_next_cid + i;
+	}
+	// channel opened events are delivered with next responses
+	mock_ecbm_num_pending_channels = num_channels;
+	mock_ecbm_num_pending_refused_channels = btstack_min(mock_ecbm_num_refused_channels, num_channels);
+	mock_ecbm_num_refused_channels = 0;
+	return ERROR_CODE_SUCCESS;
+}
+
+uint8_t l2cap_send(uint16_t local_cid, const uint8_t *data, uint16_t len){
+	att_connection_t att_connection;
+	att_init_connection(&att_connection);
+	att_connection.mtu = mock_ecbm_remote_mtu;
+	att_connection.max_mtu = mock_ecbm_remote_mtu;
+	mock_queue_response(&att_connection, local_cid, data, len);
+	if (mock_deferred_responses == false){
+		mock_deliver_responses();
+	}
+	return ERROR_CODE_SUCCESS;
+}
+
+uint8_t l2cap_disconnect(uint16_t local_cid){
+	UNUSED(local_cid);
+	return ERROR_CODE_SUCCESS;
+}
+
+static void mock_ecbm_emit_channel_opened(uint16_t local_cid, uint8_t status){
+	uint8_t event[25];
+	memset(event, 0, sizeof(event));
+	event[0] = L2CAP_EVENT_ECBM_CHANNEL_OPENED;
+	event[1] = sizeof(event) - 2;
+	event[2] = status;
+	little_endian_store_16(event, 10, gatt_client_handle);
+	little_endian_store_16(event, 13, BLUETOOTH_PSM_EATT);
+	little_endian_store_16(event, 15, local_cid);
+	little_endian_store_16(event, 17, local_cid);
+	little_endian_store_16(event, 19, MOCK_EATT_MTU);
+	little_endian_store_16(event, 21, mock_ecbm_remote_mtu);
+	if (status == ERROR_CODE_SUCCESS){
+		btstack_assert(mock_ecbm_num_open_cids < MOCK_EATT_MAX_OPEN_CHANNELS);
+		mock_ecbm_open_cids[mock_ecbm_num_open_cids++] = local_cid;
+	}
+	(*mock_ecbm_packet_handler)(HCI_EVENT_PACKET, 0, event, sizeof(event));
+}
+#endif
+
+void mock_simulate_disconnected(void){
+	mock_num_pending_responses = 0;
+#ifdef ENABLE_GATT_OVER_EATT
+	mock_ecbm_num_pending_channels = 0;
+	uint8_t num_open_cids = mock_ecbm_num_open_cids;
+	mock_ecbm_num_open_cids = 0;
+	uint8_t i;
+	for (i = 0; i < num_open_cids; i++){
+		uint8_t event[4] = { L2CAP_EVENT_CHANNEL_CLOSED, 2, 0, 0 };
+		little_endian_store_16(event, 2, mock_ecbm_open_cids[i]);
+		(*mock_ecbm_packet_handler)(HCI_EVENT_PACKET, 0, event, sizeof(event));
+	}
+#endif
+	uint8_t event[6] = { HCI_EVENT_DISCONNECTION_COMPLETE, 4, 0, 0, 0, 0 };
+	little_endian_store_16(event, 3, gatt_client_handle);
+	registered_hci_event_handler(HCI_EVENT_PACKET, 0, event, sizeof(event));
+}
+
+void mock_set_deferred_responses(bool deferred){
+	mock_deferred_responses = deferred;
+}
+
+// deliver all pending responses, returns number of delivered responses
+uint16_t mock_deliver_responses(void){
+	mock_pending_response_t responses[MOCK_MAX_PENDING_RESPONSES];
+	uint8_t num_responses = mock_num_pending_responses;
+	memcpy(responses, mock_pending_responses, num_responses * sizeof(mock_pending_response_t));
+	mock_num_pending_responses = 0;
+	uint16_t num_delivered = num_responses;
+#ifdef ENABLE_GATT_OVER_EATT
+	uint8_t num_channels = mock_ecbm_num_pending_channels;
+	mock_ecbm_num_pending_channels = 0;
+	uint8_t i;
+	uint8_t num_refused = mock_ecbm_num_pending_refused_channels;
+	mock_ecbm_num_pending_refused_channels = 0;
+	for (i = 0; i < num_channels; i++){
+		uint8_t status = (i < (num_channels - num_refused)) ? ERROR_CODE_SUCCESS : ERROR_CODE_CONNECTION_REJECTED_DUE_TO_LIMITED_RESOURCES;
+		mock_ecbm_emit_channel_opened(mock_ecbm_next_cid + i, status);
+	}
+	mock_ecbm_next_cid += num_channels;
+	num_delivered += num_channels;
+#endif
+	uint8_t j;
+	for (j = 0; j < num_responses; j++){
+		uint8_t * response = &responses[j].data[PREBUFFER_SIZE];
+		if (responses[j].cid == L2CAP_CID_ATTRIBUTE_PROTOCOL){
+			att_packet_handler(ATT_DATA_PACKET, gatt_client_handle, response, responses[j].len);
+#ifdef ENABLE_GATT_OVER_EATT
+		} else {
+			(*mock_ecbm_packet_handler)(L2CAP_DATA_PACKET, responses[j].cid, response, responses[j].len);
+#endif
+		}
+	}
+	return num_delivered;
+}
+
 void sm_add_event_handler(btstack_packet_callback_registration_t * callback_handler){
 }
 
@@ -36,6 +36,10 @@ extern "C" void mock_call_att_packet_handler(uint8_t packet_type, uint16_t chann
 extern "C" void mock_l2cap_set_max_mtu(uint16_t mtu);
 extern "C" void hci_setup_classic_connection(uint16_t con_handle);
 extern "C" void set_cmac_ready(int ready);
+extern "C" bool mock_fire_timer(void);
+extern "C" uint16_t mock_get_num_sent_pdus(void);
+extern "C" const uint8_t * mock_get_last_sent_pdu(uint16_t * len);
+extern "C" void mock_sm_set_le_device_index(int le_device_index);
 
 static uint8_t att_request[255];
 static uint16_t att_write_request(uint16_t request_type, uint16_t attribute_handle, uint16_t value_length, const uint8_t * value){
@@ -666,6 +670,192 @@ TEST(ATT_SERVER, att_server_register_service_handler) {
     att_server_register_service_handler(&test_service);
 }   
 
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+static void enable_multiple_handle_value_notifications(hci_con_handle_t con_handle, uint8_t client_supported_features){
+    att_db_util_add_characteristic_uuid16(ORG_BLUETOOTH_CHARACTERISTIC_CLIENT_SUPPORTED_FEATURES, ATT_PROPERTY_READ | ATT_PROPERTY_WRITE | ATT_PROPERTY_DYNAMIC, ATT_SECURITY_NONE, ATT_SECURITY_NONE, &battery_level, 1);
+    uint16_t csf_handle = gatt_server_get_value_handle_for_characteristic_with_uuid16(0, 0xffff, ORG_BLUETOOTH_CHARACTERISTIC_CLIENT_SUPPORTED_FEATURES);
+    uint16_t att_request_len = att_write_request(ATT_WRITE_REQUEST, csf_handle, 1, &client_supported_features);
+    mock_call_att_server_packet_handler(ATT_DATA_PACKET, con_handle, &att_request[0], att_request_len);
+    // 30 ms connection interval
+    hci_connection_for_handle(con_handle)->le_connection_interval = 24;
+}
+
+static uint16_t notification_value_handle(uint16_t uuid16){
+    return gatt_server_get_value_handle_for_characteristic_with_uuid16(0, 0xffff, uuid16);
+}
+
+TEST(ATT_SERVER, notification_coalescing_requires_client_support){
+    enable_multiple_handle_value_notifications(att_con_handle, 0x02);
+    static uint8_t value[] = {0x55};
+    uint16_t num_sent_pdus = mock_get_num_sent_pdus();
+    uint8_t status = att_server_notify(att_con_handle, notification_value_handle(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL_STATE), value, 1);
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, status);
+    CHECK_EQUAL(num_sent_pdus + 1, mock_get_num_sent_pdus());
+    uint16_t pdu_len;
+    const uint8_t * pdu = mock_get_last_sent_pdu(&pdu_len);
+    CHECK_EQUAL(ATT_HANDLE_VALUE_NOTIFICATION, pdu[0]);
+    CHECK_FALSE(mock_fire_timer());
+}
+
+TEST(ATT_SERVER, notification_coalescing_multiple_handle_value_notification){
+    enable_multiple_handle_value_notifications(att_con_handle, 0x06);
+    uint16_t handle_a = notification_value_handle(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL_STATE);
+    uint16_t handle_b = notification_value_handle(ORG_BLUETOOTH_CHARACTERISTIC_BODY_SENSOR_LOCATION);
+    static uint8_t value_a[] = {0x11, 0x22};
+    static uint8_t value_b[] = {0x33};
+    uint16_t num_sent_pdus = mock_get_num_sent_pdus();
+
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, handle_a, value_a, sizeof(value_a)));
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, handle_b, value_b, sizeof(value_b)));
+    CHECK_EQUAL(num_sent_pdus, mock_get_num_sent_pdus());
+
+    // sent after connection interval
+    CHECK_TRUE(mock_fire_timer());
+    CHECK_EQUAL(num_sent_pdus + 1, mock_get_num_sent_pdus());
+    uint16_t pdu_len;
+    const uint8_t * pdu = mock_get_last_sent_pdu(&pdu_len);
+    const uint8_t expected_pdu[] = { ATT_MULTIPLE_HANDLE_VALUE_NTF,
+        (uint8_t) handle_a, (uint8_t) (handle_a >> 8), 2, 0, 0x11, 0x22,
+        (uint8_t) handle_b, (uint8_t) (handle_b >> 8), 1, 0, 0x33 };
+    CHECK_EQUAL(sizeof(expected_pdu), pdu_len);
+    MEMCMP_EQUAL(expected_pdu, pdu, sizeof(expected_pdu));
+
+    // single queued notification sent as Handle Value Notification
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, handle_b, value_b, sizeof(value_b)));
+    CHECK_TRUE(mock_fire_timer());
+    pdu = mock_get_last_sent_pdu(&pdu_len);
+    const uint8_t expected_single_pdu[] = { ATT_HANDLE_VALUE_NOTIFICATION, (uint8_t) handle_b, (uint8_t) (handle_b >> 8), 0x33 };
+    CHECK_EQUAL(sizeof(expected_single_pdu), pdu_len);
+    MEMCMP_EQUAL(expected_single_pdu, pdu, sizeof(expected_single_pdu));
+    CHECK_FALSE(mock_fire_timer());
+}
+
+TEST(ATT_SERVER, notification_coalescing_up_to_mtu){
+    enable_multiple_handle_value_notifications(att_con_handle, 0x04);
+    uint16_t value_handle = notification_value_handle(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL_STATE);
+    static uint8_t value[] = {1, 2, 3, 4};
+    static uint8_t large_value[30];
+    uint16_t num_sent_pdus = mock_get_num_sent_pdus();
+    uint16_t pdu_len;
+    const uint8_t * pdu;
+
+    // ATT MTU 23: two notifications with 4 byte value fit, third one causes flush
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, value_handle, value, sizeof(value)));
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, value_handle, value, sizeof(value)));
+    CHECK_EQUAL(num_sent_pdus, mock_get_num_sent_pdus());
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, value_handle, value, sizeof(value)));
+    CHECK_EQUAL(num_sent_pdus + 1, mock_get_num_sent_pdus());
+    pdu = mock_get_last_sent_pdu(&pdu_len);
+    CHECK_EQUAL(ATT_MULTIPLE_HANDLE_VALUE_NTF, pdu[0]);
+    CHECK_EQUAL(17, pdu_len);
+
+    // value too large for Multiple Handle Value Notification: queued one sent first, then truncated notification
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, value_handle, large_value, sizeof(large_value)));
+    CHECK_EQUAL(num_sent_pdus + 3, mock_get_num_sent_pdus());
+    pdu = mock_get_last_sent_pdu(&pdu_len);
+    CHECK_EQUAL(ATT_HANDLE_VALUE_NOTIFICATION, pdu[0]);
+    CHECK_EQUAL(23, pdu_len);
+    CHECK_FALSE(mock_fire_timer());
+}
+
+TEST(ATT_SERVER, notification_coalescing_acl_buffers_full){
+    enable_multiple_handle_value_notifications(att_con_handle, 0x04);
+    uint16_t value_handle = notification_value_handle(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL_STATE);
+    static uint8_t value[] = {1, 2, 3, 4};
+    uint16_t num_sent_pdus = mock_get_num_sent_pdus();
+
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, value_handle, value, sizeof(value)));
+    l2cap_can_send_fixed_channel_packet_now_set_status(0);
+    CHECK_TRUE(mock_fire_timer());
+    CHECK_EQUAL(num_sent_pdus, mock_get_num_sent_pdus());
+
+    // still queued
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, value_handle, value, sizeof(value)));
+    CHECK_EQUAL(BTSTACK_ACL_BUFFERS_FULL, att_server_notify(att_con_handle, value_handle, value, sizeof(value)));
+    CHECK_EQUAL(num_sent_pdus, mock_get_num_sent_pdus());
+
+    // sent on can send now
+    l2cap_can_send_fixed_channel_packet_now_set_status(1);
+    uint8_t can_send_now_event[] = { L2CAP_EVENT_CAN_SEND_NOW, 2, 1, 0};
+    mock_call_att_server_packet_handler(HCI_EVENT_PACKET, 0, can_send_now_event, sizeof(can_send_now_event));
+    CHECK_EQUAL(num_sent_pdus + 1, mock_get_num_sent_pdus());
+    uint16_t pdu_len;
+    const uint8_t * pdu = mock_get_last_sent_pdu(&pdu_len);
+    CHECK_EQUAL(ATT_MULTIPLE_HANDLE_VALUE_NTF, pdu[0]);
+    CHECK_EQUAL(1 + 2 * (4 + sizeof(value)), pdu_len);
+}
+
+TEST(ATT_SERVER, notification_coalescing_disconnect){
+    enable_multiple_handle_value_notifications(att_con_handle, 0x04);
+    static uint8_t value[] = {0x55};
+    uint16_t num_sent_pdus = mock_get_num_sent_pdus();
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, notification_value_handle(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL_STATE), value, 1));
+
+    uint8_t buffer[6];
+    buffer[0] = HCI_EVENT_DISCONNECTION_COMPLETE;
+    buffer[1] = 4;
+    buffer[2] = 0;
+    little_endian_store_16(buffer, 3, att_con_handle);
+    mock_call_att_packet_handler(HCI_EVENT_PACKET, 0, &buffer[0], sizeof(buffer));
+    CHECK_FALSE(mock_fire_timer());
+    CHECK_EQUAL(num_sent_pdus, mock_get_num_sent_pdus());
+}
+
+TEST(ATT_SERVER, notification_coalescing_restored_on_reconnect){
+    // bonded device
+    mock_sm_set_le_device_index(0);
+    hci_setup_le_connection(att_con_handle);
+    uint8_t event[36];
+    memset(event, 0, sizeof(event));
+    event[0] = HCI_EVENT_META_GAP;
+    event[1] = sizeof(event) - 2;
+    event[2] = GAP_SUBEVENT_LE_CONNECTION_COMPLETE;
+    event[3] = ERROR_CODE_SUCCESS;
+    little_endian_store_16(event, 4, att_con_handle);
+    mock_call_att_packet_handler(HCI_EVENT_PACKET, 0, &event[0], sizeof(event));
+    enable_multiple_handle_value_notifications(att_con_handle, 0x04);
+
+    uint8_t buffer[6];
+    buffer[0] = HCI_EVENT_DISCONNECTION_COMPLETE;
+    buffer[1] = 4;
+    buffer[2] = 0;
+    little_endian_store_16(buffer, 3, att_con_handle);
+    mock_call_att_packet_handler(HCI_EVENT_PACKET, 0, &buffer[0], sizeof(buffer));
+
+    // reconnect, Client Supported Features restored when encrypted
+    hci_setup_le_connection(att_con_handle);
+    mock_call_att_packet_handler(HCI_EVENT_PACKET, 0, &event[0], sizeof(event));
+    CHECK_FALSE(hci_connection_for_handle(att_con_handle)->att_server.multiple_notifications_supported);
+    buffer[0] = HCI_EVENT_ENCRYPTION_CHANGE;
+    buffer[1] = 4;
+    buffer[2] = 0;
+    little_endian_store_16(buffer, 3, att_con_handle);
+    buffer[5] = 1;
+    mock_call_att_packet_handler(HCI_EVENT_PACKET, 0, &buffer[0], sizeof(buffer));
+    CHECK_TRUE(hci_connection_for_handle(att_con_handle)->att_server.multiple_notifications_supported);
+
+    // notification coalesced
+    static uint8_t value[] = {0x55};
+    uint16_t num_sent_pdus = mock_get_num_sent_pdus();
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, att_server_notify(att_con_handle, notification_value_handle(ORG_BLUETOOTH_CHARACTERISTIC_BATTERY_LEVEL_STATE), value, 1));
+    CHECK_EQUAL(num_sent_pdus, mock_get_num_sent_pdus());
+    CHECK_TRUE(mock_fire_timer());
+    CHECK_EQUAL(num_sent_pdus + 1, mock_get_num_sent_pdus());
+
+    // bonding deleted
+    memset(event, 0, sizeof(event));
+    event[0] = HCI_EVENT_META_GAP;
+    event[1] = 11;
+    event[2] = GAP_SUBEVENT_BONDING_DELETED;
+    // index 0
+    little_endian_store_16(event, 11, HCI_CON_HANDLE_INVALID);
+    mock_call_att_packet_handler(HCI_EVENT_PACKET, 0, &event[0], 13);
+    uint8_t client_supported_features;
+    CHECK_EQUAL(0, tlv_impl->get_tag(&tlv_context, ('B' << 24) | ('T' << 16) | ('F' << 8) | 0, &client_supported_features, 1));
+    mock_sm_set_le_device_index(-1);
+}
+#endif
+
 int main (int argc, const char * argv[]){
     return CommandLineTestRunner::RunAllTests(argc, argv);
 }
@@ -22,6 +22,10 @@ static uint16_t max_mtu = 23;
 static uint8_t  l2cap_stack_buffer[HCI_INCOMING_PRE_BUFFER_SIZE + 8 + ATT_DEFAULT_MTU];	// pre buffer + HCI Header + L2CAP header
 static uint16_t gatt_client_handle = 0x40;
 static hci_connection_t hci_connection;
+static uint8_t  sent_pdu[ATT_DEFAULT_MTU];
+static uint16_t sent_pdu_len;
+static uint16_t num_sent_pdus;
+static btstack_timer_source_t * active_timer;
 
 uint16_t get_gatt_client_handle(void){
 	return gatt_client_handle;
@@ -130,6 +134,13 @@ void hci_deinit(void){
     hci_connection.att_server.notification_requests = NULL;
     hci_connection.att_server.indication_requests = NULL;
     connections = NULL;
+    num_sent_pdus = 0;
+    active_timer = NULL;
+    hci_connection.le_connection_interval = 0;
+#ifdef ENABLE_ATT_NOTIFICATION_COALESCING
+    hci_connection.att_server.multiple_notifications_supported = false;
+    hci_connection.att_server.notification_coalescing_size = 0;
+#endif
 }
 
 void hci_add_event_handler(btstack_packet_callback_registration_t * callback_handler){
@@ -196,6 +207,9 @@ void l2cap_request_can_send_fix_channel_now_event(uint16_t handle, uint16_t chan
 }
 
 uint8_t l2cap_send_prepared_connectionless(uint16_t handle, uint16_t cid, uint16_t len){
+	sent_pdu_len = btstack_min(len, sizeof(sent_pdu));
+	memcpy(sent_pdu, l2cap_get_outgoing_buffer(), sent_pdu_len);
+	num_sent_pdus++;
 	att_connection_t att_connection;
     hci_setup_le_connection(handle);
 	uint8_t response[max_mtu];
@@ -222,8 +236,14 @@ void sm_cmac_signed_write_start(const sm_key_t key, uint8_t opcode, uint16_t att
 	// sm_notify_client(SM_EVENT_IDENTITY_RESOLVING_SUCCEEDED, sm_central_device_addr_type, sm_central_device_address, 0, sm_central_device_matched);      
 }
 
+static int mock_le_device_index = -1;
+
+void mock_sm_set_le_device_index(int le_device_index){
+	mock_le_device_index = le_device_index;
+}
+
 int sm_le_device_index(uint16_t handle ){
-	return -1;
+	return mock_le_device_index;
 }
 
 irk_lookup_state_t sm_identity_resolving_state(hci_con_handle_t con_handle){
@@ -238,16 +258,45 @@ void btstack_run_loop_set_timer(btstack_timer_source_t *a, uint32_t timeout_in_m
 
 // Set callback that will be executed when timer expires.
 void btstack_run_loop_set_timer_handler(btstack_timer_source_t *ts, void (*process)(btstack_timer_source_t *_ts)){
+    ts->process = process;
 }
 
 // Add/Remove timer source.
 void btstack_run_loop_add_timer(btstack_timer_source_t *timer){
+    active_timer = timer;
 }
 
 int  btstack_run_loop_remove_timer(btstack_timer_source_t *timer){
+    if (active_timer == timer){
+        active_timer = NULL;
+    }
 	return 1;
 }
 
+void btstack_run_loop_set_timer_context(btstack_timer_source_t *ts, void * context){
+    ts->context = context;
+}
+
+// fire last added timer
+bool mock_fire_timer(void){
+    btstack_timer_source_t * timer = active_timer;
+    if (timer == NULL){
+        return false;
+    }
+    active_timer = NULL;
+    (*timer->process)(timer);
+    return true;
+}
+
+uint16_t mock_get_num_sent_pdus(void){
+    return num_sent_pdus;
+}
+
+const uint8_t * mock_get_last_sent_pdu(uint16_t * len){
+    *len = sent_pdu_len;
+    return sent_pdu;
+}
+
 void * btstack_run_loop_get_timer_context(btstack_timer_source_t *ts){
     return ts->context;
 }
@@ -0,0 +1,177 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_util.h"
+#include "hci_dump.h"
+#include "hci_dump_posix_async.h"
+
+#define TEST_LOG_FILE "hci_dump_posix_async_test.log"
+
+static std::vector<uint8_t> read_log_file(void){
+    std::vector<uint8_t> content;
+    FILE * file = fopen(TEST_LOG_FILE, "rb");
+    CHECK(file != NULL);
+    uint8_t buffer[4096];
+    size_t len;
+    while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0){
+        content.insert(content.end(), buffer, buffer + len);
+    }
+    fclose(file);
+    return content;
+}
+
+typedef struct {
+    uint8_t  packet_type;
+    uint32_t cumulative_drops;
+    std::vector<uint8_t> payload;
+} btsnoop_record_t;
+
+static std::vector<btsnoop_record_t> parse_btsnoop(const std::vector<uint8_t> & content){
+    std::vector<btsnoop_record_t> records;
+    CHECK(content.size() >= 16);
+    MEMCMP_EQUAL("btsnoop", content.data(), 8);
+    size_t pos = 16;
+    while (pos < content.size()){
+        CHECK((pos + HCI_DUMP_HEADER_SIZE_BTSNOOP) <= content.size());
+        uint32_t len = big_endian_read_32(content.data(), pos);
+        btsnoop_record_t record;
+        record.cumulative_drops = big_endian_read_32(content.data(), pos + 12);
+        record.packet_type = content[pos + 15];
+        pos += HCI_DUMP_HEADER_SIZE_BTSNOOP;
+        CHECK((pos + len) <= content.size());
+        record.payload.assign(content.begin() + pos, content.begin() + pos + len);
+        pos += len;
+        records.push_back(record);
+    }
+    return records;
+}
+
+static std::vector<std::vector<uint8_t>> parse_packetlogger(const std::vector<uint8_t> & content){
+    std::vector<std::vector<uint8_t>> records;
+    size_t pos = 0;
+    while (pos < content.size()){
+        CHECK((pos + 4) <= content.size());
+        // length includes timestamp and type
+        uint32_t len = big_endian_read_32(content.data(), pos);
+        CHECK((pos + 4 + len) <= content.size());
+        records.push_back(std::vector<uint8_t>(content.begin() + pos + 4 + 9, content.begin() + pos + 4 + len));
+        pos += 4 + len;
+    }
+    return records;
+}
+
+static void log_acl_packet(uint32_t counter, uint16_t len){
+    uint8_t packet[1024];
+    memset(packet, 0, sizeof(packet));
+    little_endian_store_16(packet, 0, 0x0001);
+    little_endian_store_16(packet, 2, len - 4);
+    little_endian_store_32(packet, 4, counter);
+    hci_dump_packet(HCI_ACL_DATA_PACKET, 1, packet, len);
+}
+
+TEST_GROUP(HCIDumpPosixAsync){
+    void setup(void){
+        hci_dump_init(hci_dump_posix_async_get_instance());
+        hci_dump_set_max_packets(-1);
+    }
+    void teardown(void){
+        hci_dump_posix_async_close();
+        hci_dump_init(NULL);
+        remove(TEST_LOG_FILE);
+    }
+};
+
+TEST(HCIDumpPosixAsync, PacketsWrittenInOrder){
+    CHECK_EQUAL(0, hci_dump_posix_async_open(TEST_LOG_FILE, HCI_DUMP_BTSNOOP, 0));
+    uint32_t i;
+    for (i = 0; i < 100; i++){
+        log_acl_packet(i, 8 + (i % 50));
+    }
+    hci_dump_posix_async_close();
+
+    std::vector<btsnoop_record_t> records = parse_btsnoop(read_log_file());
+    CHECK_EQUAL(100, records.size());
+    for (i = 0; i < 100; i++){
+        CHECK_EQUAL(8 + (i % 50), records[i].payload.size());
+        CHECK_EQUAL(i, little_endian_read_32(records[i].payload.data(), 4));
+        CHECK_EQUAL(0, records[i].cumulative_drops);
+    }
+    CHECK_EQUAL(0, hci_dump_posix_async_get_num_dropped_records());
+}
+
+TEST(HCIDumpPosixAsync, OverflowReportedInCumulativeDrops){
+    CHECK_EQUAL(0, hci_dump_posix_async_open(TEST_LOG_FILE, HCI_DUMP_BTSNOOP, 256));
+    // record larger than ring buffer gets dropped
+    log_acl_packet(0, 300);
+    log_acl_packet(1, 300);
+    log_acl_packet(2, 20);
+    hci_dump_posix_async_close();
+
+    CHECK_EQUAL(2, hci_dump_posix_async_get_num_dropped_records());
+    std::vector<btsnoop_record_t> records = parse_btsnoop(read_log_file());
+    CHECK_EQUAL(1, records.size());
+    CHECK_EQUAL(2, little_endian_read_32(records[0].payload.data(), 4));
+    CHECK_EQUAL(2, records[0].cumulative_drops);
+}
+
+TEST(HCIDumpPosixAsync, OverflowReportedAsLogMessage){
+    CHECK_EQUAL(0, hci_dump_posix_async_open(TEST_LOG_FILE, HCI_DUMP_PACKETLOGGER, 256));
+    log_acl_packet(0, 300);
+    log_acl_packet(1, 20);
+    hci_dump_posix_async_close();
+
+    std::vector<std::vector<uint8_t>> records = parse_packetlogger(read_log_file());
+    CHECK_EQUAL(2, records.size());
+    const char * expected = "hci_dump_posix_async: 1 records dropped";
+    CHECK_EQUAL(strlen(expected), records[0].size());
+    MEMCMP_EQUAL(expected, records[0].data(), strlen(expected));
+    CHECK_EQUAL(1, little_endian_read_32(records[1].data(), 4));
+}
+
+TEST(HCIDumpPosixAsync, WrapAroundKeepsRecordsIntact){
+    CHECK_EQUAL(0, hci_dump_posix_async_open(TEST_LOG_FILE, HCI_DUMP_BTSNOOP, 1000));
+    const uint32_t num_packets = 20000;
+    uint32_t i;
+    for (i = 0; i < num_packets; i++){
+        log_acl_packet(i, 8 + (i % 97));
+    }
+    hci_dump_posix_async_close();
+
+    // all records intact and in order, gaps match drop counter
+    std::vector<btsnoop_record_t> records = parse_btsnoop(read_log_file());
+    uint32_t num_dropped = hci_dump_posix_async_get_num_dropped_records();
+    CHECK_EQUAL(num_packets, records.size() + num_dropped);
+    uint32_t expected_counter = 0;
+    for (const btsnoop_record_t & record : records){
+        uint32_t counter = little_endian_read_32(record.payload.data(), 4);
+        CHECK(counter >= expected_counter);
+        CHECK_EQUAL(8 + (counter % 97), record.payload.size());
+        // drops before this record
+        CHECK_EQUAL(counter - (&record - records.data()), record.cumulative_drops);
+        expected_counter = counter + 1;
+    }
+}
+
+TEST(HCIDumpPosixAsync, ResetAfterMaxPackets){
+    CHECK_EQUAL(0, hci_dump_posix_async_open(TEST_LOG_FILE, HCI_DUMP_BTSNOOP, 0));
+    hci_dump_set_max_packets(10);
+    uint32_t i;
+    for (i = 0; i < 15; i++){
+        log_acl_packet(i, 8);
+    }
+    hci_dump_posix_async_close();
+
+    // file restarted with BTSnoop header
+    std::vector<btsnoop_record_t> records = parse_btsnoop(read_log_file());
+    CHECK_EQUAL(5, records.size());
+    CHECK_EQUAL(10, little_endian_read_32(records[0].payload.data(), 4));
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
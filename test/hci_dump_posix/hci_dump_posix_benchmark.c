@@ -0,0 +1,99 @@
+// Benchmark for latency of hci_dump_packet with synchronous, asynchronous and memory-mapped file output
+//
+// Logs ACL packets in BTSnoop format at a fixed rate well above Bluetooth data rates and measures time
+// spent in hci_dump_packet per call
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "btstack_util.h"
+#include "hci_dump.h"
+#include "hci_dump_posix_async.h"
+#include "hci_dump_posix_fs.h"
+#include "hci_dump_posix_mmap.h"
+
+#define NUM_PACKETS     50000
+#define PACKET_INTERVAL_NS 20000
+#define ACL_PACKET_LEN  (4 + 251)
+#define LOG_FILE        "hci_dump_posix_benchmark.log"
+
+static uint32_t latencies_ns[NUM_PACKETS];
+
+static uint64_t get_time_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000u) + (uint64_t) ts.tv_nsec;
+}
+
+static int compare_uint32(const void * a, const void * b){
+    uint32_t value_a = *(const uint32_t *) a;
+    uint32_t value_b = *(const uint32_t *) b;
+    return (value_a > value_b) - (value_a < value_b);
+}
+
+static void log_packets(void){
+    uint8_t packet[ACL_PACKET_LEN];
+    memset(packet, 0x55, sizeof(packet));
+    little_endian_store_16(packet, 0, 0x0001);
+    little_endian_store_16(packet, 2, ACL_PACKET_LEN - 4);
+    uint64_t next_packet_ns = get_time_ns();
+    uint32_t i;
+    for (i = 0; i < NUM_PACKETS; i++){
+        while (get_time_ns() < next_packet_ns){
+        }
+        next_packet_ns += PACKET_INTERVAL_NS;
+        uint64_t start_ns = get_time_ns();
+        hci_dump_packet(HCI_ACL_DATA_PACKET, 1, packet, sizeof(packet));
+        latencies_ns[i] = (uint32_t) (get_time_ns() - start_ns);
+    }
+}
+
+static void report(const char * name, uint64_t total_ns, uint32_t num_dropped){
+    qsort(latencies_ns, NUM_PACKETS, sizeof(uint32_t), &compare_uint32);
+    uint64_t sum_ns = 0;
+    uint32_t i;
+    for (i = 0; i < NUM_PACKETS; i++){
+        sum_ns += latencies_ns[i];
+    }
+    printf("%-28s mean %5u ns, p99 %6u ns, max %8u ns per packet, total %u ms, %u dropped\n", name,
+           (unsigned int) (sum_ns / NUM_PACKETS), latencies_ns[(NUM_PACKETS * 99) / 100], latencies_ns[NUM_PACKETS - 1],
+           (unsigned int) (total_ns / 1000000u), num_dropped);
+}
+
+int main(void){
+    uint64_t start_ns;
+
+    hci_dump_posix_fs_open(LOG_FILE, HCI_DUMP_BTSNOOP);
+    hci_dump_init(hci_dump_posix_fs_get_instance());
+    start_ns = get_time_ns();
+    log_packets();
+    hci_dump_posix_fs_close();
+    report("hci_dump_posix_fs", get_time_ns() - start_ns, 0);
+
+    const uint32_t ring_buffer_sizes[] = { 0, 4 * 1024 * 1024 };
+    uint32_t i;
+    for (i = 0; i < (sizeof(ring_buffer_sizes) / sizeof(uint32_t)); i++){
+        char name[40];
+        snprintf(name, sizeof(name), "hci_dump_posix_async %4u kB", (unsigned int) ((ring_buffer_sizes[i] ? ring_buffer_sizes[i] : 256 * 1024) / 1024));
+        hci_dump_posix_async_open(LOG_FILE, HCI_DUMP_BTSNOOP, ring_buffer_sizes[i]);
+        hci_dump_init(hci_dump_posix_async_get_instance());
+        start_ns = get_time_ns();
+        log_packets();
+        hci_dump_posix_async_close();
+        report(name, get_time_ns() - start_ns, hci_dump_posix_async_get_num_dropped_records());
+    }
+
+    hci_dump_posix_mmap_open(LOG_FILE, 4 * 1024 * 1024);
+    hci_dump_init(hci_dump_posix_mmap_get_instance());
+    start_ns = get_time_ns();
+    log_packets();
+    hci_dump_posix_mmap_close();
+    report("hci_dump_posix_mmap 4096 kB", get_time_ns() - start_ns, 0);
+
+    remove(LOG_FILE);
+    return 0;
+}
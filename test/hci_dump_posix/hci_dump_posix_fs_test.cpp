@@ -0,0 +1,306 @@
+#include <dirent.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_util.h"
+#include "hci_dump.h"
+#include "hci_dump_posix_fs.h"
+
+static char test_dir[] = "/tmp/hci_dump_posix_fs_test_XXXXXX";
+
+static std::vector<std::string> list_log_files(void){
+    std::vector<std::string> files;
+    DIR * dir = opendir(test_dir);
+    CHECK(dir != NULL);
+    struct dirent * entry;
+    while ((entry = readdir(dir)) != NULL){
+        if (entry->d_name[0] == '.') continue;
+        files.push_back(std::string(test_dir) + "/" + entry->d_name);
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static std::vector<uint8_t> read_file(const std::string & path){
+    std::vector<uint8_t> content;
+    FILE * file = fopen(path.c_str(), "rb");
+    CHECK(file != NULL);
+    uint8_t buffer[4096];
+    size_t len;
+    while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0){
+        content.insert(content.end(), buffer, buffer + len);
+    }
+    fclose(file);
+    return content;
+}
+
+// returns counters of logged ACL packets
+static std::vector<uint32_t> parse_packetlogger(const std::vector<uint8_t> & content){
+    std::vector<uint32_t> counters;
+    size_t pos = 0;
+    while (pos < content.size()){
+        CHECK((pos + 4) <= content.size());
+        // length includes timestamp and type
+        uint32_t len = big_endian_read_32(content.data(), pos);
+        CHECK((pos + 4 + len) <= content.size());
+        counters.push_back(little_endian_read_32(content.data(), pos + 4 + 9 + 4));
+        pos += 4 + len;
+    }
+    return counters;
+}
+
+static std::vector<uint32_t> parse_btsnoop(const std::vector<uint8_t> & content){
+    std::vector<uint32_t> counters;
+    CHECK(content.size() >= 16);
+    MEMCMP_EQUAL("btsnoop", content.data(), 8);
+    size_t pos = 16;
+    while (pos < content.size()){
+        CHECK((pos + HCI_DUMP_HEADER_SIZE_BTSNOOP) <= content.size());
+        uint32_t len = big_endian_read_32(content.data(), pos);
+        pos += HCI_DUMP_HEADER_SIZE_BTSNOOP;
+        CHECK((pos + len) <= content.size());
+        counters.push_back(little_endian_read_32(content.data(), pos + 4));
+        pos += len;
+    }
+    return counters;
+}
+
+static void log_acl_packet(uint32_t counter){
+    uint8_t packet[100];
+    memset(packet, 0, sizeof(packet));
+    little_endian_store_16(packet, 0, 0x0001);
+    little_endian_store_16(packet, 2, sizeof(packet) - 4);
+    little_endian_store_32(packet, 4, counter);
+    hci_dump_packet(HCI_ACL_DATA_PACKET, 1, packet, sizeof(packet));
+}
+
+TEST_GROUP(HCIDumpPosixFs){
+    std::string log_file;
+    void setup(void){
+        strcpy(test_dir, "/tmp/hci_dump_posix_fs_test_XXXXXX");
+        CHECK(mkdtemp(test_dir) != NULL);
+        log_file = std::string(test_dir) + "/hci_dump.pklg";
+        hci_dump_init(hci_dump_posix_fs_get_instance());
+        hci_dump_set_max_packets(-1);
+    }
+    void teardown(void){
+        hci_dump_posix_fs_close();
+        hci_dump_posix_fs_set_rotation(0, 0, 0);
+        hci_dump_init(NULL);
+        for (const std::string & path : list_log_files()){
+            remove(path.c_str());
+        }
+        rmdir(test_dir);
+    }
+};
+
+TEST(HCIDumpPosixFs, RotationBySize){
+    hci_dump_posix_fs_set_rotation(1000, 0, 0);
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    uint32_t i;
+    for (i = 0; i < 50; i++){
+        log_acl_packet(i);
+    }
+    hci_dump_posix_fs_close();
+
+    // 8 packets of 117 bytes fit into 1000 bytes
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(7, files.size());
+    uint32_t expected_counter = 0;
+    for (const std::string & path : files){
+        std::vector<uint8_t> content = read_file(path);
+        CHECK(content.size() <= 1000);
+        CHECK_EQUAL(0, path.compare(path.size() - 5, 5, ".pklg"));
+        for (uint32_t counter : parse_packetlogger(content)){
+            CHECK_EQUAL(expected_counter, counter);
+            expected_counter++;
+        }
+    }
+    CHECK_EQUAL(50, expected_counter);
+}
+
+TEST(HCIDumpPosixFs, RetentionKeepsNewestFiles){
+    hci_dump_posix_fs_set_rotation(1000, 0, 3);
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    uint32_t i;
+    for (i = 0; i < 50; i++){
+        log_acl_packet(i);
+    }
+    hci_dump_posix_fs_close();
+
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(3, files.size());
+    CHECK_EQUAL(32, parse_packetlogger(read_file(files[0]))[0]);
+    CHECK_EQUAL(49, parse_packetlogger(read_file(files[2])).back());
+}
+
+TEST(HCIDumpPosixFs, OpenFailureDisablesRotation){
+    hci_dump_posix_fs_set_rotation(1000, 0, 3);
+    std::string missing_dir_file = std::string(test_dir) + "/missing/hci_dump.pklg";
+    CHECK_EQUAL(ENOENT, hci_dump_posix_fs_open(missing_dir_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    log_acl_packet(0);
+    CHECK_EQUAL(0, list_log_files().size());
+
+    // open afterwards works as usual
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    log_acl_packet(1);
+    hci_dump_posix_fs_close();
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(1, files.size());
+    CHECK_EQUAL(1, parse_packetlogger(read_file(files[0]))[0]);
+}
+
+TEST(HCIDumpPosixFs, OpenTwiceWithoutClose){
+    hci_dump_posix_fs_set_rotation(1000, 0, 1);
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    log_acl_packet(0);
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    log_acl_packet(1);
+    hci_dump_posix_fs_close();
+
+    // file of first open is closed but not part of the new retention list
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(2, files.size());
+    CHECK_EQUAL(0, parse_packetlogger(read_file(files[0]))[0]);
+    CHECK_EQUAL(1, parse_packetlogger(read_file(files[1]))[0]);
+}
+
+TEST(HCIDumpPosixFs, RotationRetriedAfterFailure){
+    hci_dump_posix_fs_set_rotation(1000, 0, 0);
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    uint32_t i;
+    for (i = 0; i < 8; i++){
+        log_acl_packet(i);
+    }
+
+    // remove directory, rotation on next packet fails
+    for (const std::string & path : list_log_files()){
+        remove(path.c_str());
+    }
+    CHECK_EQUAL(0, rmdir(test_dir));
+    for (i = 8; i < 20; i++){
+        log_acl_packet(i);
+    }
+
+    // retried at most once per second
+    CHECK_EQUAL(0, mkdir(test_dir, 0700));
+    sleep(1);
+    log_acl_packet(20);
+    hci_dump_posix_fs_close();
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(1, files.size());
+    std::vector<uint32_t> counters = parse_packetlogger(read_file(files[0]));
+    CHECK_EQUAL(1, counters.size());
+    CHECK_EQUAL(20, counters[0]);
+}
+
+TEST(HCIDumpPosixFs, TruncatedPacketKeepsOriginalLength){
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_BTSNOOP));
+    uint8_t packet[100];
+    memset(packet, 0, sizeof(packet));
+    little_endian_store_16(packet, 0, 0x0001);
+    little_endian_store_16(packet, 2, sizeof(packet) - 4);
+    hci_dump_posix_fs_get_instance()->log_packet_truncated(HCI_ACL_DATA_PACKET, 1, packet, 20, sizeof(packet));
+    hci_dump_posix_fs_close();
+
+    // original and included length
+    std::vector<uint8_t> content = read_file(log_file);
+    CHECK_EQUAL(16 + HCI_DUMP_HEADER_SIZE_BTSNOOP + 20, content.size());
+    CHECK_EQUAL(100, big_endian_read_32(content.data(), 16));
+    CHECK_EQUAL(20, big_endian_read_32(content.data(), 20));
+}
+
+TEST(HCIDumpPosixFs, RotationOnMaxPackets){
+    hci_dump_posix_fs_set_rotation(0, 0, 2);
+    CHECK_EQUAL(0, hci_dump_posix_fs_open(log_file.c_str(), HCI_DUMP_PACKETLOGGER));
+    hci_dump_set_max_packets(10);
+    uint32_t i;
+    for (i = 0; i < 25; i++){
+        log_acl_packet(i);
+    }
+    hci_dump_posix_fs_close();
+
+    // history before reset kept in previous file
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(2, files.size());
+    std::vector<uint32_t> previous = parse_packetlogger(read_file(files[0]));
+    std::vector<uint32_t> current  = parse_packetlogger(read_file(files[1]));
+    CHECK_EQUAL(10, previous.size());
+    CHECK_EQUAL(10, previous[0]);
+    CHECK_EQUAL(5, current.size());
+    CHECK_EQUAL(20, current[0]);
+}
+
+TEST(HCIDumpPosixFs, FlightRecorderKeepsNewestRecords){
+    CHECK_EQUAL(0, hci_dump_posix_fs_open_flight_recorder(log_file.c_str(), HCI_DUMP_BTSNOOP, 1000));
+    uint32_t i;
+    for (i = 0; i < 50; i++){
+        log_acl_packet(i);
+    }
+    CHECK(list_log_files().empty());
+    CHECK_EQUAL(0, hci_dump_posix_fs_flight_recorder_save());
+
+    // 7 records of 4 + 24 + 100 bytes fit into 1000 bytes
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(1, files.size());
+    std::vector<uint32_t> counters = parse_btsnoop(read_file(files[0]));
+    CHECK_EQUAL(7, counters.size());
+    for (i = 0; i < 7; i++){
+        CHECK_EQUAL(43 + i, counters[i]);
+    }
+}
+
+TEST(HCIDumpPosixFs, FlightRecorderSavedOnSnapshot){
+    CHECK_EQUAL(0, hci_dump_posix_fs_open_flight_recorder(log_file.c_str(), HCI_DUMP_PACKETLOGGER, 10000));
+    log_acl_packet(1);
+    log_acl_packet(2);
+    hci_dump_snapshot();
+    log_acl_packet(3);
+    hci_dump_snapshot();
+
+    // each snapshot creates new file with complete history, incl. log message about previous snapshot
+    std::vector<std::string> files = list_log_files();
+    CHECK_EQUAL(2, files.size());
+    CHECK_EQUAL(2, parse_packetlogger(read_file(files[0])).size());
+    CHECK_EQUAL(4, parse_packetlogger(read_file(files[1])).size());
+}
+
+TEST(HCIDumpPosixFs, FlightRecorderOpenTwice){
+    CHECK_EQUAL(0, hci_dump_posix_fs_open_flight_recorder(log_file.c_str(), HCI_DUMP_BTSNOOP, 10000));
+    log_acl_packet(1);
+    CHECK_EQUAL(0, hci_dump_posix_fs_open_flight_recorder(log_file.c_str(), HCI_DUMP_BTSNOOP, 1000));
+    log_acl_packet(2);
+    CHECK_EQUAL(0, hci_dump_posix_fs_flight_recorder_save());
+
+    // buffer of first open released, its records discarded
+    std::vector<uint32_t> counters = parse_btsnoop(read_file(list_log_files()[0]));
+    CHECK_EQUAL(1, counters.size());
+    CHECK_EQUAL(2, counters[0]);
+}
+
+TEST(HCIDumpPosixFs, FlightRecorderResetKeepsHistory){
+    CHECK_EQUAL(0, hci_dump_posix_fs_open_flight_recorder(log_file.c_str(), HCI_DUMP_PACKETLOGGER, 10000));
+    hci_dump_set_max_packets(2);
+    uint32_t i;
+    for (i = 0; i < 5; i++){
+        log_acl_packet(i);
+    }
+    CHECK_EQUAL(0, hci_dump_posix_fs_flight_recorder_save());
+    CHECK_EQUAL(5, parse_packetlogger(read_file(list_log_files()[0])).size());
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
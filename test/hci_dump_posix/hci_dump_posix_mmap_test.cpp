@@ -0,0 +1,126 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_util.h"
+#include "hci_dump.h"
+#include "hci_dump_buffered.h"
+#include "hci_dump_posix_mmap.h"
+
+#define TEST_RING_FILE "hci_dump_posix_mmap_test.ring"
+
+// returns counters of logged ACL packets in published records
+static std::vector<uint32_t> read_ring_file(void){
+    std::vector<uint8_t> content;
+    FILE * file = fopen(TEST_RING_FILE, "rb");
+    CHECK(file != NULL);
+    uint8_t buffer[4096];
+    size_t len;
+    while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0){
+        content.insert(content.end(), buffer, buffer + len);
+    }
+    fclose(file);
+
+    MEMCMP_EQUAL("BTSTKRNG", content.data(), 8);
+    const uint8_t * ring    = &content[HCI_DUMP_BUFFERED_RING_HEADER_SIZE];
+    uint32_t ring_size      = little_endian_read_32(content.data(), 16);
+    uint32_t pos            = little_endian_read_32(content.data(), 28);
+    uint32_t first_sequence = little_endian_read_32(content.data(), 32);
+    uint32_t next_sequence  = little_endian_read_32(content.data(), 36);
+    std::vector<uint32_t> counters;
+    uint32_t sequence_number;
+    for (sequence_number = first_sequence; sequence_number != next_sequence; sequence_number++){
+        if (((pos + 16u) > ring_size) || (little_endian_read_16(ring, pos) == 0u)){
+            pos = 0;
+        }
+        CHECK_EQUAL(sequence_number, little_endian_read_32(ring, pos + 4));
+        if (ring[pos + 2] == HCI_ACL_DATA_PACKET){
+            counters.push_back(little_endian_read_32(ring, pos + 16 + 4));
+        }
+        pos += (little_endian_read_16(ring, pos) + 3u) & ~3u;
+    }
+    return counters;
+}
+
+static void log_acl_packet(uint32_t counter){
+    uint8_t packet[100];
+    memset(packet, 0, sizeof(packet));
+    little_endian_store_16(packet, 0, 0x0001);
+    little_endian_store_16(packet, 2, sizeof(packet) - 4);
+    little_endian_store_32(packet, 4, counter);
+    hci_dump_packet(HCI_ACL_DATA_PACKET, 1, packet, sizeof(packet));
+}
+
+TEST_GROUP(HCIDumpPosixMmap){
+    void setup(void){
+        remove(TEST_RING_FILE);
+        hci_dump_init(hci_dump_posix_mmap_get_instance());
+        hci_dump_set_max_packets(-1);
+    }
+    void teardown(void){
+        hci_dump_posix_mmap_close();
+        hci_dump_init(NULL);
+        remove(TEST_RING_FILE);
+    }
+};
+
+TEST(HCIDumpPosixMmap, KeepsNewestRecords){
+    CHECK_EQUAL(0, hci_dump_posix_mmap_open(TEST_RING_FILE, 4096));
+    uint32_t i;
+    for (i = 0; i < 100; i++){
+        log_acl_packet(i);
+    }
+    hci_dump_posix_mmap_close();
+
+    // renewed with 116 byte records, 4032 / 116 = 34 records fit into ring
+    std::vector<uint32_t> counters = read_ring_file();
+    CHECK_EQUAL(34, counters.size());
+    for (i = 0; i < 34; i++){
+        CHECK_EQUAL(66 + i, counters[i]);
+    }
+}
+
+TEST(HCIDumpPosixMmap, AppendsAfterReopen){
+    CHECK_EQUAL(0, hci_dump_posix_mmap_open(TEST_RING_FILE, 0));
+    log_acl_packet(1);
+    hci_dump_posix_mmap_close();
+    CHECK_EQUAL(0, hci_dump_posix_mmap_open(TEST_RING_FILE, 0));
+    log_acl_packet(2);
+    hci_dump_posix_mmap_close();
+
+    std::vector<uint32_t> counters = read_ring_file();
+    CHECK_EQUAL(2, counters.size());
+    CHECK_EQUAL(1, counters[0]);
+    CHECK_EQUAL(2, counters[1]);
+}
+
+TEST(HCIDumpPosixMmap, SurvivesCrash){
+    pid_t pid = fork();
+    if (pid == 0){
+        // terminate without closing the file
+        if (hci_dump_posix_mmap_open(TEST_RING_FILE, 0) != 0) _exit(1);
+        uint32_t i;
+        for (i = 0; i < 10; i++){
+            log_acl_packet(i);
+        }
+        abort();
+    }
+    int status;
+    CHECK_EQUAL(pid, waitpid(pid, &status, 0));
+    CHECK_TRUE(WIFSIGNALED(status));
+
+    std::vector<uint32_t> counters = read_ring_file();
+    CHECK_EQUAL(10, counters.size());
+    CHECK_EQUAL(9, counters[9]);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
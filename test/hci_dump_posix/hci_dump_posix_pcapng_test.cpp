@@ -0,0 +1,248 @@
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_util.h"
+#include "hci_dump.h"
+#include "hci_dump_posix_pcapng.h"
+
+#define TEST_LOG_FILE "hci_dump_posix_pcapng_test.pcapng"
+
+typedef struct {
+    uint32_t type;
+    std::vector<uint8_t> body;
+} pcapng_block_t;
+
+static std::vector<pcapng_block_t> read_blocks(void){
+    std::vector<uint8_t> content;
+    FILE * file = fopen(TEST_LOG_FILE, "rb");
+    CHECK(file != NULL);
+    uint8_t buffer[4096];
+    size_t len;
+    while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0){
+        content.insert(content.end(), buffer, buffer + len);
+    }
+    fclose(file);
+
+    std::vector<pcapng_block_t> blocks;
+    size_t pos = 0;
+    while (pos < content.size()){
+        CHECK((pos + 12) <= content.size());
+        uint32_t block_len = little_endian_read_32(content.data(), pos + 4);
+        CHECK_EQUAL(0, block_len & 3);
+        CHECK((pos + block_len) <= content.size());
+        CHECK_EQUAL(block_len, little_endian_read_32(content.data(), pos + block_len - 4));
+        pcapng_block_t block;
+        block.type = little_endian_read_32(content.data(), pos);
+        block.body.assign(content.begin() + pos + 8, content.begin() + pos + block_len - 4);
+        blocks.push_back(block);
+        pos += block_len;
+    }
+    return blocks;
+}
+
+// returns value of option with given code, options start at offset
+static std::string find_option(const pcapng_block_t & block, size_t offset, uint16_t code){
+    size_t pos = offset;
+    while ((pos + 4) <= block.body.size()){
+        uint16_t option_code = little_endian_read_16(block.body.data(), pos);
+        uint16_t option_len  = little_endian_read_16(block.body.data(), pos + 2);
+        if (option_code == 0) break;
+        if (option_code == code){
+            return std::string((const char *) &block.body[pos + 4], option_len);
+        }
+        pos += 4 + ((option_len + 3) & ~3);
+    }
+    return std::string();
+}
+
+// enhanced packet block options follow padded packet data
+static size_t enhanced_packet_options_offset(const pcapng_block_t & block){
+    return 20 + ((little_endian_read_32(block.body.data(), 12) + 3) & ~3);
+}
+
+static void log_acl_packet(uint32_t counter){
+    uint8_t packet[9];
+    memset(packet, 0, sizeof(packet));
+    little_endian_store_16(packet, 0, 0x0001);
+    little_endian_store_16(packet, 2, sizeof(packet) - 4);
+    little_endian_store_32(packet, 4, counter);
+    hci_dump_packet(HCI_ACL_DATA_PACKET, 1, packet, sizeof(packet));
+}
+
+TEST_GROUP(HCIDumpPosixPcapng){
+    void setup(void){
+        hci_dump_init(hci_dump_posix_pcapng_get_instance());
+        hci_dump_set_max_packets(-1);
+    }
+    void teardown(void){
+        hci_dump_posix_pcapng_close();
+        hci_dump_init(NULL);
+        remove(TEST_LOG_FILE);
+    }
+};
+
+TEST(HCIDumpPosixPcapng, DefaultInterface){
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_open(TEST_LOG_FILE));
+    log_acl_packet(1);
+    hci_dump_posix_pcapng_close();
+
+    std::vector<pcapng_block_t> blocks = read_blocks();
+    CHECK_EQUAL(4, blocks.size());
+    CHECK_EQUAL(0x0A0D0D0A, blocks[0].type);
+    CHECK_EQUAL(0x1A2B3C4D, little_endian_read_32(blocks[0].body.data(), 0));
+    STRCMP_EQUAL("BTstack", find_option(blocks[0], 16, 4).c_str());
+
+    // Linux Monitor link type with ns resolution
+    CHECK_EQUAL(1, blocks[1].type);
+    CHECK_EQUAL(254, little_endian_read_16(blocks[1].body.data(), 0));
+    STRCMP_EQUAL("hci0", find_option(blocks[1], 8, 2).c_str());
+    CHECK_EQUAL(9, find_option(blocks[1], 8, 9)[0]);
+
+    // ACL RX with monitor header
+    CHECK_EQUAL(6, blocks[2].type);
+    CHECK_EQUAL(0, little_endian_read_32(blocks[2].body.data(), 0));
+    CHECK_EQUAL(4 + 9, little_endian_read_32(blocks[2].body.data(), 12));
+    CHECK_EQUAL(0x0005, big_endian_read_16(blocks[2].body.data(), 22));
+    CHECK_EQUAL(1, little_endian_read_32(blocks[2].body.data(), 24 + 4));
+    uint64_t timestamp_ns = ((uint64_t) little_endian_read_32(blocks[2].body.data(), 4) << 32) | little_endian_read_32(blocks[2].body.data(), 8);
+    CHECK(timestamp_ns > 1000000000000000000ULL);
+
+    // statistics
+    CHECK_EQUAL(5, blocks[3].type);
+    CHECK_EQUAL(1, little_endian_read_32((const uint8_t *) find_option(blocks[3], 12, 4).data(), 0));
+    CHECK_EQUAL(0, little_endian_read_32((const uint8_t *) find_option(blocks[3], 12, 5).data(), 0));
+}
+
+TEST(HCIDumpPosixPcapng, TruncatedPacketKeepsOriginalLength){
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_open(TEST_LOG_FILE));
+    uint8_t packet[9] = { 0x01, 0x00, 0x05, 0x00, 0x01 };
+    hci_dump_posix_pcapng_get_instance()->log_packet_truncated(HCI_ACL_DATA_PACKET, 1, packet, 6, sizeof(packet));
+    hci_dump_posix_pcapng_close();
+
+    // captured and original length
+    std::vector<pcapng_block_t> blocks = read_blocks();
+    CHECK_EQUAL(6, blocks[2].type);
+    CHECK_EQUAL(4 + 6, little_endian_read_32(blocks[2].body.data(), 12));
+    CHECK_EQUAL(4 + 9, little_endian_read_32(blocks[2].body.data(), 16));
+}
+
+TEST(HCIDumpPosixPcapng, MultipleInterfaces){
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_open(TEST_LOG_FILE));
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_add_interface("/dev/ttyUSB0"));
+    CHECK_EQUAL(1, hci_dump_posix_pcapng_add_interface("usb-1-2"));
+    log_acl_packet(1);
+    hci_dump_posix_pcapng_set_interface(1);
+    log_acl_packet(2);
+    const uint8_t command[] = { 0x03, 0x0c, 0x00 };
+    hci_dump_posix_pcapng_log_packet(0, HCI_COMMAND_DATA_PACKET, 0, command, sizeof(command));
+    hci_dump_posix_pcapng_close();
+
+    std::vector<pcapng_block_t> blocks = read_blocks();
+    CHECK_EQUAL(8, blocks.size());
+    STRCMP_EQUAL("/dev/ttyUSB0", find_option(blocks[1], 8, 2).c_str());
+    STRCMP_EQUAL("usb-1-2", find_option(blocks[2], 8, 2).c_str());
+    CHECK_EQUAL(0, little_endian_read_32(blocks[3].body.data(), 0));
+    CHECK_EQUAL(1, little_endian_read_32(blocks[4].body.data(), 0));
+    CHECK_EQUAL(1, big_endian_read_16(blocks[4].body.data(), 20));
+    CHECK_EQUAL(2, little_endian_read_32(blocks[4].body.data(), 24 + 4));
+    CHECK_EQUAL(0, little_endian_read_32(blocks[5].body.data(), 0));
+    CHECK_EQUAL(0x0002, big_endian_read_16(blocks[5].body.data(), 22));
+    MEMCMP_EQUAL(command, &blocks[5].body[24], sizeof(command));
+    CHECK_EQUAL(5, blocks[6].type);
+    CHECK_EQUAL(5, blocks[7].type);
+    CHECK_EQUAL(1, little_endian_read_32(blocks[7].body.data(), 0));
+}
+
+TEST(HCIDumpPosixPcapng, LogMessageAsComment){
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_open(TEST_LOG_FILE));
+    hci_dump_log(HCI_DUMP_LOG_LEVEL_INFO, "test %u", 7);
+    hci_dump_posix_pcapng_close();
+
+    std::vector<pcapng_block_t> blocks = read_blocks();
+    CHECK_EQUAL(6, blocks[2].type);
+    CHECK_EQUAL(0x000c, big_endian_read_16(blocks[2].body.data(), 22));
+    MEMCMP_EQUAL("test 7", &blocks[2].body[24], 6);
+    STRCMP_EQUAL("test 7", find_option(blocks[2], enhanced_packet_options_offset(blocks[2]), 1).c_str());
+}
+
+TEST(HCIDumpPosixPcapng, DropCounters){
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_open(TEST_LOG_FILE));
+    log_acl_packet(1);
+    hci_dump_posix_pcapng_add_dropped_packets(0, 3);
+    log_acl_packet(2);
+    log_acl_packet(3);
+    hci_dump_posix_pcapng_close();
+
+    std::vector<pcapng_block_t> blocks = read_blocks();
+    CHECK_EQUAL(6, blocks.size());
+    CHECK(find_option(blocks[2], enhanced_packet_options_offset(blocks[2]), 4).empty());
+    std::string drop_count = find_option(blocks[3], enhanced_packet_options_offset(blocks[3]), 4);
+    CHECK_EQUAL(8, drop_count.size());
+    CHECK_EQUAL(3, little_endian_read_32((const uint8_t *) drop_count.data(), 0));
+    CHECK(find_option(blocks[4], enhanced_packet_options_offset(blocks[4]), 4).empty());
+    CHECK_EQUAL(6, little_endian_read_32((const uint8_t *) find_option(blocks[5], 12, 4).data(), 0));
+    CHECK_EQUAL(3, little_endian_read_32((const uint8_t *) find_option(blocks[5], 12, 5).data(), 0));
+}
+
+TEST(HCIDumpPosixPcapng, ShortWriteRemovesPartialBlock){
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_open(TEST_LOG_FILE));
+    log_acl_packet(1);
+
+    // limit file size to get partial block for next packet
+    struct stat file_stat;
+    CHECK_EQUAL(0, stat(TEST_LOG_FILE, &file_stat));
+    struct rlimit old_limit;
+    CHECK_EQUAL(0, getrlimit(RLIMIT_FSIZE, &old_limit));
+    struct rlimit limit = old_limit;
+    limit.rlim_cur = (rlim_t) file_stat.st_size + 10u;
+    void (*old_handler)(int) = signal(SIGXFSZ, SIG_IGN);
+    CHECK_EQUAL(0, setrlimit(RLIMIT_FSIZE, &limit));
+    log_acl_packet(2);
+    CHECK_EQUAL(0, setrlimit(RLIMIT_FSIZE, &old_limit));
+    signal(SIGXFSZ, old_handler);
+    struct stat truncated_stat;
+    CHECK_EQUAL(0, stat(TEST_LOG_FILE, &truncated_stat));
+    CHECK_EQUAL(file_stat.st_size, truncated_stat.st_size);
+
+    log_acl_packet(3);
+    hci_dump_posix_pcapng_close();
+
+    std::vector<pcapng_block_t> blocks = read_blocks();
+    CHECK_EQUAL(5, blocks.size());
+    CHECK_EQUAL(1, little_endian_read_32(blocks[2].body.data(), 24 + 4));
+    CHECK_EQUAL(3, little_endian_read_32(blocks[3].body.data(), 24 + 4));
+    std::string drop_count = find_option(blocks[3], enhanced_packet_options_offset(blocks[3]), 4);
+    CHECK_EQUAL(1, little_endian_read_32((const uint8_t *) drop_count.data(), 0));
+}
+
+TEST(HCIDumpPosixPcapng, ResetRewritesInterfaces){
+    CHECK_EQUAL(0, hci_dump_posix_pcapng_open(TEST_LOG_FILE));
+    hci_dump_posix_pcapng_add_interface("hci0");
+    hci_dump_posix_pcapng_add_interface("hci1");
+    hci_dump_set_max_packets(2);
+    uint32_t i;
+    for (i = 0; i < 3; i++){
+        log_acl_packet(i);
+    }
+    hci_dump_posix_pcapng_close();
+
+    std::vector<pcapng_block_t> blocks = read_blocks();
+    CHECK_EQUAL(6, blocks.size());
+    CHECK_EQUAL(0x0A0D0D0A, blocks[0].type);
+    CHECK_EQUAL(1, blocks[1].type);
+    CHECK_EQUAL(1, blocks[2].type);
+    CHECK_EQUAL(2, little_endian_read_32(blocks[3].body.data(), 24 + 4));
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -0,0 +1,139 @@
+// Benchmark for H4 receive path against a fake controller on a pseudo terminal
+//
+// Build with and without ENABLE_H4_STREAMING_RX (make benchmark) to compare block and streaming receive
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "btstack_run_loop.h"
+#include "btstack_run_loop_posix.h"
+#include "btstack_uart.h"
+#include "btstack_util.h"
+#include "hci_transport.h"
+#include "hci_transport_h4.h"
+
+#define NUM_PACKETS         100000
+#define ACL_PAYLOAD_LEN     27
+#define PACKETS_PER_WRITE   32
+
+static hci_transport_config_uart_t config = {
+        HCI_TRANSPORT_CONFIG_UART,
+        115200,
+        0,  // main baudrate
+        0,  // flow control
+        NULL,
+        BTSTACK_UART_PARITY_OFF,
+};
+
+static uint32_t num_packets_received;
+static uint32_t num_bytes_received;
+
+static uint64_t get_time_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000u) + ((uint64_t) ts.tv_nsec / 1000u);
+}
+
+// fake controller: send ACL packets in bursts as fast as the pty accepts them
+static void fake_controller(int fd, int start_fd){
+    uint8_t start;
+    if (read(start_fd, &start, 1) != 1) exit(1);
+
+    uint8_t burst[PACKETS_PER_WRITE * (5 + ACL_PAYLOAD_LEN)];
+    uint16_t pos = 0;
+    uint16_t i;
+    for (i = 0; i < PACKETS_PER_WRITE; i++){
+        burst[pos++] = HCI_ACL_DATA_PACKET;
+        little_endian_store_16(burst, pos, 0x2001);
+        pos += 2;
+        little_endian_store_16(burst, pos, ACL_PAYLOAD_LEN);
+        pos += 2;
+        memset(&burst[pos], i, ACL_PAYLOAD_LEN);
+        pos += ACL_PAYLOAD_LEN;
+    }
+
+    uint32_t packets_sent;
+    for (packets_sent = 0; packets_sent < NUM_PACKETS; packets_sent += PACKETS_PER_WRITE){
+        const uint8_t * data = burst;
+        ssize_t len = pos;
+        while (len > 0){
+            ssize_t written = write(fd, data, len);
+            if (written <= 0) exit(1);
+            data += written;
+            len  -= written;
+        }
+    }
+    // keep pty open until parent is done
+    pause();
+    exit(0);
+}
+
+static void packet_handler(uint8_t packet_type, uint8_t *packet, uint16_t size){
+    UNUSED(packet);
+    if (packet_type != HCI_ACL_DATA_PACKET) return;
+    num_packets_received++;
+    num_bytes_received += size;
+    if (num_packets_received >= NUM_PACKETS){
+        btstack_run_loop_trigger_exit();
+    }
+}
+
+int main(void){
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master_fd < 0) || (grantpt(master_fd) != 0) || (unlockpt(master_fd) != 0)){
+        printf("Failed to create pseudo terminal\n");
+        return 1;
+    }
+    config.device_name = ptsname(master_fd);
+
+    int start_pipe[2];
+    if (pipe(start_pipe) != 0) return 1;
+
+    pid_t pid = fork();
+    if (pid == 0){
+        close(start_pipe[1]);
+        fake_controller(master_fd, start_pipe[0]);
+    }
+    close(start_pipe[0]);
+
+    btstack_run_loop_init(btstack_run_loop_posix_get_instance());
+    const hci_transport_t * transport = hci_transport_h4_instance_for_uart(btstack_uart_posix_instance());
+    transport->init(&config);
+    transport->register_packet_handler(&packet_handler);
+    if (transport->open() != 0){
+        printf("Failed to open %s\n", config.device_name);
+        kill(pid, SIGTERM);
+        return 1;
+    }
+
+    // pty is in raw mode now, start fake controller
+    uint8_t start = 1;
+    if (write(start_pipe[1], &start, 1) != 1) return 1;
+
+    uint64_t start_us = get_time_us();
+    btstack_run_loop_execute();
+    uint64_t duration_us = get_time_us() - start_us;
+
+    transport->close();
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+
+#ifdef ENABLE_H4_STREAMING_RX
+    const char * mode = "streaming";
+#else
+    const char * mode = "block";
+#endif
+    printf("H4 %-9s receive: %u ACL packets, %u bytes in %u ms, %u packets/s, %u kB/s\n", mode,
+           num_packets_received, num_bytes_received, (unsigned int) (duration_us / 1000u),
+           (unsigned int) (((uint64_t) num_packets_received * 1000000u) / duration_us),
+           (unsigned int) (((uint64_t) num_bytes_received * 1000u) / duration_us));
+    return 0;
+}
@@ -0,0 +1,276 @@
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "hci_transport.h"
+#include "hci_transport_h4.h"
+#include "btstack_util.h"
+
+#ifndef ENABLE_H4_STREAMING_RX
+#error "Test requires ENABLE_H4_STREAMING_RX"
+#endif
+
+static hci_transport_config_uart_t config = {
+        HCI_TRANSPORT_CONFIG_UART,
+        115200,
+        0,  // main baudrate
+        1,  // flow control
+        NULL,
+        BTSTACK_UART_PARITY_OFF,
+};
+
+// mock UART
+static uint8_t * read_request_buffer;
+static uint16_t  read_request_len;
+static uint16_t  num_block_reads;
+static uint16_t  num_bytes_reads;
+
+static void (*block_received)(void);
+static void (*bytes_received)(uint16_t bytes_received);
+
+static int btstack_uart_mock_init(const btstack_uart_config_t * uart_config){
+    UNUSED(uart_config);
+    return 0;
+}
+
+static int btstack_uart_mock_open(void){
+    return 0;
+}
+
+static int btstack_uart_mock_close(void){
+    read_request_len = 0;
+    return 0;
+}
+
+static void btstack_uart_mock_set_block_received( void (*block_handler)(void)){
+    block_received = block_handler;
+}
+
+static void btstack_uart_mock_set_block_sent( void (*block_handler)(void)){
+    UNUSED(block_handler);
+}
+
+static void btstack_uart_mock_set_bytes_received( void (*bytes_handler)(uint16_t bytes_received)){
+    bytes_received = bytes_handler;
+}
+
+static void btstack_uart_mock_send_block(const uint8_t *data, uint16_t size){
+    UNUSED(data);
+    UNUSED(size);
+}
+
+static void btstack_uart_mock_receive_block(uint8_t *buffer, uint16_t len){
+    read_request_buffer = buffer;
+    read_request_len = len;
+    num_block_reads++;
+}
+
+static void btstack_uart_mock_receive_bytes(uint8_t *buffer, uint16_t len){
+    read_request_buffer = buffer;
+    read_request_len = len;
+    num_bytes_reads++;
+}
+
+static int btstack_uart_mock_set_baudrate(uint32_t baudrate){
+    UNUSED(baudrate);
+    return 0;
+}
+
+static btstack_uart_t uart_driver_streaming = {
+    .init                    = &btstack_uart_mock_init,
+    .open                    = &btstack_uart_mock_open,
+    .close                   = &btstack_uart_mock_close,
+    .set_block_received      = &btstack_uart_mock_set_block_received,
+    .set_block_sent          = &btstack_uart_mock_set_block_sent,
+    .set_baudrate            = &btstack_uart_mock_set_baudrate,
+    .set_parity              = NULL,
+    .set_flowcontrol         = NULL,
+    .receive_block           = &btstack_uart_mock_receive_block,
+    .send_block              = &btstack_uart_mock_send_block,
+    .get_supported_sleep_modes = NULL,
+    .set_sleep               = NULL,
+    .set_wakeup_handler      = NULL,
+    .set_frame_received      = NULL,
+    .set_frame_sent          = NULL,
+    .receive_frame           = NULL,
+    .send_frame              = NULL,
+    .set_bytes_received      = &btstack_uart_mock_set_bytes_received,
+    .receive_bytes           = &btstack_uart_mock_receive_bytes,
+};
+
+static btstack_uart_t uart_driver_block = {
+    .init                    = &btstack_uart_mock_init,
+    .open                    = &btstack_uart_mock_open,
+    .close                   = &btstack_uart_mock_close,
+    .set_block_received      = &btstack_uart_mock_set_block_received,
+    .set_block_sent          = &btstack_uart_mock_set_block_sent,
+    .set_baudrate            = &btstack_uart_mock_set_baudrate,
+    .set_parity              = NULL,
+    .set_flowcontrol         = NULL,
+    .receive_block           = &btstack_uart_mock_receive_block,
+    .send_block              = &btstack_uart_mock_send_block,
+    .get_supported_sleep_modes = NULL,
+    .set_sleep               = NULL,
+    .set_wakeup_handler      = NULL,
+    .set_frame_received      = NULL,
+    .set_frame_sent          = NULL,
+    .receive_frame           = NULL,
+    .send_frame              = NULL,
+    .set_bytes_received      = NULL,
+    .receive_bytes           = NULL,
+};
+
+// received packets: type followed by payload
+static std::vector<std::vector<uint8_t>> packets;
+static const hci_transport_t * transport;
+static bool close_on_packet;
+
+static void packet_handler(uint8_t packet_type, uint8_t *packet, uint16_t size){
+    std::vector<uint8_t> entry;
+    entry.push_back(packet_type);
+    entry.insert(entry.end(), packet, packet + size);
+    packets.push_back(entry);
+    if (close_on_packet){
+        transport->close();
+    }
+}
+
+// feed data through bytes_received, at most chunk_size bytes per read
+static void feed_bytes(const uint8_t * data, uint16_t size, uint16_t chunk_size){
+    while (size > 0){
+        CHECK(read_request_len > 0);
+        uint16_t bytes_to_feed = btstack_min(btstack_min(read_request_len, size), chunk_size);
+        memcpy(read_request_buffer, data, bytes_to_feed);
+        data += bytes_to_feed;
+        size -= bytes_to_feed;
+        read_request_len = 0;
+        (*bytes_received)(bytes_to_feed);
+    }
+}
+
+// feed data through block_received, exactly as requested
+static void feed_blocks(const uint8_t * data, uint16_t size){
+    while (size > 0){
+        CHECK(read_request_len > 0);
+        uint16_t bytes_to_feed = btstack_min(read_request_len, size);
+        CHECK_EQUAL(read_request_len, bytes_to_feed);
+        memcpy(read_request_buffer, data, bytes_to_feed);
+        data += bytes_to_feed;
+        size -= bytes_to_feed;
+        read_request_len = 0;
+        (*block_received)();
+    }
+}
+
+static const uint8_t event_command_complete[] = { HCI_EVENT_PACKET, 0x0e, 0x04, 0x01, 0x03, 0x0c, 0x00 };
+static const uint8_t event_empty[]            = { HCI_EVENT_PACKET, 0x0e, 0x00 };
+static const uint8_t acl_packet[]             = { HCI_ACL_DATA_PACKET, 0x01, 0x20, 0x05, 0x00, 0x01, 0x00, 0x04, 0x00, 0x0a };
+static const uint8_t sco_packet[]             = { HCI_SCO_DATA_PACKET, 0x01, 0x00, 0x03, 0x11, 0x22, 0x33 };
+
+static std::vector<uint8_t> stream_of_packets(void){
+    std::vector<uint8_t> stream;
+    stream.insert(stream.end(), event_command_complete, event_command_complete + sizeof(event_command_complete));
+    stream.insert(stream.end(), acl_packet, acl_packet + sizeof(acl_packet));
+    stream.insert(stream.end(), event_empty, event_empty + sizeof(event_empty));
+    stream.insert(stream.end(), sco_packet, sco_packet + sizeof(sco_packet));
+    stream.insert(stream.end(), acl_packet, acl_packet + sizeof(acl_packet));
+    return stream;
+}
+
+static void check_packet(uint16_t index, const uint8_t * expected, uint16_t size){
+    CHECK(index < packets.size());
+    CHECK_EQUAL(size, packets[index].size());
+    MEMCMP_EQUAL(expected, packets[index].data(), size);
+}
+
+static void check_stream_of_packets(void){
+    CHECK_EQUAL(5, packets.size());
+    check_packet(0, event_command_complete, sizeof(event_command_complete));
+    check_packet(1, acl_packet, sizeof(acl_packet));
+    check_packet(2, event_empty, sizeof(event_empty));
+    check_packet(3, sco_packet, sizeof(sco_packet));
+    check_packet(4, acl_packet, sizeof(acl_packet));
+}
+
+TEST_GROUP(HCITransportH4){
+    void setup(void){
+        packets.clear();
+        close_on_packet = false;
+        read_request_buffer = NULL;
+        read_request_len = 0;
+        num_block_reads = 0;
+        num_bytes_reads = 0;
+        block_received = NULL;
+        bytes_received = NULL;
+    }
+
+    void open(btstack_uart_t * uart_driver){
+        transport = hci_transport_h4_instance_for_uart(uart_driver);
+        transport->init(&config);
+        transport->register_packet_handler(&packet_handler);
+        transport->open();
+    }
+
+    void teardown(void){
+        transport->close();
+    }
+};
+
+TEST(HCITransportH4, MultiplePacketsInSingleRead){
+    open(&uart_driver_streaming);
+    std::vector<uint8_t> stream = stream_of_packets();
+    feed_bytes(stream.data(), (uint16_t) stream.size(), 0xffff);
+    check_stream_of_packets();
+    CHECK_EQUAL(2, num_bytes_reads);
+    CHECK_EQUAL(0, num_block_reads);
+}
+
+TEST(HCITransportH4, PacketsSplitAcrossReads){
+    std::vector<uint8_t> stream = stream_of_packets();
+    uint16_t chunk_size;
+    for (chunk_size = 1; chunk_size < stream.size(); chunk_size++){
+        packets.clear();
+        open(&uart_driver_streaming);
+        feed_bytes(stream.data(), (uint16_t) stream.size(), chunk_size);
+        check_stream_of_packets();
+        transport->close();
+    }
+}
+
+TEST(HCITransportH4, InvalidPacketTypeSkipped){
+    open(&uart_driver_streaming);
+    std::vector<uint8_t> stream;
+    stream.push_back(0xff);
+    stream.insert(stream.end(), acl_packet, acl_packet + sizeof(acl_packet));
+    feed_bytes(stream.data(), (uint16_t) stream.size(), 0xffff);
+    CHECK_EQUAL(1, packets.size());
+    check_packet(0, acl_packet, sizeof(acl_packet));
+}
+
+TEST(HCITransportH4, CloseDuringDeliveryDropsRemainingBytes){
+    open(&uart_driver_streaming);
+    close_on_packet = true;
+    std::vector<uint8_t> stream = stream_of_packets();
+    uint16_t reads_before = num_bytes_reads;
+    memcpy(read_request_buffer, stream.data(), stream.size());
+    read_request_len = 0;
+    (*bytes_received)((uint16_t) stream.size());
+    CHECK_EQUAL(1, packets.size());
+    check_packet(0, event_command_complete, sizeof(event_command_complete));
+    CHECK_EQUAL(reads_before, num_bytes_reads);
+}
+
+TEST(HCITransportH4, FallbackToBlockReads){
+    open(&uart_driver_block);
+    std::vector<uint8_t> stream = stream_of_packets();
+    feed_blocks(stream.data(), (uint16_t) stream.size());
+    check_stream_of_packets();
+    CHECK_EQUAL(0, num_bytes_reads);
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
@@ -0,0 +1,243 @@
+// Benchmark for H5 send throughput against a loopback SLIP peer on a pseudo terminal
+//
+// The peer decodes and encodes frames with btstack_slip.c and models a UART link: each frame occupies the
+// line for its encoded size at LINE_BAUDRATE, and its acknowledgement arrives after LINE_LATENCY_US in each
+// direction, e.g. caused by the latency timer of a USB-to-serial adapter.
+//
+// Build with different HCI_TRANSPORT_H5_WINDOW_SIZE (make benchmark) to compare sliding window sizes
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "btstack_run_loop.h"
+#include "btstack_run_loop_posix.h"
+#include "btstack_slip.h"
+#include "btstack_uart.h"
+#include "btstack_util.h"
+#include "hci_transport.h"
+#include "hci_transport_h5.h"
+
+#define NUM_PACKETS         1000
+#define ACL_PAYLOAD_LEN     251
+#define LINE_BAUDRATE       921600
+#define LINE_LATENCY_US     1000
+
+static hci_transport_config_uart_t config = {
+        HCI_TRANSPORT_CONFIG_UART,
+        LINE_BAUDRATE,
+        0,  // main baudrate
+        0,  // flow control
+        NULL,
+        BTSTACK_UART_PARITY_OFF,
+};
+
+static uint64_t get_time_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000u) + ((uint64_t) ts.tv_nsec / 1000u);
+}
+
+// loopback SLIP peer
+
+static int peer_fd;
+
+static void peer_send_frame(uint8_t reliable, uint8_t seq_nr, uint8_t ack_nr, uint8_t packet_type, const uint8_t * payload, uint16_t payload_len){
+    uint8_t frame[4 + 16];
+    frame[0] = (reliable ? (0x80 | seq_nr) : 0) | (ack_nr << 3);
+    frame[1] = packet_type | ((payload_len & 0x0f) << 4);
+    frame[2] = payload_len >> 4;
+    frame[3] = 0xff - (frame[0] + frame[1] + frame[2]);
+    memcpy(&frame[4], payload, payload_len);
+
+    uint8_t encoded[2 * sizeof(frame) + 2];
+    uint16_t pos = 0;
+    btstack_slip_encoder_start(frame, 4 + payload_len);
+    while (btstack_slip_encoder_has_data()){
+        encoded[pos++] = btstack_slip_encoder_get_byte();
+    }
+    if (write(peer_fd, encoded, pos) != pos) exit(1);
+}
+
+static void fake_controller(int fd){
+    peer_fd = fd;
+
+    static uint8_t frame[4 + HCI_ACL_PAYLOAD_SIZE + 8];
+    uint8_t  ack_nr = 0;
+    uint8_t  tx_seq_nr = 0;
+    uint32_t num_packets_received = 0;
+    uint64_t line_free_us = 0;
+    uint64_t ack_due_us = 0;
+    uint16_t frame_wire_bytes = 0;
+    bool     ack_pending = false;
+
+    btstack_slip_decoder_init(frame, sizeof(frame));
+    while (true){
+        // wait for data or next ack
+        struct timespec timeout = { 1, 0 };
+        if (ack_pending){
+            uint64_t now_us = get_time_us();
+            uint64_t wait_us = (ack_due_us > now_us) ? (ack_due_us - now_us) : 0;
+            timeout.tv_sec  = wait_us / 1000000u;
+            timeout.tv_nsec = (wait_us % 1000000u) * 1000u;
+        }
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (ppoll(&pfd, 1, &timeout, NULL) < 0) exit(1);
+
+        if (pfd.revents & POLLIN){
+            uint8_t data[1024];
+            ssize_t len = read(fd, data, sizeof(data));
+            if (len <= 0) exit(1);
+            ssize_t i;
+            for (i = 0; i < len; i++){
+                frame_wire_bytes++;
+                btstack_slip_decoder_process(data[i]);
+                uint16_t frame_size = btstack_slip_decoder_frame_size();
+                if (frame_size == 0) continue;
+                btstack_slip_decoder_init(frame, sizeof(frame));
+
+                // frame occupies line for 10 bits per encoded byte
+                uint64_t now_us = get_time_us();
+                if (line_free_us < now_us){
+                    line_free_us = now_us;
+                }
+                line_free_us += ((uint64_t) frame_wire_bytes * 10u * 1000000u) / LINE_BAUDRATE;
+                frame_wire_bytes = 0;
+
+                uint8_t  reliable    = (frame[0] & 0x80) != 0;
+                uint8_t  seq_nr      = frame[0] & 0x07;
+                uint8_t  packet_type = frame[1] & 0x0f;
+                uint16_t payload_len = (frame[1] >> 4) | (frame[2] << 4);
+                const uint8_t * payload = &frame[4];
+
+                if (packet_type == 0x0f){
+                    if ((payload[0] == 0x01) && (payload[1] == 0x7e)){
+                        // sync -> sync response
+                        const uint8_t sync_response[] = { 0x02, 0x7d };
+                        peer_send_frame(0, 0, 0, 0x0f, sync_response, sizeof(sync_response));
+                    } else if ((payload[0] == 0x03) && (payload[1] == 0xfc)){
+                        // config -> config response: up to 7 packets, OOF flow control and DIC as requested
+                        uint8_t host_config = (payload_len > 2) ? payload[2] : 0;
+                        const uint8_t config_response[] = { 0x04, 0x7b, (uint8_t) (host_config & 0x1f) };
+                        peer_send_frame(0, 0, 0, 0x0f, config_response, sizeof(config_response));
+                    }
+                    continue;
+                }
+                if (!reliable) continue;
+
+                // ack in-sequence packets after transmission and round trip, re-ack others
+                if (seq_nr == ack_nr){
+                    ack_nr = (ack_nr + 1) & 0x07;
+                    if (packet_type == HCI_ACL_DATA_PACKET){
+                        num_packets_received++;
+                    }
+                }
+                if (!ack_pending){
+                    ack_due_us  = line_free_us + (2 * LINE_LATENCY_US);
+                    ack_pending = true;
+                }
+
+                // report completion with HCI event
+                if (num_packets_received == NUM_PACKETS){
+                    num_packets_received++;
+                    const uint8_t event[] = { 0xff, 0x00 };
+                    peer_send_frame(1, tx_seq_nr, ack_nr, HCI_EVENT_PACKET, event, sizeof(event));
+                    tx_seq_nr = (tx_seq_nr + 1) & 0x07;
+                }
+            }
+        }
+
+        // send cumulative ack when due
+        if (ack_pending && (get_time_us() >= ack_due_us)){
+            ack_pending = false;
+            peer_send_frame(0, 0, ack_nr, 0x00, NULL, 0);
+        }
+    }
+}
+
+// host
+
+static const hci_transport_t * transport;
+static uint8_t  acl_buffer[4 + 4 + ACL_PAYLOAD_LEN + 2];
+static bool     link_active;
+static uint32_t num_packets_sent;
+static uint64_t start_us;
+static uint64_t duration_us;
+
+static void send_acl_packet(void){
+    uint8_t * packet = &acl_buffer[4];
+    little_endian_store_16(packet, 0, 0x2001);
+    little_endian_store_16(packet, 2, ACL_PAYLOAD_LEN);
+    memset(&packet[4], (uint8_t) num_packets_sent, ACL_PAYLOAD_LEN);
+    num_packets_sent++;
+    transport->send_packet(HCI_ACL_DATA_PACKET, packet, 4 + ACL_PAYLOAD_LEN);
+}
+
+static void packet_handler(uint8_t packet_type, uint8_t *packet, uint16_t size){
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    switch (packet[0]){
+        case HCI_EVENT_TRANSPORT_PACKET_SENT:
+            if (!link_active){
+                link_active = true;
+                start_us = get_time_us();
+            }
+            if (num_packets_sent < NUM_PACKETS){
+                send_acl_packet();
+            }
+            break;
+        case 0xff:
+            // all packets received by peer
+            duration_us = get_time_us() - start_us;
+            btstack_run_loop_trigger_exit();
+            break;
+        default:
+            break;
+    }
+}
+
+int main(void){
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master_fd < 0) || (grantpt(master_fd) != 0) || (unlockpt(master_fd) != 0)){
+        printf("Failed to create pseudo terminal\n");
+        return 1;
+    }
+    config.device_name = ptsname(master_fd);
+
+    btstack_run_loop_init(btstack_run_loop_posix_get_instance());
+    transport = hci_transport_h5_instance(btstack_uart_posix_instance());
+    transport->init(&config);
+    transport->register_packet_handler(&packet_handler);
+    if (transport->open() != 0){
+        printf("Failed to open %s\n", config.device_name);
+        return 1;
+    }
+
+    // pty is in raw mode now, start fake controller
+    pid_t pid = fork();
+    if (pid == 0){
+        fake_controller(master_fd);
+    }
+
+    btstack_run_loop_execute();
+
+    transport->close();
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+
+    uint32_t num_bytes = NUM_PACKETS * ACL_PAYLOAD_LEN;
+    printf("H5 window %u, %u baud, %u us latency: %u ACL packets, %u bytes in %u ms, %u packets/s, %u kB/s\n",
+           HCI_TRANSPORT_H5_WINDOW_SIZE, LINE_BAUDRATE, LINE_LATENCY_US,
+           NUM_PACKETS, num_bytes, (unsigned int) (duration_us / 1000u),
+           (unsigned int) (((uint64_t) NUM_PACKETS * 1000000u) / duration_us),
+           (unsigned int) (((uint64_t) num_bytes * 1000u) / duration_us));
+    return 0;
+}
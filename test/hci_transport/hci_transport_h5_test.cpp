@@ -0,0 +1,365 @@
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "btstack_run_loop.h"
+#include "btstack_slip.h"
+#include "btstack_util.h"
+#include "hci_transport.h"
+#include "hci_transport_h5.h"
+
+#if (HCI_TRANSPORT_H5_WINDOW_SIZE != 4) || !defined(ENABLE_H5_OOF_FLOW_CONTROL)
+#error "Test requires HCI_TRANSPORT_H5_WINDOW_SIZE 4 and ENABLE_H5_OOF_FLOW_CONTROL"
+#endif
+
+static hci_transport_config_uart_t config = {
+        HCI_TRANSPORT_CONFIG_UART,
+        115200,
+        0,  // main baudrate
+        1,  // flow control
+        NULL,
+        BTSTACK_UART_PARITY_OFF,
+};
+
+// mock run loop, only link timer is used without auto sleep
+static btstack_timer_source_t * active_timer;
+
+void btstack_run_loop_add_timer(btstack_timer_source_t * timer){
+    active_timer = timer;
+}
+
+int btstack_run_loop_remove_timer(btstack_timer_source_t * timer){
+    if (active_timer == timer){
+        active_timer = NULL;
+    }
+    return 1;
+}
+
+void btstack_run_loop_set_timer(btstack_timer_source_t * timer, uint32_t timeout_in_ms){
+    UNUSED(timer);
+    UNUSED(timeout_in_ms);
+}
+
+void btstack_run_loop_set_timer_handler(btstack_timer_source_t * timer, void (*process)(btstack_timer_source_t * _timer)){
+    timer->process = process;
+}
+
+static void trigger_timer(void){
+    CHECK(active_timer != NULL);
+    btstack_timer_source_t * timer = active_timer;
+    active_timer = NULL;
+    (*timer->process)(timer);
+}
+
+// mock UART with SLIP frame support
+static uint8_t * receive_buffer;
+static uint16_t  receive_buffer_len;
+static bool      send_active;
+static std::vector<std::vector<uint8_t>> frames_sent;
+
+static void (*frame_received)(uint16_t frame_size);
+static void (*frame_sent)(void);
+
+static int btstack_uart_mock_init(const btstack_uart_config_t * uart_config){
+    UNUSED(uart_config);
+    return 0;
+}
+
+static int btstack_uart_mock_open(void){
+    return 0;
+}
+
+static int btstack_uart_mock_close(void){
+    return 0;
+}
+
+static int btstack_uart_mock_set_baudrate(uint32_t baudrate){
+    UNUSED(baudrate);
+    return 0;
+}
+
+static void btstack_uart_mock_set_frame_received(void (*frame_handler)(uint16_t frame_size)){
+    frame_received = frame_handler;
+}
+
+static void btstack_uart_mock_set_frame_sent(void (*frame_handler)(void)){
+    frame_sent = frame_handler;
+}
+
+static void btstack_uart_mock_receive_frame(uint8_t *buffer, uint16_t len){
+    receive_buffer = buffer;
+    receive_buffer_len = len;
+}
+
+static void btstack_uart_mock_send_frame(const uint8_t *buffer, uint16_t length){
+    CHECK(send_active == false);
+    send_active = true;
+    frames_sent.push_back(std::vector<uint8_t>(buffer, buffer + length));
+}
+
+static btstack_uart_t uart_driver = {
+    .init                    = &btstack_uart_mock_init,
+    .open                    = &btstack_uart_mock_open,
+    .close                   = &btstack_uart_mock_close,
+    .set_block_received      = NULL,
+    .set_block_sent          = NULL,
+    .set_baudrate            = &btstack_uart_mock_set_baudrate,
+    .set_parity              = NULL,
+    .set_flowcontrol         = NULL,
+    .receive_block           = NULL,
+    .send_block              = NULL,
+    .get_supported_sleep_modes = NULL,
+    .set_sleep               = NULL,
+    .set_wakeup_handler      = NULL,
+    .set_frame_received      = &btstack_uart_mock_set_frame_received,
+    .set_frame_sent          = &btstack_uart_mock_set_frame_sent,
+    .receive_frame           = &btstack_uart_mock_receive_frame,
+    .send_frame              = &btstack_uart_mock_send_frame,
+    .set_bytes_received      = NULL,
+    .receive_bytes           = NULL,
+};
+
+// complete all frames sent by transport
+static void complete_frames(void){
+    while (send_active){
+        send_active = false;
+        (*frame_sent)();
+    }
+}
+
+// peer frames without data integrity check
+static void receive_frame(bool reliable, uint8_t seq_nr, uint8_t ack_nr, uint8_t packet_type, const uint8_t * payload, uint16_t payload_len){
+    CHECK(receive_buffer_len >= (4 + payload_len));
+    uint8_t * header = receive_buffer;
+    header[0] = (reliable ? (seq_nr | 0x80) : 0) | (ack_nr << 3);
+    header[1] = packet_type | ((payload_len & 0x0f) << 4);
+    header[2] = payload_len >> 4;
+    header[3] = 0xff - (header[0] + header[1] + header[2]);
+    memcpy(&header[4], payload, payload_len);
+    (*frame_received)(4 + payload_len);
+}
+
+static void receive_link_control(const uint8_t * message, uint16_t message_len){
+    receive_frame(false, 0, 0, 0x0f, message, message_len);
+}
+
+static void receive_ack(uint8_t ack_nr){
+    receive_frame(false, 0, ack_nr, 0x00, NULL, 0);
+}
+
+static uint8_t frame_seq_nr(const std::vector<uint8_t> & frame){
+    return frame[0] & 0x07;
+}
+
+static bool frame_is_reliable(const std::vector<uint8_t> & frame){
+    return (frame[0] & 0x80) != 0;
+}
+
+static uint8_t frame_packet_type(const std::vector<uint8_t> & frame){
+    return frame[1] & 0x0f;
+}
+
+// hci packet handler
+static const hci_transport_t * transport;
+static uint16_t num_packet_sent_events;
+
+static void packet_handler(uint8_t packet_type, uint8_t *packet, uint16_t size){
+    UNUSED(size);
+    if (packet_type != HCI_EVENT_PACKET) return;
+    if (packet[0] != HCI_EVENT_TRANSPORT_PACKET_SENT) return;
+    num_packet_sent_events++;
+}
+
+static const uint8_t sync_response[] = { 0x02, 0x7d };
+
+static void establish_link(uint8_t peer_config){
+    transport->open();
+    // sync
+    CHECK_EQUAL(1, frames_sent.size());
+    complete_frames();
+    receive_link_control(sync_response, sizeof(sync_response));
+    complete_frames();
+    // config: window 4, OOF flow control, DIC
+    std::vector<uint8_t> & config_frame = frames_sent.back();
+    CHECK_EQUAL(7, config_frame.size());
+    CHECK_EQUAL(0x03, config_frame[4]);
+    CHECK_EQUAL(0x1c, config_frame[6]);
+    // config response without data integrity check to keep frames simple
+    const uint8_t config_response[] = { 0x04, 0x7b, peer_config };
+    receive_link_control(config_response, sizeof(config_response));
+    CHECK_EQUAL(1, num_packet_sent_events);
+    frames_sent.clear();
+    num_packet_sent_events = 0;
+}
+
+static uint8_t acl_packet[] = { 0x01, 0x20, 0x03, 0x00, 0xaa, 0xbb, 0xcc };
+
+static void send_acl_packet(uint8_t tag){
+    CHECK(transport->can_send_packet_now(HCI_ACL_DATA_PACKET));
+    acl_packet[4] = tag;
+    CHECK_EQUAL(0, transport->send_packet(HCI_ACL_DATA_PACKET, acl_packet, sizeof(acl_packet)));
+    // HCI re-uses buffer
+    acl_packet[4] = 0xff;
+}
+
+TEST_GROUP(HCITransportH5){
+    void setup(void){
+        active_timer = NULL;
+        receive_buffer = NULL;
+        receive_buffer_len = 0;
+        send_active = false;
+        frames_sent.clear();
+        num_packet_sent_events = 0;
+        transport = hci_transport_h5_instance(&uart_driver);
+        transport->init(&config);
+        transport->register_packet_handler(&packet_handler);
+    }
+
+    void teardown(void){
+        complete_frames();
+        transport->reset_link();
+        complete_frames();
+        transport->close();
+        btstack_slip_decoder_set_xon_xoff_handler(NULL);
+        btstack_slip_encoder_set_xon_xoff_escaping(false);
+    }
+};
+
+TEST(HCITransportH5, WindowNegotiatedToMinimum){
+    establish_link(0x02);
+    send_acl_packet(0);
+    complete_frames();
+    CHECK_EQUAL(1, num_packet_sent_events);
+    send_acl_packet(1);
+    complete_frames();
+    CHECK_EQUAL(2, frames_sent.size());
+    // window of 2 full
+    CHECK_EQUAL(1, num_packet_sent_events);
+    CHECK_FALSE(transport->can_send_packet_now(HCI_ACL_DATA_PACKET));
+    receive_ack(1);
+    CHECK_EQUAL(2, num_packet_sent_events);
+    CHECK(transport->can_send_packet_now(HCI_ACL_DATA_PACKET));
+}
+
+TEST(HCITransportH5, SendsWindowWithoutAck){
+    establish_link(0x07);
+    uint8_t i;
+    for (i = 0; i < 4; i++){
+        send_acl_packet(i);
+        complete_frames();
+    }
+    CHECK_EQUAL(4, frames_sent.size());
+    for (i = 0; i < 4; i++){
+        CHECK(frame_is_reliable(frames_sent[i]));
+        CHECK_EQUAL(i, frame_seq_nr(frames_sent[i]));
+        CHECK_EQUAL(HCI_ACL_DATA_PACKET, frame_packet_type(frames_sent[i]));
+        CHECK_EQUAL(i, frames_sent[i][4 + 4]);
+    }
+    CHECK_EQUAL(3, num_packet_sent_events);
+    CHECK_FALSE(transport->can_send_packet_now(HCI_ACL_DATA_PACKET));
+    // cumulative ack for first two packets
+    receive_ack(2);
+    CHECK_EQUAL(4, num_packet_sent_events);
+    send_acl_packet(4);
+    complete_frames();
+    CHECK_EQUAL(5, frames_sent.size());
+    CHECK_EQUAL(4, frame_seq_nr(frames_sent[4]));
+    // all acknowledged, resend timer stopped
+    receive_ack(5);
+    CHECK(active_timer == NULL);
+}
+
+TEST(HCITransportH5, GoBackNOnTimeout){
+    establish_link(0x07);
+    uint8_t i;
+    for (i = 0; i < 3; i++){
+        send_acl_packet(i);
+        complete_frames();
+    }
+    receive_ack(1);
+    frames_sent.clear();
+    trigger_timer();
+    complete_frames();
+    CHECK_EQUAL(2, frames_sent.size());
+    for (i = 0; i < 2; i++){
+        CHECK_EQUAL(i + 1, frame_seq_nr(frames_sent[i]));
+        // payload from copy, not from re-used HCI buffer
+        CHECK_EQUAL(i + 1, frames_sent[i][4 + 4]);
+    }
+}
+
+TEST(HCITransportH5, AckForUnsentPacketIgnored){
+    establish_link(0x07);
+    send_acl_packet(0);
+    complete_frames();
+    receive_ack(3);
+    CHECK(active_timer != NULL);
+    receive_ack(1);
+    CHECK(active_timer == NULL);
+}
+
+TEST(HCITransportH5, ScoSentUnreliable){
+    establish_link(0x07);
+    // SCO packets are sent in place, H5 header stored in outgoing pre-buffer
+    uint8_t sco_buffer[4 + 6 + 2] = { 0, 0, 0, 0, 0x01, 0x00, 0x03, 0x11, 0x22, 0x33 };
+    CHECK(transport->can_send_packet_now(HCI_SCO_DATA_PACKET));
+    transport->send_packet(HCI_SCO_DATA_PACKET, &sco_buffer[4], 6);
+    CHECK_FALSE(transport->can_send_packet_now(HCI_ACL_DATA_PACKET));
+    complete_frames();
+    CHECK_EQUAL(1, frames_sent.size());
+    CHECK_FALSE(frame_is_reliable(frames_sent[0]));
+    CHECK_EQUAL(HCI_SCO_DATA_PACKET, frame_packet_type(frames_sent[0]));
+    CHECK_EQUAL(1, num_packet_sent_events);
+}
+
+TEST(HCITransportH5, ConfigResponseUsesCommonSettings){
+    transport->open();
+    complete_frames();
+    receive_link_control(sync_response, sizeof(sync_response));
+    complete_frames();
+    // peer config: window 7, DIC, no OOF flow control
+    const uint8_t peer_config[] = { 0x03, 0xfc, 0x17 };
+    receive_link_control(peer_config, sizeof(peer_config));
+    complete_frames();
+    std::vector<uint8_t> & response = frames_sent.back();
+    CHECK_EQUAL(0x04, response[4]);
+    CHECK_EQUAL(0x14, response[6]);
+}
+
+TEST(HCITransportH5, XoffPausesTransmission){
+    establish_link(0x0f);
+    btstack_slip_decoder_process(BTSTACK_SLIP_XOFF);
+    send_acl_packet(0);
+    CHECK_EQUAL(0, frames_sent.size());
+    btstack_slip_decoder_process(BTSTACK_SLIP_XON);
+    complete_frames();
+    CHECK_EQUAL(1, frames_sent.size());
+}
+
+TEST(HCITransportH5, SlipEscapesXonXoff){
+    const uint8_t data[] = { BTSTACK_SLIP_XON, 0x01, BTSTACK_SLIP_XOFF, BTSTACK_SLIP_SOF, 0xdb };
+    const uint8_t expected[] = { 0xc0, 0xdb, 0xde, 0x01, 0xdb, 0xdf, 0xdb, 0xdc, 0xdb, 0xdd, 0xc0 };
+    std::vector<uint8_t> encoded;
+    btstack_slip_encoder_set_xon_xoff_escaping(true);
+    btstack_slip_encoder_start(data, sizeof(data));
+    while (btstack_slip_encoder_has_data()){
+        encoded.push_back(btstack_slip_encoder_get_byte());
+    }
+    CHECK_EQUAL(sizeof(expected), encoded.size());
+    MEMCMP_EQUAL(expected, encoded.data(), sizeof(expected));
+
+    uint8_t decoded[10];
+    btstack_slip_decoder_init(decoded, sizeof(decoded));
+    for (uint8_t byte : encoded){
+        btstack_slip_decoder_process(byte);
+    }
+    CHECK_EQUAL(sizeof(data), btstack_slip_decoder_frame_size());
+    MEMCMP_EQUAL(data, decoded, sizeof(data));
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
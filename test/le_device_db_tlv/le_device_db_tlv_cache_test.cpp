@@ -0,0 +1,199 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/CommandLineTestRunner.h"
+
+#include "ble/le_device_db.h"
+#include "ble/le_device_db_tlv.h"
+
+#include "btstack_util.h"
+#include "bluetooth.h"
+#include "btstack_tlv_flash_bank.h"
+#include "hal_flash_bank_memory.h"
+#include "hci.h"
+
+#ifndef ENABLE_LE_DEVICE_DB_TLV_CACHE
+#error "ENABLE_LE_DEVICE_DB_TLV_CACHE required"
+#endif
+
+#define HAL_FLASH_BANK_MEMORY_STORAGE_SIZE 4096
+static uint8_t hal_flash_bank_memory_storage[HAL_FLASH_BANK_MEMORY_STORAGE_SIZE];
+
+static const hal_flash_bank_t * hal_flash_bank_impl;
+static hal_flash_bank_memory_t  hal_flash_bank_context;
+static const btstack_tlv_t *    btstack_tlv_impl;
+static btstack_tlv_flash_bank_t btstack_tlv_context;
+
+// count TLV access
+static int num_get_tag;
+static int num_store_tag;
+
+static int counting_get_tag(void * context, uint32_t tag, uint8_t * buffer, uint32_t buffer_size){
+    num_get_tag++;
+    return btstack_tlv_impl->get_tag(context, tag, buffer, buffer_size);
+}
+
+static int counting_store_tag(void * context, uint32_t tag, const uint8_t * data, uint32_t data_size){
+    num_store_tag++;
+    return btstack_tlv_impl->store_tag(context, tag, data, data_size);
+}
+
+static void counting_delete_tag(void * context, uint32_t tag){
+    btstack_tlv_impl->delete_tag(context, tag);
+}
+
+static const btstack_tlv_t counting_tlv = {
+    &counting_get_tag,
+    &counting_store_tag,
+    &counting_delete_tag,
+};
+
+// stub, le_device_db_tlv only registers for HCI events
+static btstack_packet_callback_registration_t * hci_event_callback_registration;
+void hci_add_event_handler(btstack_packet_callback_registration_t * callback_handler){
+    hci_event_callback_registration = callback_handler;
+}
+
+static void emit_disconnection_complete(void){
+    uint8_t event[] = { HCI_EVENT_DISCONNECTION_COMPLETE, 4, 0, 0x40, 0x00, 0x13 };
+    CHECK(hci_event_callback_registration != NULL);
+    (*hci_event_callback_registration->callback)(HCI_EVENT_PACKET, 0, event, sizeof(event));
+}
+
+TEST_GROUP(LE_DEVICE_DB_TLV_CACHE){
+    bd_addr_t addr;
+    sm_key_t  irk;
+    int       index;
+
+    void setup(void){
+        hal_flash_bank_impl = hal_flash_bank_memory_init_instance(&hal_flash_bank_context, hal_flash_bank_memory_storage, HAL_FLASH_BANK_MEMORY_STORAGE_SIZE);
+        hal_flash_bank_impl->erase(&hal_flash_bank_context, 0);
+        hal_flash_bank_impl->erase(&hal_flash_bank_context, 1);
+        btstack_tlv_impl = btstack_tlv_flash_bank_init_instance(&btstack_tlv_context, hal_flash_bank_impl, &hal_flash_bank_context);
+        le_device_db_tlv_configure(&counting_tlv, &btstack_tlv_context);
+        le_device_db_init();
+
+        memset(addr, 0x11, 6);
+        memset(irk, 0x22, 16);
+        index = le_device_db_add(BD_ADDR_TYPE_LE_PUBLIC, addr, irk);
+        CHECK(index >= 0);
+        num_get_tag = 0;
+        num_store_tag = 0;
+    }
+
+    // re-read db from TLV, e.g. after power cycle
+    void reboot(void){
+        btstack_tlv_impl = btstack_tlv_flash_bank_init_instance(&btstack_tlv_context, hal_flash_bank_impl, &hal_flash_bank_context);
+        le_device_db_tlv_configure(&counting_tlv, &btstack_tlv_context);
+    }
+};
+
+TEST(LE_DEVICE_DB_TLV_CACHE, ReadFromCache){
+    int addr_type;
+    bd_addr_t info_addr;
+    sm_key_t  info_irk;
+    uint16_t ediv;
+    int i;
+    for (i = 0; i < 10; i++){
+        le_device_db_info(index, &addr_type, info_addr, info_irk);
+        le_device_db_encryption_get(index, &ediv, NULL, NULL, NULL, NULL, NULL, NULL);
+        (void) le_device_db_remote_counter_get(index);
+    }
+    CHECK_EQUAL(0, num_get_tag);
+    CHECK_EQUAL(BD_ADDR_TYPE_LE_PUBLIC, addr_type);
+    MEMCMP_EQUAL(addr, info_addr, 6);
+    MEMCMP_EQUAL(irk, info_irk, 16);
+
+    // unused entries
+    le_device_db_info(index - 1, &addr_type, NULL, NULL);
+    CHECK_EQUAL(BD_ADDR_TYPE_UNKNOWN, addr_type);
+    CHECK_EQUAL(0, num_get_tag);
+}
+
+TEST(LE_DEVICE_DB_TLV_CACHE, AddExistingFromCache){
+    CHECK_EQUAL(index, le_device_db_add(BD_ADDR_TYPE_LE_PUBLIC, addr, irk));
+    CHECK_EQUAL(1, le_device_db_count());
+    CHECK_EQUAL(0, num_get_tag);
+}
+
+TEST(LE_DEVICE_DB_TLV_CACHE, CounterWriteBack){
+    le_device_db_remote_counter_set(index, 1);
+    le_device_db_local_counter_set(index, 2);
+    CHECK_EQUAL(0, num_store_tag);
+    CHECK_EQUAL(1, le_device_db_remote_counter_get(index));
+    CHECK_EQUAL(2, le_device_db_local_counter_get(index));
+
+    // not written yet
+    reboot();
+    CHECK_EQUAL(0, le_device_db_remote_counter_get(index));
+    CHECK_EQUAL(0, le_device_db_local_counter_get(index));
+
+    le_device_db_remote_counter_set(index, 3);
+    le_device_db_local_counter_set(index, 4);
+    le_device_db_tlv_flush();
+    CHECK_EQUAL(1, num_store_tag);
+    le_device_db_tlv_flush();
+    CHECK_EQUAL(1, num_store_tag);
+
+    reboot();
+    CHECK_EQUAL(3, le_device_db_remote_counter_get(index));
+    CHECK_EQUAL(4, le_device_db_local_counter_get(index));
+}
+
+TEST(LE_DEVICE_DB_TLV_CACHE, CounterWriteBackAfterUpdates){
+    uint32_t counter;
+    for (counter = 1; counter < LE_DEVICE_DB_TLV_CACHE_COUNTER_WRITE_BACK; counter++){
+        le_device_db_remote_counter_set(index, counter);
+    }
+    CHECK_EQUAL(0, num_store_tag);
+    le_device_db_remote_counter_set(index, counter);
+    CHECK_EQUAL(1, num_store_tag);
+
+    reboot();
+    CHECK_EQUAL(counter, le_device_db_remote_counter_get(index));
+}
+
+TEST(LE_DEVICE_DB_TLV_CACHE, CounterWriteBackOnDisconnect){
+    le_device_db_remote_counter_set(index, 5);
+    emit_disconnection_complete();
+    CHECK_EQUAL(1, num_store_tag);
+
+    reboot();
+    CHECK_EQUAL(5, le_device_db_remote_counter_get(index));
+}
+
+TEST(LE_DEVICE_DB_TLV_CACHE, StoreIncludesCounter){
+    uint8_t rand[8];
+    sm_key_t ltk;
+    memset(rand, 0x33, sizeof(rand));
+    memset(ltk, 0x44, sizeof(ltk));
+    le_device_db_local_counter_set(index, 7);
+    le_device_db_encryption_set(index, 0x1234, rand, ltk, 16, 1, 0, 1);
+    CHECK_EQUAL(1, num_store_tag);
+    le_device_db_tlv_flush();
+    CHECK_EQUAL(1, num_store_tag);
+
+    reboot();
+    uint16_t ediv;
+    sm_key_t ltk_stored;
+    le_device_db_encryption_get(index, &ediv, NULL, ltk_stored, NULL, NULL, NULL, NULL);
+    CHECK_EQUAL(0x1234, ediv);
+    MEMCMP_EQUAL(ltk, ltk_stored, 16);
+    CHECK_EQUAL(7, le_device_db_local_counter_get(index));
+}
+
+TEST(LE_DEVICE_DB_TLV_CACHE, RemoveDropsPendingUpdates){
+    le_device_db_remote_counter_set(index, 5);
+    le_device_db_remove(index);
+    le_device_db_tlv_flush();
+    CHECK_EQUAL(0, num_store_tag);
+    CHECK_EQUAL(0, le_device_db_count());
+
+    reboot();
+    CHECK_EQUAL(0, le_device_db_count());
+}
+
+int main (int argc, const char * argv[]){
+    return CommandLineTestRunner::RunAllTests(argc, argv);
+}
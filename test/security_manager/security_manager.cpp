@@ -25,6 +25,9 @@
 #include "hci_dump_posix_fs.h"
 #include "l2cap.h"
 #include "ble/sm.h"
+#include "ble/le_device_db.h"
+#include "btstack_crypto.h"
+#include "btstack_event.h"
 
 uint8_t test_command_packet_sc_read_public_key[] = { 0x25, 0x20, 0x00 };
 
@@ -122,6 +125,10 @@ extern "C" {
     void mock_clear_packet_buffer(void);
 }
 
+static int identity_resolving_succeeded;
+static int identity_resolving_failed;
+static int identity_resolving_index;
+
 void app_packet_handler (uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size){
     uint16_t aHandle;
     bd_addr_t event_address;
@@ -134,6 +141,15 @@ void app_packet_handler (uint8_t packet_type, uint16_t channel, uint8_t *packet,
                     fflush(stdout);
                     break;
 
+                case SM_EVENT_IDENTITY_RESOLVING_SUCCEEDED:
+                    identity_resolving_succeeded++;
+                    identity_resolving_index = sm_event_identity_resolving_succeeded_get_index(packet);
+                    break;
+
+                case SM_EVENT_IDENTITY_RESOLVING_FAILED:
+                    identity_resolving_failed++;
+                    break;
+
                 case SM_EVENT_PASSKEY_DISPLAY_NUMBER:
                     printf("\nGAP Bonding: Display Passkey '%06u\n", little_endian_read_32(packet, 11));
                     break;
@@ -459,6 +475,112 @@ TEST(SecurityManager, AddressResolutionLookup){
     CHECK_EQUAL(status, BTSTACK_BUSY);
 }
 
+static void create_resolvable_private_address(const sm_key_t irk, uint8_t prand, bd_addr_t address){
+    uint8_t r_prime[16];
+    uint8_t hash[16];
+    memset(r_prime, 0, 16);
+    r_prime[13] = 0x40;
+    r_prime[14] = 0x12;
+    r_prime[15] = prand;
+    btstack_aes128_calc(irk, r_prime, hash);
+    memcpy(&address[0], &r_prime[13], 3);
+    memcpy(&address[3], &hash[13],    3);
+}
+
+static void resolve_address(bd_addr_t address){
+    identity_resolving_succeeded = 0;
+    identity_resolving_failed = 0;
+    identity_resolving_index = -1;
+    CHECK_EQUAL(ERROR_CODE_SUCCESS, sm_address_resolution_lookup((uint8_t) BD_ADDR_TYPE_LE_RANDOM, address));
+    int i;
+    for (i = 0; i < 10; i++){
+        btstack_run_loop_embedded_execute_once();
+    }
+}
+
+TEST(SecurityManager, AddressResolutionBatched){
+    mock_init();
+    mock_simulate_hci_state_working();
+    le_device_db_init();
+
+    // bonded devices with distinct IRKs, resolve against the last one
+    sm_key_t irk;
+    bd_addr_t identity_address = { 0xC0, 0x01, 0x02, 0x03, 0x04, 0x00 };
+    int i;
+    int num_devices = 5;
+    for (i = 0; i < num_devices; i++){
+        memset(irk, 0x10 + i, 16);
+        identity_address[5] = (uint8_t) i;
+        le_device_db_add(BD_ADDR_TYPE_LE_RANDOM, identity_address, irk);
+    }
+
+    bd_addr_t address;
+    create_resolvable_private_address(irk, 0x34, address);
+    sm_address_resolution_reset_stats();
+    resolve_address(address);
+    CHECK_EQUAL(1, identity_resolving_succeeded);
+    CHECK_EQUAL(num_devices - 1, identity_resolving_index);
+
+    sm_address_resolution_stats_t stats;
+    sm_address_resolution_get_stats(&stats);
+    CHECK_EQUAL(1, stats.num_lookups);
+    CHECK_EQUAL(1, stats.num_resolved);
+    CHECK_EQUAL(0, stats.num_failed);
+    CHECK_EQUAL(num_devices, stats.num_ah_calculations);
+    CHECK(stats.latency_max_ms > 0);
+    CHECK_EQUAL(stats.latency_max_ms, stats.latency_total_ms);
+
+    // unknown address
+    memset(irk, 0x55, 16);
+    create_resolvable_private_address(irk, 0x56, address);
+    resolve_address(address);
+    CHECK_EQUAL(1, identity_resolving_failed);
+    sm_address_resolution_get_stats(&stats);
+    CHECK_EQUAL(2, stats.num_lookups);
+    CHECK_EQUAL(1, stats.num_failed);
+    CHECK_EQUAL(2 * num_devices, stats.num_ah_calculations);
+
+    sm_address_resolution_reset_stats();
+    sm_address_resolution_get_stats(&stats);
+    CHECK_EQUAL(0, stats.num_lookups);
+    CHECK_EQUAL(0, stats.latency_max_ms);
+}
+
+#ifdef ENABLE_SM_ADDRESS_RESOLUTION_CACHE
+TEST(SecurityManager, AddressResolutionCache){
+    mock_init();
+    mock_simulate_hci_state_working();
+    le_device_db_init();
+
+    sm_key_t irk;
+    bd_addr_t identity_address = { 0xC0, 0x01, 0x02, 0x03, 0x04, 0x05 };
+    memset(irk, 0x22, 16);
+    int index = le_device_db_add(BD_ADDR_TYPE_LE_RANDOM, identity_address, irk);
+
+    bd_addr_t address;
+    create_resolvable_private_address(irk, 0x78, address);
+    sm_address_resolution_reset_stats();
+    resolve_address(address);
+    CHECK_EQUAL(1, identity_resolving_succeeded);
+
+    // second lookup served from cache
+    resolve_address(address);
+    CHECK_EQUAL(1, identity_resolving_succeeded);
+    CHECK_EQUAL(index, identity_resolving_index);
+    sm_address_resolution_stats_t stats;
+    sm_address_resolution_get_stats(&stats);
+    CHECK_EQUAL(1, stats.num_cache_hits);
+    CHECK_EQUAL(1, stats.num_ah_calculations);
+
+    // cache entry invalidated when bonding is removed
+    le_device_db_remove(index);
+    resolve_address(address);
+    CHECK_EQUAL(1, identity_resolving_failed);
+    sm_address_resolution_get_stats(&stats);
+    CHECK_EQUAL(1, stats.num_cache_hits);
+}
+#endif
+
 int main (int argc, const char * argv[]){
     // log into file using HCI_DUMP_PACKETLOGGER format
     const char * log_path = "hci_dump.pklg";
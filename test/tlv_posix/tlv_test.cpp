@@ -28,20 +28,12 @@ TEST_GROUP(BSTACK_TLV){
     }
     void reopen_db(void){
         log_info("reopen");
-        // close file 
-        if( btstack_tlv_context.file != NULL ) {
-            fclose(btstack_tlv_context.file);
-        }
-        // reopen
+        // close file and reopen, read-only after deinit
         btstack_tlv_posix_deinit(&btstack_tlv_context);
 		btstack_tlv_impl = btstack_tlv_posix_init_instance(&btstack_tlv_context, TEST_DB);
     }
     void teardown(void){
         log_info("teardown");
-        // close file
-        if( btstack_tlv_context.file != NULL ) {
-            fclose(btstack_tlv_context.file);
-        }
         btstack_tlv_posix_deinit(&btstack_tlv_context);
     }
 };
@@ -188,6 +180,114 @@ TEST(BSTACK_TLV, TestWriteDeleteResetReadDeleteRead){
     CHECK_EQUAL(size, 0);
 }
 
+static long file_size(const char * path){
+    FILE * file = fopen(path, "r");
+    if (file == NULL) return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+TEST(BSTACK_TLV, TestManyTags){
+    uint32_t tag;
+    uint8_t  buffer[4];
+    // more tags than hash buckets
+    for (tag = 0; tag < 200; tag++){
+        big_endian_store_32(buffer, 0, tag);
+        btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, buffer, sizeof(buffer));
+    }
+    for (tag = 0; tag < 200; tag += 2){
+        btstack_tlv_impl->delete_tag(&btstack_tlv_context, tag);
+    }
+
+    reopen_db();
+
+    for (tag = 0; tag < 200; tag++){
+        int size = btstack_tlv_impl->get_tag(&btstack_tlv_context, tag, buffer, sizeof(buffer));
+        if ((tag & 1) == 0){
+            CHECK_EQUAL(0, size);
+        } else {
+            CHECK_EQUAL(4, size);
+            CHECK_EQUAL(tag, big_endian_read_32(buffer, 0));
+        }
+    }
+}
+
+TEST(BSTACK_TLV, TestCompaction){
+    uint32_t tag_a = TAG('a','a','a','a');
+    uint32_t tag_b = TAG('b','b','b','b');
+    uint8_t  data[100];
+    memset(data, 0x55, sizeof(data));
+    btstack_tlv_impl->store_tag(&btstack_tlv_context, tag_b, data, sizeof(data));
+
+    // overwrite tag, file must not grow beyond threshold + live entries
+    int i;
+    for (i = 0; i < 1000; i++){
+        data[0] = (uint8_t) i;
+        btstack_tlv_impl->store_tag(&btstack_tlv_context, tag_a, data, sizeof(data));
+    }
+    CHECK(file_size(TEST_DB) < (8 + 2 * (BTSTACK_TLV_POSIX_COMPACTION_THRESHOLD + 2 * 108)));
+
+    // explicit compaction leaves only header and live entries
+    CHECK_EQUAL(0, btstack_tlv_posix_compact(&btstack_tlv_context));
+    CHECK_EQUAL(8 + 2 * 108, file_size(TEST_DB));
+
+    reopen_db();
+
+    uint8_t buffer[100];
+    CHECK_EQUAL(100, btstack_tlv_impl->get_tag(&btstack_tlv_context, tag_a, buffer, sizeof(buffer)));
+    CHECK_EQUAL((uint8_t) 999, buffer[0]);
+    CHECK_EQUAL(100, btstack_tlv_impl->get_tag(&btstack_tlv_context, tag_b, buffer, sizeof(buffer)));
+    CHECK_EQUAL(0x55, buffer[0]);
+}
+
+TEST(BSTACK_TLV, TestSyncPolicy){
+    uint32_t tag = TAG('a','b','c','d');
+    uint8_t  data = 7;
+    uint8_t  buffer = data;
+    btstack_tlv_posix_set_sync_policy(&btstack_tlv_context, BTSTACK_TLV_POSIX_SYNC_FSYNC);
+    btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, &buffer, 1);
+    CHECK_EQUAL(8 + 9, file_size(TEST_DB));
+
+    btstack_tlv_posix_set_sync_policy(&btstack_tlv_context, BTSTACK_TLV_POSIX_SYNC_NONE);
+    btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, &buffer, 1);
+
+    reopen_db();
+
+    CHECK_EQUAL(1, btstack_tlv_impl->get_tag(&btstack_tlv_context, tag, &buffer, 1));
+    CHECK_EQUAL(data, buffer);
+}
+
+TEST(BSTACK_TLV, TestFlush){
+    uint32_t tag = TAG('a','b','c','d');
+    uint8_t  data = 7;
+    btstack_tlv_posix_set_sync_policy(&btstack_tlv_context, BTSTACK_TLV_POSIX_SYNC_NONE);
+    btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, &data, 1);
+    CHECK_EQUAL(8, file_size(TEST_DB));
+    CHECK_EQUAL(0, btstack_tlv_posix_flush(&btstack_tlv_context));
+    CHECK_EQUAL(8 + 9, file_size(TEST_DB));
+}
+
+TEST(BSTACK_TLV, TestDeinitClosesFile){
+    uint32_t tag = TAG('a','b','c','d');
+    uint8_t  data = 7;
+    btstack_tlv_posix_set_sync_policy(&btstack_tlv_context, BTSTACK_TLV_POSIX_SYNC_NONE);
+    btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, &data, 1);
+    btstack_tlv_posix_deinit(&btstack_tlv_context);
+    POINTERS_EQUAL(NULL, btstack_tlv_context.file);
+    CHECK_EQUAL(8 + 9, file_size(TEST_DB));
+
+    // following instance is read-only
+    btstack_tlv_impl = btstack_tlv_posix_init_instance(&btstack_tlv_context, TEST_DB);
+    POINTERS_EQUAL(NULL, btstack_tlv_context.file);
+    uint8_t buffer = 0;
+    CHECK_EQUAL(1, btstack_tlv_impl->get_tag(&btstack_tlv_context, tag, &buffer, 1));
+    CHECK_EQUAL(data, buffer);
+    data++;
+    btstack_tlv_impl->store_tag(&btstack_tlv_context, tag, &data, 1);
+    CHECK_EQUAL(8 + 9, file_size(TEST_DB));
+}
 
 int main (int argc, const char * argv[]){
     // log into file using HCI_DUMP_PACKETLOGGER format
@@ -107,6 +107,13 @@ void btstack_memory_init(void);
  */
 void btstack_memory_deinit(void);
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+/**
+ * @brief Log current and max number of buffers in use for all memory pools
+ */
+void btstack_memory_dump_stats(void);
+#endif
+
 /* API_END */
 """
 
@@ -201,6 +208,27 @@ static void btstack_memory_tracking_remove(btstack_memory_buffer_t * buffer){
 }
 #endif
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+typedef struct {
+    uint16_t num_in_use;
+    uint16_t max_in_use;
+} btstack_memory_usage_t;
+
+#ifdef HAVE_MALLOC
+static void btstack_memory_usage_get(btstack_memory_usage_t * usage){
+    usage->num_in_use++;
+    if (usage->num_in_use > usage->max_in_use){
+        usage->max_in_use = usage->num_in_use;
+    }
+}
+
+static void btstack_memory_usage_free(btstack_memory_usage_t * usage){
+    btstack_assert(usage->num_in_use > 0u);
+    usage->num_in_use--;
+}
+#endif
+#endif
+
 void btstack_memory_deinit(void){
 #ifdef HAVE_MALLOC
     while (btstack_memory_malloc_buffers != NULL){
@@ -230,16 +258,29 @@ code_template = """
 #ifdef POOL_COUNT
 #if POOL_COUNT > 0
 static STRUCT_TYPE STRUCT_NAME_storage[POOL_COUNT];
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static uint8_t STRUCT_NAME_bitmap[BTSTACK_MEMORY_TRACKED_POOL_BITMAP_SIZE(POOL_COUNT)];
+static btstack_memory_tracked_pool_t STRUCT_NAME_pool;
+#else
 static btstack_memory_pool_t STRUCT_NAME_pool;
+#endif
 STRUCT_NAME_t * btstack_memory_STRUCT_NAME_get(void){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    void * buffer = btstack_memory_tracked_pool_get(&STRUCT_NAME_pool);
+#else
     void * buffer = btstack_memory_pool_get(&STRUCT_NAME_pool);
+#endif
     if (buffer){
         memset(buffer, 0, sizeof(STRUCT_TYPE));
     }
     return (STRUCT_NAME_t *) buffer;
 }
 void btstack_memory_STRUCT_NAME_free(STRUCT_NAME_t *STRUCT_NAME){
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_free(&STRUCT_NAME_pool, STRUCT_NAME);
+#else
     btstack_memory_pool_free(&STRUCT_NAME_pool, STRUCT_NAME);
+#endif
 }
 #else
 STRUCT_NAME_t * btstack_memory_STRUCT_NAME_get(void){
@@ -256,11 +297,18 @@ typedef struct {
     STRUCT_NAME_t data;
 } btstack_memory_STRUCT_NAME_t;
 
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+static btstack_memory_usage_t STRUCT_NAME_usage;
+#endif
+
 STRUCT_NAME_t * btstack_memory_STRUCT_NAME_get(void){
     btstack_memory_STRUCT_NAME_t * buffer = (btstack_memory_STRUCT_NAME_t *) malloc(sizeof(btstack_memory_STRUCT_NAME_t));
     if (buffer){
         memset(buffer, 0, sizeof(btstack_memory_STRUCT_NAME_t));
         btstack_memory_tracking_add(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+        btstack_memory_usage_get(&STRUCT_NAME_usage);
+#endif
         return &buffer->data;
     } else {
         return NULL;
@@ -271,6 +319,9 @@ void btstack_memory_STRUCT_NAME_free(STRUCT_NAME_t *STRUCT_NAME){
     btstack_memory_STRUCT_NAME_t *buffer = (btstack_memory_STRUCT_NAME_t *)
         ((uint8_t *)STRUCT_NAME - offsetof(btstack_memory_STRUCT_NAME_t, data));
     btstack_memory_tracking_remove(&buffer->tracking);
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_usage_free(&STRUCT_NAME_usage);
+#endif
     free(buffer);
 }
 #endif
@@ -286,7 +337,43 @@ void btstack_memory_init(void){
 '''
 
 init_template = """#if POOL_COUNT > 0
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+    btstack_memory_tracked_pool_create(&STRUCT_NAME_pool, STRUCT_NAME_storage, POOL_COUNT, sizeof(STRUCT_TYPE), STRUCT_NAME_bitmap);
+#else
     btstack_memory_pool_create(&STRUCT_NAME_pool, STRUCT_NAME_storage, POOL_COUNT, sizeof(STRUCT_TYPE));
+#endif
+#endif"""
+
+stats_used_header = '''
+#ifdef ENABLE_MEMORY_POOL_TRACKING
+// btstack_memory_log_stats is only used for pools with storage or malloc
+'''
+
+stats_used_template = """#ifdef POOL_COUNT
+#if POOL_COUNT > 0
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif
+#elif defined(HAVE_MALLOC)
+#define BTSTACK_MEMORY_LOG_STATS_USED
+#endif"""
+
+stats_header = '''
+#ifdef BTSTACK_MEMORY_LOG_STATS_USED
+static void btstack_memory_log_stats(const char * name, uint16_t num_in_use, uint16_t max_in_use, uint16_t count){
+    log_info("%-32s in use %3u, max %3u, pool size %3u", name, num_in_use, max_in_use, count);
+}
+#endif
+
+void btstack_memory_dump_stats(void){
+'''
+
+stats_template = """#ifdef POOL_COUNT
+#if POOL_COUNT > 0
+    btstack_memory_log_stats("STRUCT_NAME", btstack_memory_tracked_pool_num_in_use(&STRUCT_NAME_pool),
+                             btstack_memory_tracked_pool_max_in_use(&STRUCT_NAME_pool), POOL_COUNT);
+#endif
+#elif defined(HAVE_MALLOC)
+    btstack_memory_log_stats("STRUCT_NAME", STRUCT_NAME_usage.num_in_use, STRUCT_NAME_usage.max_in_use, 0);
 #endif"""
 
 list_of_structs = [
@@ -315,6 +402,9 @@ list_of_mesh_structs = [
 list_of_iso_structs = [
     ['hci_iso_stream']
 ]
+list_of_gatt_client_discovery_cache_structs = [
+    ['gatt_client_discovery_cache']
+]
 
 def writeln(f, data):
     f.write(data + "\n")
@@ -346,6 +436,7 @@ def add_structs(f, template):
     add_struct(f, "ENABLE_BLE",                     template, list_of_le_structs)
     add_struct(f, "ENABLE_MESH",                    template, list_of_mesh_structs)
     add_struct(f, "ENABLE_LE_ISOCHRONOUS_STREAMS",  template, list_of_iso_structs)
+    add_struct(f, "ENABLE_GATT_CLIENT_DISCOVERY_CACHE", template, list_of_gatt_client_discovery_cache_structs)
 
 btstack_root = os.path.abspath(os.path.dirname(sys.argv[0]) + '/..')
 file_name = btstack_root + "/src/btstack_memory"
@@ -367,6 +458,13 @@ add_structs(f, code_template)
 f.write(init_header)
 add_structs(f, init_template)
 writeln(f, "}")
+
+f.write(stats_used_header)
+add_structs(f, stats_used_template)
+f.write(stats_header)
+add_structs(f, stats_template)
+writeln(f, "}")
+writeln(f, "#endif")
 f.close()
     
 # also generate test code
@@ -138,6 +138,13 @@ def my_parse_opcodes(infile, convert_to_camel_case):
                 (opcode, ogf, ocf) = definition.groups()
                 # opcodes.append((opcode, ogf, ocf))
                 opcodes[opcode] = (ogf, ocf)
+                continue
+            # vendor specific opcode given as plain value
+            definition = re.match(r'\s*(HCI_OPCODE_\w+)\s*=\s*(0x[0-9a-fA-F]+)\s*,.*', line)
+            if definition:
+                (opcode, value) = definition.groups()
+                value = int(value, 16)
+                opcodes[opcode] = ('OGF_VENDOR' if (value >> 10) == 0x3f else '0x%02x' % (value >> 10), '0x%03x' % (value & 0x3ff))
     return opcodes
 
 def parse_opcodes(camel_case=True, extra_header_path=None):
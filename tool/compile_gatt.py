@@ -179,6 +179,8 @@ service_counter = {}
 
 handle = 1
 total_size = 0
+# (handle, size, uuid16) of all attributes for ATT DB index
+index_attributes = []
 
 def aes_cmac(key, n):
     if have_crypto:
@@ -471,6 +473,18 @@ def database_hash_append_value(value):
     for byte in value:
         database_hash_append_uint8(byte)
 
+def uuid16_for_uuid(uuid):
+    # same as att_iterator_get_uuid16 in att_db.c
+    if len(uuid) == 2:
+        return uuid[0] | (uuid[1] << 8)
+    bluetooth_base_uuid = [0xfb, 0x34, 0x9b, 0x5f, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00]
+    if list(uuid[0:12]) != bluetooth_base_uuid[0:12] or list(uuid[14:16]) != bluetooth_base_uuid[14:16]:
+        return 0
+    return uuid[12] | (uuid[13] << 8)
+
+def index_append_attribute(handle, size, uuid16):
+    index_attributes.append((handle, size, uuid16))
+
 def parseService(fout, parts, service_type):
     global handle
     global total_size
@@ -499,6 +513,7 @@ def parseService(fout, parts, service_type):
     write_16(fout, service_type)
     write_uuid(fout, uuid)
     fout.write("\n")
+    index_append_attribute(handle, size, service_type)
 
     database_hash_append_uint16(handle)
     database_hash_append_uint16(service_type)
@@ -546,6 +561,7 @@ def parseIncludeService(fout, parts):
             if uuid_size > 0:
                 write_uuid(fout, uuid)
             fout.write("\n")
+            index_append_attribute(handle, size, 0x2802)
 
             database_hash_append_uint16(handle)
             database_hash_append_uint16(0x2802)
@@ -606,6 +622,7 @@ def parseCharacteristic(fout, parts):
     write_16(fout, handle+1)
     write_uuid(fout, uuid)
     fout.write("\n")
+    index_append_attribute(handle, size, 0x2803)
     total_size = total_size + size
 
     database_hash_append_uint16(handle)
@@ -657,6 +674,7 @@ def parseCharacteristic(fout, parts):
             write_sequence(fout,value)
 
     fout.write("\n")
+    index_append_attribute(handle, size, uuid16_for_uuid(uuid))
     defines_for_characteristics.append('#define ATT_CHARACTERISTIC_%s_VALUE_HANDLE 0x%04x' % (current_characteristic_uuid_string, handle))
     handle = handle + 1
 
@@ -681,6 +699,7 @@ def parseCharacteristic(fout, parts):
         write_16(fout, 0x2902)
         write_16(fout, 0)
         fout.write("\n")
+        index_append_attribute(handle, size, 0x2902)
 
         database_hash_append_uint16(handle)
         database_hash_append_uint16(0x2902)
@@ -700,6 +719,7 @@ def parseCharacteristic(fout, parts):
         write_16(fout, 0x2900)
         write_16(fout, 1)   # Reliable Write
         fout.write("\n")
+        index_append_attribute(handle, size, 0x2900)
 
         database_hash_append_uint16(handle)
         database_hash_append_uint16(0x2900)
@@ -732,6 +752,7 @@ def parseGenericDynamicDescriptor(fout, parts, uuid, name):
     write_16(fout, handle)
     write_16(fout, uuid)
     fout.write("\n")
+    index_append_attribute(handle, size, uuid)
 
     database_hash_append_uint16(handle)
     database_hash_append_uint16(uuid)
@@ -763,6 +784,7 @@ def parseGenericDynamicReadOnlyDescriptor(fout, parts, uuid, name):
     write_16(fout, handle)
     write_16(fout, uuid)
     fout.write("\n")
+    index_append_attribute(handle, size, uuid)
 
     database_hash_append_uint16(handle)
     database_hash_append_uint16(uuid)
@@ -804,6 +826,7 @@ def parseCharacteristicFormat(fout, parts):
     write_sequence(fout, name_space)
     write_uuid(fout, description)
     fout.write("\n")
+    index_append_attribute(handle, size, 0x2904)
 
     database_hash_append_uint16(handle)
     database_hash_append_uint16(0x2904)
@@ -833,6 +856,7 @@ def parseCharacteristicAggregateFormat(fout, parts):
         format_handle = presentation_formats[identifier]
         write_16(fout, format_handle)
     fout.write("\n")
+    index_append_attribute(handle, size, 0x2905)
 
     database_hash_append_uint16(handle)
     database_hash_append_uint16(0x2905)
@@ -857,6 +881,7 @@ def parseExternalReportReference(fout, parts):
     write_16(fout, 0x2907)
     write_16(fout, report_uuid)
     fout.write("\n")
+    index_append_attribute(handle, size, 0x2907)
     handle = handle + 1
 
 def parseReportReference(fout, parts):
@@ -879,6 +904,7 @@ def parseReportReference(fout, parts):
     write_sequence(fout, report_id)
     write_sequence(fout, report_type)
     fout.write("\n")
+    index_append_attribute(handle, size, 0x2908)
     handle = handle + 1
 
 def parseNumberOfDigitals(fout, parts):
@@ -899,6 +925,7 @@ def parseNumberOfDigitals(fout, parts):
     write_16(fout, 0x2909)
     write_sequence(fout, no_of_digitals)
     fout.write("\n")
+    index_append_attribute(handle, size, 0x2909)
     handle = handle + 1
 
 def parseLines(fname_in, fin, fout):
@@ -1081,6 +1108,56 @@ def listHandles(fout):
         fout.write(define)
         fout.write('\n')
 
+def listIndex(fout):
+    handles = []
+    offsets = []
+    uuids = []
+    # offsets relative to first attribute after ATT DB version
+    offset = 0
+    for (handle, size, uuid16) in index_attributes:
+        if len(handles) > 0 and handle <= handles[-1]:
+            warn("handles not ascending, ATT DB index not generated")
+            return
+        handles.append(handle)
+        offsets.append(offset)
+        uuids.append(uuid16)
+        offset += size
+    end_offset = offset
+    num_attributes = len(handles)
+
+    # position of last attribute before next service declaration
+    group_ends = [0] * num_attributes
+    group_end = num_attributes - 1
+    for i in reversed(range(num_attributes)):
+        group_ends[i] = group_end
+        if uuids[i] in [0x2800, 0x2801]:
+            group_end = i - 1
+
+    # positions sorted by UUID16, then by handle
+    by_uuid16 = sorted(range(num_attributes), key=lambda i: (uuids[i], handles[i]))
+
+    fout.write('\n')
+    fout.write('//\n')
+    fout.write('// ATT DB index for att_set_db_index, requires ENABLE_ATT_DB_INDEX\n')
+    fout.write('//\n')
+    fout.write('#if __cplusplus >= 200704L\n')
+    fout.write('constexpr\n')
+    fout.write('#endif\n')
+    fout.write('static const uint16_t profile_data_index[] = {\n')
+    write_indent(fout)
+    fout.write('// number of attributes, offset of end tag\n')
+    write_indent(fout)
+    fout.write('%u, 0x%04x,\n' % (num_attributes, end_offset))
+    for (comment, values) in [('handles', handles), ('offsets', offsets), ('UUID16s', uuids),
+                              ('service group ends', group_ends), ('sorted by UUID16', by_uuid16)]:
+        write_indent(fout)
+        fout.write('// %s\n' % comment)
+        for i in range(0, num_attributes, 8):
+            write_indent(fout)
+            fout.write(' '.join(['0x%04x,' % value for value in values[i:i+8]]))
+            fout.write('\n')
+    fout.write('};\n')
+
 def getFile( fileName ):
     for d in include_paths:
         fullFile = os.path.normpath(d + os.sep + fileName) # because Windows exists
@@ -1106,6 +1183,8 @@ parser.add_argument('-v', '--verbose', action='store_true',
         help='enable verbose output on stdout')
 parser.add_argument('-I', action='append', nargs=1, metavar='includes', 
         help='include search path for .gatt service files and bluetooth_gatt.h (default: %s)' % ", ".join(default_includes))
+parser.add_argument('--index', action='store_true',
+        help='generate ATT DB index tables for att_set_db_index')
 parser.add_argument('gattfile', metavar='gattfile', type=str,
         help='gatt file to be compiled')
 parser.add_argument('hfile', metavar='hfile', type=str,
@@ -1160,6 +1239,8 @@ try:
     ftemp.seek(0)
     for line in ftemp:
         fout.write(line.replace('THE-DATABASE-HASH', db_hash_string))
+    if args.index:
+        listIndex(fout)
     fout.close()
     ftemp.close()
 
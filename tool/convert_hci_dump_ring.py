@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+# BlueKitchen GmbH (c) 2026
+
+# convert ring buffer of hci_dump_buffered_init_ring, e.g. file of hci_dump_posix_mmap,
+# into PacketLogger or BTSnoop format, can be viewed with Wireshark
+
+# Ring header, little endian
+# typedef struct {
+# 	uint8_t		magic[8];   // "BTSTKRNG"
+# 	uint32_t	version;
+# 	uint32_t	header_size;
+# 	uint32_t	ring_size;
+# 	uint32_t	reserved;
+# 	uint32_t	write_index;
+# 	uint32_t	tail_index;
+# 	uint32_t	first_sequence;
+# 	uint32_t	next_sequence;
+# }
+#
+# Ring record, little endian, 4-byte aligned, record_len 0 marks end of ring
+# typedef struct {
+# 	uint16_t	record_len; // incl. record header
+# 	uint8_t		packet_type;
+# 	uint8_t		in;
+# 	uint32_t	sequence_number;
+# 	uint64_t	timestamp_us;
+# }
+
+import argparse
+import struct
+import sys
+
+RING_MAGIC = b'BTSTKRNG'
+RING_VERSION = 1
+RING_HEADER_FORMAT = '<8sIIIIIIII'
+RING_RECORD_HEADER_FORMAT = '<HBBIQ'
+RING_RECORD_HEADER_SIZE = 16
+
+HCI_COMMAND_DATA_PACKET = 0x01
+HCI_ACL_DATA_PACKET = 0x02
+HCI_SCO_DATA_PACKET = 0x03
+HCI_EVENT_PACKET = 0x04
+HCI_ISO_DATA_PACKET = 0x05
+LOG_MESSAGE_PACKET = 0xfc
+
+# packet type -> (out, in)
+packet_logger_types = {
+	HCI_COMMAND_DATA_PACKET: (0x00, 0x00),
+	HCI_EVENT_PACKET: (0x01, 0x01),
+	HCI_ACL_DATA_PACKET: (0x02, 0x03),
+	HCI_SCO_DATA_PACKET: (0x08, 0x09),
+	HCI_ISO_DATA_PACKET: (0x0c, 0x0d),
+	LOG_MESSAGE_PACKET: (0xfc, 0xfc),
+}
+
+# Linux Monitor opcodes
+btsnoop_opcodes = {
+	HCI_COMMAND_DATA_PACKET: (0x02, 0x02),
+	HCI_EVENT_PACKET: (0x03, 0x03),
+	HCI_ACL_DATA_PACKET: (0x04, 0x05),
+	HCI_SCO_DATA_PACKET: (0x06, 0x07),
+	HCI_ISO_DATA_PACKET: (0x12, 0x13),
+	LOG_MESSAGE_PACKET: (0x0c, 0x0c),
+}
+
+# Identification Pattern "btsnoop\0", Version 1, Datalink Type 2001 - Linux Monitor
+btsnoop_file_header = b'btsnoop\0' + struct.pack('>II', 1, 2001)
+
+# microseconds between 0 AD and 1970
+btsnoop_epoch_offset_us = 0xdcddb30f2f8000
+
+def read_ring(data):
+	if len(data) < 64:
+		raise ValueError('file too short')
+	(magic, version, header_size, ring_size, _, write_index, tail_index, first_sequence, next_sequence) = struct.unpack_from(RING_HEADER_FORMAT, data, 0)
+	if magic != RING_MAGIC or version != RING_VERSION:
+		raise ValueError('no ring buffer found')
+	if header_size + ring_size > len(data):
+		raise ValueError('ring size %u exceeds file size' % ring_size)
+	ring = data[header_size:header_size + ring_size]
+
+	def record_len(pos):
+		if pos + RING_RECORD_HEADER_SIZE > ring_size:
+			return 0
+		return struct.unpack_from('<H', ring, pos)[0]
+
+	# walk records from tail, a complete record at the write index might not have been published before a crash
+	has_records = first_sequence != next_sequence
+	if tail_index > ring_size or tail_index & 3:
+		tail_index = 0
+	records = []
+	pos = tail_index
+	wrapped = False
+	while len(records) < ring_size // RING_RECORD_HEADER_SIZE:
+		length = record_len(pos)
+		if length == 0:
+			if wrapped or pos == 0:
+				break
+			wrapped = True
+			pos = 0
+			continue
+		record_size = (length + 3) & ~3
+		if length < RING_RECORD_HEADER_SIZE or pos + record_size > ring_size:
+			break
+		(_, packet_type, direction, sequence_number, timestamp_us) = struct.unpack_from(RING_RECORD_HEADER_FORMAT, ring, pos)
+		if pos == write_index and sequence_number != next_sequence:
+			if len(records) > 0 or not has_records:
+				break
+		if len(records) > 0 and sequence_number != (records[0][0] + len(records)) & 0xffffffff:
+			break
+		payload = ring[pos + RING_RECORD_HEADER_SIZE:pos + length]
+		records.append((sequence_number, packet_type, direction, timestamp_us, payload))
+		pos += record_size
+	return records
+
+def write_packetlogger(fout, records):
+	for (_, packet_type, direction, timestamp_us, payload) in records:
+		if packet_type not in packet_logger_types:
+			continue
+		packet_logger_type = packet_logger_types[packet_type][1 if direction else 0]
+		fout.write(struct.pack('>IIIB', 9 + len(payload), timestamp_us // 1000000, timestamp_us % 1000000, packet_logger_type))
+		fout.write(payload)
+
+def write_btsnoop(fout, records):
+	fout.write(btsnoop_file_header)
+	for (_, packet_type, direction, timestamp_us, payload) in records:
+		if packet_type not in btsnoop_opcodes:
+			continue
+		opcode = btsnoop_opcodes[packet_type][1 if direction else 0]
+		fout.write(struct.pack('>IIIIQ', len(payload), len(payload), opcode, 0, btsnoop_epoch_offset_us + timestamp_us))
+		fout.write(payload)
+
+parser = argparse.ArgumentParser(description='Convert hci_dump ring buffer into PacketLogger or BTSnoop file')
+parser.add_argument('-f', '--format', choices=['pklg', 'btsnoop'],
+		help='output format (default: from extension of output file, PacketLogger otherwise)')
+parser.add_argument('ringfile', metavar='ringfile', type=str,
+		help='ring buffer file, e.g. created by hci_dump_posix_mmap')
+parser.add_argument('outfile', metavar='outfile', type=str,
+		help='output file')
+args = parser.parse_args()
+
+output_format = args.format
+if output_format is None:
+	output_format = 'btsnoop' if args.outfile.endswith(('.btsnoop', '.log', '.cfa')) else 'pklg'
+
+with open(args.ringfile, 'rb') as fin:
+	data = fin.read()
+try:
+	records = read_ring(data)
+except ValueError as e:
+	print('Error: %s: %s' % (args.ringfile, e), file=sys.stderr)
+	sys.exit(1)
+
+with open(args.outfile, 'wb') as fout:
+	if output_format == 'btsnoop':
+		write_btsnoop(fout, records)
+	else:
+		write_packetlogger(fout, records)
+
+if len(records) > 0:
+	print('%u records, sequence numbers %u - %u' % (len(records), records[0][0], records[-1][0]))
+else:
+	print('0 records')
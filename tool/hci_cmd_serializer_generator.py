@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+
+import re
+import sys
+import os
+
+import btstack_parser as parser
+
+program_info = '''
+BTstack HCI Command Serializer Generator for BTstack
+Copyright 2026, BlueKitchen GmbH
+'''
+
+copyright = """/*
+ * Copyright (C) 2026 BlueKitchen GmbH
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ * 4. Any redistribution, use, or modification is done solely for
+ *    personal benefit and not for any commercial purpose or for
+ *    monetary gain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY BLUEKITCHEN GMBH AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL BLUEKITCHEN
+ * GMBH OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * Please inquire about commercial licensing options at
+ * contact@bluekitchen-gmbh.com
+ *
+ */
+"""
+
+hfile_header_begin = """
+
+/**
+ * HCI Command Serializer
+ *
+ * Typed alternative to hci_cmd_create_from_template for commands with fixed field layout.
+ * Fields are stored at offsets known at compile time, without parsing the format string
+ * or passing arguments via va_list.
+ *
+ * Note: Don't edit this file. It is generated by tool/hci_cmd_serializer_generator.py
+ *
+ */
+
+#ifndef HCI_CMD_SERIALIZER_H
+#define HCI_CMD_SERIALIZER_H
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+#include "btstack_util.h"
+#include "hci_cmd.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* API_START */
+
+"""
+
+hfile_header_end = """
+/* API_END */
+
+#if defined __cplusplus
+}
+#endif
+
+#endif // HCI_CMD_SERIALIZER_H
+"""
+
+c_types = {
+    '1' : 'uint8_t',
+    '2' : 'uint16_t',
+    '3' : 'uint32_t',
+    '4' : 'uint32_t',
+    'A' : 'const uint8_t *',
+    'B' : 'const bd_addr_t',
+    'D' : 'const uint8_t *',
+    'E' : 'const uint8_t *',
+    'H' : 'hci_con_handle_t',
+    'J' : 'uint8_t',
+    'K' : 'const uint8_t *',
+    'N' : 'const char *',
+    'P' : 'const uint8_t *',
+    'Q' : 'const uint8_t *',
+    'V' : 'const uint8_t *',
+}
+
+# size in command, 'V' is limited by 8 bit length field 'J'
+field_sizes = {
+    '1' : 1,
+    '2' : 2,
+    '3' : 3,
+    '4' : 4,
+    'A' : 31,
+    'B' : 6,
+    'D' : 8,
+    'E' : 240,
+    'H' : 2,
+    'J' : 1,
+    'K' : 16,
+    'N' : 248,
+    'P' : 16,
+    'Q' : 32,
+    'V' : 255,
+}
+
+# local variables and C/C++ keywords
+reserved_names = ['buffer', 'pos', 'class', 'default', 'delete', 'new', 'private', 'protected', 'public', 'register', 'this']
+
+def is_supported(format):
+    # array and service record parameters are not supported
+    for field_type in format:
+        if field_type not in c_types:
+            return False
+    # 'V' requires preceding 'J'
+    return re.sub(r'JV', '', format).find('V') < 0
+
+def param_names(format, params):
+    names = []
+    for param in params:
+        if re.match(r'^[a-z_][a-z0-9_]*$', param) is None or param in reserved_names:
+            break
+        names.append(param)
+    if len(names) != len(format) or len(set(names)) != len(names):
+        names = ['arg%u' % (i + 1) for i in range(len(format))]
+    return names
+
+def serializer_name(command_name):
+    if command_name.startswith('hci_'):
+        command_name = command_name[len('hci_'):]
+    return 'hci_cmd_serialize_' + command_name
+
+def store_little_endian(num_bytes, name, position):
+    text = '    buffer[%s] = (uint8_t) %s;\n' % (position, name)
+    for i in range(1, num_bytes):
+        text += '    buffer[%s] = (uint8_t) (%s >> %u);\n' % (offset_add(position, i), name, 8 * i)
+    return text
+
+def offset_add(position, value):
+    if position.endswith('u'):
+        return '%uu' % (int(position[:-1]) + value)
+    return '%s + %uu' % (position, value)
+
+def store_field(field_type, name, offset, last_length_field):
+    position = '%uu' % offset if isinstance(offset, int) else offset
+    if field_type in '1J':
+        return '    buffer[%s] = %s;\n' % (position, name)
+    if field_type in '2H':
+        return store_little_endian(2, name, position)
+    if field_type == '3':
+        return store_little_endian(3, name, position)
+    if field_type == '4':
+        return store_little_endian(4, name, position)
+    if field_type == 'B':
+        return '    reverse_bd_addr(%s, &buffer[%s]);\n' % (name, position)
+    if field_type in 'KQ':
+        return '    reverse_bytes(%s, &buffer[%s], %u);\n' % (name, position, field_sizes[field_type])
+    if field_type in 'ADEP':
+        return '    (void)memcpy(&buffer[%s], %s, %u);\n' % (position, name, field_sizes[field_type])
+    if field_type == 'N':
+        return ('    uint16_t %s_len = (uint16_t) btstack_min((uint32_t) strlen(%s), 248u);\n' % (name, name) +
+                '    (void)memcpy(&buffer[%s], %s, %s_len);\n' % (position, name, name) +
+                '    memset(&buffer[%s + %s_len], 0, 248u - %s_len);\n' % (position, name, name))
+    if field_type == 'V':
+        # inlined memcpy with 8 bit length gets expanded by some compilers, e.g. into slow 'rep movsq' on x86
+        return '    hci_cmd_store_variable_length_data(buffer, %s, %s, %s);\n' % (position, name, last_length_field)
+    return ''
+
+def create_serializer(command_name, ogf, ocf, format, params):
+    names = param_names(format, params)
+    max_size = 3 + sum(field_sizes[field_type] for field_type in format)
+
+    text = '/**\n'
+    text += ' * @brief Serialize %s into buffer\n' % command_name
+    if 'V' in format:
+        text += ' * @param buffer for HCI command of up to %u bytes\n' % max_size
+    else:
+        text += ' * @param buffer for HCI command of %u bytes\n' % max_size
+    for name in names:
+        text += ' * @param %s\n' % name
+    text += ' * @return size of HCI command\n'
+    text += (' * @note: btstack_type %s' % format).rstrip() + '\n'
+    text += ' */\n'
+
+    args = ['uint8_t * buffer'] + ['%s %s' % (c_types[field_type], name) for (field_type, name) in zip(format, names)]
+    text += 'static inline uint16_t %s(%s){\n' % (serializer_name(command_name), ', '.join(args))
+    text += '    buffer[0] = (uint8_t) HCI_OPCODE(%s, %s);\n' % (ogf, ocf)
+    text += '    buffer[1] = (uint8_t) (HCI_OPCODE(%s, %s) >> 8);\n' % (ogf, ocf)
+    if 'V' not in format:
+        text += '    buffer[2] = %uu;\n' % (max_size - 3)
+
+    # fixed offsets up to first variable length field, running position afterwards
+    offset = 3
+    last_length_field = None
+    for (field_type, name) in zip(format, names):
+        text += store_field(field_type, name, offset, last_length_field)
+        if field_type == 'J':
+            last_length_field = name
+        if field_type == 'V':
+            if isinstance(offset, int):
+                text += '    uint16_t pos = %uu + %s;\n' % (offset, last_length_field)
+                offset = 'pos'
+            else:
+                text += '    pos += %s;\n' % last_length_field
+        elif isinstance(offset, int):
+            offset += field_sizes[field_type]
+        else:
+            text += '    pos += %uu;\n' % field_sizes[field_type]
+
+    if isinstance(offset, int):
+        text += '    return %uu;\n' % offset
+    else:
+        text += '    buffer[2] = (uint8_t) (pos - 3u);\n'
+        text += '    return pos;\n'
+    text += '}\n\n'
+    return text
+
+def create_serializers(commands):
+    global gen_path
+    with open(gen_path, 'wt') as fout:
+        fout.write(copyright)
+        fout.write(hfile_header_begin)
+        for (command_name, ogf, ocf, format, params) in commands:
+            if not is_supported(format):
+                print('Skip %s, format "%s" not supported' % (command_name, format))
+                continue
+            fout.write(create_serializer(command_name, ogf, ocf, format, params))
+        fout.write(hfile_header_end)
+
+btstack_root = os.path.abspath(os.path.dirname(sys.argv[0]) + '/..')
+gen_path = btstack_root + '/src/hci_cmd_serializer.h'
+
+print(program_info)
+
+# parse commands
+commands = parser.parse_commands(camel_case=False)
+# create serializers
+create_serializers(commands)
+
+# done
+print('Done!')